@@ -0,0 +1,13 @@
+# Set working variables.
+set datafile points/sampled-surf_01.xyz
+
+# Read input geometry.
+set datadir $env(ASI_TEST_DATA)
+load-points pts $datadir/$datafile
+fit
+
+# Make average plane.
+re-make-average-plane p pts
+
+# Build concave hull of the points projected on the plane.
+re-concave-hull hull pts p -k 7
@@ -0,0 +1,10 @@
+# Set working variables.
+set datafile points/sampled-surf_01.xyz
+
+# Read input geometry.
+set datadir $env(ASI_TEST_DATA)
+load-points pts $datadir/$datafile
+fit
+
+# Plate sparse clouds and fit dense ones.
+re-plate-points res pts -maxplatepts 1000
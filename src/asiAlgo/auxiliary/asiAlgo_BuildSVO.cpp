@@ -0,0 +1,354 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_BuildSVO.h>
+
+// Standard includes
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Max number of octree levels.
+  const int MaxDepth = 20;
+
+  //! Max number of cells processed in a single batch.
+  const int BatchSize = 65536;
+
+  //! Decision on splitting a single cell.
+  struct t_split
+  {
+    bool  Split;      //!< Whether to split the cell.
+    float Values[27]; //!< Function values in the 3x3x3 lattice (X runs fastest).
+  };
+
+  //! Converts the function value to the stored precision.
+  inline float ToScalar(const double f)
+  {
+    return float( std::max( std::min( f, double(FLT_MAX) ), -double(FLT_MAX) ) );
+  }
+
+  //! Interpolates the corner scalars trilinearly.
+  inline double Interpolate(const float* sc,
+                            const double u,
+                            const double v,
+                            const double w)
+  {
+    const double c00 = sc[0]*(1. - u) + sc[1]*u;
+    const double c10 = sc[2]*(1. - u) + sc[3]*u;
+    const double c01 = sc[4]*(1. - u) + sc[5]*u;
+    const double c11 = sc[6]*(1. - u) + sc[7]*u;
+
+    return ( c00*(1. - v) + c10*v )*(1. - w) + ( c01*(1. - v) + c11*v )*w;
+  }
+
+  //! Functor deciding on splitting the cells of a single level.
+  class SplitFunctor
+  {
+  public:
+
+    SplitFunctor(const asiAlgo_DistanceFunc*             pFunc,
+                 const asiAlgo_SVO*                      pSVO,
+                 const std::vector<asiAlgo_SVO::t_cell>& cells,
+                 const int                               offset,
+                 const double                            minSize,
+                 const double                            maxSize,
+                 const double                            prec,
+                 const bool                              isUniform,
+                 std::vector<t_split>&                   splits)
+    : m_pFunc    (pFunc),
+      m_pSVO     (pSVO),
+      m_cells    (cells),
+      m_iOffset  (offset),
+      m_fMinSize (minSize),
+      m_fMaxSize (maxSize),
+      m_fPrec    (prec),
+      m_bUniform (isUniform),
+      m_splits   (splits)
+    {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int i = first; i < last; ++i )
+        this->processCell(m_cells[m_iOffset + i], m_splits[i]);
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    void processCell(const asiAlgo_SVO::t_cell& cell,
+                     t_split&                   res) const
+    {
+      res.Split = false;
+
+      const gp_XYZ d    = cell.Max - cell.Min;
+      const double size = std::max( d.X(), std::max( d.Y(), d.Z() ) );
+      //
+      if ( size <= m_fMinSize )
+        return;
+
+      const float* sc = m_pSVO->GetNode(cell.Node).Scalars;
+
+      // Evaluate the lattice.
+      double maxErr      = 0.;
+      double minAbs      = DBL_MAX;
+      bool   hasPositive = false;
+      bool   hasNegative = false;
+      //
+      for ( int c = 0; c < 3; ++c )
+        for ( int b = 0; b < 3; ++b )
+          for ( int a = 0; a < 3; ++a )
+          {
+            float f;
+            //
+            if ( a != 1 && b != 1 && c != 1 )
+            {
+              f = sc[ asiAlgo_SVO::GetCornerID(a/2, b/2, c/2) ];
+            }
+            else
+            {
+              f = ToScalar( m_pFunc->Eval( cell.Min.X() + 0.5*a*d.X(),
+                                           cell.Min.Y() + 0.5*b*d.Y(),
+                                           cell.Min.Z() + 0.5*c*d.Z() ) );
+              //
+              maxErr = std::max( maxErr, std::fabs( f - Interpolate(sc, 0.5*a, 0.5*b, 0.5*c) ) );
+            }
+
+            res.Values[a + 3*b + 9*c] = f;
+            //
+            minAbs = std::min( minAbs, std::fabs(double(f)) );
+            //
+            if ( f > 0.f )
+              hasPositive = true;
+            else if ( f < 0.f )
+              hasNegative = true;
+          }
+
+      // Since the distance is 1-Lipschitz, no point of the cell is on the
+      // zero level if all lattice values are far from zero.
+      const bool isFar = !(hasPositive && hasNegative) && ( minAbs > 0.5*d.Modulus() );
+
+      if ( size > m_fMaxSize )
+        res.Split = true;
+      else if ( isFar )
+        res.Split = false;
+      else if ( m_bUniform )
+        res.Split = true;
+      else
+        res.Split = ( maxErr > m_fPrec );
+    }
+
+  private:
+
+    const asiAlgo_DistanceFunc*             m_pFunc;    //!< Distance function.
+    const asiAlgo_SVO*                      m_pSVO;     //!< Octree being built.
+    const std::vector<asiAlgo_SVO::t_cell>& m_cells;    //!< Cells of the level.
+    int                                     m_iOffset;  //!< Offset of the batch.
+    double                                  m_fMinSize; //!< Min cell size.
+    double                                  m_fMaxSize; //!< Max cell size.
+    double                                  m_fPrec;    //!< Precision.
+    bool                                    m_bUniform; //!< Uniform mode.
+    std::vector<t_split>&                   m_splits;   //!< Decisions.
+  };
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_BuildSVO::asiAlgo_BuildSVO(ActAPI_ProgressEntry progress,
+                                   ActAPI_PlotterEntry  plotter)
+: ActAPI_IAlgorithm (progress, plotter),
+  m_pResult         (nullptr),
+  m_bIsParallel     (true)
+{}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_BuildSVO::~asiAlgo_BuildSVO()
+{
+  delete m_pResult;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_BuildSVO::Perform(const Handle(asiAlgo_DistanceFunc)& func,
+                               const double                        minSize,
+                               const double                        maxSize,
+                               const double                        prec,
+                               const bool                          isUniform)
+{
+  delete m_pResult;
+  m_pResult = nullptr;
+
+  if ( func.IsNull() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Null distance function.");
+    return false;
+  }
+
+  if ( minSize <= 0. )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Min cell size should be positive.");
+    return false;
+  }
+
+  const gp_XYZ& domainMin = func->GetDomainMin();
+  const gp_XYZ& domainMax = func->GetDomainMax();
+  //
+  if ( domainMax.X() <= domainMin.X() ||
+       domainMax.Y() <= domainMin.Y() ||
+       domainMax.Z() <= domainMin.Z() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Degenerated domain of the distance function.");
+    return false;
+  }
+
+  /* =================
+   *  Initialize root.
+   * ================= */
+
+  m_pResult = new asiAlgo_SVO(domainMin, domainMax);
+  //
+  for ( int k = 0; k < 8; ++k )
+  {
+    const double x = (k & 1) ? domainMax.X() : domainMin.X();
+    const double y = (k & 2) ? domainMax.Y() : domainMin.Y();
+    const double z = (k & 4) ? domainMax.Z() : domainMin.Z();
+    //
+    m_pResult->ChangeNode(0).Scalars[k] = ToScalar( func->Eval(x, y, z) );
+  }
+
+  /* ==========================
+   *  Subdivide level by level.
+   * ========================== */
+
+  std::vector<asiAlgo_SVO::t_cell> level, nextLevel;
+  std::vector<t_split>             splits;
+  int                              depth = 0;
+  //
+  level.push_back( asiAlgo_SVO::t_cell(0, domainMin, domainMax) );
+  //
+  for ( ; depth < MaxDepth && !level.empty(); ++depth )
+  {
+    nextLevel.clear();
+
+    for ( int offset = 0; offset < int( level.size() ); offset += BatchSize )
+    {
+      const int numCells = std::min( BatchSize, int( level.size() ) - offset );
+      //
+      splits.resize(numCells);
+
+      SplitFunctor splitFunc( func.get(), m_pResult, level, offset,
+                              minSize, maxSize, prec, isUniform, splits );
+
+#ifdef USE_THREADING
+      if ( m_bIsParallel )
+        tbb::parallel_for(tbb::blocked_range<int>(0, numCells, 16), splitFunc);
+      else
+#endif
+        splitFunc.Process(0, numCells);
+
+      // Allocate children and pass them the lattice values.
+      for ( int i = 0; i < numCells; ++i )
+      {
+        if ( !splits[i].Split )
+          continue;
+
+        const asiAlgo_SVO::t_cell& cell  = level[offset + i];
+        const int                  first = m_pResult->Split(cell.Node);
+        //
+        for ( int k = 0; k < 8; ++k )
+        {
+          const int nx = (k & 1), ny = (k & 2) >> 1, nz = (k & 4) >> 2;
+
+          asiAlgo_SVO::t_node& child = m_pResult->ChangeNode(first + k);
+          //
+          for ( int corner = 0; corner < 8; ++corner )
+          {
+            const int a = nx + (corner & 1);
+            const int b = ny + ( (corner & 2) >> 1 );
+            const int c = nz + ( (corner & 4) >> 2 );
+            //
+            child.Scalars[corner] = splits[i].Values[a + 3*b + 9*c];
+          }
+
+          asiAlgo_SVO::t_cell childCell;
+          childCell.Node = first + k;
+          asiAlgo_SVO::GetChildBounds(cell.Min, cell.Max, k, childCell.Min, childCell.Max);
+          //
+          nextLevel.push_back(childCell);
+        }
+      }
+
+      if ( m_progress.IsCancelling() )
+      {
+        delete m_pResult;
+        m_pResult = nullptr;
+        return false;
+      }
+    }
+
+    level.swap(nextLevel);
+  }
+
+  if ( !level.empty() )
+    m_progress.SendLogMessage(LogWarn(Normal) << "Max octree depth %1 is reached." << MaxDepth);
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "Octree contains %1 nodes on %2 levels and occupies %3 MiB."
+                                             << m_pResult->GetNumNodes()
+                                             << depth
+                                             << m_pResult->GetMemoryInBytes()/(1024.*1024.) );
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_SVO* asiAlgo_BuildSVO::ReleaseResult()
+{
+  asiAlgo_SVO* pResult = m_pResult;
+  m_pResult = nullptr;
+
+  return pResult;
+}
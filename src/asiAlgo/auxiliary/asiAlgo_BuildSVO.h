@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_BuildSVO_h
+#define asiAlgo_BuildSVO_h
+
+// asiAlgo includes
+#include <asiAlgo_DistanceFunc.h>
+#include <asiAlgo_SVO.h>
+
+// Active Data includes
+#include <ActAPI_IAlgorithm.h>
+
+//-----------------------------------------------------------------------------
+
+//! Builds an adaptive distance field (ADF) as a sparse voxel octree by
+//! sampling the given distance function. The octree is subdivided top-down
+//! level by level, and the cells of each level are processed in parallel.
+//! For each cell, the function is evaluated in the 3x3x3 lattice of its
+//! corners, face and edge midpoints and center. The cell is split if it is
+//! larger than the max size, or if it is larger than the min size and the
+//! trilinear interpolation of its corner values deviates from the lattice
+//! values by more than the precision. The cells which are far enough from
+//! the zero level set are never split below the max size. In the uniform
+//! mode, the precision is ignored, and all cells near the zero level set
+//! are split down to the min size. The lattice values give the scalars of
+//! the children, so each value is evaluated once per cell.
+class asiAlgo_BuildSVO : public ActAPI_IAlgorithm
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_BuildSVO, ActAPI_IAlgorithm)
+
+public:
+
+  //! Ctor.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  asiAlgo_EXPORT
+    asiAlgo_BuildSVO(ActAPI_ProgressEntry progress = nullptr,
+                     ActAPI_PlotterEntry  plotter  = nullptr);
+
+  //! Dtor. Deletes the result unless it was released.
+  asiAlgo_EXPORT
+    ~asiAlgo_BuildSVO();
+
+public:
+
+  //! Builds the octree in the domain of the distance function.
+  //! \param[in] func      distance function to sample.
+  //! \param[in] minSize   min cell size.
+  //! \param[in] maxSize   max cell size.
+  //! \param[in] prec      approximation precision.
+  //! \param[in] isUniform whether to split all cells near the zero level
+  //!                      set down to the min size.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const Handle(asiAlgo_DistanceFunc)& func,
+            const double                        minSize,
+            const double                        maxSize,
+            const double                        prec,
+            const bool                          isUniform);
+
+  //! Returns the constructed octree and passes its ownership to the
+  //! caller.
+  //! \return octree to be deleted by the caller.
+  asiAlgo_EXPORT asiAlgo_SVO*
+    ReleaseResult();
+
+public:
+
+  //! Sets multithreading mode (parallel or sequential).
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+  //! \return true if the parallel mode is on.
+  bool IsParallelMode() const
+  {
+    return m_bIsParallel;
+  }
+
+protected:
+
+  asiAlgo_SVO* m_pResult;     //!< Constructed octree.
+  bool         m_bIsParallel; //!< Multithreading mode.
+
+private:
+
+  asiAlgo_BuildSVO(const asiAlgo_BuildSVO&);            //!< Not copyable.
+  asiAlgo_BuildSVO& operator=(const asiAlgo_BuildSVO&); //!< Not assignable.
+
+};
+
+#endif
@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_CSGDistanceFunc.h>
+
+// Standard includes
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_CSGDistanceFunc::asiAlgo_CSGDistanceFunc(const Handle(asiAlgo_DistanceFunc)& left,
+                                                 const Handle(asiAlgo_DistanceFunc)& right,
+                                                 const asiAlgo_CSG                   op)
+: asiAlgo_DistanceFunc (Mode_Signed),
+  m_left               (left),
+  m_right              (right),
+  m_op                 (op)
+{
+  const gp_XYZ& lMin = left->GetDomainMin();
+  const gp_XYZ& lMax = left->GetDomainMax();
+  const gp_XYZ& rMin = right->GetDomainMin();
+  const gp_XYZ& rMax = right->GetDomainMax();
+
+  m_domainMin.SetCoord( std::min( lMin.X(), rMin.X() ),
+                        std::min( lMin.Y(), rMin.Y() ),
+                        std::min( lMin.Z(), rMin.Z() ) );
+  //
+  m_domainMax.SetCoord( std::max( lMax.X(), rMax.X() ),
+                        std::max( lMax.Y(), rMax.Y() ),
+                        std::max( lMax.Z(), rMax.Z() ) );
+}
+
+//-----------------------------------------------------------------------------
+
+double asiAlgo_CSGDistanceFunc::Eval(const double x,
+                                     const double y,
+                                     const double z) const
+{
+  const double fl = m_left->Eval(x, y, z);
+  const double fr = m_right->Eval(x, y, z);
+
+  switch ( m_op )
+  {
+    case CSG_Union:        return std::min(fl, fr);
+    case CSG_Intersection: return std::max(fl, fr);
+    case CSG_Difference:   return std::max(fl, -fr);
+    default: break;
+  }
+
+  return fl;
+}
@@ -0,0 +1,83 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_CSGDistanceFunc_h
+#define asiAlgo_CSGDistanceFunc_h
+
+// asiAlgo includes
+#include <asiAlgo_CSG.h>
+#include <asiAlgo_DistanceFunc.h>
+
+//-----------------------------------------------------------------------------
+
+//! Distance function of a Boolean operation on two signed distance
+//! functions. The union takes the min of operands, the intersection takes
+//! their max, and the difference is the intersection with the complement
+//! of the right operand. The result is a bound of the exact distance which
+//! is exact in the outside of the union and the inside of the intersection.
+//! The domain of the function is the box enclosing the domains of both
+//! operands.
+class asiAlgo_CSGDistanceFunc : public asiAlgo_DistanceFunc
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_CSGDistanceFunc, asiAlgo_DistanceFunc)
+
+public:
+
+  //! Ctor.
+  //! \param[in] left  left operand.
+  //! \param[in] right right operand.
+  //! \param[in] op    Boolean operation.
+  asiAlgo_EXPORT
+    asiAlgo_CSGDistanceFunc(const Handle(asiAlgo_DistanceFunc)& left,
+                            const Handle(asiAlgo_DistanceFunc)& right,
+                            const asiAlgo_CSG                   op);
+
+public:
+
+  //! Evaluates function for the given coordinates.
+  //! \param[in] x first argument.
+  //! \param[in] y second argument.
+  //! \param[in] z third argument.
+  //! \return evaluated distance.
+  asiAlgo_EXPORT virtual double
+    Eval(const double x, const double y, const double z) const;
+
+protected:
+
+  Handle(asiAlgo_DistanceFunc) m_left;  //!< Left operand.
+  Handle(asiAlgo_DistanceFunc) m_right; //!< Right operand.
+  asiAlgo_CSG                  m_op;    //!< Boolean operation.
+
+};
+
+#endif
@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_DistanceFunc_h
+#define asiAlgo_DistanceFunc_h
+
+// asiAlgo includes
+#include <asiAlgo.h>
+
+// OCCT includes
+#include <gp_XYZ.hxx>
+#include <Standard_Type.hxx>
+
+//-----------------------------------------------------------------------------
+
+//! Base class for scalar distance functions sampled into distance fields.
+//! The function is defined in the box given by its min and max corners.
+//! Since the distance fields are built in parallel, Eval() should be safe to
+//! call concurrently.
+class asiAlgo_DistanceFunc : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_DistanceFunc, Standard_Transient)
+
+public:
+
+  //! Distance calculation mode.
+  enum Mode
+  {
+    Mode_Unsigned = 0, //!< Unsigned distance.
+    Mode_Signed        //!< Signed distance (negative inside).
+  };
+
+public:
+
+  //! Ctor.
+  //! \param[in] mode distance calculation mode.
+  asiAlgo_DistanceFunc(const Mode mode = Mode_Signed) : Standard_Transient(), m_mode(mode) {}
+
+public:
+
+  //! Evaluates function for the given coordinates.
+  //! \param[in] x first argument.
+  //! \param[in] y second argument.
+  //! \param[in] z third argument.
+  //! \return evaluated distance.
+  virtual double
+    Eval(const double x, const double y, const double z) const = 0;
+
+public:
+
+  //! \return distance calculation mode.
+  Mode GetMode() const
+  {
+    return m_mode;
+  }
+
+  //! \return min corner of the function domain.
+  const gp_XYZ& GetDomainMin() const
+  {
+    return m_domainMin;
+  }
+
+  //! \return max corner of the function domain.
+  const gp_XYZ& GetDomainMax() const
+  {
+    return m_domainMax;
+  }
+
+  //! Sets the function domain.
+  //! \param[in] domainMin min corner of the domain.
+  //! \param[in] domainMax max corner of the domain.
+  void SetDomain(const gp_XYZ& domainMin, const gp_XYZ& domainMax)
+  {
+    m_domainMin = domainMin;
+    m_domainMax = domainMax;
+  }
+
+protected:
+
+  Mode   m_mode;      //!< Distance calculation mode.
+  gp_XYZ m_domainMin; //!< Min corner of the domain.
+  gp_XYZ m_domainMax; //!< Max corner of the domain.
+
+};
+
+#endif
@@ -38,12 +38,13 @@
 #include <BRep_Tool.hxx>
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
+#include <ElCLib.hxx>
 #include <GCPnts_UniformAbscissa.hxx>
 #include <GCPnts_TangentialDeflection.hxx>
 #include <Geom_Line.hxx>
 #include <GeomAdaptor_Curve.hxx>
 #include <GeomAPI_Interpolate.hxx>
-#include <GeomAPI_ProjectPointOnCurve.hxx>
+#include <NCollection_CellFilter.hxx>
 #include <Precision.hxx>
 #include <ShapeAnalysis_FreeBounds.hxx>
 #include <TColgp_HArray1OfPnt.hxx>
@@ -53,6 +54,12 @@
 #include <TopoDS.hxx>
 #include <TopTools_HSequenceOfShape.hxx>
 
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
 #undef DRAW_DEBUG
 #undef DRAW_DEBUG_SEGMENTATION
 #undef DRAW_DEBUG_APPROX
@@ -77,6 +84,246 @@ int ranged(const int I, const int NUM)
 
 //-----------------------------------------------------------------------------
 
+namespace
+{
+  //! Min number of points in a contour to fit its segments concurrently.
+  const int ParallelMinPts = 1000;
+
+  //! Auxiliary class to search for the points closer than the resolution.
+  class InspectXYZ : public NCollection_CellFilter_InspectorXYZ
+  {
+  public:
+
+    typedef gp_XYZ Target;
+
+    //! Constructor accepting resolution distance and point.
+    InspectXYZ(const double resolution, const gp_XYZ& P) : m_fResolution(resolution), m_bFound(false), m_P(P) {}
+
+    //! \return true/false depending on whether the point was found or not.
+    bool IsFound() const { return m_bFound; }
+
+    //! Implementation of inspection method.
+    NCollection_CellFilter_Action Inspect(const gp_XYZ& Target)
+    {
+      if ( gp_Pnt(Target).Distance(m_P) < m_fResolution )
+        m_bFound = true;
+
+      return CellFilter_Keep;
+    }
+
+  private:
+
+    double m_fResolution; //!< Resolution to check for coincidence.
+    bool   m_bFound;      //!< Whether a close point is found.
+    gp_Pnt m_P;           //!< Source point.
+
+  };
+
+  //! Interpolates the points of a segment parameterized by their projections
+  //! to the principal direction.
+  //! \param[in]  seg     segment to approximate.
+  //! \param[in]  center  center point of the contour.
+  //! \param[in]  prec    precision.
+  //! \param[out] curve   interpolant.
+  //! \param[out] normals unit normals of the contour in the segment's points.
+  void ApproxSegment(const asiAlgo_ReapproxContour::t_segment& seg,
+                     const gp_Pnt&                             center,
+                     const double                              prec,
+                     Handle(Geom_Curve)&                       curve,
+                     std::vector<gp_XYZ>&                      normals)
+  {
+    TColStd_SequenceOfReal params_seq;
+    TColgp_SequenceOfPnt   points_seq;
+
+    // Evaluate parameters filtering out those conflicting against the
+    // principal. Thus we ensure that the resulting curve does not contain
+    // reverse points. As the kept parameters are increasing, it is enough
+    // to compare the coming parameter with the last one.
+    for ( int pt_idx = 1; pt_idx <= seg.Pts->Length(); ++pt_idx )
+    {
+      const gp_Pnt& P = seg.Pts->Value(pt_idx);
+
+      // Project point on principal.
+      const double param = ElCLib::Parameter(seg.Principal, P);
+
+      if ( !params_seq.IsEmpty() && ( param - params_seq.Last() ) < RealEpsilon() )
+        continue;
+
+      params_seq.Append(param);
+      points_seq.Append(P);
+    }
+
+    // Make proper arrays.
+    Handle(TColStd_HArray1OfReal) params = new TColStd_HArray1OfReal( 1, params_seq.Length() );
+    Handle(TColgp_HArray1OfPnt)   points = new TColgp_HArray1OfPnt  ( 1, points_seq.Length() );
+
+    // Populate arrays.
+    const int nSegPts = points->Length();
+    for ( int k = 1; k <= nSegPts; ++k )
+    {
+      params->ChangeValue(k) = params_seq.Value(k);
+      points->ChangeValue(k) = points_seq.Value(k);
+
+      const gp_Pnt& P1 = points_seq.Value(k);
+      const gp_Pnt& P2 = points_seq.Value(k == nSegPts ? 1 : k + 1);
+
+      gp_XYZ n = ( P1.XYZ() - center.XYZ() ).Crossed( P2.XYZ() - center.XYZ() );
+      if ( n.SquareModulus() > Square(prec) )
+        normals.push_back( n.Normalized() );
+    }
+
+    // Interpolate.
+    GeomAPI_Interpolate Interp( points, params, 0, Precision::Confusion() );
+    //
+    Interp.Perform();
+    curve = Interp.Curve();
+  }
+
+  //! Functor approximating the segments of a contour. Each segment has its
+  //! own outputs, so the tasks do not share any mutable data.
+  class ApproxSegmentsFunctor
+  {
+  public:
+
+    ApproxSegmentsFunctor(const std::vector<asiAlgo_ReapproxContour::t_segment>& segments,
+                          const gp_Pnt&                                          center,
+                          const double                                           prec,
+                          std::vector<Handle(Geom_Curve)>&                       curves,
+                          std::vector< std::vector<gp_XYZ> >&                    normals)
+    : m_segments (segments),
+      m_center   (center),
+      m_fPrec    (prec),
+      m_curves   (curves),
+      m_normals  (normals)
+    {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int s = first; s < last; ++s )
+        ApproxSegment(m_segments[s], m_center, m_fPrec, m_curves[s], m_normals[s]);
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const std::vector<asiAlgo_ReapproxContour::t_segment>& m_segments; //!< Segments.
+    gp_Pnt                                                 m_center;   //!< Center of the contour.
+    double                                                 m_fPrec;    //!< Precision.
+    std::vector<Handle(Geom_Curve)>&                       m_curves;   //!< Interpolants.
+    std::vector< std::vector<gp_XYZ> >&                    m_normals;  //!< Normals.
+  };
+
+  //! Functor re-approximating the contours in batch mode.
+  class ReapproxContoursFunctor
+  {
+  public:
+
+    ReapproxContoursFunctor(const std::vector<TopoDS_Shape>& contours,
+                            const double                     precision,
+                            const double                     barrierAngleDeg,
+                            const bool                       useSegments,
+                            const bool                       useAccumulatedAngle,
+                            std::vector<TopoDS_Wire>&        wires,
+                            std::vector<char>&               isDone)
+    : m_contours             (contours),
+      m_fPrec                (precision),
+      m_fBarrierAngleDeg     (barrierAngleDeg),
+      m_bUseSegments         (useSegments),
+      m_bUseAccumulatedAngle (useAccumulatedAngle),
+      m_wires                (wires),
+      m_isDone               (isDone)
+    {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int k = first; k < last; ++k )
+      {
+        // Diagnostic tools are not thread-safe, so the contours are
+        // processed silently. Exceptions are caught not to break the batch.
+        try
+        {
+          asiAlgo_ReapproxContour reapprox(m_contours[k], m_fPrec, m_fBarrierAngleDeg);
+          //
+          m_isDone[k] = reapprox(m_bUseSegments, m_bUseAccumulatedAngle, m_wires[k]) ? 1 : 0;
+        }
+        catch ( ... )
+        {
+          m_isDone[k] = 0;
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const std::vector<TopoDS_Shape>& m_contours;             //!< Contours.
+    double                           m_fPrec;                //!< Precision.
+    double                           m_fBarrierAngleDeg;     //!< Barrier angle.
+    bool                             m_bUseSegments;         //!< Segmentation by edges.
+    bool                             m_bUseAccumulatedAngle; //!< Accumulated angle.
+    std::vector<TopoDS_Wire>&        m_wires;                //!< Resulting wires.
+    std::vector<char>&               m_isDone;               //!< Statuses.
+  };
+}
+
+//-----------------------------------------------------------------------------
+
+int asiAlgo_ReapproxContour::PerformBatch(const std::vector<TopoDS_Shape>& contours,
+                                          const double                     precision,
+                                          const double                     barrierAngleDeg,
+                                          const bool                       useSegments,
+                                          const bool                       useAccumulatedAngle,
+                                          std::vector<TopoDS_Wire>&        wires,
+                                          const bool                       isParallel,
+                                          ActAPI_ProgressEntry             progress)
+{
+#ifndef USE_THREADING
+  asiAlgo_NotUsed(isParallel);
+#endif
+
+  const int numContours = int( contours.size() );
+
+  wires.assign( numContours, TopoDS_Wire() );
+  std::vector<char> isDone(numContours, 0);
+
+  ReapproxContoursFunctor reapproxFunc(contours, precision, barrierAngleDeg,
+                                       useSegments, useAccumulatedAngle,
+                                       wires, isDone);
+  //
+#ifdef USE_THREADING
+  if ( isParallel )
+    tbb::parallel_for(tbb::blocked_range<int>(0, numContours, 1), reapproxFunc);
+  else
+#endif
+    reapproxFunc.Process(0, numContours);
+
+  int numDone = 0;
+  //
+  for ( int k = 0; k < numContours; ++k )
+  {
+    if ( isDone[k] )
+      numDone++;
+    else
+      progress.SendLogMessage( LogWarn(Normal) << "Cannot re-approximate contour %1." << k );
+  }
+
+  return numDone;
+}
+
+//-----------------------------------------------------------------------------
+
 asiAlgo_ReapproxContour::asiAlgo_ReapproxContour(const TopoDS_Shape&  contour,
                                                  const double         precision,
                                                  const double         barrierAngleDeg,
@@ -85,7 +332,8 @@ asiAlgo_ReapproxContour::asiAlgo_ReapproxContour(const TopoDS_Shape&  contour,
 : ActAPI_IAlgorithm  (progress, plotter),
   m_contour          (contour),
   m_fPrec            (precision),
-  m_fBarrierAngleDeg (barrierAngleDeg)
+  m_fBarrierAngleDeg (barrierAngleDeg),
+  m_bIsParallel      (true)
 {
 #if defined COUT_DEBUG
   std::cout << "asiAlgo_ReapproxContour precision: " << precision << std::endl;
@@ -375,110 +623,65 @@ bool asiAlgo_ReapproxContour::doApprox(const std::vector<t_segment>&    segments
   // Check if segmentation was done successfully. Otherwise we cannot
   // re-approximate segment-by-segment.
   bool isSegmented = true;
+  int  numPts      = 0;
   for ( int seg_idx = 0; seg_idx < int( segments.size() ); ++seg_idx )
   {
+    numPts += segments[seg_idx].Pts->Length();
+
     if ( !segments[seg_idx].HasPrincipal )
-    {
       isSegmented = false;
-      break;
-    }
   }
 
-  Handle(TColgp_HSequenceOfPnt) all_points;
-  if ( !isSegmented )
-    all_points = new TColgp_HSequenceOfPnt;
-
   gp_XYZ ori;
   int nTerms = 0;
-  for ( int seg_idx = 0; seg_idx < int( segments.size() ); ++seg_idx )
-  {
-    const t_segment& seg = segments[seg_idx];
-
-    Handle(TColStd_HSequenceOfReal) params_seq = (isSegmented ? new TColStd_HSequenceOfReal : nullptr);
-    Handle(TColgp_HSequenceOfPnt)   points_seq = (isSegmented ? new TColgp_HSequenceOfPnt   : all_points);
-
-    // Evaluate parameters filtering out those conflicting against the
-    // principal. Thus we ensure that the resulting curve does not contain
-    // reverse points.
-    for ( int pt_idx = 1; pt_idx <= seg.Pts->Length(); ++pt_idx )
-    {
-      const gp_Pnt& P = seg.Pts->Value(pt_idx);
-
-      bool isOk = true;
-      if ( isSegmented )
-      {
-        // Project point on principal.
-        GeomAPI_ProjectPointOnCurve Proj( P, new Geom_Line(seg.Principal) );
-        const double param = Proj.Parameter(1);
-
-        // Check that the coming parameter is greater than existing ones.
-        for ( int k = 1; k <= params_seq->Length(); ++k )
-        {
-          if ( ( param - params_seq->Value(k) ) < RealEpsilon() )
-          {
-            isOk = false;
-            break;
-          }
-        }
-
-        if ( isOk )
-          params_seq->Append(param);
-      }
-
-      if ( isOk )
-        points_seq->Append(P);
-    }
-
-    if ( !isSegmented )
-      continue;
-
-    // Make proper arrays.
-    Handle(TColStd_HArray1OfReal) params = new TColStd_HArray1OfReal( 1, params_seq->Length() );
-    Handle(TColgp_HArray1OfPnt)   points = new TColgp_HArray1OfPnt  ( 1, points_seq->Length() );
 
-    // Populate arrays.
-    const int nSegPts = points->Length();
-    for ( int k = 1; k <= nSegPts; ++k )
-    {
-      if ( !params.IsNull() )
-        params->ChangeValue(k) = params_seq->Value(k);
+  if ( isSegmented )
+  {
+    const int numSegments = int( segments.size() );
 
-      points->ChangeValue(k) = points_seq->Value(k);
+    std::vector<Handle(Geom_Curve)>    segCurves(numSegments);
+    std::vector< std::vector<gp_XYZ> > segNormals(numSegments);
 
-      const gp_Pnt& P1 = points_seq->Value(k);
-      const gp_Pnt& P2 = points_seq->Value(k == nSegPts ? 1 : k + 1);
+    ApproxSegmentsFunctor approxFunc(segments, m_center, m_fPrec, segCurves, segNormals);
 
-#if defined DRAW_DEBUG && defined DRAW_DEBUG_APPROX
-      DRAW_INITGROUP(pointseq_approx)
-      DRAW_POINT(P1, pointseq_approx, Draw_blanc, Draw_Plus)
+    // The segments are independent, so they are fitted concurrently for
+    // large contours.
+#ifdef USE_THREADING
+    if ( m_bIsParallel && numPts >= ParallelMinPts )
+      tbb::parallel_for(tbb::blocked_range<int>(0, numSegments, 1), approxFunc);
+    else
 #endif
+      approxFunc.Process(0, numSegments);
 
-      gp_XYZ n = ( P1.XYZ() - m_center.XYZ() ).Crossed( P2.XYZ() - m_center.XYZ() );
-      if ( n.SquareModulus() > Square(m_fPrec) )
+    // Accumulate the orientation in the order of segments, so that the
+    // result does not depend on the multithreading mode.
+    for ( int seg_idx = 0; seg_idx < numSegments; ++seg_idx )
+    {
+      for ( size_t k = 0; k < segNormals[seg_idx].size(); ++k )
       {
-        ori += n.Normalized();
+        ori += segNormals[seg_idx][k];
         ++nTerms;
       }
-    }
 
-    // Interpolate.
-    GeomAPI_Interpolate Interp( points, params, 0, Precision::Confusion() );
-    //
-    Interp.Perform();
-    curves.push_back( Interp.Curve() );
+      curves.push_back(segCurves[seg_idx]);
 
 #if defined DRAW_DEBUG && defined DRAW_DEBUG_APPROX
-    DRAW_INITGROUP(CC_ReapproxContour_curve)
-    DRAW_CURVE(Interp.Curve(), CC_ReapproxContour_curve, Draw_blanc)
+      DRAW_INITGROUP(CC_ReapproxContour_curve)
+      DRAW_CURVE(segCurves[seg_idx], CC_ReapproxContour_curve, Draw_blanc)
 #endif
+    }
   }
-
-  // If no segmentation was done, let's interpolate all points.
-  if ( !isSegmented )
+  else
   {
+    // If no segmentation was done, let's interpolate all points.
+    TColgp_SequenceOfPnt all_points;
+    for ( int seg_idx = 0; seg_idx < int( segments.size() ); ++seg_idx )
+      for ( int pt_idx = 1; pt_idx <= segments[seg_idx].Pts->Length(); ++pt_idx )
+        all_points.Append( segments[seg_idx].Pts->Value(pt_idx) );
+
     // Remove coincident points.
     TColgp_SequenceOfPnt sparsed;
-    this->makeCoarser(all_points->Sequence(), m_fPrec, sparsed);
+    this->makeCoarser(all_points, m_fPrec, sparsed);
 
     // Repack to array.
     Handle(TColgp_HArray1OfPnt) all_points_arr = new TColgp_HArray1OfPnt( 1, sparsed.Length() );
@@ -549,6 +752,11 @@ void asiAlgo_ReapproxContour::makeCoarser(const TColgp_SequenceOfPnt& source,
 #endif
   result.Append( source(1) ); // First point is always in a result.
 
+  // Spatial index of the resulting points to check if a point is already
+  // in the result.
+  NCollection_CellFilter<InspectXYZ> resultFilter(resolution);
+  resultFilter.Add( source(1).XYZ(), source(1).XYZ() );
+
   // Add other points.
   while ( pt_idx < nSource )
   {
@@ -614,17 +822,16 @@ void asiAlgo_ReapproxContour::makeCoarser(const TColgp_SequenceOfPnt& source,
 #endif
 
       // Check if such point is not already in the result.
-      bool cannotAppend = false;
-      for ( int pi = 1; pi <= result.Length(); ++pi )
+      InspectXYZ inspect( resolution, P_next.XYZ() );
+      resultFilter.Inspect( inspect.Shift(P_next.XYZ(), -resolution),
+                            inspect.Shift(P_next.XYZ(),  resolution),
+                            inspect );
+      //
+      if ( !inspect.IsFound() )
       {
-        if ( result(pi).Distance(P_next) < resolution )
-        {
-          cannotAppend = true;
-          break;
-        }
-      }
-      if ( !cannotAppend )
         result.Append(P_next);
+        resultFilter.Add( P_next.XYZ(), P_next.XYZ() );
+      }
     }
 
     pt_idx = next_idx;
@@ -44,6 +44,9 @@
 #include <TColgp_HSequenceOfPnt.hxx>
 #include <TopoDS_Wire.hxx>
 
+// Standard includes
+#include <vector>
+
 //-----------------------------------------------------------------------------
 
 //! Contour re-approximation (healing) is a common tool which is designed to
@@ -85,6 +88,30 @@ public:
     Handle(TColgp_HSequenceOfPnt) Pts;
   };
 
+public:
+
+  //! Re-approximates the passed contours in batch mode. Each contour is
+  //! processed by its own instance of the tool, so the resulting wires are
+  //! the same as if the contours were re-approximated one by one.
+  //! \param[in]  contours            contours to re-approximate.
+  //! \param[in]  precision           precision to use.
+  //! \param[in]  barrierAngleDeg     barrier angle for segmentation.
+  //! \param[in]  useSegments         indicates whether to use segmentation of wire by edges.
+  //! \param[in]  useAccumulatedAngle indicates whether to use accumulated angle for segmentation.
+  //! \param[out] wires               resulting wires (null for failed contours).
+  //! \param[in]  isParallel          indicates whether to process the contours concurrently.
+  //! \param[in]  progress            progress notifier.
+  //! \return number of re-approximated contours.
+  asiAlgo_EXPORT static int
+    PerformBatch(const std::vector<TopoDS_Shape>& contours,
+                 const double                     precision,
+                 const double                     barrierAngleDeg,
+                 const bool                       useSegments,
+                 const bool                       useAccumulatedAngle,
+                 std::vector<TopoDS_Wire>&        wires,
+                 const bool                       isParallel = true,
+                 ActAPI_ProgressEntry             progress   = nullptr);
+
 public:
 
   //! Ctor.
@@ -114,6 +141,14 @@ public:
     return m_ori;
   }
 
+  //! Sets multithreading mode (parallel or sequential). In parallel mode,
+  //! the segments of large contours are approximated concurrently.
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
 public:
 
   //! Performs reapproximation.
@@ -177,6 +212,7 @@ private:
   gp_Pnt       m_center;           //!< Center point of the contour.
   gp_Vec       m_ori;              //!< Orientation vector.
   bool         m_bClosed;          //!< Indicates whether the contour is closed.
+  bool         m_bIsParallel;      //!< Multithreading mode.
 
 };
 
@@ -27,7 +27,6 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //-----------------------------------------------------------------------------
-
 // Own include
 #include <asiAlgo_ResampleADF.h>
 
@@ -40,10 +39,9 @@
   #include <parallel_for.h>
 #endif
 
-#ifdef USE_MOBIUS
-#ifdef USE_THREADING
+//-----------------------------------------------------------------------------
 
-//! Intel TBB functor for parallel evaluation of distance field hosted in
+//! Functor for (parallel) evaluation of distance field hosted in
 //! adaptive octree (ADF).
 template <typename T>
 class ParallelEvalFunctor
@@ -51,7 +49,7 @@ class ParallelEvalFunctor
 public:
 
   //! Ctor initializing the functor.
-  ParallelEvalFunctor(poly_SVO*                             pSVO,
+  ParallelEvalFunctor(const asiAlgo_SVO*                    pSVO,
                       const T                               xStep,
                       const T                               yStep,
                       const T                               zStep,
@@ -65,68 +63,59 @@ public:
     m_fZStep = zStep;
 
     // Domain.
-    m_fXMin = (T) pSVO->GetP0().X();
-    m_fYMin = (T) pSVO->GetP0().Y();
-    m_fZMin = (T) pSVO->GetP0().Z();
+    m_fXMin = (T) pSVO->GetCornerMin().X();
+    m_fYMin = (T) pSVO->GetCornerMin().Y();
+    m_fZMin = (T) pSVO->GetCornerMin().Z();
 
     // Array of scalars.
     m_grid = grid;
   }
 
-  //! Body of parallel evaluation.
-  //! \param[in] range three-dimensional range for task stealing.
-  void operator()(const tbb::blocked_range3d<int>& range) const
+  //! Evaluates the block of grid nodes. The X index runs in the innermost
+  //! loop to follow the memory layout of the grid.
+  void Process(const int begPag, const int endPag,
+               const int begRow, const int endRow,
+               const int begCol, const int endCol) const
   {
-    const int begPag = range.pages().begin();
-    const int endPag = range.pages().end();
-    const int begRow = range.rows().begin();
-    const int endRow = range.rows().end();
-    const int begCol = range.cols().begin();
-    const int endCol = range.cols().end();
-
     T x = 0., y = 0., z = 0.;
 
     // Process the block of data.
-    for ( int i = begPag; i != endPag; ++i )
+    for ( int k = begPag; k != endPag; ++k )
     {
-      x = m_fXMin + m_fXStep*i;
+      z = m_fZMin + m_fZStep*k;
       for ( int j = begRow; j != endRow; ++j )
       {
         y = m_fYMin + m_fYStep*j;
-        for ( int k = begCol; k != endCol; ++k )
-        {
-          z = m_fZMin + m_fZStep*k;
 
-          // Evaluate scalar.
-          const T s = (T) m_pSVO->Eval( t_xyz(x, y, z), false );
+        T* pRow = &m_grid->ChangeValue(0, j, k);
+        //
+        for ( int i = begCol; i != endCol; ++i )
+        {
+          x = m_fXMin + m_fXStep*i;
 
-          // Put in the grid.
-          m_grid->pArray[i][j][k] = s;
+          // Evaluate scalar and put it in the grid.
+          pRow[i] = (T) m_pSVO->Eval( gp_XYZ(x, y, z) );
         }
       }
     }
   }
 
-private:
-
-  //! Calculates unique ID for the three-dimensional data grain by the
-  //! given row & column indices. These indices normally represent
-  //! the starting indices of the block.
-  //! \param[in] i index along OX axis.
-  //! \param[in] j index along OY axis.
-  //! \param[in] k index along OZ axis.
-  //! \return unique identifier of the data grain.
-  inline int rangeId(const int i,
-                     const int j,
-                     const int k) const
+#ifdef USE_THREADING
+  //! Body of parallel evaluation.
+  //! \param[in] range three-dimensional range for task stealing (pages
+  //!                  run along OZ, columns run along OX).
+  void operator()(const tbb::blocked_range3d<int>& range) const
   {
-    return m_grid->Nx*m_grid->Ny*k + m_grid->Nx*j + i;
+    this->Process( range.pages().begin(), range.pages().end(),
+                   range.rows().begin(),  range.rows().end(),
+                   range.cols().begin(),  range.cols().end() );
   }
+#endif
 
 private:
 
   /* Octree. */
-  poly_SVO* m_pSVO;
+  const asiAlgo_SVO* m_pSVO;
 
   /* Steps. */
   T m_fXStep, m_fYStep, m_fZStep;
@@ -139,12 +128,9 @@ private:
 
 };
 
-#endif // USE_THREADING
-#endif // USE_MOBIUS
-
 //-----------------------------------------------------------------------------
 
-asiAlgo_ResampleADF::asiAlgo_ResampleADF(void*                pSVO,
+asiAlgo_ResampleADF::asiAlgo_ResampleADF(const asiAlgo_SVO*   pSVO,
                                          ActAPI_ProgressEntry progress,
                                          ActAPI_PlotterEntry  plotter)
 : ActAPI_IAlgorithm (progress, plotter),
@@ -156,19 +142,16 @@ asiAlgo_ResampleADF::asiAlgo_ResampleADF(void*                pSVO,
 
 bool asiAlgo_ResampleADF::Perform(const float step)
 {
-#ifdef USE_MOBIUS
   if ( m_pSVO == nullptr )
     return false;
 
-  poly_SVO* pSVO = static_cast<poly_SVO*>(m_pSVO);
-
   // Domain.
-  const double xMin = pSVO->GetP0().X();
-  const double yMin = pSVO->GetP0().Y();
-  const double zMin = pSVO->GetP0().Z();
-  const double xMax = pSVO->GetP7().X();
-  const double yMax = pSVO->GetP7().Y();
-  const double zMax = pSVO->GetP7().Z();
+  const double xMin = m_pSVO->GetCornerMin().X();
+  const double yMin = m_pSVO->GetCornerMin().Y();
+  const double zMin = m_pSVO->GetCornerMin().Z();
+  const double xMax = m_pSVO->GetCornerMax().X();
+  const double yMax = m_pSVO->GetCornerMax().Y();
+  const double zMax = m_pSVO->GetCornerMax().Z();
 
   m_plotter.REDRAW_POINT("P0", gp_Pnt(xMin, yMin, zMin), Color_Red);
   m_plotter.REDRAW_POINT("P7", gp_Pnt(xMax, yMax, zMax), Color_Blue);
@@ -190,30 +173,21 @@ bool asiAlgo_ResampleADF::Perform(const float step)
                                             nx, ny, nz,
                                            (float) step );
 
-#ifdef USE_THREADING
   // Compute scalars.
+  ParallelEvalFunctor<float> evalFunc(m_pSVO, xStep, yStep, zStep, m_grid);
+  //
+#ifdef USE_THREADING
   if ( m_bIsParallel )
   {
-    tbb::parallel_for(
-      tbb::blocked_range3d<int>(0, nx + 1, 0, ny + 1, 0, nz + 1),
-      ParallelEvalFunctor<float>(pSVO, xStep, yStep, zStep, m_grid)
-    );
+    tbb::parallel_for(tbb::blocked_range3d<int>(0, nz + 1, 0, ny + 1, 0, nx + 1), evalFunc);
   }
   else
+#endif
   {
-    ParallelEvalFunctor<float> Eval(pSVO, xStep, yStep, zStep, m_grid);
-    Eval( tbb::blocked_range3d<int>(0, nx + 1, 0, ny + 1, 0, nz + 1) );
+    evalFunc.Process(0, nz + 1, 0, ny + 1, 0, nx + 1);
   }
 
   return true;
-#else
-  m_progress.SendLogMessage(LogErr(Normal) << "Threading is not available. Configure with TBB.");
-  return false;
-#endif
-#else
-  m_progress.SendLogMessage(LogErr(Normal) << "Mobius is not available.");
-  return false;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -32,18 +32,12 @@
 #define asiAlgo_ResampleADF_h
 
 // asiAlgo includes
+#include <asiAlgo_SVO.h>
 #include <asiAlgo_UniformGrid.h>
 
 // Active Data includes
 #include <ActAPI_IAlgorithm.h>
 
-#ifdef USE_MOBIUS
-  // Mobius includes
-  #include <mobius/poly_SVO.h>
-
-  using namespace mobius;
-#endif
-
 // Standard includes
 #include <string>
 #include <ostream>
@@ -55,11 +49,11 @@ class asiAlgo_ResampleADF : public ActAPI_IAlgorithm
 public:
 
   //! Ctor.
-  //! \param[in] pSVO     root SVO node representing the ADF.
+  //! \param[in] pSVO     octree representing the ADF.
   //! \param[in] progress progress notifier.
   //! \param[in] plotter  imperative plotter.
   asiAlgo_EXPORT
-    asiAlgo_ResampleADF(void*                pSVO,
+    asiAlgo_ResampleADF(const asiAlgo_SVO*   pSVO,
                         ActAPI_ProgressEntry progress = nullptr,
                         ActAPI_PlotterEntry  plotter  = nullptr);
 
@@ -82,8 +76,8 @@ public:
 
 protected:
 
-  //! Root SVO node.
-  void* m_pSVO;
+  //! Octree to resample.
+  const asiAlgo_SVO* m_pSVO;
 
   //! Uniform grid which is the result of the uniform sampling.
   Handle(asiAlgo_UniformGrid<float>) m_grid;
@@ -0,0 +1,189 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_ResampleADFInput.h>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+//! Functor evaluating the rows of a single XOY slice of the distance field.
+class EvalSliceFunctor
+{
+public:
+
+  //! Ctor initializing the functor.
+  EvalSliceFunctor(const asiAlgo_SVO* pSVO,
+                   const float        xMin,
+                   const float        yMin,
+                   const float        z,
+                   const float        step,
+                   const int          sizeX,
+                   float*             pSlice)
+  : m_pSVO   (pSVO),
+    m_fXMin  (xMin),
+    m_fYMin  (yMin),
+    m_fZ     (z),
+    m_fStep  (step),
+    m_iSizeX (sizeX),
+    m_pSlice (pSlice)
+  {}
+
+#ifdef USE_THREADING
+  //! Body of parallel evaluation.
+  //! \param[in] range range of rows for task stealing.
+  void operator()(const tbb::blocked_range<int>& range) const
+  {
+    this->Eval( range.begin(), range.end() );
+  }
+#endif
+
+  //! Evaluates the rows in the given range.
+  //! \param[in] jFirst first row.
+  //! \param[in] jLast  row after the last one.
+  void Eval(const int jFirst, const int jLast) const
+  {
+    for ( int j = jFirst; j != jLast; ++j )
+    {
+      const float y    = m_fYMin + m_fStep*j;
+      float*      pRow = m_pSlice + size_t(j)*m_iSizeX;
+      //
+      for ( int i = 0; i < m_iSizeX; ++i )
+        pRow[i] = (float) m_pSVO->Eval( gp_XYZ(m_fXMin + m_fStep*i, y, m_fZ) );
+    }
+  }
+
+private:
+
+  const asiAlgo_SVO* m_pSVO;   //!< Octree.
+  float              m_fXMin;  //!< Min X.
+  float              m_fYMin;  //!< Min Y.
+  float              m_fZ;     //!< Z coordinate of the slice.
+  float              m_fStep;  //!< Step.
+  int                m_iSizeX; //!< Number of samples in a row.
+  float*             m_pSlice; //!< Slice to fill.
+
+};
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_ResampleADFInput::asiAlgo_ResampleADFInput(const asiAlgo_SVO*   pSVO,
+                                                   const float          step,
+                                                   ActAPI_ProgressEntry progress)
+: asiAlgo_WriteREKInput (),
+  m_pSVO                (pSVO),
+  m_fStep               (step),
+  m_fXMin               (0.f),
+  m_fYMin               (0.f),
+  m_fZMin               (0.f),
+  m_iNx                 (-1),
+  m_iNy                 (-1),
+  m_iNz                 (-1),
+  m_bIsParallel         (true),
+  m_progress            (progress)
+{
+  if ( m_pSVO == nullptr || m_fStep <= 0.f )
+    return;
+
+  // Domain.
+  const double xMin = m_pSVO->GetCornerMin().X();
+  const double yMin = m_pSVO->GetCornerMin().Y();
+  const double zMin = m_pSVO->GetCornerMin().Z();
+  const double xMax = m_pSVO->GetCornerMax().X();
+  const double yMax = m_pSVO->GetCornerMax().Y();
+  const double zMax = m_pSVO->GetCornerMax().Z();
+
+  m_fXMin = (float) xMin;
+  m_fYMin = (float) yMin;
+  m_fZMin = (float) zMin;
+
+  // Number of cells in each dimension (the same as in asiAlgo_ResampleADF).
+  m_iNx = int( (xMax - xMin) / m_fStep ) + 1;
+  m_iNy = int( (yMax - yMin) / m_fStep ) + 1;
+  m_iNz = int( (zMax - zMin) / m_fStep ) + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+int asiAlgo_ResampleADFInput::GetSizeX() const
+{
+  return m_iNx + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+int asiAlgo_ResampleADFInput::GetSizeY() const
+{
+  return m_iNy + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+int asiAlgo_ResampleADFInput::GetSizeZ() const
+{
+  return m_iNz + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+float asiAlgo_ResampleADFInput::GetVoxelSize() const
+{
+  return m_fStep;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ResampleADFInput::FillSlice(const int k, float* pSlice)
+{
+  if ( m_pSVO == nullptr || k < 0 || k > m_iNz )
+    return false;
+
+  EvalSliceFunctor Eval( m_pSVO,
+                         m_fXMin, m_fYMin, m_fZMin + m_fStep*k, m_fStep,
+                         this->GetSizeX(), pSlice );
+
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for( tbb::blocked_range<int>( 0, this->GetSizeY() ), Eval );
+  else
+#endif
+    Eval.Eval( 0, this->GetSizeY() );
+
+  // Allow cancellation between slices.
+  if ( m_progress.IsCancelling() )
+    return false;
+
+  return true;
+}
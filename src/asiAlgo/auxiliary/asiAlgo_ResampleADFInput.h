@@ -0,0 +1,110 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_ResampleADFInput_h
+#define asiAlgo_ResampleADFInput_h
+
+// asiAlgo includes
+#include <asiAlgo_SVO.h>
+#include <asiAlgo_WriteREKInput.h>
+
+// Active Data includes
+#include <ActAPI_IAlgorithm.h>
+
+//! Data provider for the streaming REK writer which evaluates an Adaptive
+//! Distance Field slice by slice. Unlike asiAlgo_ResampleADF, this provider
+//! does not allocate the uniform grid, so the size of the generated volume
+//! is not limited by the available memory.
+class asiAlgo_ResampleADFInput : public asiAlgo_WriteREKInput
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_ResampleADFInput, asiAlgo_WriteREKInput)
+
+public:
+
+  //! Ctor.
+  //! \param[in] pSVO     octree representing the ADF.
+  //! \param[in] step     discretization step.
+  //! \param[in] progress progress notifier.
+  asiAlgo_EXPORT
+    asiAlgo_ResampleADFInput(const asiAlgo_SVO*   pSVO,
+                             const float          step,
+                             ActAPI_ProgressEntry progress = nullptr);
+
+public:
+
+  asiAlgo_EXPORT virtual int
+    GetSizeX() const;
+
+  asiAlgo_EXPORT virtual int
+    GetSizeY() const;
+
+  asiAlgo_EXPORT virtual int
+    GetSizeZ() const;
+
+  asiAlgo_EXPORT virtual float
+    GetVoxelSize() const;
+
+  //! Evaluates the distance field in the nodes of the XOY slice with the
+  //! given index. The rows of the slice are evaluated concurrently if the
+  //! parallel mode is on.
+  //! \param[in]  k      0-based index of the slice along OZ axis.
+  //! \param[out] pSlice buffer to fill.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT virtual bool
+    FillSlice(const int k, float* pSlice);
+
+public:
+
+  //! Sets multithreading mode (parallel or sequential).
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+protected:
+
+  const asiAlgo_SVO*   m_pSVO;        //!< Octree.
+  float                m_fStep;       //!< Discretization step.
+  float                m_fXMin;       //!< Min X of the domain.
+  float                m_fYMin;       //!< Min Y of the domain.
+  float                m_fZMin;       //!< Min Z of the domain.
+  int                  m_iNx;         //!< Number of cells along OX.
+  int                  m_iNy;         //!< Number of cells along OY.
+  int                  m_iNz;         //!< Number of cells along OZ.
+  bool                 m_bIsParallel; //!< Multithreading mode.
+  ActAPI_ProgressEntry m_progress;    //!< Progress notifier.
+
+};
+
+#endif
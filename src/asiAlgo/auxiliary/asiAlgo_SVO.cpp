@@ -0,0 +1,260 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_SVO.h>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_SVO::GetChildBounds(const gp_XYZ& pmin,
+                                 const gp_XYZ& pmax,
+                                 const int     childId,
+                                 gp_XYZ&       cmin,
+                                 gp_XYZ&       cmax)
+{
+  const gp_XYZ mid = (pmin + pmax)*0.5;
+
+  for ( int a = 1; a <= 3; ++a )
+  {
+    if ( childId & ( 1 << (a - 1) ) )
+    {
+      cmin.SetCoord( a, mid.Coord(a) );
+      cmax.SetCoord( a, pmax.Coord(a) );
+    }
+    else
+    {
+      cmin.SetCoord( a, pmin.Coord(a) );
+      cmax.SetCoord( a, mid.Coord(a) );
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_SVO::asiAlgo_SVO(const gp_XYZ& cornerMin,
+                         const gp_XYZ& cornerMax)
+: m_cornerMin (cornerMin),
+  m_cornerMax (cornerMax),
+  m_nodes     (1)
+{}
+
+//-----------------------------------------------------------------------------
+
+int asiAlgo_SVO::Split(const int node)
+{
+  const int first = int( m_nodes.size() );
+  //
+  m_nodes.resize(m_nodes.size() + 8);
+  m_nodes[node].Children = first;
+
+  return first;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_SVO::Reserve(const int numNodes)
+{
+  m_nodes.reserve(numNodes);
+}
+
+//-----------------------------------------------------------------------------
+
+double asiAlgo_SVO::Eval(const gp_XYZ& P) const
+{
+  // Clamp the point to the root cell.
+  gp_XYZ Q;
+  for ( int a = 1; a <= 3; ++a )
+    Q.SetCoord( a, std::min( std::max( P.Coord(a), m_cornerMin.Coord(a) ), m_cornerMax.Coord(a) ) );
+  //
+  const double outDist = (P - Q).Modulus();
+
+  // Descend to the leaf containing the point.
+  int    node = 0;
+  gp_XYZ pmin = m_cornerMin, pmax = m_cornerMax;
+  //
+  while ( m_nodes[node].Children >= 0 )
+  {
+    const gp_XYZ mid = (pmin + pmax)*0.5;
+
+    int childId = 0;
+    for ( int a = 1; a <= 3; ++a )
+    {
+      if ( Q.Coord(a) >= mid.Coord(a) )
+      {
+        childId |= ( 1 << (a - 1) );
+        pmin.SetCoord( a, mid.Coord(a) );
+      }
+      else
+        pmax.SetCoord( a, mid.Coord(a) );
+    }
+
+    node = m_nodes[node].Children + childId;
+  }
+
+  // Local coordinates in the leaf.
+  double t[3];
+  for ( int a = 1; a <= 3; ++a )
+  {
+    const double d = pmax.Coord(a) - pmin.Coord(a);
+    t[a - 1] = ( d > 0. ) ? ( Q.Coord(a) - pmin.Coord(a) )/d : 0.;
+  }
+
+  // Trilinear interpolation.
+  const float* sc = m_nodes[node].Scalars;
+  //
+  const double c00 = sc[0]*(1. - t[0]) + sc[1]*t[0];
+  const double c10 = sc[2]*(1. - t[0]) + sc[3]*t[0];
+  const double c01 = sc[4]*(1. - t[0]) + sc[5]*t[0];
+  const double c11 = sc[6]*(1. - t[0]) + sc[7]*t[0];
+  const double c0  = c00*(1. - t[1]) + c10*t[1];
+  const double c1  = c01*(1. - t[1]) + c11*t[1];
+
+  return c0*(1. - t[2]) + c1*t[2] + outDist;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_SVO::FindCell(const std::vector<int>& path,
+                           t_cell&                 cell) const
+{
+  cell = t_cell(0, m_cornerMin, m_cornerMax);
+
+  for ( size_t k = 0; k < path.size(); ++k )
+  {
+    if ( path[k] < 0 || path[k] > 7 || this->IsLeaf(cell.Node) )
+      return false;
+
+    gp_XYZ cmin, cmax;
+    GetChildBounds(cell.Min, cell.Max, path[k], cmin, cmax);
+    //
+    cell = t_cell(m_nodes[cell.Node].Children + path[k], cmin, cmax);
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_SVO* asiAlgo_SVO::Extract(const t_cell& cell) const
+{
+  asiAlgo_SVO* pResult = new asiAlgo_SVO(cell.Min, cell.Max);
+
+  // Copy the subtree breadth-first, so the blocks of children stay
+  // contiguous. The pairs map source nodes to the result nodes.
+  std::vector< std::pair<int, int> > queue;
+  queue.push_back( std::pair<int, int>(cell.Node, 0) );
+  //
+  for ( size_t q = 0; q < queue.size(); ++q )
+  {
+    const int src = queue[q].first;
+    const int dst = queue[q].second;
+
+    std::copy( m_nodes[src].Scalars, m_nodes[src].Scalars + 8, pResult->m_nodes[dst].Scalars );
+
+    if ( this->IsLeaf(src) )
+      continue;
+
+    const int first = pResult->Split(dst);
+    //
+    for ( int k = 0; k < 8; ++k )
+      queue.push_back( std::pair<int, int>(m_nodes[src].Children + k, first + k) );
+  }
+
+  return pResult;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_SVO::GetLeaves(std::vector<t_cell>& leaves,
+                            const int            membership) const
+{
+  std::vector<t_cell> stack;
+  stack.push_back( t_cell(0, m_cornerMin, m_cornerMax) );
+
+  while ( !stack.empty() )
+  {
+    const t_cell cell = stack.back();
+    stack.pop_back();
+
+    if ( this->IsLeaf(cell.Node) )
+    {
+      if ( this->Classify(cell.Node) & membership )
+        leaves.push_back(cell);
+
+      continue;
+    }
+
+    // Push children in reverse order to visit them in the natural one.
+    for ( int k = 7; k >= 0; --k )
+    {
+      t_cell child;
+      child.Node = m_nodes[cell.Node].Children + k;
+      GetChildBounds(cell.Min, cell.Max, k, child.Min, child.Max);
+      //
+      stack.push_back(child);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_Membership asiAlgo_SVO::Classify(const int node) const
+{
+  const float* sc = m_nodes[node].Scalars;
+
+  bool hasPositive = false, hasNegative = false;
+  //
+  for ( int k = 0; k < 8; ++k )
+  {
+    if ( sc[k] > 0.f )
+      hasPositive = true;
+    else if ( sc[k] < 0.f )
+      hasNegative = true;
+  }
+
+  if ( !hasPositive )
+    return Membership_In;
+
+  if ( !hasNegative )
+    return Membership_Out;
+
+  return Membership_On;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long asiAlgo_SVO::GetMemoryInBytes() const
+{
+  return sizeof(asiAlgo_SVO) + m_nodes.capacity()*sizeof(t_node);
+}
@@ -0,0 +1,238 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_SVO_h
+#define asiAlgo_SVO_h
+
+// asiAlgo includes
+#include <asiAlgo_Membership.h>
+
+// OCCT includes
+#include <gp_XYZ.hxx>
+
+// Standard includes
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+//! Sparse voxel octree (SVO) storing the values of a scalar function in the
+//! corners of its cells. The nodes are kept in a single contiguous array
+//! with the root at index 0. The eight children of a node occupy a block of
+//! consecutive nodes, so a node refers to its children with the index of
+//! the first one and does not store any pointers or geometry. The bounds of
+//! a cell are derived from the bounds of its parent while descending.
+//!
+//! The corners (and the children) of a cell are numbered as
+//! nx + 2*ny + 4*nz, where nx, ny and nz are 0 for the min and 1 for the max
+//! coordinate along the corresponding axis.
+class asiAlgo_SVO
+{
+public:
+
+  //! Node of the octree.
+  struct t_node
+  {
+    float Scalars[8]; //!< Function values in the cell corners.
+    int   Children;   //!< Index of the first child or -1 for leaves.
+
+    t_node() : Children(-1)
+    {
+      for ( int k = 0; k < 8; ++k )
+        Scalars[k] = 0.f;
+    }
+  };
+
+  //! Cell of the octree with its bounds.
+  struct t_cell
+  {
+    int    Node; //!< Node index.
+    gp_XYZ Min;  //!< Min corner.
+    gp_XYZ Max;  //!< Max corner.
+
+    t_cell() : Node(-1) {}
+    t_cell(const int node, const gp_XYZ& pmin, const gp_XYZ& pmax) : Node(node), Min(pmin), Max(pmax) {}
+  };
+
+public:
+
+  //! Returns the index of a corner (or a child) by its position.
+  //! \param[in] nx 0 for min X, 1 for max X.
+  //! \param[in] ny 0 for min Y, 1 for max Y.
+  //! \param[in] nz 0 for min Z, 1 for max Z.
+  //! \return corner index.
+  static int GetCornerID(const int nx, const int ny, const int nz)
+  {
+    return nx | (ny << 1) | (nz << 2);
+  }
+
+  //! Computes the bounds of a child cell.
+  //! \param[in]  pmin    min corner of the parent cell.
+  //! \param[in]  pmax    max corner of the parent cell.
+  //! \param[in]  childId index of the child.
+  //! \param[out] cmin    min corner of the child cell.
+  //! \param[out] cmax    max corner of the child cell.
+  asiAlgo_EXPORT static void
+    GetChildBounds(const gp_XYZ& pmin,
+                   const gp_XYZ& pmax,
+                   const int     childId,
+                   gp_XYZ&       cmin,
+                   gp_XYZ&       cmax);
+
+public:
+
+  //! Ctor creating the root cell with zero scalars.
+  //! \param[in] cornerMin min corner of the root cell.
+  //! \param[in] cornerMax max corner of the root cell.
+  asiAlgo_EXPORT
+    asiAlgo_SVO(const gp_XYZ& cornerMin,
+                const gp_XYZ& cornerMax);
+
+public:
+
+  //! \return min corner of the root cell.
+  const gp_XYZ& GetCornerMin() const
+  {
+    return m_cornerMin;
+  }
+
+  //! \return max corner of the root cell.
+  const gp_XYZ& GetCornerMax() const
+  {
+    return m_cornerMax;
+  }
+
+  //! \return number of nodes.
+  int GetNumNodes() const
+  {
+    return int( m_nodes.size() );
+  }
+
+  //! \param[in] node node index.
+  //! \return node.
+  const t_node& GetNode(const int node) const
+  {
+    return m_nodes[node];
+  }
+
+  //! \param[in] node node index.
+  //! \return node for modification.
+  t_node& ChangeNode(const int node)
+  {
+    return m_nodes[node];
+  }
+
+  //! \param[in] node node index.
+  //! \return true if the node has no children.
+  bool IsLeaf(const int node) const
+  {
+    return m_nodes[node].Children < 0;
+  }
+
+  //! \param[in] node    node index.
+  //! \param[in] childId index of the child in [0, 7].
+  //! \return index of the child node or -1 for leaves.
+  int GetChild(const int node, const int childId) const
+  {
+    const int first = m_nodes[node].Children;
+    return (first < 0) ? -1 : first + childId;
+  }
+
+  //! \param[in] node   node index.
+  //! \param[in] corner corner index.
+  //! \return scalar value in the corner.
+  double GetScalar(const int node, const int corner) const
+  {
+    return m_nodes[node].Scalars[corner];
+  }
+
+public:
+
+  //! Allocates eight children of the leaf node. The scalars of children are
+  //! initialized with zeros.
+  //! \param[in] node leaf node index.
+  //! \return index of the first child.
+  asiAlgo_EXPORT int
+    Split(const int node);
+
+  //! Reserves memory for the given number of nodes.
+  //! \param[in] numNodes number of nodes.
+  asiAlgo_EXPORT void
+    Reserve(const int numNodes);
+
+  //! Evaluates the function by trilinear interpolation in the leaf
+  //! containing the given point. Outside of the root cell, the value in the
+  //! closest point of the cell is increased by the distance to it.
+  //! \param[in] P point to evaluate the function in.
+  //! \return function value.
+  asiAlgo_EXPORT double
+    Eval(const gp_XYZ& P) const;
+
+  //! Finds the cell by its path from the root.
+  //! \param[in]  path indices of children from the root.
+  //! \param[out] cell found cell.
+  //! \return false if the path does not exist.
+  asiAlgo_EXPORT bool
+    FindCell(const std::vector<int>& path,
+             t_cell&                 cell) const;
+
+  //! Creates a new octree for the subtree of the given cell.
+  //! \param[in] cell root cell of the subtree.
+  //! \return new octree to be deleted by the caller.
+  asiAlgo_EXPORT asiAlgo_SVO*
+    Extract(const t_cell& cell) const;
+
+  //! Collects leaves of the given membership classes. A leaf is inside if
+  //! none of its scalars is positive, outside if none of its scalars is
+  //! negative and on the boundary otherwise.
+  //! \param[out] leaves     collected leaves.
+  //! \param[in]  membership combination of Membership_In, Membership_On and
+  //!                        Membership_Out flags.
+  asiAlgo_EXPORT void
+    GetLeaves(std::vector<t_cell>& leaves,
+              const int            membership = Membership_InOnOut) const;
+
+  //! \param[in] node node index.
+  //! \return membership class of the node (see GetLeaves()).
+  asiAlgo_EXPORT asiAlgo_Membership
+    Classify(const int node) const;
+
+  //! \return memory occupied by the octree.
+  asiAlgo_EXPORT unsigned long long
+    GetMemoryInBytes() const;
+
+protected:
+
+  gp_XYZ              m_cornerMin; //!< Min corner of the root cell.
+  gp_XYZ              m_cornerMax; //!< Max corner of the root cell.
+  std::vector<t_node> m_nodes;     //!< Nodes with the root at index 0.
+
+};
+
+#endif
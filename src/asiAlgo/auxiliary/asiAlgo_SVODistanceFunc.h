@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_SVODistanceFunc_h
+#define asiAlgo_SVODistanceFunc_h
+
+// asiAlgo includes
+#include <asiAlgo_DistanceFunc.h>
+#include <asiAlgo_SVO.h>
+
+//-----------------------------------------------------------------------------
+
+//! Distance function interpolating the scalars stored in a sparse voxel
+//! octree. The octree is not owned by the function and should outlive it.
+class asiAlgo_SVODistanceFunc : public asiAlgo_DistanceFunc
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_SVODistanceFunc, asiAlgo_DistanceFunc)
+
+public:
+
+  //! Ctor.
+  //! \param[in] pSVO octree to evaluate.
+  asiAlgo_SVODistanceFunc(const asiAlgo_SVO* pSVO)
+  : asiAlgo_DistanceFunc(Mode_Signed), m_pSVO(pSVO)
+  {
+    m_domainMin = pSVO->GetCornerMin();
+    m_domainMax = pSVO->GetCornerMax();
+  }
+
+public:
+
+  //! Evaluates function for the given coordinates.
+  //! \param[in] x first argument.
+  //! \param[in] y second argument.
+  //! \param[in] z third argument.
+  //! \return evaluated distance.
+  virtual double Eval(const double x, const double y, const double z) const
+  {
+    return m_pSVO->Eval( gp_XYZ(x, y, z) );
+  }
+
+protected:
+
+  const asiAlgo_SVO* m_pSVO; //!< Octree to evaluate.
+
+};
+
+#endif
@@ -37,14 +37,30 @@
 // OpenCascade includes
 #include <Standard_Type.hxx>
 
+// Standard includes
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
 //! Convenience class for a three-dimensional array which represents a
-//! uniform voxelization.
+//! uniform voxelization. The scalars are stored in the nodes of the grid,
+//! so there are (Nx + 1) x (Ny + 1) x (Nz + 1) values kept in a single
+//! contiguous buffer. The X index runs fastest, so each XOY slice is a
+//! contiguous block of memory which can be written to a volume file or
+//! processed by a single thread as is.
 template <typename T>
 class asiAlgo_UniformGrid : public Standard_Transient
 {
 public:
 
-  //! Ctor.
+  //! Ctor. The scalars are not initialized.
   //! \param[in] xmin     min X.
   //! \param[in] ymin     min Y.
   //! \param[in] zmin     min Z.
@@ -68,36 +84,338 @@ public:
     Nz       = nz;
     CellSize = cellSize;
 
-    std::cout << "Num. of cells along OX: " << nx << std::endl;
-    std::cout << "Num. of cells along OY: " << ny << std::endl;
-    std::cout << "Num. of cells along OZ: " << nz << std::endl;
-    std::cout << "Memory threshold: " << uint64_t( sizeof(T)*(nx + 1)*(ny + 1)*(nz + 1) ) / (1024.*1024.) << "MiB" << std::endl;
+    // Allocate all scalars at once. The buffer is not value-initialized,
+    // so the pages are touched for the first time by the code filling
+    // the grid.
+    pData = new T[this->GetNumNodes()];
+  }
+
+  //! Dtor.
+  ~asiAlgo_UniformGrid()
+  {
+    delete[] pData;
+  }
+
+public:
+
+  //! \return number of grid nodes.
+  size_t GetNumNodes() const
+  {
+    return size_t(Nx + 1)*size_t(Ny + 1)*size_t(Nz + 1);
+  }
+
+  //! \return number of nodes in a single XOY slice.
+  size_t GetSliceSize() const
+  {
+    return size_t(Nx + 1)*size_t(Ny + 1);
+  }
+
+  //! \return memory occupied by the scalars.
+  unsigned long long GetMemoryInBytes() const
+  {
+    return (unsigned long long) ( this->GetNumNodes()*sizeof(T) );
+  }
+
+  //! Returns the position of the node in the buffer.
+  //! \param[in] i index along OX axis.
+  //! \param[in] j index along OY axis.
+  //! \param[in] k index along OZ axis.
+  //! \return 0-based offset of the node.
+  size_t GetIndex(const int i, const int j, const int k) const
+  {
+    return size_t(i) + size_t(Nx + 1)*( size_t(j) + size_t(Ny + 1)*size_t(k) );
+  }
+
+  //! \param[in] i index along OX axis.
+  //! \param[in] j index along OY axis.
+  //! \param[in] k index along OZ axis.
+  //! \return scalar in the node.
+  T GetValue(const int i, const int j, const int k) const
+  {
+    return pData[this->GetIndex(i, j, k)];
+  }
+
+  //! \param[in] i index along OX axis.
+  //! \param[in] j index along OY axis.
+  //! \param[in] k index along OZ axis.
+  //! \return scalar in the node for modification.
+  T& ChangeValue(const int i, const int j, const int k)
+  {
+    return pData[this->GetIndex(i, j, k)];
+  }
+
+  //! \param[in] k index of the XOY slice.
+  //! \return pointer to the first scalar of the slice.
+  const T* GetSlice(const int k) const
+  {
+    return pData + this->GetSliceSize()*size_t(k);
+  }
+
+  //! \param[in] k index of the XOY slice.
+  //! \return pointer to the first scalar of the slice for modification.
+  T* ChangeSlice(const int k)
+  {
+    return pData + this->GetSliceSize()*size_t(k);
+  }
+
+  //! Sets the same value to all nodes.
+  //! \param[in] val value to set.
+  void Fill(const T val)
+  {
+    std::fill( pData, pData + this->GetNumNodes(), val );
+  }
+
+public:
+
+  //! Evaluates the scalar field by trilinear interpolation. The points out
+  //! of the grid are clamped to its bounds.
+  //! \param[in] x X coordinate.
+  //! \param[in] y Y coordinate.
+  //! \param[in] z Z coordinate.
+  //! \return interpolated value.
+  T Eval(const T x, const T y, const T z) const
+  {
+    int i, j, k;
+    T   u, v, w;
+    this->locate(x, y, z, i, j, k, u, v, w);
+
+    T c[8];
+    this->getCorners(i, j, k, c);
+
+    const T c00 = c[0]*(1 - u) + c[1]*u;
+    const T c10 = c[2]*(1 - u) + c[3]*u;
+    const T c01 = c[4]*(1 - u) + c[5]*u;
+    const T c11 = c[6]*(1 - u) + c[7]*u;
+
+    return ( c00*(1 - v) + c10*v )*(1 - w) + ( c01*(1 - v) + c11*v )*w;
+  }
+
+  //! Evaluates the gradient of the trilinear interpolant. The points out of
+  //! the grid are clamped to its bounds.
+  //! \param[in]  x  X coordinate.
+  //! \param[in]  y  Y coordinate.
+  //! \param[in]  z  Z coordinate.
+  //! \param[out] gx derivative along OX axis.
+  //! \param[out] gy derivative along OY axis.
+  //! \param[out] gz derivative along OZ axis.
+  void EvalGradient(const T x, const T y, const T z,
+                    T&      gx,
+                    T&      gy,
+                    T&      gz) const
+  {
+    int i, j, k;
+    T   u, v, w;
+    this->locate(x, y, z, i, j, k, u, v, w);
+
+    T c[8];
+    this->getCorners(i, j, k, c);
+
+    gx = ( ( (c[1] - c[0])*(1 - v) + (c[3] - c[2])*v )*(1 - w)
+         + ( (c[5] - c[4])*(1 - v) + (c[7] - c[6])*v )*w ) / CellSize;
+    //
+    gy = ( ( (c[2] - c[0])*(1 - u) + (c[3] - c[1])*u )*(1 - w)
+         + ( (c[6] - c[4])*(1 - u) + (c[7] - c[5])*u )*w ) / CellSize;
+    //
+    gz = ( ( (c[4] - c[0])*(1 - u) + (c[5] - c[1])*u )*(1 - v)
+         + ( (c[6] - c[2])*(1 - u) + (c[7] - c[3])*u )*v ) / CellSize;
+  }
+
+public:
+
+  //! Computes the extreme scalars. The slices are processed concurrently
+  //! if the parallel mode is on.
+  //! \param[out] minVal   min scalar.
+  //! \param[out] maxVal   max scalar.
+  //! \param[in]  parallel parallel mode.
+  void ComputeMinMax(T&         minVal,
+                     T&         maxVal,
+                     const bool parallel = true) const
+  {
+    std::vector<T> mins(Nz + 1), maxs(Nz + 1);
+    //
+    MinMaxFunctor func(this, mins, maxs);
+    this->run(func, Nz + 1, parallel);
+
+    minVal = *std::min_element( mins.begin(), mins.end() );
+    maxVal = *std::max_element( maxs.begin(), maxs.end() );
+  }
+
+  //! Counts the cells whose corner values are on different sides of the
+  //! given level. These are the cells polygonized by marching cubes.
+  //! \param[in] iso      iso level.
+  //! \param[in] parallel parallel mode.
+  //! \return number of cells crossed by the level set.
+  size_t CountIsoCrossings(const T    iso,
+                           const bool parallel = true) const
+  {
+    if ( Nz < 1 )
+      return 0;
 
-    pArray = new T**[nx + 1];
+    std::vector<size_t> counts(Nz);
     //
-    for ( int i = 0; i <= nx; ++i )
+    IsoCrossingFunctor func(this, iso, counts);
+    this->run(func, Nz, parallel);
+
+    size_t res = 0;
+    for ( size_t k = 0; k < counts.size(); ++k )
+      res += counts[k];
+
+    return res;
+  }
+
+protected:
+
+  //! Finds the cell containing the given point and the local coordinates
+  //! of the point in the cell.
+  void locate(const T x, const T y, const T z,
+              int& i, int& j, int& k,
+              T&   u, T&   v, T&   w) const
+  {
+    locateAxis( (x - XMin)/CellSize, Nx, i, u );
+    locateAxis( (y - YMin)/CellSize, Ny, j, v );
+    locateAxis( (z - ZMin)/CellSize, Nz, k, w );
+  }
+
+  //! Finds the cell index and the local coordinate along a single axis.
+  static void locateAxis(const T t, const int n, int& idx, T& local)
+  {
+    if ( n < 1 )
+    {
+      idx = 0; local = 0;
+      return;
+    }
+
+    const T tc = std::min( std::max( t, T(0) ), T(n) );
+    //
+    idx   = std::min( int(tc), n - 1 );
+    local = tc - T(idx);
+  }
+
+  //! Gathers the corner scalars of the cell numbered as i + 2*j + 4*k.
+  //! For the grids degenerated along some axis, the corners collapse.
+  void getCorners(const int i, const int j, const int k, T* c) const
+  {
+    const size_t di = (Nx > 0) ? 1 : 0;
+    const size_t dj = (Ny > 0) ? size_t(Nx + 1) : 0;
+    const size_t dk = (Nz > 0) ? this->GetSliceSize() : 0;
+    const T*     p  = pData + this->GetIndex(i, j, k);
+
+    c[0] = p[0];       c[1] = p[di];
+    c[2] = p[dj];      c[3] = p[dj + di];
+    c[4] = p[dk];      c[5] = p[dk + di];
+    c[6] = p[dk + dj]; c[7] = p[dk + dj + di];
+  }
+
+  //! Runs the functor over slices.
+  template <typename TFunc>
+  void run(const TFunc& func, const int numSlices, const bool parallel) const
+  {
+#ifdef USE_THREADING
+    if ( parallel )
+      tbb::parallel_for(tbb::blocked_range<int>(0, numSlices), func);
+    else
+#else
+    (void) parallel;
+#endif
+      func.Process(0, numSlices);
+  }
+
+  //! Computes the extreme scalars in each slice.
+  class MinMaxFunctor
+  {
+  public:
+
+    MinMaxFunctor(const asiAlgo_UniformGrid* pGrid,
+                  std::vector<T>&            mins,
+                  std::vector<T>&            maxs)
+    : m_pGrid(pGrid), m_mins(mins), m_maxs(maxs) {}
+
+    void Process(const int first, const int last) const
     {
-      pArray[i] = new T*[ny + 1];
-      for ( int j = 0; j <= ny; ++j )
+      const size_t sliceSize = m_pGrid->GetSliceSize();
+
+      for ( int k = first; k < last; ++k )
       {
-        pArray[i][j] = new T[nz + 1];
+        const T* pSlice = m_pGrid->GetSlice(k);
+        T        minVal = pSlice[0];
+        T        maxVal = pSlice[0];
+        //
+        for ( size_t n = 1; n < sliceSize; ++n )
+        {
+          minVal = std::min(minVal, pSlice[n]);
+          maxVal = std::max(maxVal, pSlice[n]);
+        }
+
+        m_mins[k] = minVal;
+        m_maxs[k] = maxVal;
       }
     }
-  }
 
-  //! Dtor.
-  ~asiAlgo_UniformGrid()
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const asiAlgo_UniformGrid* m_pGrid; //!< Grid.
+    std::vector<T>&            m_mins;  //!< Min scalar per slice.
+    std::vector<T>&            m_maxs;  //!< Max scalar per slice.
+  };
+
+  //! Counts the cells crossed by the level set in each layer of cells.
+  class IsoCrossingFunctor
   {
-    for ( int i = 0; i <= Nx; ++i )
+  public:
+
+    IsoCrossingFunctor(const asiAlgo_UniformGrid* pGrid,
+                       const T                    iso,
+                       std::vector<size_t>&       counts)
+    : m_pGrid(pGrid), m_fIso(iso), m_counts(counts) {}
+
+    void Process(const int first, const int last) const
     {
-      for ( int j = 0; j <= Ny; ++j )
+      const int nx = m_pGrid->Nx;
+      const int ny = m_pGrid->Ny;
+
+      for ( int k = first; k < last; ++k )
       {
-        delete[] pArray[i][j];
+        size_t count = 0;
+
+        for ( int j = 0; j < ny; ++j )
+          for ( int i = 0; i < nx; ++i )
+          {
+            T c[8];
+            m_pGrid->getCorners(i, j, k, c);
+
+            int below = 0;
+            for ( int n = 0; n < 8; ++n )
+              if ( c[n] < m_fIso )
+                ++below;
+
+            if ( below != 0 && below != 8 )
+              ++count;
+          }
+
+        m_counts[k] = count;
       }
-      delete[] pArray[i];
     }
-    delete[] pArray;
-  }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const asiAlgo_UniformGrid* m_pGrid;  //!< Grid.
+    T                          m_fIso;   //!< Iso level.
+    std::vector<size_t>&       m_counts; //!< Counts per layer of cells.
+  };
 
 public:
 
@@ -110,8 +428,14 @@ public:
   /* Cell size. */
   T CellSize;
 
-  /* Array of scalars. */
-  T*** pArray;
+  /* Contiguous array of scalars (see GetIndex()). */
+  T* pData;
+
+private:
+
+  asiAlgo_UniformGrid(const asiAlgo_UniformGrid&);            //!< Not copyable.
+  asiAlgo_UniformGrid& operator=(const asiAlgo_UniformGrid&); //!< Not assignable.
+
 };
 
 #endif
@@ -0,0 +1,207 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_ReadREK.h>
+
+// OS-dependent includes
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+// Standard includes
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_ReadREK::asiAlgo_ReadREK()
+: m_pData    (nullptr),
+  m_iSize    (0),
+  m_hFile    (nullptr),
+  m_hMapping (nullptr),
+  m_iFile    (-1)
+{}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_ReadREK::~asiAlgo_ReadREK()
+{
+  this->Close();
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ReadREK::Open(const std::string& filename)
+{
+  this->Close();
+
+#ifdef _WIN32
+  HANDLE hFile = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+  //
+  if ( hFile == INVALID_HANDLE_VALUE )
+    return false;
+
+  LARGE_INTEGER fileSize;
+  //
+  if ( !GetFileSizeEx(hFile, &fileSize) )
+  {
+    CloseHandle(hFile);
+    return false;
+  }
+
+  HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  //
+  if ( hMapping == NULL )
+  {
+    CloseHandle(hFile);
+    return false;
+  }
+
+  const void* pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+  //
+  if ( pData == NULL )
+  {
+    CloseHandle(hMapping);
+    CloseHandle(hFile);
+    return false;
+  }
+
+  m_hFile    = hFile;
+  m_hMapping = hMapping;
+  m_pData    = static_cast<const char*>(pData);
+  m_iSize    = (uint64_t) fileSize.QuadPart;
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  //
+  if ( fd < 0 )
+    return false;
+
+  struct stat st;
+  //
+  if ( fstat(fd, &st) != 0 || st.st_size == 0 )
+  {
+    close(fd);
+    return false;
+  }
+
+  void* pData = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  //
+  if ( pData == MAP_FAILED )
+  {
+    close(fd);
+    return false;
+  }
+
+  // Slices are mostly traversed in order.
+  madvise(pData, size_t(st.st_size), MADV_SEQUENTIAL);
+
+  m_iFile = fd;
+  m_pData = static_cast<const char*>(pData);
+  m_iSize = (uint64_t) st.st_size;
+#endif
+
+  // Read header. The fields are taken from their fixed offsets to stay
+  // independent of the structure alignment.
+  if ( m_iSize < uint64_t(asiAlgo_WriteREK::HeaderSize) )
+  {
+    this->Close();
+    return false;
+  }
+  //
+  memcpy( &m_header.SizeX,     m_pData + 0,    sizeof(uint16_t) );
+  memcpy( &m_header.SizeY,     m_pData + 2,    sizeof(uint16_t) );
+  memcpy( &m_header.Pixel,     m_pData + 4,    sizeof(uint16_t) );
+  memcpy( &m_header.SizeZ,     m_pData + 6,    sizeof(uint16_t) );
+  memcpy( &m_header.Res1,      m_pData + 8,    sizeof(char[572]) );
+  memcpy( &m_header.SomeValue, m_pData + 580,  sizeof(float) );
+  memcpy( &m_header.PixelSize, m_pData + 584,  sizeof(float) );
+  memcpy( &m_header.SliceDist, m_pData + 588,  sizeof(float) );
+  memcpy( &m_header.Res2,      m_pData + 592,  sizeof(char[1456]) );
+
+  // Check that the contents correspond to the header.
+  const uint64_t expectedSize = uint64_t(asiAlgo_WriteREK::HeaderSize)
+                              + uint64_t(m_header.SizeX)*m_header.SizeY*m_header.SizeZ*sizeof(float);
+  //
+  if ( m_header.Pixel != 32 || m_iSize < expectedSize )
+  {
+    this->Close();
+    return false;
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_ReadREK::Close()
+{
+#ifdef _WIN32
+  if ( m_pData )
+    UnmapViewOfFile(m_pData);
+
+  if ( m_hMapping )
+    CloseHandle( static_cast<HANDLE>(m_hMapping) );
+
+  if ( m_hFile )
+    CloseHandle( static_cast<HANDLE>(m_hFile) );
+#else
+  if ( m_pData )
+    munmap( const_cast<char*>(m_pData), size_t(m_iSize) );
+
+  if ( m_iFile >= 0 )
+    close(m_iFile);
+#endif
+
+  m_pData    = nullptr;
+  m_iSize    = 0;
+  m_hFile    = nullptr;
+  m_hMapping = nullptr;
+  m_iFile    = -1;
+  m_header   = asiAlgo_WriteREK::t_header();
+}
+
+//-----------------------------------------------------------------------------
+
+const float* asiAlgo_ReadREK::GetSlice(const int k) const
+{
+  if ( !m_pData || k < 0 || k >= m_header.SizeZ )
+    return nullptr;
+
+  const uint64_t offset = uint64_t(asiAlgo_WriteREK::HeaderSize)
+                        + uint64_t(k)*m_header.SizeX*m_header.SizeY*sizeof(float);
+
+  return reinterpret_cast<const float*>(m_pData + offset);
+}
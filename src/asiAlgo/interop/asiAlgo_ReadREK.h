@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_ReadREK_h
+#define asiAlgo_ReadREK_h
+
+// asiAlgo includes
+#include <asiAlgo_WriteREK.h>
+
+// Standard includes
+#include <string>
+
+//! Reads the voxelization stored in Fraunhofer Raw Volumes file format (REK).
+//! The file is memory-mapped, so the slices are accessed directly without
+//! loading the entire volume into memory. Only 32-bit floating-point volumes
+//! are supported.
+class asiAlgo_ReadREK
+{
+public:
+
+  //! Default ctor.
+  asiAlgo_EXPORT
+    asiAlgo_ReadREK();
+
+  //! Dtor. Unmaps the file.
+  asiAlgo_EXPORT
+    ~asiAlgo_ReadREK();
+
+public:
+
+  //! Opens and maps the REK file.
+  //! \param[in] filename file to open.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Open(const std::string& filename);
+
+  //! Unmaps and closes the file.
+  asiAlgo_EXPORT void
+    Close();
+
+  //! Returns pointer to the XOY slice with the given index. The values are
+  //! stored row by row, i.e., the X index runs fastest.
+  //! \param[in] k 0-based index of the slice along OZ axis.
+  //! \return pointer to the first value of the slice or null pointer if
+  //!         the index is out of range.
+  asiAlgo_EXPORT const float*
+    GetSlice(const int k) const;
+
+public:
+
+  //! \return true if the file is mapped.
+  bool IsOpen() const
+  {
+    return m_pData != nullptr;
+  }
+
+  //! \return header of the file.
+  const asiAlgo_WriteREK::t_header& GetHeader() const
+  {
+    return m_header;
+  }
+
+  //! \return number of samples along OX axis.
+  int GetSizeX() const { return m_header.SizeX; }
+
+  //! \return number of samples along OY axis.
+  int GetSizeY() const { return m_header.SizeY; }
+
+  //! \return number of samples along OZ axis.
+  int GetSizeZ() const { return m_header.SizeZ; }
+
+  //! Returns the voxel value without any range checks.
+  //! \param[in] i index along OX axis.
+  //! \param[in] j index along OY axis.
+  //! \param[in] k index along OZ axis.
+  //! \return voxel value.
+  float GetValue(const int i, const int j, const int k) const
+  {
+    return this->GetSlice(k)[size_t(j)*m_header.SizeX + i];
+  }
+
+private:
+
+  asiAlgo_ReadREK(const asiAlgo_ReadREK&);            //!< Not copyable.
+  asiAlgo_ReadREK& operator=(const asiAlgo_ReadREK&); //!< Not assignable.
+
+private:
+
+  asiAlgo_WriteREK::t_header m_header;   //!< File header.
+  const char*                m_pData;    //!< Mapped file contents.
+  uint64_t                   m_iSize;    //!< Size of the mapped file in bytes.
+  void*                      m_hFile;    //!< File handle (Windows only).
+  void*                      m_hMapping; //!< Mapping handle (Windows only).
+  int                        m_iFile;    //!< File descriptor (POSIX only).
+
+};
+
+#endif
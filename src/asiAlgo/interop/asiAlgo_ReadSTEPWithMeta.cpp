@@ -32,31 +32,134 @@
 #include <asiAlgo_ReadSTEPWithMeta.h>
 
 // OpenCascade includes
+#include <BRep_Builder.hxx>
 #include <Interface_EntityIterator.hxx>
 #include <Interface_Graph.hxx>
+#include <OSD_Timer.hxx>
 #include <STEPControl_Controller.hxx>
 #include <STEPConstruct.hxx>
 #include <STEPConstruct_Styles.hxx>
+#include <StepBasic_Product.hxx>
+#include <StepBasic_ProductDefinition.hxx>
+#include <StepBasic_ProductDefinitionFormation.hxx>
 #include <StepRepr_NextAssemblyUsageOccurrence.hxx>
 #include <StepRepr_ProductDefinitionShape.hxx>
+#include <StepRepr_PropertyDefinition.hxx>
 #include <StepRepr_RepresentedDefinition.hxx>
 #include <StepRepr_SpecifiedHigherUsageOccurrence.hxx>
 #include <StepShape_ShapeDefinitionRepresentation.hxx>
 #include <StepShape_ShapeRepresentation.hxx>
+#include <StepVisual_Colour.hxx>
 #include <StepVisual_PresentationStyleByContext.hxx>
 #include <StepVisual_StyledItem.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Iterator.hxx>
+#include <TopTools_SequenceOfShape.hxx>
 #include <Transfer_TransientProcess.hxx>
 #include <TransferBRep.hxx>
 #include <XSControl_TransferReader.hxx>
 #include <XSControl_WorkSession.hxx>
 
+// Standard includes
+#include <algorithm>
+#include <thread>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Max number of transfer workers. Each worker keeps its own copy of the
+  //! STEP model, so this number bounds the memory consumption.
+  const int MaxNumTransferWorkers = 8;
+
+  //! Extracts product name for the given root entity.
+  //! \param[in] root root entity.
+  //! \return product name or empty string if the name is not available.
+  TCollection_AsciiString GetProductName(const Handle(Standard_Transient)& root)
+  {
+    Handle(StepBasic_ProductDefinition)
+      PD = Handle(StepBasic_ProductDefinition)::DownCast(root);
+
+    // Shape definition representations refer to product definitions
+    // through the product definition shapes.
+    if ( PD.IsNull() )
+    {
+      Handle(StepShape_ShapeDefinitionRepresentation)
+        SDR = Handle(StepShape_ShapeDefinitionRepresentation)::DownCast(root);
+      //
+      if ( !SDR.IsNull() )
+      {
+        Handle(StepRepr_PropertyDefinition) PDS = SDR->Definition().PropertyDefinition();
+        //
+        if ( !PDS.IsNull() )
+          PD = PDS->Definition().ProductDefinition();
+      }
+    }
+
+    if ( PD.IsNull() || PD->Formation().IsNull() )
+      return TCollection_AsciiString();
+
+    Handle(StepBasic_Product) product = PD->Formation()->OfProduct();
+    //
+    if ( product.IsNull() || product->Name().IsNull() )
+      return TCollection_AsciiString();
+
+    return product->Name()->String();
+  }
+}
+
+#ifdef USE_THREADING
+
+//! Intel TBB functor for parallel transfer of STEP roots. Each worker owns
+//! a reader with its own STEP model and transfers a contiguous range of roots,
+//! so no data is shared between the concurrent transfer processes.
+class ParallelTransferFunctor
+{
+public:
+
+  //! Ctor initializing the functor.
+  //! \param[in] readers    readers prepared for transfer (one per worker).
+  //! \param[in] firstRoots 1-based index of the first root of each worker
+  //!                       followed by the past-the-end index.
+  ParallelTransferFunctor(const std::vector<STEPControl_Reader*>& readers,
+                          const std::vector<int>&                 firstRoots)
+  : m_readers    (readers),
+    m_firstRoots (firstRoots)
+  {}
+
+  //! Body of parallel transfer.
+  //! \param[in] range range of workers for task stealing.
+  void operator()(const tbb::blocked_range<int>& range) const
+  {
+    for ( int w = range.begin(); w != range.end(); ++w )
+      for ( int r = m_firstRoots[w]; r < m_firstRoots[w + 1]; ++r )
+        m_readers[w]->TransferOneRoot(r);
+  }
+
+private:
+
+  const std::vector<STEPControl_Reader*>& m_readers;    //!< Readers to run.
+  const std::vector<int>&                 m_firstRoots; //!< Ranges of roots.
+
+};
+
+#endif // USE_THREADING
+
 //-----------------------------------------------------------------------------
 
 asiAlgo_ReadSTEPWithMeta::asiAlgo_ReadSTEPWithMeta(ActAPI_ProgressEntry progress,
                                                    ActAPI_PlotterEntry  plotter)
 : ActAPI_IAlgorithm (progress, plotter),
-  m_bColorMode      (true)
+  m_bColorMode      (true),
+  m_bIsParallel     (false),
+  m_fParseTime      (0.),
+  m_bStylesIndexed  (false)
 {
   STEPControl_Controller::Init();
 }
@@ -68,7 +171,10 @@ asiAlgo_ReadSTEPWithMeta::asiAlgo_ReadSTEPWithMeta(const Handle(XSControl_WorkSe
                                                    ActAPI_ProgressEntry                 progress,
                                                    ActAPI_PlotterEntry                  plotter)
 : ActAPI_IAlgorithm (progress, plotter),
-  m_bColorMode      (true)
+  m_bColorMode      (true),
+  m_bIsParallel     (false),
+  m_fParseTime      (0.),
+  m_bStylesIndexed  (false)
 {
   STEPControl_Controller::Init();
   this->Init(WS, scratch);
@@ -86,7 +192,19 @@ void asiAlgo_ReadSTEPWithMeta::Init(const Handle(XSControl_WorkSession)& WS,
 
 IFSelect_ReturnStatus asiAlgo_ReadSTEPWithMeta::ReadFile(const char* filename)
 {
-  return m_reader.ReadFile(filename);
+  m_filename = filename;
+
+  // The parsing time is used to decide whether parsing the file again for
+  // parallel transfer pays off.
+  OSD_Timer timer;
+  timer.Start();
+  //
+  const IFSelect_ReturnStatus status = m_reader.ReadFile(filename);
+  //
+  timer.Stop();
+  m_fParseTime = timer.ElapsedTime();
+
+  return status;
 }
 
 
@@ -109,6 +227,9 @@ bool asiAlgo_ReadSTEPWithMeta::TransferOneRoot(const int num)
 
 bool asiAlgo_ReadSTEPWithMeta::Transfer()
 {
+  if ( m_bIsParallel && m_reader.NbRootsForTransfer() > 1 )
+    return this->transferParallel();
+
   TDF_LabelSequence Lseq;
   return this->transfer(m_reader, 0);
 }
@@ -163,6 +284,129 @@ bool asiAlgo_ReadSTEPWithMeta::GetColorMode() const
 
 //-----------------------------------------------------------------------------
 
+void asiAlgo_ReadSTEPWithMeta::SetParallelMode(const bool on)
+{
+  m_bIsParallel = on;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ReadSTEPWithMeta::IsParallelMode() const
+{
+  return m_bIsParallel;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ReadSTEPWithMeta::ReadStructure(const char* filename)
+{
+  m_structure.clear();
+  m_materialized.Clear();
+  m_itemStyles.Clear();
+  m_invisStyles.Clear();
+  m_rootColors.Clear();
+  m_bStylesIndexed = false;
+
+  if ( this->ReadFile(filename) != IFSelect_RetDone )
+    return false;
+
+  const int numRoots = m_reader.NbRootsForTransfer();
+  //
+  for ( int r = 1; r <= numRoots; ++r )
+  {
+    const Handle(Standard_Transient)& root = m_reader.RootForTransfer(r);
+    //
+    if ( root.IsNull() )
+      continue;
+
+    t_rootInfo info;
+    info.index = r;
+    info.type  = root->DynamicType()->Name();
+    info.name  = GetProductName(root);
+    //
+    m_structure.push_back(info);
+  }
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "Indexed %1 transferable root(s)."
+                                             << int( m_structure.size() ) );
+  return !m_structure.empty();
+}
+
+//-----------------------------------------------------------------------------
+
+const std::vector<asiAlgo_ReadSTEPWithMeta::t_rootInfo>&
+  asiAlgo_ReadSTEPWithMeta::GetStructure() const
+{
+  return m_structure;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ReadSTEPWithMeta::MaterializeRoot(const int     num,
+                                               TopoDS_Shape& shape)
+{
+  // The roots materialized before are only passed to the output again as
+  // the output might have changed since then.
+  if ( !m_materialized.IsBound(num) )
+  {
+    if ( num < 1 || num > m_reader.NbRootsForTransfer() )
+    {
+      m_progress.SendLogMessage(LogErr(Normal) << "Root index %1 is out of range." << num);
+      return false;
+    }
+
+    // The transfer process is not cleared between the calls, and it maps
+    // the entities in the order of their transfer. The entities mapped
+    // after the current number are those of this root.
+    const Handle(Transfer_TransientProcess)&
+      prevTP = m_reader.WS()->TransferReader()->TransientProcess();
+    //
+    const int firstMapped = prevTP.IsNull() ? 1 : prevTP->NbMapped() + 1;
+
+    m_reader.ClearShapes();
+    //
+    if ( !m_reader.TransferOneRoot(num) || m_reader.NbShapes() <= 0 )
+    {
+      m_progress.SendLogMessage(LogErr(Normal) << "Cannot transfer root %1." << num);
+      return false;
+    }
+    //
+    m_materialized.Bind( num, m_reader.OneShape() );
+
+    // Colors of the entities shared with the previous roots are known.
+    if ( m_bColorMode )
+      this->readRootColors(firstMapped);
+
+    for ( size_t k = 0; k < m_structure.size(); ++k )
+      if ( m_structure[k].index == num )
+        m_structure[k].isMaterialized = true;
+  }
+  //
+  shape = m_materialized(num);
+
+  if ( m_output.IsNull() )
+    return true;
+
+  // Pass all materialized roots to the output in the order of indices.
+  TopoDS_Compound comp;
+  BRep_Builder().MakeCompound(comp);
+  //
+  for ( int r = 1; r <= m_reader.NbRootsForTransfer(); ++r )
+    if ( m_materialized.IsBound(r) )
+      BRep_Builder().Add( comp, m_materialized(r) );
+  //
+  m_output->SetShape(comp);
+
+  // The output loses the colors with the previous shape, so the colors of
+  // all materialized roots are set again.
+  for ( t_shapeColors::Iterator it(m_rootColors); it.More(); it.Next() )
+    m_output->SetColor( it.Key(), it.Value() );
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
 static void FillShapesMap(const TopoDS_Shape& S, TopTools_MapOfShape& map)
 {
   TopoDS_Shape S0 = S;
@@ -261,6 +505,194 @@ bool asiAlgo_ReadSTEPWithMeta::transfer(STEPControl_Reader& reader,
 
 //-----------------------------------------------------------------------------
 
+bool asiAlgo_ReadSTEPWithMeta::transferParallel()
+{
+#ifdef USE_THREADING
+  const int numRoots = m_reader.NbRootsForTransfer();
+  if ( numRoots <= 0 )
+    return false;
+
+  // Each worker needs its own model, so the file is parsed again for all
+  // workers except the first one, which reuses the model of the main reader.
+  if ( m_filename.IsEmpty() )
+  {
+    m_progress.SendLogMessage(LogWarn(Normal) << "File name is unknown. Transferring sequentially.");
+    return this->transfer(m_reader, 0);
+  }
+
+  /* ============================================
+   *  Stage 1: estimate the gain of parallel transfer
+   * ============================================ */
+
+  // The first root is transferred by the main reader to measure the cost
+  // of transfer.
+  m_reader.ClearShapes();
+  //
+  OSD_Timer timer;
+  timer.Start();
+  //
+  m_reader.TransferOneRoot(1);
+  //
+  timer.Stop();
+
+  // The remaining roots are assumed to cost as much as the first one. The
+  // extra workers parse the file one after another, so each of them adds
+  // the parsing time, while the transfer time is divided by the number of
+  // workers. The number of workers giving the greatest gain is taken.
+  const double transferTime = timer.ElapsedTime()*(numRoots - 1);
+  const int    maxWorkers   = std::min( std::min(numRoots - 1, MaxNumTransferWorkers),
+                                        std::max( 1, int( std::thread::hardware_concurrency() ) ) );
+  //
+  int    numWorkers = 1;
+  double bestGain   = 0.;
+  //
+  for ( int w = 2; w <= maxWorkers; ++w )
+  {
+    const double gain = transferTime*(1. - 1./w) - (w - 1)*m_fParseTime;
+    //
+    if ( gain > bestGain )
+    {
+      bestGain   = gain;
+      numWorkers = w;
+    }
+  }
+
+  /* ============================================
+   *  Stage 2: prepare readers with own models
+   * ============================================ */
+
+  // Parsing is not thread-safe, so this stage is sequential.
+  std::vector<STEPControl_Reader>  extraReaders(numWorkers - 1);
+  std::vector<STEPControl_Reader*> readers;
+  //
+  readers.push_back(&m_reader);
+  //
+  for ( int w = 1; w < numWorkers; ++w )
+  {
+    STEPControl_Reader& rd = extraReaders[w - 1];
+    //
+    if ( rd.ReadFile( m_filename.ToCString() ) != IFSelect_RetDone )
+    {
+      m_progress.SendLogMessage(LogErr(Normal) << "Cannot read file '%1' for worker %2."
+                                               << m_filename << w);
+      return false;
+    }
+
+    // Compute roots in advance as this requires the graph of the model.
+    if ( rd.NbRootsForTransfer() != numRoots )
+    {
+      m_progress.SendLogMessage(LogErr(Normal) << "Inconsistent roots in isolated transfer process.");
+      return false;
+    }
+    //
+    readers.push_back(&rd);
+  }
+
+  // Distribute the remaining roots between workers in contiguous ranges, so
+  // that merging the results in the order of workers preserves the order
+  // of roots.
+  std::vector<int> firstRoots(numWorkers + 1);
+  //
+  for ( int w = 0; w <= numWorkers; ++w )
+    firstRoots[w] = 2 + w*(numRoots - 1)/numWorkers;
+
+  /* ============================================
+   *  Stage 3: transfer roots concurrently
+   * ============================================ */
+
+  if ( numWorkers > 1 )
+  {
+    m_progress.SendLogMessage( LogInfo(Normal) << "Transferring %1 roots with %2 workers."
+                                               << numRoots << numWorkers );
+
+    tbb::parallel_for( tbb::blocked_range<int>(0, numWorkers, 1),
+                       ParallelTransferFunctor(readers, firstRoots) );
+  }
+  else
+  {
+    m_progress.SendLogMessage( LogInfo(Normal) << "Parsing the file again costs more than the "
+                                                  "parallel transfer saves. Transferring sequentially." );
+
+    for ( int r = 2; r <= numRoots; ++r )
+      m_reader.TransferOneRoot(r);
+  }
+
+  /* ============================================
+   *  Stage 4: merge results in the order of roots
+   * ============================================ */
+
+  TopTools_SequenceOfShape shapes;
+  //
+  for ( int w = 0; w < numWorkers; ++w )
+  {
+    for ( int s = 1; s <= readers[w]->NbShapes(); ++s )
+      shapes.Append( readers[w]->Shape(s) );
+  }
+  //
+  if ( shapes.IsEmpty() )
+    return false;
+
+  TopoDS_Shape result;
+  //
+  if ( shapes.Length() == 1 )
+    result = shapes.First();
+  else
+  {
+    TopoDS_Compound comp;
+    BRep_Builder().MakeCompound(comp);
+    //
+    for ( TopTools_SequenceOfShape::Iterator it(shapes); it.More(); it.Next() )
+      BRep_Builder().Add( comp, it.Value() );
+    //
+    result = comp;
+  }
+
+  // Set shape in the output.
+  m_output->SetShape(result);
+
+  /* ============================================
+   *  Stage 5: resolve styles once
+   * ============================================ */
+
+  if ( m_bColorMode )
+  {
+    // All models are parsed from the same file, so the entities have the
+    // same numbers everywhere. Collect the shapes of all transfer processes
+    // into one map keyed by entity numbers.
+    NCollection_DataMap<int, TopoDS_Shape> itemShapes;
+    //
+    for ( int w = 0; w < numWorkers; ++w )
+    {
+      const Handle(Interface_InterfaceModel)& model = readers[w]->Model();
+      const Handle(Transfer_TransientProcess)&
+        TP = readers[w]->WS()->TransferReader()->TransientProcess();
+      //
+      for ( int i = 1; i <= TP->NbMapped(); ++i )
+      {
+        TopoDS_Shape S = TransferBRep::ShapeResult( TP, TP->MapItem(i) );
+        //
+        if ( S.IsNull() )
+          continue;
+
+        const int entNum = model->Number( TP->Mapped(i) );
+        //
+        if ( entNum > 0 && !itemShapes.IsBound(entNum) )
+          itemShapes.Bind(entNum, S);
+      }
+    }
+
+    this->readColors(m_reader.WS(), &itemShapes);
+  }
+
+  return true;
+#else
+  m_progress.SendLogMessage(LogWarn(Normal) << "Threading is not available. Transferring sequentially.");
+  return this->transfer(m_reader, 0);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
 static void findStyledSR(const Handle(StepVisual_StyledItem)&   style,
                          Handle(StepShape_ShapeRepresentation)& aSR)
 {
@@ -282,7 +714,64 @@ static void findStyledSR(const Handle(StepVisual_StyledItem)&   style,
 
 //-----------------------------------------------------------------------------
 
-bool asiAlgo_ReadSTEPWithMeta::readColors(const Handle(XSControl_WorkSession)& WS) const
+//! Checks whether the component style refers to a specified higher usage
+//! occurrence (SHUO). Such styles are skipped.
+static bool isSHUOStyle(const Handle(XSControl_WorkSession)& WS,
+                        const Handle(StepVisual_StyledItem)& style)
+{
+  // take SR of NAUO
+  Handle(StepShape_ShapeRepresentation) aSR;
+  findStyledSR(style, aSR);
+  // search for SR along model
+  if (aSR.IsNull())
+    return false;
+  Interface_EntityIterator subs = WS->HGraph()->Graph().Sharings(aSR);
+  Handle(StepShape_ShapeDefinitionRepresentation) aSDR;
+  for (subs.Start(); subs.More(); subs.Next()) {
+    aSDR = Handle(StepShape_ShapeDefinitionRepresentation)::DownCast(subs.Value());
+    if (aSDR.IsNull())
+      continue;
+    StepRepr_RepresentedDefinition aPDSselect = aSDR->Definition();
+    Handle(StepRepr_ProductDefinitionShape) PDS =
+      Handle(StepRepr_ProductDefinitionShape)::DownCast(aPDSselect.PropertyDefinition());
+    if (PDS.IsNull())
+      continue;
+    StepRepr_CharacterizedDefinition aCharDef = PDS->Definition();
+
+    Handle(StepRepr_AssemblyComponentUsage) ACU =
+      Handle(StepRepr_AssemblyComponentUsage)::DownCast(aCharDef.ProductDefinitionRelationship());
+    if (ACU.IsNull())
+      continue;
+    // PTV 10.02.2003 skip styled item that refer to SHUO
+    if (ACU->IsKind(STANDARD_TYPE(StepRepr_SpecifiedHigherUsageOccurrence)))
+      return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+
+//! Decodes the color to assign from the colors of a style. The surface,
+//! boundary and curve colors are assigned in this order, so the last
+//! available one wins.
+static bool getStyleColor(const Handle(StepVisual_Colour)& SurfCol,
+                          const Handle(StepVisual_Colour)& BoundCol,
+                          const Handle(StepVisual_Colour)& CurveCol,
+                          Quantity_Color&                  color)
+{
+  if ( !CurveCol.IsNull() )
+    return STEPConstruct_Styles::DecodeColor(CurveCol, color) == Standard_True;
+  if ( !BoundCol.IsNull() )
+    return STEPConstruct_Styles::DecodeColor(BoundCol, color) == Standard_True;
+  if ( !SurfCol.IsNull() )
+    return STEPConstruct_Styles::DecodeColor(SurfCol, color) == Standard_True;
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ReadSTEPWithMeta::readColors(const Handle(XSControl_WorkSession)&          WS,
+                                          const NCollection_DataMap<int, TopoDS_Shape>* itemShapes) const
 {
   STEPConstruct_Styles Styles(WS);
 
@@ -330,76 +819,137 @@ bool asiAlgo_ReadSTEPWithMeta::readColors(const Handle(XSControl_WorkSession)& W
         anItems.Append(aRepr->Items()->Value(j));
     }
     for (int itemIt = 0; itemIt < anItems.Length(); itemIt++) {
-      TopoDS_Shape S = STEPConstruct::FindShape(Styles.TransientProcess(),
-        Handle(StepRepr_RepresentationItem)::DownCast(anItems.Value(itemIt)));
-      bool isSkipSHUOstyle = false;
-      // take shape with real location.
-      while (IsComponent) {
-        // take SR of NAUO
-        Handle(StepShape_ShapeRepresentation) aSR;
-        findStyledSR(style, aSR);
-        // search for SR along model
-        if (aSR.IsNull())
-          break;
-        Interface_EntityIterator subs = WS->HGraph()->Graph().Sharings(aSR);
-        Handle(StepShape_ShapeDefinitionRepresentation) aSDR;
-        for (subs.Start(); subs.More(); subs.Next()) {
-          aSDR = Handle(StepShape_ShapeDefinitionRepresentation)::DownCast(subs.Value());
-          if (aSDR.IsNull())
-            continue;
-          StepRepr_RepresentedDefinition aPDSselect = aSDR->Definition();
-          Handle(StepRepr_ProductDefinitionShape) PDS =
-            Handle(StepRepr_ProductDefinitionShape)::DownCast(aPDSselect.PropertyDefinition());
-          if (PDS.IsNull())
-            continue;
-          StepRepr_CharacterizedDefinition aCharDef = PDS->Definition();
-
-          Handle(StepRepr_AssemblyComponentUsage) ACU =
-            Handle(StepRepr_AssemblyComponentUsage)::DownCast(aCharDef.ProductDefinitionRelationship());
-          if (ACU.IsNull())
-            continue;
-          // PTV 10.02.2003 skip styled item that refer to SHUO
-          if (ACU->IsKind(STANDARD_TYPE(StepRepr_SpecifiedHigherUsageOccurrence))) {
-            isSkipSHUOstyle = true;
-            break;
-          }
-          Handle(StepRepr_NextAssemblyUsageOccurrence) NAUO =
-            Handle(StepRepr_NextAssemblyUsageOccurrence)::DownCast(ACU);
-          if (NAUO.IsNull())
-            continue;
-        }
-        break;
+      TopoDS_Shape S;
+      if (itemShapes) {
+        const int entNum = WS->Model()->Number(anItems.Value(itemIt));
+        if (itemShapes->IsBound(entNum))
+          S = itemShapes->Find(entNum);
       }
-      if (isSkipSHUOstyle)
-        continue; // skip styled item which refer to SHUO
-
+      else
+        S = STEPConstruct::FindShape(Styles.TransientProcess(),
+          Handle(StepRepr_RepresentationItem)::DownCast(anItems.Value(itemIt)));
       if (S.IsNull())
         continue;
 
+      // skip styled item which refer to SHUO
+      if (IsComponent && isSHUOStyle(WS, style))
+        continue;
 
-      if (!SurfCol.IsNull() || !BoundCol.IsNull() || !CurveCol.IsNull())
-      {
-        Quantity_Color aSCol, aBCol, aCCol;
-        if ( !SurfCol.IsNull() )
-        {
-          Styles.DecodeColor(SurfCol, aSCol);
-          //
-          m_output->SetColor(S, aSCol);
-        }
-        if ( !BoundCol.IsNull() )
-        {
-          Styles.DecodeColor(BoundCol, aBCol);
-          //
-          m_output->SetColor(S, aBCol);
-        }
-        if ( !CurveCol.IsNull() )
-        {
-          Styles.DecodeColor(CurveCol, aCCol);
-          //
-          m_output->SetColor(S, aBCol);
-        }
-      }
+      Quantity_Color aCol;
+      if (getStyleColor(SurfCol, BoundCol, CurveCol, aCol))
+        m_output->SetColor(S, aCol);
     }
   }
   return true;
 }
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_ReadSTEPWithMeta::indexStyles()
+{
+  if ( m_bStylesIndexed )
+    return;
+
+  m_bStylesIndexed = true;
+
+  STEPConstruct_Styles Styles( m_reader.WS() );
+  //
+  if ( !Styles.LoadStyles() )
+    return;
+
+  Handle(TColStd_HSequenceOfTransient) invisStyles = new TColStd_HSequenceOfTransient;
+  Styles.LoadInvisStyles(invisStyles);
+  //
+  for ( int i = 1; i <= invisStyles->Length(); ++i )
+    m_invisStyles.Add( invisStyles->Value(i) );
+
+  const Handle(Interface_InterfaceModel)& model = m_reader.WS()->Model();
+
+  // Map the styled items to their styles.
+  for ( int i = 1; i <= Styles.NbStyles(); ++i )
+  {
+    Handle(StepVisual_StyledItem) style = Styles.Style(i);
+    if ( style.IsNull() )
+      continue;
+
+    NCollection_Vector<Handle(Standard_Transient)> items;
+    //
+    if ( !style->Item().IsNull() )
+      items.Append( style->Item() );
+    //
+    else if ( !style->ItemAP242().Representation().IsNull() )
+    {
+      // Special case for AP242: item can be representation.
+      Handle(StepRepr_Representation) repr = style->ItemAP242().Representation();
+      //
+      for ( int j = 1; j <= repr->Items()->Length(); ++j )
+        items.Append( repr->Items()->Value(j) );
+    }
+
+    for ( int j = 0; j < items.Length(); ++j )
+    {
+      const int entNum = model->Number( items.Value(j) );
+      //
+      if ( entNum <= 0 )
+        continue;
+
+      if ( !m_itemStyles.IsBound(entNum) )
+        m_itemStyles.Bind( entNum, new TColStd_HSequenceOfTransient );
+      //
+      m_itemStyles(entNum)->Append(style);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_ReadSTEPWithMeta::readRootColors(const int firstMapped)
+{
+  this->indexStyles();
+  //
+  if ( m_itemStyles.IsEmpty() )
+    return;
+
+  const Handle(XSControl_WorkSession)&      WS    = m_reader.WS();
+  const Handle(Interface_InterfaceModel)&   model = WS->Model();
+  const Handle(Transfer_TransientProcess)&  TP    = WS->TransferReader()->TransientProcess();
+  //
+  STEPConstruct_Styles Styles(WS);
+
+  // Only the entities transferred for the root are looked up.
+  for ( int i = firstMapped; i <= TP->NbMapped(); ++i )
+  {
+    const int entNum = model->Number( TP->Mapped(i) );
+    //
+    if ( !m_itemStyles.IsBound(entNum) )
+      continue;
+
+    TopoDS_Shape S = TransferBRep::ShapeResult( TP, TP->MapItem(i) );
+    //
+    if ( S.IsNull() )
+      continue;
+
+    const Handle(TColStd_HSequenceOfTransient)& styles = m_itemStyles(entNum);
+    //
+    for ( int j = 1; j <= styles->Length(); ++j )
+    {
+      Handle(StepVisual_StyledItem)
+        style = Handle(StepVisual_StyledItem)::DownCast( styles->Value(j) );
+
+      Handle(StepVisual_Colour) SurfCol, BoundCol, CurveCol;
+      bool IsComponent = false;
+      //
+      if ( !Styles.GetColors(style, SurfCol, BoundCol, CurveCol, IsComponent) &&
+           !m_invisStyles.Contains(style) )
+        continue;
+
+      if ( IsComponent && isSHUOStyle(WS, style) )
+        continue;
+
+      Quantity_Color color;
+      //
+      if ( getStyleColor(SurfCol, BoundCol, CurveCol, color) )
+        m_rootColors.Bind(S, color);
+    }
+  }
+}
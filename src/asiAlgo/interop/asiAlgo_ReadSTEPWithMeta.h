@@ -52,6 +52,14 @@
 #include <TColStd_HSequenceOfTransient.hxx>
 #include <XCAFDimTolObjects_DatumModifiersSequence.hxx>
 #include <XCAFDimTolObjects_DatumModifWithValue.hxx>
+#include <NCollection_DataMap.hxx>
+#include <Quantity_Color.hxx>
+#include <TColStd_MapOfTransient.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+
+// Standard includes
+#include <vector>
+
 class XSControl_WorkSession;
 class TDocStd_Document;
 class TCollection_AsciiString;
@@ -76,6 +84,24 @@ public:
   // OCCT RTTI
   DEFINE_STANDARD_RTTI_INLINE(asiAlgo_ReadSTEPWithMeta, ActAPI_IAlgorithm)
 
+public:
+
+  //! Descriptor of a single transferable root collected in the
+  //! structure-only mode.
+  struct t_rootInfo
+  {
+    int                     index;          //!< 1-based index of the root in the reader.
+    TCollection_AsciiString type;           //!< STEP type of the root entity.
+    TCollection_AsciiString name;           //!< Product name (if available).
+    bool                    isMaterialized; //!< Whether the root has been transferred.
+
+    //! Default ctor.
+    t_rootInfo() : index(0), isMaterialized(false) {}
+  };
+
+  //! Colors of shapes.
+  typedef NCollection_DataMap<TopoDS_Shape, Quantity_Color, TopTools_ShapeMapHasher> t_shapeColors;
+
 public:
 
   asiAlgo_EXPORT
@@ -139,18 +165,112 @@ public:
   asiAlgo_EXPORT bool
     GetColorMode() const;
 
+  //! Sets multithreading mode (parallel or sequential). In the parallel
+  //! mode, the transferable roots are distributed between workers, and each
+  //! worker translates its roots with its own reader and STEP model (the
+  //! file is parsed once per extra worker). The number of workers is chosen
+  //! from the measured times of parsing and of transferring the first root,
+  //! so the transfer falls back to the sequential one if parsing the file
+  //! again does not pay off. The results are merged in the order of roots,
+  //! so the output does not depend on the thread scheduling. Shapes shared
+  //! between the roots of different workers are not shared in the result.
+  //! \param[in] on Boolean value to set.
+  asiAlgo_EXPORT void
+    SetParallelMode(const bool on);
+
+  //! \return true if the parallel mode is on.
+  asiAlgo_EXPORT bool
+    IsParallelMode() const;
+
+public:
+
+  //! Reads the STEP file and indexes its transferable roots without
+  //! translating any geometry. Use MaterializeRoot() to transfer the
+  //! individual roots on demand.
+  //! \param[in] filename file to read.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    ReadStructure(const char* filename);
+
+  //! \return name of the file being read.
+  const TCollection_AsciiString& GetFilename() const
+  {
+    return m_filename;
+  }
+
+  //! \return roots indexed by the structure-only reading.
+  asiAlgo_EXPORT const std::vector<t_rootInfo>&
+    GetStructure() const;
+
+  //! Transfers the root with the given index if it has not been transferred
+  //! yet. All materialized roots are passed to the output data adaptor as a
+  //! single compound together with their colors. The file is parsed once by
+  //! ReadStructure(), so the reader can be kept to materialize other roots
+  //! later. Only the styles of the entities transferred for the root are
+  //! resolved.
+  //! \param[in]  num   1-based index of the root to transfer.
+  //! \param[out] shape transferred shape of the root.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    MaterializeRoot(const int     num,
+                    TopoDS_Shape& shape);
+
 protected:
 
   asiAlgo_EXPORT bool
     transfer(STEPControl_Reader& rd, const int num, const bool asOne = true);
 
   asiAlgo_EXPORT bool
-    readColors(const Handle(XSControl_WorkSession)& WS) const;
+    transferParallel();
+
+  //! Reads colors of the transferred shapes.
+  //! \param[in] WS         work session to take the styles from.
+  //! \param[in] itemShapes optional map of entity numbers to shapes to use
+  //!                       instead of the transfer process of the work session.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    readColors(const Handle(XSControl_WorkSession)&          WS,
+               const NCollection_DataMap<int, TopoDS_Shape>* itemShapes = nullptr) const;
+
+  //! Maps the styled items of the model to their styles. The model is
+  //! scanned only once.
+  asiAlgo_EXPORT void
+    indexStyles();
+
+  //! Resolves the colors of the shapes transferred for a root and stores
+  //! them together with the colors of the previously materialized roots.
+  //! \param[in] firstMapped 1-based index of the first entity mapped in the
+  //!                        transfer process for the root.
+  asiAlgo_EXPORT void
+    readRootColors(const int firstMapped);
 
 private:
 
-  STEPControl_Reader m_reader;     //!< Reader (without metadata).
-  bool               m_bColorMode; //!< Color mode (on/off).
+  STEPControl_Reader m_reader;      //!< Reader (without metadata).
+  bool               m_bColorMode;  //!< Color mode (on/off).
+  bool               m_bIsParallel; //!< Parallel mode (on/off).
+  double             m_fParseTime;  //!< Time of parsing the file (seconds).
+
+  //! Name of the file being read.
+  TCollection_AsciiString m_filename;
+
+  //! Roots indexed in the structure-only mode.
+  std::vector<t_rootInfo> m_structure;
+
+  //! Shapes of the roots materialized on demand.
+  NCollection_DataMap<int, TopoDS_Shape> m_materialized;
+
+  //! Styles of the styled items by entity numbers.
+  NCollection_DataMap<int, Handle(TColStd_HSequenceOfTransient)> m_itemStyles;
+
+  //! Invisible styles.
+  TColStd_MapOfTransient m_invisStyles;
+
+  //! Whether the styles are indexed.
+  bool m_bStylesIndexed;
+
+  //! Colors of the shapes of the materialized roots.
+  t_shapeColors m_rootColors;
 
   //! Output data adaptor.
   Handle(asiAlgo_ReadSTEPWithMetaOutput) m_output;
@@ -26,6 +26,9 @@
 // asiAlgo includes
 #include <asiAlgo_STEPReduce.h>
 
+// OpenCascade includes
+#include <OSD_Timer.hxx>
+
 // Standard includes
 #pragma warning(push, 0)
 #include <algorithm>
@@ -37,6 +40,7 @@
 #include <fstream>
 #include <regex>
 #include <iostream>
+#include <stdint.h>
 #pragma warning(pop)
 
 namespace
@@ -64,6 +68,400 @@ namespace
       *(result++) = item;
     }
   }
+
+  //---------------------------------------------------------------------------
+  // Streaming reduction
+  //---------------------------------------------------------------------------
+
+  //! Size of the buffer for streaming I/O.
+  const size_t StreamBufferSize = 1 << 22;
+
+  //! 128-bit hash of a canonicalized entity record. Two independent 64-bit
+  //! hashes keep the probes short. The records with equal hashes are still
+  //! compared by their canonical bodies.
+  struct t_recordHash
+  {
+    uint64_t h1, h2;
+
+    t_recordHash() : h1(0), h2(0) {}
+  };
+
+  //! Computes hash of the given record body.
+  //! \param[in] body record body to hash.
+  //! \return hash value.
+  t_recordHash HashRecord(const std::string& body)
+  {
+    t_recordHash res;
+    res.h1 = 14695981039346656037ULL; // FNV-1a offset basis.
+    res.h2 = 0x9E3779B97F4A7C15ULL;
+    //
+    for ( size_t k = 0; k < body.size(); ++k )
+    {
+      const uint64_t c = (unsigned char) body[k];
+
+      res.h1 ^= c;
+      res.h1 *= 1099511628211ULL; // FNV-1a prime.
+
+      res.h2 += c;
+      res.h2 *= 0xC2B2AE3D27D4EB4FULL;
+      res.h2 ^= res.h2 >> 29;
+    }
+    return res;
+  }
+
+  //! Compact open-addressing hash table binding canonical record bodies to
+  //! the IDs of the first records having these bodies. The bodies of the
+  //! bound records are kept in a single pool, and the slots refer to them
+  //! by offset.
+  class RecordHashTable
+  {
+  public:
+
+    //! Ctor.
+    RecordHashTable() : m_iSize(0) { m_slots.resize(1 << 16); }
+
+    //! Cleans up the table.
+    void Clear()
+    {
+      m_slots.assign( m_slots.size(), t_slot() );
+      m_pool.clear();
+      m_iSize = 0;
+    }
+
+    //! \return number of bound records.
+    size_t Size() const { return m_iSize; }
+
+    //! \return number of bytes allocated by the table.
+    size_t Footprint() const
+    {
+      return m_slots.capacity()*sizeof(t_slot) + m_pool.capacity();
+    }
+
+    //! Returns the ID of the first record having the same canonical body.
+    //! If there is no such record, the passed ID is bound and returned.
+    //! \param[in] key  hash of the record.
+    //! \param[in] body canonical body of the record.
+    //! \param[in] id   ID of the record.
+    //! \return ID of the representative record.
+    unsigned FindOrBind(const t_recordHash& key,
+                        const std::string&  body,
+                        const unsigned      id)
+    {
+      if ( (m_iSize + 1)*10 > m_slots.size()*7 )
+        this->grow();
+
+      const size_t mask = m_slots.size() - 1;
+      size_t       pos  = size_t(key.h1) & mask;
+      //
+      for ( ;; )
+      {
+        t_slot& slot = m_slots[pos];
+        //
+        if ( slot.id == 0 )
+        {
+          slot.key    = key;
+          slot.id     = id + 1;
+          slot.offset = m_pool.size();
+          slot.length = body.size();
+          m_pool.append(body);
+          ++m_iSize;
+          return id;
+        }
+        //
+        if ( slot.key.h1 == key.h1 && slot.key.h2 == key.h2 &&
+             slot.length == body.size() &&
+             m_pool.compare(slot.offset, slot.length, body) == 0 )
+          return slot.id - 1;
+
+        pos = (pos + 1) & mask;
+      }
+    }
+
+  private:
+
+    //! Doubles the capacity of the table. The pool is not touched.
+    void grow()
+    {
+      std::vector<t_slot> old;
+      old.swap(m_slots);
+      m_slots.resize(old.size()*2);
+      //
+      const size_t mask = m_slots.size() - 1;
+      //
+      for ( size_t k = 0; k < old.size(); ++k )
+      {
+        if ( !old[k].id )
+          continue;
+
+        size_t pos = size_t(old[k].key.h1) & mask;
+        //
+        while ( m_slots[pos].id )
+          pos = (pos + 1) & mask;
+
+        m_slots[pos] = old[k];
+      }
+    }
+
+  private:
+
+    //! Slot of the table. Zero ID stands for an empty slot.
+    struct t_slot
+    {
+      t_recordHash key;    //!< Hash of the body.
+      size_t       offset; //!< Offset of the body in the pool.
+      size_t       length; //!< Length of the body.
+      unsigned     id;     //!< ID of the record plus one.
+
+      t_slot() : offset(0), length(0), id(0) {}
+    };
+
+    std::vector<t_slot> m_slots; //!< Slots.
+    std::string         m_pool;  //!< Canonical bodies of the bound records.
+    size_t              m_iSize; //!< Number of occupied slots.
+  };
+
+  //! Reader of entity records from the DATA section of a STEP file. The
+  //! records spanning several lines are joined in the same way as in the
+  //! in-memory reduction.
+  class RecordReader
+  {
+  public:
+
+    //! Ctor.
+    RecordReader() : m_buffer(StreamBufferSize), m_iBytes(0), m_bPastHeader(false), m_bPastData(false), m_bBroken(false) {}
+
+    //! Opens file for reading.
+    //! \param[in] filename file to open.
+    //! \return true in case of success, false -- otherwise.
+    bool Open(const std::string& filename)
+    {
+      m_is.rdbuf()->pubsetbuf( &m_buffer[0], std::streamsize( m_buffer.size() ) );
+      m_is.open(filename, std::ios::binary);
+      return m_is.is_open();
+    }
+
+    //! Reads the next entity record.
+    //! \param[out] id   ID of the entity.
+    //! \param[out] body trimmed record body (after the `=` sign).
+    //! \return false if there are no more records or the record is
+    //!         malformed (see IsBroken()).
+    bool Next(unsigned& id, std::string& body)
+    {
+      std::string record;
+      bool continuing = false;
+      //
+      while ( !m_bPastData && std::getline(m_is, m_line) )
+      {
+        m_iBytes += m_line.size() + 1;
+
+        if ( !m_line.empty() && m_line.back() == '\r' )
+          m_line.pop_back();
+
+        if ( !m_bPastHeader )
+        {
+          if ( m_line.find("DATA;") != std::string::npos )
+            m_bPastHeader = true;
+
+          Header.push_back(m_line);
+          continue;
+        }
+
+        if ( !continuing && m_line.find("ENDSEC;") != std::string::npos )
+        {
+          m_bPastData = true;
+          Footer.push_back(m_line);
+          break;
+        }
+
+        rtrim(m_line);
+        //
+        if ( m_line.empty() )
+          continue;
+
+        if ( continuing )
+        {
+          if ( std::isalpha(m_line.front()) )
+            record.append(" ");
+
+          record += m_line;
+        }
+        else
+          record = m_line;
+
+        continuing = ( record.back() != ';' );
+        //
+        if ( continuing )
+          continue;
+
+        const size_t eqPos = record.find('=');
+        //
+        if ( record[0] != '#' || eqPos == std::string::npos )
+          continue; // Skip comments and garbage.
+
+        if ( !ParseId(record, eqPos, id) )
+        {
+          m_bBroken    = true;
+          BrokenRecord = record;
+          return false;
+        }
+
+        body = record.substr(eqPos + 1);
+        //
+        ltrim(body);
+        rtrim(body);
+        return true;
+      }
+
+      // Collect the footer.
+      while ( m_bPastData && std::getline(m_is, m_line) )
+      {
+        m_iBytes += m_line.size() + 1;
+        Footer.push_back(m_line);
+      }
+      return false;
+    }
+
+    //! \return number of bytes read so far.
+    uint64_t GetNumBytes() const { return m_iBytes; }
+
+    //! \return true if reading stopped at a malformed record.
+    bool IsBroken() const { return m_bBroken; }
+
+  public:
+
+    std::vector<std::string> Header;       //!< Lines before the data section.
+    std::vector<std::string> Footer;       //!< Lines after the data section.
+    std::string              BrokenRecord; //!< Malformed record (if any).
+
+  private:
+
+    //! Parses the entity ID of the `#<id>=` record.
+    //! \param[in]  record record to parse.
+    //! \param[in]  eqPos  position of the `=` sign.
+    //! \param[out] id     parsed ID.
+    //! \return false if the ID is not a valid unsigned number.
+    static bool ParseId(const std::string& record,
+                        const size_t       eqPos,
+                        unsigned&          id)
+    {
+      size_t end = eqPos;
+      //
+      while ( end > 1 && std::isspace( (unsigned char) record[end - 1] ) )
+        --end;
+
+      if ( end <= 1 )
+        return false;
+
+      uint64_t value = 0;
+      //
+      for ( size_t k = 1; k < end; ++k )
+      {
+        if ( !std::isdigit( (unsigned char) record[k] ) )
+          return false;
+
+        value = value*10 + uint64_t(record[k] - '0');
+        //
+        if ( value >= UINT32_MAX )
+          return false;
+      }
+
+      id = unsigned(value);
+      return true;
+    }
+
+  private:
+
+    std::vector<char> m_buffer;      //!< I/O buffer.
+    std::ifstream     m_is;          //!< Input stream.
+    std::string       m_line;        //!< Current line.
+    uint64_t          m_iBytes;      //!< Number of bytes read.
+    bool              m_bPastHeader; //!< Whether the header is read.
+    bool              m_bPastData;   //!< Whether the data section is read.
+    bool              m_bBroken;     //!< Whether a malformed record is met.
+  };
+
+  //! Returns the value stored in the ID-indexed array or the ID itself
+  //! if no value is stored.
+  inline unsigned Resolve(const std::vector<unsigned>& arr, const unsigned id)
+  {
+    return ( id < arr.size() && arr[id] ) ? arr[id] : id;
+  }
+
+  //! Substitutes the entity references (`#<id>`) in the record body by the
+  //! values from the passed ID-indexed arrays. The references in string
+  //! literals are left untouched.
+  //! \param[in]  body       record body.
+  //! \param[in]  remap      array of representatives.
+  //! \param[in]  numbering  optional array of new IDs for representatives.
+  //! \param[out] result     resulting body.
+  //! \param[in]  dangling   optional map of new IDs for the referenced entities
+  //!                        which are not defined in the file. The missing
+  //!                        IDs are allocated after `lastId`, so that the
+  //!                        dangling references do not collide with the
+  //!                        renumbered entities.
+  //! \param[in]  lastId     last allocated ID.
+  void SubstituteRefs(const std::string&                      body,
+                      const std::vector<unsigned>&            remap,
+                      const std::vector<unsigned>*            numbering,
+                      std::string&                            result,
+                      std::unordered_map<unsigned, unsigned>* dangling = nullptr,
+                      unsigned*                               lastId   = nullptr)
+  {
+    result.clear();
+    result.reserve( body.size() );
+
+    bool inString = false;
+    //
+    for ( size_t k = 0; k < body.size(); )
+    {
+      const char c = body[k];
+      //
+      if ( c == '\'' )
+        inString = !inString; // Escaped quotes ('') toggle twice.
+
+      if ( inString || c != '#' || k + 1 >= body.size() || !std::isdigit(body[k + 1]) )
+      {
+        result.push_back(c);
+        ++k;
+        continue;
+      }
+
+      // Parse reference.
+      size_t   next = k + 1;
+      unsigned ref  = 0;
+      //
+      while ( next < body.size() && std::isdigit(body[next]) )
+        ref = ref*10 + unsigned(body[next++] - '0');
+
+      unsigned newRef = Resolve(remap, ref);
+      //
+      if ( numbering )
+      {
+        if ( newRef < numbering->size() && (*numbering)[newRef] )
+          newRef = (*numbering)[newRef];
+        else if ( dangling && lastId )
+        {
+          auto it = dangling->find(newRef);
+          //
+          if ( it == dangling->end() )
+            it = dangling->insert( std::make_pair(newRef, ++(*lastId)) ).first;
+          //
+          newRef = it->second;
+        }
+      }
+
+      result.push_back('#');
+      result += std::to_string(newRef);
+      k = next;
+    }
+  }
+
+  //! Checks whether the record with the given body should never be merged.
+  inline bool IsKeptUnique(const std::string& body)
+  {
+    return body.find("PRODUCT_DEFINITION")   == 0
+        || body.find("SHAPE_REPRESENTATION") == 0;
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -236,3 +634,177 @@ bool asiAlgo_STEPReduce::Peform(const std::string& inFilename,
 
   return true;
 }
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_STEPReduce::PerformStreaming(const std::string& inFilename,
+                                          const std::string& outFilename) const
+{
+  OSD_Timer timer;
+  timer.Start();
+
+  // The arrays below are indexed by the original entity IDs. Zero value
+  // stands for "not defined", i.e., the entity is mapped to itself.
+  std::vector<unsigned> remap;     // Representatives from the previous pass.
+  std::vector<unsigned> nextRemap; // Representatives from the current pass.
+  std::vector<unsigned> numbering; // New IDs of the representatives.
+
+  RecordHashTable          table;
+  std::vector<std::string> header, footer;
+  std::string              body, canonical;
+  unsigned                 id          = 0;
+  size_t                   numRecords  = 0;
+  size_t                   numUniques  = 0;
+  size_t                   prevUniques = 0;
+  size_t                   tableBytes  = 0;
+  uint64_t                 inBytes     = 0;
+  int                      numPasses   = 0;
+
+  // Hash the records until no more duplicates are found.
+  do
+  {
+    RecordReader reader;
+    //
+    if ( !reader.Open(inFilename) )
+    {
+      m_progress.SendLogMessage(LogErr(Normal) << "Cannot open file %1." << inFilename);
+      return false;
+    }
+
+    prevUniques = numUniques;
+    numRecords  = 0;
+    numUniques  = 0;
+    unsigned ordinal = 0;
+
+    table.Clear();
+    nextRemap.assign(remap.size(), 0);
+    numbering.assign(remap.size(), 0);
+
+    while ( reader.Next(id, body) )
+    {
+      ++numRecords;
+
+      if ( id >= nextRemap.size() )
+      {
+        nextRemap.resize(id + 1, 0);
+        numbering.resize(id + 1, 0);
+      }
+
+      unsigned rep = id;
+      //
+      if ( !IsKeptUnique(body) )
+      {
+        SubstituteRefs(body, remap, nullptr, canonical);
+        rep = table.FindOrBind(HashRecord(canonical), canonical, id);
+      }
+
+      nextRemap[id] = rep;
+      //
+      if ( rep == id )
+      {
+        numbering[id] = ++ordinal;
+        ++numUniques;
+      }
+    }
+
+    if ( reader.IsBroken() )
+    {
+      m_progress.SendLogMessage( LogErr(Normal) << "Malformed entity record in file %1: %2"
+                                                << inFilename << reader.BrokenRecord );
+      return false;
+    }
+
+    remap.swap(nextRemap);
+    tableBytes = std::max( tableBytes, table.Footprint() );
+    inBytes    = reader.GetNumBytes();
+    header     = reader.Header;
+    footer     = reader.Footer;
+    ++numPasses;
+
+    m_progress.SendLogMessage( LogInfo(Normal) << "Pass %1: %2 unique records out of %3."
+                                               << numPasses << int(numUniques) << int(numRecords) );
+  }
+  while ( numPasses == 1 || numUniques < prevUniques );
+
+  // Write the output file.
+  RecordReader reader;
+  //
+  if ( !reader.Open(inFilename) )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot open file %1." << inFilename);
+    return false;
+  }
+
+  std::vector<char> outBuffer(StreamBufferSize);
+  std::ofstream     os;
+  //
+  os.rdbuf()->pubsetbuf( &outBuffer[0], std::streamsize( outBuffer.size() ) );
+  os.open(outFilename, std::ios::binary);
+  //
+  if ( !os.is_open() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot open file %1 for writing." << outFilename);
+    return false;
+  }
+
+  uint64_t                               outBytes = 0;
+  unsigned                               lastId   = unsigned(numUniques);
+  std::unordered_map<unsigned, unsigned> dangling;
+
+  for ( const auto& line : header )
+  {
+    os << line << "\n";
+    outBytes += line.size() + 1;
+  }
+
+  while ( reader.Next(id, body) )
+  {
+    if ( Resolve(remap, id) != id )
+      continue; // Skip duplicates.
+
+    SubstituteRefs(body, remap, &numbering, canonical, &dangling, &lastId);
+
+    const std::string line = "#" + std::to_string( numbering[id] ) + "=" + canonical;
+    os << line << "\n";
+    outBytes += line.size() + 1;
+  }
+
+  for ( const auto& line : reader.Footer )
+  {
+    os << line << "\n";
+    outBytes += line.size() + 1;
+  }
+
+  os.close();
+  timer.Stop();
+
+  if ( reader.IsBroken() )
+  {
+    m_progress.SendLogMessage( LogErr(Normal) << "Malformed entity record in file %1: %2"
+                                              << inFilename << reader.BrokenRecord );
+    return false;
+  }
+
+  if ( !dangling.empty() )
+    m_progress.SendLogMessage( LogWarn(Normal) << "%1 referenced entities are not defined in file %2. "
+                                                  "The references are renumbered after the last entity."
+                                               << int( dangling.size() ) << inFilename );
+
+  // Report.
+  const double elapsed   = timer.ElapsedTime();
+  const double inMiB     = double(inBytes)  / (1024.*1024.);
+  const double outMiB    = double(outBytes) / (1024.*1024.);
+  const double indexMiB  = double( tableBytes + 3*remap.size()*sizeof(unsigned) ) / (1024.*1024.);
+  const double ratio     = inBytes ? 100.*(1. - double(outBytes)/double(inBytes)) : 0.;
+  const double scanSpeed = elapsed > 0. ? inMiB*(numPasses + 1)/elapsed : 0.;
+
+  m_progress.SendLogMessage( LogNotice(Normal) << "Input file %1 (%2 MiB, %3 records) was shrunk to "
+                                                  "%4 MiB (%5 records) in the output file %6."
+                                               << inFilename << inMiB << int(numRecords)
+                                               << outMiB << int(numUniques) << outFilename );
+  m_progress.SendLogMessage( LogNotice(Normal) << "Size reduction: %1%. Passes: %2. Elapsed: %3 s. "
+                                                  "Throughput: %4 MiB/s. Index memory: %5 MiB."
+                                               << ratio << numPasses + 1 << elapsed
+                                               << scanSpeed << indexMiB );
+  return true;
+}
@@ -57,4 +57,21 @@ public:
     Peform(const std::string& inFilename,
            const std::string& outFilename) const;
 
+  //! Performs compression in the streaming mode. Unlike Peform(), this
+  //! method does not keep the whole file contents in memory. The input file is
+  //! scanned several times: each pass hashes the canonicalized entity
+  //! records (with references substituted by their representatives from
+  //! the previous pass) until no more duplicates are found. The records
+  //! with equal hashes are compared by their canonical bodies, so only the
+  //! bodies of the unique records are kept in memory. The final pass
+  //! rewrites the references and writes the output file. The peak memory
+  //! is proportional to the size of the unique records plus a few integers
+  //! per entity ID.
+  //! \param[in] inFilename  input filename.
+  //! \param[in] outFilename output filename.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    PerformStreaming(const std::string& inFilename,
+                     const std::string& outFilename) const;
+
 };
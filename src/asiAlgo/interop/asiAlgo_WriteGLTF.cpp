@@ -0,0 +1,730 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_WriteGLTF.h>
+
+// asiAlgo includes
+#include <asiAlgo_AttrFaceColor.h>
+#include <asiAlgo_Timer.h>
+
+// OCCT includes
+#include <BRep_Tool.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+// Standard includes
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <locale>
+#include <map>
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  const uint32_t GLB_Magic     = 0x46546C67; // "glTF"
+  const uint32_t GLB_Version   = 2;
+  const uint32_t GLB_ChunkJSON = 0x4E4F534A; // "JSON"
+  const uint32_t GLB_ChunkBIN  = 0x004E4942; // "BIN\0"
+
+  const int GLTF_Byte          = 5120;
+  const int GLTF_UnsignedShort = 5123;
+  const int GLTF_UnsignedInt   = 5125;
+  const int GLTF_Float         = 5126;
+
+  const int GLTF_ArrayBuffer        = 34962;
+  const int GLTF_ElementArrayBuffer = 34963;
+
+  //! Layout of a primitive in the binary chunk.
+  struct t_layout
+  {
+    uint64_t VertexOffset; //!< Offset of the interleaved vertex data.
+    uint64_t VertexLength; //!< Length of the vertex data.
+    uint64_t IndexOffset;  //!< Offset of the index data.
+    uint64_t IndexLength;  //!< Length of the index data (without padding).
+    int      IndexType;    //!< Component type of indices.
+    int      IndexSize;    //!< Size of one index in bytes.
+  };
+
+  //! Rounds up the passed size to be a multiple of four.
+  uint64_t Align4(const uint64_t size)
+  {
+    return (size + 3) & ~uint64_t(3);
+  }
+
+  //! Writes 32-bit unsigned integer in little-endian byte order.
+  void WriteUInt32(std::ostream& out, const uint32_t val)
+  {
+    const char bytes[4] = { char( val        & 0xFF),
+                            char((val >>  8) & 0xFF),
+                            char((val >> 16) & 0xFF),
+                            char((val >> 24) & 0xFF) };
+    out.write(bytes, 4);
+  }
+
+  //! Writes zero bytes to pad the data to four-byte boundary.
+  void WritePadding(std::ostream& out, const uint64_t size, const char pad = 0)
+  {
+    const uint64_t num = Align4(size) - size;
+    for ( uint64_t k = 0; k < num; ++k )
+      out.put(pad);
+  }
+
+  //! Converts color component from sRGB to linear space as required for
+  //! the base color factor of glTF materials.
+  double SRGBToLinear(const double c)
+  {
+    if ( c <= 0.04045 )
+      return c/12.92;
+
+    return std::pow( (c + 0.055)/1.055, 2.4 );
+  }
+
+  //! Evaluates the transformed nodes and the smooth (area-weighted) nodal
+  //! normals of the passed mesh.
+  //! \param[in]  tris       triangulation.
+  //! \param[in]  trsf       transformation to apply.
+  //! \param[in]  isReversed whether to flip the triangles.
+  //! \param[out] nodes      node coordinates (three values per node).
+  //! \param[out] norms      nodal normals (three values per node).
+  void EvaluatePatch(const Handle(Poly_Triangulation)& tris,
+                     const gp_Trsf&                    trsf,
+                     const bool                        isReversed,
+                     std::vector<float>&               nodes,
+                     std::vector<float>&               norms)
+  {
+    const TColgp_Array1OfPnt&    meshNodes = tris->Nodes();
+    const Poly_Array1OfTriangle& meshTris  = tris->Triangles();
+    const int                    numNodes  = meshNodes.Length();
+    const bool                   isMirror  = trsf.VectorialPart().Determinant() < 0.0;
+    const bool                   doFlip    = isReversed ^ isMirror;
+
+    nodes.resize(numNodes*3);
+
+    std::vector<double> acc(numNodes*3, 0.);
+
+    for ( int i = 0; i < numNodes; ++i )
+    {
+      gp_Pnt P = meshNodes( meshNodes.Lower() + i );
+      P.Transform(trsf);
+      //
+      nodes[i*3 + 0] = float( P.X() );
+      nodes[i*3 + 1] = float( P.Y() );
+      nodes[i*3 + 2] = float( P.Z() );
+    }
+
+    for ( int k = meshTris.Lower(); k <= meshTris.Upper(); ++k )
+    {
+      int n[3];
+      if ( doFlip )
+        meshTris(k).Get(n[0], n[2], n[1]);
+      else
+        meshTris(k).Get(n[0], n[1], n[2]);
+
+      for ( int j = 0; j < 3; ++j )
+        n[j] -= meshNodes.Lower();
+
+      // Accumulate area-weighted normal.
+      double a[3], b[3], c[3][3];
+      for ( int j = 0; j < 3; ++j )
+        for ( int d = 0; d < 3; ++d )
+          c[j][d] = nodes[n[j]*3 + d];
+      //
+      for ( int d = 0; d < 3; ++d )
+      {
+        a[d] = c[1][d] - c[0][d];
+        b[d] = c[2][d] - c[0][d];
+      }
+      //
+      const double cross[3] = { a[1]*b[2] - a[2]*b[1],
+                                a[2]*b[0] - a[0]*b[2],
+                                a[0]*b[1] - a[1]*b[0] };
+      //
+      for ( int j = 0; j < 3; ++j )
+        for ( int d = 0; d < 3; ++d )
+          acc[n[j]*3 + d] += cross[d];
+    }
+
+    norms.resize(numNodes*3);
+    for ( int i = 0; i < numNodes; ++i )
+    {
+      const double len = std::sqrt( acc[i*3 + 0]*acc[i*3 + 0]
+                                  + acc[i*3 + 1]*acc[i*3 + 1]
+                                  + acc[i*3 + 2]*acc[i*3 + 2] );
+      if ( len < 1.e-30 )
+      {
+        norms[i*3 + 0] = 0.f;
+        norms[i*3 + 1] = 0.f;
+        norms[i*3 + 2] = 1.f;
+      }
+      else
+      {
+        norms[i*3 + 0] = float(acc[i*3 + 0]/len);
+        norms[i*3 + 1] = float(acc[i*3 + 1]/len);
+        norms[i*3 + 2] = float(acc[i*3 + 2]/len);
+      }
+    }
+  }
+
+  //! Position quantization parameters (KHR_mesh_quantization).
+  struct t_quantizer
+  {
+    double Origin[3]; //!< Translation.
+    double Scale;     //!< Uniform scale.
+
+    //! Quantizes the coordinate.
+    uint16_t operator()(const double val, const int dim) const
+    {
+      double q = std::floor( (val - Origin[dim])/Scale + 0.5 );
+      if ( q < 0. )     q = 0.;
+      if ( q > 65535. ) q = 65535.;
+      return uint16_t(q);
+    }
+  };
+
+  //! Quantizes normal component to normalized signed byte.
+  int8_t QuantizeNormal(const float val)
+  {
+    double q = std::floor(val*127. + 0.5);
+    if ( q < -127. ) q = -127.;
+    if ( q >  127. ) q =  127.;
+    return int8_t(q);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_WriteGLTF::asiAlgo_WriteGLTF(ActAPI_ProgressEntry progress,
+                                     ActAPI_PlotterEntry  plotter)
+: ActAPI_IAlgorithm (progress, plotter),
+  m_bQuantize       (false)
+{}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_WriteGLTF::Perform(const TopoDS_Shape&            shape,
+                                const TCollection_AsciiString& filename)
+{
+  if ( shape.IsNull() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Null shape passed to GLB writer.");
+    return false;
+  }
+
+  // Gather the face triangulations into primitives by their colors.
+  std::vector<t_primitive> prims;
+  std::map<int, int>       primByColor;
+  //
+  for ( TopExp_Explorer fexp(shape, TopAbs_FACE); fexp.More(); fexp.Next() )
+  {
+    const TopoDS_Face& F = TopoDS::Face( fexp.Current() );
+    //
+    TopLoc_Location                   L;
+    const Handle(Poly_Triangulation)& T = BRep_Tool::Triangulation(F, L);
+    //
+    if ( T.IsNull() || !T->NbTriangles() )
+      continue;
+
+    const int color = this->faceColor(F);
+
+    std::map<int, int>::const_iterator cit = primByColor.find(color);
+    int primIdx;
+    //
+    if ( cit == primByColor.end() )
+    {
+      primIdx = int( prims.size() );
+      primByColor.insert( std::pair<int, int>(color, primIdx) );
+      //
+      prims.push_back( t_primitive() );
+      prims.back().Color = color;
+    }
+    else
+      primIdx = cit->second;
+
+    t_patch patch;
+    patch.Tris       = T;
+    patch.Trsf       = L.Transformation();
+    patch.IsReversed = (F.Orientation() == TopAbs_REVERSED);
+    //
+    prims[primIdx].Patches.push_back(patch);
+  }
+
+  return this->write(prims, filename);
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_WriteGLTF::Perform(const Handle(Poly_Triangulation)& mesh,
+                                const TCollection_AsciiString&    filename)
+{
+  if ( mesh.IsNull() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Null mesh passed to GLB writer.");
+    return false;
+  }
+
+  t_patch patch;
+  patch.Tris = mesh;
+
+  std::vector<t_primitive> prims(1);
+  prims[0].Patches.push_back(patch);
+
+  return this->write(prims, filename);
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_WriteGLTF::write(std::vector<t_primitive>&      prims,
+                              const TCollection_AsciiString& filename)
+{
+  TIMER_NEW
+  TIMER_GO
+
+  if ( prims.empty() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "No mesh data to export.");
+    return false;
+  }
+
+  /* =============================================
+   *  Stage 1: evaluate sizes and bounds of data
+   * ============================================= */
+
+  double gMin[3] = {  DBL_MAX,  DBL_MAX,  DBL_MAX };
+  double gMax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+  //
+  for ( size_t p = 0; p < prims.size(); ++p )
+  {
+    t_primitive& prim = prims[p];
+    //
+    for ( size_t k = 0; k < prim.Patches.size(); ++k )
+    {
+      const t_patch&            patch = prim.Patches[k];
+      const TColgp_Array1OfPnt& nodes = patch.Tris->Nodes();
+      //
+      for ( int i = nodes.Lower(); i <= nodes.Upper(); ++i )
+      {
+        gp_Pnt P = nodes(i);
+        P.Transform(patch.Trsf);
+
+        // Bounds are computed for single-precision values as they
+        // go to the file.
+        const double coords[3] = { float( P.X() ), float( P.Y() ), float( P.Z() ) };
+        //
+        for ( int d = 0; d < 3; ++d )
+        {
+          prim.Min[d] = Min(prim.Min[d], coords[d]);
+          prim.Max[d] = Max(prim.Max[d], coords[d]);
+        }
+      }
+
+      prim.NumNodes     += nodes.Length();
+      prim.NumTriangles += patch.Tris->NbTriangles();
+    }
+
+    for ( int d = 0; d < 3; ++d )
+    {
+      gMin[d] = Min(gMin[d], prim.Min[d]);
+      gMax[d] = Max(gMax[d], prim.Max[d]);
+    }
+  }
+
+  // Prepare quantization transformation. The scale is uniform so that
+  // the normals are not distorted by the node transformation.
+  t_quantizer quantizer;
+  {
+    double extent = 0.;
+    for ( int d = 0; d < 3; ++d )
+    {
+      quantizer.Origin[d] = gMin[d];
+      extent              = Max(extent, gMax[d] - gMin[d]);
+    }
+    //
+    quantizer.Scale = ( extent > 0. ? extent/65535. : 1. );
+  }
+
+  // Lay out the binary chunk.
+  const int vertexStride = ( m_bQuantize ? 12 : 24 );
+  const int normalOffset = ( m_bQuantize ?  8 : 12 );
+  //
+  std::vector<t_layout> layouts( prims.size() );
+  uint64_t              binLength = 0;
+  //
+  for ( size_t p = 0; p < prims.size(); ++p )
+  {
+    t_layout& layout = layouts[p];
+
+    // Index values must not reach the max value of the component type.
+    if ( m_bQuantize && prims[p].NumNodes < 65535 )
+    {
+      layout.IndexType = GLTF_UnsignedShort;
+      layout.IndexSize = 2;
+    }
+    else
+    {
+      layout.IndexType = GLTF_UnsignedInt;
+      layout.IndexSize = 4;
+    }
+
+    layout.VertexOffset = binLength;
+    layout.VertexLength = uint64_t(prims[p].NumNodes)*vertexStride;
+    binLength           = Align4(binLength + layout.VertexLength);
+    //
+    layout.IndexOffset  = binLength;
+    layout.IndexLength  = uint64_t(prims[p].NumTriangles)*3*layout.IndexSize;
+    binLength           = Align4(binLength + layout.IndexLength);
+  }
+
+  if ( binLength > 0xFFFFFFF0ull )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Mesh is too large for GLB container.");
+    return false;
+  }
+
+  /* ===========================
+   *  Stage 2: compose JSON chunk
+   * =========================== */
+
+  std::ostringstream json;
+  json.imbue( std::locale::classic() );
+  json.precision( std::numeric_limits<double>::max_digits10 );
+
+  std::vector<int> materials; // Colors of materials.
+  std::map<int, int> materialByColor;
+
+  json << "{\"asset\":{\"version\":\"2.0\",\"generator\":\"Analysis Situs\"}";
+  //
+  if ( m_bQuantize )
+    json << ",\"extensionsUsed\":[\"KHR_mesh_quantization\"]"
+         << ",\"extensionsRequired\":[\"KHR_mesh_quantization\"]";
+
+  // CAD data is Z-up while glTF is Y-up, so the root node rotates
+  // the scene by -90 degrees around the X axis.
+  json << ",\"scene\":0,\"scenes\":[{\"nodes\":[0]}]"
+       << ",\"nodes\":[{\"rotation\":[-0.707106781,0,0,0.707106781],\"children\":[1]},{\"mesh\":0";
+  //
+  if ( m_bQuantize )
+    json << ",\"translation\":[" << quantizer.Origin[0] << "," << quantizer.Origin[1] << "," << quantizer.Origin[2] << "]"
+         << ",\"scale\":[" << quantizer.Scale << "," << quantizer.Scale << "," << quantizer.Scale << "]";
+  //
+  json << "}]";
+
+  // Meshes.
+  json << ",\"meshes\":[{\"primitives\":[";
+  //
+  for ( size_t p = 0; p < prims.size(); ++p )
+  {
+    const int acc = int(p)*3;
+
+    if ( p ) json << ",";
+    json << "{\"attributes\":{\"POSITION\":" << acc << ",\"NORMAL\":" << (acc + 1) << "}"
+         << ",\"indices\":" << (acc + 2) << ",\"mode\":4";
+
+    if ( prims[p].Color >= 0 )
+    {
+      std::map<int, int>::const_iterator mit = materialByColor.find(prims[p].Color);
+      int matIdx;
+      //
+      if ( mit == materialByColor.end() )
+      {
+        matIdx = int( materials.size() );
+        materials.push_back(prims[p].Color);
+        materialByColor.insert( std::pair<int, int>(prims[p].Color, matIdx) );
+      }
+      else
+        matIdx = mit->second;
+
+      json << ",\"material\":" << matIdx;
+    }
+    json << "}";
+  }
+  json << "]}]";
+
+  // Materials.
+  if ( !materials.empty() )
+  {
+    json << ",\"materials\":[";
+    //
+    for ( size_t m = 0; m < materials.size(); ++m )
+    {
+      const int    color = materials[m];
+      const double r     = SRGBToLinear( ( (color >> 16) & 0xFF )/255. );
+      const double g     = SRGBToLinear( ( (color >>  8) & 0xFF )/255. );
+      const double b     = SRGBToLinear( (  color        & 0xFF )/255. );
+
+      if ( m ) json << ",";
+      json << "{\"pbrMetallicRoughness\":{\"baseColorFactor\":["
+           << r << "," << g << "," << b << ",1],\"metallicFactor\":0,\"roughnessFactor\":0.5}}";
+    }
+    json << "]";
+  }
+
+  // Buffer and views.
+  json << ",\"buffers\":[{\"byteLength\":" << binLength << "}],\"bufferViews\":[";
+  //
+  for ( size_t p = 0; p < layouts.size(); ++p )
+  {
+    const t_layout& layout = layouts[p];
+
+    if ( p ) json << ",";
+    json << "{\"buffer\":0,\"byteOffset\":" << layout.VertexOffset
+         << ",\"byteLength\":" << layout.VertexLength
+         << ",\"byteStride\":" << vertexStride
+         << ",\"target\":" << GLTF_ArrayBuffer << "}"
+         << ",{\"buffer\":0,\"byteOffset\":" << layout.IndexOffset
+         << ",\"byteLength\":" << layout.IndexLength
+         << ",\"target\":" << GLTF_ElementArrayBuffer << "}";
+  }
+  json << "]";
+
+  // Accessors.
+  json << ",\"accessors\":[";
+  //
+  for ( size_t p = 0; p < prims.size(); ++p )
+  {
+    const t_primitive& prim   = prims[p];
+    const t_layout&    layout = layouts[p];
+    const int          view   = int(p)*2;
+
+    if ( p ) json << ",";
+
+    // Positions.
+    json << "{\"bufferView\":" << view << ",\"byteOffset\":0";
+    //
+    if ( m_bQuantize )
+    {
+      json << ",\"componentType\":" << GLTF_UnsignedShort
+           << ",\"min\":[" << quantizer(prim.Min[0], 0) << "," << quantizer(prim.Min[1], 1) << "," << quantizer(prim.Min[2], 2) << "]"
+           << ",\"max\":[" << quantizer(prim.Max[0], 0) << "," << quantizer(prim.Max[1], 1) << "," << quantizer(prim.Max[2], 2) << "]";
+    }
+    else
+    {
+      json << ",\"componentType\":" << GLTF_Float
+           << ",\"min\":[" << float(prim.Min[0]) << "," << float(prim.Min[1]) << "," << float(prim.Min[2]) << "]"
+           << ",\"max\":[" << float(prim.Max[0]) << "," << float(prim.Max[1]) << "," << float(prim.Max[2]) << "]";
+    }
+    json << ",\"count\":" << prim.NumNodes << ",\"type\":\"VEC3\"}";
+
+    // Normals.
+    json << ",{\"bufferView\":" << view << ",\"byteOffset\":" << normalOffset;
+    //
+    if ( m_bQuantize )
+      json << ",\"componentType\":" << GLTF_Byte << ",\"normalized\":true";
+    else
+      json << ",\"componentType\":" << GLTF_Float;
+    //
+    json << ",\"count\":" << prim.NumNodes << ",\"type\":\"VEC3\"}";
+
+    // Indices.
+    json << ",{\"bufferView\":" << (view + 1)
+         << ",\"componentType\":" << layout.IndexType
+         << ",\"count\":" << (uint64_t(prim.NumTriangles)*3)
+         << ",\"type\":\"SCALAR\"}";
+  }
+  json << "]}";
+
+  /* ====================================
+   *  Stage 3: write header and JSON chunk
+   * ==================================== */
+
+  std::ofstream out(filename.ToCString(), std::ios::out | std::ios::binary);
+  //
+  if ( !out.is_open() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot open file '%1' for writing." << filename);
+    return false;
+  }
+
+  const std::string jsonStr    = json.str();
+  const uint64_t    jsonLength = Align4( jsonStr.size() );
+  const uint64_t    fileLength = 12 + 8 + jsonLength + 8 + binLength;
+
+  WriteUInt32( out, GLB_Magic );
+  WriteUInt32( out, GLB_Version );
+  WriteUInt32( out, uint32_t(fileLength) );
+  //
+  WriteUInt32( out, uint32_t(jsonLength) );
+  WriteUInt32( out, GLB_ChunkJSON );
+  out.write( jsonStr.c_str(), std::streamsize( jsonStr.size() ) );
+  WritePadding( out, jsonStr.size(), ' ' );
+
+  /* ===================================
+   *  Stage 4: stream the binary chunk
+   * =================================== */
+
+  WriteUInt32( out, uint32_t(binLength) );
+  WriteUInt32( out, GLB_ChunkBIN );
+
+  std::vector<float> nodes, norms;
+  std::vector<char>  buff;
+  //
+  for ( size_t p = 0; p < prims.size(); ++p )
+  {
+    const t_primitive& prim   = prims[p];
+    const t_layout&    layout = layouts[p];
+
+    // Interleaved vertex data.
+    for ( size_t k = 0; k < prim.Patches.size(); ++k )
+    {
+      if ( m_progress.IsCancelling() )
+        return false;
+
+      const t_patch& patch = prim.Patches[k];
+      EvaluatePatch(patch.Tris, patch.Trsf, patch.IsReversed, nodes, norms);
+
+      const size_t numNodes = nodes.size()/3;
+      buff.resize(numNodes*vertexStride);
+      //
+      for ( size_t i = 0; i < numNodes; ++i )
+      {
+        char* ptr = &buff[i*vertexStride];
+        //
+        if ( m_bQuantize )
+        {
+          const uint16_t pos[4] = { quantizer(nodes[i*3 + 0], 0),
+                                    quantizer(nodes[i*3 + 1], 1),
+                                    quantizer(nodes[i*3 + 2], 2),
+                                    0 };
+          const int8_t   nrm[4] = { QuantizeNormal(norms[i*3 + 0]),
+                                    QuantizeNormal(norms[i*3 + 1]),
+                                    QuantizeNormal(norms[i*3 + 2]),
+                                    0 };
+          //
+          memcpy(ptr,     pos, 8);
+          memcpy(ptr + 8, nrm, 4);
+        }
+        else
+        {
+          memcpy(ptr,      &nodes[i*3], 12);
+          memcpy(ptr + 12, &norms[i*3], 12);
+        }
+      }
+      //
+      out.write( &buff[0], std::streamsize( buff.size() ) );
+    }
+    WritePadding(out, layout.VertexLength);
+
+    // Indices.
+    uint32_t nodeShift = 0;
+    //
+    for ( size_t k = 0; k < prim.Patches.size(); ++k )
+    {
+      const t_patch&               patch    = prim.Patches[k];
+      const Poly_Array1OfTriangle& meshTris = patch.Tris->Triangles();
+      const int                    lower    = patch.Tris->Nodes().Lower();
+      const bool                   isMirror = patch.Trsf.VectorialPart().Determinant() < 0.0;
+      const bool                   doFlip   = patch.IsReversed ^ isMirror;
+
+      buff.resize(meshTris.Length()*3*layout.IndexSize);
+      //
+      char* ptr = &buff[0];
+      for ( int t = meshTris.Lower(); t <= meshTris.Upper(); ++t )
+      {
+        int n[3];
+        if ( doFlip )
+          meshTris(t).Get(n[0], n[2], n[1]);
+        else
+          meshTris(t).Get(n[0], n[1], n[2]);
+
+        for ( int j = 0; j < 3; ++j )
+        {
+          const uint32_t idx = nodeShift + uint32_t(n[j] - lower);
+          //
+          if ( layout.IndexSize == 2 )
+          {
+            const uint16_t sidx = uint16_t(idx);
+            memcpy(ptr, &sidx, 2);
+          }
+          else
+            memcpy(ptr, &idx, 4);
+          //
+          ptr += layout.IndexSize;
+        }
+      }
+      //
+      out.write( &buff[0], std::streamsize( buff.size() ) );
+      nodeShift += uint32_t( patch.Tris->NbNodes() );
+    }
+    WritePadding(out, layout.IndexLength);
+  }
+
+  out.close();
+  //
+  if ( out.fail() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Failed to write file '%1'." << filename);
+    return false;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Write GLB")
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "GLB file written: %1 primitive(s), %2 material(s), %3 KiB."
+                                             << int( prims.size() )
+                                             << int( materials.size() )
+                                             << int( fileLength/1024 ) );
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+int asiAlgo_WriteGLTF::faceColor(const TopoDS_Shape& face) const
+{
+  if ( !m_aag.IsNull() )
+  {
+    const t_topoId fid = m_aag->GetFaceId(face);
+    //
+    if ( fid )
+    {
+      Handle(asiAlgo_AttrFaceColor)
+        attr = m_aag->ATTR_NODE<asiAlgo_AttrFaceColor>(fid);
+      //
+      if ( !attr.IsNull() )
+      {
+        unsigned r, g, b;
+        attr->GetColor(r, g, b);
+        //
+        return int( ( (r & 0xFF) << 16 ) | ( (g & 0xFF) << 8 ) | (b & 0xFF) );
+      }
+    }
+  }
+
+  const int* colorPtr = m_faceColors.Seek(face);
+  //
+  if ( colorPtr )
+    return *colorPtr;
+
+  return -1;
+}
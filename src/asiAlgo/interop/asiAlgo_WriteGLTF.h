@@ -0,0 +1,189 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_WriteGLTF_h
+#define asiAlgo_WriteGLTF_h
+
+// asiAlgo includes
+#include <asiAlgo_AAG.h>
+
+// Active Data includes
+#include <ActAPI_IAlgorithm.h>
+
+// OCCT includes
+#include <gp_Trsf.hxx>
+#include <NCollection_DataMap.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+
+// Standard includes
+#include <cfloat>
+#include <vector>
+
+//! Writes tessellations to binary glTF 2.0 files (GLB). The geometry is
+//! stored in the binary chunk as packed little-endian buffers: interleaved
+//! positions and normals plus triangle indices. Faces sharing the same color
+//! are gathered into one mesh primitive referencing a dedicated material, so
+//! the per-face colors survive the export without duplicating vertex data.
+//!
+//! The writer does not accumulate the binary buffer in memory. The sizes
+//! and bounds of all buffers are evaluated in a lightweight preliminary
+//! pass, so the JSON chunk can be written ahead of the binary data which is
+//! then streamed to the file face by face.
+//!
+//! If quantization is enabled, the positions are stored as unsigned shorts
+//! and the normals as normalized signed bytes following the
+//! KHR_mesh_quantization extension. The dequantization transform is
+//! stored in the scene node.
+class asiAlgo_WriteGLTF : public ActAPI_IAlgorithm
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_WriteGLTF, ActAPI_IAlgorithm)
+
+public:
+
+  //! Ctor.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  asiAlgo_EXPORT
+    asiAlgo_WriteGLTF(ActAPI_ProgressEntry progress = nullptr,
+                      ActAPI_PlotterEntry  plotter  = nullptr);
+
+public:
+
+  //! Sets AAG to take the face colors from. The colors are read from
+  //! the asiAlgo_AttrFaceColor attributes of the graph nodes and take
+  //! precedence over the colors passed with SetFaceColor().
+  //! \param[in] aag attributed adjacency graph of the shape to export.
+  void SetAAG(const Handle(asiAlgo_AAG)& aag)
+  {
+    m_aag = aag;
+  }
+
+  //! Assigns color to the passed face.
+  //! \param[in] face  face of the shape to export.
+  //! \param[in] color color packed as 0xRRGGBB integer (the same
+  //!                  convention as in the metadata elements).
+  void SetFaceColor(const TopoDS_Shape& face, const int color)
+  {
+    m_faceColors.Bind(face, color);
+  }
+
+  //! Enables/disables quantization of vertex attributes.
+  //! \param[in] on the Boolean value to set.
+  void SetQuantization(const bool on)
+  {
+    m_bQuantize = on;
+  }
+
+  //! \return true if the vertex attributes are quantized.
+  bool IsQuantization() const
+  {
+    return m_bQuantize;
+  }
+
+public:
+
+  //! Writes the face triangulations of the passed shape to the GLB file.
+  //! \param[in] shape    shape whose faces are meshed.
+  //! \param[in] filename target filename.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const TopoDS_Shape&            shape,
+            const TCollection_AsciiString& filename);
+
+  //! Writes the passed triangulation to the GLB file.
+  //! \param[in] mesh     triangulation to write.
+  //! \param[in] filename target filename.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const Handle(Poly_Triangulation)& mesh,
+            const TCollection_AsciiString&    filename);
+
+protected:
+
+  //! Triangulation to export with its placement.
+  struct t_patch
+  {
+    Handle(Poly_Triangulation) Tris;       //!< Triangulation.
+    gp_Trsf                    Trsf;       //!< Transformation to apply.
+    bool                       IsReversed; //!< Whether to flip triangles.
+
+    t_patch() : IsReversed(false) {}
+  };
+
+  //! Mesh primitive gathering all patches of the same color.
+  struct t_primitive
+  {
+    int                  Color;        //!< Packed color or -1 if none.
+    std::vector<t_patch> Patches;      //!< Patches to export.
+    int                  NumNodes;     //!< Number of nodes.
+    int                  NumTriangles; //!< Number of triangles.
+    double               Min[3];       //!< Min corner of the bounding box.
+    double               Max[3];       //!< Max corner of the bounding box.
+
+    t_primitive() : Color(-1), NumNodes(0), NumTriangles(0)
+    {
+      Min[0] = Min[1] = Min[2] =  DBL_MAX;
+      Max[0] = Max[1] = Max[2] = -DBL_MAX;
+    }
+  };
+
+protected:
+
+  //! Writes the prepared primitives to the file.
+  //! \param[in,out] prims    primitives to write (bounds are computed here).
+  //! \param[in]     filename target filename.
+  //! \return true in case of success, false -- otherwise.
+  bool write(std::vector<t_primitive>&      prims,
+             const TCollection_AsciiString& filename);
+
+  //! Finds color of the passed face.
+  //! \param[in] face face in question.
+  //! \return packed color or -1 if the face is not colored.
+  int faceColor(const TopoDS_Shape& face) const;
+
+protected:
+
+  //! AAG to take the face colors from.
+  Handle(asiAlgo_AAG) m_aag;
+
+  //! Explicitly assigned face colors.
+  NCollection_DataMap<TopoDS_Shape, int, TopTools_ShapeMapHasher> m_faceColors;
+
+  //! Whether to quantize vertex attributes.
+  bool m_bQuantize;
+
+};
+
+#endif
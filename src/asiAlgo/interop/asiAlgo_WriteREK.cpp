@@ -31,6 +31,50 @@
 // Own include
 #include <asiAlgo_WriteREK.h>
 
+// Standard includes
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Default memory budget of a single slab.
+  const size_t DefaultSlabBytes = 64*1024*1024;
+
+  //! Adaptor exposing the uniform grid as the data provider for the
+  //! streaming writer.
+  class GridInput : public asiAlgo_WriteREKInput
+  {
+  public:
+
+    //! Ctor.
+    //! \param[in] grid uniform grid to adapt.
+    GridInput(const Handle(asiAlgo_UniformGrid<float>)& grid) : m_grid(grid) {}
+
+  public:
+
+    virtual int   GetSizeX()     const { return m_grid->Nx + 1; }
+    virtual int   GetSizeY()     const { return m_grid->Ny + 1; }
+    virtual int   GetSizeZ()     const { return m_grid->Nz + 1; }
+    virtual float GetVoxelSize() const { return m_grid->CellSize; }
+
+    //! Fills the XOY slice with the given index. The slices of the grid
+    //! are contiguous and have the same layout as in REK.
+    virtual bool FillSlice(const int k, float* pSlice)
+    {
+      memcpy( pSlice, m_grid->GetSlice(k), m_grid->GetSliceSize()*sizeof(float) );
+      return true;
+    }
+
+  private:
+
+    Handle(asiAlgo_UniformGrid<float>) m_grid; //!< Grid to adapt.
+  };
+}
+
 //-----------------------------------------------------------------------------
 
 asiAlgo_WriteREK::asiAlgo_WriteREK(const std::string& filename,
@@ -39,11 +83,13 @@ asiAlgo_WriteREK::asiAlgo_WriteREK(const std::string& filename,
   m_pFILE = new std::ofstream(filename, std::ios::binary);
   if ( !m_pFILE->is_open() )
   {
+    delete m_pFILE;
     m_pFILE = nullptr;
     throw std::runtime_error("Cannot open file for writing.");
   }
 
   m_fScaleCoeff = scaleCoeff;
+  m_iSlabSize   = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -59,54 +105,105 @@ asiAlgo_WriteREK::~asiAlgo_WriteREK()
 //-----------------------------------------------------------------------------
 
 bool asiAlgo_WriteREK::Write(const Handle(asiAlgo_UniformGrid<float>)& grid)
+{
+  if ( grid.IsNull() )
+    return false;
+
+  return this->Write( new GridInput(grid) );
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_WriteREK::Write(const Handle(asiAlgo_WriteREKInput)& input)
 {
   // Contract check.
-  if ( (m_pFILE == nullptr) || !m_pFILE->is_open() )
+  if ( (m_pFILE == nullptr) || !m_pFILE->is_open() || input.IsNull() )
+    return false;
+
+  const int sizeX = input->GetSizeX();
+  const int sizeY = input->GetSizeY();
+  const int sizeZ = input->GetSizeZ();
+
+  // REK stores dimensions as 16-bit integers.
+  const int maxSize = std::numeric_limits<uint16_t>::max();
+  //
+  if ( sizeX <= 0 || sizeY <= 0 || sizeZ <= 0 ||
+       sizeX > maxSize || sizeY > maxSize || sizeZ > maxSize )
     return false;
 
   // Prepare a header for the REK file.
   t_header rekHeader;
-  rekHeader.SizeX     = (uint16_t) grid->Nx + 1;
-  rekHeader.SizeY     = (uint16_t) grid->Ny + 1;
+  rekHeader.SizeX     = (uint16_t) sizeX;
+  rekHeader.SizeY     = (uint16_t) sizeY;
   rekHeader.Pixel     = 32; // float.
-  rekHeader.SizeZ     = (uint16_t) grid->Nz + 1;
-  rekHeader.PixelSize = grid->CellSize;
-  rekHeader.SliceDist = grid->CellSize;
+  rekHeader.SizeZ     = (uint16_t) sizeZ;
+  rekHeader.PixelSize = input->GetVoxelSize();
+  rekHeader.SliceDist = input->GetVoxelSize();
 
   // Write header.
-  m_pFILE->write( (char*) &rekHeader.SizeX,     sizeof(uint16_t) );
-  m_pFILE->write( (char*) &rekHeader.SizeY,     sizeof(uint16_t) );
-  m_pFILE->write( (char*) &rekHeader.Pixel,     sizeof(uint16_t) );
-  m_pFILE->write( (char*) &rekHeader.SizeZ,     sizeof(uint16_t) );
-  m_pFILE->write( (char*) &rekHeader.Res1,      sizeof(char[572]) );
-  m_pFILE->write( (char*) &rekHeader.SomeValue, sizeof(float) );
-  m_pFILE->write( (char*) &rekHeader.PixelSize, sizeof(float) );
-  m_pFILE->write( (char*) &rekHeader.SliceDist, sizeof(float) );
-  m_pFILE->write( (char*) &rekHeader.Res1,      sizeof(char[1456]) );
+  this->writeHeader(rekHeader);
+
+  // Choose the number of slices to flush at once.
+  const size_t sliceSize = size_t(sizeX)*size_t(sizeY);
+  const int    slabSize  = ( m_iSlabSize > 0 ) ? m_iSlabSize
+                                                : (int) std::max( size_t(1), DefaultSlabBytes / (sliceSize*sizeof(float)) );
+
+  std::vector<float> slab( sliceSize*std::min(slabSize, sizeZ) );
 
   /*
     Write raw data. Notice that the X coordinates should go first.
     Therefore, we render the raw data plan-by-plan, i.e., the XOY
-    slices are stacked along the OZ direction, hence the order of
-    the nested loops.
+    slices are stacked along the OZ direction.
 
     The order is important for non-cubic domains, i.e., in the
     situations when Nx, Ny, Nz are not equal.
    */
-  for ( int k = 0; k <= grid->Nz; ++k )
+  for ( int kStart = 0; kStart < sizeZ; kStart += slabSize )
   {
-    for ( int j = 0; j <= grid->Ny; ++j )
+    const int numSlices = std::min(slabSize, sizeZ - kStart);
+
+    // Request slices from the provider.
+    for ( int s = 0; s < numSlices; ++s )
     {
-      for ( int i = 0; i <= grid->Nx; ++i )
-      {
-        // Apply scaling.
-        const float val = grid->pArray[i][j][k]*m_fScaleCoeff;
-
-        // Write.
-        m_pFILE->write( (char*) &val, sizeof(float) );
-      }
+      float* pSlice = &slab[0] + sliceSize*s;
+      //
+      if ( !input->FillSlice(kStart + s, pSlice) )
+        return false;
+
+      // Apply scaling.
+      if ( m_fScaleCoeff != 1.f )
+        for ( size_t v = 0; v < sliceSize; ++v )
+          pSlice[v] *= m_fScaleCoeff;
     }
+
+    // Write the entire slab at once.
+    m_pFILE->write( (const char*) &slab[0], std::streamsize( sliceSize*numSlices*sizeof(float) ) );
+    //
+    if ( !m_pFILE->good() )
+      return false;
   }
 
   return true;
 }
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_WriteREK::SetSlabSize(const int numSlices)
+{
+  m_iSlabSize = numSlices;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_WriteREK::writeHeader(const t_header& header)
+{
+  m_pFILE->write( (const char*) &header.SizeX,     sizeof(uint16_t) );
+  m_pFILE->write( (const char*) &header.SizeY,     sizeof(uint16_t) );
+  m_pFILE->write( (const char*) &header.Pixel,     sizeof(uint16_t) );
+  m_pFILE->write( (const char*) &header.SizeZ,     sizeof(uint16_t) );
+  m_pFILE->write( (const char*) &header.Res1,      sizeof(char[572]) );
+  m_pFILE->write( (const char*) &header.SomeValue, sizeof(float) );
+  m_pFILE->write( (const char*) &header.PixelSize, sizeof(float) );
+  m_pFILE->write( (const char*) &header.SliceDist, sizeof(float) );
+  m_pFILE->write( (const char*) &header.Res2,      sizeof(char[1456]) );
+}
@@ -33,6 +33,7 @@
 
 // asiAlgo includes
 #include <asiAlgo_UniformGrid.h>
+#include <asiAlgo_WriteREKInput.h>
 
 // Standard includes
 #include <string>
@@ -95,10 +96,38 @@ public:
   asiAlgo_EXPORT bool
     Write(const Handle(asiAlgo_UniformGrid<float>)& grid);
 
+  //! Writes the voxel values generated by the passed data provider. The
+  //! values are requested slice by slice and flushed to the file in Z-slabs,
+  //! so the memory footprint is limited by the slab size regardless of the
+  //! volume size.
+  //! \param[in] input data provider.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Write(const Handle(asiAlgo_WriteREKInput)& input);
+
+  //! Sets the number of XOY slices to accumulate before flushing them to
+  //! the file. If zero is passed (default), the slab size is selected
+  //! automatically to occupy about 64 MiB of memory.
+  //! \param[in] numSlices number of slices in one slab.
+  asiAlgo_EXPORT void
+    SetSlabSize(const int numSlices);
+
+public:
+
+  //! Size of the REK header in bytes.
+  static const int HeaderSize = 2048;
+
+protected:
+
+  //! Writes REK header.
+  //! \param[in] header header to write.
+  void writeHeader(const t_header& header);
+
 protected:
 
   std::ofstream* m_pFILE;       //!< File handle.
   float          m_fScaleCoeff; //!< Raw data scaling coefficient.
+  int            m_iSlabSize;   //!< Number of slices in one slab.
 
 };
 
@@ -0,0 +1,80 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_WriteREKInput_h
+#define asiAlgo_WriteREKInput_h
+
+// asiAlgo includes
+#include <asiAlgo.h>
+
+// OCCT includes
+#include <Standard_Type.hxx>
+
+//-----------------------------------------------------------------------------
+
+//! Input data provider for the streaming REK writer. The provider generates
+//! voxel values slice by slice, so the entire volume never has to reside
+//! in memory.
+class asiAlgo_WriteREKInput : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_WriteREKInput, Standard_Transient)
+
+public:
+
+  //! \return number of samples along OX axis.
+  virtual int
+    GetSizeX() const = 0;
+
+  //! \return number of samples along OY axis.
+  virtual int
+    GetSizeY() const = 0;
+
+  //! \return number of samples (i.e., XOY slices) along OZ axis.
+  virtual int
+    GetSizeZ() const = 0;
+
+  //! \return voxel size.
+  virtual float
+    GetVoxelSize() const = 0;
+
+  //! Fills the XOY slice with the given index. The values are stored row
+  //! by row, i.e., the X index runs fastest.
+  //! \param[in]  k      0-based index of the slice along OZ axis.
+  //! \param[out] pSlice buffer of GetSizeX()*GetSizeY() values to fill.
+  //! \return true in case of success, false -- otherwise.
+  virtual bool
+    FillSlice(const int k, float* pSlice) = 0;
+
+};
+
+#endif
@@ -0,0 +1,646 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_MarchingCubes.h>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Max number of slabs.
+  const int MaxSlabs = 256;
+
+  //! Corners of the cube edges. The first corner is the min one. Edges
+  //! 0-3 run along OX, 4-7 along OY and 8-11 along OZ.
+  const int EdgeCorners[12][2] = { {0, 1}, {2, 3}, {4, 5}, {6, 7},
+                                   {0, 2}, {1, 3}, {4, 6}, {5, 7},
+                                   {0, 4}, {1, 5}, {2, 6}, {3, 7} };
+
+  //! Corners of the cube faces ordered counterclockwise when looking
+  //! from outside of the cube.
+  const int FaceCorners[6][4] = { {0, 4, 6, 2}, {1, 3, 7, 5},
+                                  {0, 1, 5, 4}, {2, 6, 7, 3},
+                                  {0, 2, 3, 1}, {4, 5, 7, 6} };
+
+  //! Triangles of the iso surface for each configuration of inner corners.
+  class CaseTable
+  {
+  public:
+
+    //! \return the only instance of the table.
+    static const CaseTable& Get()
+    {
+      static CaseTable table;
+      return table;
+    }
+
+  public:
+
+    int NumTris[256];  //!< Number of triangles in each case.
+    int Tris[256][30]; //!< Edges hosting the triangle vertices.
+
+  private:
+
+    CaseTable()
+    {
+      for ( int mask = 0; mask < 256; ++mask )
+        this->build(mask);
+    }
+
+    //! Returns the edge connecting the given corners.
+    static int edge(const int a, const int b)
+    {
+      for ( int e = 0; e < 12; ++e )
+        if ( ( EdgeCorners[e][0] == a && EdgeCorners[e][1] == b ) ||
+             ( EdgeCorners[e][0] == b && EdgeCorners[e][1] == a ) )
+          return e;
+
+      return -1;
+    }
+
+    //! Derives the triangles of the given case from the cube faces.
+    void build(const int mask)
+    {
+      NumTris[mask] = 0;
+
+      // Link the crossed edges into loops face by face. Walking the face
+      // boundary counterclockwise, each entry into the inner region is
+      // linked to the next crossing, which cuts the inner corners off.
+      int next[12];
+      for ( int e = 0; e < 12; ++e )
+        next[e] = -1;
+      //
+      for ( int f = 0; f < 6; ++f )
+      {
+        int  crossings[4];
+        bool isEntry[4];
+        int  numCrossings = 0;
+        //
+        for ( int s = 0; s < 4; ++s )
+        {
+          const int  a   = FaceCorners[f][s];
+          const int  b   = FaceCorners[f][(s + 1) % 4];
+          const bool aIn = ( mask & (1 << a) ) != 0;
+          const bool bIn = ( mask & (1 << b) ) != 0;
+          //
+          if ( aIn != bIn )
+          {
+            crossings[numCrossings] = edge(a, b);
+            isEntry[numCrossings]   = bIn;
+            numCrossings++;
+          }
+        }
+
+        for ( int c = 0; c < numCrossings; ++c )
+          if ( isEntry[c] )
+            next[ crossings[c] ] = crossings[(c + 1) % numCrossings];
+      }
+
+      // Triangulate the loops by fans.
+      bool visited[12] = {false};
+      //
+      for ( int e = 0; e < 12; ++e )
+      {
+        if ( next[e] < 0 || visited[e] )
+          continue;
+
+        int loop[12], loopSize = 0;
+        //
+        for ( int cur = e; !visited[cur]; cur = next[cur] )
+        {
+          visited[cur]     = true;
+          loop[loopSize++] = cur;
+        }
+
+        for ( int v = 1; v + 1 < loopSize; ++v )
+        {
+          int* pTri = Tris[mask] + 3*NumTris[mask];
+          //
+          pTri[0] = loop[0];
+          pTri[1] = loop[v];
+          pTri[2] = loop[v + 1];
+          //
+          NumTris[mask]++;
+        }
+      }
+    }
+  };
+
+  //! Key of a lattice edge.
+  struct t_edgeKey
+  {
+    unsigned long long Node;     //!< Packed coordinates of the min node.
+    int                AxisSize; //!< Axis and size of the edge.
+
+    bool operator==(const t_edgeKey& other) const
+    {
+      return (Node == other.Node) && (AxisSize == other.AxisSize);
+    }
+  };
+
+  //! Hasher for edge keys.
+  struct t_edgeKeyHasher
+  {
+    size_t operator()(const t_edgeKey& key) const
+    {
+      unsigned long long h = key.Node*0x9E3779B97F4A7C15ull;
+      h ^= (unsigned long long) key.AxisSize + 0x7F4A7C15ull + (h << 6) + (h >> 2);
+      return size_t(h);
+    }
+  };
+
+  typedef std::unordered_map<t_edgeKey, int, t_edgeKeyHasher> t_vertexMap;
+
+  //! Vertices created by a single slab.
+  struct t_slab
+  {
+    int                 First;   //!< First node layer.
+    int                 Last;    //!< Node layer after the last one.
+    t_vertexMap         Map;     //!< Local vertex indices by edge keys.
+    std::vector<gp_XYZ> Nodes;   //!< Vertices.
+    std::vector<int>    Tris;    //!< Triangles by global vertex indices.
+    int                 Offset;  //!< Index of the first vertex.
+  };
+
+  //! \return inner corners mask of the cell.
+  inline int GetMask(const asiAlgo_MarchingCubes::t_cell& cell, const float iso)
+  {
+    int mask = 0;
+    for ( int c = 0; c < 8; ++c )
+      if ( cell.V[c] < iso )
+        mask |= (1 << c);
+
+    return mask;
+  }
+
+  //! Returns the min node and the key of the cell edge.
+  inline t_edgeKey GetEdgeKey(const asiAlgo_MarchingCubes::t_cell& cell,
+                              const int                            e,
+                              int&                                 nodeK)
+  {
+    const int a = EdgeCorners[e][0];
+
+    const unsigned long long I = cell.I + cell.Size*( a & 1 );
+    const unsigned long long J = cell.J + cell.Size*( (a >> 1) & 1 );
+    nodeK                      = cell.K + cell.Size*( (a >> 2) & 1 );
+
+    t_edgeKey key;
+    key.Node     = I | (J << 21) | ( (unsigned long long) nodeK << 42 );
+    key.AxisSize = (e / 4) | (cell.Size << 2);
+    return key;
+  }
+
+  //! Functor creating the vertices owned by slabs.
+  class VerticesFunctor
+  {
+  public:
+
+    VerticesFunctor(const asiAlgo_MarchingCubes::t_lattice& lattice,
+                    const float                             iso,
+                    std::vector<t_slab>&                    slabs)
+    : m_lattice(lattice), m_fIso(iso), m_slabs(slabs) {}
+
+    void Process(const int first, const int last) const
+    {
+      const CaseTable& table     = CaseTable::Get();
+      const int        numLayers = int( m_lattice.Layers.size() );
+
+      for ( int s = first; s < last; ++s )
+      {
+        t_slab& slab = m_slabs[s];
+
+        // The cells touching the node layers of the slab.
+        const int kFirst = std::max(0, slab.First - m_lattice.MaxSize);
+        const int kLast  = std::min(numLayers, slab.Last);
+        //
+        for ( int k = kFirst; k < kLast; ++k )
+        {
+          const std::vector<asiAlgo_MarchingCubes::t_cell>& layer = m_lattice.Layers[k];
+          //
+          for ( size_t c = 0; c < layer.size(); ++c )
+          {
+            const asiAlgo_MarchingCubes::t_cell& cell = layer[c];
+            const int                            mask = GetMask(cell, m_fIso);
+            //
+            if ( !table.NumTris[mask] )
+              continue;
+
+            for ( int e = 0; e < 12; ++e )
+            {
+              const int a = EdgeCorners[e][0];
+              const int b = EdgeCorners[e][1];
+              //
+              if ( ( (mask >> a) & 1 ) == ( (mask >> b) & 1 ) )
+                continue;
+
+              int             nodeK;
+              const t_edgeKey key = GetEdgeKey(cell, e, nodeK);
+              //
+              if ( nodeK < slab.First || nodeK >= slab.Last )
+                continue;
+
+              std::pair<t_vertexMap::iterator, bool>
+                res = slab.Map.insert( std::make_pair( key, int( slab.Nodes.size() ) ) );
+              //
+              if ( res.second )
+                slab.Nodes.push_back( this->interpolate(cell, a, b) );
+            }
+          }
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    //! Computes the position of the level set on the cell edge.
+    gp_XYZ interpolate(const asiAlgo_MarchingCubes::t_cell& cell,
+                       const int                            a,
+                       const int                            b) const
+    {
+      const gp_XYZ pa = this->corner(cell, a);
+      const gp_XYZ pb = this->corner(cell, b);
+      const double va = cell.V[a];
+      const double vb = cell.V[b];
+      const double t  = (m_fIso - va) / (vb - va);
+
+      return pa + (pb - pa)*t;
+    }
+
+    //! Computes the position of the cell corner.
+    gp_XYZ corner(const asiAlgo_MarchingCubes::t_cell& cell,
+                  const int                            c) const
+    {
+      const gp_XYZ& o = m_lattice.Origin;
+      const gp_XYZ& u = m_lattice.Unit;
+
+      return gp_XYZ( o.X() + u.X()*( cell.I + cell.Size*( c & 1 ) ),
+                     o.Y() + u.Y()*( cell.J + cell.Size*( (c >> 1) & 1 ) ),
+                     o.Z() + u.Z()*( cell.K + cell.Size*( (c >> 2) & 1 ) ) );
+    }
+
+  private:
+
+    const asiAlgo_MarchingCubes::t_lattice& m_lattice; //!< Lattice.
+    float                                   m_fIso;    //!< Iso level.
+    std::vector<t_slab>&                    m_slabs;   //!< Slabs.
+  };
+
+  //! Functor creating the triangles of slabs.
+  class TrianglesFunctor
+  {
+  public:
+
+    TrianglesFunctor(const asiAlgo_MarchingCubes::t_lattice& lattice,
+                     const float                             iso,
+                     const int                               thickness,
+                     std::vector<t_slab>&                    slabs)
+    : m_lattice(lattice), m_fIso(iso), m_iThickness(thickness), m_slabs(slabs) {}
+
+    void Process(const int first, const int last) const
+    {
+      const CaseTable& table     = CaseTable::Get();
+      const int        numLayers = int( m_lattice.Layers.size() );
+
+      for ( int s = first; s < last; ++s )
+      {
+        t_slab& slab = m_slabs[s];
+
+        for ( int k = slab.First; k < std::min(numLayers, slab.Last); ++k )
+        {
+          const std::vector<asiAlgo_MarchingCubes::t_cell>& layer = m_lattice.Layers[k];
+          //
+          for ( size_t c = 0; c < layer.size(); ++c )
+          {
+            const asiAlgo_MarchingCubes::t_cell& cell = layer[c];
+            const int                            mask = GetMask(cell, m_fIso);
+            const int*                           pTri = table.Tris[mask];
+            //
+            for ( int v = 0; v < 3*table.NumTris[mask]; ++v )
+            {
+              int             nodeK;
+              const t_edgeKey key   = GetEdgeKey(cell, pTri[v], nodeK);
+              const t_slab&   owner = m_slabs[nodeK / m_iThickness];
+
+              slab.Tris.push_back( owner.Offset + owner.Map.find(key)->second );
+            }
+          }
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const asiAlgo_MarchingCubes::t_lattice& m_lattice;    //!< Lattice.
+    float                                   m_fIso;       //!< Iso level.
+    int                                     m_iThickness; //!< Slab thickness.
+    std::vector<t_slab>&                    m_slabs;      //!< Slabs.
+  };
+
+  //! Functor collecting the crossing cells of the uniform grid.
+  class GridLayersFunctor
+  {
+  public:
+
+    GridLayersFunctor(const asiAlgo_UniformGrid<float>*  pGrid,
+                      const float                        iso,
+                      asiAlgo_MarchingCubes::t_lattice&  lattice)
+    : m_pGrid(pGrid), m_fIso(iso), m_lattice(lattice) {}
+
+    void Process(const int first, const int last) const
+    {
+      const CaseTable& table = CaseTable::Get();
+
+      for ( int k = first; k < last; ++k )
+      {
+        std::vector<asiAlgo_MarchingCubes::t_cell>& layer = m_lattice.Layers[k];
+
+        asiAlgo_MarchingCubes::t_cell cell;
+        cell.K    = k;
+        cell.Size = 1;
+        //
+        for ( int j = 0; j < m_pGrid->Ny; ++j )
+          for ( int i = 0; i < m_pGrid->Nx; ++i )
+          {
+            cell.I = i;
+            cell.J = j;
+            //
+            for ( int c = 0; c < 8; ++c )
+              cell.V[c] = m_pGrid->GetValue( i + (c & 1), j + ( (c >> 1) & 1 ), k + ( (c >> 2) & 1 ) );
+
+            if ( table.NumTris[ GetMask(cell, m_fIso) ] )
+              layer.push_back(cell);
+          }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const asiAlgo_UniformGrid<float>* m_pGrid;   //!< Grid.
+    float                             m_fIso;    //!< Iso level.
+    asiAlgo_MarchingCubes::t_lattice& m_lattice; //!< Lattice to populate.
+  };
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_MarchingCubes::asiAlgo_MarchingCubes(ActAPI_ProgressEntry progress,
+                                             ActAPI_PlotterEntry  plotter)
+: ActAPI_IAlgorithm (progress, plotter),
+  m_bIsParallel     (true)
+{}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_MarchingCubes::Perform(const Handle(asiAlgo_UniformGrid<float>)& grid,
+                                    const double                              iso)
+{
+  m_result.Nullify();
+
+  if ( grid.IsNull() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Null uniform grid.");
+    return false;
+  }
+
+  t_lattice lattice;
+  lattice.Origin  = gp_XYZ(grid->XMin, grid->YMin, grid->ZMin);
+  lattice.Unit    = gp_XYZ(grid->CellSize, grid->CellSize, grid->CellSize);
+  lattice.MaxSize = 1;
+  lattice.Layers.resize( std::max(grid->Nz, 0) );
+
+  GridLayersFunctor layersFunc(grid.get(), float(iso), lattice);
+  //
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for(tbb::blocked_range<int>( 0, int( lattice.Layers.size() ) ), layersFunc);
+  else
+#endif
+    layersFunc.Process( 0, int( lattice.Layers.size() ) );
+
+  return this->polygonize( lattice, float(iso) );
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_MarchingCubes::Perform(const asiAlgo_SVO* pSVO,
+                                    const double       iso)
+{
+  m_result.Nullify();
+
+  if ( pSVO == nullptr )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Null octree.");
+    return false;
+  }
+
+  const CaseTable& table = CaseTable::Get();
+
+  // Collect the leaves crossed by the level set.
+  std::vector<asiAlgo_SVO::t_cell> leaves, crossing;
+  pSVO->GetLeaves(leaves);
+  //
+  for ( size_t l = 0; l < leaves.size(); ++l )
+  {
+    t_cell cell;
+    for ( int c = 0; c < 8; ++c )
+      cell.V[c] = (float) pSVO->GetScalar(leaves[l].Node, c);
+
+    if ( table.NumTris[ GetMask( cell, float(iso) ) ] )
+      crossing.push_back(leaves[l]);
+  }
+
+  // The lattice unit is the size of the smallest crossing leaf.
+  const gp_XYZ rootSize = pSVO->GetCornerMax() - pSVO->GetCornerMin();
+  gp_XYZ       unit     = rootSize;
+  //
+  for ( size_t l = 0; l < crossing.size(); ++l )
+  {
+    const gp_XYZ d = crossing[l].Max - crossing[l].Min;
+    //
+    unit.SetCoord( std::min( unit.X(), d.X() ),
+                   std::min( unit.Y(), d.Y() ),
+                   std::min( unit.Z(), d.Z() ) );
+  }
+
+  t_lattice lattice;
+  lattice.Origin  = pSVO->GetCornerMin();
+  lattice.Unit    = unit;
+  lattice.MaxSize = 1;
+  lattice.Layers.resize( int( std::floor(rootSize.Z() / unit.Z() + 0.5) ) );
+
+  for ( size_t l = 0; l < crossing.size(); ++l )
+  {
+    const asiAlgo_SVO::t_cell& leaf = crossing[l];
+    const gp_XYZ               rel  = leaf.Min - lattice.Origin;
+
+    t_cell cell;
+    cell.I    = int( std::floor(rel.X() / unit.X() + 0.5) );
+    cell.J    = int( std::floor(rel.Y() / unit.Y() + 0.5) );
+    cell.K    = int( std::floor(rel.Z() / unit.Z() + 0.5) );
+    cell.Size = int( std::floor( (leaf.Max.X() - leaf.Min.X()) / unit.X() + 0.5 ) );
+    //
+    for ( int c = 0; c < 8; ++c )
+      cell.V[c] = (float) pSVO->GetScalar(leaf.Node, c);
+
+    lattice.MaxSize = std::max(lattice.MaxSize, cell.Size);
+    lattice.Layers[cell.K].push_back(cell);
+  }
+
+  return this->polygonize( lattice, float(iso) );
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_MarchingCubes::polygonize(const t_lattice& lattice,
+                                       const float      iso)
+{
+  /* ==================
+   *  Prepare slabs.
+   * ================== */
+
+  const int numNodeLayers = int( lattice.Layers.size() ) + 1;
+  const int thickness     = std::max( lattice.MaxSize, (numNodeLayers + MaxSlabs - 1) / MaxSlabs );
+  const int numSlabs      = (numNodeLayers + thickness - 1) / thickness;
+
+  std::vector<t_slab> slabs(numSlabs);
+  //
+  for ( int s = 0; s < numSlabs; ++s )
+  {
+    slabs[s].First  = s*thickness;
+    slabs[s].Last   = std::min( (s + 1)*thickness, numNodeLayers );
+    slabs[s].Offset = 0;
+  }
+
+  /* ==================
+   *  Create vertices.
+   * ================== */
+
+  VerticesFunctor verticesFunc(lattice, iso, slabs);
+  //
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for(tbb::blocked_range<int>(0, numSlabs), verticesFunc);
+  else
+#endif
+    verticesFunc.Process(0, numSlabs);
+
+  int numNodes = 0;
+  //
+  for ( int s = 0; s < numSlabs; ++s )
+  {
+    slabs[s].Offset = numNodes;
+    numNodes       += int( slabs[s].Nodes.size() );
+  }
+
+  if ( m_progress.IsCancelling() )
+    return false;
+
+  /* ===================
+   *  Create triangles.
+   * =================== */
+
+  TrianglesFunctor trianglesFunc(lattice, iso, thickness, slabs);
+  //
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for(tbb::blocked_range<int>(0, numSlabs), trianglesFunc);
+  else
+#endif
+    trianglesFunc.Process(0, numSlabs);
+
+  int numTris = 0;
+  //
+  for ( int s = 0; s < numSlabs; ++s )
+    numTris += int( slabs[s].Tris.size() / 3 );
+
+  if ( !numTris )
+  {
+    m_progress.SendLogMessage(LogWarn(Normal) << "The level set does not cross the field.");
+    return false;
+  }
+
+  /* =====================
+   *  Populate the mesh.
+   * ===================== */
+
+  m_result = new Poly_Triangulation(numNodes, numTris, false);
+  //
+  int nodeIdx = 1, triIdx = 1;
+  //
+  for ( int s = 0; s < numSlabs; ++s )
+  {
+    const t_slab& slab = slabs[s];
+
+    for ( size_t n = 0; n < slab.Nodes.size(); ++n )
+      m_result->ChangeNode(nodeIdx++) = gp_Pnt( slab.Nodes[n] );
+
+    for ( size_t t = 0; t < slab.Tris.size(); t += 3 )
+      m_result->ChangeTriangle(triIdx++).Set( slab.Tris[t]     + 1,
+                                              slab.Tris[t + 1] + 1,
+                                              slab.Tris[t + 2] + 1 );
+  }
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "Marching cubes produced %1 nodes and %2 triangles in %3 slabs."
+                                             << numNodes << numTris << numSlabs );
+  return true;
+}
@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_MarchingCubes_h
+#define asiAlgo_MarchingCubes_h
+
+// asiAlgo includes
+#include <asiAlgo_SVO.h>
+#include <asiAlgo_UniformGrid.h>
+
+// Active Data includes
+#include <ActAPI_IAlgorithm.h>
+
+// OCCT includes
+#include <Poly_Triangulation.hxx>
+
+//-----------------------------------------------------------------------------
+
+//! Marching cubes polygonization of a scalar field sampled in a uniform
+//! grid or in the leaves of a sparse voxel octree.
+//!
+//! The cells are addressed by integer coordinates in a lattice. For the
+//! uniform grid, the lattice is the grid itself. For the octree, the
+//! lattice unit is the size of the deepest leaf, and each leaf is a cell
+//! spanning several units. Each mesh vertex lies on a lattice edge and is
+//! keyed by the edge's min node, axis and length, so the cells sharing an
+//! edge share the vertex and the result is an indexed mesh without
+//! duplicated nodes. The octree leaves of different sizes do not share
+//! edges, so cracks remain where such leaves meet.
+//!
+//! The cells are processed in slabs of layers along OZ. The vertices of
+//! each slab are generated in parallel and kept in its own hash map. The
+//! slab owning an edge is the one containing its min node, so every vertex
+//! is created once. The triangles are then generated in parallel with
+//! read-only lookups into the maps, and the slabs are concatenated in order.
+//! The result is the same in the sequential and parallel modes.
+//!
+//! The triangulation of each cube configuration is derived from the cube
+//! faces. On the faces with two diagonal inner corners, the inner corners
+//! are always separated. The same face gets the same resolution in both
+//! adjacent cells, so the surface is free of holes. Triangles are oriented
+//! so that their normals point towards the greater values.
+class asiAlgo_MarchingCubes : public ActAPI_IAlgorithm
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_MarchingCubes, ActAPI_IAlgorithm)
+
+public:
+
+  //! Ctor.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  asiAlgo_EXPORT
+    asiAlgo_MarchingCubes(ActAPI_ProgressEntry progress = nullptr,
+                          ActAPI_PlotterEntry  plotter  = nullptr);
+
+public:
+
+  //! Polygonizes the level set of the scalar field stored in a uniform grid.
+  //! \param[in] grid uniform grid.
+  //! \param[in] iso  iso level.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const Handle(asiAlgo_UniformGrid<float>)& grid,
+            const double                              iso = 0.);
+
+  //! Polygonizes the level set of the scalar field stored in the leaves
+  //! of an octree. Each leaf is polygonized as a single cube with the
+  //! scalars in its corners.
+  //! \param[in] pSVO octree.
+  //! \param[in] iso  iso level.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const asiAlgo_SVO* pSVO,
+            const double       iso = 0.);
+
+  //! \return resulting mesh.
+  const Handle(Poly_Triangulation)& GetResult() const
+  {
+    return m_result;
+  }
+
+public:
+
+  //! Sets multithreading mode (parallel or sequential).
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+  //! \return true if the parallel mode is on.
+  bool IsParallelMode() const
+  {
+    return m_bIsParallel;
+  }
+
+public:
+
+  //! Cell of the lattice.
+  struct t_cell
+  {
+    int   I, J, K; //!< Lattice coordinates of the min corner.
+    int   Size;    //!< Size in lattice units.
+    float V[8];    //!< Scalars in corners numbered as nx + 2*ny + 4*nz.
+  };
+
+  //! Lattice with the cells bucketed by their K coordinate.
+  struct t_lattice
+  {
+    gp_XYZ                             Origin;  //!< Position of the lattice node (0, 0, 0).
+    gp_XYZ                             Unit;    //!< Lattice unit along each axis.
+    int                                MaxSize; //!< Max cell size in lattice units.
+    std::vector< std::vector<t_cell> > Layers;  //!< Crossing cells by K.
+  };
+
+protected:
+
+  //! Polygonizes the prepared lattice.
+  //! \param[in] lattice lattice with the crossing cells.
+  //! \param[in] iso     iso level.
+  //! \return true in case of success, false -- otherwise.
+  bool polygonize(const t_lattice& lattice,
+                  const float      iso);
+
+protected:
+
+  Handle(Poly_Triangulation) m_result;      //!< Resulting mesh.
+  bool                       m_bIsParallel; //!< Multithreading mode.
+
+};
+
+#endif
@@ -32,48 +32,67 @@
 #include <asiAlgo_MeshDistanceFunc.h>
 
 // asiAlgo includes
+#include <asiAlgo_BullardRNG.h>
 #include <asiAlgo_BVHAlgo.h>
 
-// Mobius includes
-#include <mobius/cascade.h>
-
 // OpenCascade includes
 #include <Precision.hxx>
 
+// Standard includes
+#include <cstring>
+
 //-----------------------------------------------------------------------------
 
 namespace
 {
-  void CorrectBboxToCube(mobius::t_xyz& Pmin,
-                         mobius::t_xyz& Pmax)
+  void CorrectBboxToCube(gp_XYZ& Pmin,
+                         gp_XYZ& Pmax)
   {
     const double dx = fabs( Pmax.X() - Pmin.X() );
     const double dy = fabs( Pmax.Y() - Pmin.Y() );
     const double dz = fabs( Pmax.Z() - Pmin.Z() );
     double       d  = Max(Max(dx, dy), dz);
 
-    mobius::t_xyz aabbCenter = (Pmax + Pmin)*0.5;
+    gp_XYZ aabbCenter = (Pmax + Pmin)*0.5;
 
     // Enlarge.
     Pmax.SetX(Pmin.X() + d);
     Pmax.SetY(Pmin.Y() + d);
     Pmax.SetZ(Pmin.Z() + d);
     //
-    mobius::t_xyz cubeCenter = (Pmax + Pmin)*0.5;
+    gp_XYZ cubeCenter = (Pmax + Pmin)*0.5;
 
     // Translate the center of the cube to the center of the AABB.
-    mobius::t_xyz ccVec = aabbCenter - cubeCenter;
+    gp_XYZ ccVec = aabbCenter - cubeCenter;
     //
     Pmin += ccVec;
     Pmax += ccVec;
   }
+
+  //! Mixes the bits of point coordinates into a seed of random numbers.
+  unsigned GetSeed(const double x, const double y, const double z)
+  {
+    const double coords[3] = {x, y, z};
+    unsigned     seed      = 2166136261u;
+
+    for ( int k = 0; k < 3; ++k )
+    {
+      unsigned long long bits;
+      memcpy( &bits, &coords[k], sizeof(double) );
+      //
+      seed = ( seed ^ unsigned(bits) )       * 16777619u;
+      seed = ( seed ^ unsigned(bits >> 32) ) * 16777619u;
+    }
+
+    return seed;
+  }
 }
 
 //-----------------------------------------------------------------------------
 
 asiAlgo_MeshDistanceFunc::asiAlgo_MeshDistanceFunc(const Mode mode,
                                                    const int  numRays)
-: mobius::poly_DistanceFunc(mode), m_iNumRays(numRays), m_RNG(128)
+: asiAlgo_DistanceFunc(mode), m_iNumRays(numRays)
 {}
 
 //-----------------------------------------------------------------------------
@@ -82,7 +101,7 @@ asiAlgo_MeshDistanceFunc::asiAlgo_MeshDistanceFunc(const Handle(asiAlgo_BVHFacet
                                                    const Mode                       mode,
                                                    const int                        numRays,
                                                    const bool                       cube)
-: mobius::poly_DistanceFunc(mode), m_iNumRays(numRays), m_RNG(128)
+: asiAlgo_DistanceFunc(mode), m_iNumRays(numRays)
 {
   this->Init(facets, cube);
 }
@@ -95,7 +114,7 @@ asiAlgo_MeshDistanceFunc::asiAlgo_MeshDistanceFunc(const Handle(asiAlgo_BVHFacet
                                                    const Mode                       mode,
                                                    const int                        numRays,
                                                    const bool                       cube)
-: mobius::poly_DistanceFunc(mode), m_iNumRays(numRays), m_RNG(128)
+: asiAlgo_DistanceFunc(mode), m_iNumRays(numRays)
 {
   this->Init(facets, domainMin, domainMax, cube);
 }
@@ -110,12 +129,12 @@ bool asiAlgo_MeshDistanceFunc::Init(const Handle(asiAlgo_BVHFacets)& facets,
 
   BVH_Box<double, 3> aabb = facets->Box();
 
-  mobius::t_xyz Pmin = mobius::t_xyz( aabb.CornerMin().x(),
-                                      aabb.CornerMin().y(),
-                                      aabb.CornerMin().z() );
-  mobius::t_xyz Pmax = mobius::t_xyz( aabb.CornerMax().x(),
-                                      aabb.CornerMax().y(),
-                                      aabb.CornerMax().z() );
+  gp_XYZ Pmin( aabb.CornerMin().x(),
+               aabb.CornerMin().y(),
+               aabb.CornerMin().z() );
+  gp_XYZ Pmax( aabb.CornerMax().x(),
+               aabb.CornerMax().y(),
+               aabb.CornerMax().z() );
 
   if ( cube )
   {
@@ -143,10 +162,8 @@ bool asiAlgo_MeshDistanceFunc::Init(const Handle(asiAlgo_BVHFacets)& facets,
   if ( facets.IsNull() )
     return false;
 
-  BVH_Box<double, 3> aabb = facets->Box();
-
-  mobius::t_xyz Pmin = mobius::cascade::GetMobiusPnt(domainMin);
-  mobius::t_xyz Pmax = mobius::cascade::GetMobiusPnt(domainMax);
+  gp_XYZ Pmin = domainMin;
+  gp_XYZ Pmax = domainMax;
 
   if ( cube )
   {
@@ -170,9 +187,6 @@ double asiAlgo_MeshDistanceFunc::Eval(const double x,
                                       const double y,
                                       const double z) const
 {
-  // Project point on mesh.
-  gp_Pnt P(x, y, z);
-
   // Get unsigned distance.
   const double
     d2 = asiAlgo_BVHAlgo::squaredDistanceToMesh( m_facets.get(), BVH_Vec3d(x, y, z) );
@@ -187,6 +201,9 @@ double asiAlgo_MeshDistanceFunc::Eval(const double x,
   bool isOutside = true;
   if ( m_mode == Mode_Signed )
   {
+    // Local generator keeps the function thread-safe and reproducible.
+    asiAlgo_BullardRNG rng( GetSeed(x, y, z) );
+
     int vote    = 0;
     int barrier = int( std::ceil(double(m_iNumRays) / 2.) );
 
@@ -198,9 +215,9 @@ double asiAlgo_MeshDistanceFunc::Eval(const double x,
       // Initialize random ray.
       asiAlgo_BVHAlgo::t_ray
         ray( BVH_Vec3d(x, y, z),
-             BVH_Vec3d( m_RNG.RandDouble() * 2.0 - 1.0,
-                        m_RNG.RandDouble() * 2.0 - 1.0,
-                        m_RNG.RandDouble() * 2.0 - 1.0) );
+             BVH_Vec3d( rng.RandDouble() * 2.0 - 1.0,
+                        rng.RandDouble() * 2.0 - 1.0,
+                        rng.RandDouble() * 2.0 - 1.0) );
       //
       const int numBounces = asiAlgo_BVHAlgo::rayMeshHitCount(m_facets.get(), ray);
       //
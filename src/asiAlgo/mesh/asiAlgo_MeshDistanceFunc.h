@@ -32,18 +32,23 @@
 #define asiAlgo_MeshDistanceFunc_h
 
 // asiAlgo includes
-#include <asiAlgo_BullardRNG.h>
 #include <asiAlgo_BVHFacets.h>
-
-// Mobius includes
-#include <mobius/poly_DistanceFunc.h>
+#include <asiAlgo_DistanceFunc.h>
 
 //-----------------------------------------------------------------------------
 
 //! Distance function to be used for spatial shape representations, such as
-//! Discrete Distance Fields (DDF).
-class asiAlgo_MeshDistanceFunc : public mobius::poly_DistanceFunc
+//! Discrete Distance Fields (DDF). The directions of the rays used to
+//! check the distance sign are generated from the coordinates of the
+//! evaluated point, so the function is deterministic and can be evaluated
+//! concurrently.
+class asiAlgo_MeshDistanceFunc : public asiAlgo_DistanceFunc
 {
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_MeshDistanceFunc, asiAlgo_DistanceFunc)
+
 public:
 
   //! Ctor.
@@ -121,9 +126,8 @@ public:
 
 protected:
 
-  Handle(asiAlgo_BVHFacets)  m_facets;   //!< BVH for shape represented with facets.
-  int                        m_iNumRays; //!< Number of rays to check distance sign.
-  mutable asiAlgo_BullardRNG m_RNG;      //!< Random number generator.
+  Handle(asiAlgo_BVHFacets) m_facets;   //!< BVH for shape represented with facets.
+  int                       m_iNumRays; //!< Number of rays to check distance sign.
 
 public:
 
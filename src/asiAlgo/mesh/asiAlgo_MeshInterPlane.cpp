@@ -32,184 +32,465 @@
 #include <asiAlgo_MeshInterPlane.h>
 
 // asiAlgo includes
-#include <asiAlgo_KHull2d.h>
-#include <asiAlgo_MeshConvert.h>
-#include <asiAlgo_PointWithAttr.h>
 #include <asiAlgo_Timer.h>
 
 // OCCT includes
-#include <ShapeAnalysis_Surface.hxx>
+#include <Precision.hxx>
 
-// VTK includes
-#pragma warning(push, 0)
-#include <vtkCutter.h>
-#include <vtkPlane.h>
-#pragma warning(pop)
+// Standard includes
+#include <algorithm>
+#include <unordered_map>
 
-#undef DRAW_DEBUG
-#if defined DRAW_DEBUG
-  #pragma message("===== warning: DRAW_DEBUG is enabled")
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
 #endif
 
 //-----------------------------------------------------------------------------
 
-asiAlgo_MeshInterPlane::asiAlgo_MeshInterPlane(const Handle(Poly_Triangulation)& mesh,
-                                               ActAPI_ProgressEntry              progress,
-                                               ActAPI_PlotterEntry               plotter)
-: ActAPI_IAlgorithm(progress, plotter)
+namespace
 {
-  m_mesh = mesh;
-}
+  //! Intersection segment of a triangle with a plane. The segment goes
+  //! from the edge where the triangle contour leaves the upper half-space
+  //! to the edge where it comes back, so the segments of a section follow
+  //! the orientation of the mesh.
+  struct t_segment
+  {
+    unsigned long long Keys[2]; //!< Keys of the crossed mesh edges.
+    gp_XYZ             Pts[2];  //!< End points.
+  };
 
-//-----------------------------------------------------------------------------
+  //! Segments sharing a crossed mesh edge.
+  struct t_edgeSegments
+  {
+    int Segs[2]; //!< Indices of the segments.
 
-bool asiAlgo_MeshInterPlane::Perform(const Handle(Geom_Plane)& plane,
-                                     const bool                doSort)
-{
-  /* =====================================
-   *  Stage 1: convert mesh to VTK format
-   * ===================================== */
+    t_edgeSegments() { Segs[0] = Segs[1] = -1; } //!< Ctor.
+  };
+
+  typedef std::unordered_map<unsigned long long, t_edgeSegments> t_edgeMap;
 
-  // Convert triangulation to VTK form.
-  vtkSmartPointer<vtkPolyData> meshVtk;
-  if ( !asiAlgo_MeshConvert::ToVTK(m_mesh, meshVtk) )
+  //! \return key of the mesh edge given by its nodes.
+  inline unsigned long long GetEdgeKey(const int n1, const int n2)
   {
-    m_progress.SendLogMessage(LogErr(Normal) << "Cannot convert mesh to VTK data structure.");
-    return false;
+    return (n1 < n2) ? ( ( (unsigned long long) n1 << 32 ) | (unsigned long long) n2 )
+                     : ( ( (unsigned long long) n2 << 32 ) | (unsigned long long) n1 );
   }
 
-  /* ==================================
-   *  Stage 2: intersect by VTK cutter
-   * ================================== */
-
-  const gp_Ax3& origin = plane->Position();
-
-  // Prepare plane to cut.
-  vtkSmartPointer<vtkPlane> planeVtk = vtkSmartPointer<vtkPlane>::New();
-  //
-  planeVtk->SetOrigin( origin.Location().X(),
-                       origin.Location().Y(),
-                       origin.Location().Z() );
-  planeVtk->SetNormal( origin.Direction().X(),
-                       origin.Direction().Y(),
-                       origin.Direction().Z() );
-
-  // Create cutter.
-  vtkSmartPointer<vtkCutter> cutter = vtkSmartPointer<vtkCutter>::New();
-  cutter->SetCutFunction(planeVtk);
-  cutter->SetInputData(meshVtk);
-  cutter->Update();
-
-  // Get output.
-  vtkPolyData* outputVtk = cutter->GetOutput();
-
-  // Get number of cells.
-  const int numCells = int( outputVtk->GetNumberOfCells() );
-  //
-  if ( numCells == 0 )
+  //! Adds the point to the polyline unless it coincides with the last one.
+  inline void AddPoint(const gp_XYZ& P, std::vector<gp_XYZ>& pts)
   {
-    m_progress.SendLogMessage(LogErr(Normal) << "No cells in the output.");
-    return false;
+    if ( pts.empty() || (pts.back() - P).SquareModulus() > Precision::SquareConfusion() )
+      pts.push_back(P);
   }
-  //
-  m_progress.SendLogMessage(LogInfo(Normal) << "Generated output with %1 cells." << numCells);
 
-  /* =====================================
-   *  Stage 3: convert to asi point cloud
-   * ===================================== */
+  //! Traces a polyline starting from the given end of the given segment.
+  //! \param[in]     segs      all segments of a section.
+  //! \param[in]     edges     segments by the crossed edges.
+  //! \param[in]     s0        index of the starting segment.
+  //! \param[in]     e0        starting end of the segment.
+  //! \param[in,out] isVisited flags of the traced segments.
+  //! \return traced polyline.
+  asiAlgo_MeshInterPlane::t_loop
+    TraceLoop(const std::vector<t_segment>& segs,
+              const t_edgeMap&              edges,
+              const int                     s0,
+              const int                     e0,
+              std::vector<bool>&            isVisited)
+  {
+    asiAlgo_MeshInterPlane::t_loop loop;
+    AddPoint(segs[s0].Pts[e0], loop.Pts);
+
+    int s = s0, e = e0;
+    //
+    for ( ;; )
+    {
+      isVisited[s] = true;
+
+      // Leave the segment through its opposite end.
+      const unsigned long long key = segs[s].Keys[1 - e];
+      AddPoint(segs[s].Pts[1 - e], loop.Pts);
+
+      const t_edgeSegments& edgeSegs = edges.find(key)->second;
+      const int             next     = (edgeSegs.Segs[0] == s) ? edgeSegs.Segs[1] : edgeSegs.Segs[0];
+      //
+      if ( next == s0 )
+      {
+        loop.IsClosed = true;
+        break;
+      }
+      //
+      if ( next == -1 || isVisited[next] )
+        break;
+
+      // Enter the next segment through the shared edge.
+      e = (segs[next].Keys[0] == key) ? 0 : 1;
+      s = next;
+    }
+
+    // The closing point repeats the first one.
+    if ( loop.IsClosed && loop.Pts.size() > 1 &&
+         (loop.Pts.front() - loop.Pts.back()).SquareModulus() <= Precision::SquareConfusion() )
+      loop.Pts.pop_back();
 
-  // Prepare adaptor to invert points on surface.
-  ShapeAnalysis_Surface sas(plane);
+    // Keep the orientation of the segments for the polylines traced backwards.
+    if ( e0 == 1 )
+      std::reverse( loop.Pts.begin(), loop.Pts.end() );
 
-  // Get output points.
-  Handle(asiAlgo_PointWithAttrCloud<gp_XY>) cloud = new asiAlgo_PointWithAttrCloud<gp_XY>;
-  //
-  for ( vtkIdType cellId = 0; cellId < numCells; ++cellId )
+    return loop;
+  }
+
+  //! Links the segments into polylines through the shared mesh edges.
+  //! \param[in]  segs    segments to link.
+  //! \param[out] section resulting polylines.
+  void LinkSegments(const std::vector<t_segment>&      segs,
+                    asiAlgo_MeshInterPlane::t_section& section)
   {
-    vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+    const int numSegs = int( segs.size() );
 
-    // Get the list of points for this cell.
-    outputVtk->GetCellPoints(cellId, ptIds);
+    t_edgeMap edges;
+    edges.reserve(numSegs);
     //
-    for ( vtkIdType k = 0; k < ptIds->GetNumberOfIds(); ++k )
+    for ( int s = 0; s < numSegs; ++s )
     {
-      const vtkIdType pid = ptIds->GetId(k);
-
-      double coords[3];
-      outputVtk->GetPoint(pid, coords);
+      for ( int e = 0; e < 2; ++e )
+      {
+        t_edgeSegments& edgeSegs = edges[segs[s].Keys[e]];
+
+        // Non-manifold edges keep the first two segments only.
+        if ( edgeSegs.Segs[0] == -1 )
+          edgeSegs.Segs[0] = s;
+        else if ( edgeSegs.Segs[1] == -1 )
+          edgeSegs.Segs[1] = s;
+      }
+    }
 
-      // Project point on plane.
-      gp_XY _P = sas.ValueOfUV(gp_Pnt(coords[0], coords[1], coords[2]), 1.0e-4).XY();
+    std::vector<bool> isVisited(numSegs, false);
 
-#if defined DRAW_DEBUG
-      m_plotter.DRAW_POINT(_P, Color_Red, "P");
-#endif
+    // Open polylines start at the edges crossed by a single segment,
+    // e.g., on the mesh boundary.
+    for ( int s = 0; s < numSegs; ++s )
+    {
+      for ( int e = 0; e < 2 && !isVisited[s]; ++e )
+      {
+        if ( edges.find(segs[s].Keys[e])->second.Segs[1] == -1 )
+          section.push_back( TraceLoop(segs, edges, s, e, isVisited) );
+      }
+    }
 
-      // Add to the point cloud.
-      cloud->AddElement( asiAlgo_PointWithAttr<gp_XY>( _P, 0, int(pid) ) );
+    // The remaining segments form closed loops.
+    for ( int s = 0; s < numSegs; ++s )
+    {
+      if ( !isVisited[s] )
+        section.push_back( TraceLoop(segs, edges, s, 0, isVisited) );
     }
   }
 
-  /* =========================================
-   *  Stage 4: reorder by constructing a hull
-   * ========================================= */
-
-  if ( doSort )
+  //! Comparator of level indices by the level values.
+  struct LevelLess
   {
-    m_progress.SendLogMessage(LogInfo(Normal) << "Sorting by constructing a concave hull.");
+    LevelLess(const std::vector<double>& levels) : Levels(levels) {}
 
-    TIMER_NEW
-    TIMER_GO
+    bool operator()(const int l1, const int l2) const
+    {
+      return Levels[l1] < Levels[l2];
+    }
 
-    // Prepare algorithm.
-    asiAlgo_KHull2d<gp_XY> kHull(cloud, 5, 0, m_progress, m_plotter);
+    const std::vector<double>& Levels; //!< Levels to compare.
+  };
 
-    // Build K-neighbors hull.
-    if ( !kHull.Perform() )
+  //! Functor slicing the mesh by a range of sorted levels.
+  class SliceFunctor
+  {
+  public:
+
+    SliceFunctor(const Handle(Poly_Triangulation)&                mesh,
+                 const std::vector<double>&                       heights,
+                 const std::vector<double>&                       levels,
+                 const std::vector<int>&                          order,
+                 const std::vector<int>&                          offsets,
+                 const std::vector<int>&                          tris,
+                 const bool                                       doLink,
+                 std::vector<asiAlgo_MeshInterPlane::t_section>& sections)
+    : m_mesh     (mesh),
+      m_heights  (heights),
+      m_levels   (levels),
+      m_order    (order),
+      m_offsets  (offsets),
+      m_tris     (tris),
+      m_bDoLink  (doLink),
+      m_sections (sections)
+    {}
+
+    void Process(const int first, const int last) const
     {
-      m_progress.SendLogMessage(LogErr(Normal) << "K-hull failed.");
-      return false;
+      for ( int k = first; k < last; ++k )
+        this->sliceLevel(k);
     }
 
-    TIMER_FINISH
-    TIMER_COUT_RESULT_NOTIFIER(m_progress, "Build K-neighbors hull")
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
 
-    // Override cloud with its hull.
-    cloud = kHull.GetHull();
+  private:
 
-#if defined DRAW_DEBUG
-    for ( int k = 0; k < cloud->GetNumberOfElements(); ++k )
+    //! Slices the triangles crossing the k-th level.
+    void sliceLevel(const int k) const
     {
-      gp_XY p1 = cloud->GetElement(k).Coord;
-      gp_XY p2 = ( ( k == cloud->GetNumberOfElements() - 1) ? cloud->GetElement(0).Coord
-                                                            : cloud->GetElement(k + 1).Coord );
+      const double                 level     = m_levels[k];
+      const Poly_Array1OfTriangle& triangles = m_mesh->Triangles();
+
+      std::vector<t_segment> segs;
+      segs.reserve(m_offsets[k + 1] - m_offsets[k]);
+      //
+      for ( int j = m_offsets[k]; j < m_offsets[k + 1]; ++j )
+      {
+        int n[3];
+        triangles(m_tris[j]).Get(n[0], n[1], n[2]);
+
+        // The nodes on the plane are taken as lying above it, so a crossing
+        // triangle always has exactly two crossed edges.
+        bool isAbove[3];
+        for ( int v = 0; v < 3; ++v )
+          isAbove[v] = (m_heights[n[v] - 1] >= level);
+
+        t_segment seg;
+        int       numEnds = 0;
+        //
+        for ( int v = 0; v < 3; ++v )
+        {
+          const int w = (v + 1) % 3;
+          //
+          if ( isAbove[v] == isAbove[w] )
+            continue;
+
+          const int end = isAbove[v] ? 0 : 1;
+          //
+          seg.Keys[end] = GetEdgeKey(n[v], n[w]);
+          seg.Pts[end]  = this->edgePoint(n[v], n[w], level);
+          numEnds++;
+        }
+
+        // Skip degenerated triangles.
+        if ( numEnds == 2 && seg.Keys[0] != seg.Keys[1] )
+          segs.push_back(seg);
+      }
+
+      asiAlgo_MeshInterPlane::t_section& section = m_sections[m_order[k]];
+      //
+      if ( m_bDoLink )
+      {
+        LinkSegments(segs, section);
+        return;
+      }
+
+      // Without linking, each crossed edge gives a single point.
+      asiAlgo_MeshInterPlane::t_loop loop;
+      t_edgeMap                      edges;
+      //
+      for ( size_t s = 0; s < segs.size(); ++s )
+        for ( int e = 0; e < 2; ++e )
+          if ( edges.insert( std::make_pair( segs[s].Keys[e], t_edgeSegments() ) ).second )
+            loop.Pts.push_back(segs[s].Pts[e]);
+      //
+      if ( !loop.Pts.empty() )
+        section.push_back(loop);
+    }
 
-      m_plotter.DRAW_LINK(p1, p2, Color_Green, "hull");
+    //! Computes the intersection point on the crossed edge. The nodes are
+    //! taken in the order of their indices, so the neighbor triangles get
+    //! exactly the same point.
+    gp_XYZ edgePoint(const int    n1,
+                     const int    n2,
+                     const double level) const
+    {
+      const int a = Min(n1, n2);
+      const int b = Max(n1, n2);
+
+      const double da = m_heights[a - 1] - level;
+      const double db = m_heights[b - 1] - level;
+      const double t  = da / (da - db);
+
+      const gp_XYZ& Pa = m_mesh->Nodes()(a).XYZ();
+      const gp_XYZ& Pb = m_mesh->Nodes()(b).XYZ();
+
+      return Pa + (Pb - Pa)*t;
     }
-#endif
+
+  private:
+
+    const Handle(Poly_Triangulation)&                m_mesh;     //!< Mesh to slice.
+    const std::vector<double>&                       m_heights;  //!< Heights of the nodes.
+    const std::vector<double>&                       m_levels;   //!< Sorted levels.
+    const std::vector<int>&                          m_order;    //!< Original indices of the levels.
+    const std::vector<int>&                          m_offsets;  //!< Offsets of the triangles by levels.
+    const std::vector<int>&                          m_tris;     //!< Triangles crossing the levels.
+    bool                                             m_bDoLink;  //!< Whether to link segments.
+    std::vector<asiAlgo_MeshInterPlane::t_section>& m_sections; //!< Resulting sections.
+  };
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_MeshInterPlane::asiAlgo_MeshInterPlane(const Handle(Poly_Triangulation)& mesh,
+                                               ActAPI_ProgressEntry              progress,
+                                               ActAPI_PlotterEntry               plotter)
+: ActAPI_IAlgorithm (progress, plotter),
+  m_mesh            (mesh),
+  m_bIsParallel     (true)
+{}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_MeshInterPlane::Perform(const Handle(Geom_Plane)& plane,
+                                     const bool                doSort)
+{
+  return this->slice( plane->Position(), std::vector<double>(1, 0.), doSort );
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_MeshInterPlane::Perform(const gp_Ax3&              pos,
+                                     const std::vector<double>& levels,
+                                     const bool                 doSort)
+{
+  return this->slice(pos, levels, doSort);
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_MeshInterPlane::slice(const gp_Ax3&              pos,
+                                   const std::vector<double>& levels,
+                                   const bool                 doLink)
+{
+  m_sections.clear();
+  m_result.Nullify();
+
+  if ( m_mesh.IsNull() || !m_mesh->NbTriangles() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Mesh is null or empty.");
+    return false;
+  }
+  //
+  if ( levels.empty() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "No planes to cut with.");
+    return false;
   }
 
+  TIMER_NEW
+  TIMER_GO
+
   /* ============================
-   *  Stage 5: Obtain base cloud
+   *  Stage 1: distribute levels
    * ============================ */
 
-  // Convert to base cloud.
-  Handle(asiAlgo_BaseCloud<double>) pts = new asiAlgo_BaseCloud<double>;
+  const int numLevels = int( levels.size() );
+  const int numNodes  = m_mesh->NbNodes();
+  const int numTris   = m_mesh->NbTriangles();
+
+  // Sort levels to look up the ones within the height range of a triangle.
+  std::vector<int> order(numLevels);
+  //
+  for ( int k = 0; k < numLevels; ++k )
+    order[k] = k;
   //
-  for ( int k = 0; k < cloud->GetNumberOfElements(); ++k )
+  std::sort( order.begin(), order.end(), LevelLess(levels) );
+
+  std::vector<double> sorted(numLevels);
+  //
+  for ( int k = 0; k < numLevels; ++k )
+    sorted[k] = levels[order[k]];
+
+  // Heights of the nodes over the base plane.
+  const gp_XYZ& O = pos.Location().XYZ();
+  const gp_XYZ& N = pos.Direction().XYZ();
+  //
+  std::vector<double> heights(numNodes);
+  //
+  for ( int i = 1; i <= numNodes; ++i )
+    heights[i - 1] = ( m_mesh->Nodes()(i).XYZ() - O ).Dot(N);
+
+  // A triangle crosses the levels in its height range, excluding the
+  // minimal height where all nodes are taken as lying above the plane.
+  std::vector<int> lo(numTris), hi(numTris), offsets(numLevels + 1, 0);
+  //
+  for ( int t = 1; t <= numTris; ++t )
   {
-    const vtkIdType pid = vtkIdType(cloud->GetElement(k).Index);
+    int n1, n2, n3;
+    m_mesh->Triangles()(t).Get(n1, n2, n3);
 
-    // Get point from the VTK dataset.
-    double xyz[3];
-    outputVtk->GetPoint(pid, xyz);
+    const double h1 = heights[n1 - 1], h2 = heights[n2 - 1], h3 = heights[n3 - 1];
 
-    // Add point to the point cloud.
-    pts->AddElement(xyz[0], xyz[1], xyz[2]);
+    lo[t - 1] = int( std::upper_bound( sorted.begin(), sorted.end(), Min(h1, Min(h2, h3)) ) - sorted.begin() );
+    hi[t - 1] = int( std::upper_bound( sorted.begin(), sorted.end(), Max(h1, Max(h2, h3)) ) - sorted.begin() );
+
+    for ( int k = lo[t - 1]; k < hi[t - 1]; ++k )
+      offsets[k + 1]++;
   }
+  //
+  for ( int k = 0; k < numLevels; ++k )
+    offsets[k + 1] += offsets[k];
+
+  // Triangles by levels.
+  std::vector<int> tris( offsets[numLevels] ), cursors( offsets.begin(), offsets.end() - 1 );
+  //
+  for ( int t = 0; t < numTris; ++t )
+    for ( int k = lo[t]; k < hi[t]; ++k )
+      tris[cursors[k]++] = t + 1;
+
+  /* =====================
+   *  Stage 2: slice mesh
+   * ===================== */
+
+  m_sections.resize(numLevels);
+
+  SliceFunctor sliceFunc(m_mesh, heights, sorted, order, offsets, tris, doLink, m_sections);
+  //
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for(tbb::blocked_range<int>(0, numLevels), sliceFunc);
+  else
+#endif
+    sliceFunc.Process(0, numLevels);
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Slice mesh")
 
-  // Set the result.
-  m_result = pts;
+  /* ==========================
+   *  Stage 3: collect results
+   * ========================== */
+
+  m_result = new asiAlgo_BaseCloud<double>;
+  //
+  int numLoops = 0;
+  //
+  for ( int k = 0; k < numLevels; ++k )
+  {
+    for ( size_t l = 0; l < m_sections[k].size(); ++l )
+    {
+      const std::vector<gp_XYZ>& pts = m_sections[k][l].Pts;
+      //
+      for ( size_t p = 0; p < pts.size(); ++p )
+        m_result->AddElement( pts[p].X(), pts[p].Y(), pts[p].Z() );
+    }
+
+    numLoops += int( m_sections[k].size() );
+  }
+  //
+  if ( !m_result->GetNumberOfElements() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "The mesh does not intersect the plane(s).");
+    return false;
+  }
+  //
+  if ( doLink )
+    m_progress.SendLogMessage(LogInfo(Normal) << "Sliced mesh with %1 plane(s) into %2 polyline(s)."
+                                              << numLevels << numLoops);
 
   return true;
 }
@@ -40,12 +40,17 @@
 // OCCT includes
 #include <Geom_Plane.hxx>
 
+// Standard includes
+#include <vector>
+
 //-----------------------------------------------------------------------------
 
-//! Utility to intersect mesh with a plane. This algorithm is based on VTK
-//! cutter which returns an unordered set of points. As the second (and
-//! optional) stage, we sort the obtained points with concave hull utility,
-//! thus making the section ready for subsequent curve approximation.
+//! Utility to intersect mesh with a plane or a stack of parallel planes.
+//! The triangles are intersected directly, and the obtained segments are
+//! linked into ordered polylines through the mesh edges they share, so the
+//! sections with several loops or concave loops come out properly ordered.
+//! For a stack of planes, each triangle is distributed to the planes within
+//! its height range in one sweep, and the planes are then sliced concurrently.
 class asiAlgo_MeshInterPlane : public ActAPI_IAlgorithm
 {
 public:
@@ -53,6 +58,20 @@ public:
   // OCCT RTTI
   DEFINE_STANDARD_RTTI_INLINE(asiAlgo_MeshInterPlane, ActAPI_IAlgorithm)
 
+public:
+
+  //! Polyline of a section.
+  struct t_loop
+  {
+    std::vector<gp_XYZ> Pts;      //!< Ordered points.
+    bool                IsClosed; //!< Whether the polyline is closed.
+
+    t_loop() : IsClosed(false) {} //!< Ctor.
+  };
+
+  //! Section of the mesh by a single plane.
+  typedef std::vector<t_loop> t_section;
+
 public:
 
   //! Constructs intersection tool.
@@ -68,24 +87,64 @@ public:
 
   //! Performs intersection.
   //! \param[in] plane  plane to intersect the mesh with.
-  //! \param[in] doSort indicates whether to sort the obtained points.
+  //! \param[in] doSort indicates whether to link the obtained points into
+  //!                   ordered polylines.
   //! \return true in case of success, false -- otherwise.
   asiAlgo_EXPORT bool
     Perform(const Handle(Geom_Plane)& plane,
             const bool                doSort);
 
+  //! Performs intersection with a stack of parallel planes.
+  //! \param[in] pos    position of the base plane.
+  //! \param[in] levels offsets of the planes from the base one along its
+  //!                   normal direction.
+  //! \param[in] doSort indicates whether to link the obtained points into
+  //!                   ordered polylines.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const gp_Ax3&              pos,
+            const std::vector<double>& levels,
+            const bool                 doSort);
+
 public:
 
-  //! \return resulting section points.
+  //! \return resulting section points. If the points are linked, the
+  //!         polylines of all sections follow each other.
   const Handle(asiAlgo_BaseCloud<double>)& GetResult() const
   {
     return m_result;
   }
 
+  //! \return sections in the order of the passed levels.
+  const std::vector<t_section>& GetSections() const
+  {
+    return m_sections;
+  }
+
+  //! Sets multithreading mode (parallel or sequential).
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+protected:
+
+  //! Slices the mesh by the planes of the stack.
+  //! \param[in] pos    position of the base plane.
+  //! \param[in] levels offsets of the planes.
+  //! \param[in] doLink indicates whether to link the segments.
+  //! \return true in case of success, false -- otherwise.
+  bool slice(const gp_Ax3&              pos,
+             const std::vector<double>& levels,
+             const bool                 doLink);
+
 protected:
 
-  Handle(Poly_Triangulation)        m_mesh;   //!< Mesh to cut.
-  Handle(asiAlgo_BaseCloud<double>) m_result; //!< Resulting points.
+  Handle(Poly_Triangulation)        m_mesh;        //!< Mesh to cut.
+  Handle(asiAlgo_BaseCloud<double>) m_result;      //!< Resulting points.
+  std::vector<t_section>            m_sections;    //!< Resulting sections.
+  bool                              m_bIsParallel; //!< Multithreading mode.
 
 };
 
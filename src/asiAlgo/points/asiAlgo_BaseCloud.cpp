@@ -32,6 +32,7 @@
 #include <asiAlgo_BaseCloud.h>
 
 // asiAlgo includes
+#include <asiAlgo_CloudKernels.h>
 #include <asiAlgo_PointCloudUtils.h>
 
 // OpenCascade includes
@@ -196,40 +197,17 @@ void asiAlgo_BaseCloud<TCoordType>::ComputeBoundingBox(TCoordType& xMin, TCoordT
                                                        TCoordType& yMin, TCoordType& yMax,
                                                        TCoordType& zMin, TCoordType& zMax) const
 {
-  TCoordType _xMin = std::numeric_limits<TCoordType>::max();
-  TCoordType _yMin = _xMin;
-  TCoordType _zMin = _xMin;
-  TCoordType _xMax = std::numeric_limits<TCoordType>::min();
-  TCoordType _yMax = _xMax;
-  TCoordType _zMax = _xMax;
-
-  const int nElems = this->GetNumberOfElements();
-  //
-  for ( int e = 0; e < nElems; ++e )
-  {
-    TCoordType x, y, z;
-    this->GetElement(e, x, y, z);
-
-    if ( x > _xMax )
-      _xMax = x;
-    if ( x < _xMin )
-      _xMin = x;
-    if ( y > _yMax )
-      _yMax = y;
-    if ( y < _yMin )
-      _yMin = y;
-    if ( z > _zMax )
-      _zMax = z;
-    if ( z < _zMin )
-      _zMin = z;
-  }
-
-  xMin = _xMin;
-  xMax = _xMax;
-  yMin = _yMin;
-  yMax = _yMax;
-  zMin = _zMin;
-  zMax = _zMax;
+  TCoordType bounds[6];
+  asiAlgo_CloudKernels::ComputeBoundingBox( m_coords.empty() ? NULL : &m_coords[0],
+                                            this->GetNumberOfElements(),
+                                            bounds );
+
+  xMin = bounds[0];
+  xMax = bounds[1];
+  yMin = bounds[2];
+  yMax = bounds[3];
+  zMin = bounds[4];
+  zMax = bounds[5];
 }
 
 //-----------------------------------------------------------------------------
@@ -259,65 +237,58 @@ Handle(asiAlgo_BaseCloud<TCoordType>)
 template <typename TCoordType>
 void asiAlgo_BaseCloud<TCoordType>::Merge(const Handle(asiAlgo_BaseCloud<TCoordType>)& cloud)
 {
-  const int nElems2Add = cloud->GetNumberOfElements();
+  // The cloud can be this one, so its iterators would be invalidated by
+  // the growth of the vector.
+  const size_t numCoords = cloud->m_coords.size();
   //
-  for ( int e = 0; e < nElems2Add; ++e )
-  {
-    TCoordType x, y, z;
-    cloud->GetElement(e, x, y, z);
+  m_coords.reserve(m_coords.size() + numCoords);
+  //
+  for ( size_t k = 0; k < numCoords; ++k )
+    m_coords.push_back(cloud->m_coords[k]);
+}
 
-    this->AddElement(x, y, z);
-  }
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+void asiAlgo_BaseCloud<TCoordType>::Merge(const std::vector<Handle(asiAlgo_BaseCloud<TCoordType>)>& clouds)
+{
+  asiAlgo_CloudKernels::Merge(clouds, *this);
 }
 
 //-----------------------------------------------------------------------------
 
 template <typename TCoordType>
-bool asiAlgo_BaseCloud<TCoordType>::ComputeInertiaAxes(gp_Ax3& axes) const
+void asiAlgo_BaseCloud<TCoordType>::Transform(const gp_Trsf& T)
 {
-  TCoordType xCenter = 0.0;
-  TCoordType yCenter = 0.0;
-  TCoordType zCenter = 0.0;
-  TCoordType x, y, z;
-  gp_XYZ meanVertex;
+  if ( m_coords.empty() )
+    return;
 
-  for ( int i = 0; i < this->GetNumberOfElements(); ++i )
-  {
-    this->GetElement(i, x, y, z);
-    xCenter += x;
-    yCenter += y;
-    zCenter += z;
-  }
+  double mx[12];
+  for ( int r = 0; r < 3; ++r )
+    for ( int c = 0; c < 4; ++c )
+      mx[4*r + c] = T.Value(r + 1, c + 1);
 
-  meanVertex.SetX(xCenter);
-  meanVertex.SetY(yCenter);
-  meanVertex.SetZ(zCenter);
-  meanVertex /= this->GetNumberOfElements();
+  asiAlgo_CloudKernels::Transform(&m_coords[0], this->GetNumberOfElements(), mx, &m_coords[0]);
+}
 
-  Eigen::Matrix3d C;
-  for (int j = 0; j < 3; ++j)
-  {
-    for (int k = 0; k < 3; ++k)
-      C(j, k) = 0.0; // TODO: is that necessary?
-  }
+//-----------------------------------------------------------------------------
 
-  for (int i = 0; i < this->GetNumberOfElements(); ++i)
-  {
-    this->GetElement(i, x, y, z);
-    gp_XYZ p = gp_XYZ(x, y, z);
-    gp_XYZ p_dash = p - meanVertex;
+template <typename TCoordType>
+bool asiAlgo_BaseCloud<TCoordType>::ComputeInertiaAxes(gp_Ax3& axes) const
+{
+  if ( this->IsEmpty() )
+    return false;
 
-    for (int j = 0; j < 3; ++j)
-    {
-      for (int k = 0; k < 3; ++k)
-        C(j, k) += p_dash.Coord(j + 1) * p_dash.Coord(k + 1);
-    }
-  }
+  double center[3], cov[9];
+  asiAlgo_CloudKernels::ComputeCovariance(&m_coords[0], this->GetNumberOfElements(), center, cov);
 
-  for (int j = 0; j < 3; ++j)
+  gp_XYZ meanVertex(center[0], center[1], center[2]);
+
+  Eigen::Matrix3d C;
+  for ( int j = 0; j < 3; ++j )
   {
-    for (int k = 0; k < 3; ++k)
-      C(j, k) /= (this->GetNumberOfElements());
+    for ( int k = 0; k < 3; ++k )
+      C(j, k) = cov[3*j + k];
   }
 
   Eigen::EigenSolver<Eigen::Matrix3d> EigenSolver(C);
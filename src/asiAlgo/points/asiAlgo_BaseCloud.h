@@ -35,6 +35,7 @@
 #include <asiAlgo_CloudRegion.h>
 
 // OCCT includes
+#include <gp_Trsf.hxx>
 #include <gp_XYZ.hxx>
 #include <Standard_Type.hxx>
 #include <TColStd_HArray1OfReal.hxx>
@@ -108,6 +109,16 @@ public:
   asiAlgo_EXPORT void
     Merge(const Handle(asiAlgo_BaseCloud<TCoordType>)& cloud);
 
+  //! Appends several clouds at once with a single allocation.
+  //! \param[in] clouds clouds to append.
+  asiAlgo_EXPORT void
+    Merge(const std::vector<Handle(asiAlgo_BaseCloud<TCoordType>)>& clouds);
+
+  //! Transforms all elements in place.
+  //! \param[in] T transformation to apply.
+  asiAlgo_EXPORT void
+    Transform(const gp_Trsf& T);
+
   asiAlgo_EXPORT void
     Clear();
 
@@ -0,0 +1,918 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_CloudKdTree.h>
+
+// asiAlgo includes
+#include <asiAlgo_Timer.h>
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+  #include <parallel_invoke.h>
+#endif
+
+// Instantiate for allowed types
+template class asiAlgo_CloudKdTree<double>;
+template class asiAlgo_CloudKdTree<float>;
+
+//-----------------------------------------------------------------------------
+
+#define KDTREE_MAGIC   "ASIKDT"
+#define KDTREE_VERSION 1
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of points starting from which the subtrees are built in parallel.
+  const int ParallelBuildThreshold = 1 << 15;
+
+  //! Number of query points processed by a single task.
+  const int QueryGrain = 256;
+
+  //! Computes the number of nodes in a subtree containing the given number
+  //! of points. The results are cached as there are at most two distinct
+  //! subtree sizes on each level of the tree.
+  int NumNodes(const int           numPts,
+               const int           leafSize,
+               std::map<int, int>& cache)
+  {
+    if ( numPts <= leafSize )
+      return 1;
+
+    std::map<int, int>::const_iterator it = cache.find(numPts);
+    if ( it != cache.end() )
+      return it->second;
+
+    const int res = 1 + NumNodes(numPts/2,          leafSize, cache)
+                      + NumNodes(numPts - numPts/2, leafSize, cache);
+    //
+    cache[numPts] = res;
+    return res;
+  }
+
+  //! Compares the points by the given coordinate.
+  template <typename TCoordType>
+  struct CompareByAxis
+  {
+    CompareByAxis(const TCoordType* coords, const int axis)
+    : Coords(coords), Axis(axis) {}
+
+    bool operator()(const int i, const int j) const
+    {
+      return Coords[3*i + Axis] < Coords[3*j + Axis];
+    }
+
+    const TCoordType* Coords;
+    int               Axis;
+  };
+
+  //! Recursive construction of the tree.
+  template <typename TCoordType>
+  class BuildFunctor
+  {
+  public:
+
+    typedef typename asiAlgo_CloudKdTree<TCoordType>::t_node t_node;
+
+    BuildFunctor(const TCoordType*         coords,
+                 int*                      indices,
+                 t_node*                   nodes,
+                 const int                 leafSize,
+                 const std::map<int, int>& numNodes,
+                 const bool                isParallel,
+                 const int                 node,
+                 const int                 first,
+                 const int                 count)
+    : m_coords(coords), m_indices(indices), m_nodes(nodes), m_iLeafSize(leafSize),
+      m_numNodes(numNodes), m_bIsParallel(isParallel), m_iNode(node),
+      m_iFirst(first), m_iCount(count) {}
+
+    void operator()() const
+    {
+      t_node& node = m_nodes[m_iNode];
+
+      if ( m_iCount <= m_iLeafSize )
+      {
+        node.Split = 0;
+        node.Axis  = -1;
+        node.First = m_iFirst;
+        node.Count = m_iCount;
+        return;
+      }
+
+      // Choose the axis of the largest extent.
+      TCoordType bounds[6];
+      for ( int a = 0; a < 3; ++a )
+      {
+        bounds[a]     =  std::numeric_limits<TCoordType>::max();
+        bounds[a + 3] = -std::numeric_limits<TCoordType>::max();
+      }
+      //
+      for ( int i = m_iFirst; i < m_iFirst + m_iCount; ++i )
+      {
+        const TCoordType* P = &m_coords[3*m_indices[i]];
+        for ( int a = 0; a < 3; ++a )
+        {
+          bounds[a]     = std::min(bounds[a],     P[a]);
+          bounds[a + 3] = std::max(bounds[a + 3], P[a]);
+        }
+      }
+      //
+      int axis = 0;
+      for ( int a = 1; a < 3; ++a )
+        if ( bounds[a + 3] - bounds[a] > bounds[axis + 3] - bounds[axis] )
+          axis = a;
+
+      // Split at median.
+      const int numLeft = m_iCount/2;
+      const int mid     = m_iFirst + numLeft;
+      //
+      std::nth_element( m_indices + m_iFirst, m_indices + mid, m_indices + m_iFirst + m_iCount,
+                        CompareByAxis<TCoordType>(m_coords, axis) );
+
+      // The left subtree immediately follows the parent.
+      const int numLeftNodes = (numLeft <= m_iLeafSize) ? 1 : m_numNodes.find(numLeft)->second;
+      //
+      node.Split = m_coords[3*m_indices[mid] + axis];
+      node.Axis  = axis;
+      node.First = m_iNode + 1 + numLeftNodes;
+      node.Count = 0;
+
+      BuildFunctor left  (m_coords, m_indices, m_nodes, m_iLeafSize, m_numNodes, m_bIsParallel,
+                          m_iNode + 1, m_iFirst, numLeft);
+      BuildFunctor right (m_coords, m_indices, m_nodes, m_iLeafSize, m_numNodes, m_bIsParallel,
+                          node.First, mid, m_iCount - numLeft);
+
+#ifdef USE_THREADING
+      if ( m_bIsParallel && m_iCount >= ParallelBuildThreshold )
+      {
+        tbb::parallel_invoke(left, right);
+        return;
+      }
+#endif
+      left();
+      right();
+    }
+
+  private:
+
+    const TCoordType*         m_coords;
+    int*                      m_indices;
+    t_node*                   m_nodes;
+    int                       m_iLeafSize;
+    const std::map<int, int>& m_numNodes;
+    bool                      m_bIsParallel;
+    int                       m_iNode;
+    int                       m_iFirst;
+    int                       m_iCount;
+  };
+
+  //! Traversal of the tree with incremental distance to the nodes
+  //! (see S. Arya and D. Mount, "Algorithms for fast vector quantization").
+  //! The search is pruned when the lower bound of the distance to a node
+  //! exceeds the current worst distance.
+  template <typename TCoordType>
+  class Search
+  {
+  public:
+
+    typedef typename asiAlgo_CloudKdTree<TCoordType>::t_node t_node;
+
+    Search(const t_node*     nodes,
+           const TCoordType* coords,
+           const TCoordType* P)
+    : m_nodes(nodes), m_coords(coords), m_P(P) {}
+
+  protected:
+
+    //! Computes the squared distance to the bounding box.
+    static TCoordType boxDist(const TCoordType* P,
+                              const TCoordType* bounds,
+                              TCoordType*       offsets)
+    {
+      TCoordType rd = 0;
+      for ( int a = 0; a < 3; ++a )
+      {
+        offsets[a] = 0;
+        //
+        if ( P[a] < bounds[a] )
+          offsets[a] = P[a] - bounds[a];
+        else if ( P[a] > bounds[a + 3] )
+          offsets[a] = P[a] - bounds[a + 3];
+
+        rd += offsets[a]*offsets[a];
+      }
+      return rd;
+    }
+
+    //! Computes the squared distance to the given point.
+    TCoordType pointDist(const int pos) const
+    {
+      const TCoordType* Q  = &m_coords[3*pos];
+      const TCoordType  dx = Q[0] - m_P[0];
+      const TCoordType  dy = Q[1] - m_P[1];
+      const TCoordType  dz = Q[2] - m_P[2];
+      //
+      return dx*dx + dy*dy + dz*dz;
+    }
+
+  protected:
+
+    const t_node*     m_nodes;
+    const TCoordType* m_coords;
+    const TCoordType* m_P;
+  };
+
+  //! k nearest neighbors search.
+  template <typename TCoordType>
+  class KNearestSearch : public Search<TCoordType>
+  {
+  public:
+
+    typedef typename Search<TCoordType>::t_node t_node;
+
+    KNearestSearch(const t_node*     nodes,
+                   const TCoordType* coords,
+                   const TCoordType* P,
+                   const int         k,
+                   int*              pos,
+                   TCoordType*       sqDists)
+    : Search<TCoordType>(nodes, coords, P), m_iK(k), m_pPos(pos), m_pDists(sqDists),
+      m_iNumFound(0) {}
+
+    int Perform(const TCoordType* bounds)
+    {
+      TCoordType offsets[3];
+      const TCoordType rd = Search<TCoordType>::boxDist(this->m_P, bounds, offsets);
+      //
+      this->visit(0, rd, offsets);
+      return m_iNumFound;
+    }
+
+  private:
+
+    TCoordType worst() const
+    {
+      return (m_iNumFound < m_iK) ? std::numeric_limits<TCoordType>::max()
+                                  : m_pDists[m_iK - 1];
+    }
+
+    void add(const int pos, const TCoordType d)
+    {
+      if ( m_iNumFound == m_iK && d >= m_pDists[m_iK - 1] )
+        return;
+
+      // Insertion into the sorted list.
+      int i = (m_iNumFound < m_iK) ? m_iNumFound++ : m_iK - 1;
+      for ( ; i > 0 && m_pDists[i - 1] > d; --i )
+      {
+        m_pDists[i] = m_pDists[i - 1];
+        m_pPos[i]   = m_pPos[i - 1];
+      }
+      m_pDists[i] = d;
+      m_pPos[i]   = pos;
+    }
+
+    void visit(const int nodeIdx, const TCoordType rd, TCoordType* offsets)
+    {
+      const t_node& node = this->m_nodes[nodeIdx];
+
+      if ( node.Axis < 0 )
+      {
+        for ( int p = node.First; p < node.First + node.Count; ++p )
+          this->add( p, this->pointDist(p) );
+        return;
+      }
+
+      const int        axis    = node.Axis;
+      const TCoordType diff    = this->m_P[axis] - node.Split;
+      const int        nearIdx = (diff < 0) ? nodeIdx + 1 : node.First;
+      const int        farIdx  = (diff < 0) ? node.First  : nodeIdx + 1;
+
+      this->visit(nearIdx, rd, offsets);
+
+      const TCoordType saved   = offsets[axis];
+      const TCoordType farDist = rd - saved*saved + diff*diff;
+      //
+      if ( farDist < this->worst() )
+      {
+        offsets[axis] = diff;
+        this->visit(farIdx, farDist, offsets);
+        offsets[axis] = saved;
+      }
+    }
+
+  private:
+
+    int         m_iK;
+    int*        m_pPos;
+    TCoordType* m_pDists;
+    int         m_iNumFound;
+  };
+
+  //! Radius search.
+  template <typename TCoordType>
+  class RadiusSearch : public Search<TCoordType>
+  {
+  public:
+
+    typedef typename Search<TCoordType>::t_node t_node;
+
+    RadiusSearch(const t_node*                               nodes,
+                 const TCoordType*                           coords,
+                 const TCoordType*                           P,
+                 const TCoordType                            sqRadius,
+                 std::vector< std::pair<TCoordType, int> >& result)
+    : Search<TCoordType>(nodes, coords, P), m_fSqRadius(sqRadius), m_result(result) {}
+
+    void Perform(const TCoordType* bounds)
+    {
+      TCoordType offsets[3];
+      const TCoordType rd = Search<TCoordType>::boxDist(this->m_P, bounds, offsets);
+      //
+      if ( rd <= m_fSqRadius )
+        this->visit(0, rd, offsets);
+
+      std::sort( m_result.begin(), m_result.end() );
+    }
+
+  private:
+
+    void visit(const int nodeIdx, const TCoordType rd, TCoordType* offsets)
+    {
+      const t_node& node = this->m_nodes[nodeIdx];
+
+      if ( node.Axis < 0 )
+      {
+        for ( int p = node.First; p < node.First + node.Count; ++p )
+        {
+          const TCoordType d = this->pointDist(p);
+          if ( d <= m_fSqRadius )
+            m_result.push_back( std::pair<TCoordType, int>(d, p) );
+        }
+        return;
+      }
+
+      const int        axis    = node.Axis;
+      const TCoordType diff    = this->m_P[axis] - node.Split;
+      const int        nearIdx = (diff < 0) ? nodeIdx + 1 : node.First;
+      const int        farIdx  = (diff < 0) ? node.First  : nodeIdx + 1;
+
+      this->visit(nearIdx, rd, offsets);
+
+      const TCoordType saved   = offsets[axis];
+      const TCoordType farDist = rd - saved*saved + diff*diff;
+      //
+      if ( farDist <= m_fSqRadius )
+      {
+        offsets[axis] = diff;
+        this->visit(farIdx, farDist, offsets);
+        offsets[axis] = saved;
+      }
+    }
+
+  private:
+
+    TCoordType                                 m_fSqRadius;
+    std::vector< std::pair<TCoordType, int> >& m_result;
+  };
+
+  //! Copies coordinates in the order of leaves.
+  template <typename TCoordType>
+  class ReorderFunctor
+  {
+  public:
+
+    ReorderFunctor(const TCoordType* src, const int* indices, TCoordType* dst)
+    : m_src(src), m_indices(indices), m_dst(dst) {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int i = first; i < last; ++i )
+      {
+        const TCoordType* P = &m_src[3*m_indices[i]];
+        //
+        m_dst[3*i]     = P[0];
+        m_dst[3*i + 1] = P[1];
+        m_dst[3*i + 2] = P[2];
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const TCoordType* m_src;
+    const int*        m_indices;
+    TCoordType*       m_dst;
+  };
+
+  //! Batched k nearest neighbors search.
+  template <typename TCoordType>
+  class KNearestFunctor
+  {
+  public:
+
+    KNearestFunctor(const asiAlgo_CloudKdTree<TCoordType>* tree,
+                    const TCoordType*                      queries,
+                    const int                              k,
+                    int*                                   indices,
+                    TCoordType*                            sqDists)
+    : m_tree(tree), m_queries(queries), m_iK(k), m_pIndices(indices), m_pDists(sqDists) {}
+
+    void Process(const int first, const int last) const
+    {
+      std::vector<int>        indices;
+      std::vector<TCoordType> sqDists;
+      //
+      for ( int q = first; q < last; ++q )
+      {
+        const TCoordType* P   = &m_queries[3*q];
+        const int         num = m_tree->FindKNearest(P[0], P[1], P[2], m_iK, indices, sqDists);
+
+        for ( int i = 0; i < m_iK; ++i )
+        {
+          m_pIndices[q*m_iK + i] = (i < num) ? indices[i] : -1;
+          m_pDists  [q*m_iK + i] = (i < num) ? sqDists[i] : std::numeric_limits<TCoordType>::max();
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const asiAlgo_CloudKdTree<TCoordType>* m_tree;
+    const TCoordType*                      m_queries;
+    int                                    m_iK;
+    int*                                   m_pIndices;
+    TCoordType*                            m_pDists;
+  };
+
+  //! Batched radius search.
+  template <typename TCoordType>
+  class RadiusFunctor
+  {
+  public:
+
+    RadiusFunctor(const asiAlgo_CloudKdTree<TCoordType>*  tree,
+                  const TCoordType*                       queries,
+                  const TCoordType                        radius,
+                  std::vector< std::vector<int> >&        indices,
+                  std::vector< std::vector<TCoordType> >& sqDists)
+    : m_tree(tree), m_queries(queries), m_fRadius(radius), m_indices(indices), m_sqDists(sqDists) {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int q = first; q < last; ++q )
+      {
+        const TCoordType* P = &m_queries[3*q];
+        //
+        m_tree->FindInRadius(P[0], P[1], P[2], m_fRadius, m_indices[q], m_sqDists[q]);
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const asiAlgo_CloudKdTree<TCoordType>*  m_tree;
+    const TCoordType*                       m_queries;
+    TCoordType                              m_fRadius;
+    std::vector< std::vector<int> >&        m_indices;
+    std::vector< std::vector<TCoordType> >& m_sqDists;
+  };
+
+  //! Runs the functor over the range of items.
+  template <typename TFunctor>
+  void Run(const TFunctor& func, const int num, const int grain, const bool isParallel)
+  {
+#ifdef USE_THREADING
+    if ( isParallel )
+    {
+      tbb::parallel_for(tbb::blocked_range<int>(0, num, grain), func);
+      return;
+    }
+#else
+    (void) grain;
+    (void) isParallel;
+#endif
+    func.Process(0, num);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+asiAlgo_CloudKdTree<TCoordType>::asiAlgo_CloudKdTree(ActAPI_ProgressEntry progress,
+                                                      ActAPI_PlotterEntry  plotter)
+: Standard_Transient (),
+  m_iLeafSize        (16),
+  m_bIsParallel      (true),
+  m_progress         (progress),
+  m_plotter          (plotter)
+{
+  for ( int a = 0; a < 6; ++a )
+    m_bounds[a] = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+bool asiAlgo_CloudKdTree<TCoordType>::Build(const Handle(asiAlgo_BaseCloud<TCoordType>)& cloud,
+                                            const int                                    leafSize)
+{
+  m_nodes.clear();
+  m_coords.clear();
+  m_indices.clear();
+  m_iLeafSize = std::max(leafSize, 1);
+
+  if ( cloud.IsNull() || cloud->IsEmpty() )
+    return false;
+
+  TIMER_NEW
+  TIMER_GO
+
+  const int                      numPts = cloud->GetNumberOfElements();
+  const std::vector<TCoordType>& coords = cloud->GetCoords();
+
+  // Bounding box of the entire cloud is used to start the traversals.
+  cloud->ComputeBoundingBox(m_bounds[0], m_bounds[3],
+                            m_bounds[1], m_bounds[4],
+                            m_bounds[2], m_bounds[5]);
+
+  // The subtree sizes are known in advance as the points are split at
+  // median, so the subtrees can be populated concurrently.
+  std::map<int, int> numNodes;
+  m_nodes.resize( NumNodes(numPts, m_iLeafSize, numNodes) );
+  //
+  m_indices.resize(numPts);
+  for ( int i = 0; i < numPts; ++i )
+    m_indices[i] = i;
+
+  BuildFunctor<TCoordType>( &coords[0], &m_indices[0], &m_nodes[0], m_iLeafSize, numNodes,
+                            m_bIsParallel, 0, 0, numPts )();
+
+  // Copy coordinates in the order of leaves.
+  m_coords.resize(3*numPts);
+  //
+  Run(ReorderFunctor<TCoordType>( &coords[0], &m_indices[0], &m_coords[0] ),
+      numPts, 4096, m_bIsParallel);
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Build k-d tree")
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "k-d tree with %1 nodes is built for %2 points."
+                                             << int( m_nodes.size() ) << numPts );
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+int asiAlgo_CloudKdTree<TCoordType>::FindNearest(const TCoordType x,
+                                                 const TCoordType y,
+                                                 const TCoordType z,
+                                                 TCoordType&      sqDist) const
+{
+  if ( m_indices.empty() )
+    return -1;
+
+  const TCoordType P[3] = {x, y, z};
+  int              pos  = -1;
+  int              num  = 0;
+  //
+  this->searchKNearest(P, 1, &pos, &sqDist, num);
+
+  return num ? m_indices[pos] : -1;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+int asiAlgo_CloudKdTree<TCoordType>::FindKNearest(const TCoordType         x,
+                                                  const TCoordType         y,
+                                                  const TCoordType         z,
+                                                  const int                k,
+                                                  std::vector<int>&        indices,
+                                                  std::vector<TCoordType>& sqDists) const
+{
+  indices.clear();
+  sqDists.clear();
+
+  if ( m_indices.empty() || k <= 0 )
+    return 0;
+
+  const TCoordType P[3] = {x, y, z};
+  int              num  = 0;
+  //
+  indices.resize(k);
+  sqDists.resize(k);
+  //
+  this->searchKNearest(P, k, &indices[0], &sqDists[0], num);
+
+  indices.resize(num);
+  sqDists.resize(num);
+
+  // Convert positions in the tree to the indices in the source cloud.
+  for ( int i = 0; i < num; ++i )
+    indices[i] = m_indices[indices[i]];
+
+  return num;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+int asiAlgo_CloudKdTree<TCoordType>::FindInRadius(const TCoordType         x,
+                                                  const TCoordType         y,
+                                                  const TCoordType         z,
+                                                  const TCoordType         radius,
+                                                  std::vector<int>&        indices,
+                                                  std::vector<TCoordType>& sqDists) const
+{
+  indices.clear();
+  sqDists.clear();
+
+  if ( m_indices.empty() || radius < 0 )
+    return 0;
+
+  const TCoordType P[3] = {x, y, z};
+  this->searchInRadius(P, radius*radius, indices, sqDists);
+
+  return int( indices.size() );
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+void asiAlgo_CloudKdTree<TCoordType>::FindKNearest(const std::vector<TCoordType>& queries,
+                                                   const int                      k,
+                                                   std::vector<int>&              indices,
+                                                   std::vector<TCoordType>&       sqDists) const
+{
+  const int numQueries = int( queries.size() / 3 );
+  //
+  indices.resize( numQueries*std::max(k, 0) );
+  sqDists.resize( numQueries*std::max(k, 0) );
+
+  if ( !numQueries || k <= 0 )
+    return;
+
+  Run(KNearestFunctor<TCoordType>( this, &queries[0], k, &indices[0], &sqDists[0] ),
+      numQueries, QueryGrain, m_bIsParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+void asiAlgo_CloudKdTree<TCoordType>::FindInRadius(const std::vector<TCoordType>&          queries,
+                                                   const TCoordType                        radius,
+                                                   std::vector< std::vector<int> >&        indices,
+                                                   std::vector< std::vector<TCoordType> >& sqDists) const
+{
+  const int numQueries = int( queries.size() / 3 );
+  //
+  indices.clear();
+  sqDists.clear();
+  indices.resize(numQueries);
+  sqDists.resize(numQueries);
+
+  if ( !numQueries )
+    return;
+
+  Run(RadiusFunctor<TCoordType>( this, &queries[0], radius, indices, sqDists ),
+      numQueries, QueryGrain, m_bIsParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+bool asiAlgo_CloudKdTree<TCoordType>::SaveAs(const char* filename) const
+{
+  std::ofstream FILE(filename, std::ios::out | std::ios::binary);
+  if ( !FILE.is_open() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot open file '%1' for writing." << filename);
+    return false;
+  }
+
+  const int numPts    = this->GetNumberOfPoints();
+  const int numNodes  = this->GetNumberOfNodes();
+  const int version   = KDTREE_VERSION;
+  const int coordSize = int( sizeof(TCoordType) );
+
+  char magic[8] = {0};
+  strcpy(magic, KDTREE_MAGIC);
+
+  FILE.write( magic,                                       sizeof(magic) );
+  FILE.write( reinterpret_cast<const char*>(&version),     sizeof(int) );
+  FILE.write( reinterpret_cast<const char*>(&coordSize),   sizeof(int) );
+  FILE.write( reinterpret_cast<const char*>(&numPts),      sizeof(int) );
+  FILE.write( reinterpret_cast<const char*>(&numNodes),    sizeof(int) );
+  FILE.write( reinterpret_cast<const char*>(&m_iLeafSize), sizeof(int) );
+  FILE.write( reinterpret_cast<const char*>(m_bounds),     6*sizeof(TCoordType) );
+
+  for ( int n = 0; n < numNodes; ++n )
+  {
+    const t_node& node = m_nodes[n];
+    //
+    FILE.write( reinterpret_cast<const char*>(&node.Split), sizeof(TCoordType) );
+    FILE.write( reinterpret_cast<const char*>(&node.Axis),  sizeof(int) );
+    FILE.write( reinterpret_cast<const char*>(&node.First), sizeof(int) );
+    FILE.write( reinterpret_cast<const char*>(&node.Count), sizeof(int) );
+  }
+
+  if ( numPts )
+  {
+    FILE.write( reinterpret_cast<const char*>(&m_indices[0]), numPts*sizeof(int) );
+    FILE.write( reinterpret_cast<const char*>(&m_coords[0]),  3*numPts*sizeof(TCoordType) );
+  }
+
+  return FILE.good();
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+bool asiAlgo_CloudKdTree<TCoordType>::Load(const char* filename)
+{
+  m_nodes.clear();
+  m_coords.clear();
+  m_indices.clear();
+
+  std::ifstream FILE(filename, std::ios::in | std::ios::binary);
+  if ( !FILE.is_open() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot open file '%1' for reading." << filename);
+    return false;
+  }
+
+  char magic[8];
+  int  version = 0, coordSize = 0, numPts = 0, numNodes = 0, leafSize = 0;
+  //
+  FILE.read( magic,                               sizeof(magic) );
+  FILE.read( reinterpret_cast<char*>(&version),   sizeof(int) );
+  FILE.read( reinterpret_cast<char*>(&coordSize), sizeof(int) );
+  FILE.read( reinterpret_cast<char*>(&numPts),    sizeof(int) );
+  FILE.read( reinterpret_cast<char*>(&numNodes),  sizeof(int) );
+  FILE.read( reinterpret_cast<char*>(&leafSize),  sizeof(int) );
+  FILE.read( reinterpret_cast<char*>(m_bounds),   6*sizeof(TCoordType) );
+  //
+  if ( !FILE.good() || strncmp(magic, KDTREE_MAGIC, sizeof(magic)) )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "File '%1' is not a k-d tree file." << filename);
+    return false;
+  }
+  //
+  if ( version != KDTREE_VERSION || coordSize != int( sizeof(TCoordType) ) )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Unsupported k-d tree file version (%1) "
+                                                "or coordinate size (%2)." << version << coordSize);
+    return false;
+  }
+  //
+  if ( numPts < 0 || numNodes < 0 || leafSize < 1 || (numPts && !numNodes) )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Corrupted header of the k-d tree file.");
+    return false;
+  }
+
+  m_iLeafSize = leafSize;
+  m_nodes.resize(numNodes);
+  //
+  for ( int n = 0; n < numNodes; ++n )
+  {
+    t_node& node = m_nodes[n];
+    //
+    FILE.read( reinterpret_cast<char*>(&node.Split), sizeof(TCoordType) );
+    FILE.read( reinterpret_cast<char*>(&node.Axis),  sizeof(int) );
+    FILE.read( reinterpret_cast<char*>(&node.First), sizeof(int) );
+    FILE.read( reinterpret_cast<char*>(&node.Count), sizeof(int) );
+  }
+
+  if ( numPts )
+  {
+    m_indices.resize(numPts);
+    m_coords.resize(3*numPts);
+    //
+    FILE.read( reinterpret_cast<char*>(&m_indices[0]), numPts*sizeof(int) );
+    FILE.read( reinterpret_cast<char*>(&m_coords[0]),  3*numPts*sizeof(TCoordType) );
+  }
+
+  // Validate the structure so that corrupted files do not crash the queries.
+  bool isValid = FILE.good();
+  //
+  for ( int n = 0; isValid && n < numNodes; ++n )
+  {
+    const t_node& node = m_nodes[n];
+    //
+    if ( node.Axis < 0 )
+      isValid = (node.First >= 0) && (node.Count >= 0) && (node.First + node.Count <= numPts);
+    else
+      isValid = (node.Axis < 3) && (node.First > n + 1) && (node.First < numNodes);
+  }
+  //
+  for ( int i = 0; isValid && i < numPts; ++i )
+    isValid = (m_indices[i] >= 0) && (m_indices[i] < numPts);
+
+  if ( !isValid )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Corrupted k-d tree file '%1'." << filename);
+    m_nodes.clear();
+    m_coords.clear();
+    m_indices.clear();
+    return false;
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+void asiAlgo_CloudKdTree<TCoordType>::searchKNearest(const TCoordType* P,
+                                                     const int         k,
+                                                     int*              indices,
+                                                     TCoordType*       sqDists,
+                                                     int&              numFound) const
+{
+  KNearestSearch<TCoordType> search(&m_nodes[0], &m_coords[0], P, k, indices, sqDists);
+  numFound = search.Perform(m_bounds);
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TCoordType>
+void asiAlgo_CloudKdTree<TCoordType>::searchInRadius(const TCoordType*        P,
+                                                     const TCoordType         sqRadius,
+                                                     std::vector<int>&        indices,
+                                                     std::vector<TCoordType>& sqDists) const
+{
+  std::vector< std::pair<TCoordType, int> > result;
+  //
+  RadiusSearch<TCoordType> search(&m_nodes[0], &m_coords[0], P, sqRadius, result);
+  search.Perform(m_bounds);
+
+  indices.resize( result.size() );
+  sqDists.resize( result.size() );
+  //
+  for ( size_t i = 0; i < result.size(); ++i )
+  {
+    sqDists[i] = result[i].first;
+    indices[i] = m_indices[result[i].second];
+  }
+}
@@ -0,0 +1,239 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_CloudKdTree_h
+#define asiAlgo_CloudKdTree_h
+
+// asiAlgo includes
+#include <asiAlgo_BaseCloud.h>
+
+// Active Data includes
+#include <ActAPI_IPlotter.h>
+#include <ActAPI_IProgressNotifier.h>
+
+// STL includes
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+//! k-d tree for spatial queries on a point cloud. The tree is stored as a
+//! flat array of nodes in depth-first order, so the left child of an inner
+//! node immediately follows its parent. Points are split at the median along
+//! the axis of the largest extent until a node contains no more than the
+//! given number of points (leaf bucket). The coordinates are copied in the
+//! order of leaves, so the points of a bucket are contiguous in memory.
+//!
+//! The construction and the batched queries run in parallel if Analysis
+//! Situs is built with Intel TBB. The tree does not keep a reference to the
+//! source cloud and can be saved to (and restored from) a binary file.
+template <typename TCoordType>
+class asiAlgo_CloudKdTree : public Standard_Transient
+{
+public:
+
+  //! Node of the tree.
+  struct t_node
+  {
+    TCoordType Split; //!< Split coordinate for inner nodes.
+    int        Axis;  //!< Split axis (0, 1, 2) or -1 for leaves.
+    int        First; //!< Right child for inner nodes or first point for leaves.
+    int        Count; //!< Number of points in a leaf.
+  };
+
+public:
+
+  //! Ctor accepting progress notifier and imperative plotter.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  asiAlgo_EXPORT
+    asiAlgo_CloudKdTree(ActAPI_ProgressEntry progress = nullptr,
+                        ActAPI_PlotterEntry  plotter  = nullptr);
+
+public:
+
+  //! Builds the tree for the passed point cloud.
+  //! \param[in] cloud    point cloud to index.
+  //! \param[in] leafSize max number of points in a leaf bucket.
+  //! \return false if the cloud is empty.
+  asiAlgo_EXPORT bool
+    Build(const Handle(asiAlgo_BaseCloud<TCoordType>)& cloud,
+          const int                                    leafSize = 16);
+
+  //! Finds the nearest point.
+  //! \param[in]  x      X coordinate of the query point.
+  //! \param[in]  y      Y coordinate of the query point.
+  //! \param[in]  z      Z coordinate of the query point.
+  //! \param[out] sqDist squared distance to the nearest point.
+  //! \return 0-based index of the nearest point in the source cloud or -1
+  //!         if the tree is empty.
+  asiAlgo_EXPORT int
+    FindNearest(const TCoordType x,
+                const TCoordType y,
+                const TCoordType z,
+                TCoordType&      sqDist) const;
+
+  //! Finds k nearest points sorted by distance.
+  //! \param[in]  x       X coordinate of the query point.
+  //! \param[in]  y       Y coordinate of the query point.
+  //! \param[in]  z       Z coordinate of the query point.
+  //! \param[in]  k       number of neighbors to find.
+  //! \param[out] indices 0-based indices of the found points.
+  //! \param[out] sqDists squared distances to the found points.
+  //! \return number of found points (less than k for small clouds).
+  asiAlgo_EXPORT int
+    FindKNearest(const TCoordType         x,
+                 const TCoordType         y,
+                 const TCoordType         z,
+                 const int                k,
+                 std::vector<int>&        indices,
+                 std::vector<TCoordType>& sqDists) const;
+
+  //! Finds all points within the given radius sorted by distance.
+  //! \param[in]  x       X coordinate of the query point.
+  //! \param[in]  y       Y coordinate of the query point.
+  //! \param[in]  z       Z coordinate of the query point.
+  //! \param[in]  radius  search radius.
+  //! \param[out] indices 0-based indices of the found points.
+  //! \param[out] sqDists squared distances to the found points.
+  //! \return number of found points.
+  asiAlgo_EXPORT int
+    FindInRadius(const TCoordType         x,
+                 const TCoordType         y,
+                 const TCoordType         z,
+                 const TCoordType         radius,
+                 std::vector<int>&        indices,
+                 std::vector<TCoordType>& sqDists) const;
+
+  //! Finds k nearest points for each query point. The results are stored
+  //! with the stride of k. Missing neighbors (if the cloud contains less
+  //! than k points) are marked with -1 indices.
+  //! \param[in]  queries query points as coordinate triples.
+  //! \param[in]  k       number of neighbors to find.
+  //! \param[out] indices 0-based indices of the found points.
+  //! \param[out] sqDists squared distances to the found points.
+  asiAlgo_EXPORT void
+    FindKNearest(const std::vector<TCoordType>& queries,
+                 const int                      k,
+                 std::vector<int>&              indices,
+                 std::vector<TCoordType>&       sqDists) const;
+
+  //! Finds all points within the given radius for each query point.
+  //! \param[in]  queries query points as coordinate triples.
+  //! \param[in]  radius  search radius.
+  //! \param[out] indices 0-based indices of the found points per query.
+  //! \param[out] sqDists squared distances to the found points per query.
+  asiAlgo_EXPORT void
+    FindInRadius(const std::vector<TCoordType>&          queries,
+                 const TCoordType                        radius,
+                 std::vector< std::vector<int> >&        indices,
+                 std::vector< std::vector<TCoordType> >& sqDists) const;
+
+public:
+
+  //! Writes the tree to a binary file.
+  //! \param[in] filename file to write into.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    SaveAs(const char* filename) const;
+
+  //! Reads the tree from a binary file written by SaveAs().
+  //! \param[in] filename file to read.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Load(const char* filename);
+
+public:
+
+  //! Enables/disables parallel mode.
+  //! \param[in] on the Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+  //! \return true if parallel mode is enabled.
+  bool IsParallelMode() const
+  {
+    return m_bIsParallel;
+  }
+
+  //! \return number of indexed points.
+  int GetNumberOfPoints() const
+  {
+    return int( m_indices.size() );
+  }
+
+  //! \return number of nodes.
+  int GetNumberOfNodes() const
+  {
+    return int( m_nodes.size() );
+  }
+
+  //! \return max number of points in a leaf.
+  int GetLeafSize() const
+  {
+    return m_iLeafSize;
+  }
+
+  //! \return nodes of the tree.
+  const std::vector<t_node>& GetNodes() const
+  {
+    return m_nodes;
+  }
+
+protected:
+
+  asiAlgo_EXPORT void
+    searchKNearest(const TCoordType* P,
+                   const int         k,
+                   int*              indices,
+                   TCoordType*       sqDists,
+                   int&              numFound) const;
+
+  asiAlgo_EXPORT void
+    searchInRadius(const TCoordType*        P,
+                   const TCoordType         sqRadius,
+                   std::vector<int>&        indices,
+                   std::vector<TCoordType>& sqDists) const;
+
+protected:
+
+  std::vector<t_node>     m_nodes;       //!< Nodes in depth-first order.
+  std::vector<TCoordType> m_coords;      //!< Coordinates in the order of leaves.
+  std::vector<int>        m_indices;     //!< Indices of points in the source cloud.
+  TCoordType              m_bounds[6];   //!< Bounding box (min, max).
+  int                     m_iLeafSize;   //!< Max number of points in a leaf.
+  bool                    m_bIsParallel; //!< Whether to run in parallel mode.
+  ActAPI_ProgressEntry    m_progress;    //!< Progress notifier.
+  ActAPI_PlotterEntry     m_plotter;     //!< Imperative plotter.
+
+};
+
+#endif
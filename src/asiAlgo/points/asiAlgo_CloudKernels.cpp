@@ -0,0 +1,808 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_CloudKernels.h>
+
+// Standard includes
+#include <algorithm>
+#include <limits>
+
+#if defined __AVX__
+  #include <immintrin.h>
+  #define asiAlgo_CloudKernels_AVX
+#elif defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define asiAlgo_CloudKernels_SSE2
+#endif
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of points processed by a single task.
+  const int BlockSize = 65536;
+
+  //! Number of points accumulated in registers before the sums are flushed
+  //! to double precision.
+  const int ChunkSize = 1024;
+
+  //! Max number of lanes in a register.
+  const int MaxWidth = 8;
+
+  //---------------------------------------------------------------------------
+  // Wrappers of SIMD registers. The generic template is the scalar fallback.
+  //---------------------------------------------------------------------------
+
+  template <typename T>
+  struct t_simd
+  {
+    typedef T t_reg;
+    enum { Width = 1 };
+
+    static t_reg Load  (const T* p)         { return *p; }
+    static t_reg Zero  ()                   { return T(0); }
+    static t_reg Min   (t_reg a, t_reg b)   { return (a < b) ? a : b; }
+    static t_reg Max   (t_reg a, t_reg b)   { return (a > b) ? a : b; }
+    static t_reg Add   (t_reg a, t_reg b)   { return a + b; }
+    static t_reg Sub   (t_reg a, t_reg b)   { return a - b; }
+    static t_reg Mul   (t_reg a, t_reg b)   { return a*b; }
+    static void  Store (T* p, t_reg a)      { *p = a; }
+  };
+
+#if defined asiAlgo_CloudKernels_AVX
+
+  template <>
+  struct t_simd<float>
+  {
+    typedef __m256 t_reg;
+    enum { Width = 8 };
+
+    static t_reg Load  (const float* p)     { return _mm256_loadu_ps(p); }
+    static t_reg Zero  ()                   { return _mm256_setzero_ps(); }
+    static t_reg Min   (t_reg a, t_reg b)   { return _mm256_min_ps(a, b); }
+    static t_reg Max   (t_reg a, t_reg b)   { return _mm256_max_ps(a, b); }
+    static t_reg Add   (t_reg a, t_reg b)   { return _mm256_add_ps(a, b); }
+    static t_reg Sub   (t_reg a, t_reg b)   { return _mm256_sub_ps(a, b); }
+    static t_reg Mul   (t_reg a, t_reg b)   { return _mm256_mul_ps(a, b); }
+    static void  Store (float* p, t_reg a)  { _mm256_storeu_ps(p, a); }
+  };
+
+  template <>
+  struct t_simd<double>
+  {
+    typedef __m256d t_reg;
+    enum { Width = 4 };
+
+    static t_reg Load  (const double* p)    { return _mm256_loadu_pd(p); }
+    static t_reg Zero  ()                   { return _mm256_setzero_pd(); }
+    static t_reg Min   (t_reg a, t_reg b)   { return _mm256_min_pd(a, b); }
+    static t_reg Max   (t_reg a, t_reg b)   { return _mm256_max_pd(a, b); }
+    static t_reg Add   (t_reg a, t_reg b)   { return _mm256_add_pd(a, b); }
+    static t_reg Sub   (t_reg a, t_reg b)   { return _mm256_sub_pd(a, b); }
+    static t_reg Mul   (t_reg a, t_reg b)   { return _mm256_mul_pd(a, b); }
+    static void  Store (double* p, t_reg a) { _mm256_storeu_pd(p, a); }
+  };
+
+#elif defined asiAlgo_CloudKernels_SSE2
+
+  template <>
+  struct t_simd<float>
+  {
+    typedef __m128 t_reg;
+    enum { Width = 4 };
+
+    static t_reg Load  (const float* p)     { return _mm_loadu_ps(p); }
+    static t_reg Zero  ()                   { return _mm_setzero_ps(); }
+    static t_reg Min   (t_reg a, t_reg b)   { return _mm_min_ps(a, b); }
+    static t_reg Max   (t_reg a, t_reg b)   { return _mm_max_ps(a, b); }
+    static t_reg Add   (t_reg a, t_reg b)   { return _mm_add_ps(a, b); }
+    static t_reg Sub   (t_reg a, t_reg b)   { return _mm_sub_ps(a, b); }
+    static t_reg Mul   (t_reg a, t_reg b)   { return _mm_mul_ps(a, b); }
+    static void  Store (float* p, t_reg a)  { _mm_storeu_ps(p, a); }
+  };
+
+  template <>
+  struct t_simd<double>
+  {
+    typedef __m128d t_reg;
+    enum { Width = 2 };
+
+    static t_reg Load  (const double* p)    { return _mm_loadu_pd(p); }
+    static t_reg Zero  ()                   { return _mm_setzero_pd(); }
+    static t_reg Min   (t_reg a, t_reg b)   { return _mm_min_pd(a, b); }
+    static t_reg Max   (t_reg a, t_reg b)   { return _mm_max_pd(a, b); }
+    static t_reg Add   (t_reg a, t_reg b)   { return _mm_add_pd(a, b); }
+    static t_reg Sub   (t_reg a, t_reg b)   { return _mm_sub_pd(a, b); }
+    static t_reg Mul   (t_reg a, t_reg b)   { return _mm_mul_pd(a, b); }
+    static void  Store (double* p, t_reg a) { _mm_storeu_pd(p, a); }
+  };
+
+#endif
+
+  //---------------------------------------------------------------------------
+  // Kernels over ranges of points. The coordinates are interleaved, so W
+  // points occupy three registers of W lanes, and the lane L of the
+  // register r holds the coordinate (W*r + L) % 3.
+  //---------------------------------------------------------------------------
+
+  //! Computes the box of points in the range.
+  template <typename T>
+  void BoxRange(const T* coords, const int first, const int last, T* bounds)
+  {
+    typedef t_simd<T>             S;
+    typedef typename S::t_reg     t_reg;
+    const int                     W = S::Width;
+
+    T lo[3], hi[3];
+    for ( int a = 0; a < 3; ++a )
+    {
+      lo[a] =  std::numeric_limits<T>::max();
+      hi[a] = -std::numeric_limits<T>::max();
+    }
+
+    int i = first;
+    //
+    if ( last - first >= W )
+    {
+      t_reg mn[3], mx[3];
+      for ( int r = 0; r < 3; ++r )
+        mn[r] = mx[r] = S::Load(coords + 3*first + W*r);
+
+      for ( i = first + W; i + W <= last; i += W )
+      {
+        const T* p = coords + 3*i;
+        //
+        for ( int r = 0; r < 3; ++r )
+        {
+          const t_reg v = S::Load(p + W*r);
+          //
+          mn[r] = S::Min(mn[r], v);
+          mx[r] = S::Max(mx[r], v);
+        }
+      }
+
+      T lanesMin[3*MaxWidth], lanesMax[3*MaxWidth];
+      for ( int r = 0; r < 3; ++r )
+      {
+        S::Store(lanesMin + W*r, mn[r]);
+        S::Store(lanesMax + W*r, mx[r]);
+      }
+      //
+      for ( int l = 0; l < 3*W; ++l )
+      {
+        lo[l % 3] = std::min(lo[l % 3], lanesMin[l]);
+        hi[l % 3] = std::max(hi[l % 3], lanesMax[l]);
+      }
+    }
+
+    for ( ; i < last; ++i )
+    {
+      for ( int a = 0; a < 3; ++a )
+      {
+        lo[a] = std::min(lo[a], coords[3*i + a]);
+        hi[a] = std::max(hi[a], coords[3*i + a]);
+      }
+    }
+
+    for ( int a = 0; a < 3; ++a )
+    {
+      bounds[2*a]     = lo[a];
+      bounds[2*a + 1] = hi[a];
+    }
+  }
+
+  //! Computes the sums of coordinates of points in the range.
+  template <typename T>
+  void SumRange(const T* coords, const int first, const int last, double* sums)
+  {
+    typedef t_simd<T>             S;
+    typedef typename S::t_reg     t_reg;
+    const int                     W = S::Width;
+
+    sums[0] = sums[1] = sums[2] = 0.;
+
+    const int simdLast = first + (last - first)/W*W;
+    //
+    for ( int c = first; c < simdLast; c += ChunkSize )
+    {
+      const int cLast = std::min(c + ChunkSize, simdLast);
+
+      t_reg acc[3] = { S::Zero(), S::Zero(), S::Zero() };
+      //
+      for ( int i = c; i < cLast; i += W )
+      {
+        const T* p = coords + 3*i;
+        //
+        for ( int r = 0; r < 3; ++r )
+          acc[r] = S::Add( acc[r], S::Load(p + W*r) );
+      }
+
+      T lanes[3*MaxWidth];
+      for ( int r = 0; r < 3; ++r )
+        S::Store(lanes + W*r, acc[r]);
+      //
+      for ( int l = 0; l < 3*W; ++l )
+        sums[l % 3] += lanes[l];
+    }
+
+    for ( int i = simdLast; i < last; ++i )
+      for ( int a = 0; a < 3; ++a )
+        sums[a] += coords[3*i + a];
+  }
+
+  //! Computes the sums of products of centered coordinates of points in the
+  //! range as (xx, yy, zz, xy, yz, zx).
+  //!
+  //! The diagonal terms are the squares of lanes. The off-diagonal ones are
+  //! the products with the registers loaded at the shifts of +1 and -2
+  //! coordinates: the shift of +1 gives xy and yz in the lanes of x and y,
+  //! and the shift of -2 gives zx in the lanes of z. The shifted loads may
+  //! read the neighbor points, so the vectorized part is limited to the
+  //! points in [1, numPts - 1).
+  template <typename T>
+  void CovarianceRange(const T*      coords,
+                       const int     numPts,
+                       const int     first,
+                       const int     last,
+                       const double* centroid,
+                       double*       sums)
+  {
+    typedef t_simd<T>             S;
+    typedef typename S::t_reg     t_reg;
+    const int                     W = S::Width;
+
+    for ( int k = 0; k < 6; ++k )
+      sums[k] = 0.;
+
+    // Centroid patterns for the unshifted and shifted loads.
+    T pattern0[3*MaxWidth], pattern1[3*MaxWidth];
+    for ( int l = 0; l < 3*W; ++l )
+    {
+      pattern0[l] = T( centroid[l % 3] );
+      pattern1[l] = T( centroid[(l + 1) % 3] );
+    }
+    //
+    t_reg P0[3], P1[3];
+    for ( int r = 0; r < 3; ++r )
+    {
+      P0[r] = S::Load(pattern0 + W*r);
+      P1[r] = S::Load(pattern1 + W*r);
+    }
+
+    const int simdFirst = std::min( last, std::max(first, 1) );
+    const int simdLast  = simdFirst + std::max(0, std::min(last, numPts - 1) - simdFirst)/W*W;
+
+    for ( int c = simdFirst; c < simdLast; c += ChunkSize )
+    {
+      const int cLast = std::min(c + ChunkSize, simdLast);
+
+      t_reg d[3], o1[3], o2[3];
+      for ( int r = 0; r < 3; ++r )
+        d[r] = o1[r] = o2[r] = S::Zero();
+      //
+      for ( int i = c; i < cLast; i += W )
+      {
+        const T* p = coords + 3*i;
+        //
+        for ( int r = 0; r < 3; ++r )
+        {
+          const t_reg v  = S::Sub( S::Load(p + W*r),     P0[r] );
+          const t_reg v1 = S::Sub( S::Load(p + W*r + 1), P1[r] );
+          const t_reg v2 = S::Sub( S::Load(p + W*r - 2), P1[r] );
+          //
+          d[r]  = S::Add( d[r],  S::Mul(v, v) );
+          o1[r] = S::Add( o1[r], S::Mul(v, v1) );
+          o2[r] = S::Add( o2[r], S::Mul(v, v2) );
+        }
+      }
+
+      T lanesD[3*MaxWidth], lanesO1[3*MaxWidth], lanesO2[3*MaxWidth];
+      for ( int r = 0; r < 3; ++r )
+      {
+        S::Store(lanesD  + W*r, d[r]);
+        S::Store(lanesO1 + W*r, o1[r]);
+        S::Store(lanesO2 + W*r, o2[r]);
+      }
+      //
+      for ( int l = 0; l < 3*W; ++l )
+      {
+        const int a = l % 3;
+        //
+        sums[a] += lanesD[l];
+        //
+        if ( a == 0 )      sums[3] += lanesO1[l]; // xy
+        else if ( a == 1 ) sums[4] += lanesO1[l]; // yz
+        else               sums[5] += lanesO2[l]; // zx
+      }
+    }
+
+    // Scalar head and tail.
+    for ( int i = first; i < last; ++i )
+    {
+      if ( i == simdFirst && simdLast > simdFirst )
+      {
+        i = simdLast - 1;
+        continue;
+      }
+
+      const double x = coords[3*i]     - centroid[0];
+      const double y = coords[3*i + 1] - centroid[1];
+      const double z = coords[3*i + 2] - centroid[2];
+      //
+      sums[0] += x*x;
+      sums[1] += y*y;
+      sums[2] += z*z;
+      sums[3] += x*y;
+      sums[4] += y*z;
+      sums[5] += z*x;
+    }
+  }
+
+  //! Transforms points in the range.
+  template <typename T>
+  void TransformRange(const T*      coords,
+                      const int     first,
+                      const int     last,
+                      const double* mx,
+                      T*            result)
+  {
+    for ( int i = first; i < last; ++i )
+    {
+      const double x = coords[3*i];
+      const double y = coords[3*i + 1];
+      const double z = coords[3*i + 2];
+      //
+      result[3*i]     = T( mx[0]*x + mx[1]*y + mx[2]*z  + mx[3] );
+      result[3*i + 1] = T( mx[4]*x + mx[5]*y + mx[6]*z  + mx[7] );
+      result[3*i + 2] = T( mx[8]*x + mx[9]*y + mx[10]*z + mx[11] );
+    }
+  }
+
+  //---------------------------------------------------------------------------
+  // Functors processing blocks of points.
+  //---------------------------------------------------------------------------
+
+  //! Base class of functors over blocks of points.
+  template <typename TDerived>
+  class BlockFunctor
+  {
+  public:
+
+    BlockFunctor(const int numPts) : m_iNumPts(numPts) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      for ( int b = firstBlock; b < lastBlock; ++b )
+        static_cast<const TDerived*>(this)->processBlock( b, b*BlockSize, std::min(m_iNumPts, (b + 1)*BlockSize) );
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+    //! Runs the functor over all blocks.
+    void Run(const bool isParallel) const
+    {
+      const int numBlocks = this->NumBlocks();
+
+#ifdef USE_THREADING
+      if ( isParallel && numBlocks > 1 )
+      {
+        tbb::parallel_for(tbb::blocked_range<int>(0, numBlocks, 1), static_cast<const TDerived&>(*this));
+        return;
+      }
+#else
+      (void) isParallel;
+#endif
+      this->Process(0, numBlocks);
+    }
+
+    int NumBlocks() const
+    {
+      return (m_iNumPts + BlockSize - 1)/BlockSize;
+    }
+
+  protected:
+
+    int m_iNumPts; //!< Number of points.
+  };
+
+  //! Computes boxes of blocks.
+  template <typename T>
+  class BoxFunctor : public BlockFunctor< BoxFunctor<T> >
+  {
+  public:
+
+    BoxFunctor(const T* coords, const int numPts, std::vector<T>& boxes)
+    : BlockFunctor< BoxFunctor<T> >(numPts), m_coords(coords), m_boxes(boxes) {}
+
+    void processBlock(const int b, const int first, const int last) const
+    {
+      BoxRange(m_coords, first, last, &m_boxes[6*b]);
+    }
+
+  private:
+
+    const T*        m_coords;
+    std::vector<T>& m_boxes;
+  };
+
+  //! Computes sums of coordinates of blocks.
+  template <typename T>
+  class SumFunctor : public BlockFunctor< SumFunctor<T> >
+  {
+  public:
+
+    SumFunctor(const T* coords, const int numPts, std::vector<double>& sums)
+    : BlockFunctor< SumFunctor<T> >(numPts), m_coords(coords), m_sums(sums) {}
+
+    void processBlock(const int b, const int first, const int last) const
+    {
+      SumRange(m_coords, first, last, &m_sums[3*b]);
+    }
+
+  private:
+
+    const T*             m_coords;
+    std::vector<double>& m_sums;
+  };
+
+  //! Computes sums of products of blocks.
+  template <typename T>
+  class CovarianceFunctor : public BlockFunctor< CovarianceFunctor<T> >
+  {
+  public:
+
+    CovarianceFunctor(const T*             coords,
+                      const int            numPts,
+                      const double*        centroid,
+                      std::vector<double>& sums)
+    : BlockFunctor< CovarianceFunctor<T> >(numPts), m_coords(coords), m_centroid(centroid), m_sums(sums) {}
+
+    void processBlock(const int b, const int first, const int last) const
+    {
+      CovarianceRange(m_coords, this->m_iNumPts, first, last, m_centroid, &m_sums[6*b]);
+    }
+
+  private:
+
+    const T*             m_coords;
+    const double*        m_centroid;
+    std::vector<double>& m_sums;
+  };
+
+  //! Transforms blocks.
+  template <typename T>
+  class TransformFunctor : public BlockFunctor< TransformFunctor<T> >
+  {
+  public:
+
+    TransformFunctor(const T* coords, const int numPts, const double* mx, T* result)
+    : BlockFunctor< TransformFunctor<T> >(numPts), m_coords(coords), m_mx(mx), m_result(result) {}
+
+    void processBlock(const int, const int first, const int last) const
+    {
+      TransformRange(m_coords, first, last, m_mx, m_result);
+    }
+
+  private:
+
+    const T*      m_coords;
+    const double* m_mx;
+    T*            m_result;
+  };
+
+  //! Copies clouds to their places in the merged array.
+  template <typename T>
+  class CopyFunctor
+  {
+  public:
+
+    CopyFunctor(const std::vector<Handle(asiAlgo_BaseCloud<T>)>& clouds,
+                const std::vector<size_t>&                      offsets,
+                const std::vector<size_t>&                      sizes,
+                T*                                              result)
+    : m_clouds(clouds), m_offsets(offsets), m_sizes(sizes), m_result(result) {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int c = first; c < last; ++c )
+      {
+        if ( m_clouds[c].IsNull() )
+          continue;
+
+        // The sizes are taken before resizing the result, which can be
+        // one of the clouds.
+        const std::vector<T>& coords = m_clouds[c]->GetCoords();
+        std::copy( coords.begin(), coords.begin() + m_sizes[c], m_result + m_offsets[c] );
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const std::vector<Handle(asiAlgo_BaseCloud<T>)>& m_clouds;
+    const std::vector<size_t>&                      m_offsets;
+    const std::vector<size_t>&                      m_sizes;
+    T*                                              m_result;
+  };
+
+  //---------------------------------------------------------------------------
+  // Generic implementations.
+  //---------------------------------------------------------------------------
+
+
+  template <typename T>
+  void ComputeBoundingBoxImpl(const T*   coords,
+                              const int  numPts,
+                              T          bounds[6],
+                              const bool isParallel)
+  {
+    // Keep the box void (min above max) if there are no points.
+    if ( numPts <= 0 )
+    {
+      for ( int a = 0; a < 3; ++a )
+      {
+        bounds[2*a]     =  std::numeric_limits<T>::max();
+        bounds[2*a + 1] = -std::numeric_limits<T>::max();
+      }
+      return;
+    }
+
+    std::vector<T> boxes;
+    BoxFunctor<T>  func(coords, numPts, boxes);
+    //
+    boxes.resize(6*func.NumBlocks());
+    func.Run(isParallel);
+
+    for ( int k = 0; k < 6; ++k )
+      bounds[k] = boxes[k];
+    //
+    for ( size_t b = 1; b < boxes.size()/6; ++b )
+    {
+      for ( int a = 0; a < 3; ++a )
+      {
+        bounds[2*a]     = std::min(bounds[2*a],     boxes[6*b + 2*a]);
+        bounds[2*a + 1] = std::max(bounds[2*a + 1], boxes[6*b + 2*a + 1]);
+      }
+    }
+  }
+
+  template <typename T>
+  void ComputeCovarianceImpl(const T*   coords,
+                             const int  numPts,
+                             double     centroid[3],
+                             double     covariance[9],
+                             const bool isParallel)
+  {
+    for ( int k = 0; k < 3; ++k )
+      centroid[k] = 0.;
+    //
+    for ( int k = 0; k < 9; ++k )
+      covariance[k] = 0.;
+
+    if ( numPts <= 0 )
+      return;
+
+    /* ===============
+     *  Compute centroid.
+     * =============== */
+
+    std::vector<double> sums;
+    SumFunctor<T>       sumFunc(coords, numPts, sums);
+    //
+    sums.resize(3*sumFunc.NumBlocks(), 0.);
+    sumFunc.Run(isParallel);
+
+    for ( size_t b = 0; b < sums.size()/3; ++b )
+      for ( int a = 0; a < 3; ++a )
+        centroid[a] += sums[3*b + a];
+    //
+    for ( int a = 0; a < 3; ++a )
+      centroid[a] /= numPts;
+
+    /* ===========================
+     *  Compute centered products.
+     * =========================== */
+
+    std::vector<double>  prods;
+    CovarianceFunctor<T> covFunc(coords, numPts, centroid, prods);
+    //
+    prods.resize(6*covFunc.NumBlocks(), 0.);
+    covFunc.Run(isParallel);
+
+    double c[6] = {0., 0., 0., 0., 0., 0.};
+    //
+    for ( size_t b = 0; b < prods.size()/6; ++b )
+      for ( int k = 0; k < 6; ++k )
+        c[k] += prods[6*b + k];
+    //
+    for ( int k = 0; k < 6; ++k )
+      c[k] /= numPts;
+
+    covariance[0] = c[0]; covariance[1] = c[3]; covariance[2] = c[5];
+    covariance[3] = c[3]; covariance[4] = c[1]; covariance[5] = c[4];
+    covariance[6] = c[5]; covariance[7] = c[4]; covariance[8] = c[2];
+  }
+
+  template <typename T>
+  void MergeImpl(const std::vector<Handle(asiAlgo_BaseCloud<T>)>& clouds,
+                 asiAlgo_BaseCloud<T>&                            result,
+                 const bool                                       isParallel)
+  {
+    std::vector<T>& coords = result.ChangeCoords();
+
+    // Compute the offsets of clouds in the merged array.
+    std::vector<size_t> offsets( clouds.size() ), sizes( clouds.size(), 0 );
+    size_t              total = coords.size();
+    //
+    for ( size_t c = 0; c < clouds.size(); ++c )
+    {
+      offsets[c] = total;
+      //
+      if ( !clouds[c].IsNull() )
+        sizes[c] = clouds[c]->GetCoords().size();
+      //
+      total += sizes[c];
+    }
+
+    coords.resize(total);
+    //
+    if ( total == 0 )
+      return;
+
+    CopyFunctor<T> func(clouds, offsets, sizes, &coords[0]);
+
+#ifdef USE_THREADING
+    if ( isParallel )
+    {
+      tbb::parallel_for(tbb::blocked_range<int>(0, int( clouds.size() ), 1), func);
+      return;
+    }
+#else
+    (void) isParallel;
+#endif
+
+    func.Process( 0, int( clouds.size() ) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_CloudKernels::ComputeBoundingBox(const float* coords,
+                                              const int    numPts,
+                                              float        bounds[6],
+                                              const bool   isParallel)
+{
+  ComputeBoundingBoxImpl(coords, numPts, bounds, isParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_CloudKernels::ComputeBoundingBox(const double* coords,
+                                              const int     numPts,
+                                              double        bounds[6],
+                                              const bool    isParallel)
+{
+  ComputeBoundingBoxImpl(coords, numPts, bounds, isParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_CloudKernels::ComputeCovariance(const float* coords,
+                                             const int    numPts,
+                                             double       centroid[3],
+                                             double       covariance[9],
+                                             const bool   isParallel)
+{
+  ComputeCovarianceImpl(coords, numPts, centroid, covariance, isParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_CloudKernels::ComputeCovariance(const double* coords,
+                                             const int     numPts,
+                                             double        centroid[3],
+                                             double        covariance[9],
+                                             const bool    isParallel)
+{
+  ComputeCovarianceImpl(coords, numPts, centroid, covariance, isParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_CloudKernels::Transform(const float*  coords,
+                                     const int     numPts,
+                                     const double  mx[12],
+                                     float*        result,
+                                     const bool    isParallel)
+{
+  if ( numPts > 0 )
+    TransformFunctor<float>(coords, numPts, mx, result).Run(isParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_CloudKernels::Transform(const double* coords,
+                                     const int     numPts,
+                                     const double  mx[12],
+                                     double*       result,
+                                     const bool    isParallel)
+{
+  if ( numPts > 0 )
+    TransformFunctor<double>(coords, numPts, mx, result).Run(isParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_CloudKernels::Merge(const std::vector<Handle(asiAlgo_BaseCloud<float>)>& clouds,
+                                 asiAlgo_BaseCloud<float>&                            result,
+                                 const bool                                           isParallel)
+{
+  MergeImpl(clouds, result, isParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_CloudKernels::Merge(const std::vector<Handle(asiAlgo_BaseCloud<double>)>& clouds,
+                                 asiAlgo_BaseCloud<double>&                            result,
+                                 const bool                                            isParallel)
+{
+  MergeImpl(clouds, result, isParallel);
+}
+
+//-----------------------------------------------------------------------------
+
+const char* asiAlgo_CloudKernels::GetInstructionSet()
+{
+#if defined asiAlgo_CloudKernels_AVX
+  return "AVX";
+#elif defined asiAlgo_CloudKernels_SSE2
+  return "SSE2";
+#else
+  return "scalar";
+#endif
+}
@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_CloudKernels_h
+#define asiAlgo_CloudKernels_h
+
+// asiAlgo includes
+#include <asiAlgo_BaseCloud.h>
+
+//-----------------------------------------------------------------------------
+
+//! Bulk kernels for flattened point coordinates (x1, y1, z1, x2, ...). The
+//! bounding box and covariance kernels are vectorized with SSE2 or AVX
+//! depending on the target instruction set (the scalar code is used
+//! otherwise), and all kernels run in parallel over blocks of points. The
+//! blocks are reduced in a fixed order, so the results do not depend on
+//! the number of threads.
+namespace asiAlgo_CloudKernels
+{
+  //! Computes the bounding box of points. The box is void (each min is
+  //! above the corresponding max) if there are no points.
+  //! \param[in]  coords     flattened coordinates.
+  //! \param[in]  numPts     number of points.
+  //! \param[out] bounds     box as (xMin, xMax, yMin, yMax, zMin, zMax).
+  //! \param[in]  isParallel whether to run in parallel.
+  asiAlgo_EXPORT void
+    ComputeBoundingBox(const float* coords,
+                       const int    numPts,
+                       float        bounds[6],
+                       const bool   isParallel = true);
+
+  //! \copydoc ComputeBoundingBox()
+  asiAlgo_EXPORT void
+    ComputeBoundingBox(const double* coords,
+                       const int     numPts,
+                       double        bounds[6],
+                       const bool    isParallel = true);
+
+  //! Computes the centroid and the covariance matrix of points. The sums
+  //! are accumulated in double precision for both types of coordinates.
+  //! \param[in]  coords     flattened coordinates.
+  //! \param[in]  numPts     number of points.
+  //! \param[out] centroid   centroid.
+  //! \param[out] covariance row-major 3x3 covariance matrix divided by the
+  //!                        number of points.
+  //! \param[in]  isParallel whether to run in parallel.
+  asiAlgo_EXPORT void
+    ComputeCovariance(const float* coords,
+                      const int    numPts,
+                      double       centroid[3],
+                      double       covariance[9],
+                      const bool   isParallel = true);
+
+  //! \copydoc ComputeCovariance()
+  asiAlgo_EXPORT void
+    ComputeCovariance(const double* coords,
+                      const int     numPts,
+                      double        centroid[3],
+                      double        covariance[9],
+                      const bool    isParallel = true);
+
+  //! Transforms points with the affine map given by the row-major 3x4
+  //! matrix (rotation and translation in the last column). The result can
+  //! be the same array as the input.
+  //! \param[in]  coords     flattened coordinates.
+  //! \param[in]  numPts     number of points.
+  //! \param[in]  mx         3x4 transformation matrix.
+  //! \param[out] result     transformed coordinates.
+  //! \param[in]  isParallel whether to run in parallel.
+  asiAlgo_EXPORT void
+    Transform(const float*  coords,
+              const int     numPts,
+              const double  mx[12],
+              float*        result,
+              const bool    isParallel = true);
+
+  //! \copydoc Transform()
+  asiAlgo_EXPORT void
+    Transform(const double* coords,
+              const int     numPts,
+              const double  mx[12],
+              double*       result,
+              const bool    isParallel = true);
+
+  //! Appends the points of several clouds to the result with a single
+  //! allocation. The result can be one of the clouds.
+  //! \param[in]     clouds     clouds to append.
+  //! \param[in,out] result     cloud to append to.
+  //! \param[in]     isParallel whether to run in parallel.
+  asiAlgo_EXPORT void
+    Merge(const std::vector<Handle(asiAlgo_BaseCloud<float>)>& clouds,
+          asiAlgo_BaseCloud<float>&                            result,
+          const bool                                           isParallel = true);
+
+  //! \copydoc Merge()
+  asiAlgo_EXPORT void
+    Merge(const std::vector<Handle(asiAlgo_BaseCloud<double>)>& clouds,
+          asiAlgo_BaseCloud<double>&                            result,
+          const bool                                            isParallel = true);
+
+  //! \return name of the instruction set the kernels are compiled for
+  //!         ("AVX", "SSE2" or "scalar").
+  asiAlgo_EXPORT const char*
+    GetInstructionSet();
+}
+
+#endif
@@ -42,6 +42,139 @@
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 
+// Standard includes
+#include <fstream>
+#include <string>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of faces sampled in one go. The samples of these faces are
+  //! kept in memory until they are flushed to the result.
+  const int ChunkSize = 256;
+
+  //! Samples a chunk of faces into per-face buffers.
+  class SampleFunctor
+  {
+  public:
+
+    SampleFunctor(const asiAlgo_Cloudify*             pAlgo,
+                  const std::vector<TopoDS_Face>&     faces,
+                  const int                           first,
+                  const bool                          onFacets,
+                  std::vector< std::vector<double> >& buffers,
+                  std::vector<char>&                  failures)
+    : m_pAlgo(pAlgo), m_faces(faces), m_iFirst(first), m_bOnFacets(onFacets),
+      m_buffers(buffers), m_failures(failures) {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int i = first; i < last; ++i )
+      {
+        const TopoDS_Face& face = m_faces[m_iFirst + i];
+        //
+        m_buffers[i].clear();
+        m_failures[i] = 0;
+
+        try
+        {
+          if ( m_bOnFacets )
+            m_pAlgo->SampleFacets(face, m_buffers[i]);
+          else
+            m_pAlgo->SampleFace(face, m_buffers[i]);
+        }
+        catch ( ... )
+        {
+          m_buffers[i].clear();
+          m_failures[i] = 1;
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const asiAlgo_Cloudify*             m_pAlgo;
+    const std::vector<TopoDS_Face>&     m_faces;
+    int                                 m_iFirst;
+    bool                                m_bOnFacets;
+    std::vector< std::vector<double> >& m_buffers;
+    std::vector<char>&                  m_failures;
+  };
+
+  //! Writes points to a binary PLY file. The number of vertices is not
+  //! known in advance, so it is reserved as a fixed-width field in the
+  //! header and patched once all points are written.
+  class PlyStream
+  {
+  public:
+
+    bool Open(const char* filename)
+    {
+      m_file.open(filename, std::ios::out | std::ios::binary);
+      if ( !m_file.is_open() )
+        return false;
+
+      m_file << "ply\n"
+             << "format binary_little_endian 1.0\n"
+             << "comment Generated by Analysis Situs\n"
+             << "element vertex ";
+      //
+      m_countPos = m_file.tellp();
+      this->writeCount(0);
+      //
+      m_file << "\n"
+             << "property double x\n"
+             << "property double y\n"
+             << "property double z\n"
+             << "end_header\n";
+
+      return m_file.good();
+    }
+
+    void Write(const std::vector<double>& coords)
+    {
+      if ( !coords.empty() )
+        m_file.write( reinterpret_cast<const char*>(&coords[0]), coords.size()*sizeof(double) );
+    }
+
+    bool Close(const long long numPts)
+    {
+      m_file.seekp(m_countPos);
+      this->writeCount(numPts);
+      m_file.close();
+      return !m_file.fail();
+    }
+
+  private:
+
+    void writeCount(const long long numPts)
+    {
+      char buff[32];
+      Sprintf(buff, "%012lld", numPts);
+      m_file << buff;
+    }
+
+  private:
+
+    std::ofstream  m_file;
+    std::streampos m_countPos;
+  };
+}
+
 //-----------------------------------------------------------------------------
 
 //! Constructor.
@@ -55,7 +188,9 @@ asiAlgo_Cloudify::asiAlgo_Cloudify(const double         uv_step,
   m_fLinStep            (uv_step),
   m_bUseExternalUVSteps (false),
   m_fUStep              (0.0),
-  m_fVStep              (0.0)
+  m_fVStep              (0.0),
+  m_bIsParallel         (true),
+  m_iNumSamples         (0)
 {}
 
 //-----------------------------------------------------------------------------
@@ -67,180 +202,278 @@ asiAlgo_Cloudify::asiAlgo_Cloudify(const double         uv_step,
 bool asiAlgo_Cloudify::Sample_Faces(const TopoDS_Shape&                model,
                                     Handle(asiAlgo_BaseCloud<double>)& point_cloud)
 {
-  point_cloud = new asiAlgo_BaseCloud<double>;
+  return this->sample(model, false, point_cloud);
+}
 
-  { // Progress [begin]
-    TopTools_IndexedMapOfShape M;
-    TopExp::MapShapes(model, TopAbs_FACE, M);
-    //
-    this->GetProgress().Init( M.Extent() );
-  } // Progress [end]
+//-----------------------------------------------------------------------------
 
-  // Iterate over the faces, and sample points in their domains
-  for ( TopExp_Explorer exp(model, TopAbs_FACE); exp.More(); exp.Next() )
+//! Builds a representative point cloud for the facets of the given model.
+//! \param model       [in]  target CAD model to take facets from.
+//! \param point_cloud [out] result point cloud.
+//! \return true in case of success, false -- otherwise.
+bool asiAlgo_Cloudify::Sample_Facets(const TopoDS_Shape&                model,
+                                     Handle(asiAlgo_BaseCloud<double>)& point_cloud)
+{
+  return this->sample(model, true, point_cloud);
+}
+
+//-----------------------------------------------------------------------------
+
+//! Samples points in the domain of the given face. This method does not
+//! modify any shared state, so different faces can be sampled concurrently.
+//! \param face   [in]     face to sample.
+//! \param coords [in/out] coordinates to append the samples to.
+void asiAlgo_Cloudify::SampleFace(const TopoDS_Face&   face,
+                                  std::vector<double>& coords) const
+{
+  // Surface adaptor
+  BRepAdaptor_Surface bas(face);
+
+  // Get parametric bounds
+  double uMin, uMax, vMin, vMax;
+  BRepTools::UVBounds(face, uMin, uMax, vMin, vMax);
+
+  // Choose an adequate sampling step in parametric space for the
+  // current face. A user is not aware of any parametric spaces as a rule,
+  // so we'd better treat his sampling argument as a linear metric
+  // property in three dimensions. Obviously, some distortion
+  // coefficient has to be applied to stick to this metric constraint
+  // in 3D when we are sampling 2D
+
+  // We do not want to use curvature since parameterization of a host
+  // surface may happen to be irregular. So we are using D0-wise
+  // heuristic, like we pick up two points, take the one in-between,
+  // and pass a circle using three point. The radius of that circle
+  // we take as a curvature radius. Having this radius R, it is easy
+  // to derive an angle giving us a certain arc length:
+  // L = alpha * R => alpha = L / R
+
+  double uStep, vStep;
+  //
+  if ( m_bUseExternalUVSteps )
   {
-    const TopoDS_Face& face = TopoDS::Face( exp.Current() );
-
-    // Surface adaptor
-    BRepAdaptor_Surface bas(face);
-
-    // Get parametric bounds
-    double uMin, uMax, vMin, vMax;
-    BRepTools::UVBounds(face, uMin, uMax, vMin, vMax);
-
-    // Choose an adequate sampling step in parametric space for the
-    // current face. A user is not aware of any parametric spaces as a rule,
-    // so we'd better treat his sampling argument as a linear metric
-    // property in three dimensions. Obviously, some distortion
-    // coefficient has to be applied to stick to this metric constraint
-    // in 3D when we are sampling 2D
-
-    // We do not want to use curvature since parameterization of a host
-    // surface may happen to be irregular. So we are using D0-wise
-    // heuristic, like we pick up two points, take the one in-between,
-    // and pass a circle using three point. The radius of that circle
-    // we take as a curvature radius. Having this radius R, it is easy
-    // to derive an angle giving us a certain arc length:
-    // L = alpha * R => alpha = L / R
-
-    double uStep, vStep;
-    //
-    if ( m_bUseExternalUVSteps )
+    uStep = m_fUStep;
+    vStep = m_fVStep;
+  }
+  else
+  {
+    uStep = this->chooseParametricStep(bas, true, uMin, uMax, vMin, vMax);
+    vStep = this->chooseParametricStep(bas, false, uMin, uMax, vMin, vMax);
+  }
+
+  // Prepare classifier (each face gets its own one, so the classifiers
+  // are never shared between threads)
+  asiAlgo_ClassifyPointFace classifier(face, BRep_Tool::Tolerance(face), 0.01);
+
+  // Sample points
+  double u = uMin;
+  bool uStop = false;
+  while ( !uStop )
+  {
+    if ( u > uMax )
     {
-      uStep = m_fUStep;
-      vStep = m_fVStep;
+      u     = uMax;
+      uStop = true;
     }
-    else
+
+    double v = vMin;
+    bool vStop = false;
+    while ( !vStop )
     {
-      uStep = this->chooseParametricStep(bas, true, uMin, uMax, vMin, vMax);
-      vStep = this->chooseParametricStep(bas, false, uMin, uMax, vMin, vMax);
+      if ( v > vMax )
+      {
+        v     = vMax;
+        vStop = true;
+      }
+
+      // Perform point membership classification
+      asiAlgo_Membership pmc = classifier( gp_Pnt2d(u, v) );
+      //
+      if ( pmc & Membership_InOn )
+      {
+        gp_Pnt P = bas.Value(u, v);
+        //
+        coords.push_back( P.X() );
+        coords.push_back( P.Y() );
+        coords.push_back( P.Z() );
+      }
+
+      v += vStep;
     }
 
-    // Prepare classifier
-    asiAlgo_ClassifyPointFace classifier(face, BRep_Tool::Tolerance(face), 0.01);
+    u += uStep;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+//! Samples points on the facets of the given face.
+//! \param face   [in]     face to take facets from.
+//! \param coords [in/out] coordinates to append the samples to.
+void asiAlgo_Cloudify::SampleFacets(const TopoDS_Face&   face,
+                                    std::vector<double>& coords) const
+{
+  // Constants
+  const double lower = 0.0, upper = 1.0;
+
+  // Ask for the facets belonging to the given face
+  TopLoc_Location L;
+  const Handle(Poly_Triangulation)& T = BRep_Tool::Triangulation(face, L);
+  //
+  if ( T.IsNull() )
+    return;
+
+  // Take data arrays
+  const TColgp_Array1OfPnt&   nodes = T->Nodes();
+  const Poly_Array1OfTriangle& tris = T->Triangles();
 
-    // Sample points
-    double u = uMin;
-    bool uStop = false;
-    while ( !uStop )
+  // Loop over the array of triangles, so that we can work with each
+  // individual facet independently
+  for ( int t = 1; t <= tris.Length(); ++t )
+  {
+    const Poly_Triangle& tri = tris(t);
+
+    // Take triangle's nodes
+    int n[3];
+    tri.Get(n[0], n[1], n[2]);
+
+    // Check out the nodes
+    gp_XYZ r[3] = { nodes(n[0]).XYZ(), nodes(n[1]).XYZ(), nodes(n[2]).XYZ() };
+
+    // There are two parameters for sampling. One runs from r[1] to r[2],
+    // while the second runs from r[0] to the intermediate point between
+    // r[1] and r[2] (defined by the first parameter). The first parameter
+    // is alpha, the second is beta
+    double alpha   = lower;
+    bool alphaStop = false;
+    //
+    while ( !alphaStop )
     {
-      if ( u > uMax )
+      if ( alpha > upper )
       {
-        u     = uMax;
-        uStop = true;
+        alpha     = upper;
+        alphaStop = true;
       }
 
-      double v = vMin;
-      bool vStop = false;
-      while ( !vStop )
+      double beta   = lower;
+      bool betaStop = false;
+      //
+      while ( !betaStop )
       {
-        if ( v > vMax )
+        if ( beta > upper )
         {
-          v     = vMax;
-          vStop = true;
+          beta     = upper;
+          betaStop = true;
         }
 
-        // Perform point membership classification
-        asiAlgo_Membership pmc = classifier( gp_Pnt2d(u, v) );
+        gp_XYZ P = r[0] + beta*(r[1] + alpha*(r[2] - r[1]) - r[0]);
         //
-        if ( pmc & Membership_InOn )
-        {
-          gp_Pnt P = bas.Value(u, v);
-          point_cloud->AddElement( P.X(), P.Y(), P.Z() );
-        }
+        coords.push_back( P.X() );
+        coords.push_back( P.Y() );
+        coords.push_back( P.Z() );
 
-        v += vStep;
+        beta += m_fLinStep;
       }
 
-      u += uStep;
+      alpha += m_fLinStep;
     }
-
-    // Progress
-    this->GetProgress().StepProgress(1);
   }
-
-  return true;
 }
 
 //-----------------------------------------------------------------------------
 
-//! Builds a representative point cloud for the facets of the given model.
-//! \param model       [in]  target CAD model to take facets from.
+//! Samples the faces (or their facets) chunk by chunk. The faces of each
+//! chunk are sampled concurrently, and their samples are flushed to the
+//! result (or to the output file) in the order of faces.
+//! \param model       [in]  target CAD model.
+//! \param onFacets    [in]  whether to sample facets instead of surfaces.
 //! \param point_cloud [out] result point cloud.
 //! \return true in case of success, false -- otherwise.
-bool asiAlgo_Cloudify::Sample_Facets(const TopoDS_Shape&                model,
-                                     Handle(asiAlgo_BaseCloud<double>)& point_cloud)
+bool asiAlgo_Cloudify::sample(const TopoDS_Shape&                model,
+                              const bool                         onFacets,
+                              Handle(asiAlgo_BaseCloud<double>)& point_cloud)
 {
-  point_cloud = new asiAlgo_BaseCloud<double>;
-
-  // Constants
-  const double lower = 0.0, upper = 1.0;
+  point_cloud   = new asiAlgo_BaseCloud<double>;
+  m_iNumSamples = 0;
 
-  // Loop over the facets
+  // Collect faces in the order of exploration.
+  std::vector<TopoDS_Face> faces;
+  //
   for ( TopExp_Explorer exp(model, TopAbs_FACE); exp.More(); exp.Next() )
-  {
-    const TopoDS_Face& F = TopoDS::Face( exp.Current() );
-
-    // Ask for the facets belonging to the given face
-    TopLoc_Location L;
-    const Handle(Poly_Triangulation)& T = BRep_Tool::Triangulation(F, L);
-    //
-    if ( T.IsNull() )
-      continue;
+    faces.push_back( TopoDS::Face( exp.Current() ) );
+  //
+  const int numFaces = int( faces.size() );
 
-    // Take data arrays
-    const TColgp_Array1OfPnt&   nodes = T->Nodes();
-    const Poly_Array1OfTriangle& tris = T->Triangles();
+  // Prepare output file.
+  const bool isStreaming = !m_outputFilename.IsEmpty();
+  PlyStream  stream;
+  //
+  if ( isStreaming && !stream.Open( m_outputFilename.ToCString() ) )
+  {
+    m_progress.SendLogMessage( LogErr(Normal) << "Cannot open file '%1' for writing."
+                                              << m_outputFilename.ToCString() );
+    return false;
+  }
 
-    // Loop over the array of triangles, so that we can work with each
-    // individual facet independently
-    for ( int t = 1; t <= tris.Length(); ++t )
-    {
-      const Poly_Triangle& tri = tris(t);
+  m_progress.Init(numFaces);
 
-      // Take triangle's nodes
-      int n[3];
-      tri.Get(n[0], n[1], n[2]);
+  std::vector< std::vector<double> > buffers( std::min(numFaces, ChunkSize) );
+  std::vector<char>                  failures( buffers.size() );
+  long long                          numPts = 0;
+  //
+  for ( int first = 0; first < numFaces; first += ChunkSize )
+  {
+    const int num = std::min(ChunkSize, numFaces - first);
 
-      // Check out the nodes
-      gp_XYZ r[3] = { nodes(n[0]).XYZ(), nodes(n[1]).XYZ(), nodes(n[2]).XYZ() };
+    SampleFunctor func(this, faces, first, onFacets, buffers, failures);
+    //
+#ifdef USE_THREADING
+    if ( m_bIsParallel )
+      tbb::parallel_for(tbb::blocked_range<int>(0, num, 1), func);
+    else
+#endif
+      func.Process(0, num);
 
-      // There are two parameters for sampling. One runs from r[1] to r[2],
-      // while the second runs from r[0] to the intermediate point between
-      // r[1] and r[2] (defined by the first parameter). The first parameter
-      // is alpha, the second is beta
-      double alpha   = lower;
-      bool alphaStop = false;
-      //
-      while ( !alphaStop )
-      {
-        if ( alpha > upper )
-        {
-          alpha     = upper;
-          alphaStop = true;
-        }
+    // Flush samples in the order of faces.
+    size_t chunkSize = 0;
+    for ( int i = 0; i < num; ++i )
+    {
+      if ( failures[i] )
+        m_progress.SendLogMessage( LogWarn(Normal) << "Cannot sample face %1." << (first + i + 1) );
 
-        double beta   = lower;
-        bool betaStop = false;
-        //
-        while ( !betaStop )
-        {
-          if ( beta > upper )
-          {
-            beta     = upper;
-            betaStop = true;
-          }
+      chunkSize += buffers[i].size();
+    }
+    //
+    for ( int i = 0; i < num; ++i )
+    {
+      if ( isStreaming )
+        stream.Write(buffers[i]);
+      else
+        point_cloud->ChangeCoords().insert( point_cloud->ChangeCoords().end(),
+                                            buffers[i].begin(), buffers[i].end() );
+    }
+    //
+    numPts += chunkSize/3;
 
-          gp_XYZ P = r[0] + beta*(r[1] + alpha*(r[2] - r[1]) - r[0]);
-          //
-          point_cloud->AddElement( P.X(), P.Y(), P.Z() );
+    m_progress.StepProgress(num);
+    //
+    if ( m_progress.IsCancelling() )
+      return false;
+  }
 
-          beta += m_fLinStep;
-        }
+  m_iNumSamples = int64_t(numPts);
 
-        alpha += m_fLinStep;
-      }
+  if ( isStreaming )
+  {
+    if ( !stream.Close(numPts) )
+    {
+      m_progress.SendLogMessage( LogErr(Normal) << "Cannot write file '%1'." << m_outputFilename.ToCString() );
+      return false;
     }
+
+    m_progress.SendLogMessage( LogInfo(Normal) << "%1 point(s) written to '%2'."
+                                               << std::to_string(m_iNumSamples)
+                                               << m_outputFilename.ToCString() );
   }
 
   return true;
@@ -39,11 +39,22 @@
 
 // OCCT includes
 #include <BRepAdaptor_Surface.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 
+// STL includes
+#include <cstdint>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 
 //! Utility to build a point cloud by sampling a CAD model.
+//!
+//! The faces are sampled concurrently into per-face buffers which are then
+//! concatenated in the order of faces, so the result does not depend on
+//! the number of threads. Optionally, the samples can be streamed to a
+//! binary PLY file instead of being accumulated in memory.
 class asiAlgo_Cloudify : public ActAPI_IAlgorithm
 {
 public:
@@ -63,6 +74,16 @@ public:
     Sample_Facets(const TopoDS_Shape&                model,
                   Handle(asiAlgo_BaseCloud<double>)& point_cloud);
 
+public:
+
+  asiAlgo_EXPORT void
+    SampleFace(const TopoDS_Face&   face,
+               std::vector<double>& coords) const;
+
+  asiAlgo_EXPORT void
+    SampleFacets(const TopoDS_Face&   face,
+                 std::vector<double>& coords) const;
+
 public:
 
   //! Sets parametric steps to use.
@@ -75,8 +96,46 @@ public:
     m_fVStep              = vstep;
   }
 
+  //! Enables/disables parallel mode.
+  //! \param[in] on the Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+  //! \return true if parallel mode is enabled.
+  bool IsParallelMode() const
+  {
+    return m_bIsParallel;
+  }
+
+  //! Sets the name of a binary PLY file to stream the samples to. If the
+  //! filename is not empty, the resulting point cloud is left empty, and
+  //! only a bounded number of faces is kept in memory at a time.
+  //! \param[in] filename the filename to set.
+  void SetOutputFilename(const TCollection_AsciiString& filename)
+  {
+    m_outputFilename = filename;
+  }
+
+  //! \return filename to stream the samples to.
+  const TCollection_AsciiString& GetOutputFilename() const
+  {
+    return m_outputFilename;
+  }
+
+  //! \return number of samples produced by the last run.
+  int64_t GetNumberOfSamples() const
+  {
+    return m_iNumSamples;
+  }
+
 protected:
 
+  bool sample(const TopoDS_Shape&                model,
+              const bool                         onFacets,
+              Handle(asiAlgo_BaseCloud<double>)& point_cloud);
+
   double chooseParametricStep(const BRepAdaptor_Surface& bas,
                               const bool                 isU,
                               const double               uMin,
@@ -86,11 +145,16 @@ protected:
 
 protected:
 
-  double m_fPrecision;          //!< Precision of internal classification.
-  double m_fLinStep;            //!< Linear step for point sampling.
-  bool   m_bUseExternalUVSteps; //!< Whether to use externally defined U, V steps.
-  double m_fUStep;              //!< Step in U direction.
-  double m_fVStep;              //!< Step in V direction.
+  double  m_fPrecision;          //!< Precision of internal classification.
+  double  m_fLinStep;            //!< Linear step for point sampling.
+  bool    m_bUseExternalUVSteps; //!< Whether to use externally defined U, V steps.
+  double  m_fUStep;              //!< Step in U direction.
+  double  m_fVStep;              //!< Step in V direction.
+  bool    m_bIsParallel;         //!< Whether to run in parallel mode.
+  int64_t m_iNumSamples;         //!< Number of produced samples.
+
+  //! Binary PLY file to stream the samples to.
+  TCollection_AsciiString m_outputFilename;
 
 };
 
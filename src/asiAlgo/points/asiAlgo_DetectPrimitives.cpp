@@ -0,0 +1,1319 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_DetectPrimitives.h>
+
+// asiAlgo includes
+#include <asiAlgo_Timer.h>
+
+// OCCT includes
+#include <ElSLib.hxx>
+#include <Geom_ConicalSurface.hxx>
+#include <Geom_CylindricalSurface.hxx>
+#include <Geom_Plane.hxx>
+#include <Geom_SphericalSurface.hxx>
+
+// Eigen includes
+#include <Eigen/Dense>
+
+// Standard includes
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of points processed by a single task.
+  const int BlockSize = 4096;
+
+  //! Max number of points to score the candidates against.
+  const int SubsetSize = 16384;
+
+  //! Sizes of neighborhoods for local sampling. Small neighborhoods are
+  //! good for small primitives, while the large ones help to get the
+  //! minimal sets spread over big primitives.
+  const int NeighborhoodSizes[] = {32, 256, 2048};
+
+  //! Max number of refitting passes for a primitive.
+  const int MaxRefits = 5;
+
+  //! Min and max semi-angles of cones (smaller angles are cylinders, and
+  //! bigger ones are planes).
+  const double MinConeAngle = 2.*M_PI/180.;
+  const double MaxConeAngle = 88.*M_PI/180.;
+
+  //---------------------------------------------------------------------------
+
+  inline double Dot(const double* a, const double* b)
+  {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+  }
+
+  inline void Cross(const double* a, const double* b, double* c)
+  {
+    c[0] = a[1]*b[2] - a[2]*b[1];
+    c[1] = a[2]*b[0] - a[0]*b[2];
+    c[2] = a[0]*b[1] - a[1]*b[0];
+  }
+
+  inline double Normalize(double* a)
+  {
+    const double len = std::sqrt( Dot(a, a) );
+    if ( len > 0. )
+    {
+      a[0] /= len;
+      a[1] /= len;
+      a[2] /= len;
+    }
+    return len;
+  }
+
+  //! Finds the closest points of two lines `p1 + t*a` and `p2 + s*b`.
+  //! \return false if the lines are parallel.
+  bool ClosestPoints(const double* p1, const double* a,
+                     const double* p2, const double* b,
+                     double*       q1, double*       q2)
+  {
+    const double w0[3] = {p1[0] - p2[0], p1[1] - p2[1], p1[2] - p2[2]};
+    const double A = Dot(a, a), B = Dot(a, b), C = Dot(b, b);
+    const double D = Dot(a, w0), E = Dot(b, w0);
+    const double denom = A*C - B*B;
+    //
+    if ( denom < 1e-12*A*C )
+      return false;
+
+    const double t = (B*E - C*D)/denom;
+    const double s = (A*E - B*D)/denom;
+    //
+    for ( int k = 0; k < 3; ++k )
+    {
+      q1[k] = p1[k] + t*a[k];
+      q2[k] = p2[k] + s*b[k];
+    }
+    return true;
+  }
+
+  //---------------------------------------------------------------------------
+
+  //! Candidate shape.
+  struct t_shape
+  {
+    asiAlgo_PrimitiveType Type;  //!< Type of shape.
+    double                P[3];  //!< Plane origin, axis point, center or apex.
+    double                D[3];  //!< Plane normal or axis direction.
+    double                R;     //!< Radius of sphere or cylinder.
+    double                Angle; //!< Semi-angle of cone.
+    int                   Score; //!< Number of inliers in the scored subset.
+
+    t_shape() : Type(Primitive_Plane), R(0.), Angle(0.), Score(-1)
+    {
+      P[0] = P[1] = P[2] = D[0] = D[1] = 0.;
+      D[2] = 1.;
+    }
+
+    //! Computes the distance from the point to the shape and the cosine of
+    //! the angle between the passed normal and the normal of the shape.
+    void Eval(const double* p, const double* n, double& dist, double& cosAng) const
+    {
+      const double v[3] = {p[0] - P[0], p[1] - P[1], p[2] - P[2]};
+
+      if ( Type == Primitive_Plane )
+      {
+        dist   = std::fabs( Dot(v, D) );
+        cosAng = std::fabs( Dot(n, D) );
+        return;
+      }
+
+      if ( Type == Primitive_Sphere )
+      {
+        const double r = std::sqrt( Dot(v, v) );
+        dist   = std::fabs(r - R);
+        cosAng = (r > 0.) ? std::fabs( Dot(n, v) )/r : 0.;
+        return;
+      }
+
+      const double h    = Dot(v, D);
+      const double w[3] = {v[0] - h*D[0], v[1] - h*D[1], v[2] - h*D[2]};
+      const double r    = std::sqrt( Dot(w, w) );
+
+      if ( Type == Primitive_Cylinder )
+      {
+        dist   = std::fabs(r - R);
+        cosAng = (r > 0.) ? std::fabs( Dot(n, w) )/r : 0.;
+        return;
+      }
+
+      // Cone.
+      const double c = std::cos(Angle), s = std::sin(Angle);
+      //
+      dist   = (h > 0.) ? std::fabs(r*c - h*s) : DBL_MAX;
+      cosAng = (r > 0.) ? std::fabs( c*Dot(n, w)/r - s*Dot(n, D) ) : 0.;
+    }
+  };
+
+  //! Shape in single precision for scoring the points shifted to the origin.
+  struct t_shapef
+  {
+    int   Type;
+    float P[3], D[3], R, Sin, Cos;
+
+    t_shapef(const t_shape& s, const double* origin)
+    {
+      Type = s.Type;
+      for ( int k = 0; k < 3; ++k )
+      {
+        P[k] = float(s.P[k] - origin[k]);
+        D[k] = float(s.D[k]);
+      }
+      R   = float(s.R);
+      Sin = float( std::sin(s.Angle) );
+      Cos = float( std::cos(s.Angle) );
+    }
+  };
+
+  //! Remaining points in the structure-of-arrays layout, so that the inlier
+  //! counting loops are vectorized by compiler.
+  struct t_points
+  {
+    std::vector<float> X, Y, Z, NX, NY, NZ;
+    std::vector<int>   Ids;
+
+    int Size() const { return int( Ids.size() ); }
+
+    void Resize(const int n)
+    {
+      X.resize(n); Y.resize(n); Z.resize(n);
+      NX.resize(n); NY.resize(n); NZ.resize(n);
+      Ids.resize(n);
+    }
+  };
+
+  //! Counts inliers of the shape in the range of points. Optionally, marks
+  //! the inliers in the passed mask.
+  template <bool WithMask>
+  int CountInliers(const t_shapef& s,
+                   const t_points& pts,
+                   const int       first,
+                   const int       last,
+                   const float     eps,
+                   const float     cosAng,
+                   unsigned char*  mask)
+  {
+    const float* X  = &pts.X[0];
+    const float* Y  = &pts.Y[0];
+    const float* Z  = &pts.Z[0];
+    const float* NX = &pts.NX[0];
+    const float* NY = &pts.NY[0];
+    const float* NZ = &pts.NZ[0];
+    int          count = 0;
+
+    switch ( s.Type )
+    {
+      case Primitive_Plane:
+      {
+        for ( int i = first; i < last; ++i )
+        {
+          const float d  = (X[i] - s.P[0])*s.D[0] + (Y[i] - s.P[1])*s.D[1] + (Z[i] - s.P[2])*s.D[2];
+          const float nd = NX[i]*s.D[0] + NY[i]*s.D[1] + NZ[i]*s.D[2];
+          const int   in = (std::fabs(d) < eps) & (std::fabs(nd) >= cosAng);
+          //
+          if ( WithMask ) mask[i] = (unsigned char) in;
+          count += in;
+        }
+        break;
+      }
+      case Primitive_Sphere:
+      {
+        for ( int i = first; i < last; ++i )
+        {
+          const float vx = X[i] - s.P[0], vy = Y[i] - s.P[1], vz = Z[i] - s.P[2];
+          const float r  = std::sqrt(vx*vx + vy*vy + vz*vz);
+          const float nd = NX[i]*vx + NY[i]*vy + NZ[i]*vz;
+          const int   in = (std::fabs(r - s.R) < eps) & (std::fabs(nd) >= cosAng*r);
+          //
+          if ( WithMask ) mask[i] = (unsigned char) in;
+          count += in;
+        }
+        break;
+      }
+      case Primitive_Cylinder:
+      {
+        for ( int i = first; i < last; ++i )
+        {
+          const float vx = X[i] - s.P[0], vy = Y[i] - s.P[1], vz = Z[i] - s.P[2];
+          const float h  = vx*s.D[0] + vy*s.D[1] + vz*s.D[2];
+          const float wx = vx - h*s.D[0], wy = vy - h*s.D[1], wz = vz - h*s.D[2];
+          const float r  = std::sqrt(wx*wx + wy*wy + wz*wz);
+          const float nd = NX[i]*wx + NY[i]*wy + NZ[i]*wz;
+          const int   in = (std::fabs(r - s.R) < eps) & (std::fabs(nd) >= cosAng*r);
+          //
+          if ( WithMask ) mask[i] = (unsigned char) in;
+          count += in;
+        }
+        break;
+      }
+      case Primitive_Cone:
+      {
+        for ( int i = first; i < last; ++i )
+        {
+          const float vx = X[i] - s.P[0], vy = Y[i] - s.P[1], vz = Z[i] - s.P[2];
+          const float h  = vx*s.D[0] + vy*s.D[1] + vz*s.D[2];
+          const float wx = vx - h*s.D[0], wy = vy - h*s.D[1], wz = vz - h*s.D[2];
+          const float r  = std::sqrt(wx*wx + wy*wy + wz*wz);
+          const float nw = NX[i]*wx + NY[i]*wy + NZ[i]*wz;
+          const float nd = NX[i]*s.D[0] + NY[i]*s.D[1] + NZ[i]*s.D[2];
+          const int   in = (h > 0.f)
+                         & (std::fabs(r*s.Cos - h*s.Sin) < eps)
+                         & (std::fabs(s.Cos*nw - s.Sin*nd*r) >= cosAng*r);
+          //
+          if ( WithMask ) mask[i] = (unsigned char) in;
+          count += in;
+        }
+        break;
+      }
+      default: break;
+    }
+
+    return count;
+  }
+
+  //---------------------------------------------------------------------------
+
+  //! Constructs a shape from the minimal set of points with normals.
+  bool ConstructShape(const asiAlgo_PrimitiveType type,
+                      const double*               p[3],
+                      const double*               n[3],
+                      t_shape&                    shape)
+  {
+    shape      = t_shape();
+    shape.Type = type;
+
+    switch ( type )
+    {
+      case Primitive_Plane:
+      {
+        const double a[3] = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+        const double b[3] = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+        //
+        Cross(a, b, shape.D);
+        if ( Normalize(shape.D) < 1e-12*std::sqrt( Dot(a, a)*Dot(b, b) ) + 1e-300 )
+          return false;
+
+        std::copy(p[0], p[0] + 3, shape.P);
+        return true;
+      }
+      case Primitive_Sphere:
+      {
+        double q1[3], q2[3];
+        if ( !ClosestPoints(p[0], n[0], p[1], n[1], q1, q2) )
+          return false;
+
+        for ( int k = 0; k < 3; ++k )
+          shape.P[k] = 0.5*(q1[k] + q2[k]);
+
+        const double v1[3] = {p[0][0] - shape.P[0], p[0][1] - shape.P[1], p[0][2] - shape.P[2]};
+        const double v2[3] = {p[1][0] - shape.P[0], p[1][1] - shape.P[1], p[1][2] - shape.P[2]};
+        //
+        shape.R = 0.5*( std::sqrt( Dot(v1, v1) ) + std::sqrt( Dot(v2, v2) ) );
+        return shape.R > 0.;
+      }
+      case Primitive_Cylinder:
+      {
+        Cross(n[0], n[1], shape.D);
+        if ( Normalize(shape.D) < 1e-3 )
+          return false;
+
+        // Project normals and the second point to the plane orthogonal to
+        // the axis and passing through the first point.
+        double a[3], b[3], p2[3];
+        const double h  = (p[1][0] - p[0][0])*shape.D[0]
+                        + (p[1][1] - p[0][1])*shape.D[1]
+                        + (p[1][2] - p[0][2])*shape.D[2];
+        const double na = Dot(n[0], shape.D), nb = Dot(n[1], shape.D);
+        //
+        for ( int k = 0; k < 3; ++k )
+        {
+          a[k]  = n[0][k] - na*shape.D[k];
+          b[k]  = n[1][k] - nb*shape.D[k];
+          p2[k] = p[1][k] - h*shape.D[k];
+        }
+
+        double q1[3], q2[3];
+        if ( !ClosestPoints(p[0], a, p2, b, q1, q2) )
+          return false;
+
+        for ( int k = 0; k < 3; ++k )
+          shape.P[k] = 0.5*(q1[k] + q2[k]);
+
+        const double v1[3] = {p[0][0] - shape.P[0], p[0][1] - shape.P[1], p[0][2] - shape.P[2]};
+        const double v2[3] = {p2[0]   - shape.P[0], p2[1]   - shape.P[1], p2[2]   - shape.P[2]};
+        //
+        shape.R = 0.5*( std::sqrt( Dot(v1, v1) ) + std::sqrt( Dot(v2, v2) ) );
+        return shape.R > 0.;
+      }
+      case Primitive_Cone:
+      {
+        // Apex is the intersection point of the tangent planes.
+        Eigen::Matrix3d M;
+        Eigen::Vector3d rhs;
+        //
+        for ( int i = 0; i < 3; ++i )
+        {
+          M(i, 0) = n[i][0];
+          M(i, 1) = n[i][1];
+          M(i, 2) = n[i][2];
+          rhs(i)  = Dot(n[i], p[i]);
+        }
+        //
+        // The apex is unstable if the normals are close to coplanar.
+        if ( std::fabs( M.determinant() ) < 1e-2 )
+          return false;
+
+        const Eigen::Vector3d apex = M.partialPivLu().solve(rhs);
+        //
+        for ( int k = 0; k < 3; ++k )
+          shape.P[k] = apex(k);
+
+        // The axis is orthogonal to the plane passing through the unit
+        // directions from the apex to the points.
+        double u[3][3];
+        for ( int i = 0; i < 3; ++i )
+        {
+          for ( int k = 0; k < 3; ++k )
+            u[i][k] = p[i][k] - shape.P[k];
+          //
+          if ( Normalize(u[i]) <= 0. )
+            return false;
+        }
+
+        const double a[3] = {u[1][0] - u[0][0], u[1][1] - u[0][1], u[1][2] - u[0][2]};
+        const double b[3] = {u[2][0] - u[0][0], u[2][1] - u[0][1], u[2][2] - u[0][2]};
+        //
+        Cross(a, b, shape.D);
+        if ( Normalize(shape.D) < 1e-6 )
+          return false;
+
+        if ( Dot(shape.D, u[0]) + Dot(shape.D, u[1]) + Dot(shape.D, u[2]) < 0. )
+        {
+          shape.D[0] = -shape.D[0];
+          shape.D[1] = -shape.D[1];
+          shape.D[2] = -shape.D[2];
+        }
+
+        shape.Angle = 0.;
+        for ( int i = 0; i < 3; ++i )
+          shape.Angle += std::acos( std::max( -1., std::min( 1., Dot(shape.D, u[i]) ) ) )/3.;
+
+        return (shape.Angle > MinConeAngle) && (shape.Angle < MaxConeAngle);
+      }
+      default: break;
+    }
+
+    return false;
+  }
+
+  //! Computes an orthonormal basis of the plane orthogonal to the direction.
+  void OrthoBasis(const double* D, double* e1, double* e2)
+  {
+    e1[0] = 1.; e1[1] = 0.; e1[2] = 0.;
+    //
+    if ( std::fabs(D[0]) > 0.9 )
+    {
+      e1[0] = 0.;
+      e1[1] = 1.;
+    }
+    Cross(D, e1, e2);
+    Normalize(e2);
+    Cross(e2, D, e1);
+  }
+
+  //! Computes the sum of squared distances from the points to the shape.
+  double SquaredDistances(const std::vector<double>& coords,
+                          const std::vector<int>&    ids,
+                          const t_shape&             shape)
+  {
+    const double N[3] = {0., 0., 1.};
+    double       sum  = 0.;
+    //
+    for ( size_t i = 0; i < ids.size(); ++i )
+    {
+      double dist, cosAng;
+      shape.Eval(&coords[3*ids[i]], N, dist, cosAng);
+      //
+      sum += std::min(dist*dist, DBL_MAX/ids.size());
+    }
+    return sum;
+  }
+
+  //! Refines cylinder or cone with Levenberg-Marquardt iterations minimizing
+  //! the squared distances to the points. The parameters are the axis point
+  //! (or apex), two rotations of the axis and the radius (or semi-angle).
+  void RefineShape(const std::vector<double>& coords,
+                   const std::vector<int>&    ids,
+                   t_shape&                   shape)
+  {
+    typedef Eigen::Matrix<double, 6, 6> t_mx6;
+    typedef Eigen::Matrix<double, 6, 1> t_vec6;
+
+    const bool isCone = (shape.Type == Primitive_Cone);
+    double     cost   = SquaredDistances(coords, ids, shape);
+    double     lambda = 1e-3;
+
+    for ( int iter = 0; iter < 10; ++iter )
+    {
+      double e1[3], e2[3];
+      OrthoBasis(shape.D, e1, e2);
+
+      const double c = std::cos(shape.Angle), s = std::sin(shape.Angle);
+      t_mx6        JtJ = t_mx6::Zero();
+      t_vec6       Jtr = t_vec6::Zero();
+      //
+      for ( size_t i = 0; i < ids.size(); ++i )
+      {
+        const double* p    = &coords[3*ids[i]];
+        const double  v[3] = {p[0] - shape.P[0], p[1] - shape.P[1], p[2] - shape.P[2]};
+        const double  h    = Dot(v, shape.D);
+        const double  w[3] = {v[0] - h*shape.D[0], v[1] - h*shape.D[1], v[2] - h*shape.D[2]};
+        const double  r    = std::sqrt( Dot(w, w) );
+        //
+        if ( r < 1e-12 )
+          continue;
+
+        t_vec6 J;
+        double d;
+        //
+        if ( isCone )
+        {
+          d = r*c - h*s;
+          for ( int k = 0; k < 3; ++k )
+            J(k) = -c*w[k]/r + s*shape.D[k];
+          //
+          J(3) = -Dot(v, e1)*(c*h/r + s);
+          J(4) = -Dot(v, e2)*(c*h/r + s);
+          J(5) = -r*s - h*c;
+        }
+        else
+        {
+          d = r - shape.R;
+          for ( int k = 0; k < 3; ++k )
+            J(k) = -w[k]/r;
+          //
+          J(3) = -Dot(v, e1)*h/r;
+          J(4) = -Dot(v, e2)*h/r;
+          J(5) = -1.;
+        }
+
+        JtJ += J*J.transpose();
+        Jtr += J*d;
+      }
+
+      // Damping also fixes the degenerate direction along the axis.
+      t_mx6 A = JtJ;
+      for ( int k = 0; k < 6; ++k )
+        A(k, k) += lambda*( JtJ(k, k) + 1e-12 );
+
+      const t_vec6 delta = A.ldlt().solve(-Jtr);
+      //
+      if ( !delta.allFinite() )
+        break;
+
+      t_shape next = shape;
+      for ( int k = 0; k < 3; ++k )
+      {
+        next.P[k] += delta(k);
+        next.D[k] += delta(3)*e1[k] + delta(4)*e2[k];
+      }
+      Normalize(next.D);
+      //
+      if ( isCone )
+        next.Angle += delta(5);
+      else
+        next.R += delta(5);
+
+      const bool   isValid  = isCone ? (next.Angle > MinConeAngle && next.Angle < MaxConeAngle)
+                                     : (next.R > 0.);
+      const double nextCost = isValid ? SquaredDistances(coords, ids, next) : DBL_MAX;
+      //
+      if ( nextCost < cost )
+      {
+        const bool isConverged = (cost - nextCost < 1e-9*cost);
+        //
+        shape   = next;
+        cost    = nextCost;
+        lambda *= 0.1;
+        //
+        if ( isConverged )
+          break;
+      }
+      else
+      {
+        lambda *= 10.;
+      }
+    }
+  }
+
+  //! Refits the shape to the passed points.
+  void RefitShape(const std::vector<double>& coords,
+                  const std::vector<int>&    ids,
+                  t_shape&                   shape)
+  {
+    const int n = int( ids.size() );
+    if ( n < 4 )
+      return;
+
+    // Centroid.
+    Eigen::Vector3d c = Eigen::Vector3d::Zero();
+    for ( int i = 0; i < n; ++i )
+      c += Eigen::Vector3d(coords[3*ids[i]], coords[3*ids[i] + 1], coords[3*ids[i] + 2]);
+    //
+    c /= n;
+
+    if ( shape.Type == Primitive_Plane )
+    {
+      Eigen::Matrix3d C = Eigen::Matrix3d::Zero();
+      for ( int i = 0; i < n; ++i )
+      {
+        const Eigen::Vector3d v = Eigen::Vector3d(coords[3*ids[i]], coords[3*ids[i] + 1], coords[3*ids[i] + 2]) - c;
+        C += v*v.transpose();
+      }
+
+      Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigen(C);
+      const Eigen::Vector3d D = eigen.eigenvectors().col(0);
+      //
+      for ( int k = 0; k < 3; ++k )
+      {
+        shape.P[k] = c(k);
+        shape.D[k] = D(k);
+      }
+    }
+    else if ( shape.Type == Primitive_Sphere )
+    {
+      // Algebraic fit: |x|^2 + a.x + d = 0 (relative to the centroid).
+      Eigen::Matrix4d A = Eigen::Matrix4d::Zero();
+      Eigen::Vector4d b = Eigen::Vector4d::Zero();
+      //
+      for ( int i = 0; i < n; ++i )
+      {
+        const Eigen::Vector3d v = Eigen::Vector3d(coords[3*ids[i]], coords[3*ids[i] + 1], coords[3*ids[i] + 2]) - c;
+        const Eigen::Vector4d row(v(0), v(1), v(2), 1.);
+        //
+        A += row*row.transpose();
+        b -= row*v.squaredNorm();
+      }
+
+      const Eigen::Vector4d x   = A.ldlt().solve(b);
+      const Eigen::Vector3d ctr = -0.5*x.head<3>();
+      const double          sqR = ctr.squaredNorm() - x(3);
+      //
+      if ( sqR > 0. && x.allFinite() )
+      {
+        for ( int k = 0; k < 3; ++k )
+          shape.P[k] = ctr(k) + c(k);
+        //
+        shape.R = std::sqrt(sqR);
+      }
+    }
+    else if ( shape.Type == Primitive_Cylinder )
+    {
+      // Circle fit in the plane orthogonal to the axis.
+      double e1[3], e2[3];
+      OrthoBasis(shape.D, e1, e2);
+
+      Eigen::Matrix3d A = Eigen::Matrix3d::Zero();
+      Eigen::Vector3d b = Eigen::Vector3d::Zero();
+      //
+      for ( int i = 0; i < n; ++i )
+      {
+        const double v[3] = {coords[3*ids[i]]     - c(0),
+                             coords[3*ids[i] + 1] - c(1),
+                             coords[3*ids[i] + 2] - c(2)};
+        const double x = Dot(v, e1), y = Dot(v, e2);
+        const Eigen::Vector3d row(x, y, 1.);
+        //
+        A += row*row.transpose();
+        b -= row*(x*x + y*y);
+      }
+
+      const Eigen::Vector3d x   = A.ldlt().solve(b);
+      const double          cx  = -0.5*x(0), cy = -0.5*x(1);
+      const double          sqR = cx*cx + cy*cy - x(2);
+      //
+      if ( sqR > 0. && x.allFinite() )
+      {
+        for ( int k = 0; k < 3; ++k )
+          shape.P[k] = c(k) + cx*e1[k] + cy*e2[k];
+        //
+        shape.R = std::sqrt(sqR);
+      }
+    }
+
+    if ( shape.Type == Primitive_Cylinder || shape.Type == Primitive_Cone )
+      RefineShape(coords, ids, shape);
+  }
+
+  //---------------------------------------------------------------------------
+
+  //! Shared data of detection.
+  struct t_context
+  {
+    const std::vector<double>*         Coords;     //!< All points.
+    const std::vector<double>*         Normals;    //!< All normals.
+    const asiAlgo_CloudKdTree<double>* Tree;       //!< Spatial index.
+    const std::vector<char>*           Assigned;   //!< Points extracted already.
+    const t_points*                    Remaining;  //!< Remaining points.
+    const double*                      Origin;     //!< Origin of shifted coords.
+    std::vector<asiAlgo_PrimitiveType> Types;      //!< Types to detect.
+    double                             Tol;        //!< Distance tolerance.
+    double                             CosAng;     //!< Cosine of angular tolerance.
+    int                                SubsetSize; //!< Number of points to score against.
+    unsigned                           Seed;       //!< Seed of the round.
+  };
+
+  //! Generates and scores candidate shapes.
+  class CandidatesFunctor
+  {
+  public:
+
+    CandidatesFunctor(const t_context& ctx, std::vector<t_shape>& candidates)
+    : m_ctx(ctx), m_candidates(candidates) {}
+
+    void Process(const int first, const int last) const
+    {
+      std::vector<int>    neighbors;
+      std::vector<double> sqDists;
+
+      for ( int c = first; c < last; ++c )
+      {
+        t_shape& shape = m_candidates[c];
+        shape.Score = -1;
+
+        // Each candidate has its own generator, so the results do not
+        // depend on the scheduling of tasks.
+        std::mt19937 rng(m_ctx.Seed*7919u + unsigned(c));
+
+        const asiAlgo_PrimitiveType type = m_ctx.Types[rng() % m_ctx.Types.size()];
+
+        // Sample a seed point and two more points in its neighborhood.
+        const int    seed = m_ctx.Remaining->Ids[rng() % m_ctx.Remaining->Size()];
+        const double* P   = &(*m_ctx.Coords)[3*seed];
+        const int    k    = NeighborhoodSizes[rng() % 3];
+        //
+        m_ctx.Tree->FindKNearest(P[0], P[1], P[2], k, neighbors, sqDists);
+
+        int ids[3] = {seed, -1, -1};
+        for ( int s = 1, attempt = 0; s < 3 && attempt < 16; ++attempt )
+        {
+          const int id = neighbors[rng() % neighbors.size()];
+          //
+          if ( (*m_ctx.Assigned)[id] || id == ids[0] || id == ids[1] )
+            continue;
+
+          ids[s++] = id;
+        }
+        //
+        if ( ids[2] < 0 )
+          continue;
+
+        const double* p[3];
+        const double* n[3];
+        for ( int i = 0; i < 3; ++i )
+        {
+          p[i] = &(*m_ctx.Coords)[3*ids[i]];
+          n[i] = &(*m_ctx.Normals)[3*ids[i]];
+        }
+        //
+        if ( !ConstructShape(type, p, n, shape) )
+          continue;
+
+        // All samples should be compatible with the shape.
+        bool isOk = true;
+        for ( int i = 0; i < 3 && isOk; ++i )
+        {
+          double dist, cosAng;
+          shape.Eval(p[i], n[i], dist, cosAng);
+          //
+          isOk = (dist < m_ctx.Tol) && (cosAng >= m_ctx.CosAng);
+        }
+        //
+        if ( !isOk )
+          continue;
+
+        // Score against the subset.
+        shape.Score = CountInliers<false>( t_shapef(shape, m_ctx.Origin), *m_ctx.Remaining,
+                                           0, m_ctx.SubsetSize,
+                                           float(m_ctx.Tol), float(m_ctx.CosAng), nullptr );
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const t_context&      m_ctx;
+    std::vector<t_shape>& m_candidates;
+  };
+
+  //! Marks inliers of a shape among all remaining points.
+  class InliersFunctor
+  {
+  public:
+
+    InliersFunctor(const t_shapef&             shape,
+                   const t_points&             pts,
+                   const float                 eps,
+                   const float                 cosAng,
+                   std::vector<unsigned char>& mask)
+    : m_shape(shape), m_pts(pts), m_fEps(eps), m_fCosAng(cosAng), m_mask(mask) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      const int first = firstBlock*BlockSize;
+      const int last  = std::min(m_pts.Size(), lastBlock*BlockSize);
+      //
+      CountInliers<true>(m_shape, m_pts, first, last, m_fEps, m_fCosAng, &m_mask[0]);
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const t_shapef&             m_shape;
+    const t_points&             m_pts;
+    float                       m_fEps;
+    float                       m_fCosAng;
+    std::vector<unsigned char>& m_mask;
+  };
+
+  //! Estimates normals with principal component analysis of neighbors.
+  class NormalsFunctor
+  {
+  public:
+
+    NormalsFunctor(const std::vector<double>& coords,
+                   const std::vector<int>&    neighbors,
+                   const int                  k,
+                   std::vector<double>&       normals)
+    : m_coords(coords), m_neighbors(neighbors), m_iK(k), m_normals(normals) {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int i = first; i < last; ++i )
+      {
+        Eigen::Vector3d c   = Eigen::Vector3d::Zero();
+        int             num = 0;
+        //
+        for ( int s = 0; s < m_iK; ++s )
+        {
+          const int j = m_neighbors[i*m_iK + s];
+          if ( j < 0 )
+            continue;
+
+          c += Eigen::Vector3d(m_coords[3*j], m_coords[3*j + 1], m_coords[3*j + 2]);
+          num++;
+        }
+        //
+        if ( num < 3 )
+        {
+          m_normals[3*i] = m_normals[3*i + 1] = m_normals[3*i + 2] = 0.;
+          continue;
+        }
+        c /= num;
+
+        Eigen::Matrix3d C = Eigen::Matrix3d::Zero();
+        for ( int s = 0; s < m_iK; ++s )
+        {
+          const int j = m_neighbors[i*m_iK + s];
+          if ( j < 0 )
+            continue;
+
+          const Eigen::Vector3d v = Eigen::Vector3d(m_coords[3*j], m_coords[3*j + 1], m_coords[3*j + 2]) - c;
+          C += v*v.transpose();
+        }
+
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigen(C);
+        const Eigen::Vector3d N = eigen.eigenvectors().col(0);
+        //
+        m_normals[3*i]     = N(0);
+        m_normals[3*i + 1] = N(1);
+        m_normals[3*i + 2] = N(2);
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const std::vector<double>& m_coords;
+    const std::vector<int>&    m_neighbors;
+    int                        m_iK;
+    std::vector<double>&       m_normals;
+  };
+
+  //! Runs the functor over the range of items.
+  template <typename TFunctor>
+  void Run(const TFunctor& func, const int num, const int grain, const bool isParallel)
+  {
+#ifdef USE_THREADING
+    if ( isParallel )
+    {
+      tbb::parallel_for(tbb::blocked_range<int>(0, num, grain), func);
+      return;
+    }
+#else
+    (void) grain;
+    (void) isParallel;
+#endif
+    func.Process(0, num);
+  }
+
+  //---------------------------------------------------------------------------
+
+  //! Populates the remaining points in the shuffled order, so that any
+  //! prefix of the arrays is a random subset.
+  void PopulateRemaining(const std::vector<double>& coords,
+                         const std::vector<double>& normals,
+                         const std::vector<char>&   assigned,
+                         const double*              origin,
+                         std::mt19937&              rng,
+                         t_points&                  pts)
+  {
+    std::vector<int> ids;
+    for ( int i = 0; i < int( assigned.size() ); ++i )
+      if ( !assigned[i] )
+        ids.push_back(i);
+    //
+    std::shuffle(ids.begin(), ids.end(), rng);
+
+    const int n = int( ids.size() );
+    pts.Resize(n);
+    //
+    for ( int i = 0; i < n; ++i )
+    {
+      const int id = ids[i];
+      //
+      pts.Ids[i] = id;
+      pts.X[i]   = float(coords[3*id]     - origin[0]);
+      pts.Y[i]   = float(coords[3*id + 1] - origin[1]);
+      pts.Z[i]   = float(coords[3*id + 2] - origin[2]);
+      pts.NX[i]  = float(normals[3*id]);
+      pts.NY[i]  = float(normals[3*id + 1]);
+      pts.NZ[i]  = float(normals[3*id + 2]);
+    }
+  }
+
+  //! Finds the largest connected region among the inliers.
+  //! \param[in]  tree      spatial index.
+  //! \param[in]  coords    all points.
+  //! \param[in]  inliers   0-based indices of inliers.
+  //! \param[in]  radius    max distance between neighbors.
+  //! \param[out] region    0-based indices of the largest region.
+  void LargestRegion(const asiAlgo_CloudKdTree<double>& tree,
+                     const std::vector<double>&         coords,
+                     const std::vector<int>&            inliers,
+                     const double                       radius,
+                     std::vector<int>&                  region)
+  {
+    region.clear();
+
+    // Labels: -1 for outliers, 0 for unvisited inliers, otherwise region id.
+    std::vector<int> labels(coords.size()/3, -1);
+    for ( size_t i = 0; i < inliers.size(); ++i )
+      labels[inliers[i]] = 0;
+
+    std::vector<int>    front, current;
+    std::vector<int>    neighbors;
+    std::vector<double> sqDists;
+    int                 regionId = 0;
+    //
+    for ( size_t i = 0; i < inliers.size(); ++i )
+    {
+      if ( labels[inliers[i]] )
+        continue;
+
+      regionId++;
+      current.clear();
+      front.assign(1, inliers[i]);
+      labels[inliers[i]] = regionId;
+
+      while ( !front.empty() )
+      {
+        const int id = front.back();
+        front.pop_back();
+        current.push_back(id);
+
+        const double* P = &coords[3*id];
+        tree.FindInRadius(P[0], P[1], P[2], radius, neighbors, sqDists);
+        //
+        for ( size_t j = 0; j < neighbors.size(); ++j )
+        {
+          if ( labels[neighbors[j]] != 0 )
+            continue;
+
+          labels[neighbors[j]] = regionId;
+          front.push_back(neighbors[j]);
+        }
+      }
+
+      if ( current.size() > region.size() )
+        region.swap(current);
+    }
+
+    std::sort( region.begin(), region.end() );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_DetectPrimitives::asiAlgo_DetectPrimitives(ActAPI_ProgressEntry progress,
+                                                   ActAPI_PlotterEntry  plotter)
+: ActAPI_IAlgorithm (progress, plotter),
+  m_fTol            (0.),
+  m_fAngTolDeg      (20.),
+  m_fClusterTol     (0.),
+  m_iMinPoints      (100),
+  m_iTypes          (Primitive_All),
+  m_iNumNeighbors   (10),
+  m_iNumCandidates  (64),
+  m_iMaxFailures    (20),
+  m_iSeed           (1),
+  m_bIsParallel     (true),
+  m_fSpacing        (0.)
+{}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_DetectPrimitives::Perform(const Handle(asiAlgo_BaseCloud<double>)& points,
+                                       const Handle(asiAlgo_BaseCloud<double>)& normals)
+{
+  m_primitives.clear();
+  m_unassigned.clear();
+
+  if ( points.IsNull() || points->IsEmpty() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Empty point cloud.");
+    return false;
+  }
+  //
+  if ( !normals.IsNull() && normals->GetNumberOfElements() != points->GetNumberOfElements() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "The number of normals is different "
+                                                "from the number of points.");
+    return false;
+  }
+
+  std::vector<asiAlgo_PrimitiveType> types;
+  //
+  if ( m_iTypes & Primitive_Plane )    types.push_back(Primitive_Plane);
+  if ( m_iTypes & Primitive_Sphere )   types.push_back(Primitive_Sphere);
+  if ( m_iTypes & Primitive_Cylinder ) types.push_back(Primitive_Cylinder);
+  if ( m_iTypes & Primitive_Cone )     types.push_back(Primitive_Cone);
+  //
+  if ( types.empty() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "No primitive types to detect.");
+    return false;
+  }
+
+  TIMER_NEW
+  TIMER_GO
+
+  const int                  numPts = points->GetNumberOfElements();
+  const std::vector<double>& coords = points->GetCoords();
+
+  // Build spatial index.
+  asiAlgo_CloudKdTree<double> tree;
+  tree.SetParallelMode(m_bIsParallel);
+  tree.Build(points);
+
+  // Estimate normals and point spacing.
+  this->estimateNormals( points, tree, normals.IsNull() );
+  //
+  if ( !normals.IsNull() )
+  {
+    m_normals = new asiAlgo_BaseCloud<double>;
+    normals->CopyTo(*m_normals);
+
+    // Unit normals are expected by the inlier tests.
+    std::vector<double>& N = m_normals->ChangeCoords();
+    for ( int i = 0; i < numPts; ++i )
+      Normalize(&N[3*i]);
+  }
+
+  const double tol        = (m_fTol > 0.)        ? m_fTol        : 2.*m_fSpacing;
+  const double clusterTol = (m_fClusterTol > 0.) ? m_fClusterTol : 3.*m_fSpacing;
+  //
+  m_progress.SendLogMessage( LogInfo(Normal) << "Detecting primitives with tolerance %1 "
+                                                "and cluster tolerance %2."
+                                             << tol << clusterTol );
+
+  // Shift the origin to the center of the bounding box for the single
+  // precision inlier tests.
+  double xMin, xMax, yMin, yMax, zMin, zMax;
+  points->ComputeBoundingBox(xMin, xMax, yMin, yMax, zMin, zMax);
+  //
+  const double origin[3] = {0.5*(xMin + xMax), 0.5*(yMin + yMax), 0.5*(zMin + zMax)};
+
+  std::mt19937               rng(m_iSeed);
+  std::vector<char>          assigned(numPts, 0);
+  t_points                   remaining;
+  std::vector<t_shape>       candidates(m_iNumCandidates);
+  std::vector<unsigned char> mask;
+  std::vector<int>           inliers, region, bestRegion;
+  //
+  PopulateRemaining(coords, m_normals->GetCoords(), assigned, origin, rng, remaining);
+
+  t_context ctx;
+  ctx.Coords    = &coords;
+  ctx.Normals   = &m_normals->GetCoords();
+  ctx.Tree      = &tree;
+  ctx.Assigned  = &assigned;
+  ctx.Remaining = &remaining;
+  ctx.Origin    = origin;
+  ctx.Types     = types;
+  ctx.Tol       = tol;
+  ctx.CosAng    = std::cos(m_fAngTolDeg*M_PI/180.);
+
+  int numFailures = 0, round = 0;
+  //
+  while ( numFailures < m_iMaxFailures && remaining.Size() >= std::max(m_iMinPoints, 3) )
+  {
+    if ( m_progress.IsCancelling() )
+      return false;
+
+    ctx.SubsetSize = std::min(SubsetSize, remaining.Size());
+    ctx.Seed       = m_iSeed + unsigned(round++);
+
+    // Generate and score candidates.
+    Run(CandidatesFunctor(ctx, candidates), m_iNumCandidates, 1, m_bIsParallel);
+
+    int best = -1;
+    for ( int c = 0; c < m_iNumCandidates; ++c )
+      if ( candidates[c].Score > 0 && ( best < 0 || candidates[c].Score > candidates[best].Score ) )
+        best = c;
+
+    // Skip if the best candidate cannot be big enough.
+    if ( best < 0 ||
+         double(candidates[best].Score)*remaining.Size()/ctx.SubsetSize < 0.5*m_iMinPoints )
+    {
+      numFailures++;
+      continue;
+    }
+
+    t_shape shape = candidates[best], bestShape;
+
+    // Score against all points, grow region and refit while the region
+    // keeps growing.
+    bestRegion.clear();
+    //
+    for ( int pass = 0; pass < MaxRefits; ++pass )
+    {
+      const int numBlocks = (remaining.Size() + BlockSize - 1)/BlockSize;
+      //
+      mask.resize( remaining.Size() );
+      Run(InliersFunctor( t_shapef(shape, origin), remaining, float(tol), float(ctx.CosAng), mask ),
+          numBlocks, 1, m_bIsParallel);
+
+      inliers.clear();
+      for ( int i = 0; i < remaining.Size(); ++i )
+        if ( mask[i] )
+          inliers.push_back(remaining.Ids[i]);
+
+      LargestRegion(tree, coords, inliers, clusterTol, region);
+      //
+      if ( region.size() <= bestRegion.size() )
+        break;
+
+      bestShape = shape;
+      bestRegion.swap(region);
+      //
+      RefitShape(coords, bestRegion, shape);
+    }
+    //
+    shape = bestShape;
+    region.swap(bestRegion);
+
+    if ( int( region.size() ) < m_iMinPoints )
+    {
+      numFailures++;
+      continue;
+    }
+
+    // Accept primitive.
+    t_primitive prim;
+    prim.Type      = shape.Type;
+    prim.Radius    = shape.R;
+    prim.SemiAngle = shape.Angle;
+    prim.Indices   = region;
+    prim.Axes      = gp_Ax3( gp_Pnt(shape.P[0], shape.P[1], shape.P[2]),
+                             gp_Dir(shape.D[0], shape.D[1], shape.D[2]) );
+
+    gp_Pln      pln;
+    gp_Sphere   sph;
+    gp_Cylinder cyl;
+    gp_Cone     cone;
+    //
+    switch ( shape.Type )
+    {
+      case Primitive_Plane:
+        pln          = gp_Pln(prim.Axes);
+        prim.Surface = new Geom_Plane(pln);
+        break;
+      case Primitive_Sphere:
+        sph          = gp_Sphere(prim.Axes, shape.R);
+        prim.Surface = new Geom_SphericalSurface(sph);
+        break;
+      case Primitive_Cylinder:
+        cyl          = gp_Cylinder(prim.Axes, shape.R);
+        prim.Surface = new Geom_CylindricalSurface(cyl);
+        break;
+      case Primitive_Cone:
+        cone         = gp_Cone(prim.Axes, shape.Angle, 0.);
+        prim.Surface = new Geom_ConicalSurface(cone);
+        break;
+      default: break;
+    }
+
+    // Parametric bounds and deviation.
+    prim.UMin = prim.VMin =  DBL_MAX;
+    prim.UMax = prim.VMax = -DBL_MAX;
+    //
+    for ( size_t i = 0; i < region.size(); ++i )
+    {
+      const int    id = region[i];
+      const gp_Pnt P(coords[3*id], coords[3*id + 1], coords[3*id + 2]);
+      double       u = 0., v = 0., dist, cosAng;
+
+      shape.Eval( &coords[3*id], &m_normals->GetCoords()[3*id], dist, cosAng );
+      prim.MeanDev += dist/region.size();
+
+      switch ( shape.Type )
+      {
+        case Primitive_Plane:    ElSLib::Parameters(pln,  P, u, v); break;
+        case Primitive_Sphere:   ElSLib::Parameters(sph,  P, u, v); break;
+        case Primitive_Cylinder: ElSLib::Parameters(cyl,  P, u, v); break;
+        case Primitive_Cone:     ElSLib::Parameters(cone, P, u, v); break;
+        default: break;
+      }
+
+      prim.UMin = std::min(prim.UMin, u);
+      prim.UMax = std::max(prim.UMax, u);
+      prim.VMin = std::min(prim.VMin, v);
+      prim.VMax = std::max(prim.VMax, v);
+    }
+
+    m_primitives.push_back(prim);
+
+    // Extract points.
+    for ( size_t i = 0; i < region.size(); ++i )
+      assigned[region[i]] = 1;
+    //
+    PopulateRemaining(coords, m_normals->GetCoords(), assigned, origin, rng, remaining);
+
+    numFailures = 0;
+  }
+
+  for ( int i = 0; i < numPts; ++i )
+    if ( !assigned[i] )
+      m_unassigned.push_back(i);
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Detect primitives")
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "%1 primitive(s) detected in %2 round(s). "
+                                                "%3 point(s) out of %4 are not assigned."
+                                             << int( m_primitives.size() ) << round
+                                             << int( m_unassigned.size() ) << numPts );
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_DetectPrimitives::estimateNormals(const Handle(asiAlgo_BaseCloud<double>)& points,
+                                               const asiAlgo_CloudKdTree<double>&       tree,
+                                               const bool                               withNormals)
+{
+  const int                  numPts = points->GetNumberOfElements();
+  const std::vector<double>& coords = points->GetCoords();
+  const int                  k      = std::max(m_iNumNeighbors, 3);
+
+  std::vector<int>    neighbors;
+  std::vector<double> sqDists;
+  tree.FindKNearest(coords, k, neighbors, sqDists);
+
+  // Average distance to the nearest neighbor (the first one is the point
+  // itself).
+  double spacing = 0.;
+  int    num     = 0;
+  //
+  for ( int i = 0; i < numPts; ++i )
+  {
+    if ( neighbors[i*k + 1] < 0 )
+      continue;
+
+    spacing += std::sqrt(sqDists[i*k + 1]);
+    num++;
+  }
+  //
+  m_fSpacing = num ? spacing/num : 0.;
+
+  if ( !withNormals )
+    return;
+
+  m_normals = new asiAlgo_BaseCloud<double>;
+  m_normals->ChangeCoords().resize(3*numPts);
+  //
+  Run(NormalsFunctor( coords, neighbors, k, m_normals->ChangeCoords() ),
+      numPts, 1024, m_bIsParallel);
+}
@@ -0,0 +1,257 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_DetectPrimitives_h
+#define asiAlgo_DetectPrimitives_h
+
+// asiAlgo includes
+#include <asiAlgo_BaseCloud.h>
+#include <asiAlgo_CloudKdTree.h>
+
+// Active Data includes
+#include <ActAPI_IAlgorithm.h>
+
+// OCCT includes
+#include <Geom_Surface.hxx>
+#include <gp_Ax3.hxx>
+
+// STL includes
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+//! Types of primitives to detect.
+enum asiAlgo_PrimitiveType
+{
+  Primitive_Plane    = 0x01,
+  Primitive_Sphere   = 0x02,
+  Primitive_Cylinder = 0x04,
+  Primitive_Cone     = 0x08,
+  //
+  Primitive_All      = Primitive_Plane | Primitive_Sphere | Primitive_Cylinder | Primitive_Cone
+};
+
+//-----------------------------------------------------------------------------
+
+//! Detects planes, spheres, cylinders and cones in a point cloud with
+//! RANSAC (see R. Schnabel et al., "Efficient RANSAC for point-cloud shape
+//! detection"). The minimal sets of points are sampled locally, i.e., in
+//! the neighborhood of a random seed point found with a k-d tree, and the
+//! shapes are constructed from the points together with their normals.
+//! The normals are estimated from the nearest neighbors if not passed.
+//!
+//! Each round generates a batch of candidate shapes which are scored in
+//! parallel against a random subset of the remaining points. The best
+//! candidate is scored against all remaining points, and its inliers are
+//! grown into a connected region. If the largest region is big enough, the
+//! shape is refitted and its points are extracted from the cloud. The
+//! detection stops after a number of unsuccessful rounds in a row.
+class asiAlgo_DetectPrimitives : public ActAPI_IAlgorithm
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_DetectPrimitives, ActAPI_IAlgorithm)
+
+public:
+
+  //! Detected primitive.
+  struct t_primitive
+  {
+    asiAlgo_PrimitiveType Type;          //!< Type of primitive.
+    gp_Ax3                Axes;          //!< Placement (plane, axis, center or apex).
+    double                Radius;        //!< Radius of sphere or cylinder.
+    double                SemiAngle;     //!< Semi-angle of cone.
+    double                UMin;          //!< Min U of inliers on the surface.
+    double                UMax;          //!< Max U of inliers on the surface.
+    double                VMin;          //!< Min V of inliers on the surface.
+    double                VMax;          //!< Max V of inliers on the surface.
+    double                MeanDev;       //!< Mean deviation of inliers.
+    Handle(Geom_Surface)  Surface;       //!< Host surface.
+    std::vector<int>      Indices;       //!< 0-based indices of inliers.
+
+    t_primitive() : Type(Primitive_Plane), Radius(0.), SemiAngle(0.),
+                    UMin(0.), UMax(0.), VMin(0.), VMax(0.), MeanDev(0.) {}
+  };
+
+public:
+
+  //! Ctor accepting progress notifier and imperative plotter.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  asiAlgo_EXPORT
+    asiAlgo_DetectPrimitives(ActAPI_ProgressEntry progress = nullptr,
+                             ActAPI_PlotterEntry  plotter  = nullptr);
+
+public:
+
+  //! Detects primitives in the passed point cloud.
+  //! \param[in] points  point cloud.
+  //! \param[in] normals optional normals (one per point). If null, the
+  //!                    normals are estimated from the nearest neighbors.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const Handle(asiAlgo_BaseCloud<double>)& points,
+            const Handle(asiAlgo_BaseCloud<double>)& normals = nullptr);
+
+public:
+
+  //! \return detected primitives in the order of detection.
+  const std::vector<t_primitive>& GetPrimitives() const
+  {
+    return m_primitives;
+  }
+
+  //! \return indices of points not assigned to any primitive.
+  const std::vector<int>& GetUnassigned() const
+  {
+    return m_unassigned;
+  }
+
+  //! \return normals used for detection.
+  const Handle(asiAlgo_BaseCloud<double>)& GetNormals() const
+  {
+    return m_normals;
+  }
+
+public:
+
+  //! Sets max distance from inliers to a primitive.
+  //! \param[in] tol the tolerance to set.
+  void SetTolerance(const double tol)
+  {
+    m_fTol = tol;
+  }
+
+  //! Sets max angle (in degrees) between the normals of inliers and
+  //! the normal of a primitive.
+  //! \param[in] angDeg the angle to set.
+  void SetAngularTolerance(const double angDeg)
+  {
+    m_fAngTolDeg = angDeg;
+  }
+
+  //! Sets max distance between neighbor points of a connected region. If
+  //! not positive, the distance is derived from the density of points.
+  //! \param[in] tol the tolerance to set.
+  void SetClusterTolerance(const double tol)
+  {
+    m_fClusterTol = tol;
+  }
+
+  //! Sets min number of points in a primitive.
+  //! \param[in] num the number to set.
+  void SetMinPoints(const int num)
+  {
+    m_iMinPoints = num;
+  }
+
+  //! Sets the types of primitives to detect.
+  //! \param[in] types combination of asiAlgo_PrimitiveType flags.
+  void SetTypes(const int types)
+  {
+    m_iTypes = types;
+  }
+
+  //! Sets the number of neighbors for normal estimation.
+  //! \param[in] k the number to set.
+  void SetNumNeighbors(const int k)
+  {
+    m_iNumNeighbors = k;
+  }
+
+  //! Sets the number of candidates generated in each round.
+  //! \param[in] num the number to set.
+  void SetNumCandidates(const int num)
+  {
+    m_iNumCandidates = num;
+  }
+
+  //! Sets the number of unsuccessful rounds in a row to stop after.
+  //! \param[in] num the number to set.
+  void SetMaxFailures(const int num)
+  {
+    m_iMaxFailures = num;
+  }
+
+  //! Sets the seed of random sampling.
+  //! \param[in] seed the seed to set.
+  void SetSeed(const unsigned seed)
+  {
+    m_iSeed = seed;
+  }
+
+  //! Enables/disables parallel mode.
+  //! \param[in] on the Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+  //! \return true if parallel mode is enabled.
+  bool IsParallelMode() const
+  {
+    return m_bIsParallel;
+  }
+
+protected:
+
+  //! Estimates the average spacing of points and, optionally, the normals
+  //! with principal component analysis of the nearest neighbors.
+  //! \param[in] points      point cloud.
+  //! \param[in] tree        spatial index of the point cloud.
+  //! \param[in] withNormals whether to estimate normals.
+  void estimateNormals(const Handle(asiAlgo_BaseCloud<double>)& points,
+                       const asiAlgo_CloudKdTree<double>&       tree,
+                       const bool                               withNormals);
+
+protected:
+
+  /* Parameters */
+  double   m_fTol;           //!< Distance tolerance.
+  double   m_fAngTolDeg;     //!< Angular tolerance in degrees.
+  double   m_fClusterTol;    //!< Max distance between neighbors in a region.
+  int      m_iMinPoints;     //!< Min number of points in a primitive.
+  int      m_iTypes;         //!< Types of primitives to detect.
+  int      m_iNumNeighbors;  //!< Number of neighbors for normal estimation.
+  int      m_iNumCandidates; //!< Number of candidates per round.
+  int      m_iMaxFailures;   //!< Max number of unsuccessful rounds in a row.
+  unsigned m_iSeed;          //!< Random seed.
+  bool     m_bIsParallel;    //!< Whether to run in parallel mode.
+
+  /* Results */
+  Handle(asiAlgo_BaseCloud<double>) m_normals;    //!< Normals used for detection.
+  double                            m_fSpacing;   //!< Average spacing of points.
+  std::vector<t_primitive>          m_primitives; //!< Detected primitives.
+  std::vector<int>                  m_unassigned; //!< Points out of primitives.
+
+};
+
+#endif
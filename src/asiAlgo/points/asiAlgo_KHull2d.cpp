@@ -35,14 +35,12 @@
 #include <asiAlgo_PurifyCloud.h>
 
 // OCCT includes
-#include <GCE2d_MakeSegment.hxx>
-#include <Geom2d_TrimmedCurve.hxx>
-#include <Geom2dAPI_InterCurveCurve.hxx>
 #include <gp_Pnt2d.hxx>
-#include <NCollection_Vector.hxx>
+#include <Precision.hxx>
 
 // STL includes
 #include <algorithm>
+#include <utility>
 
 #undef DRAW_DEBUG
 #if defined DRAW_DEBUG
@@ -54,73 +52,65 @@
 // Instantiate for allowed types
 template class asiAlgo_KHull2d<gp_XY>;
 
-//-----------------------------------------------------------------------------
-// Custom data associated with each point in a cloud
 //-----------------------------------------------------------------------------
 
-//! Custom data associated with each point.
-struct t_point_data
+namespace
 {
-  t_point_data() : Dist(0.0), Idx(0) {}
-  t_point_data(const double _d, const int _i) : Dist(_d), Idx(_i) {}
-
-  double Dist; //!< Distance.
-  double Ang;  //!< Angle.
-  int    Idx;  //!< Zero-based index of point in the initial cloud.
-};
-
-//-----------------------------------------------------------------------------
+  //! Point index with a sorting key (distance or angle).
+  typedef std::pair<double, int> t_keyedPoint;
 
-//! Comparator for points by their associated distances.
-template <typename TPoint>
-class DistComparator
-{
-public:
+  //! Tolerance of link intersections. It is the default tolerance of
+  //! Geom2dAPI_InterCurveCurve used for this test formerly.
+  const double IntersectionTol = 1.0e-6;
 
-  DistComparator() = delete;
-  DistComparator& operator=(const DistComparator&) = delete;
-  DistComparator(const std::vector< asiAlgo_PointWithAttr<TPoint> >& points) : m_points(points) {}
-
-  bool operator()(const asiAlgo_PointWithAttr<TPoint>& left, const asiAlgo_PointWithAttr<TPoint>& right)
+  //! \return signed area of the triangle (A, B, C) doubled.
+  template <typename TPoint>
+  inline double Orient(const TPoint& A, const TPoint& B, const TPoint& C)
   {
-    const double l = (*((t_point_data*)(left.pData))).Dist;
-    const double r = (*((t_point_data*)(right.pData))).Dist;
-
-    return (l < r);
+    return (B - A) ^ (C - A);
   }
 
-public:
-
-  const std::vector< asiAlgo_PointWithAttr<TPoint> >& m_points; //!< Collection of points.
-
-};
-
-
-//-----------------------------------------------------------------------------
-
-//! Comparator for points by their associated angles.
-template <typename TPoint>
-class AngleComparator
-{
-public:
-
-  AngleComparator() = delete;
-  AngleComparator& operator=(const AngleComparator&) = delete;
-  AngleComparator(const std::vector< asiAlgo_PointWithAttr<TPoint> >& points) : m_points(points) {}
-
-  bool operator()(const asiAlgo_PointWithAttr<TPoint>& left, const asiAlgo_PointWithAttr<TPoint>& right)
+  //! \return squared distance from the point P to the segment (A, B).
+  template <typename TPoint>
+  inline double SquareDistToSegment(const TPoint& P, const TPoint& A, const TPoint& B)
   {
-    const double l = (*((t_point_data*)(left.pData))).Ang;
-    const double r = (*((t_point_data*)(right.pData))).Ang;
+    const TPoint AB  = B - A;
+    const double len = AB.SquareModulus();
+    //
+    if ( len < gp::Resolution() )
+      return (P - A).SquareModulus();
 
-    return (l < r);
+    const double t = Max( 0., Min( 1., (P - A)*AB / len ) );
+    //
+    return (P - (A + AB*t)).SquareModulus();
   }
 
-public:
-
-  const std::vector< asiAlgo_PointWithAttr<TPoint> >& m_points; //!< Collection of points.
+  //! Checks whether the segments (A1, A2) and (B1, B2) cross each other or
+  //! come closer than the given tolerance.
+  template <typename TPoint>
+  bool AreSegmentsIntersecting(const TPoint& A1, const TPoint& A2,
+                               const TPoint& B1, const TPoint& B2,
+                               const double  tol)
+  {
+    // Proper crossing.
+    const double o1 = Orient(A1, A2, B1);
+    const double o2 = Orient(A1, A2, B2);
+    const double o3 = Orient(B1, B2, A1);
+    const double o4 = Orient(B1, B2, A2);
+    //
+    if ( ( (o1 > 0 && o2 < 0) || (o1 < 0 && o2 > 0) ) &&
+         ( (o3 > 0 && o4 < 0) || (o3 < 0 && o4 > 0) ) )
+      return true;
 
-};
+    // Touching or overlapping segments.
+    const double tol2 = tol*tol;
+    //
+    return SquareDistToSegment(B1, A1, A2) <= tol2 ||
+           SquareDistToSegment(B2, A1, A2) <= tol2 ||
+           SquareDistToSegment(A1, B1, B2) <= tol2 ||
+           SquareDistToSegment(A2, B1, B2) <= tol2;
+  }
+}
 
 //-----------------------------------------------------------------------------
 
@@ -136,9 +126,11 @@ asiAlgo_KHull2d<TPoint>::asiAlgo_KHull2d(const Handle(asiAlgo_PointWithAttrCloud
   m_cloud       = cloud;
   m_iK          = k;
   m_iK_init     = k;
-  m_iK_limit    = 25; // We do not want to fall into stack overflow.
+  m_iK_limit    = 25; // Restarts with greater k make the hull coarser.
   m_iLimitIters = limitIters;
   m_iIterNum    = 0;
+  m_iStamp      = 0;
+  m_iWitness    = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -192,10 +184,41 @@ bool asiAlgo_KHull2d<TPoint>::Perform()
     return true;
   }
 
-  // Build hull.
-  Handle(asiAlgo_PointWithAttrCloud<TPoint>) dataset = this->copyCloud(m_cloud);
+  // The grid and the nearest points are kept for all attempts.
+  this->buildGrid();
   //
-  return this->perform(dataset);
+  m_neighbors.assign( nPoints, std::vector<int>() );
+  m_iWitness = 0;
+
+  // Build hull increasing k until the hull covers all points.
+  for ( ;; )
+  {
+    Handle(asiAlgo_PointWithAttrCloud<TPoint>) dataset = this->copyCloud(m_cloud);
+
+    bool isStuck = false;
+    //
+    if ( !this->perform(dataset, isStuck) )
+      return false;
+    //
+    if ( !isStuck )
+      return true;
+
+    // Increase k and try again.
+    const int prevK = m_iK;
+    //
+    m_iK = m_iK_init++ + 1;
+
+    // Check if we reached the limit in the number of consulted neighbors.
+    if ( m_iK > m_iK_limit )
+    {
+      m_progress.SendLogMessage(LogWarn(Normal) << "Value of K reached the limit.");
+      return true; // Let's return at least anything (result is normally not empty by this stage).
+    }
+
+    // Info.
+    m_progress.SendLogMessage(LogNotice(Normal) << "Incrementing K (%1 increased to %2)."
+                                                << prevK << m_iK);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -240,23 +263,25 @@ Handle(asiAlgo_PointWithAttrCloud<TPoint>)
 //-----------------------------------------------------------------------------
 
 template <typename TPoint>
-bool asiAlgo_KHull2d<TPoint>::perform(Handle(asiAlgo_PointWithAttrCloud<TPoint>)& dataset)
+bool asiAlgo_KHull2d<TPoint>::perform(Handle(asiAlgo_PointWithAttrCloud<TPoint>)& dataset,
+                                      bool&                                       isStuck)
 {
   // Make sure that k neighbors are available.
   m_iK = Min(m_iK, dataset->GetNumberOfElements() - 1);
 
-  // Check if we reached the limit in the number of consulted neighbors.
-  if ( m_iK > m_iK_limit )
-  {
-    m_progress.SendLogMessage(LogWarn(Normal) << "Value of K reached the limit.");
-    return true; // Let's return at least anything (result is normally not empty by this stage).
-  }
-
   // Start from beginning (with the new or initial K).
   if ( m_hull.IsNull() )
     m_hull = new asiAlgo_PointWithAttrCloud<TPoint>;
   else
     m_hull->Clear();
+  //
+  for ( size_t c = 0; c < m_linkCells.size(); ++c )
+    m_linkCells[c].clear();
+  //
+  for ( size_t r = 0; r < m_linkRows.size(); ++r )
+    m_linkRows[r].clear();
+  //
+  m_linkStamps.clear();
 
   /* ==================================
    *  Perform reconstruction of a hull
@@ -295,14 +320,7 @@ bool asiAlgo_KHull2d<TPoint>::perform(Handle(asiAlgo_PointWithAttrCloud<TPoint>)
     }
 
     // Check if all points are inside.
-    bool allInside = true;
-    int  j         = m_cloud->GetNumberOfElements();
-    while ( allInside && j )
-    {
-      --j;
-      allInside = this->isPointInPolygon(m_cloud->GetElement(j), m_hull);
-    }
-    if ( allInside )
+    if ( this->isCloudInHull() )
       return true;
 
     if ( step == 5 )
@@ -339,22 +357,15 @@ bool asiAlgo_KHull2d<TPoint>::perform(Handle(asiAlgo_PointWithAttrCloud<TPoint>)
       const asiAlgo_PointWithAttr<TPoint>& cPoint = dataset->GetElement(cPoint_index);
 
       // Check against the currently traversed path.
-      its = this->checkIntersections(currentPoint, cPoint, m_hull);
+      its = this->checkIntersections(currentPoint, cPoint);
     }
 
     if ( its ) // If there are some intersections, then we are in a trouble...
     {
-      // Increase k and try again.
-      const int prevK = m_iK;
-      //
-      m_iK = m_iK_init++ + 1;
-
-      // Info.
-      m_progress.SendLogMessage(LogNotice(Normal) << "Incrementing K because of intersections (%1 increased to %2)."
-                                                  << prevK << m_iK);
-
-      Handle(asiAlgo_PointWithAttrCloud<TPoint>) copyDS = this->copyCloud(m_cloud);
-      return this->perform(copyDS);
+      m_progress.SendLogMessage(LogNotice(Normal) << "Cannot proceed with K = %1 because of intersections."
+                                                  << m_iK);
+      isStuck = true;
+      return true;
     }
 
     if ( cPoint_index == firstPointIdx )
@@ -370,7 +381,7 @@ bool asiAlgo_KHull2d<TPoint>::perform(Handle(asiAlgo_PointWithAttrCloud<TPoint>)
     ++step;
 
     // Adjust working clouds.
-    this->addPoint(currentPoint, m_hull);
+    this->addLink( this->addPoint(currentPoint, m_hull) - 2 );
     this->removePoint(cPoint_index, dataset);
   }
 
@@ -378,31 +389,106 @@ bool asiAlgo_KHull2d<TPoint>::perform(Handle(asiAlgo_PointWithAttrCloud<TPoint>)
    *  Check that all points have been covered
    * ========================================= */
 
-  bool allInside = true;
-  int  i         = m_cloud->GetNumberOfElements();
-
-  while ( allInside && i )
+  if ( !this->isCloudInHull() ) // If there are some points still, then we are in a trouble...
   {
-    --i;
-    allInside = this->isPointInPolygon(m_cloud->GetElement(i), m_hull);
+    m_progress.SendLogMessage(LogNotice(Normal) << "Cannot proceed with K = %1 because of incomplete coverage."
+                                                << m_iK);
+    isStuck = true;
   }
 
-  if ( !allInside ) // If there are some points still, then we are in a trouble...
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TPoint>
+void asiAlgo_KHull2d<TPoint>::buildGrid()
+{
+  const int nPoints = m_cloud->GetNumberOfElements();
+
+  // Bounding box.
+  double xMin = RealLast(), yMin = RealLast(), xMax = -RealLast(), yMax = -RealLast();
+  //
+  for ( int idx = 0; idx < nPoints; ++idx )
   {
-    // Increase k and try again.
-    const int prevK = m_iK;
+    const TPoint& P = m_cloud->GetElement(idx).Coord;
     //
-    m_iK = m_iK_init++ + 1;
+    xMin = Min( xMin, P.X() ); xMax = Max( xMax, P.X() );
+    yMin = Min( yMin, P.Y() ); yMax = Max( yMax, P.Y() );
+  }
 
-    // Info.
-    m_progress.SendLogMessage(LogNotice(Normal) << "Incrementing K because of incomplete coverage (%1 increased to %2)."
-                                                << prevK << m_iK);
+  // Choose the cell size to have about two points per cell. For the points
+  // lying on a line, the cells are taken along that line.
+  const double width  = xMax - xMin;
+  const double height = yMax - yMin;
+  //
+  double cellSize = Sqrt(2.*width*height/nPoints);
+  //
+  if ( cellSize < Max(width, height)/nPoints )
+    cellSize = 2.*Max(width, height)/nPoints;
+  //
+  cellSize = Max( cellSize, Precision::Confusion() );
+
+  m_grid.MinX     = xMin;
+  m_grid.MinY     = yMin;
+  m_grid.CellSize = cellSize;
+  m_grid.NumX     = int(width/cellSize) + 1;
+  m_grid.NumY     = int(height/cellSize) + 1;
 
-    Handle(asiAlgo_PointWithAttrCloud<TPoint>) copyDS = this->copyCloud(m_cloud);
-    return this->perform(copyDS);
+  // Distribute points over the cells.
+  const int numCells = m_grid.NumX*m_grid.NumY;
+  //
+  std::vector<int> cellIds(nPoints);
+  //
+  m_grid.CellOffsets.assign(numCells + 1, 0);
+  //
+  for ( int idx = 0; idx < nPoints; ++idx )
+  {
+    const TPoint& P = m_cloud->GetElement(idx).Coord;
+    //
+    cellIds[idx] = m_grid.CellY( P.Y() )*m_grid.NumX + m_grid.CellX( P.X() );
+    m_grid.CellOffsets[cellIds[idx] + 1]++;
   }
+  //
+  for ( int c = 0; c < numCells; ++c )
+    m_grid.CellOffsets[c + 1] += m_grid.CellOffsets[c];
+
+  std::vector<int> cursors( m_grid.CellOffsets.begin(), m_grid.CellOffsets.end() - 1 );
+  //
+  m_grid.CellPoints.resize(nPoints);
+  //
+  for ( int idx = 0; idx < nPoints; ++idx )
+    m_grid.CellPoints[cursors[cellIds[idx]]++] = idx;
+
+  m_linkCells.assign( numCells, std::vector<int>() );
+  m_linkRows.assign( m_grid.NumY, std::vector<int>() );
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename TPoint>
+void asiAlgo_KHull2d<TPoint>::addLink(const int linkIdx)
+{
+  const TPoint& P1 = m_hull->GetElement(linkIdx).Coord;
+  const TPoint& P2 = m_hull->GetElement(linkIdx + 1).Coord;
+
+  m_linkStamps.push_back(0);
 
-  return true; // Success.
+  // Rows are extended to catch the points lying on the horizontal links.
+  const double eps = Precision::Confusion();
+  //
+  const int x1 = m_grid.CellX( Min( P1.X(), P2.X() ) );
+  const int x2 = m_grid.CellX( Max( P1.X(), P2.X() ) );
+  const int y1 = m_grid.CellY( Min( P1.Y(), P2.Y() ) - eps );
+  const int y2 = m_grid.CellY( Max( P1.Y(), P2.Y() ) + eps );
+  //
+  for ( int y = y1; y <= y2; ++y )
+  {
+    m_linkRows[y].push_back(linkIdx);
+
+    for ( int x = x1; x <= x2; ++x )
+      m_linkCells[y*m_grid.NumX + x].push_back(linkIdx);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -461,95 +547,158 @@ std::vector<int>
                                          int&                                        k,
                                          Handle(asiAlgo_PointWithAttrCloud<TPoint>)& cloud)
 {
-  // WARNING: currently implemented approach is suboptimal
+  const int nPoints = cloud->GetNumberOfElements();
 
-  // Access seed point.
-  const asiAlgo_PointWithAttr<TPoint>& S = cloud->GetElement(point_idx);
+  // The cached list contains the nearest points regardless of their status.
+  // It is extended only if there are not enough of the unprocessed points.
+  std::vector<int>& cached = m_neighbors[point_idx];
+  std::vector<int>  res;
+  //
+  for ( ;; )
+  {
+    res.clear();
+    //
+    for ( size_t i = 0; i < cached.size() && int( res.size() ) < k; ++i )
+    {
+      if ( cloud->GetElement(cached[i]).Status > 0 ) // Signaled state (i.e., removed point) -> skip.
+        continue;
 
-  /* =====================================
-   *  Build distance field for each point
-   * ===================================== */
+      res.push_back(cached[i]);
+    }
+    //
+    if ( int( res.size() ) == k || int( cached.size() ) == nPoints - 1 )
+      break;
 
-  // Fill collections to use sorting.
-  std::vector< asiAlgo_PointWithAttr<TPoint> > PointRefs;
+    this->collectNearestPoints( point_idx,
+                                Min( nPoints - 1, Max( 2*int( cached.size() ), 4*k ) ),
+                                cached );
+  }
 
-  // Calculate Euclidian distances for all points.
-  const int nPoints = cloud->GetNumberOfElements();
-  for ( int idx = 0; idx < nPoints; ++idx )
-  {
-    if ( idx == point_idx )
-      continue;
+  k = Min( k, int( res.size() ) );
 
-    asiAlgo_PointWithAttr<TPoint>& P = cloud->ChangeElement(idx);
+  return res;
+}
 
-    if ( P.Status > 0 ) // Signaled state (i.e., removed point) -> skip.
-      continue;
+//-----------------------------------------------------------------------------
 
-    // Calculate Euclidian distance.
-    const double dist2 = (P.Coord - S.Coord).SquareModulus();
+template <typename TPoint>
+void asiAlgo_KHull2d<TPoint>::collectNearestPoints(const int         point_idx,
+                                                   const int         num,
+                                                   std::vector<int>& res) const
+{
+  const TPoint& S  = m_cloud->GetElement(point_idx).Coord;
+  const int     cx = m_grid.CellX( S.X() );
+  const int     cy = m_grid.CellY( S.Y() );
+
+  // Visit the rings of cells around the point. The points outside the ring
+  // of radius r are farther than (r - 1) cells from the point, so the search
+  // stops once the required number of points is found within this distance.
+  std::vector<t_keyedPoint> candidates;
+  //
+  const int maxRing = Max(m_grid.NumX, m_grid.NumY);
+  //
+  for ( int r = 0; r <= maxRing; ++r )
+  {
+    for ( int y = cy - r; y <= cy + r; ++y )
+    {
+      if ( y < 0 || y >= m_grid.NumY )
+        continue;
 
-    if ( !P.pData )
-      P.pData = new t_point_data;
+      const bool isBorderRow = (y == cy - r) || (y == cy + r);
+
+      for ( int x = cx - r; x <= cx + r; x += ( isBorderRow ? 1 : 2*r ) )
+      {
+        if ( x >= 0 && x < m_grid.NumX )
+        {
+          const int cell = y*m_grid.NumX + x;
+          //
+          for ( int j = m_grid.CellOffsets[cell]; j < m_grid.CellOffsets[cell + 1]; ++j )
+          {
+            const int idx = m_grid.CellPoints[j];
+            //
+            if ( idx != point_idx )
+              candidates.push_back( t_keyedPoint( (m_cloud->GetElement(idx).Coord - S).SquareModulus(), idx ) );
+          }
+        }
+
+        if ( r == 0 )
+          break;
+      }
+    }
 
-    (*( (t_point_data*) (P.pData) )).Dist = dist2;
-    (*( (t_point_data*) (P.pData) )).Idx  = idx;
+    if ( int( candidates.size() ) < num )
+      continue;
 
-    PointRefs.push_back(P);
-  }
+    std::nth_element( candidates.begin(), candidates.begin() + (num - 1), candidates.end() );
 
-  /* ===========================================
-   *  Sort points by their associated distances
-   * =========================================== */
+    const double reach = r*m_grid.CellSize;
+    //
+    if ( candidates[num - 1].first <= reach*reach )
+      break;
+  }
 
   // Sort points by distance.
-  std::sort( PointRefs.begin(), PointRefs.end(), DistComparator<TPoint>(PointRefs) );
+  const int numRes = Min( num, int( candidates.size() ) );
+  //
+  std::partial_sort( candidates.begin(), candidates.begin() + numRes, candidates.end() );
 
-  k = Min( k, int( PointRefs.size() ) );
+  res.resize(numRes);
+  //
+  for ( int i = 0; i < numRes; ++i )
+    res[i] = candidates[i].second;
+}
 
-  std::vector<int> res;
-  for ( int i = 0; i < k; ++i )
-  {
-    const int idx = (*( (t_point_data*) (PointRefs[i].pData) )).Idx;
-    res.push_back(idx);
-  }
+//-----------------------------------------------------------------------------
 
-  /* ======================
-   *  Finalize calculation
-   * ====================== */
+template <typename TPoint>
+bool asiAlgo_KHull2d<TPoint>::isCloudInHull()
+{
+  // Start from the point which was outside the hull last time as it is
+  // likely to remain outside.
+  if ( !this->isPointInHull( m_cloud->GetElement(m_iWitness) ) )
+    return false;
 
-  // Release allocated heap memory.
-  for ( int idx = 0; idx < cloud->GetNumberOfElements(); ++idx )
+  for ( int j = m_cloud->GetNumberOfElements() - 1; j >= 0; --j )
   {
-    asiAlgo_PointWithAttr<TPoint>& P = cloud->ChangeElement(idx);
-    delete P.pData; P.pData = nullptr;
+    if ( j != m_iWitness && !this->isPointInHull( m_cloud->GetElement(j) ) )
+    {
+      m_iWitness = j;
+      return false;
+    }
   }
 
-  return res;
+  return true;
 }
 
 //-----------------------------------------------------------------------------
 
 template <typename TPoint>
-bool asiAlgo_KHull2d<TPoint>::isPointInPolygon(const asiAlgo_PointWithAttr<TPoint>&              point,
-                                               const Handle(asiAlgo_PointWithAttrCloud<TPoint>)& poly) const
+bool asiAlgo_KHull2d<TPoint>::isPointInHull(const asiAlgo_PointWithAttr<TPoint>& point) const
 {
   // Working variables.
   const double x      = point.Coord.X();
   const double y      = point.Coord.Y();
-  const int    nVerts = poly->GetNumberOfElements();
+  const int    nVerts = m_hull->GetNumberOfElements();
   bool         sign   = false;
   const double eps    = gp::Resolution();
 
-  // Loop over the polygon vertices.
-  for ( int i = 0; i < nVerts; ++i )
+  // Only the links of the row containing the point can be crossed by
+  // the horizontal ray. The closing link is not hashed as it changes
+  // with each new vertex.
+  const std::vector<int>& rowLinks = m_linkRows[m_grid.CellY(y)];
+
+  // Loop over the polygon links.
+  for ( int k = 0; k <= int( rowLinks.size() ); ++k )
   {
     // Access next segment of the polygon.
+    const int     i  = ( ( k == int( rowLinks.size() ) ) ? nVerts - 1 : rowLinks[k] );
     const int     j  = ((i == nVerts - 1) ? 0 : i + 1);
-    const TPoint& Pi = poly->GetElement(i).Coord;
-    const TPoint& Pj = poly->GetElement(j).Coord;
+    const TPoint& Pi = m_hull->GetElement(i).Coord;
+    const TPoint& Pj = m_hull->GetElement(j).Coord;
 
     // Check if sample point is coincident with pole.
-    if ( (point.Coord - Pi).SquareModulus() < eps )
+    if ( (point.Coord - Pi).SquareModulus() < eps ||
+         (point.Coord - Pj).SquareModulus() < eps )
       return true;
 
     // Coordinates of poles.
@@ -586,47 +735,62 @@ bool asiAlgo_KHull2d<TPoint>::isPointInPolygon(const asiAlgo_PointWithAttr<TPoin
 //-----------------------------------------------------------------------------
 
 template <typename TPoint>
-bool asiAlgo_KHull2d<TPoint>::checkIntersections(const asiAlgo_PointWithAttr<TPoint>&              P1,
-                                                 const asiAlgo_PointWithAttr<TPoint>&              P2,
-                                                 const Handle(asiAlgo_PointWithAttrCloud<TPoint>)& poly) const
+bool asiAlgo_KHull2d<TPoint>::checkIntersections(const asiAlgo_PointWithAttr<TPoint>& P1,
+                                                 const asiAlgo_PointWithAttr<TPoint>& P2)
 {
   const double eps = gp::Resolution();
 
   // Number of vertices.
-  const int nVerts = poly->GetNumberOfElements();
+  const int nVerts = m_hull->GetNumberOfElements();
   //
   if ( nVerts <= 1 )
     return false; // There cannot be intersection with just one point.
 
-  // Create OCCT segment for (P1,P2).
-  Handle(Geom2d_TrimmedCurve) L = GCE2d_MakeSegment(P1.Coord, P2.Coord);
-
-  // Loop over the polygon vertices.
-  for ( int i = 0; i < nVerts; ++i )
+  // The closing link always shares the vertex P1, so only the hashed links
+  // from the cells around the link (P1, P2) are checked.
+  const int x1 = m_grid.CellX( Min( P1.Coord.X(), P2.Coord.X() ) - IntersectionTol );
+  const int x2 = m_grid.CellX( Max( P1.Coord.X(), P2.Coord.X() ) + IntersectionTol );
+  const int y1 = m_grid.CellY( Min( P1.Coord.Y(), P2.Coord.Y() ) - IntersectionTol );
+  const int y2 = m_grid.CellY( Max( P1.Coord.Y(), P2.Coord.Y() ) + IntersectionTol );
+  //
+  m_iStamp++;
+  //
+  for ( int y = y1; y <= y2; ++y )
   {
-    // Access next segment of the polygon.
-    const int     j  = ((i == nVerts - 1) ? 0 : i + 1);
-    const TPoint& Pi = poly->GetElement(i).Coord;
-    const TPoint& Pj = poly->GetElement(j).Coord;
-
-    if ( (P1.Coord - Pi).SquareModulus() < eps ||
-         (P1.Coord - Pj).SquareModulus() < eps ||
-         (P2.Coord - Pi).SquareModulus() < eps ||
-         (P2.Coord - Pj).SquareModulus() < eps )
-      continue; // No intersection can happen with adjacent segments.
-
-    // Create OCCT segment for link.
-    Handle(Geom2d_TrimmedCurve) LL = GCE2d_MakeSegment(Pi, Pj);
-
-    // Check for intersections.
-    Geom2dAPI_InterCurveCurve IntCC(L, LL);
-    if ( IntCC.NbPoints() )
+    for ( int x = x1; x <= x2; ++x )
     {
+      const std::vector<int>& cellLinks = m_linkCells[y*m_grid.NumX + x];
+      //
+      for ( size_t k = 0; k < cellLinks.size(); ++k )
+      {
+        const int i = cellLinks[k];
+
+        // Each link is checked once.
+        if ( m_linkStamps[i] == m_iStamp )
+          continue;
+        //
+        m_linkStamps[i] = m_iStamp;
+
+        // Access next segment of the polygon.
+        const TPoint& Pi = m_hull->GetElement(i).Coord;
+        const TPoint& Pj = m_hull->GetElement(i + 1).Coord;
+
+        if ( (P1.Coord - Pi).SquareModulus() < eps ||
+             (P1.Coord - Pj).SquareModulus() < eps ||
+             (P2.Coord - Pi).SquareModulus() < eps ||
+             (P2.Coord - Pj).SquareModulus() < eps )
+          continue; // No intersection can happen with adjacent segments.
+
+        // Check for intersections.
+        if ( this->areLinksIntersecting(P1.Coord, P2.Coord, Pi, Pj) )
+        {
 #if defined DRAW_DEBUG
-      m_plotter.DRAW_LINK(P1.Coord, P2.Coord, Color_Red, "ilink_a");
-      m_plotter.DRAW_LINK(Pi,       Pj,       Color_Red, "ilink_b");
+          m_plotter.DRAW_LINK(P1.Coord, P2.Coord, Color_Red, "ilink_a");
+          m_plotter.DRAW_LINK(Pi,       Pj,       Color_Red, "ilink_b");
 #endif
-      return true;
+          return true;
+        }
+      }
     }
   }
 
@@ -635,6 +799,16 @@ bool asiAlgo_KHull2d<TPoint>::checkIntersections(const asiAlgo_PointWithAttr<TPo
 
 //-----------------------------------------------------------------------------
 
+template <typename TPoint>
+bool asiAlgo_KHull2d<TPoint>::areLinksIntersecting(const TPoint& A1,
+                                                   const TPoint& A2,
+                                                   const TPoint& B1,
+                                                   const TPoint& B2) const
+{
+  return AreSegmentsIntersecting(A1, A2, B1, B2, IntersectionTol);
+}
+//-----------------------------------------------------------------------------
+
 template <typename TPoint>
 std::vector<int>
   asiAlgo_KHull2d<TPoint>::sortByAngle(const std::vector<int>&                           point_indices,
@@ -655,16 +829,16 @@ std::vector<int>
    *  Calculate angles between links
    * ================================ */
 
-  // Prepare collections for sorting.
-  std::vector< asiAlgo_PointWithAttr<TPoint> > PointRefs;
+  // Prepare collection for sorting.
+  std::vector<t_keyedPoint> PointRefs;
 
   // Loop over the candidate links.
   for ( int i = 0; i < int( point_indices.size() ); ++i )
   {
     // Next candidate link.
-    const int                      next_idx = point_indices.at(i);
-    asiAlgo_PointWithAttr<TPoint>& P        = dataset->ChangeElement(next_idx);
-    gp_Dir2d                       PNext    = P.Coord - PLast;
+    const int                            next_idx = point_indices.at(i);
+    const asiAlgo_PointWithAttr<TPoint>& P        = dataset->GetElement(next_idx);
+    gp_Dir2d                             PNext    = P.Coord - PLast;
 
     // Check angle.
     double ang = gp_Vec2d(PNext).Angle(seedDir);
@@ -675,15 +849,7 @@ std::vector<int>
       ang += 2*M_PI;
 
     if ( ang > 0 )
-    {
-      if ( !P.pData )
-        P.pData = new t_point_data;
-
-      (*( (t_point_data*) (P.pData) )).Ang = ang;
-      (*( (t_point_data*) (P.pData) )).Idx = next_idx;
-
-      PointRefs.push_back(P);
-    }
+      PointRefs.push_back( t_keyedPoint(ang, next_idx) );
   }
 
   /* ========================================
@@ -691,25 +857,11 @@ std::vector<int>
    * ======================================== */
 
   // Sort points by angles.
-  std::sort( PointRefs.begin(), PointRefs.end(), AngleComparator<TPoint>(PointRefs) );
+  std::sort( PointRefs.begin(), PointRefs.end() );
 
   std::vector<int> res;
   for ( int i = 0; i < int( PointRefs.size() ); ++i ) // TODO: the order depends on orientation (!)
-  {
-    const int idx = (*( (t_point_data*) (PointRefs[i].pData) )).Idx;
-    res.push_back( (int) idx );
-  }
-
-  /* ======================
-   *  Finalize calculation
-   * ====================== */
-
-  // Release allocated heap memory.
-  for ( int idx = 0; idx < int( point_indices.size() ); ++idx )
-  {
-    asiAlgo_PointWithAttr<TPoint>& P = dataset->ChangeElement(idx);
-    delete P.pData; P.pData = nullptr;
-  }
+    res.push_back(PointRefs[i].second);
 
   return res;
 }
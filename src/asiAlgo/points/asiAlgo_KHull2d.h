@@ -40,6 +40,9 @@
 // OCCT includes
 #include <TColStd_HSequenceOfInteger.hxx>
 
+// Standard includes
+#include <vector>
+
 //-----------------------------------------------------------------------------
 
 //! Algorithm computing a non-convex hull of two-dimensional point cloud
@@ -57,6 +60,12 @@
 //! demonstrates quite good results on many cases, especially, if the
 //! cloud density is not very high.
 //!
+//! The points are indexed in a uniform grid, so the nearest neighbors are
+//! looked up in the cells around the current point. The neighbor lists are
+//! cached and reused when the algorithm restarts with greater k. The links
+//! of the growing hull are hashed in the same grid, so the intersection and
+//! inclusion tests consult only the links passing nearby.
+//!
 //! NOTE: there are infinite solutions for the problem of reconstruction of
 //!       con-convex hulls. This one should not be suggested as the best one.
 //!       It implements just one (quite simple) solution from a big variety
@@ -129,9 +138,22 @@ protected:
 
   //! Performs actual reconstruction of non-convex hull.
   //! \param[in,out] dataset working cloud.
+  //! \param[out]    isStuck indicates whether the reconstruction has to be
+  //!                        restarted with greater k.
   //! \return true in case of success, false -- otherwise.
   asiAlgo_EXPORT bool
-    perform(Handle(asiAlgo_PointWithAttrCloud<TPoint>)& dataset);
+    perform(Handle(asiAlgo_PointWithAttrCloud<TPoint>)& dataset,
+            bool&                                       isStuck);
+
+  //! Distributes the points of the initial cloud over the grid cells.
+  asiAlgo_EXPORT void
+    buildGrid();
+
+  //! Adds the hull link starting at the given hull vertex to the spatial
+  //! hash of links.
+  //! \param[in] linkIdx zero-based index of the link.
+  asiAlgo_EXPORT void
+    addLink(const int linkIdx);
 
   //! Selects a point with minimal Y coordinate.
   //! \param[out] point     found point.
@@ -168,24 +190,48 @@ protected:
                   int&                                        k,
                   Handle(asiAlgo_PointWithAttrCloud<TPoint>)& cloud);
 
-  //! Checks whether the passed point belongs to the interior of the given
-  //! polygon. This check is performed using simplest ray casting method.
+  //! Collects the given number of points of the initial cloud which are
+  //! nearest to the given one, regardless of their status.
+  //! \param[in]  point_idx 0-based index of the point to find neighbors for.
+  //! \param[in]  num       number of points to collect.
+  //! \param[out] res       indices of the nearest points sorted by distance.
+  asiAlgo_EXPORT void
+    collectNearestPoints(const int         point_idx,
+                         const int         num,
+                         std::vector<int>& res) const;
+
+  //! Checks whether all points of the initial cloud are inside the hull.
+  //! \return true/false.
+  asiAlgo_EXPORT bool
+    isCloudInHull();
+
+  //! Checks whether the passed point belongs to the interior of the hull.
+  //! This check is performed using simplest ray casting method.
   //! \param[in] point point to check.
-  //! \param[in] poly  target polygon to check the point against.
   //! \return true if the point is inside, false -- otherwise.
   asiAlgo_EXPORT bool
-    isPointInPolygon(const asiAlgo_PointWithAttr<TPoint>&              point,
-                     const Handle(asiAlgo_PointWithAttrCloud<TPoint>)& poly) const;
+    isPointInHull(const asiAlgo_PointWithAttr<TPoint>& point) const;
 
-  //! Checks whether the passed link intersects the given polygon.
-  //! \param[in] P1   first point of the link.
-  //! \param[in] P2   second point of the link.
-  //! \param[in] poly polygon to check for intersections with.
+  //! Checks whether the passed link intersects the hull.
+  //! \param[in] P1 first point of the link.
+  //! \param[in] P2 second point of the link.
   //! \return true/false.
   asiAlgo_EXPORT bool
-    checkIntersections(const asiAlgo_PointWithAttr<TPoint>&              P1,
-                       const asiAlgo_PointWithAttr<TPoint>&              P2,
-                       const Handle(asiAlgo_PointWithAttrCloud<TPoint>)& poly) const;
+    checkIntersections(const asiAlgo_PointWithAttr<TPoint>& P1,
+                       const asiAlgo_PointWithAttr<TPoint>& P2);
+
+  //! Checks whether the links (A1, A2) and (B1, B2) cross each other or
+  //! come closer than the intersection tolerance.
+  //! \param[in] A1 first point of the first link.
+  //! \param[in] A2 second point of the first link.
+  //! \param[in] B1 first point of the second link.
+  //! \param[in] B2 second point of the second link.
+  //! \return true/false.
+  asiAlgo_EXPORT virtual bool
+    areLinksIntersecting(const TPoint& A1,
+                         const TPoint& A2,
+                         const TPoint& B1,
+                         const TPoint& B2) const;
 
   //! Starting from the last link of the resulting polygon, checks the angles
   //! between this link and each point from the given list. The points in the
@@ -200,6 +246,34 @@ protected:
                 Handle(asiAlgo_PointWithAttrCloud<TPoint>)&       dataset,
                 const Handle(asiAlgo_PointWithAttrCloud<TPoint>)& poly) const;
 
+protected:
+
+  //! Uniform grid over the initial cloud.
+  struct t_grid
+  {
+    double           MinX;        //!< Min X coordinate.
+    double           MinY;        //!< Min Y coordinate.
+    double           CellSize;    //!< Size of a cell.
+    int              NumX;        //!< Number of cells along X.
+    int              NumY;        //!< Number of cells along Y.
+    std::vector<int> CellOffsets; //!< Offsets of the points by cells.
+    std::vector<int> CellPoints;  //!< Points sorted by cells.
+
+    t_grid() : MinX(0.), MinY(0.), CellSize(1.), NumX(0), NumY(0) {} //!< Ctor.
+
+    //! \return column of the cell containing the given X coordinate.
+    int CellX(const double x) const
+    {
+      return Max( 0, Min( NumX - 1, int( (x - MinX) / CellSize ) ) );
+    }
+
+    //! \return row of the cell containing the given Y coordinate.
+    int CellY(const double y) const
+    {
+      return Max( 0, Min( NumY - 1, int( (y - MinY) / CellSize ) ) );
+    }
+  };
+
 private:
 
   int                                        m_iK;          //!< Number of neighbors to consult.
@@ -209,6 +283,13 @@ private:
   int                                        m_iIterNum;    //!< Current iteration number.
   Handle(asiAlgo_PointWithAttrCloud<TPoint>) m_cloud;       //!< Initial cloud.
   Handle(asiAlgo_PointWithAttrCloud<TPoint>) m_hull;        //!< Resulting hull.
+  t_grid                                     m_grid;        //!< Grid of the initial cloud.
+  std::vector< std::vector<int> >            m_neighbors;   //!< Cached nearest points.
+  std::vector< std::vector<int> >            m_linkCells;   //!< Hull links by grid cells.
+  std::vector< std::vector<int> >            m_linkRows;    //!< Hull links by grid rows.
+  std::vector<int>                           m_linkStamps;  //!< Last queries visiting the links.
+  int                                        m_iStamp;      //!< Current query.
+  int                                        m_iWitness;    //!< Last point found outside the hull.
 
 };
 
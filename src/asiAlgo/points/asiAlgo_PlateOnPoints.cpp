@@ -32,6 +32,7 @@
 #include <asiAlgo_PlateOnPoints.h>
 
 // asiAlgo includes
+#include <asiAlgo_ApproxBSurf.h>
 #include <asiAlgo_PlaneOnPoints.h>
 #include <asiAlgo_Timer.h>
 
@@ -41,6 +42,20 @@
 #include <GeomPlate_MakeApprox.hxx>
 #include <GeomPlate_PlateG0Criterion.hxx>
 
+// Standard includes
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Max number of poles in each direction for the least squares
+  //! approximation.
+  const int MaxNumApproxPoles = 50;
+}
+
+//-----------------------------------------------------------------------------
+
 #undef COUT_DEBUG
 #if defined COUT_DEBUG
   #pragma message("===== warning: COUT_DEBUG is enabled")
@@ -53,12 +68,15 @@
 //! \param plotter  [in] imperative plotter.
 asiAlgo_PlateOnPoints::asiAlgo_PlateOnPoints(ActAPI_ProgressEntry progress,
                                              ActAPI_PlotterEntry  plotter)
-: ActAPI_IAlgorithm(progress, plotter)
+: ActAPI_IAlgorithm    (progress, plotter),
+  m_iMaxNumPlatePoints (0)
 {}
 
 //-----------------------------------------------------------------------------
 
 //! Constructs TPS (Thin Plate Spline) approximation for the passed points.
+//! If the max number of points for plating is set and exceeded, the points
+//! are fitted with a least squares B-surface instead.
 //! \param points [in]  point set to build the approximation surface for.
 //! \param result [out] approximation surface.
 //! \return true in case of success, false -- otherwise.
@@ -66,6 +84,38 @@ bool asiAlgo_PlateOnPoints::Perform(const std::vector<gp_XYZ>&   points,
                                     Handle(Geom_BSplineSurface)& result)
 {
   const int    Degree      = 3;
+
+  /* ===========================================
+   *  Approximate dense point sets by fitting
+   * =========================================== */
+
+  if ( m_iMaxNumPlatePoints > 0 && int( points.size() ) > m_iMaxNumPlatePoints )
+  {
+    m_progress.SendLogMessage( LogNotice(Normal) << "%1 points exceed the plating limit of %2 points: "
+                                                    "fitting the points in the least squares sense."
+                                                 << int( points.size() ) << m_iMaxNumPlatePoints );
+
+    Handle(asiAlgo_BaseCloud<double>) cloud = new asiAlgo_BaseCloud<double>;
+    //
+    for ( size_t k = 0; k < points.size(); ++k )
+      cloud->AddElement(points[k]);
+
+    // About 16 points per span keep the fitting well-posed.
+    const int numPoles = std::min( MaxNumApproxPoles,
+                                   int( Sqrt( double( points.size() ) / 16. ) ) + Degree );
+
+    asiAlgo_ApproxBSurf approx(cloud, m_progress, m_plotter);
+    //
+    if ( !approx.Perform(Degree, Degree, numPoles, numPoles) )
+    {
+      m_progress.SendLogMessage(LogErr(Normal) << "Cannot approximate points");
+      return false;
+    }
+
+    result = approx.GetResult();
+    return true;
+  }
+
   const int    NbPtsOnCur  = 10;
   const int    NbIter      = 3;
   const double Tol2d       = 0.00001;
@@ -62,6 +62,29 @@ public:
     Perform(const std::vector<gp_XYZ>&   points,
             Handle(Geom_BSplineSurface)& result);
 
+public:
+
+  //! Sets the max number of points for plating. Each point gives a
+  //! constraint to the plate, and the plate solver scales poorly with the
+  //! number of constraints. Denser point sets are fitted with a least
+  //! squares B-surface instead. The default value of zero means that the
+  //! points are always plated.
+  //! \param[in] numPts max number of points to plate.
+  void SetMaxNumPlatePoints(const int numPts)
+  {
+    m_iMaxNumPlatePoints = numPts;
+  }
+
+  //! \return max number of points for plating (zero for no limit).
+  int GetMaxNumPlatePoints() const
+  {
+    return m_iMaxNumPlatePoints;
+  }
+
+protected:
+
+  int m_iMaxNumPlatePoints; //!< Max number of points to plate.
+
 };
 
 #endif
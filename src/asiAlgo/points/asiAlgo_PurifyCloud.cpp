@@ -0,0 +1,867 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_PurifyCloud.h>
+
+// asiAlgo includes
+#include <asiAlgo_Timer.h>
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of points in a block of data processed by a single task.
+  const int BlockSize = 4096;
+
+  //! Number of bits in a radix sort digit.
+  const int RadixBits = 8;
+
+  //! Number of buckets in a radix sort pass.
+  const int RadixSize = 1 << RadixBits;
+
+  //! States of points in the elimination order.
+  enum t_state
+  {
+    State_Undecided = 0, //!< Not yet known.
+    State_Kept,          //!< Point is traversed by the cell filter.
+    State_Eliminated     //!< Point is purged by a preceding kept point.
+  };
+
+  //! Computes the index of the cell containing the passed coordinate in
+  //! exactly the same way as NCollection_CellFilter does, i.e., by
+  //! truncation toward zero.
+  //! \param[in]  coord    coordinate.
+  //! \param[in]  cellSize cell size.
+  //! \param[out] idx      cell index.
+  //! \return false if the cell filter would wrap the index around.
+  inline bool CellIndex(const double coord,
+                        const double cellSize,
+                        int&         idx)
+  {
+    const double val = coord / cellSize;
+    //
+    if ( !(val <= INT_MAX - 1 && val >= INT_MIN + 1) )
+      return false;
+
+    idx = int(val);
+    return true;
+  }
+
+  //! Shared data of the voxel hashing.
+  struct t_voxelHash
+  {
+    const double*                    Coords;    //!< Source coordinates.
+    int                              NumPts;    //!< Number of source points.
+    double                           Tol;       //!< Purification tolerance.
+    double                           Conf;      //!< Inspection shift.
+    int                              Reach;     //!< Neighborhood radius in cells.
+    int                              Min[3];    //!< Min cell indices.
+    int                              Max[3];    //!< Max cell indices.
+    int                              Shift[3];  //!< Bit shifts of the axes in a key.
+    std::vector<int>                 Cells;     //!< Cell indices of points.
+    std::vector<uint64_t>            Keys;      //!< Sorted keys of points.
+    std::vector<int>                 Order;     //!< Point indices sorted by keys.
+    std::vector<uint64_t>            CellKeys;  //!< Unique keys of occupied cells.
+    std::vector<int>                 CellFirst; //!< Offsets of cells in Order.
+    std::vector<unsigned char>       Purged;    //!< Kept points purged afterwards.
+    std::atomic<unsigned char>*      States;    //!< Elimination states.
+
+    //! Packs the cell indices to a key. The indices should be in range.
+    uint64_t Key(const int i, const int j, const int k) const
+    {
+      return ( uint64_t( int64_t(i) - Min[0] ) << Shift[0] )
+           | ( uint64_t( int64_t(j) - Min[1] ) << Shift[1] )
+           | ( uint64_t( int64_t(k) - Min[2] ) << Shift[2] );
+    }
+
+    //! Finds the occupied cell by its key.
+    //! \return 0-based index of the cell or -1 if the cell is empty.
+    int FindCell(const uint64_t key) const
+    {
+      int lo = 0, hi = int( CellKeys.size() );
+      while ( lo < hi )
+      {
+        const int mid = lo + (hi - lo)/2;
+        if ( CellKeys[mid] < key )
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      return ( lo < int( CellKeys.size() ) && CellKeys[lo] == key ) ? lo : -1;
+    }
+
+    //! Checks whether the cell of the point `v` belongs to the inspection
+    //! range of the point `u`, i.e., whether `u` can ever purge `v`.
+    bool Sees(const int u, const int v) const
+    {
+      for ( int a = 0; a < 3; ++a )
+      {
+        const double c = Coords[3*u + a];
+        int lo, hi;
+        CellIndex(c - Conf, Tol, lo);
+        CellIndex(c + Conf, Tol, hi);
+        //
+        const int cv = Cells[3*v + a];
+        if ( cv < lo || cv > hi )
+          return false;
+      }
+      return true;
+    }
+
+    //! Checks whether the points are coincident with the tolerance.
+    bool IsClose(const int u, const int v) const
+    {
+      const double dx = Coords[3*u]     - Coords[3*v];
+      const double dy = Coords[3*u + 1] - Coords[3*v + 1];
+      const double dz = Coords[3*u + 2] - Coords[3*v + 2];
+      //
+      return std::sqrt(dx*dx + dy*dy + dz*dz) < Tol;
+    }
+
+    //! Checks whether `u` is a purging candidate for `v`.
+    bool Purges(const int u, const int v) const
+    {
+      return this->Sees(u, v) && this->IsClose(u, v);
+    }
+
+    //! \return state of the given point.
+    unsigned char State(const int i) const
+    {
+      // Decisions are final, so there is no need for strict ordering.
+      return States[i].load(std::memory_order_relaxed);
+    }
+  };
+
+  //---------------------------------------------------------------------------
+
+  //! Base class for the functors processing the blocks of data.
+  template <typename TFunctor>
+  class BlockFunctor
+  {
+  public:
+
+    //! Runs the functor on the given number of blocks.
+    static void Run(const TFunctor& func,
+                    const int       numBlocks,
+                    const bool      isParallel)
+    {
+#ifdef USE_THREADING
+      if ( isParallel )
+      {
+        tbb::parallel_for(tbb::blocked_range<int>(0, numBlocks, 1), func);
+        return;
+      }
+#else
+      (void) isParallel;
+#endif
+      func.Process(0, numBlocks);
+    }
+
+#ifdef USE_THREADING
+    //! Body of parallel execution.
+    //! \param[in] range range of blocks to process.
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      static_cast<const TFunctor*>(this)->Process( range.begin(), range.end() );
+    }
+#endif
+  };
+
+  //! Computes the cell indices of points and reduces their ranges per block.
+  class CellsFunctor : public BlockFunctor<CellsFunctor>
+  {
+  public:
+
+    //! Per-block reduction.
+    struct t_range
+    {
+      int  Min[3], Max[3], Reach;
+      bool IsOk;
+    };
+
+    CellsFunctor(t_voxelHash& data, std::vector<t_range>& ranges)
+    : m_data(data), m_ranges(ranges) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      for ( int b = firstBlock; b < lastBlock; ++b )
+      {
+        t_range& r = m_ranges[b];
+        r.IsOk  = true;
+        r.Reach = 0;
+        for ( int a = 0; a < 3; ++a )
+        {
+          r.Min[a] = INT_MAX;
+          r.Max[a] = INT_MIN;
+        }
+
+        const int last = std::min(m_data.NumPts, (b + 1)*BlockSize);
+        for ( int i = b*BlockSize; i < last; ++i )
+        {
+          for ( int a = 0; a < 3; ++a )
+          {
+            const double c = m_data.Coords[3*i + a];
+            int cell, lo, hi;
+            //
+            if ( !CellIndex(c,               m_data.Tol, cell) ||
+                 !CellIndex(c - m_data.Conf, m_data.Tol, lo)   ||
+                 !CellIndex(c + m_data.Conf, m_data.Tol, hi) )
+            {
+              r.IsOk = false;
+              return;
+            }
+
+            m_data.Cells[3*i + a] = cell;
+            //
+            r.Min[a] = std::min(r.Min[a], cell);
+            r.Max[a] = std::max(r.Max[a], cell);
+            r.Reach  = std::max( r.Reach, std::max(cell - lo, hi - cell) );
+          }
+        }
+      }
+    }
+
+  private:
+
+    t_voxelHash&          m_data;
+    std::vector<t_range>& m_ranges;
+  };
+
+  //! Packs the cell indices of points to keys.
+  class KeysFunctor : public BlockFunctor<KeysFunctor>
+  {
+  public:
+
+    KeysFunctor(t_voxelHash& data) : m_data(data) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      const int first = firstBlock*BlockSize;
+      const int last  = std::min(m_data.NumPts, lastBlock*BlockSize);
+      //
+      for ( int i = first; i < last; ++i )
+      {
+        m_data.Keys[i]  = m_data.Key(m_data.Cells[3*i], m_data.Cells[3*i + 1], m_data.Cells[3*i + 2]);
+        m_data.Order[i] = i;
+        m_data.States[i].store(State_Undecided, std::memory_order_relaxed);
+        m_data.Purged[i] = 0;
+      }
+    }
+
+  private:
+
+    t_voxelHash& m_data;
+  };
+
+  //! Builds histograms of radix digits per block.
+  class HistogramFunctor : public BlockFunctor<HistogramFunctor>
+  {
+  public:
+
+    HistogramFunctor(const std::vector<uint64_t>& keys,
+                     const int                    shift,
+                     std::vector<int>&            hist)
+    : m_keys(keys), m_iShift(shift), m_hist(hist) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      const int numPts = int( m_keys.size() );
+      //
+      for ( int b = firstBlock; b < lastBlock; ++b )
+      {
+        int* h = &m_hist[b*RadixSize];
+        std::fill(h, h + RadixSize, 0);
+
+        const int last = std::min(numPts, (b + 1)*BlockSize);
+        for ( int i = b*BlockSize; i < last; ++i )
+          h[(m_keys[i] >> m_iShift) & (RadixSize - 1)]++;
+      }
+    }
+
+  private:
+
+    const std::vector<uint64_t>& m_keys;
+    int                          m_iShift;
+    std::vector<int>&            m_hist;
+  };
+
+  //! Scatters keys and point indices by the precomputed block offsets.
+  //! Since the blocks are processed in order, the sort is stable.
+  class ScatterFunctor : public BlockFunctor<ScatterFunctor>
+  {
+  public:
+
+    ScatterFunctor(const std::vector<uint64_t>& keys,
+                   const std::vector<int>&      order,
+                   const int                    shift,
+                   const std::vector<int>&      offsets,
+                   std::vector<uint64_t>&       keysOut,
+                   std::vector<int>&            orderOut)
+    : m_keys(keys), m_order(order), m_iShift(shift), m_offsets(offsets),
+      m_keysOut(keysOut), m_orderOut(orderOut) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      const int numPts = int( m_keys.size() );
+      //
+      for ( int b = firstBlock; b < lastBlock; ++b )
+      {
+        int pos[RadixSize];
+        std::copy(&m_offsets[b*RadixSize], &m_offsets[b*RadixSize] + RadixSize, pos);
+
+        const int last = std::min(numPts, (b + 1)*BlockSize);
+        for ( int i = b*BlockSize; i < last; ++i )
+        {
+          const int p = pos[(m_keys[i] >> m_iShift) & (RadixSize - 1)]++;
+          //
+          m_keysOut[p]  = m_keys[i];
+          m_orderOut[p] = m_order[i];
+        }
+      }
+    }
+
+  private:
+
+    const std::vector<uint64_t>& m_keys;
+    const std::vector<int>&      m_order;
+    int                          m_iShift;
+    const std::vector<int>&      m_offsets;
+    std::vector<uint64_t>&       m_keysOut;
+    std::vector<int>&            m_orderOut;
+  };
+
+  //! Resolves the elimination order of the cell filter. A point is kept if
+  //! none of the preceding kept points purges it. A point waits for the
+  //! next round if its fate depends on a preceding undecided point.
+  class ResolveFunctor : public BlockFunctor<ResolveFunctor>
+  {
+  public:
+
+    ResolveFunctor(t_voxelHash&      data,
+                   std::atomic<int>& numUndecided)
+    : m_data(data), m_numUndecided(numUndecided) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      const int first = firstBlock*BlockSize;
+      const int last  = std::min(m_data.NumPts, lastBlock*BlockSize);
+      int       numUndecided = 0;
+      //
+      for ( int v = first; v < last; ++v )
+      {
+        if ( m_data.State(v) != State_Undecided )
+          continue;
+
+        const unsigned char state = this->resolve(v);
+        //
+        if ( state == State_Undecided )
+          numUndecided++;
+        else
+          m_data.States[v].store(state, std::memory_order_relaxed);
+      }
+
+      if ( numUndecided )
+        m_numUndecided += numUndecided;
+    }
+
+  private:
+
+    unsigned char resolve(const int v) const
+    {
+      const int  R          = m_data.Reach;
+      const int* cv         = &m_data.Cells[3*v];
+      bool       isBlocked  = false;
+
+      for ( int i = std::max(cv[0] - R, m_data.Min[0]); i <= std::min(cv[0] + R, m_data.Max[0]); ++i )
+        for ( int j = std::max(cv[1] - R, m_data.Min[1]); j <= std::min(cv[1] + R, m_data.Max[1]); ++j )
+          for ( int k = std::max(cv[2] - R, m_data.Min[2]); k <= std::min(cv[2] + R, m_data.Max[2]); ++k )
+          {
+            const int cell = m_data.FindCell( m_data.Key(i, j, k) );
+            if ( cell < 0 )
+              continue;
+
+            // Points in a cell are sorted by their indices.
+            for ( int p = m_data.CellFirst[cell]; p < m_data.CellFirst[cell + 1]; ++p )
+            {
+              const int u = m_data.Order[p];
+              if ( u >= v )
+                break;
+
+              const unsigned char state = m_data.State(u);
+              //
+              if ( state == State_Eliminated || !m_data.Purges(u, v) )
+                continue;
+
+              if ( state == State_Kept )
+                return State_Eliminated;
+
+              isBlocked = true;
+            }
+          }
+
+      return isBlocked ? State_Undecided : State_Kept;
+    }
+
+  private:
+
+    t_voxelHash&      m_data;
+    std::atomic<int>& m_numUndecided;
+  };
+
+  //! Marks the kept points which are purged by the succeeding kept points
+  //! and counts the remaining points per block.
+  class FinalizeFunctor : public BlockFunctor<FinalizeFunctor>
+  {
+  public:
+
+    FinalizeFunctor(t_voxelHash& data, std::vector<int>& counts)
+    : m_data(data), m_counts(counts) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      for ( int b = firstBlock; b < lastBlock; ++b )
+      {
+        int       count = 0;
+        const int last  = std::min(m_data.NumPts, (b + 1)*BlockSize);
+        //
+        for ( int v = b*BlockSize; v < last; ++v )
+        {
+          if ( m_data.State(v) != State_Kept )
+            continue;
+
+          if ( this->isPurged(v) )
+            m_data.Purged[v] = 1;
+          else
+            count++;
+        }
+
+        m_counts[b] = count;
+      }
+    }
+
+  private:
+
+    bool isPurged(const int v) const
+    {
+      const int  R  = m_data.Reach;
+      const int* cv = &m_data.Cells[3*v];
+
+      for ( int i = std::max(cv[0] - R, m_data.Min[0]); i <= std::min(cv[0] + R, m_data.Max[0]); ++i )
+        for ( int j = std::max(cv[1] - R, m_data.Min[1]); j <= std::min(cv[1] + R, m_data.Max[1]); ++j )
+          for ( int k = std::max(cv[2] - R, m_data.Min[2]); k <= std::min(cv[2] + R, m_data.Max[2]); ++k )
+          {
+            const int cell = m_data.FindCell( m_data.Key(i, j, k) );
+            if ( cell < 0 )
+              continue;
+
+            for ( int p = m_data.CellFirst[cell + 1] - 1; p >= m_data.CellFirst[cell]; --p )
+            {
+              const int u = m_data.Order[p];
+              if ( u <= v )
+                break;
+
+              if ( m_data.State(u) == State_Kept && m_data.Purges(u, v) )
+                return true;
+            }
+          }
+
+      return false;
+    }
+
+  private:
+
+    t_voxelHash&      m_data;
+    std::vector<int>& m_counts;
+  };
+
+  //! Copies the remaining points to the resulting coordinates.
+  class CompactFunctor : public BlockFunctor<CompactFunctor>
+  {
+  public:
+
+    CompactFunctor(const t_voxelHash&      data,
+                   const std::vector<int>& offsets,
+                   double*                 out)
+    : m_data(data), m_offsets(offsets), m_pOut(out) {}
+
+    void Process(const int firstBlock, const int lastBlock) const
+    {
+      for ( int b = firstBlock; b < lastBlock; ++b )
+      {
+        int       pos  = m_offsets[b];
+        const int last = std::min(m_data.NumPts, (b + 1)*BlockSize);
+        //
+        for ( int i = b*BlockSize; i < last; ++i )
+        {
+          if ( m_data.State(i) != State_Kept || m_data.Purged[i] )
+            continue;
+
+          m_pOut[3*pos]     = m_data.Coords[3*i];
+          m_pOut[3*pos + 1] = m_data.Coords[3*i + 1];
+          m_pOut[3*pos + 2] = m_data.Coords[3*i + 2];
+          pos++;
+        }
+      }
+    }
+
+  private:
+
+    const t_voxelHash&      m_data;
+    const std::vector<int>& m_offsets;
+    double*                 m_pOut;
+  };
+
+  //! Returns the number of bits required to store the passed value.
+  inline int NumBits(uint64_t val)
+  {
+    int bits = 0;
+    while ( val )
+    {
+      bits++;
+      val >>= 1;
+    }
+    return bits;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_PurifyCloud::Perform3d(const double                             tol,
+                                    const Handle(asiAlgo_BaseCloud<double>)& source,
+                                    Handle(asiAlgo_BaseCloud<double>)&       result)
+{
+  // Check if there are any points to purify.
+  const int numPts = source->GetNumberOfElements();
+  if ( !numPts )
+    return;
+
+  // No points can be closer than a non-positive tolerance.
+  if ( !(tol > 0.) )
+  {
+    result = source;
+    return;
+  }
+
+  TIMER_NEW
+  TIMER_GO
+
+  const int numBlocks = (numPts + BlockSize - 1) / BlockSize;
+
+  t_voxelHash data;
+  data.Coords = &source->GetCoords()[0];
+  data.NumPts = numPts;
+  data.Tol    = tol;
+  data.Conf   = Precision::Confusion();
+  data.Reach  = 0;
+  data.Cells.resize(3*numPts);
+
+  /* ==================================
+   *  Stage 1: compute cells of points
+   * ================================== */
+
+  std::vector<CellsFunctor::t_range> ranges(numBlocks);
+  BlockFunctor<CellsFunctor>::Run(CellsFunctor(data, ranges), numBlocks, m_bIsParallel);
+
+  bool isOk = true;
+  for ( int a = 0; a < 3; ++a )
+  {
+    data.Min[a] = INT_MAX;
+    data.Max[a] = INT_MIN;
+  }
+  //
+  for ( int b = 0; b < numBlocks; ++b )
+  {
+    if ( !ranges[b].IsOk )
+    {
+      isOk = false;
+      break;
+    }
+
+    for ( int a = 0; a < 3; ++a )
+    {
+      data.Min[a] = std::min(data.Min[a], ranges[b].Min[a]);
+      data.Max[a] = std::max(data.Max[a], ranges[b].Max[a]);
+    }
+    data.Reach = std::max(data.Reach, ranges[b].Reach);
+  }
+
+  // Check that the cell keys fit into 64 bits.
+  int numKeyBits = 0;
+  if ( isOk )
+  {
+    for ( int a = 2; a >= 0; --a )
+    {
+      const int bits = NumBits( uint64_t( int64_t(data.Max[a]) - data.Min[a] ) );
+      //
+      data.Shift[a] = bits ? numKeyBits : 0;
+      numKeyBits   += bits;
+    }
+    //
+    isOk = (numKeyBits <= 64);
+  }
+
+  // Fall back to the cell filter for exotic configurations.
+  if ( !isOk )
+  {
+    m_progress.SendLogMessage( LogNotice(Normal) << "Voxel hashing is not applicable "
+                                                    "for the given tolerance. Using cell filter." );
+
+    this->PerformCommon<asiAlgo_BaseCloud<double>, asiAlgo_Inspector3d>(tol, source, result);
+    return;
+  }
+
+  /* ==================================
+   *  Stage 2: sort points by cell keys
+   * ================================== */
+
+  std::vector< std::atomic<unsigned char> > states(numPts);
+  //
+  data.States = &states[0];
+  data.Keys.resize(numPts);
+  data.Order.resize(numPts);
+  data.Purged.resize(numPts);
+  //
+  BlockFunctor<KeysFunctor>::Run(KeysFunctor(data), numBlocks, m_bIsParallel);
+
+  // LSD radix sort. The initial order is ascending by point indices and
+  // the sort is stable, so the points remain ordered in each cell.
+  {
+    std::vector<uint64_t> keysTmp(numPts);
+    std::vector<int>      orderTmp(numPts);
+    std::vector<int>      hist(numBlocks*RadixSize);
+    std::vector<int>      offsets(numBlocks*RadixSize);
+
+    for ( int shift = 0; shift < numKeyBits; shift += RadixBits )
+    {
+      BlockFunctor<HistogramFunctor>::Run(HistogramFunctor(data.Keys, shift, hist),
+                                          numBlocks, m_bIsParallel);
+
+      // Compute offsets and skip the pass if all keys share the digit.
+      bool isTrivial = false;
+      int  pos       = 0;
+      //
+      for ( int d = 0; d < RadixSize; ++d )
+      {
+        const int digitStart = pos;
+        for ( int b = 0; b < numBlocks; ++b )
+        {
+          offsets[b*RadixSize + d] = pos;
+          pos += hist[b*RadixSize + d];
+        }
+
+        if ( pos - digitStart == numPts )
+          isTrivial = true;
+      }
+      //
+      if ( isTrivial )
+        continue;
+
+      BlockFunctor<ScatterFunctor>::Run(ScatterFunctor(data.Keys, data.Order, shift, offsets, keysTmp, orderTmp),
+                                        numBlocks, m_bIsParallel);
+
+      data.Keys.swap(keysTmp);
+      data.Order.swap(orderTmp);
+    }
+  }
+
+  // Collect the occupied cells.
+  for ( int i = 0; i < numPts; ++i )
+  {
+    if ( !i || data.Keys[i] != data.Keys[i - 1] )
+    {
+      data.CellKeys.push_back(data.Keys[i]);
+      data.CellFirst.push_back(i);
+    }
+  }
+  data.CellFirst.push_back(numPts);
+  //
+  data.Keys.clear();
+  data.Keys.shrink_to_fit();
+
+  /* ============================================
+   *  Stage 3: resolve the order of elimination
+   * ============================================ */
+
+  int numRounds = 0;
+  for ( ;; )
+  {
+    if ( m_progress.IsCancelling() )
+      return;
+
+    std::atomic<int> numUndecided(0);
+    BlockFunctor<ResolveFunctor>::Run(ResolveFunctor(data, numUndecided), numBlocks, m_bIsParallel);
+    numRounds++;
+
+    if ( !numUndecided )
+      break;
+  }
+
+  // The kept points can still be purged by the succeeding kept points
+  // whose inspection range is shifted toward them.
+  std::vector<int> counts(numBlocks);
+  BlockFunctor<FinalizeFunctor>::Run(FinalizeFunctor(data, counts), numBlocks, m_bIsParallel);
+
+  std::vector<int> offsets(numBlocks);
+  int              numKept = 0;
+  //
+  for ( int b = 0; b < numBlocks; ++b )
+  {
+    offsets[b] = numKept;
+    numKept   += counts[b];
+  }
+
+  /* ==========================
+   *  Stage 4: populate result
+   * ========================== */
+
+  if ( numKept == numPts )
+  {
+    result = source;
+  }
+  else if ( result.get() == source.get() )
+  {
+    // Compact in place. The blocks are shifted toward the beginning, so
+    // the sequential copy never overwrites the unprocessed points.
+    std::vector<double>& coords = source->ChangeCoords();
+    //
+    CompactFunctor(data, offsets, &coords[0]).Process(0, numBlocks);
+    coords.resize(3*numKept);
+  }
+  else
+  {
+    if ( result.IsNull() )
+      result = new asiAlgo_BaseCloud<double>;
+
+    std::vector<double>& coords = result->ChangeCoords();
+    const int            base   = result->GetNumberOfElements();
+    //
+    coords.resize( 3*(base + numKept) );
+
+    BlockFunctor<CompactFunctor>::Run(CompactFunctor(data, offsets, &coords[3*base]),
+                                      numBlocks, m_bIsParallel);
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Purify point cloud")
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "%1 point(s) out of %2 remain after purification "
+                                                "(%3 cell(s), %4 round(s))."
+                                             << numKept << numPts
+                                             << int( data.CellKeys.size() ) << numRounds );
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_PurifyCloud::Perform3d(const double                      tol,
+                                    const Handle(asiAlgo_TiledCloud)& source,
+                                    const std::string&                filename)
+{
+  if ( source.IsNull() || !source->IsOpen() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Tiled point cloud is not open.");
+    return false;
+  }
+
+  TIMER_NEW
+  TIMER_GO
+
+  const asiAlgo_TiledCloudWriter::t_header& header = source->GetHeader();
+
+  asiAlgo_TiledCloudWriter writer(filename);
+  //
+  if ( !writer.Begin( header.Bounds[0], header.Bounds[1],
+                      header.Bounds[2], header.Bounds[3],
+                      header.Bounds[4], header.Bounds[5], int(header.Depth) ) )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot write file '%1'." << filename.c_str());
+    return false;
+  }
+
+  // The tiles are purified without logging.
+  asiAlgo_PurifyCloud tilePurifier;
+  tilePurifier.SetParallelMode(m_bIsParallel);
+
+  m_progress.Init( source->GetNumTiles() );
+
+  Handle(asiAlgo_BaseCloud<double>) tilePts = new asiAlgo_BaseCloud<double>;
+  //
+  for ( int t = 0; t < source->GetNumTiles(); ++t )
+  {
+    if ( m_progress.IsCancelling() )
+      return false;
+
+    source->GetTilePoints( t, tilePts->ChangeCoords() );
+
+    Handle(asiAlgo_BaseCloud<double>) purified;
+    tilePurifier.Perform3d(tol, tilePts, purified);
+    //
+    if ( !purified.IsNull() && !writer.Add(purified) )
+    {
+      m_progress.SendLogMessage(LogErr(Normal) << "Cannot write file '%1'." << filename.c_str());
+      return false;
+    }
+
+    m_progress.StepProgress(1);
+  }
+
+  const int64_t numKept = writer.GetNumPoints();
+  //
+  if ( !writer.End() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot write file '%1'." << filename.c_str());
+    return false;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Purify tiled cloud")
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "%1 point(s) out of %2 remain after purification "
+                                                "of %3 tile(s)."
+                                             << std::to_string(numKept).c_str()
+                                             << std::to_string( source->GetNumPoints() ).c_str()
+                                             << source->GetNumTiles() );
+  return true;
+}
@@ -34,6 +34,7 @@
 // asiAlgo includes
 #include <asiAlgo_BaseCloud.h>
 #include <asiAlgo_PointWithAttr.h>
+#include <asiAlgo_TiledCloud.h>
 
 // Active Data includes
 #include <ActAPI_IAlgorithm.h>
@@ -252,6 +253,13 @@ private:
 //! Auxiliary functions for purification of point clouds. These tools
 //! allow reducing the number of points by getting rid of those which
 //! fall into the given tolerant sphere.
+//!
+//! The generic PerformCommon() method is based on the OCCT cell filter and
+//! serves as the reference implementation. The 3D purification is done by
+//! voxel hashing: the points are sorted by their cell keys with a radix sort
+//! and the greedy elimination order of the cell filter is resolved in
+//! parallel rounds. The result is exactly the same as of PerformCommon()
+//! with asiAlgo_Inspector3d.
 class asiAlgo_PurifyCloud : public ActAPI_IAlgorithm
 {
 public:
@@ -261,24 +269,60 @@ public:
   //! \param[in] plotter  imperative plotter.
   asiAlgo_PurifyCloud(ActAPI_ProgressEntry progress = nullptr,
                       ActAPI_PlotterEntry  plotter  = nullptr)
-  : ActAPI_IAlgorithm(progress, plotter) {}
+  : ActAPI_IAlgorithm (progress, plotter),
+    m_bIsParallel     (true)
+  {}
+
+public:
+
+  //! Enables/disables parallel mode.
+  //! \param[in] on the Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+  //! \return true if parallel mode is enabled.
+  bool IsParallelMode() const
+  {
+    return m_bIsParallel;
+  }
 
 public:
 
-  //! Performs purification on the passed 3D point cloud.
+  //! Performs purification on the passed 3D point cloud. If the result
+  //! cloud is the same object as the source cloud, it is compacted in place.
   //! \param[in]  tol    tolerance to use.
   //! \param[in]  source source point cloud.
   //! \param[out] result resulting point cloud.
-  void Perform3d(const double                             tol,
-                 const Handle(asiAlgo_BaseCloud<double>)& source,
-                 Handle(asiAlgo_BaseCloud<double>)&       result)
-  {
-    this->PerformCommon<asiAlgo_BaseCloud<double>,
-                        asiAlgo_Inspector3d>(tol, source, result);
-  }
+  asiAlgo_EXPORT void
+    Perform3d(const double                             tol,
+              const Handle(asiAlgo_BaseCloud<double>)& source,
+              Handle(asiAlgo_BaseCloud<double>)&       result);
+
+  //! Performs purification of the out-of-core point cloud tile by tile.
+  //! The result is written to the tiled file with the same octree, so the
+  //! memory footprint is bounded by the size of a tile. As the tiles are
+  //! purified independently, the points closer than the tolerance can
+  //! survive on both sides of a tile boundary.
+  //! \param[in] tol      tolerance to use.
+  //! \param[in] source   source tiled cloud.
+  //! \param[in] filename output tiled file.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform3d(const double                      tol,
+              const Handle(asiAlgo_TiledCloud)& source,
+              const std::string&                filename);
 
 public:
 
+  //! Performs purification with the OCCT cell filter and the given
+  //! inspector. The points are processed in the order of their indices and
+  //! each retained point purges the points of its cell which are closer
+  //! than the tolerance.
+  //! \param[in]  tol    tolerance to use.
+  //! \param[in]  source source point cloud.
+  //! \param[out] result resulting point cloud.
   template<typename HCloudType,
            typename InspectorType>
   void PerformCommon(const double              tol,
@@ -365,6 +409,10 @@ public:
     }
   }
 
+protected:
+
+  bool m_bIsParallel; //!< Whether to run in parallel mode.
+
 };
 
 #endif
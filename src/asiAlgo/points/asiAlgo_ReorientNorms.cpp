@@ -31,6 +31,96 @@
 // Own include
 #include <asiAlgo_ReorientNorms.h>
 
+// asiAlgo includes
+#include <asiAlgo_CloudKdTree.h>
+#include <asiAlgo_Timer.h>
+
+// Standard includes
+#include <cmath>
+#include <queue>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Computes the weights of edges connecting the points with their
+  //! neighbors. The weight is small for nearly parallel (or anti-parallel)
+  //! normals, so that the orientation is propagated between them first.
+  class WeightsFunctor
+  {
+  public:
+
+    WeightsFunctor(const float* normals,
+                   const int*   neighbors,
+                   const int    k,
+                   float*       weights)
+    : m_pNormals(normals), m_pNeighbors(neighbors), m_iK(k), m_pWeights(weights) {}
+
+    void Process(const int first, const int last) const
+    {
+      for ( int i = first; i < last; ++i )
+      {
+        const float* ni   = &m_pNormals[3*i];
+        const float  sqNi = ni[0]*ni[0] + ni[1]*ni[1] + ni[2]*ni[2];
+
+        for ( int s = 0; s < m_iK; ++s )
+        {
+          const int j = m_pNeighbors[i*m_iK + s];
+          //
+          if ( j < 0 || j == i )
+          {
+            m_pWeights[i*m_iK + s] = 1.f;
+            continue;
+          }
+
+          const float* nj   = &m_pNormals[3*j];
+          const float  sqNj = nj[0]*nj[0] + nj[1]*nj[1] + nj[2]*nj[2];
+          const float  dot  = ni[0]*nj[0] + ni[1]*nj[1] + ni[2]*nj[2];
+          const float  norm = std::sqrt(sqNi*sqNj);
+          //
+          m_pWeights[i*m_iK + s] = (norm > 0.f) ? 1.f - std::fabs(dot)/norm : 1.f;
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const float* m_pNormals;
+    const int*   m_pNeighbors;
+    int          m_iK;
+    float*       m_pWeights;
+  };
+
+  //! Candidate edge of the spanning tree.
+  struct t_edge
+  {
+    float Weight; //!< Edge weight.
+    int   Source; //!< Oriented point.
+    int   Target; //!< Point to orient.
+
+    t_edge(const float w, const int s, const int t) : Weight(w), Source(s), Target(t) {}
+
+    //! Inverse comparison to have the lightest edge on top of the queue.
+    bool operator<(const t_edge& other) const
+    {
+      return Weight > other.Weight;
+    }
+  };
+}
+
 //-----------------------------------------------------------------------------
 
 //! ctor.
@@ -38,40 +128,203 @@
 //! \param plotter  [in] imperative plotter.
 asiAlgo_ReorientNorms::asiAlgo_ReorientNorms(ActAPI_ProgressEntry progress,
                                              ActAPI_PlotterEntry  plotter)
-: ActAPI_IAlgorithm(progress, plotter)
+: ActAPI_IAlgorithm (progress, plotter),
+  m_iNumNeighbors   (8),
+  m_iNumComponents  (0),
+  m_bIsParallel     (true)
 {}
 
 //-----------------------------------------------------------------------------
 
-//! Performs reorientation of normals with respect to the reference normal
-//! vector.
-//! \param input        [in]  input normal field.
+//! Orients the normal field consistently with the reference normal vector.
+//! The normals which cannot be reached from the reference point over the
+//! neighborhood graph are oriented consistently within their connected
+//! components only.
+//! \param points       [in]  point cloud.
+//! \param input        [in]  input normal field (one normal per point).
 //! \param refNormIndex [in]  index of the reference normal.
 //! \param output       [out] output normal field.
-bool asiAlgo_ReorientNorms::Perform(const asiAlgo_BaseCloud<float>& input,
-                                    const int                       refNormIndex,
-                                    asiAlgo_BaseCloud<float>&       output)
+//! \return true in case of success, false -- otherwise.
+bool asiAlgo_ReorientNorms::Perform(const Handle(asiAlgo_BaseCloud<double>)& points,
+                                    const Handle(asiAlgo_BaseCloud<float>)&  input,
+                                    const int                                refNormIndex,
+                                    Handle(asiAlgo_BaseCloud<float>)&        output)
 {
-  float refx, refy, refz;
-  input.GetElement(refNormIndex, refx, refy, refz);
-  gp_Vec refNorm(refx, refy, refz);
-
-  // Prepare a deep copy (TODO: this may be improved in future)
-  input.CopyTo(output);
-
-  // Decide for each single normal whether to invert it
-  //for ( int i = 0; i < output.GetNumberOfPoints(); ++i )
-  //{
-  //  if ( i == refNormIndex )
-  //    continue;
-
-  //  float nx, ny, nz;
-  //  output.GetPoint(i, nx, ny, nz);
-  //  gp_Vec norm(nx, ny, nz);
-  //  //
-  //  if ( refNorm.Dot(norm) < 0 )
-  //    output.SetPoint(i, -nx, -ny, -nz);
-  //}
+  m_iNumComponents = 0;
+
+  if ( points.IsNull() || input.IsNull() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Null point cloud or normal field.");
+    return false;
+  }
+
+  const int numPts = points->GetNumberOfElements();
+  //
+  if ( input->GetNumberOfElements() != numPts )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "The number of normals (%1) is different "
+                                                "from the number of points (%2)."
+                                             << input->GetNumberOfElements() << numPts);
+    return false;
+  }
+  //
+  if ( refNormIndex < 0 || refNormIndex >= numPts )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Reference normal index %1 is out of range."
+                                             << refNormIndex);
+    return false;
+  }
+
+  // Prepare a copy to orient.
+  output = new asiAlgo_BaseCloud<float>;
+  input->CopyTo(*output);
+  //
+  std::vector<float>& normals = output->ChangeCoords();
+
+  // One more neighbor as the point itself is found as well.
+  const int k = std::min(m_iNumNeighbors, numPts - 1) + 1;
+
+  TIMER_NEW
+  TIMER_GO
+
+  /* =================================
+   *  Stage 1: build neighborhood graph
+   * ================================= */
+
+  asiAlgo_CloudKdTree<double> tree;
+  tree.SetParallelMode(m_bIsParallel);
+  tree.Build(points);
+
+  std::vector<int>    neighbors;
+  std::vector<double> sqDists;
+  tree.FindKNearest(points->GetCoords(), k, neighbors, sqDists);
+  //
+  sqDists.clear();
+  sqDists.shrink_to_fit();
+
+  std::vector<float> weights(neighbors.size());
+  WeightsFunctor weightsFunc(&normals[0], &neighbors[0], k, &weights[0]);
+  //
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for(tbb::blocked_range<int>(0, numPts, 1024), weightsFunc);
+  else
+#endif
+    weightsFunc.Process(0, numPts);
+
+  // The k nearest neighbors relation is not symmetric, so the adjacency
+  // lists are composed of both outgoing and incoming edges.
+  std::vector<int> adjFirst(numPts + 1, 0);
+  //
+  for ( int i = 0; i < numPts; ++i )
+    for ( int s = 0; s < k; ++s )
+    {
+      const int j = neighbors[i*k + s];
+      //
+      if ( j >= 0 && j != i )
+      {
+        adjFirst[i + 1]++;
+        adjFirst[j + 1]++;
+      }
+    }
+  //
+  for ( int i = 0; i < numPts; ++i )
+    adjFirst[i + 1] += adjFirst[i];
+
+  std::vector<int>   adjPos(adjFirst.begin(), adjFirst.end() - 1);
+  std::vector<int>   adjTargets(adjFirst[numPts]);
+  std::vector<float> adjWeights(adjFirst[numPts]);
+  //
+  for ( int i = 0; i < numPts; ++i )
+    for ( int s = 0; s < k; ++s )
+    {
+      const int j = neighbors[i*k + s];
+      //
+      if ( j >= 0 && j != i )
+      {
+        const float w = weights[i*k + s];
+        //
+        adjTargets[adjPos[i]] = j; adjWeights[adjPos[i]++] = w;
+        adjTargets[adjPos[j]] = i; adjWeights[adjPos[j]++] = w;
+      }
+    }
+  //
+  neighbors.clear();
+  neighbors.shrink_to_fit();
+  weights.clear();
+  weights.shrink_to_fit();
+
+  /* ===========================================
+   *  Stage 2: propagate along the spanning tree
+   * =========================================== */
+
+  std::vector<bool>           visited(numPts, false);
+  std::priority_queue<t_edge> queue;
+  int                         numFlipped = 0;
+  int                         nextSeed   = 0;
+  int                         seed       = refNormIndex;
+  //
+  while ( seed < numPts )
+  {
+    m_iNumComponents++;
+
+    visited[seed] = true;
+    queue.push( t_edge(0.f, seed, seed) );
+
+    // Prim's algorithm with lazy removal of the outdated edges.
+    while ( !queue.empty() )
+    {
+      const t_edge edge = queue.top();
+      queue.pop();
+
+      const int v = edge.Target;
+      //
+      if ( v != edge.Source )
+      {
+        if ( visited[v] )
+          continue;
+
+        visited[v] = true;
+
+        // Pass orientation from the already oriented point.
+        const float* nu = &normals[3*edge.Source];
+        float*       nv = &normals[3*v];
+        //
+        if ( nu[0]*nv[0] + nu[1]*nv[1] + nu[2]*nv[2] < 0.f )
+        {
+          nv[0] = -nv[0];
+          nv[1] = -nv[1];
+          nv[2] = -nv[2];
+          numFlipped++;
+        }
+      }
+
+      for ( int a = adjFirst[v]; a < adjFirst[v + 1]; ++a )
+        if ( !visited[adjTargets[a]] )
+          queue.push( t_edge(adjWeights[a], v, adjTargets[a]) );
+    }
+
+    if ( m_progress.IsCancelling() )
+      return false;
+
+    // Continue with the next connected component.
+    while ( nextSeed < numPts && visited[nextSeed] )
+      nextSeed++;
+    //
+    seed = nextSeed;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Orient normals")
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "%1 normal(s) out of %2 flipped. "
+                                                "Neighborhood graph has %3 connected component(s)."
+                                             << numFlipped << numPts << m_iNumComponents );
+  //
+  if ( m_iNumComponents > 1 )
+    m_progress.SendLogMessage( LogWarn(Normal) << "Normals not connected to the reference one "
+                                                  "are oriented within their components only. "
+                                                  "Consider increasing the number of neighbors." );
 
   return true;
 }
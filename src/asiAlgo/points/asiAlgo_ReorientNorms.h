@@ -42,7 +42,17 @@
 
 //-----------------------------------------------------------------------------
 
-//! Utility to reorient normal field with respect to a sample vector.
+//! Utility to orient normal field consistently with respect to the reference
+//! normal vector. The orientation is propagated over the Riemannian graph of
+//! the point cloud (see H. Hoppe et al., "Surface reconstruction from
+//! unorganized points"): the k nearest neighbors of each point are connected
+//! with the edges weighted by 1 - |n_i.n_j|, and the orientation is passed
+//! along the minimum spanning tree grown from the reference point. This way,
+//! the orientation is propagated preferably between nearly parallel normals.
+//!
+//! The neighbors are found with a k-d tree in parallel mode. The spanning
+//! tree is grown with Prim's algorithm in O(n log n) time for a fixed number
+//! of neighbors.
 class asiAlgo_ReorientNorms : public ActAPI_IAlgorithm
 {
 public:
@@ -59,9 +69,51 @@ public:
 public:
 
   asiAlgo_EXPORT bool
-    Perform(const asiAlgo_BaseCloud<float>& input,
-            const int                       refNormIndex,
-            asiAlgo_BaseCloud<float>&       output);
+    Perform(const Handle(asiAlgo_BaseCloud<double>)& points,
+            const Handle(asiAlgo_BaseCloud<float>)&  input,
+            const int                                refNormIndex,
+            Handle(asiAlgo_BaseCloud<float>)&        output);
+
+public:
+
+  //! Sets the number of neighbors to connect each point with.
+  //! \param[in] k the number of neighbors to set.
+  void SetNumNeighbors(const int k)
+  {
+    m_iNumNeighbors = k;
+  }
+
+  //! \return number of neighbors to connect each point with.
+  int GetNumNeighbors() const
+  {
+    return m_iNumNeighbors;
+  }
+
+  //! Enables/disables parallel mode.
+  //! \param[in] on the Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+  //! \return true if parallel mode is enabled.
+  bool IsParallelMode() const
+  {
+    return m_bIsParallel;
+  }
+
+  //! \return number of connected components in the neighborhood graph
+  //!         found by the last run.
+  int GetNumComponents() const
+  {
+    return m_iNumComponents;
+  }
+
+protected:
+
+  int  m_iNumNeighbors;  //!< Number of neighbors of each point.
+  int  m_iNumComponents; //!< Number of connected components.
+  bool m_bIsParallel;    //!< Whether to run in parallel mode.
 
 };
 
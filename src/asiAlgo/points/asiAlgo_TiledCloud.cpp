@@ -0,0 +1,433 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_TiledCloud.h>
+
+// OS-dependent includes
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Default number of cached points.
+  const int64_t DefaultCacheSize = 16*1024*1024;
+
+  //! Reads the value at the given offset and moves the offset.
+  template <typename T>
+  void ReadValue(const char* data, uint64_t& offset, T& value)
+  {
+    memcpy( &value, data + offset, sizeof(T) );
+    offset += sizeof(T);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_TiledCloud::Iterator::Iterator(const Handle(asiAlgo_TiledCloud)& cloud)
+: m_cloud   (cloud),
+  m_bHasBox (false),
+  m_iTile   (0)
+{
+  for ( int k = 0; k < 6; ++k )
+    m_box[k] = 0.;
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_TiledCloud::Iterator::Iterator(const Handle(asiAlgo_TiledCloud)& cloud,
+                                       const double xMin, const double xMax,
+                                       const double yMin, const double yMax,
+                                       const double zMin, const double zMax)
+: m_cloud   (cloud),
+  m_bHasBox (true),
+  m_iTile   (0)
+{
+  m_box[0] = xMin; m_box[1] = xMax;
+  m_box[2] = yMin; m_box[3] = yMax;
+  m_box[4] = zMin; m_box[5] = zMax;
+
+  this->skip();
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TiledCloud::Iterator::Next()
+{
+  m_iTile++;
+  this->skip();
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TiledCloud::Iterator::skip()
+{
+  if ( !m_bHasBox )
+    return;
+
+  for ( ; m_iTile < m_cloud->GetNumTiles(); ++m_iTile )
+  {
+    const double* B = m_cloud->GetTile(m_iTile).Bounds;
+    //
+    if ( B[0] <= m_box[1] && B[1] >= m_box[0] &&
+         B[2] <= m_box[3] && B[3] >= m_box[2] &&
+         B[4] <= m_box[5] && B[5] >= m_box[4] )
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_TiledCloud::asiAlgo_TiledCloud()
+: Standard_Transient (),
+  m_pData            (nullptr),
+  m_iSize            (0),
+  m_hFile            (nullptr),
+  m_hMapping         (nullptr),
+  m_iFile            (-1),
+  m_iCached          (0),
+  m_iCacheSize       (DefaultCacheSize)
+{}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_TiledCloud::~asiAlgo_TiledCloud()
+{
+  this->Close();
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_TiledCloud::Open(const std::string& filename)
+{
+  this->Close();
+
+#ifdef _WIN32
+  HANDLE hFile = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+  //
+  if ( hFile == INVALID_HANDLE_VALUE )
+    return false;
+
+  LARGE_INTEGER fileSize;
+  //
+  if ( !GetFileSizeEx(hFile, &fileSize) )
+  {
+    CloseHandle(hFile);
+    return false;
+  }
+
+  HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  //
+  if ( hMapping == NULL )
+  {
+    CloseHandle(hFile);
+    return false;
+  }
+
+  const void* pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+  //
+  if ( pData == NULL )
+  {
+    CloseHandle(hMapping);
+    CloseHandle(hFile);
+    return false;
+  }
+
+  m_hFile    = hFile;
+  m_hMapping = hMapping;
+  m_pData    = static_cast<const char*>(pData);
+  m_iSize    = (uint64_t) fileSize.QuadPart;
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  //
+  if ( fd < 0 )
+    return false;
+
+  struct stat st;
+  //
+  if ( fstat(fd, &st) != 0 || st.st_size == 0 )
+  {
+    close(fd);
+    return false;
+  }
+
+  void* pData = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  //
+  if ( pData == MAP_FAILED )
+  {
+    close(fd);
+    return false;
+  }
+
+  m_iFile = fd;
+  m_pData = static_cast<const char*>(pData);
+  m_iSize = (uint64_t) st.st_size;
+#endif
+
+  // Read header. The fields are taken from their fixed offsets to stay
+  // independent of the structure alignment.
+  if ( m_iSize < uint64_t(asiAlgo_TiledCloudWriter::HeaderSize) )
+  {
+    this->Close();
+    return false;
+  }
+  //
+  uint64_t offset = 0;
+  //
+  ReadValue(m_pData, offset, m_header.Magic);
+  ReadValue(m_pData, offset, m_header.Version);
+  ReadValue(m_pData, offset, m_header.Depth);
+  ReadValue(m_pData, offset, m_header.NumPoints);
+  ReadValue(m_pData, offset, m_header.NumTiles);
+  ReadValue(m_pData, offset, m_header.Reserved);
+  ReadValue(m_pData, offset, m_header.Bounds);
+
+  if ( memcmp(m_header.Magic, asiAlgo_TiledCloudWriter::t_header().Magic, 8) != 0 ||
+       m_header.Version != 1 ||
+       m_iSize < uint64_t(asiAlgo_TiledCloudWriter::HeaderSize)
+               + uint64_t(asiAlgo_TiledCloudWriter::TileRecordSize)*m_header.NumTiles )
+  {
+    this->Close();
+    return false;
+  }
+
+  // Read the table of tiles and check that the contents correspond to it.
+  m_tiles.resize(m_header.NumTiles);
+  //
+  uint64_t numPoints = 0;
+  //
+  for ( uint32_t t = 0; t < m_header.NumTiles; ++t )
+  {
+    t_tile& tile = m_tiles[t];
+    //
+    ReadValue(m_pData, offset, tile.Bounds);
+    ReadValue(m_pData, offset, tile.Origin);
+    ReadValue(m_pData, offset, tile.Offset);
+    ReadValue(m_pData, offset, tile.FirstPoint);
+    ReadValue(m_pData, offset, tile.NumPoints);
+    ReadValue(m_pData, offset, tile.Code);
+
+    if ( tile.FirstPoint != numPoints ||
+         tile.Offset + uint64_t(tile.NumPoints)*3*sizeof(float) > m_iSize )
+    {
+      this->Close();
+      return false;
+    }
+    //
+    numPoints += tile.NumPoints;
+  }
+  //
+  if ( numPoints != m_header.NumPoints )
+  {
+    this->Close();
+    return false;
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TiledCloud::Close()
+{
+#ifdef _WIN32
+  if ( m_pData )
+    UnmapViewOfFile(m_pData);
+
+  if ( m_hMapping )
+    CloseHandle( static_cast<HANDLE>(m_hMapping) );
+
+  if ( m_hFile )
+    CloseHandle( static_cast<HANDLE>(m_hFile) );
+#else
+  if ( m_pData )
+    munmap( const_cast<char*>(m_pData), size_t(m_iSize) );
+
+  if ( m_iFile >= 0 )
+    close(m_iFile);
+#endif
+
+  m_pData    = nullptr;
+  m_iSize    = 0;
+  m_hFile    = nullptr;
+  m_hMapping = nullptr;
+  m_iFile    = -1;
+  m_header   = asiAlgo_TiledCloudWriter::t_header();
+  m_iCached  = 0;
+  //
+  m_tiles.clear();
+  m_cache.clear();
+  m_usage.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TiledCloud::GetTilePoints(const int            tile,
+                                       std::vector<double>& coords) const
+{
+  const t_tile& T    = m_tiles[tile];
+  const float*  data = this->GetTileData(tile);
+  const size_t  num  = size_t(T.NumPoints)*3;
+
+  coords.resize(num);
+  //
+  for ( size_t i = 0; i < num; i += 3 )
+  {
+    coords[i]     = T.Origin[0] + data[i];
+    coords[i + 1] = T.Origin[1] + data[i + 1];
+    coords[i + 2] = T.Origin[2] + data[i + 2];
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+Handle(asiAlgo_BaseCloud<double>) asiAlgo_TiledCloud::LoadTile(const int tile)
+{
+  std::map<int, t_cached>::iterator it = m_cache.find(tile);
+  //
+  if ( it != m_cache.end() )
+  {
+    // Mark as the most recently used.
+    m_usage.splice( m_usage.begin(), m_usage, it->second.Use );
+    return it->second.Points;
+  }
+
+  Handle(asiAlgo_BaseCloud<double>) points = new asiAlgo_BaseCloud<double>;
+  this->GetTilePoints( tile, points->ChangeCoords() );
+
+  // Evict the least recently used tiles. The last tile is kept anyway.
+  m_iCached += m_tiles[tile].NumPoints;
+  //
+  while ( m_iCached > m_iCacheSize && !m_usage.empty() )
+  {
+    const int lru = m_usage.back();
+    //
+    m_iCached -= m_tiles[lru].NumPoints;
+    m_cache.erase(lru);
+    m_usage.pop_back();
+  }
+
+  m_usage.push_front(tile);
+  //
+  t_cached& cached = m_cache[tile];
+  cached.Points = points;
+  cached.Use    = m_usage.begin();
+
+  return points;
+}
+
+//-----------------------------------------------------------------------------
+
+int asiAlgo_TiledCloud::FindTile(const int64_t pointIndex) const
+{
+  if ( pointIndex < 0 || pointIndex >= this->GetNumPoints() )
+    return -1;
+
+  // Find the last tile starting at or before the index.
+  int lo = 0, hi = this->GetNumTiles() - 1;
+  //
+  while ( lo < hi )
+  {
+    const int mid = (lo + hi + 1)/2;
+    //
+    if ( int64_t(m_tiles[mid].FirstPoint) <= pointIndex )
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+//-----------------------------------------------------------------------------
+
+Handle(asiAlgo_BaseCloud<double>)
+  asiAlgo_TiledCloud::ExtractRegion(std::vector<int64_t> indices) const
+{
+  Handle(asiAlgo_BaseCloud<double>) result = new asiAlgo_BaseCloud<double>;
+
+  // Sort indices to visit each tile once.
+  std::sort( indices.begin(), indices.end() );
+
+  std::vector<double>& coords = result->ChangeCoords();
+  coords.reserve( 3*indices.size() );
+  //
+  for ( size_t i = 0; i < indices.size(); )
+  {
+    const int tile = this->FindTile(indices[i]);
+    //
+    if ( tile < 0 )
+    {
+      ++i;
+      continue;
+    }
+
+    const t_tile& T    = m_tiles[tile];
+    const float*  data = this->GetTileData(tile);
+    const int64_t last = int64_t(T.FirstPoint) + T.NumPoints;
+    //
+    for ( ; i < indices.size() && indices[i] < last; ++i )
+    {
+      const size_t local = size_t( indices[i] - int64_t(T.FirstPoint) );
+      //
+      coords.push_back( T.Origin[0] + data[3*local] );
+      coords.push_back( T.Origin[1] + data[3*local + 1] );
+      coords.push_back( T.Origin[2] + data[3*local + 2] );
+    }
+  }
+
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+
+Handle(asiAlgo_BaseCloud<double>)
+  asiAlgo_TiledCloud::ExtractRegion(const asiAlgo_CloudRegion& region) const
+{
+  std::vector<int64_t> indices;
+  indices.reserve( region.indices->Map().Extent() );
+  //
+  for ( asiAlgo_CloudRegion::Iterator it(region); it.More(); it.Next() )
+    indices.push_back( it.Key() );
+
+  return this->ExtractRegion(indices);
+}
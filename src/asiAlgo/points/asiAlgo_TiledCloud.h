@@ -0,0 +1,276 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_TiledCloud_h
+#define asiAlgo_TiledCloud_h
+
+// asiAlgo includes
+#include <asiAlgo_CloudRegion.h>
+#include <asiAlgo_TiledCloudWriter.h>
+
+// Standard includes
+#include <list>
+#include <map>
+
+//! Out-of-core point cloud stored in a tiled file (see asiAlgo_TiledCloudWriter).
+//! The file is memory-mapped, so the tiles are decoded directly from the
+//! mapping and only the touched pages are loaded by the operating system.
+//! The decoded tiles are kept in the LRU cache limited by the number of
+//! points, which bounds the memory footprint of the algorithms processing
+//! the cloud tile by tile.
+//!
+//! The points are indexed globally in the order of tiles. This order is
+//! generally different from the order in which the points were written.
+//!
+//! The const methods are thread-safe. Loading the tiles through the cache
+//! is not, so parallel consumers should decode the tiles with GetTilePoints().
+class asiAlgo_TiledCloud : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_TiledCloud, Standard_Transient)
+
+public:
+
+  //! Tile record.
+  typedef asiAlgo_TiledCloudWriter::t_tile t_tile;
+
+  //! Iterator over the tiles, optionally, intersecting the given box.
+  class Iterator
+  {
+  public:
+
+    //! Ctor for iterating all tiles.
+    //! \param[in] cloud tiled cloud to iterate.
+    asiAlgo_EXPORT
+      Iterator(const Handle(asiAlgo_TiledCloud)& cloud);
+
+    //! Ctor for iterating the tiles whose points may fall into the box.
+    //! \param[in] cloud tiled cloud to iterate.
+    //! \param[in] xMin  min X of the box.
+    //! \param[in] xMax  max X of the box.
+    //! \param[in] yMin  min Y of the box.
+    //! \param[in] yMax  max Y of the box.
+    //! \param[in] zMin  min Z of the box.
+    //! \param[in] zMax  max Z of the box.
+    asiAlgo_EXPORT
+      Iterator(const Handle(asiAlgo_TiledCloud)& cloud,
+               const double xMin, const double xMax,
+               const double yMin, const double yMax,
+               const double zMin, const double zMax);
+
+  public:
+
+    //! \return true if there are more tiles to iterate.
+    bool More() const
+    {
+      return m_iTile < m_cloud->GetNumTiles();
+    }
+
+    //! Moves to the next tile.
+    asiAlgo_EXPORT void
+      Next();
+
+    //! \return 0-based index of the current tile.
+    int TileIndex() const
+    {
+      return m_iTile;
+    }
+
+    //! \return current tile record.
+    const t_tile& Tile() const
+    {
+      return m_cloud->GetTile(m_iTile);
+    }
+
+    //! \return points of the current tile taken from the cache.
+    Handle(asiAlgo_BaseCloud<double>) Value() const
+    {
+      return m_cloud->LoadTile(m_iTile);
+    }
+
+  protected:
+
+    //! Skips the tiles out of the box.
+    void skip();
+
+  protected:
+
+    Handle(asiAlgo_TiledCloud) m_cloud;     //!< Iterated cloud.
+    double                     m_box[6];    //!< Box of interest.
+    bool                       m_bHasBox;   //!< Whether the box is set.
+    int                        m_iTile;     //!< Current tile.
+
+  };
+
+public:
+
+  //! Default ctor.
+  asiAlgo_EXPORT
+    asiAlgo_TiledCloud();
+
+  //! Dtor. Unmaps the file.
+  asiAlgo_EXPORT
+    ~asiAlgo_TiledCloud();
+
+public:
+
+  //! Opens and maps the tiled file.
+  //! \param[in] filename file to open.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Open(const std::string& filename);
+
+  //! Unmaps and closes the file.
+  asiAlgo_EXPORT void
+    Close();
+
+  //! Decodes the points of the tile without caching.
+  //! \param[in]  tile   0-based index of the tile.
+  //! \param[out] coords flattened coordinates of the points.
+  asiAlgo_EXPORT void
+    GetTilePoints(const int            tile,
+                  std::vector<double>& coords) const;
+
+  //! Returns the points of the tile from the cache. The tile is decoded
+  //! if it is not in the cache, and the least recently used tiles are
+  //! evicted to fit the cache size.
+  //! \param[in] tile 0-based index of the tile.
+  //! \return points of the tile.
+  asiAlgo_EXPORT Handle(asiAlgo_BaseCloud<double>)
+    LoadTile(const int tile);
+
+  //! Finds the tile containing the point with the given global index.
+  //! \param[in] pointIndex 0-based global index of the point.
+  //! \return 0-based index of the tile or -1 if the index is out of range.
+  asiAlgo_EXPORT int
+    FindTile(const int64_t pointIndex) const;
+
+  //! Extracts the points with the given global indices. Only the tiles
+  //! containing the region are decoded.
+  //! \param[in] indices 0-based global indices of points to extract. The
+  //!                    indices out of range are skipped.
+  //! \return extracted points in the order of their indices.
+  asiAlgo_EXPORT Handle(asiAlgo_BaseCloud<double>)
+    ExtractRegion(std::vector<int64_t> indices) const;
+
+  //! Extracts the points of the region. The region holds 32-bit indices,
+  //! so only the first 2^31 points are addressable with it. Use the
+  //! overload taking 64-bit indices for larger clouds.
+  //! \param[in] region indices of points to extract.
+  //! \return extracted points in the order of their indices.
+  asiAlgo_EXPORT Handle(asiAlgo_BaseCloud<double>)
+    ExtractRegion(const asiAlgo_CloudRegion& region) const;
+
+public:
+
+  //! \return true if the file is mapped.
+  bool IsOpen() const
+  {
+    return m_pData != nullptr;
+  }
+
+  //! \return header of the file.
+  const asiAlgo_TiledCloudWriter::t_header& GetHeader() const
+  {
+    return m_header;
+  }
+
+  //! \return number of tiles.
+  int GetNumTiles() const
+  {
+    return int( m_tiles.size() );
+  }
+
+  //! \return total number of points.
+  int64_t GetNumPoints() const
+  {
+    return int64_t(m_header.NumPoints);
+  }
+
+  //! \param[in] tile 0-based index of the tile.
+  //! \return tile record.
+  const t_tile& GetTile(const int tile) const
+  {
+    return m_tiles[tile];
+  }
+
+  //! Returns the raw data of the tile, i.e., the coordinates as 32-bit
+  //! floats relative to the origin of the tile.
+  //! \param[in] tile 0-based index of the tile.
+  //! \return pointer to the mapped data.
+  const float* GetTileData(const int tile) const
+  {
+    return reinterpret_cast<const float*>(m_pData + m_tiles[tile].Offset);
+  }
+
+  //! Sets the max number of cached points. Default is 16M points.
+  //! \param[in] numPoints number of points.
+  void SetCacheSize(const int64_t numPoints)
+  {
+    m_iCacheSize = numPoints;
+  }
+
+  //! \return max number of cached points.
+  int64_t GetCacheSize() const
+  {
+    return m_iCacheSize;
+  }
+
+private:
+
+  asiAlgo_TiledCloud(const asiAlgo_TiledCloud&);            //!< Not copyable.
+  asiAlgo_TiledCloud& operator=(const asiAlgo_TiledCloud&); //!< Not assignable.
+
+private:
+
+  //! Cached tile.
+  struct t_cached
+  {
+    Handle(asiAlgo_BaseCloud<double>) Points; //!< Decoded points.
+    std::list<int>::iterator          Use;    //!< Position in the usage list.
+  };
+
+  asiAlgo_TiledCloudWriter::t_header m_header;     //!< File header.
+  std::vector<t_tile>                m_tiles;      //!< Table of tiles.
+  const char*                        m_pData;      //!< Mapped file contents.
+  uint64_t                           m_iSize;      //!< Size of the mapped file in bytes.
+  void*                              m_hFile;      //!< File handle (Windows only).
+  void*                              m_hMapping;   //!< Mapping handle (Windows only).
+  int                                m_iFile;      //!< File descriptor (POSIX only).
+  std::map<int, t_cached>            m_cache;      //!< Decoded tiles.
+  std::list<int>                     m_usage;      //!< Tiles from the most recently used.
+  int64_t                            m_iCached;    //!< Number of cached points.
+  int64_t                            m_iCacheSize; //!< Max number of cached points.
+
+};
+
+#endif
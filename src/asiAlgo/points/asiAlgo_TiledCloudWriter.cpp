@@ -0,0 +1,413 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_TiledCloudWriter.h>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Default number of points to buffer before spilling.
+  const int64_t DefaultBufferSize = 8*1024*1024;
+
+  //! Number of floats read from the temporary file at once (16 MiB).
+  const size_t SpillBlockSize = 4*1024*1024;
+
+  //! Extends the box of the tile with the relative coordinates.
+  //! \param[in]     data      relative coordinates.
+  //! \param[in]     num       number of coordinates.
+  //! \param[in]     firstAxis axis of the first coordinate.
+  //! \param[in,out] tile      tile to update.
+  void UpdateBounds(const float*                       data,
+                    const size_t                       num,
+                    const int                          firstAxis,
+                    asiAlgo_TiledCloudWriter::t_tile& tile)
+  {
+    for ( size_t i = 0; i < num; ++i )
+    {
+      const int    a = int( (firstAxis + i) % 3 );
+      const double v = tile.Origin[a] + data[i];
+      //
+      tile.Bounds[2*a]     = std::min(tile.Bounds[2*a],     v);
+      tile.Bounds[2*a + 1] = std::max(tile.Bounds[2*a + 1], v);
+    }
+  }
+
+  template <typename T>
+  void WriteValue(const T& value, std::ostream& out)
+  {
+    out.write( reinterpret_cast<const char*>(&value), sizeof(T) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_TiledCloudWriter::asiAlgo_TiledCloudWriter(const std::string& filename)
+: m_filename    (filename),
+  m_spillname   (filename + ".spill"),
+  m_iSpillSize  (0),
+  m_iBuffered   (0),
+  m_iBufferSize (DefaultBufferSize),
+  m_iNumPoints  (0),
+  m_bStarted    (false)
+{
+  m_fCell[0] = m_fCell[1] = m_fCell[2] = 1.;
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_TiledCloudWriter::~asiAlgo_TiledCloudWriter()
+{
+  if ( m_spillFILE.is_open() )
+  {
+    m_spillFILE.close();
+    std::remove( m_spillname.c_str() );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_TiledCloudWriter::Begin(const double xMin, const double xMax,
+                                     const double yMin, const double yMax,
+                                     const double zMin, const double zMax,
+                                     const int    depth)
+{
+  if ( m_bStarted || depth < 0 || depth > MaxDepth )
+    return false;
+
+  m_spillFILE.open(m_spillname.c_str(), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+  //
+  if ( !m_spillFILE.is_open() )
+    return false;
+
+  m_header           = t_header();
+  m_header.Depth     = uint32_t(depth);
+  m_header.Bounds[0] = xMin;
+  m_header.Bounds[1] = xMax;
+  m_header.Bounds[2] = yMin;
+  m_header.Bounds[3] = yMax;
+  m_header.Bounds[4] = zMin;
+  m_header.Bounds[5] = zMax;
+
+  // Degenerated dimensions get unit cells.
+  const int numCells = 1 << depth;
+  //
+  for ( int a = 0; a < 3; ++a )
+  {
+    const double size = m_header.Bounds[2*a + 1] - m_header.Bounds[2*a];
+    m_fCell[a] = (size > 0.) ? size/numCells : 1.;
+  }
+
+  m_buffers.clear();
+  m_buffers.resize( size_t(1) << (3*depth) );
+  m_spills.clear();
+
+  m_iSpillSize = 0;
+  m_iBuffered  = 0;
+  m_iNumPoints = 0;
+  m_bStarted   = true;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_TiledCloudWriter::Add(const Handle(asiAlgo_BaseCloud<double>)& points)
+{
+  if ( points.IsNull() )
+    return false;
+
+  const std::vector<double>& coords = points->GetCoords();
+  //
+  for ( size_t i = 0; i < coords.size(); i += 3 )
+    if ( !this->Add(coords[i], coords[i + 1], coords[i + 2]) )
+      return false;
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_TiledCloudWriter::Add(const double x, const double y, const double z)
+{
+  if ( !m_bStarted )
+    return false;
+
+  const int    maxCell = (1 << m_header.Depth) - 1;
+  const double P[3]    = {x, y, z};
+  int          idx[3];
+  //
+  for ( int a = 0; a < 3; ++a )
+    idx[a] = std::max( 0, std::min( maxCell, int( std::floor( (P[a] - m_header.Bounds[2*a])/m_fCell[a] ) ) ) );
+
+  std::vector<float>& buffer = m_buffers[ MortonCode(idx[0], idx[1], idx[2], m_header.Depth) ];
+  //
+  for ( int a = 0; a < 3; ++a )
+    buffer.push_back( float( P[a] - (m_header.Bounds[2*a] + idx[a]*m_fCell[a]) ) );
+
+  m_iNumPoints++;
+  //
+  if ( ++m_iBuffered >= m_iBufferSize )
+    return this->spill();
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_TiledCloudWriter::End()
+{
+  if ( !m_bStarted )
+    return false;
+
+  m_bStarted = false;
+
+  // Count points per cell.
+  std::vector<uint64_t> counts( m_buffers.size(), 0 );
+  //
+  for ( size_t s = 0; s < m_spills.size(); ++s )
+    counts[m_spills[s].Code] += m_spills[s].NumPoints;
+  //
+  for ( size_t c = 0; c < m_buffers.size(); ++c )
+    counts[c] += m_buffers[c].size()/3;
+
+  // Prepare the table of tiles.
+  const int           numCells = 1 << m_header.Depth;
+  std::vector<t_tile> tiles;
+  std::vector<int>    tileByCode( counts.size(), -1 );
+  //
+  for ( uint32_t c = 0; c < uint32_t( counts.size() ); ++c )
+  {
+    if ( !counts[c] )
+      continue;
+
+    // A tile cannot hold more than 4G points.
+    if ( counts[c] > UINT32_MAX )
+      return false;
+
+    // Decode the cell indices from the Morton code.
+    int idx[3] = {0, 0, 0};
+    for ( uint32_t b = 0; b < m_header.Depth; ++b )
+      for ( int a = 0; a < 3; ++a )
+        idx[a] |= int( (c >> (3*b + a)) & 1u ) << b;
+
+    t_tile tile;
+    tile.Code      = c;
+    tile.NumPoints = uint32_t(counts[c]);
+    //
+    for ( int a = 0; a < 3; ++a )
+      tile.Origin[a] = m_header.Bounds[2*a] + std::min(idx[a], numCells - 1)*m_fCell[a];
+
+    tileByCode[c] = int( tiles.size() );
+    tiles.push_back(tile);
+  }
+
+  m_header.NumTiles  = uint32_t( tiles.size() );
+  m_header.NumPoints = uint64_t(m_iNumPoints);
+
+  uint64_t offset = uint64_t(HeaderSize) + uint64_t(TileRecordSize)*tiles.size();
+  uint64_t first  = 0;
+  //
+  for ( size_t t = 0; t < tiles.size(); ++t )
+  {
+    tiles[t].Offset     = offset;
+    tiles[t].FirstPoint = first;
+    //
+    offset += uint64_t(tiles[t].NumPoints)*3*sizeof(float);
+    first  += tiles[t].NumPoints;
+  }
+
+  std::ofstream FILE(m_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  //
+  if ( !FILE.is_open() )
+    return false;
+
+  // The table is rewritten once the boxes of tiles are known.
+  WriteHeader(m_header, FILE);
+  //
+  for ( size_t t = 0; t < tiles.size(); ++t )
+    WriteTile(tiles[t], FILE);
+
+  // The temporary file is read sequentially in large blocks, and its
+  // chunks are scattered to the positions of their tiles in the output
+  // file. The chunks are spilled in the order of adding points, so the
+  // points of each tile keep this order.
+  std::vector<uint64_t> cursors( tiles.size() );
+  //
+  for ( size_t t = 0; t < tiles.size(); ++t )
+    cursors[t] = tiles[t].Offset;
+
+  m_spillFILE.flush();
+  m_spillFILE.seekg(0);
+  //
+  std::vector<float> block( size_t( std::min<uint64_t>(SpillBlockSize, m_iSpillSize/sizeof(float)) ) );
+  uint64_t           numLeft = m_iSpillSize/sizeof(float); // Floats to read.
+  size_t             s       = 0;                          // Current chunk.
+  uint64_t           numDone = 0;                          // Floats of the chunk written.
+  //
+  while ( numLeft )
+  {
+    const size_t numRead = size_t( std::min<uint64_t>(block.size(), numLeft) );
+    //
+    m_spillFILE.read( reinterpret_cast<char*>( &block[0] ), std::streamsize( numRead*sizeof(float) ) );
+    //
+    if ( !m_spillFILE.good() )
+      return false;
+
+    numLeft -= numRead;
+
+    for ( size_t pos = 0; pos < numRead; )
+    {
+      // Skip to the chunk having data left.
+      while ( s < m_spills.size() && numDone == uint64_t(m_spills[s].NumPoints)*3 )
+      {
+        ++s;
+        numDone = 0;
+      }
+      //
+      if ( s == m_spills.size() )
+        return false;
+
+      const int    t   = tileByCode[m_spills[s].Code];
+      const size_t num = size_t( std::min<uint64_t>(uint64_t(m_spills[s].NumPoints)*3 - numDone,
+                                                    numRead - pos) );
+
+      UpdateBounds(&block[pos], num, int(numDone % 3), tiles[t]);
+
+      FILE.seekp( std::streamoff(cursors[t]) );
+      FILE.write( reinterpret_cast<const char*>( &block[pos] ), std::streamsize( num*sizeof(float) ) );
+      //
+      cursors[t] += num*sizeof(float);
+      numDone    += num;
+      pos        += num;
+    }
+  }
+
+  // Append the buffered points to their tiles.
+  for ( size_t t = 0; t < tiles.size(); ++t )
+  {
+    std::vector<float>& buffer = m_buffers[tiles[t].Code];
+    //
+    if ( buffer.empty() )
+      continue;
+
+    UpdateBounds(&buffer[0], buffer.size(), 0, tiles[t]);
+
+    FILE.seekp( std::streamoff(cursors[t]) );
+    FILE.write( reinterpret_cast<const char*>( &buffer[0] ), std::streamsize( buffer.size()*sizeof(float) ) );
+
+    std::vector<float>().swap(buffer);
+  }
+
+  FILE.seekp(0);
+  WriteHeader(m_header, FILE);
+  //
+  for ( size_t t = 0; t < tiles.size(); ++t )
+    WriteTile(tiles[t], FILE);
+
+  const bool isOk = FILE.good();
+  FILE.close();
+
+  // Clean up.
+  m_spillFILE.close();
+  std::remove( m_spillname.c_str() );
+  //
+  m_buffers.clear();
+  m_spills.clear();
+  return isOk;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TiledCloudWriter::WriteHeader(const t_header& header, std::ostream& out)
+{
+  out.write(header.Magic, 8);
+  WriteValue(header.Version,   out);
+  WriteValue(header.Depth,     out);
+  WriteValue(header.NumPoints, out);
+  WriteValue(header.NumTiles,  out);
+  WriteValue(header.Reserved,  out);
+  //
+  for ( int k = 0; k < 6; ++k )
+    WriteValue(header.Bounds[k], out);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TiledCloudWriter::WriteTile(const t_tile& tile, std::ostream& out)
+{
+  for ( int k = 0; k < 6; ++k )
+    WriteValue(tile.Bounds[k], out);
+  //
+  for ( int k = 0; k < 3; ++k )
+    WriteValue(tile.Origin[k], out);
+  //
+  WriteValue(tile.Offset,     out);
+  WriteValue(tile.FirstPoint, out);
+  WriteValue(tile.NumPoints,  out);
+  WriteValue(tile.Code,       out);
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_TiledCloudWriter::spill()
+{
+  m_spillFILE.seekp( std::streamoff(m_iSpillSize) );
+
+  for ( size_t c = 0; c < m_buffers.size(); ++c )
+  {
+    std::vector<float>& buffer = m_buffers[c];
+    //
+    if ( buffer.empty() )
+      continue;
+
+    t_spill record;
+    record.Code      = uint32_t(c);
+    record.NumPoints = uint32_t(buffer.size()/3);
+    //
+    m_spills.push_back(record);
+
+    const std::streamsize numBytes = std::streamsize( buffer.size()*sizeof(float) );
+    //
+    m_spillFILE.write(reinterpret_cast<const char*>( &buffer[0] ), numBytes);
+    m_iSpillSize += uint64_t(numBytes);
+
+    // Release memory, as the next points may go to other cells.
+    std::vector<float>().swap(buffer);
+  }
+
+  m_iBuffered = 0;
+  return m_spillFILE.good();
+}
@@ -0,0 +1,245 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_TiledCloudWriter_h
+#define asiAlgo_TiledCloudWriter_h
+
+// asiAlgo includes
+#include <asiAlgo_BaseCloud.h>
+
+// Standard includes
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//! Writes a point cloud which does not fit in memory to a tiled file. The
+//! bounding box of the cloud is subdivided by a regular octree of the given
+//! depth, and the points are binned into its leaves (tiles). The points are
+//! passed in chunks and spilled to a temporary file whenever the buffered
+//! points exceed the budget, so the memory footprint does not depend on the
+//! size of the cloud. On finalization, the temporary file is read
+//! sequentially, and its chunks are scattered to the tiles, which are laid
+//! out in Morton order, so that the neighbor tiles are stored close to each
+//! other.
+//!
+//! The file starts with a header followed by the table of tiles and the
+//! tile data. The coordinates are stored as 32-bit floats relative to the
+//! origin of their tile. Within a tile, the points keep the order in which
+//! they were added. See asiAlgo_TiledCloud for reading.
+class asiAlgo_TiledCloudWriter
+{
+public:
+
+  //! RAII ctor.
+  //! \param[in] filename output file.
+  asiAlgo_EXPORT
+    asiAlgo_TiledCloudWriter(const std::string& filename);
+
+  //! Dtor. Removes the temporary file if the writer was not finalized.
+  asiAlgo_EXPORT
+    ~asiAlgo_TiledCloudWriter();
+
+public:
+
+  //! File header.
+  struct t_header
+  {
+    char     Magic[8];  //!< File signature.
+    uint32_t Version;   //!< Format version.
+    uint32_t Depth;     //!< Depth of the octree.
+    uint64_t NumPoints; //!< Total number of points.
+    uint32_t NumTiles;  //!< Number of non-empty tiles.
+    uint32_t Reserved;  //!< Reserved.
+    double   Bounds[6]; //!< Box of the octree (xMin, xMax, yMin, yMax, zMin, zMax).
+
+    //! Default ctor.
+    t_header() : Version(1), Depth(0), NumPoints(0), NumTiles(0), Reserved(0)
+    {
+      memcpy(Magic, "ASITILES", 8);
+      //
+      for ( int k = 0; k < 6; ++k )
+        Bounds[k] = 0.;
+    }
+  };
+
+  //! Record of the tile table.
+  struct t_tile
+  {
+    double   Bounds[6];  //!< Tight box of points (xMin, xMax, yMin, yMax, zMin, zMax).
+    double   Origin[3];  //!< Origin of the relative coordinates.
+    uint64_t Offset;     //!< Offset of the point data in the file.
+    uint64_t FirstPoint; //!< Global index of the first point of the tile.
+    uint32_t NumPoints;  //!< Number of points in the tile.
+    uint32_t Code;       //!< Morton code of the octree leaf.
+
+    //! Default ctor.
+    t_tile() : Offset(0), FirstPoint(0), NumPoints(0), Code(0)
+    {
+      for ( int k = 0; k < 3; ++k )
+      {
+        Bounds[2*k]     =  DBL_MAX;
+        Bounds[2*k + 1] = -DBL_MAX;
+        Origin[k]       = 0.;
+      }
+    }
+  };
+
+public:
+
+  //! Starts writing. The points out of the passed box are binned into the
+  //! nearest boundary tiles.
+  //! \param[in] xMin  min X of the cloud.
+  //! \param[in] xMax  max X of the cloud.
+  //! \param[in] yMin  min Y of the cloud.
+  //! \param[in] yMax  max Y of the cloud.
+  //! \param[in] zMin  min Z of the cloud.
+  //! \param[in] zMax  max Z of the cloud.
+  //! \param[in] depth depth of the octree (from 0 to MaxDepth).
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Begin(const double xMin, const double xMax,
+          const double yMin, const double yMax,
+          const double zMin, const double zMax,
+          const int    depth = 5);
+
+  //! Adds the chunk of points.
+  //! \param[in] points points to add.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Add(const Handle(asiAlgo_BaseCloud<double>)& points);
+
+  //! Adds a single point.
+  //! \param[in] x X coordinate.
+  //! \param[in] y Y coordinate.
+  //! \param[in] z Z coordinate.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Add(const double x, const double y, const double z);
+
+  //! Writes the tiles and closes the file.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    End();
+
+  //! Sets the max number of points to buffer in memory before spilling
+  //! them to the temporary file. Default is 8M points (96 MiB).
+  //! \param[in] numPoints number of points.
+  void SetBufferSize(const int64_t numPoints)
+  {
+    m_iBufferSize = numPoints;
+  }
+
+  //! \return number of points added so far.
+  int64_t GetNumPoints() const
+  {
+    return m_iNumPoints;
+  }
+
+public:
+
+  //! Size of the header in bytes.
+  static const int HeaderSize = 80;
+
+  //! Size of the tile record in bytes.
+  static const int TileRecordSize = 96;
+
+  //! Max depth of the octree.
+  static const int MaxDepth = 7;
+
+  //! Computes the Morton code of the octree cell.
+  //! \param[in] i     index of the cell along OX.
+  //! \param[in] j     index of the cell along OY.
+  //! \param[in] k     index of the cell along OZ.
+  //! \param[in] depth depth of the octree.
+  //! \return Morton code.
+  static uint32_t MortonCode(const int i, const int j, const int k, const int depth)
+  {
+    uint32_t code = 0;
+    for ( int b = 0; b < depth; ++b )
+    {
+      code |= ( (uint32_t(i) >> b) & 1u ) << (3*b);
+      code |= ( (uint32_t(j) >> b) & 1u ) << (3*b + 1);
+      code |= ( (uint32_t(k) >> b) & 1u ) << (3*b + 2);
+    }
+    return code;
+  }
+
+  //! Writes the header to the stream.
+  //! \param[in]  header header to write.
+  //! \param[out] out    output stream.
+  asiAlgo_EXPORT static void
+    WriteHeader(const t_header& header, std::ostream& out);
+
+  //! Writes the tile record to the stream.
+  //! \param[in]  tile tile to write.
+  //! \param[out] out  output stream.
+  asiAlgo_EXPORT static void
+    WriteTile(const t_tile& tile, std::ostream& out);
+
+protected:
+
+  //! Spills all buffered points to the temporary file.
+  //! \return true in case of success, false -- otherwise.
+  bool spill();
+
+private:
+
+  asiAlgo_TiledCloudWriter(const asiAlgo_TiledCloudWriter&);            //!< Not copyable.
+  asiAlgo_TiledCloudWriter& operator=(const asiAlgo_TiledCloudWriter&); //!< Not assignable.
+
+private:
+
+  //! Chunk of points spilled to the temporary file. The chunks are stored
+  //! in the file one after another in the order of records.
+  struct t_spill
+  {
+    uint32_t Code;      //!< Morton code of the cell.
+    uint32_t NumPoints; //!< Number of points.
+  };
+
+  std::string                       m_filename;    //!< Output filename.
+  std::string                       m_spillname;   //!< Temporary filename.
+  std::fstream                      m_spillFILE;   //!< Temporary file.
+  t_header                          m_header;      //!< Header.
+  double                            m_fCell[3];    //!< Sizes of the octree leaves.
+  std::vector< std::vector<float> > m_buffers;     //!< Buffered points per cell.
+  std::vector<t_spill>              m_spills;      //!< Spilled chunks.
+  uint64_t                          m_iSpillSize;  //!< Size of the temporary file.
+  int64_t                           m_iBuffered;   //!< Number of buffered points.
+  int64_t                           m_iBufferSize; //!< Max number of buffered points.
+  int64_t                           m_iNumPoints;  //!< Number of added points.
+  bool                              m_bStarted;    //!< Whether writing has started.
+
+};
+
+#endif
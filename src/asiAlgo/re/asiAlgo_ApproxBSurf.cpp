@@ -0,0 +1,731 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_ApproxBSurf.h>
+
+// asiAlgo includes
+#include <asiAlgo_PlaneOnPoints.h>
+#include <asiAlgo_Timer.h>
+
+// OCCT includes
+#include <BSplCLib.hxx>
+#include <GeomAPI_ProjectPointOnSurf.hxx>
+#include <math.hxx>
+#include <math_Matrix.hxx>
+#include <math_Vector.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+
+// Eigen includes
+#include <Eigen/Sparse>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of points projected by one task.
+  const int BlockSize = 4096;
+
+  //! Weight of the regularization pulling the poles to the initial
+  //! surface relative to the max diagonal element of the normal matrix.
+  //! It only matters for the poles which are affected neither by points
+  //! nor by fairing.
+  const double RegularizationWeight = 1.e-10;
+
+  //! Normal equations of the least squares problem. The matrix is
+  //! stored by rows, and each row keeps (2p+1)(2q+1) elements for the
+  //! poles whose indices differ at most by p in U and by q in V.
+  struct t_normalEqs
+  {
+    std::vector<double> A; //!< Banded normal matrix.
+    std::vector<double> B; //!< Right-hand sides for x, y and z.
+  };
+
+  //! Computes the integrals of the products of the basis functions'
+  //! derivatives of the orders 0, 1 and 2 over the knot range.
+  //! \param[in]  flatKnots flat knots.
+  //! \param[in]  degree    degree.
+  //! \param[in]  numPoles  number of poles.
+  //! \param[out] integrals dense numPoles x numPoles matrices of integrals
+  //!                       for each derivative order.
+  void IntegrateBasis(const TColStd_Array1OfReal& flatKnots,
+                      const int                   degree,
+                      const int                   numPoles,
+                      std::vector<double>         integrals[3])
+  {
+    // Gauss quadrature with p+1 points is exact for the products of
+    // polynomials of degree p.
+    const int numGauss   = degree + 1;
+    const int derivOrder = std::min(degree, 2);
+    //
+    math_Vector gaussPts(1, numGauss), gaussWeights(1, numGauss);
+    math::GaussPoints(numGauss, gaussPts);
+    math::GaussWeights(numGauss, gaussWeights);
+
+    for ( int d = 0; d < 3; ++d )
+      integrals[d].assign(numPoles*numPoles, 0.);
+
+    math_Matrix N(1, derivOrder + 1, 1, degree + 1);
+    //
+    for ( int s = flatKnots.Lower(); s < flatKnots.Upper(); ++s )
+    {
+      const double a = flatKnots(s);
+      const double b = flatKnots(s + 1);
+      //
+      if ( b - a < RealEpsilon() )
+        continue;
+
+      for ( int g = 1; g <= numGauss; ++g )
+      {
+        const double t = 0.5*(a + b) + 0.5*(b - a)*gaussPts(g);
+        const double w = 0.5*(b - a)*gaussWeights(g);
+
+        int first = 0;
+        BSplCLib::EvalBsplineBasis(derivOrder, degree + 1, flatKnots, t, first, N);
+
+        // The derivatives of order above the degree vanish.
+        for ( int d = 0; d <= derivOrder; ++d )
+          for ( int i = 0; i <= degree; ++i )
+            for ( int j = 0; j <= degree; ++j )
+              integrals[d][(first - 1 + i)*numPoles + first - 1 + j] += w*N(d + 1, i + 1)*N(d + 1, j + 1);
+      }
+    }
+  }
+
+  //! Functor projecting points to the initial surface.
+  class ProjectFunctor
+  {
+  public:
+
+    ProjectFunctor(const Handle(Geom_BSplineSurface)&       surf,
+                   const Handle(asiAlgo_BaseCloud<double>)& points,
+                   std::vector<double>&                     params)
+    : m_surf(surf), m_points(points), m_params(params) {}
+
+    //! Projects the blocks of points.
+    void Process(const int first, const int last) const
+    {
+      double uMin, uMax, vMin, vMax;
+      m_surf->Bounds(uMin, uMax, vMin, vMax);
+
+      // Projection tool is not thread-safe, so each task has its own.
+      GeomAPI_ProjectPointOnSurf proj;
+      proj.Init(m_surf, uMin, uMax, vMin, vMax);
+
+      const int numPts = m_points->GetNumberOfElements();
+      //
+      for ( int b = first; b < last; ++b )
+      {
+        const int kEnd = std::min(numPts, (b + 1)*BlockSize);
+        //
+        for ( int k = b*BlockSize; k < kEnd; ++k )
+        {
+          proj.Perform( m_points->GetElement(k) );
+          //
+          if ( proj.IsDone() && proj.NbPoints() )
+          {
+            proj.LowerDistanceParameters(m_params[2*k], m_params[2*k + 1]);
+          }
+          else
+          {
+            m_params[2*k]     = std::numeric_limits<double>::quiet_NaN();
+            m_params[2*k + 1] = std::numeric_limits<double>::quiet_NaN();
+          }
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const Handle(Geom_BSplineSurface)&       m_surf;   //!< Surface to project to.
+    const Handle(asiAlgo_BaseCloud<double>)& m_points; //!< Points to project.
+    std::vector<double>&                     m_params; //!< Resulting parameters.
+  };
+
+  //! Functor assembling the normal equations for the points of knot spans
+  //! in U. The points of the span with index s affect the rows of the poles
+  //! with the indices from s to s+p in U. The functor processes every
+  //! (p+1)-th span starting from the given one, so the rows touched by
+  //! different spans do not overlap and all tasks accumulate into the same
+  //! matrix without races.
+  class AssembleFunctor
+  {
+  public:
+
+    AssembleFunctor(const TColStd_Array1OfReal&              uFlatKnots,
+                    const TColStd_Array1OfReal&              vFlatKnots,
+                    const int                                uDegree,
+                    const int                                vDegree,
+                    const int                                numPolesV,
+                    const Handle(asiAlgo_BaseCloud<double>)& points,
+                    const std::vector<double>&               params,
+                    const std::vector<int>&                  order,
+                    const std::vector<int>&                  spanOffsets,
+                    const int                                firstSpan,
+                    t_normalEqs&                             eqs)
+    : m_uFlatKnots  (uFlatKnots),
+      m_vFlatKnots  (vFlatKnots),
+      m_iUDegree    (uDegree),
+      m_iVDegree    (vDegree),
+      m_iNumPolesV  (numPolesV),
+      m_points      (points),
+      m_params      (params),
+      m_order       (order),
+      m_spanOffsets (spanOffsets),
+      m_iFirstSpan  (firstSpan),
+      m_eqs         (eqs)
+    {}
+
+    //! \return number of spans processed by the functor.
+    int GetNumSpans() const
+    {
+      const int numSpans = int( m_spanOffsets.size() ) - 1;
+      //
+      return std::max(0, (numSpans - m_iFirstSpan + m_iUDegree) / (m_iUDegree + 1));
+    }
+
+    //! Accumulates the normal equations of the spans.
+    void Process(const int first, const int last) const
+    {
+      const int p        = m_iUDegree;
+      const int q        = m_iVDegree;
+      const int bandV    = 2*q + 1;
+      const int bandSize = (2*p + 1)*bandV;
+
+      math_Matrix Nu(1, 1, 1, p + 1);
+      math_Matrix Nv(1, 1, 1, q + 1);
+
+      // Indices and values of the nonzero basis functions.
+      std::vector<int>    rows   ( (p + 1)*(q + 1) );
+      std::vector<double> coeffs ( (p + 1)*(q + 1) );
+
+      for ( int t = first; t < last; ++t )
+      {
+        const int span = m_iFirstSpan + t*(p + 1);
+        //
+        for ( int idx = m_spanOffsets[span]; idx < m_spanOffsets[span + 1]; ++idx )
+        {
+          const int    k = m_order[idx];
+          const double u = m_params[2*k];
+          const double v = m_params[2*k + 1];
+
+          int uFirst = 0, vFirst = 0;
+          BSplCLib::EvalBsplineBasis(0, p + 1, m_uFlatKnots, u, uFirst, Nu);
+          BSplCLib::EvalBsplineBasis(0, q + 1, m_vFlatKnots, v, vFirst, Nv);
+
+          for ( int a = 0, r = 0; a <= p; ++a )
+            for ( int b = 0; b <= q; ++b, ++r )
+            {
+              rows[r]   = (uFirst - 1 + a)*m_iNumPolesV + vFirst - 1 + b;
+              coeffs[r] = Nu(1, a + 1)*Nv(1, b + 1);
+            }
+
+          const gp_XYZ P = m_points->GetElement(k);
+
+          for ( int a = 0, r = 0; a <= p; ++a )
+            for ( int b = 0; b <= q; ++b, ++r )
+            {
+              double* pB = &m_eqs.B[3*rows[r]];
+              pB[0] += coeffs[r]*P.X();
+              pB[1] += coeffs[r]*P.Y();
+              pB[2] += coeffs[r]*P.Z();
+
+              // Poles (a2, b2) are at offsets (a2 - a, b2 - b) from (a, b).
+              double* pA = &m_eqs.A[rows[r]*bandSize];
+              //
+              for ( int a2 = 0, s = 0; a2 <= p; ++a2 )
+                for ( int b2 = 0; b2 <= q; ++b2, ++s )
+                  pA[(a2 - a + p)*bandV + b2 - b + q] += coeffs[r]*coeffs[s];
+            }
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const TColStd_Array1OfReal&              m_uFlatKnots;  //!< Flat knots in U.
+    const TColStd_Array1OfReal&              m_vFlatKnots;  //!< Flat knots in V.
+    int                                      m_iUDegree;    //!< Degree in U.
+    int                                      m_iVDegree;    //!< Degree in V.
+    int                                      m_iNumPolesV;  //!< Number of poles in V.
+    const Handle(asiAlgo_BaseCloud<double>)& m_points;      //!< Points.
+    const std::vector<double>&               m_params;      //!< Parameters of points.
+    const std::vector<int>&                  m_order;       //!< Points sorted by spans.
+    const std::vector<int>&                  m_spanOffsets; //!< Offsets of spans in the sorted points.
+    int                                      m_iFirstSpan;  //!< First span to process.
+    t_normalEqs&                             m_eqs;         //!< Normal equations.
+  };
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_ApproxBSurf::asiAlgo_ApproxBSurf(const Handle(asiAlgo_BaseCloud<double>)& points,
+                                         ActAPI_ProgressEntry                     progress,
+                                         ActAPI_PlotterEntry                      plotter)
+: ActAPI_IAlgorithm (progress, plotter),
+  m_points          (points),
+  m_bIsParallel     (true)
+{}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ApproxBSurf::Perform(const int    uDegree,
+                                  const int    vDegree,
+                                  const int    numPolesU,
+                                  const int    numPolesV,
+                                  const double lambda)
+{
+  if ( m_points.IsNull() || !m_points->GetNumberOfElements() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "No points to approximate.");
+    return false;
+  }
+
+  if ( uDegree < 1 || vDegree < 1 || numPolesU <= uDegree || numPolesV <= vDegree )
+  {
+    m_progress.SendLogMessage( LogErr(Normal) << "Number of poles %1 x %2 is not enough for degrees %3 x %4."
+                                              << numPolesU << numPolesV << uDegree << vDegree );
+    return false;
+  }
+
+  /* =========================================
+   *  Parameterize points on average plane
+   * ========================================= */
+
+  gp_Pln plane;
+  //
+  if ( !asiAlgo_PlaneOnPoints(m_progress, m_plotter).Build(m_points, plane) )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot build average plane.");
+    return false;
+  }
+
+  const gp_XYZ O = plane.Position().Location().XYZ();
+  const gp_XYZ X = plane.Position().XDirection().XYZ();
+  const gp_XYZ Y = plane.Position().YDirection().XYZ();
+
+  const int numPts = m_points->GetNumberOfElements();
+  m_params.resize(2*numPts);
+
+  double xMin = RealLast(), xMax = RealFirst(), yMin = RealLast(), yMax = RealFirst();
+  //
+  for ( int k = 0; k < numPts; ++k )
+  {
+    const gp_XYZ d = m_points->GetElement(k) - O;
+    //
+    m_params[2*k]     = d.Dot(X);
+    m_params[2*k + 1] = d.Dot(Y);
+    //
+    xMin = std::min(xMin, m_params[2*k]);
+    xMax = std::max(xMax, m_params[2*k]);
+    yMin = std::min(yMin, m_params[2*k + 1]);
+    yMax = std::max(yMax, m_params[2*k + 1]);
+  }
+
+  const double dx = xMax - xMin;
+  const double dy = yMax - yMin;
+  //
+  if ( dx < Precision::Confusion() || dy < Precision::Confusion() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Points are degenerated to a line.");
+    return false;
+  }
+
+  for ( int k = 0; k < numPts; ++k )
+  {
+    m_params[2*k]     = (m_params[2*k]     - xMin) / dx;
+    m_params[2*k + 1] = (m_params[2*k + 1] - yMin) / dy;
+  }
+
+  /* =====================================
+   *  Build initial planar surface
+   * ===================================== */
+
+  const int numKnotsU = numPolesU - uDegree + 1;
+  const int numKnotsV = numPolesV - vDegree + 1;
+
+  TColStd_Array1OfReal    uKnots(1, numKnotsU), vKnots(1, numKnotsV);
+  TColStd_Array1OfInteger uMults(1, numKnotsU), vMults(1, numKnotsV);
+  //
+  for ( int i = 1; i <= numKnotsU; ++i )
+  {
+    uKnots(i) = double(i - 1) / (numKnotsU - 1);
+    uMults(i) = (i == 1 || i == numKnotsU) ? uDegree + 1 : 1;
+  }
+  //
+  for ( int j = 1; j <= numKnotsV; ++j )
+  {
+    vKnots(j) = double(j - 1) / (numKnotsV - 1);
+    vMults(j) = (j == 1 || j == numKnotsV) ? vDegree + 1 : 1;
+  }
+
+  TColStd_Array1OfReal uFlatKnots(1, numPolesU + uDegree + 1);
+  TColStd_Array1OfReal vFlatKnots(1, numPolesV + vDegree + 1);
+  //
+  BSplCLib::KnotSequence(uKnots, uMults, uFlatKnots);
+  BSplCLib::KnotSequence(vKnots, vMults, vFlatKnots);
+
+  // Poles at Greville abscissae make the surface coincide with the plane
+  // parameterized linearly, so the points keep their parameters.
+  TColStd_Array1OfReal uGreville(1, numPolesU), vGreville(1, numPolesV);
+  //
+  BSplCLib::BuildSchoenbergPoints(uDegree, uFlatKnots, uGreville);
+  BSplCLib::BuildSchoenbergPoints(vDegree, vFlatKnots, vGreville);
+
+  TColgp_Array2OfPnt poles(1, numPolesU, 1, numPolesV);
+  //
+  for ( int i = 1; i <= numPolesU; ++i )
+    for ( int j = 1; j <= numPolesV; ++j )
+      poles(i, j) = O + X*(xMin + dx*uGreville(i)) + Y*(yMin + dy*vGreville(j));
+
+  Handle(Geom_BSplineSurface)
+    initSurf = new Geom_BSplineSurface(poles, uKnots, vKnots, uMults, vMults, uDegree, vDegree);
+
+  return this->approximate(initSurf, lambda);
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ApproxBSurf::Perform(const Handle(Geom_BSplineSurface)& initSurf,
+                                  const double                       lambda)
+{
+  if ( m_points.IsNull() || !m_points->GetNumberOfElements() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "No points to approximate.");
+    return false;
+  }
+
+  if ( initSurf.IsNull() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Initial surface is null.");
+    return false;
+  }
+
+  if ( initSurf->IsUPeriodic() || initSurf->IsVPeriodic() ||
+       initSurf->IsURational() || initSurf->IsVRational() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Periodic and rational surfaces are not supported.");
+    return false;
+  }
+
+  /* ==========================================
+   *  Parameterize points on initial surface
+   * ========================================== */
+
+  TIMER_NEW
+  TIMER_GO
+
+  const int numPts    = m_points->GetNumberOfElements();
+  const int numBlocks = (numPts + BlockSize - 1) / BlockSize;
+  //
+  m_params.resize(2*numPts);
+
+  ProjectFunctor projectFunc(initSurf, m_points, m_params);
+  //
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for(tbb::blocked_range<int>(0, numBlocks, 1), projectFunc);
+  else
+#endif
+    projectFunc.Process(0, numBlocks);
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Parameterize points on initial surface")
+
+  return this->approximate(initSurf, lambda);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_ApproxBSurf::AddPinnedPole(const int i, const int j)
+{
+  m_pinned.push_back( std::pair<int, int>(i, j) );
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_ApproxBSurf::approximate(const Handle(Geom_BSplineSurface)& initSurf,
+                                      const double                       lambda)
+{
+  const int p        = initSurf->UDegree();
+  const int q        = initSurf->VDegree();
+  const int nu       = initSurf->NbUPoles();
+  const int nv       = initSurf->NbVPoles();
+  const int n        = nu*nv;
+  const int bandV    = 2*q + 1;
+  const int bandSize = (2*p + 1)*bandV;
+
+  TColStd_Array1OfReal uFlatKnots(1, nu + p + 1), vFlatKnots(1, nv + q + 1);
+  //
+  initSurf->UKnotSequence(uFlatKnots);
+  initSurf->VKnotSequence(vFlatKnots);
+
+  /* ==============================
+   *  Assemble normal equations
+   * ============================== */
+
+  TIMER_NEW
+  TIMER_GO
+
+  const int numPts   = m_points->GetNumberOfElements();
+  const int numSpans = nu - p;
+
+  // Sort the parameterized points by their knot spans in U.
+  std::vector<int> spans(numPts, -1), spanOffsets(numSpans + 1, 0);
+  {
+    math_Matrix Nu(1, 1, 1, p + 1);
+    //
+    for ( int k = 0; k < numPts; ++k )
+    {
+      if ( std::isnan(m_params[2*k]) || std::isnan(m_params[2*k + 1]) )
+        continue;
+
+      int uFirst = 0;
+      BSplCLib::EvalBsplineBasis(0, p + 1, uFlatKnots, m_params[2*k], uFirst, Nu);
+
+      spans[k] = uFirst - 1;
+      spanOffsets[uFirst]++;
+    }
+    //
+    for ( int s = 0; s < numSpans; ++s )
+      spanOffsets[s + 1] += spanOffsets[s];
+  }
+  //
+  std::vector<int> order( spanOffsets[numSpans] );
+  {
+    std::vector<int> cursors( spanOffsets.begin(), spanOffsets.end() - 1 );
+    //
+    for ( int k = 0; k < numPts; ++k )
+      if ( spans[k] >= 0 )
+        order[cursors[spans[k]]++] = k;
+  }
+  //
+  spans.clear();
+
+  // The spans of the same phase do not share rows. The phases are
+  // processed in turn, so the sums do not depend on the threading mode.
+  t_normalEqs eqs;
+  eqs.A.assign(n*bandSize, 0.);
+  eqs.B.assign(3*n, 0.);
+  //
+  for ( int phase = 0; phase <= p; ++phase )
+  {
+    AssembleFunctor assembleFunc(uFlatKnots, vFlatKnots, p, q, nv,
+                                 m_points, m_params, order, spanOffsets, phase, eqs);
+    //
+#ifdef USE_THREADING
+    if ( m_bIsParallel )
+      tbb::parallel_for(tbb::blocked_range<int>(0, assembleFunc.GetNumSpans(), 1), assembleFunc);
+    else
+#endif
+      assembleFunc.Process( 0, assembleFunc.GetNumSpans() );
+  }
+
+  // Thin plate energy integrated over the knot ranges. It is separable,
+  // so the integrals of the tensor product basis are the products of
+  // the univariate ones.
+  std::vector<double> U[3], V[3];
+  //
+  if ( lambda > 0. )
+  {
+    IntegrateBasis(uFlatKnots, p, nu, U);
+    IntegrateBasis(vFlatKnots, q, nv, V);
+  }
+
+  double maxDiag = 0.;
+  //
+  for ( int r = 0; r < n; ++r )
+    maxDiag = std::max(maxDiag, eqs.A[r*bandSize + p*bandV + q]);
+  //
+  const double mu = RegularizationWeight*std::max(maxDiag, 1.);
+
+  // Pinned poles are excluded from the unknowns by moving their
+  // contributions to the right-hand side.
+  std::vector<bool> isPinned(n, false);
+  //
+  for ( size_t k = 0; k < m_pinned.size(); ++k )
+  {
+    const int i = m_pinned[k].first;
+    const int j = m_pinned[k].second;
+    //
+    if ( i >= 1 && i <= nu && j >= 1 && j <= nv )
+      isPinned[(i - 1)*nv + j - 1] = true;
+  }
+
+  std::vector< Eigen::Triplet<double> > triplets;
+  triplets.reserve( n*(bandSize/2 + 1) );
+  //
+  Eigen::MatrixXd rhs(n, 3);
+  //
+  for ( int r = 0; r < n; ++r )
+  {
+    const int    I  = r / nv;
+    const int    J  = r % nv;
+    const gp_XYZ Pr = initSurf->Pole(I + 1, J + 1).XYZ();
+
+    if ( isPinned[r] )
+    {
+      triplets.push_back( Eigen::Triplet<double>(r, r, 1.) );
+      rhs(r, 0) = Pr.X(); rhs(r, 1) = Pr.Y(); rhs(r, 2) = Pr.Z();
+      continue;
+    }
+
+    rhs(r, 0) = eqs.B[3*r]     + mu*Pr.X();
+    rhs(r, 1) = eqs.B[3*r + 1] + mu*Pr.Y();
+    rhs(r, 2) = eqs.B[3*r + 2] + mu*Pr.Z();
+
+    for ( int di = -p; di <= p; ++di )
+    {
+      const int I2 = I + di;
+      //
+      if ( I2 < 0 || I2 >= nu )
+        continue;
+
+      for ( int dj = -q; dj <= q; ++dj )
+      {
+        const int J2 = J + dj;
+        //
+        if ( J2 < 0 || J2 >= nv )
+          continue;
+
+        const int s = I2*nv + J2;
+
+        double value = eqs.A[r*bandSize + (di + p)*bandV + dj + q];
+        //
+        if ( lambda > 0. )
+          value += lambda*(     U[2][I*nu + I2]*V[0][J*nv + J2]
+                          + 2.*U[1][I*nu + I2]*V[1][J*nv + J2]
+                          +     U[0][I*nu + I2]*V[2][J*nv + J2] );
+        //
+        if ( r == s )
+          value += mu;
+
+        if ( isPinned[s] )
+        {
+          const gp_XYZ Ps = initSurf->Pole(I2 + 1, J2 + 1).XYZ();
+          //
+          rhs(r, 0) -= value*Ps.X();
+          rhs(r, 1) -= value*Ps.Y();
+          rhs(r, 2) -= value*Ps.Z();
+        }
+        else if ( s <= r )
+        {
+          triplets.push_back( Eigen::Triplet<double>(r, s, value) );
+        }
+      }
+    }
+  }
+
+  // Release the banded matrix before factorization.
+  eqs.A.clear();
+  eqs.A.shrink_to_fit();
+
+  Eigen::SparseMatrix<double> A(n, n);
+  A.setFromTriplets( triplets.begin(), triplets.end() );
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Assemble normal equations")
+
+  /* ==================
+   *  Solve for poles
+   * ================== */
+
+  TIMER_RESET
+  TIMER_GO
+
+  Eigen::SimplicialLDLT< Eigen::SparseMatrix<double>, Eigen::Lower > solver(A);
+  //
+  if ( solver.info() != Eigen::Success )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Factorization of normal equations failed.");
+    return false;
+  }
+
+  const Eigen::MatrixXd X = solver.solve(rhs);
+  //
+  if ( solver.info() != Eigen::Success || !X.allFinite() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot solve normal equations.");
+    return false;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Solve normal equations")
+
+  /* ====================
+   *  Construct surface
+   * ==================== */
+
+  TColgp_Array2OfPnt poles(1, nu, 1, nv);
+  //
+  for ( int r = 0; r < n; ++r )
+    poles(r / nv + 1, r % nv + 1) = gp_Pnt( X(r, 0), X(r, 1), X(r, 2) );
+
+  TColStd_Array1OfReal    uKnots(1, initSurf->NbUKnots()), vKnots(1, initSurf->NbVKnots());
+  TColStd_Array1OfInteger uMults(1, initSurf->NbUKnots()), vMults(1, initSurf->NbVKnots());
+  //
+  initSurf->UKnots(uKnots);
+  initSurf->VKnots(vKnots);
+  initSurf->UMultiplicities(uMults);
+  initSurf->VMultiplicities(vMults);
+
+  m_result = new Geom_BSplineSurface(poles, uKnots, vKnots, uMults, vMults, p, q);
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "%1 points approximated with %2 x %3 poles."
+                                             << numPts << nu << nv );
+  return true;
+}
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_ApproxBSurf_h
+#define asiAlgo_ApproxBSurf_h
+
+// asiAlgo includes
+#include <asiAlgo_BaseCloud.h>
+
+// Active Data includes
+#include <ActAPI_IAlgorithm.h>
+
+// OCCT includes
+#include <Geom_BSplineSurface.hxx>
+
+// Standard includes
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+//! Approximates a point cloud with a B-spline surface in the least squares
+//! sense. Each point is affected by (p+1)(q+1) poles only, so the normal
+//! equations are assembled into a sparse banded matrix and solved with
+//! sparse Cholesky factorization. The surface is faired by adding the thin
+//! plate energy weighted with the fairing coefficient to the objective
+//! function. The points are sorted by their knot spans in U, and the spans
+//! not sharing poles are processed in parallel, all accumulating into the
+//! same banded matrix. This is where most of the time goes for dense scans.
+class asiAlgo_ApproxBSurf : public ActAPI_IAlgorithm
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiAlgo_ApproxBSurf, ActAPI_IAlgorithm)
+
+public:
+
+  //! Ctor.
+  //! \param[in] points   points to approximate.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  asiAlgo_EXPORT
+    asiAlgo_ApproxBSurf(const Handle(asiAlgo_BaseCloud<double>)& points,
+                        ActAPI_ProgressEntry                     progress = nullptr,
+                        ActAPI_PlotterEntry                      plotter  = nullptr);
+
+public:
+
+  //! Approximates the points with a B-surface of the given degrees and
+  //! numbers of poles. The points are parameterized by projection to their
+  //! average plane, and the knots are distributed uniformly.
+  //! \param[in] uDegree   degree in U direction.
+  //! \param[in] vDegree   degree in V direction.
+  //! \param[in] numPolesU number of poles in U direction.
+  //! \param[in] numPolesV number of poles in V direction.
+  //! \param[in] lambda    fairing coefficient.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const int    uDegree,
+            const int    vDegree,
+            const int    numPolesU,
+            const int    numPolesV,
+            const double lambda = 0.);
+
+  //! Approximates the points with a B-surface having the degrees and knots
+  //! of the initial surface. The points are parameterized by projection to
+  //! the initial surface.
+  //! \param[in] initSurf initial surface.
+  //! \param[in] lambda   fairing coefficient.
+  //! \return true in case of success, false -- otherwise.
+  asiAlgo_EXPORT bool
+    Perform(const Handle(Geom_BSplineSurface)& initSurf,
+            const double                       lambda = 0.);
+
+  //! Pins the pole of the initial surface, so that it is kept as is.
+  //! \param[in] i 1-based index of the pole in U direction.
+  //! \param[in] j 1-based index of the pole in V direction.
+  asiAlgo_EXPORT void
+    AddPinnedPole(const int i, const int j);
+
+public:
+
+  //! \return approximating surface.
+  const Handle(Geom_BSplineSurface)& GetResult() const
+  {
+    return m_result;
+  }
+
+  //! Sets multithreading mode (parallel or sequential).
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+protected:
+
+  //! Solves the least squares problem for the poles of the initial
+  //! surface. The points should be already parameterized.
+  //! \param[in] initSurf initial surface.
+  //! \param[in] lambda   fairing coefficient.
+  //! \return true in case of success, false -- otherwise.
+  bool approximate(const Handle(Geom_BSplineSurface)& initSurf,
+                   const double                       lambda);
+
+protected:
+
+  Handle(asiAlgo_BaseCloud<double>)  m_points;      //!< Points to approximate.
+  std::vector<double>                m_params;      //!< (u, v) pairs of the points, NaN if not parameterized.
+  std::vector< std::pair<int, int> > m_pinned;      //!< Pinned poles.
+  Handle(Geom_BSplineSurface)        m_result;      //!< Approximating surface.
+  bool                               m_bIsParallel; //!< Multithreading mode.
+
+};
+
+#endif
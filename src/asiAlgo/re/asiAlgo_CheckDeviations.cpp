@@ -35,6 +35,122 @@
 #include <asiAlgo_MeshField.h>
 #include <asiAlgo_MeshMerge.h>
 #include <asiAlgo_ProjectPointOnMesh.h>
+#include <asiAlgo_Timer.h>
+
+// Standard includes
+#include <algorithm>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of points projected between the progress updates.
+  const int BatchSize = 65536;
+
+  //! Number of points projected by one task.
+  const int BlockSize = 1024;
+
+  //! Projection of a point to the mesh.
+  struct t_projection
+  {
+    double Dist;       //!< Signed distance.
+    int    TriangleId; //!< Triangle containing the projection or -1.
+  };
+
+  //! Functor projecting the blocks of points to the mesh. Each block has
+  //! its own statistics, so the tasks do not share any mutable data.
+  class ProjectFunctor
+  {
+  public:
+
+    ProjectFunctor(const Handle(asiAlgo_BVHFacets)&         bvh,
+                   const Handle(asiAlgo_BaseCloud<double>)& points,
+                   const int                                batchStart,
+                   const int                                batchEnd,
+                   std::vector<asiAlgo_DeviationStats>&     blockStats,
+                   std::vector<t_projection>*               pProjections)
+    : m_bvh          (bvh),
+      m_points       (points),
+      m_iBatchStart  (batchStart),
+      m_iBatchEnd    (batchEnd),
+      m_blockStats   (blockStats),
+      m_pProjections (pProjections)
+    {}
+
+    void Process(const int first, const int last) const
+    {
+      asiAlgo_ProjectPointOnMesh pointToMesh(m_bvh);
+
+      for ( int b = first; b < last; ++b )
+      {
+        asiAlgo_DeviationStats& stats = m_blockStats[b];
+
+        const int kBeg = m_iBatchStart + b*BlockSize;
+        const int kEnd = std::min(m_iBatchEnd, kBeg + BlockSize);
+        //
+        for ( int k = kBeg; k < kEnd; ++k )
+        {
+          gp_Pnt P      = m_points->GetElement(k);
+          gp_Pnt P_proj = pointToMesh.Perform(P);
+          gp_Vec V      = P.XYZ() - P_proj.XYZ();
+
+          // Get distance.
+          double sd = V.Magnitude();
+          int    triangleId = -1;
+
+          // Get effective facet. The returned facet index is the 1-based
+          // index of a triangle in the merged triangulation from part.
+          const int facetInd = pointToMesh.GetFacetIds().size() ? pointToMesh.GetFacetIds()[0] : -1;
+          //
+          if ( facetInd != -1 )
+          {
+            const asiAlgo_BVHFacets::t_facet& facet = m_bvh->GetFacet(facetInd);
+
+            // Check normal to derive signed distance.
+            if ( facet.N.Dot(V) < 0 )
+              sd = -sd;
+
+            // Convert facet index to triangle index.
+            triangleId = facet.FaceIndex;
+
+            // Points without a projected facet have no signed distance,
+            // so they are left out of the statistics as well as the field.
+            stats.Add(sd, P);
+          }
+
+          if ( m_pProjections )
+          {
+            t_projection& proj = (*m_pProjections)[k - m_iBatchStart];
+            proj.Dist       = sd;
+            proj.TriangleId = triangleId;
+          }
+        }
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const Handle(asiAlgo_BVHFacets)&         m_bvh;          //!< BVH of facets.
+    const Handle(asiAlgo_BaseCloud<double>)& m_points;       //!< Points to project.
+    int                                      m_iBatchStart;  //!< First point of the batch.
+    int                                      m_iBatchEnd;    //!< Past-the-end point of the batch.
+    std::vector<asiAlgo_DeviationStats>&     m_blockStats;   //!< Statistics of blocks.
+    std::vector<t_projection>*               m_pProjections; //!< Projections of the batch.
+  };
+}
 
 //-----------------------------------------------------------------------------
 
@@ -42,7 +158,26 @@ asiAlgo_CheckDeviations::asiAlgo_CheckDeviations(const Handle(asiAlgo_BaseCloud<
                                                  ActAPI_ProgressEntry                     progress,
                                                  ActAPI_PlotterEntry                      plotter)
 : ActAPI_IAlgorithm (progress, plotter),
-  m_points          (points)
+  m_points          (points),
+  m_bComputeField   (true),
+  m_iNumBins        (0),
+  m_fHistMin        (0.),
+  m_fHistMax        (0.),
+  m_bIsParallel     (true)
+{}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_CheckDeviations::asiAlgo_CheckDeviations(const Handle(asiAlgo_TiledCloud)& points,
+                                                 ActAPI_ProgressEntry              progress,
+                                                 ActAPI_PlotterEntry               plotter)
+: ActAPI_IAlgorithm (progress, plotter),
+  m_tiles           (points),
+  m_bComputeField   (true),
+  m_iNumBins        (0),
+  m_fHistMin        (0.),
+  m_fHistMax        (0.),
+  m_bIsParallel     (true)
 {}
 
 //-----------------------------------------------------------------------------
@@ -74,77 +209,140 @@ bool asiAlgo_CheckDeviations::internalPerform()
 {
   m_progress.SetMessageKey("Compute BVH");
 
-  // Build BVH.
+  // Build BVH. The hierarchy is constructed lazily, which is not
+  // thread-safe, so it is requested here before projection.
   m_bvh = new asiAlgo_BVHFacets(m_result.triangulation);
+  m_bvh->BVH();
 
   m_progress.SetMessageKey("Project points to facets");
-  m_progress.Init( m_points->GetNumberOfElements() );
 
   // Prepare scalar field.
-  Handle(asiAlgo_MeshScalarField) field = new asiAlgo_MeshScalarField;
+  Handle(asiAlgo_MeshScalarField) field;
   //
-  m_result.fields.push_back(field);
+  if ( m_bComputeField )
+  {
+    field = new asiAlgo_MeshScalarField;
+    m_result.fields.push_back(field);
+  }
 
-  // Project each point individually.
-  double minScalar    = DBL_MAX, maxScalar    = -DBL_MAX;
-  int    minScalarIdx = -1,      maxScalarIdx = -1;
-  //
-  asiAlgo_ProjectPointOnMesh pointToMesh(m_bvh);
-  //
-  for ( int k = 0; k < m_points->GetNumberOfElements(); ++k )
+  m_stats = asiAlgo_DeviationStats(m_iNumBins, m_fHistMin, m_fHistMax);
+
+  TIMER_NEW
+  TIMER_GO
+
+  if ( !m_tiles.IsNull() )
   {
-    gp_Pnt P      = m_points->GetElement(k);
-    gp_Pnt P_proj = pointToMesh.Perform(P);
-    gp_Vec V      = P.XYZ() - P_proj.XYZ();
+    m_progress.Init( m_tiles->GetNumTiles() );
 
-    // Get distance.
-    const double ud = V.Magnitude();
+    // Project the out-of-core cloud tile by tile.
+    Handle(asiAlgo_BaseCloud<double>) tilePts = new asiAlgo_BaseCloud<double>;
     //
-    if ( ud < minScalar )
+    for ( int t = 0; t < m_tiles->GetNumTiles(); ++t )
     {
-      minScalar    = ud;
-      minScalarIdx = k;
-    }
-    //
-    if ( ud > maxScalar )
-    {
-      maxScalar    = ud;
-      maxScalarIdx = k;
+      m_tiles->GetTilePoints( t, tilePts->ChangeCoords() );
+      //
+      if ( !this->projectPoints(tilePts, field) )
+        return false;
+
+      m_progress.StepProgress(1);
     }
+  }
+  else
+  {
+    m_progress.Init( m_points->GetNumberOfElements() );
 
-    // Get effective facet. The returned facet index is the 1-based index of
-    // a triangle in the merged triangulation from part.
-    const int facetInd = pointToMesh.GetFacetIds().size() ? pointToMesh.GetFacetIds()[0] : -1;
-    //
-    if ( facetInd == -1 )
-      continue;
+    if ( !this->projectPoints(m_points, field) )
+      return false;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Project points to facets")
+
+  if ( !m_stats.GetCount() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot find min/max-distance points.");
+    m_progress.SetProgressStatus(ActAPI_ProgressStatus::Progress_Failed);
+    return false;
+  }
+
+  // Render the results.
+  m_progress.SendLogMessage(LogInfo(Normal) << "Min distance: %1." << m_stats.GetMinAbs());
+  m_progress.SendLogMessage(LogInfo(Normal) << "Max distance: %1." << m_stats.GetMaxAbs());
+  m_progress.SendLogMessage(LogInfo(Normal) << "Mean deviation: %1." << m_stats.GetMean());
+  m_progress.SendLogMessage(LogInfo(Normal) << "RMS deviation: %1." << m_stats.GetRMS());
+  m_progress.SendLogMessage( LogInfo(Normal) << "Deviation percentiles 5%, 50%, 95%: %1, %2, %3."
+                                             << m_stats.GetPercentile(5.)
+                                             << m_stats.GetPercentile(50.)
+                                             << m_stats.GetPercentile(95.) );
+  //
+  m_plotter.REDRAW_POINT("minScalarPt", m_stats.GetMinAbsPoint(), Color_Green);
+  m_plotter.REDRAW_POINT("maxScalarPt", m_stats.GetMaxAbsPoint(), Color_Red);
+
+  m_progress.SetProgressStatus(ActAPI_ProgressStatus::Progress_Succeeded);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiAlgo_CheckDeviations::projectPoints(const Handle(asiAlgo_BaseCloud<double>)& points,
+                                            const Handle(asiAlgo_MeshScalarField)&   field)
+{
+  const bool isStepping = m_tiles.IsNull();
+  const int  numPts     = points->GetNumberOfElements();
+
+  std::vector<asiAlgo_DeviationStats> blockStats;
+  std::vector<t_projection>           projections;
+
+  // Points are projected in batches, so that the progress is updated and
+  // the cancellation is checked on the main thread.
+  for ( int batchStart = 0; batchStart < numPts; batchStart += BatchSize )
+  {
+    const int batchEnd  = std::min(numPts, batchStart + BatchSize);
+    const int numBlocks = (batchEnd - batchStart + BlockSize - 1) / BlockSize;
+
+    blockStats.assign( numBlocks, asiAlgo_DeviationStats(m_iNumBins, m_fHistMin, m_fHistMax) );
     //
-    const asiAlgo_BVHFacets::t_facet& facet = m_bvh->GetFacet(facetInd);
+    if ( !field.IsNull() )
+      projections.resize(batchEnd - batchStart);
 
-    // Check normal to derive signed distance.
-    double sd;
+    ProjectFunctor projectFunc( m_bvh, points, batchStart, batchEnd, blockStats,
+                                field.IsNull() ? nullptr : &projections );
     //
-    if ( facet.N.Dot(V) < 0 )
-      sd = -ud;
+#ifdef USE_THREADING
+    if ( m_bIsParallel )
+      tbb::parallel_for(tbb::blocked_range<int>(0, numBlocks, 1), projectFunc);
     else
-      sd = ud;
+#endif
+      projectFunc.Process(0, numBlocks);
 
-    // Convert facet index to triangle index.
-    const int triangleId = facet.FaceIndex;
-
-    // Get indices of nodes.
-    const Poly_Triangle& triangle = m_result.triangulation->Triangle(triangleId);
-    //
-    int n1, n2, n3;
-    triangle.Get(n1, n2, n3);
+    // Merge the statistics in the order of blocks to get the same result
+    // regardless of the multithreading mode.
+    for ( int b = 0; b < numBlocks; ++b )
+      m_stats.Merge(blockStats[b]);
 
     // Store scalars in the field.
-    field->data.Bind(n1, sd);
-    field->data.Bind(n2, sd);
-    field->data.Bind(n3, sd);
+    if ( !field.IsNull() )
+    {
+      for ( int k = 0; k < batchEnd - batchStart; ++k )
+      {
+        if ( projections[k].TriangleId == -1 )
+          continue;
+
+        // Get indices of nodes.
+        const Poly_Triangle& triangle = m_result.triangulation->Triangle(projections[k].TriangleId);
+        //
+        int n1, n2, n3;
+        triangle.Get(n1, n2, n3);
+
+        field->data.Bind(n1, projections[k].Dist);
+        field->data.Bind(n2, projections[k].Dist);
+        field->data.Bind(n3, projections[k].Dist);
+      }
+    }
 
     // Progress notifier.
-    m_progress.StepProgress(1);
+    if ( isStepping )
+      m_progress.StepProgress(batchEnd - batchStart);
     //
     if ( m_progress.IsCancelling() )
     {
@@ -153,20 +351,5 @@ bool asiAlgo_CheckDeviations::internalPerform()
     }
   }
 
-  if ( minScalarIdx == -1 || maxScalarIdx == -1 )
-  {
-    m_progress.SendLogMessage(LogErr(Normal) << "Cannot find min/max-distance points.");
-    m_progress.SetProgressStatus(ActAPI_ProgressStatus::Progress_Failed);
-    return false;
-  }
-
-  // Render the results.
-  m_progress.SendLogMessage(LogInfo(Normal) << "Min distance: %1." << minScalar);
-  m_progress.SendLogMessage(LogInfo(Normal) << "Max distance: %1." << maxScalar);
-  //
-  m_plotter.REDRAW_POINT("minScalarPt", m_points->GetElement(minScalarIdx), Color_Green);
-  m_plotter.REDRAW_POINT("maxScalarPt", m_points->GetElement(maxScalarIdx), Color_Red);
-
-  m_progress.SetProgressStatus(ActAPI_ProgressStatus::Progress_Succeeded);
   return true;
 }
@@ -34,14 +34,21 @@
 // asiAlgo includes
 #include <asiAlgo_BaseCloud.h>
 #include <asiAlgo_BVHFacets.h>
+#include <asiAlgo_DeviationStats.h>
 #include <asiAlgo_Mesh.h>
+#include <asiAlgo_TiledCloud.h>
 
 // Active Data includes
 #include <ActAPI_IAlgorithm.h>
 
+// Forward declarations
+class asiAlgo_MeshScalarField;
+
 //-----------------------------------------------------------------------------
 
-//! Utility to check deviations between a CAD part and a point cloud.
+//! Utility to check deviations between a CAD part and a point cloud. The
+//! points are projected concurrently, and the statistics of deviations are
+//! accumulated on the fly without storing the per-point values.
 class asiAlgo_CheckDeviations : public ActAPI_IAlgorithm
 {
 public:
@@ -60,6 +67,16 @@ public:
                             ActAPI_ProgressEntry                     progress = nullptr,
                             ActAPI_PlotterEntry                      plotter  = nullptr);
 
+  //! Ctor for the out-of-core point cloud. The points are projected tile
+  //! by tile, so only a bounded number of points is kept in memory.
+  //! \param[in] points   tiled point cloud to compare with.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  asiAlgo_EXPORT
+    asiAlgo_CheckDeviations(const Handle(asiAlgo_TiledCloud)& points,
+                            ActAPI_ProgressEntry              progress = nullptr,
+                            ActAPI_PlotterEntry               plotter  = nullptr);
+
 public:
 
   //! Performs deviation check on CAD model.
@@ -85,6 +102,41 @@ public:
     return m_result;
   }
 
+  //! \return statistics of signed deviations.
+  const asiAlgo_DeviationStats& GetStats() const
+  {
+    return m_stats;
+  }
+
+  //! Enables or disables the distance field bound to the mesh nodes. If
+  //! only statistics are requested, the field can be skipped.
+  //! \param[in] on Boolean value to set.
+  void SetComputeField(const bool on)
+  {
+    m_bComputeField = on;
+  }
+
+  //! Sets up the histogram of signed deviations to count exactly during
+  //! the projection.
+  //! \param[in] numBins number of bins.
+  //! \param[in] histMin lower bound of the histogram.
+  //! \param[in] histMax upper bound of the histogram.
+  void SetHistogram(const int    numBins,
+                    const double histMin,
+                    const double histMax)
+  {
+    m_iNumBins = numBins;
+    m_fHistMin = histMin;
+    m_fHistMax = histMax;
+  }
+
+  //! Sets multithreading mode (parallel or sequential).
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
 protected:
 
   //! Internal method to perform deviation check. Triangulation should
@@ -93,11 +145,26 @@ protected:
   asiAlgo_EXPORT bool
     internalPerform();
 
+  //! Projects the points to the mesh, accumulates the statistics and
+  //! stores the signed distances in the field if it is not null.
+  //! \param[in] points points to project.
+  //! \param[in] field  scalar field to populate.
+  //! \return false if the operation was canceled, true -- otherwise.
+  bool projectPoints(const Handle(asiAlgo_BaseCloud<double>)& points,
+                     const Handle(asiAlgo_MeshScalarField)&   field);
+
 protected:
 
-  Handle(asiAlgo_BaseCloud<double>) m_points;   //!< Point cloud.
-  Handle(asiAlgo_BVHFacets)         m_bvh;      //!< BVH for point-to-mesh projection.
-  asiAlgo_Mesh                      m_result;   //!< Mesh with field.
+  Handle(asiAlgo_BaseCloud<double>) m_points;        //!< Point cloud.
+  Handle(asiAlgo_TiledCloud)        m_tiles;         //!< Out-of-core point cloud.
+  Handle(asiAlgo_BVHFacets)         m_bvh;           //!< BVH for point-to-mesh projection.
+  asiAlgo_Mesh                      m_result;        //!< Mesh with field.
+  asiAlgo_DeviationStats            m_stats;         //!< Statistics of deviations.
+  bool                              m_bComputeField; //!< Whether to compute the field.
+  int                               m_iNumBins;      //!< Number of histogram bins.
+  double                            m_fHistMin;      //!< Lower bound of the histogram.
+  double                            m_fHistMax;      //!< Upper bound of the histogram.
+  bool                              m_bIsParallel;   //!< Multithreading mode.
 
 };
 
@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_DeviationStats.h>
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_DeviationStats::Merge(const asiAlgo_DeviationStats& other)
+{
+  if ( !other.m_iCount )
+    return;
+
+  m_iCount += other.m_iCount;
+  m_fSum   += other.m_fSum;
+  m_fSumSq += other.m_fSumSq;
+  m_digest.Merge(other.m_digest);
+
+  if ( m_bins.size() == other.m_bins.size() )
+    for ( size_t b = 0; b < m_bins.size(); ++b )
+      m_bins[b] += other.m_bins[b];
+
+  if ( other.m_fMinAbs < m_fMinAbs )
+  {
+    m_fMinAbs  = other.m_fMinAbs;
+    m_minAbsPt = other.m_minAbsPt;
+  }
+  //
+  if ( other.m_fMaxAbs > m_fMaxAbs )
+  {
+    m_fMaxAbs  = other.m_fMaxAbs;
+    m_maxAbsPt = other.m_maxAbsPt;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+double asiAlgo_DeviationStats::GetPercentile(const double percent) const
+{
+  return m_digest.Quantile(percent / 100.);
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_DeviationStats::GetHistogram(const int            numBins,
+                                          std::vector<double>& edges,
+                                          std::vector<int>&    counts) const
+{
+  edges.clear();
+  counts.clear();
+
+  // Exact histogram.
+  if ( !m_bins.empty() )
+  {
+    const int n = int( m_bins.size() );
+    //
+    for ( int b = 0; b <= n; ++b )
+      edges.push_back( m_fHistMin + (m_fHistMax - m_fHistMin) * b / n );
+
+    counts = m_bins;
+    return;
+  }
+
+  if ( numBins < 1 || !m_iCount )
+    return;
+
+  const double minDev = this->GetMin();
+  const double maxDev = this->GetMax();
+
+  for ( int b = 0; b <= numBins; ++b )
+    edges.push_back( minDev + (maxDev - minDev) * b / numBins );
+
+  // Bin counts are the differences of the rounded cumulative counts, so
+  // they sum up to the number of deviations exactly.
+  int prevCumulative = 0;
+  //
+  for ( int b = 1; b <= numBins; ++b )
+  {
+    const int cumulative = (b == numBins) ? m_iCount
+                                          : int( m_digest.CDF(edges[b]) * m_iCount + 0.5 );
+    //
+    counts.push_back(cumulative - prevCumulative);
+    prevCumulative = cumulative;
+  }
+}
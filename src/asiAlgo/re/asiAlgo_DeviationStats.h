@@ -0,0 +1,216 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_DeviationStats_h
+#define asiAlgo_DeviationStats_h
+
+// asiAlgo includes
+#include <asiAlgo_TDigest.h>
+
+// OCCT includes
+#include <gp_Pnt.hxx>
+
+// Standard includes
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+//! Streaming statistics of signed deviations: moments, extremes,
+//! percentiles and histogram. The values are not stored, and the
+//! statistics accumulated for different portions of points can be merged,
+//! so each thread can have its own accumulator. The histogram is exact if
+//! its bins are set up on construction, otherwise it is estimated from the
+//! quantile sketch.
+class asiAlgo_DeviationStats
+{
+public:
+
+  //! Ctor.
+  //! \param[in] numBins number of histogram bins to count exactly.
+  //! \param[in] histMin lower bound of the histogram.
+  //! \param[in] histMax upper bound of the histogram.
+  asiAlgo_DeviationStats(const int    numBins = 0,
+                         const double histMin = 0.,
+                         const double histMax = 0.)
+  : m_iCount   (0),
+    m_fSum     (0.),
+    m_fSumSq   (0.),
+    m_fMinAbs  (DBL_MAX),
+    m_fMaxAbs  (-DBL_MAX),
+    m_fHistMin (histMin),
+    m_fHistMax (histMax)
+  {
+    if ( numBins > 0 && histMax > histMin )
+      m_bins.resize(numBins, 0);
+  }
+
+public:
+
+  //! Adds deviation.
+  //! \param[in] dev signed deviation.
+  //! \param[in] P   deviating point.
+  void Add(const double dev, const gp_Pnt& P)
+  {
+    m_iCount++;
+    m_fSum   += dev;
+    m_fSumSq += dev*dev;
+    m_digest.Add(dev);
+
+    // The deviations out of the histogram range fall into the end bins.
+    if ( !m_bins.empty() )
+    {
+      const int numBins = int( m_bins.size() );
+      const int bin     = int( (dev - m_fHistMin) / (m_fHistMax - m_fHistMin) * numBins );
+      //
+      m_bins[std::min( std::max(bin, 0), numBins - 1 )]++;
+    }
+
+    const double absDev = std::fabs(dev);
+    //
+    if ( absDev < m_fMinAbs )
+    {
+      m_fMinAbs  = absDev;
+      m_minAbsPt = P;
+    }
+    //
+    if ( absDev > m_fMaxAbs )
+    {
+      m_fMaxAbs  = absDev;
+      m_maxAbsPt = P;
+    }
+  }
+
+  //! Merges the statistics of other points.
+  //! \param[in] other statistics to merge.
+  asiAlgo_EXPORT void
+    Merge(const asiAlgo_DeviationStats& other);
+
+  //! Estimates the signed deviation below which the given percentage of
+  //! deviations falls.
+  //! \param[in] percent percentage in [0, 100] range.
+  //! \return estimated deviation.
+  asiAlgo_EXPORT double
+    GetPercentile(const double percent) const;
+
+  //! Returns the histogram of signed deviations. If the bins have been set
+  //! up on construction, their exact counts are returned. Otherwise, the
+  //! histogram with equal bins between the min and max deviations is
+  //! estimated from the quantile sketch.
+  //! \param[in]  numBins number of bins to estimate.
+  //! \param[out] edges   numBins + 1 edges of the bins.
+  //! \param[out] counts  numbers of deviations in the bins.
+  asiAlgo_EXPORT void
+    GetHistogram(const int            numBins,
+                 std::vector<double>& edges,
+                 std::vector<int>&    counts) const;
+
+public:
+
+  //! \return number of deviations.
+  int GetCount() const
+  {
+    return m_iCount;
+  }
+
+  //! \return mean signed deviation.
+  double GetMean() const
+  {
+    return m_iCount ? m_fSum / m_iCount : 0.;
+  }
+
+  //! \return root mean square deviation.
+  double GetRMS() const
+  {
+    return m_iCount ? std::sqrt(m_fSumSq / m_iCount) : 0.;
+  }
+
+  //! \return standard deviation of signed deviations.
+  double GetStdDev() const
+  {
+    const double mean = this->GetMean();
+    return m_iCount ? std::sqrt( std::max(m_fSumSq / m_iCount - mean*mean, 0.) ) : 0.;
+  }
+
+  //! \return min signed deviation.
+  double GetMin() const
+  {
+    return m_digest.GetMin();
+  }
+
+  //! \return max signed deviation.
+  double GetMax() const
+  {
+    return m_digest.GetMax();
+  }
+
+  //! \return min absolute deviation.
+  double GetMinAbs() const
+  {
+    return m_fMinAbs;
+  }
+
+  //! \return max absolute deviation.
+  double GetMaxAbs() const
+  {
+    return m_fMaxAbs;
+  }
+
+  //! \return point with the min absolute deviation.
+  const gp_Pnt& GetMinAbsPoint() const
+  {
+    return m_minAbsPt;
+  }
+
+  //! \return point with the max absolute deviation.
+  const gp_Pnt& GetMaxAbsPoint() const
+  {
+    return m_maxAbsPt;
+  }
+
+protected:
+
+  int              m_iCount;   //!< Number of deviations.
+  double           m_fSum;     //!< Sum of deviations.
+  double           m_fSumSq;   //!< Sum of squared deviations.
+  double           m_fMinAbs;  //!< Min absolute deviation.
+  double           m_fMaxAbs;  //!< Max absolute deviation.
+  gp_Pnt           m_minAbsPt; //!< Point with the min absolute deviation.
+  gp_Pnt           m_maxAbsPt; //!< Point with the max absolute deviation.
+  asiAlgo_TDigest  m_digest;   //!< Quantile estimator.
+  std::vector<int> m_bins;     //!< Exact histogram counts.
+  double           m_fHistMin; //!< Lower bound of the exact histogram.
+  double           m_fHistMax; //!< Upper bound of the exact histogram.
+
+};
+
+#endif
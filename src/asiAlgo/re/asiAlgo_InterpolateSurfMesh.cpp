@@ -35,6 +35,7 @@
 #include <asiAlgo_ClassifyPointFace.h>
 #include <asiAlgo_HitFacet.h>
 #include <asiAlgo_PlaneOnPoints.h>
+#include <asiAlgo_Timer.h>
 
 #ifdef USE_MOBIUS
   // Mobius includes
@@ -47,6 +48,7 @@
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
+#include <ElSLib.hxx>
 #include <GCE2d_MakeSegment.hxx>
 #include <Geom_Plane.hxx>
 #include <GeomLib.hxx>
@@ -58,6 +60,12 @@
 // Standard includes
 #include <algorithm>
 
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
 #undef DRAW_DEBUG
 #if defined DRAW_DEBUG
   #pragma message("===== warning: DRAW_DEBUG is enabled")
@@ -65,39 +73,173 @@
 
 //-----------------------------------------------------------------------------
 
-void RemoveCoincidentPoints(const double                                          prec,
-                            std::vector<asiAlgo_InterpolateSurfMesh::t_gridNode>& IntListNC,
-                            TColStd_PackedMapOfInteger&                           keptIndices)
+namespace
 {
-  std::vector<asiAlgo_InterpolateSurfMesh::t_gridNode> purifiedList;
-  int ip = 0;
-  do
+  //! Number of mesh nodes classified by one task.
+  const int NodeBlockSize = 4096;
+
+  //! Functor classifying the mesh nodes against the contour in the (U,V)
+  //! space of the average plane. Each task has its own classifier as the
+  //! face classifier is not thread-safe.
+  class ClassifyNodesFunctor
   {
-    const asiAlgo_InterpolateSurfMesh::t_gridNode& p = IntListNC[ip];
+  public:
+
+    ClassifyNodesFunctor(const TColgp_Array1OfPnt& triNodes,
+                         const gp_Pln&             pln,
+                         const TopoDS_Face&        face,
+                         const bool                boxClipping,
+                         const Bnd_Box&            contourAABB,
+                         std::vector<gp_XY>&       uvs,
+                         std::vector<char>&        isIn)
+    : m_triNodes     (triNodes),
+      m_pln          (pln),
+      m_face         (face),
+      m_bBoxClipping (boxClipping),
+      m_contourAABB  (contourAABB),
+      m_uvs          (uvs),
+      m_isIn         (isIn)
+    {}
+
+    void Process(const int first, const int last) const
+    {
+      asiAlgo_ClassifyPointFace classifier(m_face, 1e-4, 1e-4);
+
+      const int numNodes = int( m_uvs.size() );
+      //
+      for ( int b = first; b < last; ++b )
+      {
+        const int kEnd = std::min(numNodes, (b + 1)*NodeBlockSize);
+        //
+        for ( int k = b*NodeBlockSize; k < kEnd; ++k )
+        {
+          m_isIn[k] = 0;
+
+          const gp_Pnt& triNode = m_triNodes(m_triNodes.Lower() + k);
+          //
+          if ( m_bBoxClipping && m_contourAABB.IsOut(triNode) )
+            continue;
+
+          double u, v;
+          ElSLib::Parameters(m_pln, triNode, u, v);
+          //
+          m_uvs[k] = gp_XY(u, v);
+
+          // Classify against the two-dimensional contour.
+          if ( classifier( gp_Pnt2d(u, v) ) == Membership_In )
+            m_isIn[k] = 1;
+        }
+      }
+    }
 
-    // Traverse till the end skipping all coincident points
-    int jp = ip + 1, p_best_idx = ip;
-    asiAlgo_InterpolateSurfMesh::t_gridNode p_next, p_best = p;
-    for ( ; ; )
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
     {
-      ip = jp;
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const TColgp_Array1OfPnt& m_triNodes;     //!< Mesh nodes.
+    const gp_Pln&             m_pln;          //!< Average plane.
+    const TopoDS_Face&        m_face;         //!< Contour face on the plane.
+    bool                      m_bBoxClipping; //!< Whether to clip by the box.
+    const Bnd_Box&            m_contourAABB;  //!< Bounding box of the contour.
+    std::vector<gp_XY>&       m_uvs;          //!< Images of the nodes.
+    std::vector<char>&        m_isIn;         //!< Classification results.
+  };
+
+  //! Functor projecting the rows of grid nodes to the mesh along the normal
+  //! of the average plane.
+  class ProjectGridFunctor
+  {
+  public:
+
+    typedef std::vector< std::vector<asiAlgo_InterpolateSurfMesh::t_gridNode> > t_grid;
 
-      if ( jp >= int( IntListNC.size() ) )
-        break;
+    ProjectGridFunctor(const Handle(asiAlgo_BVHFacets)& bvh,
+                       const gp_Dir&                    planeNorm,
+                       t_grid&                          grid,
+                       std::vector<int>&                numFailed)
+    : m_bvh       (bvh),
+      m_planeNorm (planeNorm),
+      m_grid      (grid),
+      m_numFailed (numFailed)
+    {}
 
-      p_next = IntListNC[jp++];
+    void Process(const int first, const int last) const
+    {
+      asiAlgo_HitFacet picker(m_bvh);
 
-      if ( (p_next.uvInit - p.uvInit).Modulus() > prec )
-        break;
+      for ( int i = first; i < last; ++i )
+      {
+        m_numFailed[i] = 0;
+
+        for ( size_t j = 0; j < m_grid[i].size(); ++j )
+        {
+          asiAlgo_InterpolateSurfMesh::t_gridNode& node = m_grid[i][j];
+
+          gp_Lin ray1( node.xyzInit, m_planeNorm );
+          gp_Lin ray2( node.xyzInit, m_planeNorm.Reversed() );
+
+          int facetId1, facetId2;
+          gp_XYZ xyz1, xyz2;
+          //
+          const bool isOk1 = picker(ray1, facetId1, xyz1);
+          const bool isOk2 = picker(ray2, facetId2, xyz2);
+          //
+          if ( isOk1 && isOk2 )
+          {
+            // Take closest.
+            const double d1 = (node.xyzInit - xyz1).Modulus();
+            const double d2 = (node.xyzInit - xyz2).Modulus();
+            //
+            node.xyz = ( (d1 < d2) ? xyz1 : xyz2 );
+          }
+          else if ( isOk1 )
+            node.xyz = xyz1;
+          else if ( isOk2 )
+            node.xyz = xyz2;
+          else
+          {
+            node.xyz = node.xyzInit;
+            ++m_numFailed[i];
+          }
+        }
+      }
     }
 
-    keptIndices.Add(p_best_idx);
-    purifiedList.push_back(p_best);
-  }
-  while ( ip < int( IntListNC.size() ) );
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
 
-  // Override the passed list
-  IntListNC = purifiedList;
+  private:
+
+    const Handle(asiAlgo_BVHFacets)& m_bvh;       //!< BVH of facets.
+    gp_Dir                           m_planeNorm; //!< Projection direction.
+    t_grid&                          m_grid;      //!< Grid nodes.
+    std::vector<int>&                m_numFailed; //!< Failures per row.
+  };
+
+  //! Thins out the sorted coordinates, so that each kept coordinate is
+  //! farther than the given distance from the previously kept one.
+  //! \param[in]  coords sorted coordinates.
+  //! \param[in]  prec   distance to keep between the coordinates.
+  //! \param[out] result kept coordinates.
+  void SparseCoords(const std::vector<double>& coords,
+                    const double               prec,
+                    std::vector<double>&       result)
+  {
+    result.clear();
+    //
+    for ( size_t k = 0; k < coords.size(); ++k )
+      if ( result.empty() || coords[k] - result.back() > prec )
+        result.push_back(coords[k]);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -152,7 +294,7 @@ bool asiAlgo_InterpolateSurfMesh::CollectInteriorNodes(const Handle(Poly_Triangu
   // Get all mesh nodes bounded by the contour.
   std::vector<t_gridNode> reperNodes;
   //
-  if ( !collectInteriorNodes(tris, contour, boxClipping,
+  if ( !collectInteriorNodes(tris, contour, boxClipping, true,
                              NodeFilter, plane, reperNodes, curID, size,
                              progress, plotter) )
   {
@@ -175,7 +317,8 @@ asiAlgo_InterpolateSurfMesh::asiAlgo_InterpolateSurfMesh(const Handle(Poly_Trian
                                                          ActAPI_ProgressEntry              progress,
                                                          ActAPI_PlotterEntry               plotter)
 : ActAPI_IAlgorithm (progress, plotter),
-  m_tris            (tris)
+  m_tris            (tris),
+  m_bIsParallel     (true)
 {
 }
 
@@ -215,9 +358,9 @@ bool asiAlgo_InterpolateSurfMesh::performInternal(const std::vector<gp_XYZ>&   c
   NCollection_CellFilter<InspectNode> NodeFilter( Precision::Confusion() );
 
   // Get all mesh nodes bounded by the contour.
-  std::vector<t_gridNode> allNodes, reperNodes;
+  std::vector<t_gridNode> reperNodes;
   //
-  if ( !collectInteriorNodes(m_tris, contour, true,
+  if ( !collectInteriorNodes(m_tris, contour, true, m_bIsParallel,
                              NodeFilter, plane, reperNodes, curID, size,
                              m_progress, m_plotter) )
   {
@@ -225,207 +368,95 @@ bool asiAlgo_InterpolateSurfMesh::performInternal(const std::vector<gp_XYZ>&   c
     return false;
   }
 
-  /* ====================================================================
-   *  For each image point, generate all possible variants of grid nodes
-   * ==================================================================== */
+  /* ==============================================================
+   *  Select the coordinates of grid lines by the images of nodes
+   * ============================================================== */
 
+  // The grid is the tensor product of the (U,V) coordinates of all image
+  // points, so the rows and columns are defined by the sorted coordinates.
+  // Coordinates closer to each other than the grain distance are merged.
+  std::vector<double> uCoords, vCoords;
+  //
+  uCoords.reserve( reperNodes.size() );
+  vCoords.reserve( reperNodes.size() );
+  //
   for ( size_t k = 0; k < reperNodes.size(); ++k )
   {
-    const gp_XY& uv_k = reperNodes[k].uvInit;
-    const double u_k  = uv_k.X();
-    const double v_k  = uv_k.Y();
-
-    for ( size_t s = 0; s < reperNodes.size(); ++s )
-    {
-      if ( s == k ) continue;
-
-      const gp_XY& uv_s = reperNodes[s].uvInit;
-      const double u_s  = uv_s.X();
-      const double v_s  = uv_s.Y();
-
-      // Prepare a grid node structure.
-      {
-        t_gridNode node;
-        node.isContourPoint  = false;
-        node.isSampledPoint  = true;
-        node.isMeshNodePoint = false;
-        node.uvInit          = gp_XY(u_k, v_s);
-        node.xyzInit         = plane->Value( node.uvInit.X(), node.uvInit.Y() ).XYZ();
-
-        // Add node.
-        ::appendNodeInGlobalCollection(node, curID, allNodes, NodeFilter);
-      }
-
-      // Prepare a grid node structure.
-      {
-        t_gridNode node;
-        node.isContourPoint  = false;
-        node.isSampledPoint  = true;
-        node.isMeshNodePoint = false;
-        node.uvInit          = gp_XY(u_s, v_k);
-        node.xyzInit         = plane->Value(node.uvInit.X(), node.uvInit.Y()).XYZ();
-
-        // Add node
-        ::appendNodeInGlobalCollection(node, curID, allNodes, NodeFilter);
-      }
-    }
-  }
-
-  /* =============================================================
-   *  Sort nodes to get a structured grid (make topology of grid)
-   * ============================================================= */
-
-  TColStd_PackedMapOfInteger visited;
-
-  std::vector< std::vector<t_gridNode> > uvGridNodes;
-
-  const double prec = RealEpsilon();
-  bool stop = false;
-  do
-  {
-    // Find minimum V coordinate.
-    double minV = DBL_MAX;
-    //
-    for ( int i = 0; i < int( allNodes.size() ); ++i )
-    {
-      if ( visited.Contains(i) )
-        continue;
-
-      const double currV = allNodes[i].uvInit.Y();
-      //
-      if ( currV < minV )
-        minV = currV;
-    }
-
-    if ( minV == DBL_MAX )
-      stop = true;
-    else
-    {
-      std::vector<t_gridNode> vIsoNodes; // Fixed level of V.
-
-      // Collect all points with V coordinate equal to the passed value.
-      for ( int i = 0; i < int( allNodes.size() ); ++i )
-      {
-        if ( visited.Contains(i) )
-          continue;
-
-        const double currV = allNodes[i].uvInit.Y();
-        //
-        if ( Abs(currV - minV) < prec )
-        {
-          vIsoNodes.push_back(allNodes[i]);
-          visited.Add(i);
-        }
-      }
-
-      // Sort by value of U coordinate.
-      std::sort( vIsoNodes.begin(), vIsoNodes.end() );
-
-      // Add to grid.
-      uvGridNodes.push_back(vIsoNodes);
-    }
+    uCoords.push_back( reperNodes[k].uvInit.X() );
+    vCoords.push_back( reperNodes[k].uvInit.Y() );
   }
-  while ( !stop );
-
-  // Sparse rows (in U direction)
-  std::vector< std::vector<t_gridNode> > uvGridNodesSparsedU;
   //
-  double coincConf = size*grainCoeff;
-  {
-    TColStd_PackedMapOfInteger keptIndices;
-    RemoveCoincidentPoints(coincConf, uvGridNodes[0], keptIndices);
-    //
-    uvGridNodesSparsedU.push_back(uvGridNodes[0]);
-    //
-    for ( int i = 1; i < int( uvGridNodes.size() ); ++i )
-    {
-      std::vector<t_gridNode> sparsedIso;
-      for ( int j = 0; j < int( uvGridNodes[i].size() ); ++j )
-      {
-        if ( keptIndices.Contains(j) )
-          sparsedIso.push_back(uvGridNodes[i][j]);
-      }
-      uvGridNodesSparsedU.push_back(sparsedIso);
-    }
-  }
+  std::sort( uCoords.begin(), uCoords.end() );
+  std::sort( vCoords.begin(), vCoords.end() );
 
-  // Sparse cols (in V direction)
-  std::vector< std::vector<t_gridNode> > uvGridNodesSparsed;
+  const double coincConf = Max(size*grainCoeff, Precision::Confusion());
   //
-  std::vector<t_gridNode> col;
+  std::vector<double> uSparsed, vSparsed;
+  SparseCoords(uCoords, coincConf, uSparsed);
+  SparseCoords(vCoords, coincConf, vSparsed);
   //
-  for ( int i = 0; i < int( uvGridNodesSparsedU.size() ); ++i )
+  if ( uSparsed.size() < 2 || vSparsed.size() < 2 )
   {
-    col.push_back(uvGridNodesSparsedU[i][0]);
+    m_progress.SendLogMessage(LogErr(Normal) << "Not enough nodes to build interpolation grid.");
+    return false;
   }
   //
+  m_progress.SendLogMessage( LogInfo(Normal) << "Interpolation grid has %1 x %2 nodes."
+                                             << int( vSparsed.size() )
+                                             << int( uSparsed.size() ) );
+
+  // Sample grid nodes on the average plane.
+  std::vector< std::vector<t_gridNode> > uvGridNodesSparsed( vSparsed.size() );
+  //
+  for ( size_t i = 0; i < vSparsed.size(); ++i )
   {
-    TColStd_PackedMapOfInteger keptIndices;
-    RemoveCoincidentPoints(coincConf, col, keptIndices);
+    uvGridNodesSparsed[i].resize( uSparsed.size() );
     //
-    for ( int i = 0; i < int( uvGridNodesSparsedU.size() ); ++i )
+    for ( size_t j = 0; j < uSparsed.size(); ++j )
     {
-      if ( keptIndices.Contains(i) )
-        uvGridNodesSparsed.push_back(uvGridNodesSparsedU[i]);
+      t_gridNode& node = uvGridNodesSparsed[i][j];
+      //
+      node.id             = int( i*uSparsed.size() + j );
+      node.isSampledPoint = true;
+      node.uvInit         = gp_XY(uSparsed[j], vSparsed[i]);
+      node.xyzInit        = plane->Value( node.uvInit.X(), node.uvInit.Y() ).XYZ();
     }
   }
 
-  /*for ( size_t i = 0; i < uvGridNodesSparsed.size(); ++i )
-  {
-    for ( size_t j = 0; j < uvGridNodesSparsed[i].size(); ++j )
-    {
-      m_plotter.DRAW_POINT(uvGridNodesSparsed[i][j].uvInit,  uvGridNodesSparsed[i][j].isContourPoint ? Color_Red : Color_Blue, "uvInit");
-      m_plotter.DRAW_POINT(uvGridNodesSparsed[i][j].xyzInit, uvGridNodesSparsed[i][j].isContourPoint ? Color_Red : Color_Blue, "xyzInit");
-    }
-  }*/
-
   /* =========================================================
    *  Correct 3D positions of sampled nodes according to mesh
    * ========================================================= */
 
-  asiAlgo_HitFacet picker(m_bvh, m_progress, m_plotter);
+  TIMER_NEW
+  TIMER_GO
 
-  // Get norm of the plane.
-  const gp_Dir& planeNorm = plane->Axis().Direction();
+  // Build BVH before projection as it is constructed lazily.
+  m_bvh->BVH();
 
-  for ( size_t i = 0; i < uvGridNodesSparsed.size(); ++i )
-  {
-    for ( size_t j = 0; j < uvGridNodesSparsed[i].size(); ++j )
-    {
-      gp_Lin ray1( uvGridNodesSparsed[i][j].xyzInit, planeNorm );
-      gp_Lin ray2( uvGridNodesSparsed[i][j].xyzInit, planeNorm.Reversed() );
+  std::vector<int> numFailed( uvGridNodesSparsed.size(), 0 );
+  //
+  ProjectGridFunctor projectFunc( m_bvh,
+                                  plane->Axis().Direction(),
+                                  uvGridNodesSparsed,
+                                  numFailed );
+  //
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for(tbb::blocked_range<int>(0, int( uvGridNodesSparsed.size() ), 1), projectFunc);
+  else
+#endif
+    projectFunc.Process( 0, int( uvGridNodesSparsed.size() ) );
 
-      int facetId1, facetId2;
-      gp_XYZ xyz1, xyz2;
-      //
-      const bool isOk1 = picker(ray1, facetId1, xyz1);
-      const bool isOk2 = picker(ray2, facetId2, xyz2);
-      //
-      if ( !isOk1 && !isOk2 )
-      {
-        m_progress.SendLogMessage(LogWarn(Normal) << "Cannot precise grid point.");
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Project grid nodes")
 
-#if defined DRAW_DEBUG
-        m_plotter.DRAW_POINT(uvGridNodesSparsed[i][j].xyzInit, Color_Red, "cannot_precise");
-#endif
-      }
-      //
-      if ( isOk1 && isOk2 )
-      {
-        // Take closest.
-        const double d1 = (uvGridNodesSparsed[i][j].xyzInit - xyz1).Modulus();
-        const double d2 = (uvGridNodesSparsed[i][j].xyzInit - xyz2).Modulus();
-        //
-        uvGridNodesSparsed[i][j].xyz = ( (d1 < d2) ? xyz1 : xyz2 );
-      }
-      else if ( isOk1 )
-        uvGridNodesSparsed[i][j].xyz = xyz1;
-      else if ( isOk2 )
-        uvGridNodesSparsed[i][j].xyz = xyz2;
-      else
-        uvGridNodesSparsed[i][j].xyz = uvGridNodesSparsed[i][j].xyzInit;
-    }
-  }
+  int numFailedTotal = 0;
+  for ( size_t i = 0; i < numFailed.size(); ++i )
+    numFailedTotal += numFailed[i];
+  //
+  if ( numFailedTotal )
+    m_progress.SendLogMessage( LogWarn(Normal) << "Cannot precise %1 grid point(s)."
+                                               << numFailedTotal );
 
 #if defined DRAW_DEBUG
   Handle(HRealArray) pts = new HRealArray(0, int( uvGridNodesSparsed.size()*uvGridNodesSparsed[0].size() )*3 - 1);
@@ -514,6 +545,7 @@ bool asiAlgo_InterpolateSurfMesh::performInternal(const std::vector<gp_XYZ>&   c
 bool asiAlgo_InterpolateSurfMesh::collectInteriorNodes(const Handle(Poly_Triangulation)&    tris,
                                                        const std::vector<gp_XYZ>&           contour,
                                                        const bool                           boxClipping,
+                                                       const bool                           isParallel,
                                                        NCollection_CellFilter<InspectNode>& filter,
                                                        Handle(Geom_Plane)&                  avrPlane,
                                                        std::vector<t_gridNode>&             pts,
@@ -627,22 +659,34 @@ bool asiAlgo_InterpolateSurfMesh::collectInteriorNodes(const Handle(Poly_Triangu
    *  Add points representing mesh nodes
    * ==================================== */
 
-  asiAlgo_ClassifyPointFace classifier(F, 1e-4, 1e-4);
+  TIMER_NEW
+  TIMER_GO
 
-  const TColgp_Array1OfPnt& triNodes = tris->Nodes();
-
-  for ( int k = triNodes.Lower(); k <= triNodes.Upper(); ++k )
-  {
-    const gp_Pnt& triNode = triNodes(k);
-    //
-    if ( boxClipping && contourAABB.IsOut(triNode) )
-      continue;
+  const gp_Pln              pln       = avrPlane->Pln();
+  const TColgp_Array1OfPnt& triNodes  = tris->Nodes();
+  const int                 numNodes  = triNodes.Length();
+  const int                 numBlocks = (numNodes + NodeBlockSize - 1) / NodeBlockSize;
 
-    ShapeAnalysis_Surface SAS(avrPlane);
-    gp_Pnt2d UV = SAS.ValueOfUV(triNode, 1.0e-1);
+  // Project and classify the mesh nodes concurrently.
+  std::vector<gp_XY> nodeUVs(numNodes);
+  std::vector<char>  isNodeIn(numNodes, 0);
+  //
+  ClassifyNodesFunctor classifyFunc( triNodes, pln, F,
+                                     boxClipping, contourAABB,
+                                     nodeUVs, isNodeIn );
+  //
+#ifdef USE_THREADING
+  if ( isParallel )
+    tbb::parallel_for(tbb::blocked_range<int>(0, numBlocks, 1), classifyFunc);
+  else
+#endif
+    classifyFunc.Process(0, numBlocks);
 
-    // Classify against the two-dimensional contour.
-    if ( classifier(UV) != Membership_In )
+  // Add the interior nodes in their original order, so that the node IDs
+  // do not depend on the multithreading mode.
+  for ( int k = 0; k < numNodes; ++k )
+  {
+    if ( !isNodeIn[k] )
       continue;
 
     // Prepare a grid node structure.
@@ -650,13 +694,16 @@ bool asiAlgo_InterpolateSurfMesh::collectInteriorNodes(const Handle(Poly_Triangu
     node.isContourPoint  = false;
     node.isSampledPoint  = false;
     node.isMeshNodePoint = true;
-    node.uvInit          = UV.XY();
-    node.xyzInit         = triNode.XYZ();
+    node.uvInit          = nodeUVs[k];
+    node.xyzInit         = triNodes(triNodes.Lower() + k).XYZ();
 
     // Add node.
     ::appendNodeInGlobalCollection(node, lastPtIdx, pts, filter);
   }
 
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(progress, "Collect interior mesh nodes")
+
 #if defined DRAW_DEBUG
   for ( size_t k = 0; k < pts.size(); ++k )
   {
@@ -670,6 +717,7 @@ bool asiAlgo_InterpolateSurfMesh::collectInteriorNodes(const Handle(Poly_Triangu
   asiAlgo_NotUsed(tris);
   asiAlgo_NotUsed(contour);
   asiAlgo_NotUsed(boxClipping);
+  asiAlgo_NotUsed(isParallel);
   asiAlgo_NotUsed(filter);
   asiAlgo_NotUsed(avrPlane);
   asiAlgo_NotUsed(pts);
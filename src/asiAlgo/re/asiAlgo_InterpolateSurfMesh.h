@@ -106,7 +106,8 @@ public:
     //! Implementation of inspection method.
     NCollection_CellFilter_Action Inspect(const gp_XY& Target)
     {
-      m_bFound = ( (m_P - Target).SquareModulus() <= Square(m_fResolution) );
+      if ( (m_P - Target).SquareModulus() <= Square(m_fResolution) )
+        m_bFound = true;
       return CellFilter_Keep;
     }
 
@@ -133,9 +134,11 @@ public:
     //! Implementation of inspection method.
     NCollection_CellFilter_Action Inspect(const t_gridNode& Target)
     {
+      const bool wasFound = InspectXY::IsFound();
+
       InspectXY::Inspect(Target.uvInit);
 
-      if ( InspectXY::IsFound() )
+      if ( !wasFound && InspectXY::IsFound() )
         m_iID = Target.id;
 
       return CellFilter_Keep;
@@ -176,6 +179,13 @@ public:
     m_bvh = bvh;
   }
 
+  //! Sets multithreading mode (parallel or sequential).
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
 protected:
 
   asiAlgo_EXPORT bool
@@ -189,6 +199,7 @@ protected:
     collectInteriorNodes(const Handle(Poly_Triangulation)&    tris,
                          const std::vector<gp_XYZ>&           contour,
                          const bool                           boxClipping,
+                         const bool                           isParallel,
                          NCollection_CellFilter<InspectNode>& filter,
                          Handle(Geom_Plane)&                  avrPlane,
                          std::vector<t_gridNode>&             pts,
@@ -199,8 +210,9 @@ protected:
 
 protected:
 
-  Handle(Poly_Triangulation) m_tris; //!< Triangulation in question.
-  Handle(asiAlgo_BVHFacets)  m_bvh;  //!< Accelerating structure for triangulation.
+  Handle(Poly_Triangulation) m_tris;        //!< Triangulation in question.
+  Handle(asiAlgo_BVHFacets)  m_bvh;         //!< Accelerating structure for triangulation.
+  bool                       m_bIsParallel; //!< Multithreading mode.
 
 };
 
@@ -0,0 +1,234 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiAlgo_TDigest.h>
+
+// Standard includes
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  const double Pi = 3.14159265358979323846;
+
+  //! Scale function mapping quantiles to the indices of centroids. Its
+  //! slope is steep at the tails, so the centroids are small there.
+  double K(const double q, const double delta)
+  {
+    return delta / (2.*Pi) * std::asin(2.*q - 1.);
+  }
+
+  //! Inverse of the scale function.
+  double Q(const double k, const double delta)
+  {
+    if ( k >= delta / 4. )
+      return 1.;
+
+    return ( std::sin(k * 2.*Pi / delta) + 1. ) / 2.;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+asiAlgo_TDigest::asiAlgo_TDigest(const double compression)
+: m_fCompression (compression),
+  m_fTotal       (0.),
+  m_fBuffered    (0.),
+  m_fMin         (DBL_MAX),
+  m_fMax         (-DBL_MAX)
+{}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TDigest::Add(const double value, const double weight)
+{
+  m_buffer.push_back( t_centroid(value, weight) );
+  m_fBuffered += weight;
+
+  m_fMin = std::min(m_fMin, value);
+  m_fMax = std::max(m_fMax, value);
+
+  // Keep the buffer proportional to the number of centroids.
+  if ( m_buffer.size() >= size_t(10.*m_fCompression) )
+    this->compress();
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TDigest::Merge(const asiAlgo_TDigest& other)
+{
+  other.flush();
+
+  if ( other.m_centroids.empty() )
+    return;
+
+  m_buffer.insert( m_buffer.end(), other.m_centroids.begin(), other.m_centroids.end() );
+  m_fBuffered += other.m_fTotal;
+
+  m_fMin = std::min(m_fMin, other.m_fMin);
+  m_fMax = std::max(m_fMax, other.m_fMax);
+
+  this->compress();
+}
+
+//-----------------------------------------------------------------------------
+
+double asiAlgo_TDigest::Quantile(const double q) const
+{
+  this->flush();
+
+  if ( m_centroids.empty() )
+    return 0.;
+
+  if ( m_centroids.size() == 1 )
+    return m_centroids[0].Mean;
+
+  const double target = std::min( std::max(q, 0.), 1. ) * m_fTotal;
+
+  // Between min value and the center of the first centroid.
+  const t_centroid& first = m_centroids.front();
+  //
+  if ( target < first.Weight / 2. )
+    return m_fMin + (first.Mean - m_fMin) * target / (first.Weight / 2.);
+
+  // Between the center of the last centroid and max value.
+  const t_centroid& last = m_centroids.back();
+  //
+  if ( target > m_fTotal - last.Weight / 2. )
+    return last.Mean + (m_fMax - last.Mean) * (target - m_fTotal + last.Weight / 2.) / (last.Weight / 2.);
+
+  // Interpolate between the centers of the neighbor centroids.
+  double cumulative = first.Weight / 2.;
+  //
+  for ( size_t i = 0; i + 1 < m_centroids.size(); ++i )
+  {
+    const double dw = (m_centroids[i].Weight + m_centroids[i + 1].Weight) / 2.;
+    //
+    if ( target <= cumulative + dw )
+      return m_centroids[i].Mean + (m_centroids[i + 1].Mean - m_centroids[i].Mean) * (target - cumulative) / dw;
+
+    cumulative += dw;
+  }
+
+  return last.Mean;
+}
+
+//-----------------------------------------------------------------------------
+
+double asiAlgo_TDigest::CDF(const double x) const
+{
+  this->flush();
+
+  if ( m_centroids.empty() || x < m_fMin )
+    return 0.;
+
+  if ( x >= m_fMax )
+    return 1.;
+
+  // Between min value and the center of the first centroid.
+  const t_centroid& first = m_centroids.front();
+  //
+  if ( x < first.Mean )
+    return (first.Weight / 2.) * (x - m_fMin) / std::max(first.Mean - m_fMin, DBL_MIN) / m_fTotal;
+
+  // Between the center of the last centroid and max value.
+  const t_centroid& last = m_centroids.back();
+  //
+  if ( x >= last.Mean )
+    return ( m_fTotal - (last.Weight / 2.) * (m_fMax - x) / std::max(m_fMax - last.Mean, DBL_MIN) ) / m_fTotal;
+
+  // Interpolate between the centers of the neighbor centroids.
+  double cumulative = first.Weight / 2.;
+  //
+  for ( size_t i = 0; i + 1 < m_centroids.size(); ++i )
+  {
+    const double dw = (m_centroids[i].Weight + m_centroids[i + 1].Weight) / 2.;
+    //
+    if ( x < m_centroids[i + 1].Mean )
+    {
+      const double dm = m_centroids[i + 1].Mean - m_centroids[i].Mean;
+      //
+      return ( cumulative + dw * (x - m_centroids[i].Mean) / std::max(dm, DBL_MIN) ) / m_fTotal;
+    }
+
+    cumulative += dw;
+  }
+
+  return 1.;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiAlgo_TDigest::compress()
+{
+  if ( m_buffer.empty() )
+    return;
+
+  m_buffer.insert( m_buffer.end(), m_centroids.begin(), m_centroids.end() );
+  std::sort( m_buffer.begin(), m_buffer.end() );
+
+  const double total = m_fTotal + m_fBuffered;
+
+  m_centroids.clear();
+
+  // Merge the sorted clusters while the size of the current centroid is
+  // within the limit given by the scale function.
+  t_centroid current     = m_buffer[0];
+  double     weightSoFar = 0.;
+  double     weightLimit = total * Q(K(0., m_fCompression) + 1., m_fCompression);
+  //
+  for ( size_t i = 1; i < m_buffer.size(); ++i )
+  {
+    const t_centroid& next = m_buffer[i];
+    //
+    if ( weightSoFar + current.Weight + next.Weight <= weightLimit )
+    {
+      current.Mean   += (next.Mean - current.Mean) * next.Weight / (current.Weight + next.Weight);
+      current.Weight += next.Weight;
+    }
+    else
+    {
+      weightSoFar += current.Weight;
+      weightLimit  = total * Q(K(weightSoFar / total, m_fCompression) + 1., m_fCompression);
+      //
+      m_centroids.push_back(current);
+      current = next;
+    }
+  }
+  m_centroids.push_back(current);
+
+  m_buffer.clear();
+  m_fTotal    = total;
+  m_fBuffered = 0.;
+}
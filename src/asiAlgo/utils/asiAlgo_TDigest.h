@@ -0,0 +1,142 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiAlgo_TDigest_h
+#define asiAlgo_TDigest_h
+
+// asiAlgo includes
+#include <asiAlgo.h>
+
+// Standard includes
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+//! Streaming estimator of quantiles (t-digest by T. Dunning). The values
+//! are clustered into weighted centroids, which are small near the tails
+//! of the distribution and large in the middle, so the extreme quantiles
+//! are estimated accurately with a bounded memory. The digests computed
+//! for different portions of data can be merged, which makes them suitable
+//! for parallel accumulation.
+class asiAlgo_TDigest
+{
+public:
+
+  //! Ctor.
+  //! \param[in] compression max number of centroids is about twice this value.
+  asiAlgo_EXPORT
+    asiAlgo_TDigest(const double compression = 100.);
+
+public:
+
+  //! Adds value to the digest.
+  //! \param[in] value  value to add.
+  //! \param[in] weight weight of the value.
+  asiAlgo_EXPORT void
+    Add(const double value, const double weight = 1.);
+
+  //! Merges another digest into this one.
+  //! \param[in] other digest to merge.
+  asiAlgo_EXPORT void
+    Merge(const asiAlgo_TDigest& other);
+
+  //! Estimates the value at the given quantile.
+  //! \param[in] q quantile in [0, 1] range.
+  //! \return estimated value or 0 if the digest is empty.
+  asiAlgo_EXPORT double
+    Quantile(const double q) const;
+
+  //! Estimates the fraction of values not greater than the given one.
+  //! \param[in] x value in question.
+  //! \return cumulative distribution function in [0, 1] range.
+  asiAlgo_EXPORT double
+    CDF(const double x) const;
+
+public:
+
+  //! \return total weight of the added values.
+  double GetTotalWeight() const
+  {
+    return m_fTotal + m_fBuffered;
+  }
+
+  //! \return min added value.
+  double GetMin() const
+  {
+    return m_fMin;
+  }
+
+  //! \return max added value.
+  double GetMax() const
+  {
+    return m_fMax;
+  }
+
+protected:
+
+  //! Weighted cluster of values.
+  struct t_centroid
+  {
+    double Mean;   //!< Mean value.
+    double Weight; //!< Number of values.
+
+    t_centroid() : Mean(0.), Weight(0.) {}
+    t_centroid(const double m, const double w) : Mean(m), Weight(w) {}
+
+    bool operator<(const t_centroid& other) const
+    {
+      return Mean < other.Mean;
+    }
+  };
+
+  //! Merges the buffered values into the centroids.
+  asiAlgo_EXPORT void
+    compress();
+
+  //! Merges the buffered values into the centroids (const accessors).
+  void flush() const
+  {
+    if ( !m_buffer.empty() )
+      const_cast<asiAlgo_TDigest*>(this)->compress();
+  }
+
+protected:
+
+  double                  m_fCompression; //!< Compression parameter.
+  std::vector<t_centroid> m_centroids;    //!< Centroids sorted by means.
+  std::vector<t_centroid> m_buffer;       //!< Values not merged yet.
+  double                  m_fTotal;       //!< Total weight of centroids.
+  double                  m_fBuffered;    //!< Total weight of buffer.
+  double                  m_fMin;         //!< Min value.
+  double                  m_fMax;         //!< Max value.
+
+};
+
+#endif
@@ -0,0 +1,279 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiEngine_FuncScheduler.h>
+
+// asiEngine includes
+#include <asiEngine_StagedFunc.h>
+
+// asiAlgo includes
+#include <asiAlgo_Timer.h>
+
+// Active Data includes
+#include <ActData_DependencyGraph.h>
+#include <ActData_LogBook.h>
+
+// Standard includes
+#include <map>
+#include <set>
+#include <vector>
+
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Job of a staged function computed in advance.
+  struct t_stagedJob
+  {
+    Handle(asiEngine_StagedFunc) Func;   //!< Staged function.
+    Handle(Standard_Transient)   Job;    //!< Prepared job.
+    TCollection_AsciiString      Key;      //!< Key of the job.
+    unsigned long long           Hash;     //!< Hash of the job's inputs.
+    bool                         IsCached; //!< Whether the results are cached.
+    bool                         IsDone;   //!< Whether the job is computed.
+
+    t_stagedJob() : Hash(0), IsCached(false), IsDone(false) {} //!< Ctor.
+  };
+
+  //! Functor computing the prepared jobs.
+  class ComputeFunctor
+  {
+  public:
+
+    ComputeFunctor(std::vector<t_stagedJob>& jobs) : m_jobs(jobs) {}
+
+    void Process(const int first, const int last) const
+    {
+      // Diagnostic tools are not thread-safe, so the jobs are computed
+      // silently. The failed ones are recomputed on execution.
+      for ( int k = first; k < last; ++k )
+        if ( !m_jobs[k].IsCached )
+          m_jobs[k].IsDone = m_jobs[k].Func->Compute(m_jobs[k].Job, nullptr, nullptr);
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    std::vector<t_stagedJob>& m_jobs; //!< Jobs to compute.
+  };
+
+  //! Checks whether the Tree Function or any of its arguments is modified.
+  //! \param[in] vertex vertex of the execution graph.
+  //! \return true if the function is pending, false -- otherwise.
+  bool IsModified(const ActData_DependencyGraph::VertexData& vertex)
+  {
+    if ( ActData_LogBook::IsModifiedCursor(vertex.Parameter) )
+      return true;
+
+    Handle(ActAPI_HParameterList) args = vertex.Parameter->Arguments();
+    //
+    if ( args.IsNull() )
+      return false;
+
+    for ( ActAPI_HParameterList::Iterator it(*args); it.More(); it.Next() )
+      if ( ActData_LogBook::IsModifiedCursor( it.Value() ) )
+        return true;
+
+    return false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+int asiEngine_FuncScheduler::ExecuteAll()
+{
+  /* ===================
+   *  Find the ready set
+   * =================== */
+
+  Handle(ActData_DependencyGraph) graph = new ActData_DependencyGraph(m_model);
+  //
+  const ActData_DependencyGraph::VertexDataMap& vertices = graph->Vertices();
+  const ActData_DependencyGraph::EdgeMap&       arcs     = graph->Edges();
+
+  // Dependent functions.
+  std::map< int, std::vector<int> > successors;
+  //
+  for ( ActData_DependencyGraph::EdgeMap::Iterator arcIt(arcs); arcIt.More(); arcIt.Next() )
+  {
+    const ActData_DependencyGraph::OriEdge& arc = arcIt.Value();
+    successors[arc.V1].push_back(arc.V2);
+  }
+
+  // Functions modified directly.
+  std::set<int> modified;
+  //
+  for ( ActData_DependencyGraph::VertexDataMap::Iterator vIt(vertices); vIt.More(); vIt.Next() )
+    if ( IsModified( vIt.Value() ) )
+      modified.insert( vIt.Key() );
+
+  // Functions waiting for other pending functions.
+  std::set<int>    blocked;
+  std::vector<int> stack;
+  //
+  for ( std::set<int>::const_iterator mit = modified.begin(); mit != modified.end(); ++mit )
+    stack.insert( stack.end(), successors[*mit].begin(), successors[*mit].end() );
+  //
+  while ( !stack.empty() )
+  {
+    const int v = stack.back();
+    stack.pop_back();
+
+    if ( blocked.insert(v).second )
+      stack.insert( stack.end(), successors[v].begin(), successors[v].end() );
+  }
+
+  /* =========================================
+   *  Prepare staged functions on main thread
+   * ========================================= */
+
+  const Handle(asiEngine_FuncCache)& cache = m_model->GetFuncCache();
+
+  // The functions are prepared in a fixed order, so the LRU cache smaller
+  // than the number of staged functions would evict every entry before
+  // its reuse. The capacity is grown to keep the current and the previous
+  // results of each staged function.
+  int numStaged = 0;
+  //
+  for ( ActData_DependencyGraph::VertexDataMap::Iterator vIt(vertices); vIt.More(); vIt.Next() )
+    if ( !Handle(asiEngine_StagedFunc)::DownCast(vIt.Value().TreeFunction).IsNull() )
+      numStaged++;
+  //
+  if ( 2*numStaged > cache->GetCapacity() )
+    cache->SetCapacity(2*numStaged);
+
+  std::vector<t_stagedJob> jobs;
+  int                      numPending = int( blocked.size() );
+  int                      numCached  = 0;
+  //
+  for ( std::set<int>::const_iterator mit = modified.begin(); mit != modified.end(); ++mit )
+  {
+    if ( blocked.count(*mit) )
+      continue;
+
+    numPending++;
+
+    const ActData_DependencyGraph::VertexData& vertex = vertices(*mit);
+
+    Handle(asiEngine_StagedFunc)
+      func = Handle(asiEngine_StagedFunc)::DownCast(vertex.TreeFunction);
+    //
+    if ( func.IsNull() || func->IsHeavy() )
+      continue;
+
+    Handle(ActAPI_HParameterList) outputs = vertex.Parameter->Results();
+
+    t_stagedJob stagedJob;
+    stagedJob.Func = func;
+    stagedJob.Key  = func->GetJobKey(outputs);
+    stagedJob.Job  = func->Prepare(vertex.Parameter->Arguments(), outputs, m_model);
+    //
+    if ( stagedJob.Job.IsNull() )
+      continue;
+
+    // Take the results from the cache if the inputs are unchanged.
+    stagedJob.Hash = func->HashInputs(stagedJob.Job);
+    //
+    Handle(Standard_Transient) cached = cache->Find(stagedJob.Key, stagedJob.Hash);
+    //
+    if ( !cached.IsNull() )
+    {
+      func->RestoreResults(cached, stagedJob.Job);
+
+      stagedJob.IsCached = stagedJob.IsDone = true;
+      numCached++;
+    }
+
+    jobs.push_back(stagedJob);
+  }
+
+  /* ==============
+   *  Compute jobs
+   * ============== */
+
+  TIMER_NEW
+  TIMER_GO
+
+  ComputeFunctor computeFunc(jobs);
+  //
+#ifdef USE_THREADING
+  if ( m_bIsParallel )
+    tbb::parallel_for(tbb::blocked_range<int>( 0, int( jobs.size() ) ), computeFunc);
+  else
+#endif
+    computeFunc.Process( 0, int( jobs.size() ) );
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Concurrent computation of tree functions")
+
+  int numDone = 0;
+  //
+  for ( size_t k = 0; k < jobs.size(); ++k )
+  {
+    if ( !jobs[k].IsDone )
+      continue;
+
+    if ( !jobs[k].IsCached )
+    {
+      cache->Store( jobs[k].Key, jobs[k].Hash, jobs[k].Func->CacheResults(jobs[k].Job) );
+      numDone++;
+    }
+
+    m_model->BindFuncJob(jobs[k].Key, jobs[k].Job);
+  }
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "%1 of %2 pending tree functions computed concurrently, "
+                                                "%3 taken from cache."
+                                             << numDone << numPending << numCached );
+
+  /* ===========================
+   *  Execute and write results
+   * =========================== */
+
+  const int status = m_model->FuncExecuteAll();
+
+  // Drop the jobs which have not been taken by the functions.
+  m_model->ClearFuncJobs();
+
+  return status;
+}
@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiEngine_FuncScheduler_h
+#define asiEngine_FuncScheduler_h
+
+// asiEngine includes
+#include <asiEngine_Base.h>
+
+//-----------------------------------------------------------------------------
+
+//! Executes the pending Tree Functions of the Data Model running the heavy
+//! parts of independent functions concurrently.
+//!
+//! The scheduler takes the execution graph of the Model and finds the ready
+//! set, i.e., the pending functions which do not depend on other pending
+//! functions. The staged functions of the ready set (see
+//! asiEngine_StagedFunc) read their inputs on the main thread, compute their
+//! jobs on a worker pool and pass them to the Model. Then all pending
+//! functions are executed by Active Data in the usual order, so the results
+//! are written to the Model on the main thread within the same transaction.
+//! The functions depending on other pending functions, such as patches
+//! depending on the edges being rebuilt, compute their jobs in a row when
+//! executed.
+class asiEngine_FuncScheduler : public asiEngine_Base
+{
+public:
+
+  //! Ctor.
+  //! \param[in] model    Data Model instance.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  asiEngine_FuncScheduler(const Handle(asiEngine_Model)& model,
+                          ActAPI_ProgressEntry           progress = nullptr,
+                          ActAPI_PlotterEntry            plotter  = nullptr)
+  //
+  : asiEngine_Base(model, progress, plotter), m_bIsParallel(true)
+  {}
+
+public:
+
+  //! Executes all pending Tree Functions. This method should be called
+  //! within an open transaction instead of FuncExecuteAll() of the Model.
+  //! The function cache of the Model is grown to twice the number of
+  //! staged functions in the graph.
+  //! \return execution status returned by the Model.
+  asiEngine_EXPORT int
+    ExecuteAll();
+
+public:
+
+  //! Sets multithreading mode (parallel or sequential).
+  //! \param[in] on Boolean value to set.
+  void SetParallelMode(const bool on)
+  {
+    m_bIsParallel = on;
+  }
+
+  //! \return true if the parallel mode is on.
+  bool IsParallelMode() const
+  {
+    return m_bIsParallel;
+  }
+
+protected:
+
+  bool m_bIsParallel; //!< Multithreading mode.
+
+};
+
+#endif
@@ -119,7 +119,9 @@ REGISTER_NODE_TYPE(asiData_IVTextNode)
 //! Default constructor. Initializes Base Model foundation object so that
 //! to enable Extended Transaction Mode.
 asiEngine_Model::asiEngine_Model() : ActData_BaseModel(true)
-{}
+{
+  m_funcCache = new asiEngine_FuncCache;
+}
 
 //-----------------------------------------------------------------------------
 
@@ -279,6 +281,51 @@ Handle(asiData_ReTopoNode) asiEngine_Model::GetReTopoNode() const
 
 //-----------------------------------------------------------------------------
 
+//! Stores the job of a staged Tree Function computed in advance, so that
+//! the function only writes its results when executed.
+//! \param[in] key key of the job.
+//! \param[in] job computed job.
+void asiEngine_Model::BindFuncJob(const TCollection_AsciiString&    key,
+                                  const Handle(Standard_Transient)& job)
+{
+  m_funcJobs.Bind(key, job);
+}
+
+//-----------------------------------------------------------------------------
+
+//! Takes the job of a staged Tree Function computed in advance. The job is
+//! removed from the Model, so it is used once.
+//! \param[in] key key of the job.
+//! \return job or null if there is no job with the given key.
+Handle(Standard_Transient)
+  asiEngine_Model::ExtractFuncJob(const TCollection_AsciiString& key)
+{
+  Handle(Standard_Transient) job;
+  //
+  if ( m_funcJobs.Find(key, job) )
+    m_funcJobs.UnBind(key);
+
+  return job;
+}
+
+//-----------------------------------------------------------------------------
+
+//! Removes all jobs of staged Tree Functions computed in advance.
+void asiEngine_Model::ClearFuncJobs()
+{
+  m_funcJobs.Clear();
+}
+
+//-----------------------------------------------------------------------------
+
+//! \return cache of the results computed by staged Tree Functions.
+const Handle(asiEngine_FuncCache)& asiEngine_Model::GetFuncCache() const
+{
+  return m_funcCache;
+}
+
+//-----------------------------------------------------------------------------
+
 //! Initializes Partitions.
 void asiEngine_Model::initPartitions()
 {
@@ -426,4 +473,6 @@ Handle(ActData_CAFConverter) asiEngine_Model::converterApp()
 
 //! Callback for custom Data Model clean up logic.
 void asiEngine_Model::clearCustom()
-{}
+{
+  m_funcCache->Clear();
+}
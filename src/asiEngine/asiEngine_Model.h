@@ -33,6 +33,7 @@
 
 // asiEngine includes
 #include <asiEngine.h>
+#include <asiEngine_FuncCache.h>
 
 // asiData includes
 #include <asiData_BoundaryEdgesNode.h>
@@ -78,6 +79,10 @@
 // Active Data includes
 #include <ActData_BaseModel.h>
 
+// OCCT includes
+#include <NCollection_DataMap.hxx>
+#include <TCollection_AsciiString.hxx>
+
 //-----------------------------------------------------------------------------
 
 //! Standard implementation of Data Model in Analysis Situs. This
@@ -131,6 +136,23 @@ public:
   asiEngine_EXPORT Handle(asiData_ReTopoNode)
     GetReTopoNode() const;
 
+//-----------------------------------------------------------------------------
+// Staged execution of Tree Functions:
+public:
+
+  asiEngine_EXPORT void
+    BindFuncJob(const TCollection_AsciiString&    key,
+                const Handle(Standard_Transient)& job);
+
+  asiEngine_EXPORT Handle(Standard_Transient)
+    ExtractFuncJob(const TCollection_AsciiString& key);
+
+  asiEngine_EXPORT void
+    ClearFuncJobs();
+
+  asiEngine_EXPORT const Handle(asiEngine_FuncCache)&
+    GetFuncCache() const;
+
 //-----------------------------------------------------------------------------
 // Overridden:
 public:
@@ -514,6 +536,14 @@ protected:
   asiEngine_EXPORT virtual void
     clearCustom();
 
+protected:
+
+  //! Jobs of staged Tree Functions computed ahead of execution.
+  NCollection_DataMap<TCollection_AsciiString, Handle(Standard_Transient)> m_funcJobs;
+
+  //! Results of staged Tree Functions cached by their inputs.
+  Handle(asiEngine_FuncCache) m_funcCache;
+
 protected:
 
   //! IDs of the registered Partitions.
@@ -39,16 +39,25 @@
 #include <asiEngine_SmoothenPatchesFunc.h>
 
 // asiAlgo includes
+#include <asiAlgo_MeshProjectLine.h>
+#include <asiAlgo_PlateOnEdges.h>
 #include <asiAlgo_ProjectPointOnMesh.h>
+#include <asiAlgo_Timer.h>
 
 // Active Data includes
 #include <ActData_UniqueNodeName.h>
 
 // OCCT includes
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <OSD_Timer.hxx>
 #include <Poly_CoherentNode.hxx>
 #include <Poly_CoherentTriangle.hxx>
 #include <Poly_CoherentTriangulation.hxx>
 
+// Standard includes
+#include <algorithm>
+#include <unordered_map>
+
 #if defined USE_MOBIUS
   #include <mobius/cascade.h>
   #include <mobius/geom_BSplineSurface.h>
@@ -56,6 +65,12 @@
   using namespace mobius;
 #endif
 
+#ifdef USE_THREADING
+  // Intel TBB includes
+  #include <blocked_range.h>
+  #include <parallel_for.h>
+#endif
+
 #undef DRAW_DEBUG
 #if defined DRAW_DEBUG
   #pragma message("===== warning: DRAW_DEBUG is enabled")
@@ -63,6 +78,201 @@
 
 //-----------------------------------------------------------------------------
 
+namespace
+{
+  //! Number of network vertices or edges projected between progress steps.
+  const int ProjectBatchSize = 1024;
+
+  //! Job of filling a patch in batch mode.
+  struct t_fillPatchJob
+  {
+    Handle(asiData_RePatchNode)            Patch;       //!< Patch to fill.
+    std::vector<Handle(Geom_BSplineCurve)> Curves;      //!< Boundary curves.
+    int                                    MinNumKnots; //!< Min number of knots.
+    Handle(Geom_BSplineSurface)            Surf;        //!< Constructed surface.
+    double                                 Seconds;     //!< Elapsed time.
+    bool                                   IsDone;      //!< Whether the patch is filled.
+
+    t_fillPatchJob() : MinNumKnots(0), Seconds(0.), IsDone(false) {} //!< Ctor.
+  };
+
+  //! Functor filling the patches. The jobs only contain copies of the
+  //! boundary curves, so they are computed without accessing the Data Model.
+  class FillPatchFunctor
+  {
+  public:
+
+    FillPatchFunctor(const Handle(asiEngine_Model)& model,
+                     const bool                     usePlate,
+                     std::vector<t_fillPatchJob>&   jobs)
+    : m_model     (model),
+      m_bUsePlate (usePlate),
+      m_jobs      (jobs)
+    {}
+
+    void Process(const int first, const int last) const
+    {
+      // Diagnostic tools are not thread-safe, so the patches are filled
+      // silently. The failed ones are reported by the caller.
+      asiEngine_RE reApi(m_model, nullptr, nullptr);
+
+      for ( int k = first; k < last; ++k )
+      {
+        t_fillPatchJob& job = m_jobs[k];
+
+        if ( job.Curves.empty() )
+          continue;
+
+        OSD_Timer timer;
+        timer.Start();
+
+        if ( m_bUsePlate )
+          job.IsDone = reApi.FillPatchPlate(job.Curves, job.Surf);
+        else
+          job.IsDone = reApi.FillPatchCoons(job.Curves, job.MinNumKnots, job.Surf);
+
+        timer.Stop();
+        job.Seconds = timer.ElapsedTime();
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const Handle(asiEngine_Model)& m_model;     //!< Data Model instance.
+    bool                           m_bUsePlate; //!< Whether to use plate surfaces.
+    std::vector<t_fillPatchJob>&   m_jobs;      //!< Jobs to compute.
+  };
+
+  //! Vertex of a quad network.
+  struct t_networkVertex
+  {
+    int    Node;  //!< Zero-based index of the network node.
+    gp_XYZ Point; //!< Projected point.
+    int    Facet; //!< Index of the host facet (-1 if not projected).
+
+    t_networkVertex() : Node(-1), Facet(-1) {} //!< Ctor.
+  };
+
+  //! Edge of a quad network.
+  struct t_networkEdge
+  {
+    int                 V1;     //!< Zero-based index of the first vertex.
+    int                 V2;     //!< Zero-based index of the second vertex.
+    std::vector<gp_XYZ> Poles;  //!< Poles of the projected polyline.
+    std::vector<int>    Facets; //!< Host facets of the poles.
+    bool                IsDone; //!< Whether the edge is projected.
+
+    t_networkEdge() : V1(-1), V2(-1), IsDone(false) {} //!< Ctor.
+  };
+
+  //! Functor projecting the network vertices onto the mesh.
+  class ProjectVerticesFunctor
+  {
+  public:
+
+    ProjectVerticesFunctor(const Handle(asiAlgo_BVHFacets)& bvh,
+                           const std::vector<gp_XYZ>&       nodes,
+                           std::vector<t_networkVertex>&    vertices)
+    : m_bvh      (bvh),
+      m_nodes    (nodes),
+      m_vertices (vertices)
+    {}
+
+    void Process(const int first, const int last) const
+    {
+      // The projection tool keeps the facets of the last projected point,
+      // so each task has its own tool.
+      asiAlgo_ProjectPointOnMesh pointToMesh(m_bvh);
+
+      for ( int k = first; k < last; ++k )
+      {
+        t_networkVertex& vertex = m_vertices[k];
+
+        vertex.Point = pointToMesh.Perform( m_nodes[vertex.Node] ).XYZ();
+        vertex.Facet = pointToMesh.GetFacetIds().size() ? pointToMesh.GetFacetIds()[0] : -1;
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const Handle(asiAlgo_BVHFacets)& m_bvh;      //!< Mesh to project onto.
+    const std::vector<gp_XYZ>&       m_nodes;    //!< Network nodes.
+    std::vector<t_networkVertex>&    m_vertices; //!< Vertices to project.
+  };
+
+  //! Functor projecting the network edges onto the mesh.
+  class ProjectEdgesFunctor
+  {
+  public:
+
+    ProjectEdgesFunctor(const Handle(asiAlgo_BVHFacets)&    bvh,
+                        const double                        projTol,
+                        const std::vector<t_networkVertex>& vertices,
+                        std::vector<t_networkEdge>&         edges)
+    : m_bvh      (bvh),
+      m_fProjTol (projTol),
+      m_vertices (vertices),
+      m_edges    (edges)
+    {}
+
+    void Process(const int first, const int last) const
+    {
+      // Diagnostic tools are not thread-safe, so the edges are projected
+      // silently. The failed ones are reported by the caller.
+      asiAlgo_MeshProjectLine projectLine(m_bvh, nullptr, nullptr);
+
+      for ( int k = first; k < last; ++k )
+      {
+        t_networkEdge&         edge = m_edges[k];
+        const t_networkVertex& V1   = m_vertices[edge.V1];
+        const t_networkVertex& V2   = m_vertices[edge.V2];
+        //
+        if ( V1.Facet == -1 || V2.Facet == -1 )
+          continue;
+
+        edge.IsDone = projectLine.Perform(V1.Point, V2.Point, edge.Poles, edge.Facets, m_fProjTol);
+      }
+    }
+
+#ifdef USE_THREADING
+    void operator()(const tbb::blocked_range<int>& range) const
+    {
+      this->Process( range.begin(), range.end() );
+    }
+#endif
+
+  private:
+
+    const Handle(asiAlgo_BVHFacets)&    m_bvh;      //!< Mesh to project onto.
+    double                              m_fProjTol; //!< Projection precision.
+    const std::vector<t_networkVertex>& m_vertices; //!< Projected vertices.
+    std::vector<t_networkEdge>&         m_edges;    //!< Edges to project.
+  };
+
+  //! \return key of the undirected link between two vertices.
+  inline unsigned long long GetLinkKey(const int v1, const int v2)
+  {
+    return (v1 < v2) ? ( ( (unsigned long long) v1 << 32 ) | (unsigned long long) v2 )
+                     : ( ( (unsigned long long) v2 << 32 ) | (unsigned long long) v1 );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
 struct TriangleHasher
 {
   static int HashCode(const Poly_CoherentTriangle* object, const int upper)
@@ -757,18 +967,28 @@ bool asiEngine_RE::FillPatchCoons(const std::vector<Handle(asiData_ReCoedgeNode)
                                   const int                                        minNumKnots,
                                   Handle(Geom_BSplineSurface)&                     surf) const
 {
-#if defined USE_MOBIUS
-  if ( coedges.size() != 4 )
+  std::vector<Handle(Geom_BSplineCurve)> curves;
+  //
+  if ( !this->GetPatchCurves(coedges, curves) )
+    return false;
+
+  return this->FillPatchCoons(curves, minNumKnots, surf);
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiEngine_RE::GetPatchCurves(const std::vector<Handle(asiData_ReCoedgeNode)>& coedges,
+                                  std::vector<Handle(Geom_BSplineCurve)>&          curves) const
+{
+  if ( coedges.empty() )
   {
-    m_progress.SendLogMessage(LogErr(Normal) << "Only 4-sided contours are supported.");
+    m_progress.SendLogMessage(LogErr(Normal) << "No coedges in the contour.");
     return false;
   }
 
-  std::vector<Handle(Geom_BSplineCurve)> curves;
-
-  // Iterate over the coedges to collect curves for Coons interpolation. In
-  // this loop, all curves are collected taking into account the orientation
-  // flags stored in coedges, so that the 4-sided contour is properly oriented.
+  // Iterate over the coedges to collect curves for patch filling. In this
+  // loop, all curves are collected taking into account the orientation
+  // flags stored in coedges, so that the contour is properly oriented.
   for ( size_t k = 0; k < coedges.size(); ++k )
   {
     const Handle(asiData_ReCoedgeNode)& coedge = coedges[k];
@@ -797,11 +1017,27 @@ bool asiEngine_RE::FillPatchCoons(const std::vector<Handle(asiData_ReCoedgeNode)
 
     // Collect curves taking into account the orientation of edges.
     if ( coedge->IsSameSense() )
-      curves.push_back(bcurve);
+      curves.push_back( Handle(Geom_BSplineCurve)::DownCast( bcurve->Copy() ) );
     else
       curves.push_back( Handle(Geom_BSplineCurve)::DownCast( bcurve->Reversed() ) );
   }
 
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiEngine_RE::FillPatchCoons(const std::vector<Handle(Geom_BSplineCurve)>& curves,
+                                  const int                                     minNumKnots,
+                                  Handle(Geom_BSplineSurface)&                  surf) const
+{
+#if defined USE_MOBIUS
+  if ( curves.size() != 4 )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Only 4-sided contours are supported.");
+    return false;
+  }
+
   const double prec = Precision::Confusion();
 
   // C0 is the first curve in the list (the 1-st edge).
@@ -957,6 +1193,376 @@ bool asiEngine_RE::FillPatchCoons(const std::vector<Handle(asiData_ReCoedgeNode)
 
 //-----------------------------------------------------------------------------
 
+bool asiEngine_RE::FillPatchPlate(const std::vector<Handle(Geom_BSplineCurve)>& curves,
+                                  Handle(Geom_BSplineSurface)&                  surf) const
+{
+  if ( curves.size() < 2 )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "At least two curves are required for plate.");
+    return false;
+  }
+
+  // Plate is constructed on the edges without host faces, so that the
+  // curves themselves are used as pinpoint constraints.
+  Handle(TopTools_HSequenceOfShape) edges = new TopTools_HSequenceOfShape;
+  //
+  for ( size_t k = 0; k < curves.size(); ++k )
+    edges->Append( BRepBuilderAPI_MakeEdge(curves[k]).Edge() );
+
+  asiAlgo_PlateOnEdges plateOnEdges(m_progress, m_plotter);
+  //
+  if ( !plateOnEdges.BuildSurf(edges, 0, surf) )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Cannot build plate surface.");
+    return false;
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+int asiEngine_RE::FillPatches(const Handle(ActAPI_HNodeList)& patches,
+                              const bool                      usePlate,
+                              const bool                      isParallel) const
+{
+#ifndef USE_THREADING
+  asiEngine_NotUsed(isParallel);
+#endif
+
+  if ( patches.IsNull() )
+    return 0;
+
+  /* ===================================
+   *  Collect boundary curves of patches
+   * =================================== */
+
+  std::vector<t_fillPatchJob> jobs;
+  //
+  for ( ActAPI_HNodeList::Iterator nit(*patches); nit.More(); nit.Next() )
+  {
+    Handle(asiData_RePatchNode)
+      patch = Handle(asiData_RePatchNode)::DownCast( nit.Value() );
+    //
+    if ( patch.IsNull() || !patch->IsWellFormed() )
+      continue;
+
+    std::vector<Handle(asiData_ReCoedgeNode)> coedges;
+    //
+    for ( Handle(ActAPI_IChildIterator) cit = patch->GetChildIterator(); cit->More(); cit->Next() )
+    {
+      Handle(asiData_ReCoedgeNode)
+        coedge = Handle(asiData_ReCoedgeNode)::DownCast( cit->Value() );
+      //
+      if ( !coedge.IsNull() )
+        coedges.push_back(coedge);
+    }
+
+    t_fillPatchJob job;
+    job.Patch       = patch;
+    job.MinNumKnots = patch->GetMinNumKnots();
+    //
+    if ( !this->GetPatchCurves(coedges, job.Curves) )
+      job.Curves.clear();
+
+    jobs.push_back(job);
+  }
+
+  /* ==============
+   *  Fill patches
+   * ============== */
+
+  TIMER_NEW
+  TIMER_GO
+
+  FillPatchFunctor fillFunc(m_model, usePlate, jobs);
+  //
+#ifdef USE_THREADING
+  if ( isParallel )
+    tbb::parallel_for(tbb::blocked_range<int>( 0, int( jobs.size() ), 1 ), fillFunc);
+  else
+#endif
+    fillFunc.Process( 0, int( jobs.size() ) );
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Fill patches")
+
+  /* ==============================
+   *  Store surfaces in the patches
+   * ============================== */
+
+  int numDone = 0;
+  //
+  for ( size_t k = 0; k < jobs.size(); ++k )
+  {
+    const t_fillPatchJob& job = jobs[k];
+
+    if ( !job.IsDone )
+    {
+      m_progress.SendLogMessage( LogWarn(Normal) << "Cannot fill patch '%1'."
+                                                 << job.Patch->GetName() );
+      continue;
+    }
+
+    job.Patch->SetSurface(job.Surf);
+    numDone++;
+
+    m_progress.SendLogMessage( LogInfo(Normal) << "Patch '%1' is filled in %2 sec."
+                                               << job.Patch->GetName()
+                                               << job.Seconds );
+  }
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "%1 of %2 patches filled."
+                                             << numDone << int( jobs.size() ) );
+
+  return numDone;
+}
+
+//-----------------------------------------------------------------------------
+
+int asiEngine_RE::CreateQuadTopology(const std::vector<gp_XYZ>&       nodes,
+                                     const std::vector<int>&          quads,
+                                     const Handle(asiAlgo_BVHFacets)& bvh,
+                                     const double                     projTol,
+                                     Handle(ActAPI_HNodeList)&        edges,
+                                     const bool                       isParallel)
+{
+#ifndef USE_THREADING
+  asiEngine_NotUsed(isParallel);
+#endif
+
+  edges = new ActAPI_HNodeList;
+
+  const int numQuads = int( quads.size() ) / 4;
+
+  /* ===================================
+   *  Find shared vertices and edges
+   * =================================== */
+
+  TIMER_NEW
+  TIMER_GO
+
+  // The vertices and edges are numbered in the order of their first
+  // appearance in the quads.
+  std::vector<int>             nodeVertices(nodes.size(), -1);
+  std::vector<t_networkVertex> vertices;
+  //
+  for ( size_t k = 0; k < quads.size(); ++k )
+  {
+    if ( nodeVertices[quads[k]] != -1 )
+      continue;
+
+    nodeVertices[quads[k]] = int( vertices.size() );
+
+    t_networkVertex vertex;
+    vertex.Node = quads[k];
+    //
+    vertices.push_back(vertex);
+  }
+
+  // The edge is oriented as in the first quad referring to it, so the
+  // coedges of the other quads are reversed.
+  std::unordered_map<unsigned long long, int> linkEdges;
+  std::vector<t_networkEdge>                  networkEdges;
+  std::vector<int>                            quadEdges( quads.size() );
+  std::vector<bool>                           quadSenses( quads.size() );
+  //
+  for ( int q = 0; q < numQuads; ++q )
+  {
+    for ( int k = 0; k < 4; ++k )
+    {
+      const int v1 = nodeVertices[quads[4*q + k]];
+      const int v2 = nodeVertices[quads[4*q + (k + 1) % 4]];
+
+      std::pair<std::unordered_map<unsigned long long, int>::iterator, bool>
+        res = linkEdges.insert( std::make_pair( GetLinkKey(v1, v2), int( networkEdges.size() ) ) );
+      //
+      if ( res.second )
+      {
+        t_networkEdge edge;
+        edge.V1 = v1;
+        edge.V2 = v2;
+        //
+        networkEdges.push_back(edge);
+      }
+
+      quadEdges[4*q + k]  = res.first->second;
+      quadSenses[4*q + k] = ( networkEdges[res.first->second].V1 == v1 );
+    }
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Find shared vertices and edges")
+
+  m_progress.SendLogMessage( LogInfo(Normal) << "Quad network has %1 vertices and %2 edges."
+                                             << int( vertices.size() ) << int( networkEdges.size() ) );
+
+  /* ==============================
+   *  Project vertices and edges
+   * ============================== */
+
+  TIMER_RESET
+  TIMER_GO
+
+  // Build BVH on the main thread as it is constructed lazily.
+  bvh->BVH();
+
+  const int numNetworkVertices = int( vertices.size() );
+  const int numNetworkEdges    = int( networkEdges.size() );
+
+  // The network is projected in batches, so the progress is stepped by
+  // the calling thread.
+  m_progress.SetMessageKey("Project quad network");
+  m_progress.Init(numNetworkVertices + numNetworkEdges);
+
+  ProjectVerticesFunctor projectVerticesFunc(bvh, nodes, vertices);
+  //
+  for ( int batchStart = 0; batchStart < numNetworkVertices; batchStart += ProjectBatchSize )
+  {
+    const int batchEnd = std::min(numNetworkVertices, batchStart + ProjectBatchSize);
+    //
+#ifdef USE_THREADING
+    if ( isParallel )
+      tbb::parallel_for(tbb::blocked_range<int>(batchStart, batchEnd), projectVerticesFunc);
+    else
+#endif
+      projectVerticesFunc.Process(batchStart, batchEnd);
+
+    m_progress.StepProgress(batchEnd - batchStart);
+  }
+
+  ProjectEdgesFunctor projectEdgesFunc(bvh, projTol, vertices, networkEdges);
+  //
+  for ( int batchStart = 0; batchStart < numNetworkEdges; batchStart += ProjectBatchSize )
+  {
+    const int batchEnd = std::min(numNetworkEdges, batchStart + ProjectBatchSize);
+    //
+#ifdef USE_THREADING
+    if ( isParallel )
+      tbb::parallel_for(tbb::blocked_range<int>(batchStart, batchEnd), projectEdgesFunc);
+    else
+#endif
+      projectEdgesFunc.Process(batchStart, batchEnd);
+
+    m_progress.StepProgress(batchEnd - batchStart);
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Project vertices and edges")
+
+  /* =============================
+   *  Create topological Nodes
+   * ============================= */
+
+  TIMER_RESET
+  TIMER_GO
+
+  std::vector<Handle(asiData_ReVertexNode)> vertexNodes( vertices.size() );
+  std::vector<Handle(asiData_ReEdgeNode)>   edgeNodes( networkEdges.size() );
+  //
+  int numPatches = 0, numVertices = 0, numEdges = 0, numSkipped = 0, numStraight = 0;
+
+  m_progress.SetMessageKey("Process quads");
+  m_progress.Init(numQuads);
+  //
+  for ( int q = 0; q < numQuads; ++q )
+  {
+    m_progress.StepProgress(1);
+
+    // Skip the quads which cannot be projected.
+    bool isProjected = true;
+    //
+    for ( int k = 0; k < 4 && isProjected; ++k )
+      isProjected = ( vertices[nodeVertices[quads[4*q + k]]].Facet != -1 );
+    //
+    if ( !isProjected )
+    {
+      numSkipped++;
+      continue;
+    }
+
+    TCollection_ExtendedString patchName("Patch "); patchName += ++numPatches;
+    //
+    Handle(asiData_RePatchNode) patch = this->Create_Patch(patchName);
+
+    // Create vertices.
+    for ( int k = 0; k < 4; ++k )
+    {
+      const int              vIdx   = nodeVertices[quads[4*q + k]];
+      const t_networkVertex& vertex = vertices[vIdx];
+      //
+      if ( !vertexNodes[vIdx].IsNull() )
+        continue;
+
+      TCollection_ExtendedString vertexName("Vertex "); vertexName += ++numVertices;
+      //
+      vertexNodes[vIdx] = this->Create_Vertex( vertexName,
+                                               vertex.Point,
+                                               bvh->GetFacet(vertex.Facet).N.XYZ() );
+    }
+
+    // Create edges/coedges.
+    for ( int k = 0; k < 4; ++k )
+    {
+      const int            eIdx = quadEdges[4*q + k];
+      const t_networkEdge& edge = networkEdges[eIdx];
+      //
+      if ( edgeNodes[eIdx].IsNull() )
+      {
+        TCollection_ExtendedString edgeName("Edge "); edgeName += ++numEdges;
+        //
+        edgeNodes[eIdx] = this->Create_Edge(edgeName, vertexNodes[edge.V1], vertexNodes[edge.V2]);
+        edges->Append(edgeNodes[eIdx]);
+
+        // Store projection with all poles at once.
+        if ( !edge.IsDone )
+          numStraight++;
+        //
+        else if ( edge.Poles.size() > 2 )
+        {
+          const int numPoles = int( edge.Poles.size() ) + 1;
+          //
+          Handle(HRealArray) coords  = new HRealArray(0, 3*numPoles - 1, 0.);
+          Handle(HIntArray)  indices = new HIntArray(0, numPoles - 1, -1);
+          //
+          for ( int p = 0; p < numPoles; ++p )
+          {
+            const gp_XYZ& pole = ( p < numPoles - 1 ) ? edge.Poles[p] : vertices[edge.V2].Point;
+            //
+            coords->ChangeValue(3*p + 0) = pole.X();
+            coords->ChangeValue(3*p + 1) = pole.Y();
+            coords->ChangeValue(3*p + 2) = pole.Z();
+            //
+            if ( p < numPoles - 1 )
+              indices->ChangeValue(p) = edge.Facets[p];
+          }
+          //
+          edgeNodes[eIdx]->SetPolyline(coords);
+          edgeNodes[eIdx]->SetPolylineTriangles(indices);
+        }
+      }
+
+      // Create coedge.
+      this->Create_CoEdge(patch, edgeNodes[eIdx], quadSenses[4*q + k]);
+    }
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Create topological Nodes")
+
+  if ( numSkipped )
+    m_progress.SendLogMessage( LogWarn(Normal) << "%1 quads skipped as their nodes cannot be projected."
+                                               << numSkipped );
+  //
+  if ( numStraight )
+    m_progress.SendLogMessage( LogWarn(Normal) << "%1 edges cannot be projected to mesh."
+                                               << numStraight );
+
+  return numPatches;
+}
+
+//-----------------------------------------------------------------------------
+
 void asiEngine_RE::ReconnectBuildEdgeFunc(const Handle(asiData_ReEdgeNode)& edge) const
 {
   if ( edge.IsNull() || !edge->IsWellFormed() ) // Contract check.
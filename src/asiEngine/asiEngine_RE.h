@@ -37,6 +37,12 @@
 // asiData includes
 #include <asiData_ReCoEdgeNode.h>
 
+// asiAlgo includes
+#include <asiAlgo_BVHFacets.h>
+
+// OCCT includes
+#include <Geom_BSplineCurve.hxx>
+
 //! API for the data model operations related to reverse engineering.
 class asiEngine_RE : public asiEngine_Base
 {
@@ -251,6 +257,74 @@ public:
                    const int                                        minNumKnots,
                    Handle(Geom_BSplineSurface)&                     surf) const;
 
+  //! Collects the curves of the passed coedges taking into account their
+  //! orientation. The curves are copied, so they can be used without
+  //! accessing the Data Model. The number of coedges is not checked here
+  //! as it depends on the filling method.
+  //! \param[in]  coedges series of coedges in question.
+  //! \param[out] curves  collected curves.
+  //! \return true in case of success, false -- otherwise.
+  asiEngine_EXPORT bool
+    GetPatchCurves(const std::vector<Handle(asiData_ReCoedgeNode)>& coedges,
+                   std::vector<Handle(Geom_BSplineCurve)>&          curves) const;
+
+  //! Fills the contour composed of the passed curves with a Coons surface.
+  //! This method does not access the Data Model.
+  //! \param[in]  curves      four oriented boundary curves.
+  //! \param[in]  minNumKnots min number of knots in the resulting surface
+  //!                         in each curvilinear direction.
+  //! \param[out] surf        constructed surface.
+  //! \return true in case of success, false -- otherwise.
+  asiEngine_EXPORT bool
+    FillPatchCoons(const std::vector<Handle(Geom_BSplineCurve)>& curves,
+                   const int                                     minNumKnots,
+                   Handle(Geom_BSplineSurface)&                  surf) const;
+
+  //! Fills the contour composed of the passed curves with a plate surface.
+  //! Unlike Coons, the contour can have any number of sides. This method
+  //! does not access the Data Model.
+  //! \param[in]  curves oriented boundary curves.
+  //! \param[out] surf   constructed surface.
+  //! \return true in case of success, false -- otherwise.
+  asiEngine_EXPORT bool
+    FillPatchPlate(const std::vector<Handle(Geom_BSplineCurve)>& curves,
+                   Handle(Geom_BSplineSurface)&                  surf) const;
+
+  //! Fills the passed patches with Coons or plate surfaces in batch mode.
+  //! The boundary curves of all patches are collected first. Then the
+  //! surfaces are constructed concurrently as the patches do not share any
+  //! geometry. Finally, the surfaces are stored in the Patch Nodes, so the
+  //! caller is supposed to open a single Data Model command for all patches.
+  //! \param[in] patches    Patch Nodes to fill.
+  //! \param[in] usePlate   whether to use plate surfaces instead of Coons.
+  //! \param[in] isParallel whether to construct the surfaces concurrently.
+  //! \return number of filled patches.
+  asiEngine_EXPORT int
+    FillPatches(const Handle(ActAPI_HNodeList)& patches,
+                const bool                      usePlate,
+                const bool                      isParallel = true) const;
+
+  //! Creates the topology for a quad network lying on the mesh. The shared
+  //! vertices and edges of the quads are found first, and all of them are
+  //! projected onto the mesh concurrently. Then the Vertex, Edge and Patch
+  //! Nodes are created in a single pass, so the caller is supposed to open
+  //! a single Data Model command for the whole network.
+  //! \param[in]  nodes      network nodes.
+  //! \param[in]  quads      zero-based indices of the network nodes, four
+  //!                        per quad.
+  //! \param[in]  bvh        BVH of the mesh to project onto.
+  //! \param[in]  projTol    precision of the edge projection.
+  //! \param[out] edges      created Edge Nodes.
+  //! \param[in]  isParallel whether to project concurrently.
+  //! \return number of created patches.
+  asiEngine_EXPORT int
+    CreateQuadTopology(const std::vector<gp_XYZ>&       nodes,
+                       const std::vector<int>&          quads,
+                       const Handle(asiAlgo_BVHFacets)& bvh,
+                       const double                     projTol,
+                       Handle(ActAPI_HNodeList)&        edges,
+                       const bool                       isParallel = true);
+
   //! Reconnects Tree Function aimed at reconstruction of a single edge.
   //! \param[in] edge target Edge Node.
   asiEngine_EXPORT void
@@ -47,6 +47,32 @@
 
 //-----------------------------------------------------------------------------
 
+namespace
+{
+  //! Job of the edge approximation.
+  class EdgeJob : public Standard_Transient
+  {
+  public:
+
+    // OCCT RTTI
+    DEFINE_STANDARD_RTTI_INLINE(EdgeJob, Standard_Transient)
+
+  public:
+
+    Handle(asiData_ReEdgeNode) Edge;     //!< Edge Node to update on commit.
+    TCollection_AsciiString    Name;     //!< Name of the edge.
+    std::vector<gp_XYZ>        Polyline; //!< Points to approximate.
+    double                     Toler;    //!< Approximation tolerance.
+    bool                       ToFair;   //!< Whether to fair the curve.
+    double                     Lambda;   //!< Fairing coefficient.
+    Handle(Geom_BSplineCurve)  Curve;    //!< Approximated curve.
+
+    EdgeJob() : Toler(0.), ToFair(false), Lambda(0.) {} //!< Ctor.
+  };
+}
+
+//-----------------------------------------------------------------------------
+
 #if defined USE_MOBIUS
 
 Handle(Geom_BSplineCurve) FairCurve(const Handle(Geom_BSplineCurve)& curve,
@@ -99,59 +125,142 @@ const char* asiEngine_BuildEdgeFunc::GetGUID() const
 
 //-----------------------------------------------------------------------------
 
-int asiEngine_BuildEdgeFunc::execute(const Handle(ActAPI_HParameterList)& inputs,
-                                     const Handle(ActAPI_HParameterList)& asiEngine_NotUsed(outputs),
-                                     const Handle(Standard_Transient)&    asiEngine_NotUsed(userData)) const
+Handle(Standard_Transient)
+  asiEngine_BuildEdgeFunc::Prepare(const Handle(ActAPI_HParameterList)& inputs,
+                                   const Handle(ActAPI_HParameterList)& asiEngine_NotUsed(outputs),
+                                   const Handle(Standard_Transient)&    asiEngine_NotUsed(userData)) const
 {
 #if defined USE_MOBIUS
   // Get Edge Node.
   Handle(asiData_ReEdgeNode)
     edgeNode = Handle(asiData_ReEdgeNode)::DownCast( inputs->Value(1)->GetNode() );
 
-  // Fairing props.
-  const bool   toFair = edgeNode->IsFairCurve();
-  const double lambda = edgeNode->GetFairingCoeff();
-
   m_progress.SendLogMessage( LogNotice(Normal) << "Executing tree function '%1%2'..."
                                                << this->GetName()
                                                << edgeNode->RootLabel().Tag() );
 
-  // Approximate with parametric curve.
-  std::vector<gp_XYZ> pts;
-  edgeNode->GetPolyline(pts);
+  Handle(EdgeJob) job = new EdgeJob;
+  job->Edge   = edgeNode;
+  job->Name   = edgeNode->GetName();
+  job->Toler  = edgeNode->GetApproxToler();
+  job->ToFair = edgeNode->IsFairCurve();
+  job->Lambda = edgeNode->GetFairingCoeff();
   //
+  edgeNode->GetPolyline(job->Polyline);
+
+  return job;
+#else
+  asiEngine_NotUsed(inputs);
+
+  m_progress.SendLogMessage( LogErr(Normal) << "Mobius is not available." );
+  return nullptr; // Error.
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiEngine_BuildEdgeFunc::Compute(const Handle(Standard_Transient)& job,
+                                      ActAPI_ProgressEntry              progress,
+                                      ActAPI_PlotterEntry               asiEngine_NotUsed(plotter)) const
+{
+#if defined USE_MOBIUS
+  Handle(EdgeJob) edgeJob = Handle(EdgeJob)::DownCast(job);
+
+  // Approximate with parametric curve.
   Handle(Geom_BSplineCurve) curve;
-  if ( !asiAlgo_Utils::ApproximatePoints(pts, 3, 3, edgeNode->GetApproxToler(), curve) )
+  if ( !asiAlgo_Utils::ApproximatePoints(edgeJob->Polyline, 3, 3, edgeJob->Toler, curve) )
   {
-    m_progress.SendLogMessage( LogErr(Normal) << "Cannot approximate edge '%1'."
-                                              << edgeNode->GetName() );
-    return 1; // Error.
+    progress.SendLogMessage( LogErr(Normal) << "Cannot approximate edge '%1'."
+                                            << edgeJob->Name );
+    return false;
   }
 
   // Fair curve.
-  if ( toFair )
+  if ( edgeJob->ToFair )
   {
     Handle(Geom_BSplineCurve) fairedBCurve = FairCurve( curve,
-                                                        lambda );
+                                                        edgeJob->Lambda,
+                                                        progress );
     //
     if ( fairedBCurve.IsNull() )
     {
-      m_progress.SendLogMessage( LogErr(Normal) << "Fairing failed for edge '%1'."
-                                                << edgeNode->GetName() );
-      return 1; // Error.
+      progress.SendLogMessage( LogErr(Normal) << "Fairing failed for edge '%1'."
+                                              << edgeJob->Name );
+      return false;
     }
 
     curve = fairedBCurve;
   }
 
+  edgeJob->Curve = curve;
+  return true;
+#else
+  asiEngine_NotUsed(job);
+  asiEngine_NotUsed(progress);
+
+  return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+int asiEngine_BuildEdgeFunc::Commit(const Handle(Standard_Transient)&    job,
+                                    const Handle(ActAPI_HParameterList)& asiEngine_NotUsed(outputs),
+                                    const Handle(Standard_Transient)&    asiEngine_NotUsed(userData)) const
+{
+  Handle(EdgeJob) edgeJob = Handle(EdgeJob)::DownCast(job);
+  //
+  if ( edgeJob.IsNull() || edgeJob->Curve.IsNull() )
+    return 1; // Error.
+
   // Set the result.
-  edgeNode->SetCurve(curve);
+  edgeJob->Edge->SetCurve(edgeJob->Curve);
 
   return 0; // Success.
-#else
-  m_progress.SendLogMessage( LogErr(Normal) << "Mobius is not available." );
-  return 1; // Error.
-#endif
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned long long
+  asiEngine_BuildEdgeFunc::HashInputs(const Handle(Standard_Transient)& job) const
+{
+  Handle(EdgeJob) edgeJob = Handle(EdgeJob)::DownCast(job);
+
+  asiEngine_FuncCache::t_hasher hasher;
+  hasher << edgeJob->Polyline
+         << edgeJob->Toler
+         << edgeJob->ToFair
+         << edgeJob->Lambda;
+
+  return hasher.GetValue();
+}
+
+//-----------------------------------------------------------------------------
+
+Handle(Standard_Transient)
+  asiEngine_BuildEdgeFunc::CacheResults(const Handle(Standard_Transient)& job) const
+{
+  Handle(EdgeJob) edgeJob = Handle(EdgeJob)::DownCast(job);
+  Handle(EdgeJob) results = new EdgeJob;
+  //
+  if ( !edgeJob->Curve.IsNull() )
+    results->Curve = Handle(Geom_BSplineCurve)::DownCast( edgeJob->Curve->Copy() );
+
+  return results;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiEngine_BuildEdgeFunc::RestoreResults(const Handle(Standard_Transient)& cached,
+                                             const Handle(Standard_Transient)& job) const
+{
+  Handle(EdgeJob) results = Handle(EdgeJob)::DownCast(cached);
+  Handle(EdgeJob) edgeJob = Handle(EdgeJob)::DownCast(job);
+
+  // The cached curve is copied as the committed one is shared with the
+  // Data Model and may be modified there.
+  if ( !results->Curve.IsNull() )
+    edgeJob->Curve = Handle(Geom_BSplineCurve)::DownCast( results->Curve->Copy() );
 }
 
 //-----------------------------------------------------------------------------
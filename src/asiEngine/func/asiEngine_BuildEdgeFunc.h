@@ -32,20 +32,17 @@
 #define asiEngine_BuildEdgeFunc_HeaderFile
 
 // asiEngine includes
-#include <asiEngine.h>
-
-// Active Data includes
-#include <ActData_BaseTreeFunction.h>
+#include <asiEngine_StagedFunc.h>
 
 //-----------------------------------------------------------------------------
 
 //! Tree function for edge's curve approximation.
-class asiEngine_BuildEdgeFunc : public ActData_BaseTreeFunction
+class asiEngine_BuildEdgeFunc : public asiEngine_StagedFunc
 {
 public:
 
   // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(asiEngine_BuildEdgeFunc, ActData_BaseTreeFunction)
+  DEFINE_STANDARD_RTTI_INLINE(asiEngine_BuildEdgeFunc, asiEngine_StagedFunc)
 
 public:
 
@@ -79,18 +76,59 @@ public:
     return "E";
   }
 
-private:
+public:
 
-  //! Executes Tree Function on the given input and output arguments.
-  //! \param[in]      inputs   input Parameters.
-  //! \param[in, out] outputs  output Parameters.
-  //! \param[in]      userData custom user data.
-  //! \return execution status.
-  virtual int
-    execute(const Handle(ActAPI_HParameterList)& inputs,
+  //! Reads the polyline and approximation properties of the edge.
+  //! \param[in] inputs   input Parameters.
+  //! \param[in] outputs  output Parameters.
+  //! \param[in] userData custom user data.
+  //! \return job to compute.
+  asiEngine_EXPORT virtual Handle(Standard_Transient)
+    Prepare(const Handle(ActAPI_HParameterList)& inputs,
             const Handle(ActAPI_HParameterList)& outputs,
             const Handle(Standard_Transient)&    userData) const;
 
+  //! Approximates the polyline with a B-curve and fairs it if requested.
+  //! \param[in] job      job to compute.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  //! \return true in case of success, false -- otherwise.
+  asiEngine_EXPORT virtual bool
+    Compute(const Handle(Standard_Transient)& job,
+            ActAPI_ProgressEntry              progress,
+            ActAPI_PlotterEntry               plotter) const;
+
+  //! Sets the approximated curve to the edge.
+  //! \param[in] job      computed job.
+  //! \param[in] outputs  output Parameters.
+  //! \param[in] userData custom user data.
+  //! \return execution status.
+  asiEngine_EXPORT virtual int
+    Commit(const Handle(Standard_Transient)&    job,
+           const Handle(ActAPI_HParameterList)& outputs,
+           const Handle(Standard_Transient)&    userData) const;
+
+  //! Hashes the polyline and approximation properties of the edge.
+  //! \param[in] job prepared job.
+  //! \return hash of the inputs.
+  asiEngine_EXPORT virtual unsigned long long
+    HashInputs(const Handle(Standard_Transient)& job) const;
+
+  //! Copies the approximated curve to be stored in the cache.
+  //! \param[in] job computed job.
+  //! \return object holding the curve.
+  asiEngine_EXPORT virtual Handle(Standard_Transient)
+    CacheResults(const Handle(Standard_Transient)& job) const;
+
+  //! Copies the cached curve to the prepared job.
+  //! \param[in] cached results stored by CacheResults().
+  //! \param[in] job    prepared job.
+  asiEngine_EXPORT virtual void
+    RestoreResults(const Handle(Standard_Transient)& cached,
+                   const Handle(Standard_Transient)& job) const;
+
+private:
+
   //! This method returns empty list because this Tree Function has a variable
   //! input signature.
   //! \return expected input signature.
@@ -37,27 +37,17 @@
 #include <asiData_OctreeParameter.h>
 
 // asiAlgo includes
-#if defined USE_MOBIUS
-  #include <asiAlgo_MeshDistanceFunc.h>
-#endif
-#include <asiAlgo_CSG.h>
+#include <asiAlgo_BuildSVO.h>
+#include <asiAlgo_CSGDistanceFunc.h>
+#include <asiAlgo_MeshDistanceFunc.h>
 #include <asiAlgo_ResampleADF.h>
+#include <asiAlgo_SVODistanceFunc.h>
 #include <asiAlgo_Timer.h>
 
 // Active Data includes
 #include <ActData_ParameterFactory.h>
 #include <ActData_UserExtParameter.h>
 
-#ifdef USE_MOBIUS
-  #include <mobius/poly_CommonFunc.h>
-  #include <mobius/poly_DifferenceFunc.h>
-  #include <mobius/poly_DistanceField.h>
-  #include <mobius/poly_SVO.h>
-  #include <mobius/poly_UnionFunc.h>
-
-  using namespace mobius;
-#endif
-
 // OpenCascade includes
 #include <Precision.hxx>
 
@@ -88,7 +78,6 @@ int asiEngine_BuildOctreeFunc::execute(const Handle(ActAPI_HParameterList)& inpu
                                        const Handle(ActAPI_HParameterList)& outputs,
                                        const Handle(Standard_Transient)&) const
 {
-#if defined USE_MOBIUS
   /* ============================
    *  Interpret input Parameters.
    * ============================ */
@@ -170,7 +159,7 @@ int asiEngine_BuildOctreeFunc::execute(const Handle(ActAPI_HParameterList)& inpu
     gridParam = Handle(asiData_UniformGridParameter)::DownCast( octreeNode->Parameter( gridExtParam->GetParamId() ) );
 
   // Delete the previous octree (if any).
-  poly_SVO* pOldOctree = static_cast<poly_SVO*>( octreeParam->GetOctree() );
+  asiAlgo_SVO* pOldOctree = static_cast<asiAlgo_SVO*>( octreeParam->GetOctree() );
   //
   if ( pOldOctree != nullptr )
     delete pOldOctree;
@@ -184,18 +173,18 @@ int asiEngine_BuildOctreeFunc::execute(const Handle(ActAPI_HParameterList)& inpu
   TIMER_NEW
   TIMER_GO
 
-  t_ptr<poly_RealFunc> distFunc;
+  Handle(asiAlgo_DistanceFunc) distFunc;
 
   if ( op == CSG_Primitive )
   {
     distFunc = isCustomDomain ? new asiAlgo_MeshDistanceFunc(bvh,
                                                              domainMin,
                                                              domainMax,
-                                                             poly_DistanceFunc::Mode_Signed,
+                                                             asiAlgo_DistanceFunc::Mode_Signed,
                                                              numRays,
                                                              isCube)
                               : new asiAlgo_MeshDistanceFunc(bvh,
-                                                             poly_DistanceFunc::Mode_Signed,
+                                                             asiAlgo_DistanceFunc::Mode_Signed,
                                                              numRays,
                                                              isCube);
   }
@@ -204,18 +193,24 @@ int asiEngine_BuildOctreeFunc::execute(const Handle(ActAPI_HParameterList)& inpu
     Handle(asiData_OctreeNode) opLeftNode  = Handle(asiData_OctreeNode)::DownCast(opLeftBase);
     Handle(asiData_OctreeNode) opRightNode = Handle(asiData_OctreeNode)::DownCast(opRightBase);
 
-    poly_SVO* pLeftSVO  = static_cast<poly_SVO*>( opLeftNode->GetOctree() );
-    poly_SVO* pRightSVO = static_cast<poly_SVO*>( opRightNode->GetOctree() );
+    asiAlgo_SVO* pLeftSVO  = static_cast<asiAlgo_SVO*>( opLeftNode->GetOctree() );
+    asiAlgo_SVO* pRightSVO = static_cast<asiAlgo_SVO*>( opRightNode->GetOctree() );
+    //
+    if ( pLeftSVO == nullptr || pRightSVO == nullptr )
+    {
+      m_progress.SendLogMessage(LogErr(Normal) << "Operands of the Boolean operation are not built.");
+      return 1;
+    }
 
-    t_ptr<poly_DistanceField> leftField  = new poly_DistanceField(pLeftSVO);
-    t_ptr<poly_DistanceField> rightField = new poly_DistanceField(pRightSVO);
+    distFunc = new asiAlgo_CSGDistanceFunc( new asiAlgo_SVODistanceFunc(pLeftSVO),
+                                            new asiAlgo_SVODistanceFunc(pRightSVO),
+                                            op );
+  }
 
-    if ( op == CSG_Union )
-      distFunc = new poly_UnionFunc(leftField, rightField);
-    else if ( op == CSG_Intersection )
-      distFunc = new poly_CommonFunc(leftField, rightField);
-    else if ( op == CSG_Difference )
-      distFunc = new poly_DifferenceFunc(leftField, rightField);
+  if ( distFunc.IsNull() )
+  {
+    m_progress.SendLogMessage(LogErr(Normal) << "Unexpected operation type.");
+    return 1;
   }
 
   TIMER_FINISH
@@ -226,9 +221,9 @@ int asiEngine_BuildOctreeFunc::execute(const Handle(ActAPI_HParameterList)& inpu
   TIMER_RESET
   TIMER_GO
 
-  t_ptr<poly_DistanceField> DDF = new poly_DistanceField();
+  asiAlgo_BuildSVO buildSVO(m_progress, m_plotter);
   //
-  if ( !DDF->Build(minSize, maxSize, prec, isUniform, distFunc) )
+  if ( !buildSVO.Perform(distFunc, minSize, maxSize, prec, isUniform) )
   {
     m_progress.SendLogMessage(LogErr(Normal) << "Failed to build distance field.");
     return 1;
@@ -237,11 +232,11 @@ int asiEngine_BuildOctreeFunc::execute(const Handle(ActAPI_HParameterList)& inpu
   TIMER_FINISH
   TIMER_COUT_RESULT_NOTIFIER(m_progress, "Build SVO for distance field")
 
-  poly_SVO* pRoot = DDF->GetRoot();
+  asiAlgo_SVO* pRoot = buildSVO.ReleaseResult();
 
   // Measure SVO.
-  int                      numSVONodes = 0;
-  const unsigned long long memBytes    = pRoot->GetMemoryInBytes(numSVONodes);
+  const int                numSVONodes = pRoot->GetNumNodes();
+  const unsigned long long memBytes    = pRoot->GetMemoryInBytes();
   const double             memMBytes   = memBytes / (1024.*1024.);
   //
   m_progress.SendLogMessage( LogInfo(Normal) << "SVO contains %1 nodes and occupies %2 bytes (%3 MiB) of memory."
@@ -270,6 +265,10 @@ int asiEngine_BuildOctreeFunc::execute(const Handle(ActAPI_HParameterList)& inpu
     }
 
     uniformGrid = ResampleAlgo.GetResult();
+    //
+    m_progress.SendLogMessage( LogInfo(Normal) << "Uniform grid of %1 x %2 x %3 cells occupies %4 MiB."
+                                               << uniformGrid->Nx << uniformGrid->Ny << uniformGrid->Nz
+                                               << uniformGrid->GetMemoryInBytes()/(1024.*1024.) );
 
     TIMER_FINISH
     TIMER_COUT_RESULT_NOTIFIER(m_progress, "ADF resampling")
@@ -292,9 +291,6 @@ int asiEngine_BuildOctreeFunc::execute(const Handle(ActAPI_HParameterList)& inpu
   numNodesParam->SetValue(numSVONodes);
 
   return 0; // Success.
-#else
-  return 1;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -59,6 +59,37 @@
 
 //-----------------------------------------------------------------------------
 
+namespace
+{
+  //! Job of the patch construction.
+  class PatchJob : public Standard_Transient
+  {
+  public:
+
+    // OCCT RTTI
+    DEFINE_STANDARD_RTTI_INLINE(PatchJob, Standard_Transient)
+
+  public:
+
+    Handle(asiEngine_Model)                Model;            //!< Data Model (not accessed on computation).
+    Handle(asiData_RePatchNode)            Patch;            //!< Patch Node to update on commit.
+    int                                    MinNumKnots;      //!< Min number of knots.
+    bool                                   ApproxMesh;       //!< Whether to approximate mesh nodes.
+    double                                 Lambda;           //!< Fairing coefficient.
+    bool                                   IsPlotterEnabled; //!< Whether the plotter is enabled.
+    std::vector<Handle(Geom_BSplineCurve)> Curves;           //!< Oriented boundary curves.
+    Handle(asiAlgo_BaseCloud<double>)      Pts;              //!< Mesh nodes to approximate.
+    bool                                   IsExtracted;      //!< Whether mesh nodes are extracted.
+    Handle(Geom_BSplineSurface)            Coons;            //!< Coons surface.
+    Handle(Geom_BSplineSurface)            Surface;          //!< Approximated surface.
+
+    //! Ctor.
+    PatchJob() : MinNumKnots(0), ApproxMesh(false), Lambda(0.), IsPlotterEnabled(false), IsExtracted(false) {}
+  };
+}
+
+//-----------------------------------------------------------------------------
+
 Handle(asiEngine_BuildPatchFunc) asiEngine_BuildPatchFunc::Instance()
 {
   return new asiEngine_BuildPatchFunc();
@@ -80,9 +111,10 @@ const char* asiEngine_BuildPatchFunc::GetGUID() const
 
 //-----------------------------------------------------------------------------
 
-int asiEngine_BuildPatchFunc::execute(const Handle(ActAPI_HParameterList)& inputs,
-                                      const Handle(ActAPI_HParameterList)& outputs,
-                                      const Handle(Standard_Transient)&    userData) const
+Handle(Standard_Transient)
+  asiEngine_BuildPatchFunc::Prepare(const Handle(ActAPI_HParameterList)& inputs,
+                                    const Handle(ActAPI_HParameterList)& outputs,
+                                    const Handle(Standard_Transient)&    userData) const
 {
   /* ============================
    *  Interpret input Parameters
@@ -94,7 +126,7 @@ int asiEngine_BuildPatchFunc::execute(const Handle(ActAPI_HParameterList)& input
   if ( M.IsNull() )
   {
     m_progress.SendLogMessage(LogErr(Normal) << "User data is not a Data Model instance.");
-    return 1; // Error.
+    return nullptr; // Error.
   }
 
   // Vector of coedges.
@@ -108,25 +140,26 @@ int asiEngine_BuildPatchFunc::execute(const Handle(ActAPI_HParameterList)& input
                                                << this->GetName()
                                                << patchNode->RootLabel().Tag() );
 
+  Handle(PatchJob) job = new PatchJob;
+  job->Model = M;
+  job->Patch = patchNode;
+
   // Get min number of knots.
-  const int
-    minNumKnots = Handle(ActData_IntParameter)::DownCast( inputs->Value(1) )->GetValue();
+  job->MinNumKnots = Handle(ActData_IntParameter)::DownCast( inputs->Value(1) )->GetValue();
 
   // Get mesh approximation flag.
-  const bool
-    approxMesh = Handle(ActData_BoolParameter)::DownCast( inputs->Value(2) )->GetValue();
+  job->ApproxMesh = Handle(ActData_BoolParameter)::DownCast( inputs->Value(2) )->GetValue();
 
   // Get the value of fairing coefficient.
-  const double
-    approxLambda = Handle(ActData_RealParameter)::DownCast( inputs->Value(3) )->GetValue();
+  job->Lambda = Handle(ActData_RealParameter)::DownCast( inputs->Value(3) )->GetValue();
 
   // Boolean flag indicating if the visual debugging is enabled.
-  m_bPlotterEnabled = Handle(ActData_BoolParameter)::DownCast( inputs->Value(4) )->GetValue();
+  job->IsPlotterEnabled = Handle(ActData_BoolParameter)::DownCast( inputs->Value(4) )->GetValue();
 
-  m_progress.SendLogMessage( LogInfo(Normal) << "Mesh nodes approximation mode: %1." << approxMesh );
+  m_progress.SendLogMessage( LogInfo(Normal) << "Mesh nodes approximation mode: %1." << job->ApproxMesh );
   //
-  if ( approxMesh )
-    m_progress.SendLogMessage( LogInfo(Normal) << "Fairing coefficient: %1." << approxLambda );
+  if ( job->ApproxMesh )
+    m_progress.SendLogMessage( LogInfo(Normal) << "Fairing coefficient: %1." << job->Lambda );
 
   // Collect coedges.
   int       currIdx    = 1;
@@ -152,66 +185,165 @@ int asiEngine_BuildPatchFunc::execute(const Handle(ActAPI_HParameterList)& input
       break;
   }
 
+  /* ==================================
+   *  Collect curves and mesh nodes
+   * ================================== */
+
+  asiEngine_RE reApi(M, m_progress, job->IsPlotterEnabled ? m_plotter : nullptr);
+
+  // Get the boundary curves. If they are not available, the job fails on
+  // computation and the patch is left as is.
+  if ( !reApi.GetPatchCurves(coedges, job->Curves) )
+  {
+    job->Curves.clear();
+    return job;
+  }
+
+  // Extract inner nodes if mesh approximation is requested.
+  if ( job->ApproxMesh )
+    job->IsExtracted = this->extractMeshNodes(M, patchNode, job->IsPlotterEnabled, job->Pts);
+
+  return job;
+}
+
+//-----------------------------------------------------------------------------
+
+bool asiEngine_BuildPatchFunc::Compute(const Handle(Standard_Transient)& job,
+                                       ActAPI_ProgressEntry              progress,
+                                       ActAPI_PlotterEntry               plotter) const
+{
+  Handle(PatchJob) patchJob = Handle(PatchJob)::DownCast(job);
+
   /* =============
    *  Build patch
    * ============= */
 
-  asiEngine_RE reApi(M, m_progress, m_bPlotterEnabled ? m_plotter : nullptr);
+  asiEngine_RE reApi(patchJob->Model, progress, patchJob->IsPlotterEnabled ? plotter : nullptr);
 
   // Fill Coons.
-  Handle(Geom_BSplineSurface) bsurf;
-  //
-  if ( !reApi.FillPatchCoons(coedges, minNumKnots, bsurf) )
-    return 0;
-
-  /* =============================================================
-   *  Extract inner mesh nodes if mesh approximation is requested
-   * ============================================================= */
-
-  // Extract inner nodes.
-  Handle(asiAlgo_BaseCloud<double>) pts;
-  //
-  if ( approxMesh && !this->extractMeshNodes(M, patchNode, pts) )
-  {
-    // Let's return at least Coons...
-    patchNode->SetSurface(bsurf);
+  if ( !reApi.FillPatchCoons(patchJob->Curves, patchJob->MinNumKnots, patchJob->Coons) )
+    return false;
 
-    // Error.
-    m_progress.SendLogMessage( LogErr(Normal) << "Cannot approximate, falling back with Coons..." );
-    return 0;
-  }
+  // Nothing to approximate. If mesh nodes have not been extracted, the
+  // patch falls back to Coons on commit.
+  if ( !patchJob->ApproxMesh || !patchJob->IsExtracted )
+    return true;
 
   /* ==================================================
    *  Approximate points with a B-surface if requested
    * ================================================== */
 
-  Handle(Geom_BSplineSurface) approxSurf;
+  return this->approxMeshNodes(patchJob->Coons,
+                               patchJob->Pts,
+                               patchJob->Lambda,
+                               patchJob->Surface,
+                               progress);
+}
+
+//-----------------------------------------------------------------------------
+
+int asiEngine_BuildPatchFunc::Commit(const Handle(Standard_Transient)&    job,
+                                     const Handle(ActAPI_HParameterList)& asiEngine_NotUsed(outputs),
+                                     const Handle(Standard_Transient)&    asiEngine_NotUsed(userData)) const
+{
+  Handle(PatchJob) patchJob = Handle(PatchJob)::DownCast(job);
   //
-  if ( approxMesh && !this->approxMeshNodes(bsurf, pts, approxLambda, approxSurf) )
+  if ( patchJob.IsNull() )
+    return 1; // Error.
+
+  // No Coons, nothing to set.
+  if ( patchJob->Coons.IsNull() )
+    return 0;
+
+  if ( patchJob->ApproxMesh && patchJob->Surface.IsNull() )
   {
     // Let's return at least Coons...
-    patchNode->SetSurface(bsurf);
+    patchJob->Patch->SetSurface(patchJob->Coons);
 
     // Error.
     m_progress.SendLogMessage( LogErr(Normal) << "Cannot approximate, falling back with Coons..." );
     return 0;
   }
 
-  if ( approxMesh )
-    bsurf = approxSurf;
-
   /* =======================
    *  Set output Parameters
    * ======================= */
 
   // Set the surface to the output Parameter indirectly using the Patch Node.
-  patchNode->SetSurface(bsurf);
+  patchJob->Patch->SetSurface( patchJob->ApproxMesh ? patchJob->Surface : patchJob->Coons );
 
   return 0; // Success.
 }
 
 //-----------------------------------------------------------------------------
 
+unsigned long long
+  asiEngine_BuildPatchFunc::HashInputs(const Handle(Standard_Transient)& job) const
+{
+  Handle(PatchJob) patchJob = Handle(PatchJob)::DownCast(job);
+
+  asiEngine_FuncCache::t_hasher hasher;
+  hasher << patchJob->MinNumKnots
+         << patchJob->ApproxMesh
+         << patchJob->Lambda
+         << patchJob->IsExtracted;
+
+  // Boundary curves.
+  hasher << int( patchJob->Curves.size() );
+  //
+  for ( size_t k = 0; k < patchJob->Curves.size(); ++k )
+    hasher << patchJob->Curves[k];
+
+  // Mesh nodes to approximate.
+  if ( patchJob->ApproxMesh && patchJob->IsExtracted && !patchJob->Pts.IsNull() )
+  {
+    const int numPts = patchJob->Pts->GetNumberOfElements();
+    //
+    hasher << numPts;
+    //
+    for ( int k = 0; k < numPts; ++k )
+      hasher << patchJob->Pts->GetElement(k);
+  }
+
+  return hasher.GetValue();
+}
+
+//-----------------------------------------------------------------------------
+
+Handle(Standard_Transient)
+  asiEngine_BuildPatchFunc::CacheResults(const Handle(Standard_Transient)& job) const
+{
+  Handle(PatchJob) patchJob = Handle(PatchJob)::DownCast(job);
+  Handle(PatchJob) results  = new PatchJob;
+  //
+  if ( !patchJob->Coons.IsNull() )
+    results->Coons = Handle(Geom_BSplineSurface)::DownCast( patchJob->Coons->Copy() );
+  //
+  if ( !patchJob->Surface.IsNull() )
+    results->Surface = Handle(Geom_BSplineSurface)::DownCast( patchJob->Surface->Copy() );
+
+  return results;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiEngine_BuildPatchFunc::RestoreResults(const Handle(Standard_Transient)& cached,
+                                              const Handle(Standard_Transient)& job) const
+{
+  Handle(PatchJob) results  = Handle(PatchJob)::DownCast(cached);
+  Handle(PatchJob) patchJob = Handle(PatchJob)::DownCast(job);
+
+  // The cached surfaces are copied as the committed ones are shared with
+  // the Data Model and may be modified there.
+  if ( !results->Coons.IsNull() )
+    patchJob->Coons = Handle(Geom_BSplineSurface)::DownCast( results->Coons->Copy() );
+  //
+  if ( !results->Surface.IsNull() )
+    patchJob->Surface = Handle(Geom_BSplineSurface)::DownCast( results->Surface->Copy() );
+}
+
+//-----------------------------------------------------------------------------
+
 bool
   asiEngine_BuildPatchFunc::validateInput(const Handle(ActAPI_HParameterList)& inputs) const
 {
@@ -317,10 +449,11 @@ ActAPI_ParameterTypeStream
 
 bool asiEngine_BuildPatchFunc::extractMeshNodes(const Handle(asiEngine_Model)&     model,
                                                 const Handle(asiData_RePatchNode)& patch,
+                                                const bool                         plotterEnabled,
                                                 Handle(asiAlgo_BaseCloud<double>)& pts) const
 {
   // Prepare service API.
-  asiEngine_RE api(model, m_progress, m_bPlotterEnabled ? m_plotter : nullptr);
+  asiEngine_RE api(model, m_progress, plotterEnabled ? m_plotter : nullptr);
 
   // Get triangles captured by contour.
   Handle(Poly_Triangulation) regionTris;
@@ -349,7 +482,8 @@ bool asiEngine_BuildPatchFunc::extractMeshNodes(const Handle(asiEngine_Model)&
 bool asiEngine_BuildPatchFunc::approxMeshNodes(const Handle(Geom_BSplineSurface)&       initSurf,
                                                const Handle(asiAlgo_BaseCloud<double>)& pts,
                                                const double                             lambda,
-                                               Handle(Geom_BSplineSurface)&             resultSurf) const
+                                               Handle(Geom_BSplineSurface)&             resultSurf,
+                                               ActAPI_ProgressEntry                     progress) const
 {
 #if defined USE_MOBIUS
   // Convert to Mobius point cloud.
@@ -386,12 +520,12 @@ bool asiEngine_BuildPatchFunc::approxMeshNodes(const Handle(Geom_BSplineSurface)
   // Approximate.
   if ( !approx.Perform(lambda) )
   {
-    m_progress.SendLogMessage(LogErr(Normal) << "Approximation failed.");
+    progress.SendLogMessage(LogErr(Normal) << "Approximation failed.");
     return false;
   }
 
   TIMER_FINISH
-  TIMER_COUT_RESULT_NOTIFIER(m_progress, "Approximate (passed initial surface)")
+  TIMER_COUT_RESULT_NOTIFIER(progress, "Approximate (passed initial surface)")
 
   // Get result.
   t_ptr<t_bsurf> mobResSurf = approx.GetResult();
@@ -400,7 +534,7 @@ bool asiEngine_BuildPatchFunc::approxMeshNodes(const Handle(Geom_BSplineSurface)
   resultSurf = cascade::GetOpenCascadeBSurface(mobResSurf);
   return true;
 #else
-  m_progress.SendLogMessage(LogErr(Normal) << "Surface approximation module is not available.");
+  progress.SendLogMessage(LogErr(Normal) << "Surface approximation module is not available.");
   return false;
 #endif
 }
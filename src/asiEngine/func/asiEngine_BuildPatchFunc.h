@@ -32,14 +32,11 @@
 #define asiEngine_BuildPatchFunc_HeaderFile
 
 // asiEngine includes
-#include <asiEngine.h>
+#include <asiEngine_StagedFunc.h>
 
 // asiAlgo includes
 #include <asiAlgo_BaseCloud.h>
 
-// Active Data includes
-#include <ActData_BaseTreeFunction.h>
-
 // OpenCascade includes
 #include <Geom_BSplineSurface.hxx>
 
@@ -51,12 +48,12 @@ class asiEngine_Model;
 
 //! Tree function for automatic (re-)constructing surface patches in
 //! reverse engineering scenarios.
-class asiEngine_BuildPatchFunc : public ActData_BaseTreeFunction
+class asiEngine_BuildPatchFunc : public asiEngine_StagedFunc
 {
 public:
 
   // OCCT RTTI
-  DEFINE_STANDARD_RTTI_INLINE(asiEngine_BuildPatchFunc, ActData_BaseTreeFunction)
+  DEFINE_STANDARD_RTTI_INLINE(asiEngine_BuildPatchFunc, asiEngine_StagedFunc)
 
 public:
 
@@ -90,18 +87,62 @@ public:
     return "P";
   }
 
-private:
+public:
 
-  //! Executes Tree Function on the given input and output arguments.
-  //! \param[in]      inputs   input Parameters.
-  //! \param[in, out] outputs  output Parameters.
-  //! \param[in]      userData custom user data.
-  //! \return execution status.
-  virtual int
-    execute(const Handle(ActAPI_HParameterList)& inputs,
+  //! Reads the boundary curves of the patch and the mesh nodes to
+  //! approximate if requested.
+  //! \param[in] inputs   input Parameters.
+  //! \param[in] outputs  output Parameters.
+  //! \param[in] userData custom user data.
+  //! \return job to compute.
+  asiEngine_EXPORT virtual Handle(Standard_Transient)
+    Prepare(const Handle(ActAPI_HParameterList)& inputs,
             const Handle(ActAPI_HParameterList)& outputs,
             const Handle(Standard_Transient)&    userData) const;
 
+  //! Fills the patch with a Coons surface and approximates the mesh nodes
+  //! if requested.
+  //! \param[in] job      job to compute.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  //! \return true in case of success, false -- otherwise.
+  asiEngine_EXPORT virtual bool
+    Compute(const Handle(Standard_Transient)& job,
+            ActAPI_ProgressEntry              progress,
+            ActAPI_PlotterEntry               plotter) const;
+
+  //! Sets the constructed surface to the patch.
+  //! \param[in] job      computed job.
+  //! \param[in] outputs  output Parameters.
+  //! \param[in] userData custom user data.
+  //! \return execution status.
+  asiEngine_EXPORT virtual int
+    Commit(const Handle(Standard_Transient)&    job,
+           const Handle(ActAPI_HParameterList)& outputs,
+           const Handle(Standard_Transient)&    userData) const;
+
+  //! Hashes the boundary curves, the mesh nodes and the construction
+  //! properties of the patch.
+  //! \param[in] job prepared job.
+  //! \return hash of the inputs.
+  asiEngine_EXPORT virtual unsigned long long
+    HashInputs(const Handle(Standard_Transient)& job) const;
+
+  //! Copies the Coons and approximated surfaces to be stored in the cache.
+  //! \param[in] job computed job.
+  //! \return object holding the surfaces.
+  asiEngine_EXPORT virtual Handle(Standard_Transient)
+    CacheResults(const Handle(Standard_Transient)& job) const;
+
+  //! Copies the cached surfaces to the prepared job.
+  //! \param[in] cached results stored by CacheResults().
+  //! \param[in] job    prepared job.
+  asiEngine_EXPORT virtual void
+    RestoreResults(const Handle(Standard_Transient)& cached,
+                   const Handle(Standard_Transient)& job) const;
+
+private:
+
   //! This method verifies that the passed list of input Parameters satisfies
   //! the expected (variable) signature of the Tree Function.
   //! \param[in] inputs input Parameters.
@@ -122,12 +163,14 @@ private:
 private:
 
   //! Extracts mesh nodes for approximation.
-  //! \param[in]  model Data Model instance.
-  //! \param[in]  patch Patch Node being processed.
-  //! \param[out] pts   extracted points to approximate.
+  //! \param[in]  model          Data Model instance.
+  //! \param[in]  patch          Patch Node being processed.
+  //! \param[in]  plotterEnabled whether the plotter is enabled.
+  //! \param[out] pts            extracted points to approximate.
   //! \return true in case of success, false -- otherwise.
   bool extractMeshNodes(const Handle(asiEngine_Model)&     model,
                         const Handle(asiData_RePatchNode)& patch,
+                        const bool                         plotterEnabled,
                         Handle(asiAlgo_BaseCloud<double>)& pts) const;
 
   //! Approximates mesh nodes with a B-surface.
@@ -135,19 +178,17 @@ private:
   //! \param[in]  pts        points to approximate.
   //! \param[in]  lambda     value of the fairing coefficient.
   //! \param[out] resultSurf approximated surface.
+  //! \param[in]  progress   progress notifier.
   //! \return true in case of success, false -- otherwise.
   bool approxMeshNodes(const Handle(Geom_BSplineSurface)&       initSurf,
                        const Handle(asiAlgo_BaseCloud<double>)& pts,
                        const double                             lambda,
-                       Handle(Geom_BSplineSurface)&             resultSurf) const;
-
-private:
-
-  asiEngine_BuildPatchFunc() : m_bPlotterEnabled(true) {} //!< Ctor.
+                       Handle(Geom_BSplineSurface)&             resultSurf,
+                       ActAPI_ProgressEntry                     progress) const;
 
 private:
 
-  mutable bool m_bPlotterEnabled; //!< Indicates whether plotter is enabled.
+  asiEngine_BuildPatchFunc() {} //!< Ctor.
 
 };
 
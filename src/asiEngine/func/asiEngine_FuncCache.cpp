@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiEngine_FuncCache.h>
+
+// Standard includes
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+
+asiEngine_FuncCache::t_hasher&
+  asiEngine_FuncCache::t_hasher::operator<<(const Handle(Geom_BSplineCurve)& curve)
+{
+  if ( curve.IsNull() )
+    return *this << -1;
+
+  *this << curve->Degree() << curve->IsPeriodic() << curve->IsRational();
+
+  *this << curve->NbPoles();
+  //
+  for ( int i = 1; i <= curve->NbPoles(); ++i )
+  {
+    *this << curve->Pole(i).XYZ();
+    //
+    if ( curve->IsRational() )
+      *this << curve->Weight(i);
+  }
+
+  *this << curve->NbKnots();
+  //
+  for ( int i = 1; i <= curve->NbKnots(); ++i )
+    *this << curve->Knot(i) << curve->Multiplicity(i);
+
+  return *this;
+}
+
+//-----------------------------------------------------------------------------
+
+asiEngine_FuncCache::asiEngine_FuncCache(const int capacity)
+: Standard_Transient (),
+  m_iCapacity        (capacity)
+{}
+
+//-----------------------------------------------------------------------------
+
+Handle(Standard_Transient)
+  asiEngine_FuncCache::Find(const TCollection_AsciiString& key,
+                            const unsigned long long       hash)
+{
+  std::map<t_key, std::list<t_entry>::iterator>::iterator
+    it = m_index.find( t_key(key.ToCString(), hash) );
+  //
+  if ( it == m_index.end() )
+    return nullptr;
+
+  // Move to front.
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+  return it->second->Results;
+}
+
+//-----------------------------------------------------------------------------
+
+void asiEngine_FuncCache::Store(const TCollection_AsciiString&    key,
+                                const unsigned long long          hash,
+                                const Handle(Standard_Transient)& results)
+{
+  const t_key entryKey(key.ToCString(), hash);
+
+  std::map<t_key, std::list<t_entry>::iterator>::iterator
+    it = m_index.find(entryKey);
+  //
+  if ( it != m_index.end() )
+  {
+    it->second->Results = results;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  t_entry entry;
+  entry.Key     = entryKey;
+  entry.Results = results;
+  //
+  m_entries.push_front(entry);
+  m_index[entryKey] = m_entries.begin();
+
+  this->evict();
+}
+
+//-----------------------------------------------------------------------------
+
+void asiEngine_FuncCache::SetCapacity(const int capacity)
+{
+  m_iCapacity = capacity;
+  this->evict();
+}
+
+//-----------------------------------------------------------------------------
+
+void asiEngine_FuncCache::Clear()
+{
+  m_entries.clear();
+  m_index.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void asiEngine_FuncCache::evict()
+{
+  while ( int( m_entries.size() ) > std::max(m_iCapacity, 0) )
+  {
+    m_index.erase( m_entries.back().Key );
+    m_entries.pop_back();
+  }
+}
@@ -0,0 +1,212 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiEngine_FuncCache_HeaderFile
+#define asiEngine_FuncCache_HeaderFile
+
+// asiEngine includes
+#include <asiEngine.h>
+
+// OCCT includes
+#include <Geom_BSplineCurve.hxx>
+#include <gp_XYZ.hxx>
+#include <Standard_Transient.hxx>
+#include <TCollection_AsciiString.hxx>
+
+// Standard includes
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+//! Cache of the results computed by staged Tree Functions. Each entry is
+//! keyed by the job key of a function (see asiEngine_StagedFunc) and the
+//! hash of the inputs the results have been computed from. A function
+//! whose inputs are unchanged takes its results from the cache instead of
+//! recomputing them. Several entries per function are allowed, so going
+//! back and forth in the history hits the cache as well. The number of
+//! entries is bounded, and the least recently used ones are evicted.
+class asiEngine_FuncCache : public Standard_Transient
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiEngine_FuncCache, Standard_Transient)
+
+public:
+
+  //! Accumulates the hash of Tree Function inputs.
+  class t_hasher
+  {
+  public:
+
+    //! Ctor.
+    t_hasher() : m_hash(14695981039346656037ull) {}
+
+  public:
+
+    t_hasher& operator<<(const int value)
+    {
+      this->add( &value, sizeof(int) );
+      return *this;
+    }
+
+    t_hasher& operator<<(const bool value)
+    {
+      return *this << int(value);
+    }
+
+    t_hasher& operator<<(const double value)
+    {
+      const double v = (value == 0.) ? 0. : value; // Same hash for -0.
+      this->add( &v, sizeof(double) );
+      return *this;
+    }
+
+    t_hasher& operator<<(const gp_XYZ& value)
+    {
+      return *this << value.X() << value.Y() << value.Z();
+    }
+
+    t_hasher& operator<<(const std::vector<gp_XYZ>& values)
+    {
+      *this << int( values.size() );
+      for ( size_t k = 0; k < values.size(); ++k )
+        *this << values[k];
+
+      return *this;
+    }
+
+    asiEngine_EXPORT t_hasher&
+      operator<<(const Handle(Geom_BSplineCurve)& curve);
+
+  public:
+
+    //! \return accumulated hash.
+    unsigned long long GetValue() const
+    {
+      return m_hash;
+    }
+
+  private:
+
+    //! Mixes the passed bytes into the hash (FNV-1a).
+    void add(const void* pData, const size_t size)
+    {
+      const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+      //
+      for ( size_t k = 0; k < size; ++k )
+      {
+        m_hash ^= pBytes[k];
+        m_hash *= 1099511628211ull;
+      }
+    }
+
+  private:
+
+    unsigned long long m_hash; //!< Accumulated hash.
+  };
+
+public:
+
+  //! Ctor.
+  //! \param[in] capacity max number of entries.
+  asiEngine_EXPORT
+    asiEngine_FuncCache(const int capacity = 256);
+
+public:
+
+  //! Finds the results computed for the given inputs and marks them as
+  //! recently used.
+  //! \param[in] key  job key.
+  //! \param[in] hash hash of the inputs.
+  //! \return cached results or null if there are no such results.
+  asiEngine_EXPORT Handle(Standard_Transient)
+    Find(const TCollection_AsciiString& key,
+         const unsigned long long       hash);
+
+  //! Stores the results computed for the given inputs. The least recently
+  //! used entry is evicted if the cache is full.
+  //! \param[in] key     job key.
+  //! \param[in] hash    hash of the inputs.
+  //! \param[in] results results to store.
+  asiEngine_EXPORT void
+    Store(const TCollection_AsciiString&    key,
+          const unsigned long long          hash,
+          const Handle(Standard_Transient)& results);
+
+  //! Sets max number of entries evicting the extra ones.
+  //! \param[in] capacity max number of entries.
+  asiEngine_EXPORT void
+    SetCapacity(const int capacity);
+
+  //! Removes all entries.
+  asiEngine_EXPORT void
+    Clear();
+
+public:
+
+  //! \return max number of entries.
+  int GetCapacity() const
+  {
+    return m_iCapacity;
+  }
+
+  //! \return number of entries.
+  int GetSize() const
+  {
+    return int( m_entries.size() );
+  }
+
+protected:
+
+  //! Removes the least recently used entries above the capacity.
+  void evict();
+
+protected:
+
+  typedef std::pair<std::string, unsigned long long> t_key;
+
+  //! Cache entry.
+  struct t_entry
+  {
+    t_key                      Key;     //!< Key.
+    Handle(Standard_Transient) Results; //!< Cached results.
+  };
+
+  std::list<t_entry>                               m_entries;   //!< Entries, most recently used first.
+  std::map<t_key, std::list<t_entry>::iterator>    m_index;     //!< Entries by keys.
+  int                                              m_iCapacity; //!< Max number of entries.
+
+};
+
+#endif
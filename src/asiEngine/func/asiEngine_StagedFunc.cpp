@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiEngine_StagedFunc.h>
+
+// asiEngine includes
+#include <asiEngine_Model.h>
+
+//-----------------------------------------------------------------------------
+
+TCollection_AsciiString
+  asiEngine_StagedFunc::GetJobKey(const Handle(ActAPI_HParameterList)& outputs) const
+{
+  TCollection_AsciiString key( this->GetGUID() );
+  //
+  if ( !outputs.IsNull() && outputs->Length() )
+    key += TCollection_AsciiString(":") + outputs->First()->GetNode()->GetId();
+
+  return key;
+}
+
+//-----------------------------------------------------------------------------
+
+int asiEngine_StagedFunc::execute(const Handle(ActAPI_HParameterList)& inputs,
+                                  const Handle(ActAPI_HParameterList)& outputs,
+                                  const Handle(Standard_Transient)&    userData) const
+{
+  // Take the job computed in advance if any.
+  Handle(asiEngine_Model)       M   = Handle(asiEngine_Model)::DownCast(userData);
+  const TCollection_AsciiString key = this->GetJobKey(outputs);
+  Handle(Standard_Transient)    job;
+  //
+  if ( !M.IsNull() )
+    job = M->ExtractFuncJob(key);
+
+  if ( job.IsNull() )
+  {
+    job = this->Prepare(inputs, outputs, userData);
+    //
+    if ( job.IsNull() )
+      return 1; // Error.
+
+    // Take the results from the cache if the inputs are unchanged.
+    Handle(asiEngine_FuncCache) cache  = M.IsNull() ? nullptr : M->GetFuncCache();
+    Handle(Standard_Transient)  cached;
+    const unsigned long long    hash   = this->HashInputs(job);
+    //
+    if ( !cache.IsNull() )
+      cached = cache->Find(key, hash);
+
+    if ( !cached.IsNull() )
+    {
+      this->RestoreResults(cached, job);
+
+      m_progress.SendLogMessage( LogNotice(Normal) << "Inputs of tree function '%1' are unchanged, "
+                                                      "the cached results are reused."
+                                                   << this->GetName() );
+    }
+    // The job keeps the state of a failed computation, so the status is
+    // decided on commit.
+    else if ( this->Compute(job, m_progress, m_plotter) && !cache.IsNull() )
+    {
+      cache->Store( key, hash, this->CacheResults(job) );
+    }
+  }
+
+  return this->Commit(job, outputs, userData);
+}
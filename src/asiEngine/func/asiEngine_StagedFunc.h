@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef asiEngine_StagedFunc_HeaderFile
+#define asiEngine_StagedFunc_HeaderFile
+
+// asiEngine includes
+#include <asiEngine_FuncCache.h>
+
+// Active Data includes
+#include <ActData_BaseTreeFunction.h>
+
+//-----------------------------------------------------------------------------
+
+//! Base class for Tree Functions whose execution is split into stages, so
+//! that the heavy computations of independent functions can run
+//! concurrently. The Data Model is not thread-safe, so the inputs are read
+//! and the outputs are written on the main thread. In between, the function
+//! computes a job holding the copies of all data it needs. When executed by
+//! Active Data, the function runs all stages in a row unless its job has
+//! been computed in advance by asiEngine_FuncScheduler. The results are
+//! cached by the hash of the prepared inputs (see asiEngine_FuncCache), so
+//! the functions whose inputs are unchanged skip computation.
+class asiEngine_StagedFunc : public ActData_BaseTreeFunction
+{
+public:
+
+  // OCCT RTTI
+  DEFINE_STANDARD_RTTI_INLINE(asiEngine_StagedFunc, ActData_BaseTreeFunction)
+
+public:
+
+  //! Reads the input Parameters into a new job. This method is called on
+  //! the main thread.
+  //! \param[in] inputs   input Parameters.
+  //! \param[in] outputs  output Parameters.
+  //! \param[in] userData custom user data.
+  //! \return job to compute or null in case of error.
+  virtual Handle(Standard_Transient)
+    Prepare(const Handle(ActAPI_HParameterList)& inputs,
+            const Handle(ActAPI_HParameterList)& outputs,
+            const Handle(Standard_Transient)&    userData) const = 0;
+
+  //! Computes the prepared job. This method can run concurrently with the
+  //! computation of other jobs, so it must not access the Data Model and
+  //! should use the passed diagnostic tools instead of the function's ones.
+  //! The jobs failed in advance are not committed by the scheduler, so the
+  //! function recomputes them with its own diagnostic tools.
+  //! \param[in] job      job to compute.
+  //! \param[in] progress progress notifier.
+  //! \param[in] plotter  imperative plotter.
+  //! \return true in case of success, false -- otherwise.
+  virtual bool
+    Compute(const Handle(Standard_Transient)& job,
+            ActAPI_ProgressEntry              progress,
+            ActAPI_PlotterEntry               plotter) const = 0;
+
+  //! Writes the results of the computed job to the output Parameters. This
+  //! method is called on the main thread.
+  //! \param[in] job      computed job.
+  //! \param[in] outputs  output Parameters.
+  //! \param[in] userData custom user data.
+  //! \return execution status.
+  virtual int
+    Commit(const Handle(Standard_Transient)&    job,
+           const Handle(ActAPI_HParameterList)& outputs,
+           const Handle(Standard_Transient)&    userData) const = 0;
+
+  //! Computes the hash of the prepared job's inputs. The jobs having equal
+  //! hashes are supposed to give equal results.
+  //! \param[in] job prepared job.
+  //! \return hash of the inputs.
+  virtual unsigned long long
+    HashInputs(const Handle(Standard_Transient)& job) const = 0;
+
+  //! Copies the results of the computed job to be stored in the cache.
+  //! \param[in] job computed job.
+  //! \return object holding the results only.
+  virtual Handle(Standard_Transient)
+    CacheResults(const Handle(Standard_Transient)& job) const = 0;
+
+  //! Copies the cached results to the prepared job, so that it can be
+  //! committed without computation.
+  //! \param[in] cached results stored by CacheResults().
+  //! \param[in] job    prepared job.
+  virtual void
+    RestoreResults(const Handle(Standard_Transient)& cached,
+                   const Handle(Standard_Transient)& job) const = 0;
+
+public:
+
+  //! Composes the key of the job computed for the given output Parameters.
+  //! \param[in] outputs output Parameters.
+  //! \return key of the job.
+  asiEngine_EXPORT TCollection_AsciiString
+    GetJobKey(const Handle(ActAPI_HParameterList)& outputs) const;
+
+protected:
+
+  //! Executes Tree Function stage by stage or commits the job computed in
+  //! advance.
+  //! \param[in]      inputs   input Parameters.
+  //! \param[in, out] outputs  output Parameters.
+  //! \param[in]      userData custom user data.
+  //! \return execution status.
+  asiEngine_EXPORT virtual int
+    execute(const Handle(ActAPI_HParameterList)& inputs,
+            const Handle(ActAPI_HParameterList)& outputs,
+            const Handle(Standard_Transient)&    userData) const;
+
+protected:
+
+  asiEngine_StagedFunc() : ActData_BaseTreeFunction() {} //!< Ctor.
+
+};
+
+#endif
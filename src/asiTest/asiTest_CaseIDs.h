@@ -56,6 +56,22 @@ enum test_CaseID
   CaseID_AAG,
   CaseID_IsContourClosed,
   CaseID_EdgeVexity,
+  CaseID_DeviationStats,
+
+/* ------------------------------------------------------------------------ */
+
+  CaseID_CloudKdTree,
+  CaseID_PurifyCloud,
+  CaseID_Cloudify,
+  CaseID_TiledCloud,
+  CaseID_CloudKernels,
+  CaseID_KHull2d,
+
+/* ------------------------------------------------------------------------ */
+
+  CaseID_MarchingCubes,
+  CaseID_ApproxBSurf,
+  CaseID_MeshInterPlane,
 
 /* ------------------------------------------------------------------------ */
 
@@ -30,14 +30,24 @@
 
 // asiTest includes
 #include <asiTest_AAG.h>
+#include <asiTest_ApproxBSurf.h>
+#include <asiTest_CloudKdTree.h>
+#include <asiTest_CloudKernels.h>
+#include <asiTest_Cloudify.h>
 #include <asiTest_CommonFacilities.h>
+#include <asiTest_DeviationStats.h>
 #include <asiTest_EdgeVexity.h>
 #include <asiTest_InvertShells.h>
 #include <asiTest_IsContourClosed.h>
 #include <asiTest_KEV.h>
+#include <asiTest_KHull2d.h>
+#include <asiTest_MarchingCubes.h>
+#include <asiTest_MeshInterPlane.h>
+#include <asiTest_PurifyCloud.h>
 #include <asiTest_RebuildEdge.h>
 #include <asiTest_RecognizeBlends.h>
 #include <asiTest_SuppressBlends.h>
+#include <asiTest_TiledCloud.h>
 #include <asiTest_Utils.h>
 
 // asiTestEngine includes
@@ -100,6 +110,16 @@ int main(int argc, char* argv[])
   CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_EdgeVexity>      );
   CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_IsContourClosed> );
   CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_Utils>           );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_CloudKdTree>     );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_PurifyCloud>     );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_Cloudify>        );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_TiledCloud>      );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_CloudKernels>    );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_MarchingCubes>   );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_ApproxBSurf>     );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_DeviationStats>  );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_KHull2d>         );
+  CaseLaunchers.push_back( new asiTestEngine_CaseLauncher<asiTest_MeshInterPlane>  );
 
   // Launcher of entire test suite
   asiTestEngine_Launcher Launcher;
@@ -0,0 +1,344 @@
+//-----------------------------------------------------------------------------
+// Created on: 19 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+// Own include
+#include <asiTest_DeviationStats.h>
+
+// asiAlgo includes
+#include <asiAlgo_DeviationStats.h>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of sampled deviations.
+  const int NumValues = 100000;
+
+  //! Number of portions to merge.
+  const int NumParts = 16;
+
+  //! Quantiles to check. The tails are included as the sketch is supposed
+  //! to be accurate there.
+  const double Quantiles[] = { 0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999 };
+
+  //! Max allowed difference between the requested quantile and the rank of
+  //! the estimated value in the sorted sample. The observed errors are
+  //! about 0.001 for 100 centroids.
+  const double RankTol = 0.005;
+
+  //! Samples deviations from the distribution of the given kind: uniform,
+  //! normal or one-sided exponential.
+  //! \param[in] kind distribution index in [0, 2] range.
+  //! \return sampled values.
+  std::vector<double> GenerateValues(const int kind)
+  {
+    std::mt19937                           gen(kind + 1);
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+    std::normal_distribution<double>       normal(0., 0.5);
+    std::exponential_distribution<double>  exponential(10.);
+
+    std::vector<double> values(NumValues);
+    for ( int k = 0; k < NumValues; ++k )
+      values[k] = (kind == 0) ? uniform(gen) : (kind == 1) ? normal(gen) : exponential(gen);
+
+    return values;
+  }
+
+  //! Computes the rank of the value in the sorted sample. The ties are
+  //! counted by half.
+  //! \param[in] sorted sorted values.
+  //! \param[in] x      value to rank.
+  //! \return rank in [0, 1] range.
+  double Rank(const std::vector<double>& sorted, const double x)
+  {
+    const size_t lower = std::lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin();
+    const size_t upper = std::upper_bound(sorted.begin(), sorted.end(), x) - sorted.begin();
+
+    return 0.5*double(lower + upper) / double( sorted.size() );
+  }
+
+  //! Checks the estimated quantiles against the sorted sample.
+  //! \param[in] sorted   sorted values.
+  //! \param[in] estimate function returning the estimated value for a quantile.
+  //! \return true if all ranks are within the tolerance.
+  template <typename TEstimate>
+  bool CheckQuantiles(const std::vector<double>& sorted,
+                      TEstimate                  estimate)
+  {
+    for ( const double q : Quantiles )
+      if ( std::fabs( Rank( sorted, estimate(q) ) - q ) > RankTol )
+        return false;
+
+    return true;
+  }
+
+  //! Accumulates the statistics of the given range of values. The points are
+  //! made up from the value indices.
+  //! \param[in] values  deviations.
+  //! \param[in] first   first index.
+  //! \param[in] last    index after the last one.
+  //! \param[in] histMin lower bound of the histogram.
+  //! \param[in] histMax upper bound of the histogram.
+  //! \return statistics.
+  asiAlgo_DeviationStats Accumulate(const std::vector<double>& values,
+                                    const int                  first,
+                                    const int                  last,
+                                    const double               histMin,
+                                    const double               histMax)
+  {
+    asiAlgo_DeviationStats stats(50, histMin, histMax);
+    //
+    for ( int k = first; k < last; ++k )
+      stats.Add( values[k], gp_Pnt(k, 0., 0.) );
+
+    return stats;
+  }
+
+  //! Checks that the statistics accumulated in different ways are the same.
+  //! The sums are compared with tolerance as they depend on the order of
+  //! additions, whereas the counts and extremes should be equal exactly.
+  //! \param[in] ref    reference statistics.
+  //! \param[in] stats  statistics to check.
+  //! \param[in] sorted sorted values.
+  //! \return true if the statistics agree.
+  bool CheckSame(const asiAlgo_DeviationStats& ref,
+                 const asiAlgo_DeviationStats& stats,
+                 const std::vector<double>&    sorted)
+  {
+    if ( stats.GetCount()  != ref.GetCount()  ||
+         stats.GetMin()    != ref.GetMin()    ||
+         stats.GetMax()    != ref.GetMax()    ||
+         stats.GetMinAbs() != ref.GetMinAbs() ||
+         stats.GetMaxAbs() != ref.GetMaxAbs() )
+      return false;
+
+    if ( std::fabs( stats.GetMean() - ref.GetMean() ) > 1e-12 ||
+         std::fabs( stats.GetRMS()  - ref.GetRMS() )  > 1e-12 )
+      return false;
+
+    std::vector<double> refEdges, edges;
+    std::vector<int>    refCounts, counts;
+    //
+    ref.GetHistogram(0, refEdges, refCounts);
+    stats.GetHistogram(0, edges, counts);
+    //
+    if ( counts != refCounts )
+      return false;
+
+    // The centroids depend on the merge order, so the percentiles are only
+    // compared with the exact ones.
+    return CheckQuantiles( sorted, [&stats](const double q)
+                                   { return stats.GetPercentile(100.*q); } );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_DeviationStats::testQuantiles(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  for ( int kind = 0; kind < 3; ++kind )
+  {
+    std::vector<double> values = GenerateValues(kind);
+
+    asiAlgo_TDigest        digest;
+    asiAlgo_DeviationStats stats;
+    //
+    double sum = 0., sumSq = 0.;
+    //
+    for ( int k = 0; k < NumValues; ++k )
+    {
+      digest.Add(values[k]);
+      stats.Add( values[k], gp_Pnt(k, 0., 0.) );
+
+      sum   += values[k];
+      sumSq += values[k]*values[k];
+    }
+
+    std::sort( values.begin(), values.end() );
+
+    if ( !CheckQuantiles( values, [&digest](const double q) { return digest.Quantile(q); } ) )
+    {
+      cf->Progress.SendLogMessage( LogErr(Normal) << "Quantiles of distribution %1 are off."
+                                                  << kind );
+      return res.failure();
+    }
+
+    // The sketch keeps the extremes exactly.
+    if ( digest.Quantile(0.) != values.front() || digest.Quantile(1.) != values.back() )
+    {
+      cf->Progress.SendLogMessage( LogErr(Normal) << "Extreme quantiles of distribution %1 are not exact."
+                                                  << kind );
+      return res.failure();
+    }
+
+    if ( stats.GetCount() != NumValues                                       ||
+         stats.GetMin() != values.front() || stats.GetMax() != values.back() ||
+         std::fabs( stats.GetMean() - sum/NumValues ) > 1e-12                ||
+         std::fabs( stats.GetRMS() - std::sqrt(sumSq/NumValues) ) > 1e-12 )
+    {
+      cf->Progress.SendLogMessage( LogErr(Normal) << "Moments of distribution %1 are off."
+                                                  << kind );
+      return res.failure();
+    }
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_DeviationStats::testMergeOrder(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  for ( int kind = 0; kind < 3; ++kind )
+  {
+    const std::vector<double> values = GenerateValues(kind);
+    //
+    std::vector<double> sorted(values);
+    std::sort( sorted.begin(), sorted.end() );
+
+    // The histogram range is narrower than the sample, so the end bins
+    // collect the outliers.
+    const double histMin = sorted[NumValues/100];
+    const double histMax = sorted[NumValues - NumValues/100];
+
+    // Accumulate portions as threads would do.
+    std::vector<asiAlgo_DeviationStats> parts;
+    //
+    for ( int i = 0; i < NumParts; ++i )
+      parts.push_back( Accumulate(values,
+                                  i*NumValues/NumParts,
+                                  (i + 1)*NumValues/NumParts,
+                                  histMin, histMax) );
+
+    const asiAlgo_DeviationStats whole = Accumulate(values, 0, NumValues, histMin, histMax);
+
+    // Forward order.
+    asiAlgo_DeviationStats forward(50, histMin, histMax);
+    for ( int i = 0; i < NumParts; ++i )
+      forward.Merge(parts[i]);
+
+    // Reversed order.
+    asiAlgo_DeviationStats reversed(50, histMin, histMax);
+    for ( int i = NumParts - 1; i >= 0; --i )
+      reversed.Merge(parts[i]);
+
+    // Shuffled order.
+    std::vector<int> order(NumParts);
+    for ( int i = 0; i < NumParts; ++i )
+      order[i] = i;
+    //
+    std::shuffle( order.begin(), order.end(), std::mt19937(kind) );
+    //
+    asiAlgo_DeviationStats shuffled(50, histMin, histMax);
+    for ( int i = 0; i < NumParts; ++i )
+      shuffled.Merge(parts[order[i]]);
+
+    // Pairwise reduction as the parallel reducers do.
+    std::vector<asiAlgo_DeviationStats> level(parts);
+    //
+    while ( level.size() > 1 )
+    {
+      std::vector<asiAlgo_DeviationStats> next;
+      //
+      for ( size_t i = 0; i < level.size(); i += 2 )
+      {
+        next.push_back(level[i]);
+        //
+        if ( i + 1 < level.size() )
+          next.back().Merge(level[i + 1]);
+      }
+      //
+      level.swap(next);
+    }
+
+    if ( !CheckSame(whole, whole,    sorted) ||
+         !CheckSame(whole, forward,  sorted) ||
+         !CheckSame(whole, reversed, sorted) ||
+         !CheckSame(whole, shuffled, sorted) ||
+         !CheckSame(whole, level[0], sorted) )
+    {
+      cf->Progress.SendLogMessage( LogErr(Normal) << "Merged statistics of distribution %1 depend on the merge order."
+                                                  << kind );
+      return res.failure();
+    }
+
+    // The digests alone, merged forward and backward.
+    asiAlgo_TDigest digestForward, digestReversed;
+    //
+    for ( int i = 0; i < NumParts; ++i )
+    {
+      asiAlgo_TDigest part;
+      for ( int k = i*NumValues/NumParts; k < (i + 1)*NumValues/NumParts; ++k )
+        part.Add(values[k]);
+
+      digestForward.Merge(part);
+    }
+    //
+    for ( int i = NumParts - 1; i >= 0; --i )
+    {
+      asiAlgo_TDigest part;
+      for ( int k = i*NumValues/NumParts; k < (i + 1)*NumValues/NumParts; ++k )
+        part.Add(values[k]);
+
+      digestReversed.Merge(part);
+    }
+
+    if ( digestForward.GetTotalWeight() != NumValues ||
+         digestReversed.GetTotalWeight() != NumValues ||
+         !CheckQuantiles( sorted, [&digestForward](const double q)  { return digestForward.Quantile(q); } ) ||
+         !CheckQuantiles( sorted, [&digestReversed](const double q) { return digestReversed.Quantile(q); } ) )
+    {
+      cf->Progress.SendLogMessage( LogErr(Normal) << "Merged digests of distribution %1 are off."
+                                                  << kind );
+      return res.failure();
+    }
+  }
+
+  return res.success();
+}
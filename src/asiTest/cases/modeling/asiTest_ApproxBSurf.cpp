@@ -0,0 +1,322 @@
+//-----------------------------------------------------------------------------
+// Created on: 19 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiTest_ApproxBSurf.h>
+
+// asiAlgo includes
+#include <asiAlgo_ApproxBSurf.h>
+
+// OCCT includes
+#include <BSplCLib.hxx>
+#include <math_Gauss.hxx>
+#include <math_Matrix.hxx>
+#include <math_Vector.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+
+// Standard includes
+#include <cmath>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Degree of the known surface in both directions.
+  const int Degree = 3;
+
+  //! Number of poles of the known surface in both directions.
+  const int NumPoles = 7;
+
+  //! Number of samples in both directions.
+  const int NumSamples = 100;
+
+  //! Amplitude of the noise added to the samples.
+  const double Noise = 1.e-3;
+
+  //! Tolerance of the comparison of poles and points.
+  const double Prec = 1.e-6;
+
+  //! Builds a B-surface over [0, 2] x [0, 1] in XOY with uniform knots.
+  //! The poles are placed at the Greville abscissae, so the X and Y
+  //! coordinates depend on the parameters linearly.
+  //! \param[in] isFlat whether to build a planar surface.
+  //! \return B-surface.
+  Handle(Geom_BSplineSurface) BuildSurface(const bool isFlat)
+  {
+    const int numKnots = NumPoles - Degree + 1;
+
+    TColStd_Array1OfReal    knots(1, numKnots);
+    TColStd_Array1OfInteger mults(1, numKnots);
+    //
+    for ( int i = 1; i <= numKnots; ++i )
+    {
+      knots(i) = double(i - 1) / (numKnots - 1);
+      mults(i) = (i == 1 || i == numKnots) ? Degree + 1 : 1;
+    }
+
+    TColStd_Array1OfReal flatKnots(1, NumPoles + Degree + 1), greville(1, NumPoles);
+    //
+    BSplCLib::KnotSequence(knots, mults, flatKnots);
+    BSplCLib::BuildSchoenbergPoints(Degree, flatKnots, greville);
+
+    TColgp_Array2OfPnt poles(1, NumPoles, 1, NumPoles);
+    //
+    for ( int i = 1; i <= NumPoles; ++i )
+      for ( int j = 1; j <= NumPoles; ++j )
+        poles(i, j) = gp_Pnt( 2.*greville(i),
+                              greville(j),
+                              isFlat ? 0. : 0.2*std::sin(1.3*i)*std::cos(0.7*j) );
+
+    return new Geom_BSplineSurface(poles, knots, knots, mults, mults, Degree, Degree);
+  }
+
+  //! Samples the surface in a regular grid of parameters.
+  //! \param[in]  surf   surface to sample.
+  //! \param[in]  noise  amplitude of the noise added along OZ. Such noise
+  //!                    keeps the projections of the samples to XOY.
+  //! \param[out] params (u, v) pairs of the samples.
+  //! \return samples.
+  Handle(asiAlgo_BaseCloud<double>) Sample(const Handle(Geom_BSplineSurface)& surf,
+                                           const double                       noise,
+                                           std::vector<double>&               params)
+  {
+    std::mt19937                           gen(1);
+    std::uniform_real_distribution<double> uniform(-noise, noise);
+
+    Handle(asiAlgo_BaseCloud<double>) points = new asiAlgo_BaseCloud<double>;
+    //
+    for ( int i = 0; i < NumSamples; ++i )
+      for ( int j = 0; j < NumSamples; ++j )
+      {
+        const double u = (i + 0.5) / NumSamples;
+        const double v = (j + 0.5) / NumSamples;
+        //
+        params.push_back(u);
+        params.push_back(v);
+
+        gp_XYZ P = surf->Value(u, v).XYZ();
+        P.SetZ( P.Z() + uniform(gen) );
+        //
+        points->AddElement(P);
+      }
+
+    return points;
+  }
+
+  //! Fits the points keeping the knots of the planar surface.
+  //! \param[in] points     points to fit.
+  //! \param[in] isParallel whether to run in parallel.
+  //! \param[in] progress   progress notifier.
+  //! \return fitted surface or null handle in case of failure.
+  Handle(Geom_BSplineSurface) Fit(const Handle(asiAlgo_BaseCloud<double>)& points,
+                                  const bool                               isParallel,
+                                  ActAPI_ProgressEntry                     progress)
+  {
+    asiAlgo_ApproxBSurf approx(points, progress);
+    approx.SetParallelMode(isParallel);
+    //
+    if ( !approx.Perform( BuildSurface(true) ) )
+      return nullptr;
+
+    return approx.GetResult();
+  }
+
+  //! Solves the dense normal equations assembled for all points at once.
+  //! \param[in]  points points to fit.
+  //! \param[in]  params (u, v) pairs of the points.
+  //! \param[out] poles  resulting poles.
+  //! \return true in case of success, false -- otherwise.
+  bool SolveDense(const Handle(asiAlgo_BaseCloud<double>)& points,
+                  const std::vector<double>&               params,
+                  TColgp_Array2OfPnt&                      poles)
+  {
+    const int n = NumPoles*NumPoles;
+
+    TColStd_Array1OfReal flatKnots(1, NumPoles + Degree + 1);
+    BuildSurface(true)->UKnotSequence(flatKnots);
+
+    math_Matrix A(1, n, 1, n, 0.);
+    math_Vector B[3] = { math_Vector(1, n, 0.), math_Vector(1, n, 0.), math_Vector(1, n, 0.) };
+    math_Matrix Nu(1, 1, 1, Degree + 1), Nv(1, 1, 1, Degree + 1);
+
+    for ( int k = 0; k < points->GetNumberOfElements(); ++k )
+    {
+      int uFirst = 0, vFirst = 0;
+      BSplCLib::EvalBsplineBasis(0, Degree + 1, flatKnots, params[2*k],     uFirst, Nu);
+      BSplCLib::EvalBsplineBasis(0, Degree + 1, flatKnots, params[2*k + 1], vFirst, Nv);
+
+      const gp_XYZ P = points->GetElement(k);
+
+      for ( int a = 0; a <= Degree; ++a )
+        for ( int b = 0; b <= Degree; ++b )
+        {
+          const int    r  = (uFirst - 1 + a)*NumPoles + vFirst + b;
+          const double Nr = Nu(1, a + 1)*Nv(1, b + 1);
+          //
+          B[0](r) += Nr*P.X();
+          B[1](r) += Nr*P.Y();
+          B[2](r) += Nr*P.Z();
+
+          for ( int a2 = 0; a2 <= Degree; ++a2 )
+            for ( int b2 = 0; b2 <= Degree; ++b2 )
+              A(r, (uFirst - 1 + a2)*NumPoles + vFirst + b2) += Nr*Nu(1, a2 + 1)*Nv(1, b2 + 1);
+        }
+    }
+
+    math_Gauss gauss(A);
+    //
+    if ( !gauss.IsDone() )
+      return false;
+
+    math_Vector X[3] = { math_Vector(1, n), math_Vector(1, n), math_Vector(1, n) };
+    //
+    for ( int d = 0; d < 3; ++d )
+      gauss.Solve(B[d], X[d]);
+
+    for ( int r = 1; r <= n; ++r )
+      poles( (r - 1) / NumPoles + 1, (r - 1) % NumPoles + 1 ) = gp_Pnt( X[0](r), X[1](r), X[2](r) );
+
+    return true;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_ApproxBSurf::testFitDeviation(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Fit exact samples of the known surface. The samples project to the
+     planar initial surface to their own parameters, so the fitted surface
+     should coincide with the known one. */
+
+  Handle(Geom_BSplineSurface)       known = BuildSurface(false);
+  std::vector<double>               params;
+  Handle(asiAlgo_BaseCloud<double>) points = Sample(known, 0., params);
+  Handle(Geom_BSplineSurface)       fit    = Fit(points, true, cf->Progress);
+  //
+  if ( fit.IsNull() )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Cannot fit the samples.");
+    return res.failure();
+  }
+
+  double maxDev = 0.;
+  //
+  for ( int k = 0; k < points->GetNumberOfElements(); ++k )
+  {
+    const gp_Pnt S = fit->Value(params[2*k], params[2*k + 1]);
+    //
+    maxDev = std::max( maxDev, S.Distance( gp_Pnt( points->GetElement(k) ) ) );
+  }
+
+  cf->Progress.SendLogMessage(LogInfo(Normal) << "Max deviation of samples: %1." << maxDev);
+  //
+  if ( maxDev > Prec )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Fitted surface deviates from the samples.");
+    return res.failure();
+  }
+
+  for ( int i = 1; i <= NumPoles; ++i )
+    for ( int j = 1; j <= NumPoles; ++j )
+      if ( fit->Pole(i, j).Distance( known->Pole(i, j) ) > Prec )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Pole (%1, %2) differs from the known one."
+                                                    << i << j );
+        return res.failure();
+      }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_ApproxBSurf::testAssembly(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Fit noisy samples and compare the poles assembled by spans with the
+     solution of the dense normal equations. */
+
+  std::vector<double>               params;
+  Handle(asiAlgo_BaseCloud<double>) points = Sample(BuildSurface(false), Noise, params);
+  Handle(Geom_BSplineSurface)       seqFit = Fit(points, false, cf->Progress);
+  Handle(Geom_BSplineSurface)       parFit = Fit(points, true,  cf->Progress);
+  //
+  if ( seqFit.IsNull() || parFit.IsNull() )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Cannot fit the samples.");
+    return res.failure();
+  }
+
+  TColgp_Array2OfPnt densePoles(1, NumPoles, 1, NumPoles);
+  //
+  if ( !SolveDense(points, params, densePoles) )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Cannot solve dense normal equations.");
+    return res.failure();
+  }
+
+  for ( int i = 1; i <= NumPoles; ++i )
+    for ( int j = 1; j <= NumPoles; ++j )
+    {
+      // The sums are accumulated in the same order in both modes.
+      const gp_Pnt P = seqFit->Pole(i, j);
+      const gp_Pnt Q = parFit->Pole(i, j);
+      //
+      if ( P.X() != Q.X() || P.Y() != Q.Y() || P.Z() != Q.Z() )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Pole (%1, %2) differs in parallel mode."
+                                                    << i << j );
+        return res.failure();
+      }
+
+      if ( P.Distance( densePoles(i, j) ) > Prec )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Pole (%1, %2) differs from the dense solution."
+                                                    << i << j );
+        return res.failure();
+      }
+    }
+
+  return res.success();
+}
@@ -0,0 +1,282 @@
+//-----------------------------------------------------------------------------
+// Created on: 19 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiTest_MarchingCubes.h>
+
+// asiAlgo includes
+#include <asiAlgo_MarchingCubes.h>
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Radius of the sphere.
+  const double Radius = 1.;
+
+  //! Center of the sphere. It is shifted off the grid nodes, so that no
+  //! node lies exactly on the surface.
+  const double Center[3] = { 0.013, -0.021, 0.007 };
+
+  //! Number of grid cells along each axis.
+  const int NumCells = 40;
+
+  //! Size of the grid cell.
+  const float CellSize = 0.08f;
+
+  //! Samples the signed distance field of the sphere in a uniform grid.
+  //! \return uniform grid.
+  Handle(asiAlgo_UniformGrid<float>) SampleSphere()
+  {
+    const float                        origin = -0.5f*NumCells*CellSize;
+    Handle(asiAlgo_UniformGrid<float>) grid   = new asiAlgo_UniformGrid<float>(origin, origin, origin,
+                                                                              NumCells, NumCells, NumCells,
+                                                                              CellSize);
+    for ( int k = 0; k <= NumCells; ++k )
+      for ( int j = 0; j <= NumCells; ++j )
+        for ( int i = 0; i <= NumCells; ++i )
+        {
+          const double x = origin + i*CellSize - Center[0];
+          const double y = origin + j*CellSize - Center[1];
+          const double z = origin + k*CellSize - Center[2];
+          //
+          grid->ChangeValue(i, j, k) = float( std::sqrt(x*x + y*y + z*z) - Radius );
+        }
+
+    return grid;
+  }
+
+  //! Polygonizes the sphere.
+  //! \param[in] isParallel whether to run in parallel.
+  //! \param[in] progress   progress notifier.
+  //! \return mesh or null handle in case of failure.
+  Handle(Poly_Triangulation) PolygonizeSphere(const bool           isParallel,
+                                              ActAPI_ProgressEntry progress)
+  {
+    asiAlgo_MarchingCubes mc(progress);
+    mc.SetParallelMode(isParallel);
+    //
+    if ( !mc.Perform( SampleSphere() ) )
+      return nullptr;
+
+    return mc.GetResult();
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_MarchingCubes::testSphereClosed(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  Handle(Poly_Triangulation) mesh = PolygonizeSphere(true, cf->Progress);
+  //
+  if ( mesh.IsNull() )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Marching cubes failed.");
+    return res.failure();
+  }
+
+  /* Each directed edge should appear once and have its opposite, so that
+     every edge is shared by exactly two consistently oriented triangles. */
+
+  std::map<std::pair<int, int>, int> edges;
+  //
+  for ( int t = 1; t <= mesh->NbTriangles(); ++t )
+  {
+    int n[3];
+    mesh->Triangle(t).Get(n[0], n[1], n[2]);
+    //
+    if ( n[0] == n[1] || n[1] == n[2] || n[2] == n[0] )
+    {
+      cf->Progress.SendLogMessage(LogErr(Normal) << "Triangle %1 is degenerated." << t);
+      return res.failure();
+    }
+
+    for ( int k = 0; k < 3; ++k )
+      edges[std::make_pair( n[k], n[(k + 1) % 3] )]++;
+  }
+  //
+  for ( std::map<std::pair<int, int>, int>::const_iterator it = edges.begin(); it != edges.end(); ++it )
+  {
+    std::map<std::pair<int, int>, int>::const_iterator opp
+      = edges.find( std::make_pair(it->first.second, it->first.first) );
+    //
+    if ( it->second != 1 || opp == edges.end() || opp->second != 1 )
+    {
+      cf->Progress.SendLogMessage( LogErr(Normal) << "Edge (%1, %2) is not shared by two triangles."
+                                                  << it->first.first << it->first.second );
+      return res.failure();
+    }
+  }
+
+  // Check the topology of the sphere: V - E + F = 2.
+  const int euler = mesh->NbNodes() - int( edges.size() )/2 + mesh->NbTriangles();
+  //
+  if ( euler != 2 )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Unexpected Euler characteristic %1." << euler);
+    return res.failure();
+  }
+
+  // The nodes lie on the sphere up to the interpolation error.
+  for ( int n = 1; n <= mesh->NbNodes(); ++n )
+  {
+    const gp_Pnt& P = mesh->Node(n);
+    const double  d = std::sqrt( (P.X() - Center[0])*(P.X() - Center[0])
+                               + (P.Y() - Center[1])*(P.Y() - Center[1])
+                               + (P.Z() - Center[2])*(P.Z() - Center[2]) );
+    //
+    if ( std::fabs(d - Radius) > 0.1*CellSize )
+    {
+      cf->Progress.SendLogMessage(LogErr(Normal) << "Node %1 is off the sphere." << n);
+      return res.failure();
+    }
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_MarchingCubes::testSphereNoDuplicates(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  Handle(Poly_Triangulation) mesh = PolygonizeSphere(true, cf->Progress);
+  //
+  if ( mesh.IsNull() )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Marching cubes failed.");
+    return res.failure();
+  }
+
+  // Sort the nodes by X and compare each node with the following ones
+  // within the tolerance.
+  const double tol = 1.e-6*CellSize;
+  //
+  std::vector< std::array<double, 3> > nodes;
+  //
+  for ( int n = 1; n <= mesh->NbNodes(); ++n )
+  {
+    const gp_Pnt& P = mesh->Node(n);
+    nodes.push_back( std::array<double, 3>{ {P.X(), P.Y(), P.Z()} } );
+  }
+  //
+  std::sort( nodes.begin(), nodes.end() );
+
+  for ( size_t i = 0; i < nodes.size(); ++i )
+  {
+    for ( size_t j = i + 1; j < nodes.size() && nodes[j][0] - nodes[i][0] <= tol; ++j )
+    {
+      if ( std::fabs(nodes[j][1] - nodes[i][1]) <= tol &&
+           std::fabs(nodes[j][2] - nodes[i][2]) <= tol )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Duplicated node (%1, %2, %3)."
+                                                    << nodes[i][0] << nodes[i][1] << nodes[i][2] );
+        return res.failure();
+      }
+    }
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_MarchingCubes::testSphereParallel(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  Handle(Poly_Triangulation) seqMesh = PolygonizeSphere(false, cf->Progress);
+  Handle(Poly_Triangulation) parMesh = PolygonizeSphere(true,  cf->Progress);
+  //
+  if ( seqMesh.IsNull() || parMesh.IsNull() )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Marching cubes failed.");
+    return res.failure();
+  }
+
+  if ( seqMesh->NbNodes()     != parMesh->NbNodes() ||
+       seqMesh->NbTriangles() != parMesh->NbTriangles() )
+  {
+    cf->Progress.SendLogMessage( LogErr(Normal) << "Sequential mesh has %1 nodes and %2 triangles "
+                                                   "while parallel mesh has %3 nodes and %4 triangles."
+                                                << seqMesh->NbNodes() << seqMesh->NbTriangles()
+                                                << parMesh->NbNodes() << parMesh->NbTriangles() );
+    return res.failure();
+  }
+
+  // The meshes should be identical, including the numbering.
+  for ( int n = 1; n <= seqMesh->NbNodes(); ++n )
+  {
+    const gp_Pnt& P = seqMesh->Node(n);
+    const gp_Pnt& Q = parMesh->Node(n);
+    //
+    if ( P.X() != Q.X() || P.Y() != Q.Y() || P.Z() != Q.Z() )
+    {
+      cf->Progress.SendLogMessage(LogErr(Normal) << "Node %1 differs in parallel mode." << n);
+      return res.failure();
+    }
+  }
+  //
+  for ( int t = 1; t <= seqMesh->NbTriangles(); ++t )
+  {
+    int s[3], p[3];
+    seqMesh->Triangle(t).Get(s[0], s[1], s[2]);
+    parMesh->Triangle(t).Get(p[0], p[1], p[2]);
+    //
+    if ( s[0] != p[0] || s[1] != p[1] || s[2] != p[2] )
+    {
+      cf->Progress.SendLogMessage(LogErr(Normal) << "Triangle %1 differs in parallel mode." << t);
+      return res.failure();
+    }
+  }
+
+  return res.success();
+}
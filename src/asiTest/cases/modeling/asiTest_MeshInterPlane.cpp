@@ -0,0 +1,317 @@
+//-----------------------------------------------------------------------------
+// Created on: 19 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+// Own include
+#include <asiTest_MeshInterPlane.h>
+
+// asiAlgo includes
+#include <asiAlgo_MeshInterPlane.h>
+
+// OCCT includes
+#include <Geom_Plane.hxx>
+
+// Standard includes
+#include <cmath>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Distance between the octahedra.
+  const double Spacing = 5.;
+
+  //! Builds a mesh of several unit octahedra placed along the X axis. The
+  //! octahedra do not share nodes, so each of them gives its own section.
+  //! \param[in] numOcta number of octahedra.
+  //! \return mesh.
+  Handle(Poly_Triangulation) MakeOctahedra(const int numOcta)
+  {
+    const double nodes[6][3] = { {  1.,  0.,  0. }, {  0.,  1.,  0. },
+                                 { -1.,  0.,  0. }, {  0., -1.,  0. },
+                                 {  0.,  0.,  1. }, {  0.,  0., -1. } };
+
+    // Triangles oriented outwards.
+    const int tris[8][3] = { { 1, 2, 5 }, { 2, 3, 5 }, { 3, 4, 5 }, { 4, 1, 5 },
+                             { 2, 1, 6 }, { 3, 2, 6 }, { 4, 3, 6 }, { 1, 4, 6 } };
+
+    Handle(Poly_Triangulation) mesh = new Poly_Triangulation(6*numOcta, 8*numOcta, false);
+    //
+    for ( int o = 0; o < numOcta; ++o )
+    {
+      for ( int i = 0; i < 6; ++i )
+        mesh->ChangeNode(6*o + i + 1) = gp_Pnt(nodes[i][0] + o*Spacing, nodes[i][1], nodes[i][2]);
+      //
+      for ( int t = 0; t < 8; ++t )
+        mesh->ChangeTriangle(8*o + t + 1).Set(6*o + tris[t][0], 6*o + tris[t][1], 6*o + tris[t][2]);
+    }
+
+    return mesh;
+  }
+
+  //! Builds a mesh of a vertical unit square made of two triangles.
+  //! \return mesh.
+  Handle(Poly_Triangulation) MakeSquare()
+  {
+    Handle(Poly_Triangulation) mesh = new Poly_Triangulation(4, 2, false);
+    //
+    mesh->ChangeNode(1) = gp_Pnt(0., 0., -1.);
+    mesh->ChangeNode(2) = gp_Pnt(1., 0., -1.);
+    mesh->ChangeNode(3) = gp_Pnt(1., 0.,  1.);
+    mesh->ChangeNode(4) = gp_Pnt(0., 0.,  1.);
+    //
+    mesh->ChangeTriangle(1).Set(1, 2, 3);
+    mesh->ChangeTriangle(2).Set(1, 3, 4);
+
+    return mesh;
+  }
+
+  //! Checks the polylines of a section.
+  //! \param[in] section   section to check.
+  //! \param[in] numLoops  expected number of polylines.
+  //! \param[in] isClosed  expected closedness of the polylines.
+  //! \param[in] numPts    expected number of points in each polyline.
+  //! \param[in] level     expected height of the points.
+  //! \param[in] progress  progress notifier.
+  //! \return true if the section is as expected.
+  bool CheckSection(const asiAlgo_MeshInterPlane::t_section& section,
+                    const int                                numLoops,
+                    const bool                               isClosed,
+                    const int                                numPts,
+                    const double                             level,
+                    ActAPI_ProgressEntry                     progress)
+  {
+    if ( int( section.size() ) != numLoops )
+    {
+      progress.SendLogMessage( LogErr(Normal) << "Unexpected number of polylines: %1 instead of %2."
+                                              << int( section.size() ) << numLoops );
+      return false;
+    }
+
+    for ( size_t l = 0; l < section.size(); ++l )
+    {
+      if ( section[l].IsClosed != isClosed )
+      {
+        progress.SendLogMessage( LogErr(Normal) << "Polyline %1 is expected to be %2."
+                                                << int(l + 1) << (isClosed ? "closed" : "open") );
+        return false;
+      }
+      //
+      if ( int( section[l].Pts.size() ) != numPts )
+      {
+        progress.SendLogMessage( LogErr(Normal) << "Polyline %1 has %2 points instead of %3."
+                                                << int(l + 1) << int( section[l].Pts.size() ) << numPts );
+        return false;
+      }
+      //
+      for ( size_t p = 0; p < section[l].Pts.size(); ++p )
+      {
+        if ( std::fabs(section[l].Pts[p].Z() - level) > 1.e-12 )
+        {
+          progress.SendLogMessage( LogErr(Normal) << "Point %1 of polyline %2 is off the plane."
+                                                  << int(p + 1) << int(l + 1) );
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_MeshInterPlane::testSingleSection(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  const double level = 0.3;
+
+  asiAlgo_MeshInterPlane algo( MakeOctahedra(1), cf->Progress, cf->Plotter );
+  //
+  if ( !algo.Perform(new Geom_Plane( gp_Pnt(0., 0., level), gp::DZ() ), true) )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Slicing failed.");
+    return res.failure();
+  }
+
+  // The plane crosses the four edges going to the top node.
+  if ( algo.GetSections().size() != 1 ||
+       !CheckSection(algo.GetSections()[0], 1, true, 4, level, cf->Progress) )
+    return res.failure();
+
+  if ( algo.GetResult()->GetNumberOfElements() != 4 )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Unexpected number of section points.");
+    return res.failure();
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_MeshInterPlane::testTwoSections(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  const double level = -0.4;
+
+  asiAlgo_MeshInterPlane algo( MakeOctahedra(2), cf->Progress, cf->Plotter );
+  //
+  if ( !algo.Perform(new Geom_Plane( gp_Pnt(0., 0., level), gp::DZ() ), true) )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Slicing failed.");
+    return res.failure();
+  }
+
+  // Each octahedron gives its own closed loop.
+  if ( algo.GetSections().size() != 1 ||
+       !CheckSection(algo.GetSections()[0], 2, true, 4, level, cf->Progress) )
+    return res.failure();
+
+  // The points of a loop belong to the same octahedron.
+  const asiAlgo_MeshInterPlane::t_section& section = algo.GetSections()[0];
+  //
+  for ( size_t l = 0; l < section.size(); ++l )
+  {
+    const double xMid = section[l].Pts[0].X() > 0.5*Spacing ? Spacing : 0.;
+    //
+    for ( size_t p = 0; p < section[l].Pts.size(); ++p )
+    {
+      if ( std::fabs(section[l].Pts[p].X() - xMid) > 1. )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Polyline %1 mixes the sections."
+                                                    << int(l + 1) );
+        return res.failure();
+      }
+    }
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_MeshInterPlane::testOpenSection(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  const double level = 0.3;
+
+  asiAlgo_MeshInterPlane algo( MakeSquare(), cf->Progress, cf->Plotter );
+  //
+  if ( !algo.Perform(new Geom_Plane( gp_Pnt(0., 0., level), gp::DZ() ), true) )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Slicing failed.");
+    return res.failure();
+  }
+
+  // Two boundary edges and the diagonal are crossed.
+  if ( algo.GetSections().size() != 1 ||
+       !CheckSection(algo.GetSections()[0], 1, false, 3, level, cf->Progress) )
+    return res.failure();
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_MeshInterPlane::testStack(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  // The levels are not sorted, and the last one misses the mesh.
+  std::vector<double> levels;
+  levels.push_back(0.3);
+  levels.push_back(-0.4);
+  levels.push_back(2.);
+
+  for ( int p = 0; p < 2; ++p )
+  {
+    for ( int s = 0; s < 2; ++s )
+    {
+      const bool doSort = (s == 1);
+
+      asiAlgo_MeshInterPlane algo( MakeOctahedra(2), cf->Progress, cf->Plotter );
+      algo.SetParallelMode(p == 1);
+      //
+      if ( !algo.Perform(gp_Ax3( gp::Origin(), gp::DZ() ), levels, doSort) )
+      {
+        cf->Progress.SendLogMessage(LogErr(Normal) << "Slicing failed.");
+        return res.failure();
+      }
+
+      const std::vector<asiAlgo_MeshInterPlane::t_section>& sections = algo.GetSections();
+      //
+      if ( sections.size() != levels.size() )
+      {
+        cf->Progress.SendLogMessage(LogErr(Normal) << "Unexpected number of sections.");
+        return res.failure();
+      }
+
+      /* Linked sections consist of a closed loop per octahedron. Without
+         linking, all points of a section come in a single open polyline. */
+
+      for ( size_t k = 0; k < 2; ++k )
+      {
+        const bool isOk = doSort ? CheckSection(sections[k], 2, true,  4, levels[k], cf->Progress)
+                                 : CheckSection(sections[k], 1, false, 8, levels[k], cf->Progress);
+        if ( !isOk )
+          return res.failure();
+      }
+      //
+      if ( !sections[2].empty() )
+      {
+        cf->Progress.SendLogMessage(LogErr(Normal) << "The plane missing the mesh gives a section.");
+        return res.failure();
+      }
+    }
+  }
+
+  return res.success();
+}
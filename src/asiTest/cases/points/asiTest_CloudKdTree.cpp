@@ -0,0 +1,246 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiTest_CloudKdTree.h>
+
+// asiAlgo includes
+#include <asiAlgo_CloudKdTree.h>
+
+// Standard includes
+#include <algorithm>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of points in the test cloud.
+  const int NumPoints = 20000;
+
+  //! Number of query points.
+  const int NumQueries = 500;
+
+  //! Generates a flattened random cloud with duplicated points.
+  //! \param[in] numPts number of points to generate.
+  //! \param[in] seed   random seed.
+  //! \return point coordinates.
+  std::vector<double> GenerateCoords(const int numPts, const unsigned seed)
+  {
+    std::mt19937                           gen(seed);
+    std::uniform_real_distribution<double> uniform(-1., 1.);
+
+    std::vector<double> coords;
+    for ( int i = 0; i < numPts; ++i )
+    {
+      for ( int a = 0; a < 3; ++a )
+      {
+        if ( i && (i % 5 == 0) )
+          coords.push_back( coords[3*(i - 1) + a] );
+        else
+          coords.push_back( (a == 2 ? 0.01 : 1.)*uniform(gen) );
+      }
+    }
+    return coords;
+  }
+
+  //! Computes sorted squared distances from the query point to all points.
+  //! \param[in] coords point coordinates.
+  //! \param[in] P      query point.
+  //! \return sorted squared distances.
+  std::vector<double> BruteForce(const std::vector<double>& coords,
+                                 const double*              P)
+  {
+    std::vector<double> sqDists;
+    for ( size_t i = 0; i < coords.size(); i += 3 )
+    {
+      const double dx = coords[i]     - P[0];
+      const double dy = coords[i + 1] - P[1];
+      const double dz = coords[i + 2] - P[2];
+      //
+      sqDists.push_back(dx*dx + dy*dy + dz*dz);
+    }
+    std::sort( sqDists.begin(), sqDists.end() );
+    return sqDists;
+  }
+
+  //! Computes squared distance from the query point to the given point.
+  //! \param[in] coords point coordinates.
+  //! \param[in] idx    0-based index of the point.
+  //! \param[in] P      query point.
+  //! \return squared distance.
+  double SquareDist(const std::vector<double>& coords,
+                    const int                  idx,
+                    const double*              P)
+  {
+    const double dx = coords[3*idx]     - P[0];
+    const double dy = coords[3*idx + 1] - P[1];
+    const double dz = coords[3*idx + 2] - P[2];
+    //
+    return dx*dx + dy*dy + dz*dz;
+  }
+
+  //! Collects indices of the points within the given radius by brute force.
+  //! \param[in] coords point coordinates.
+  //! \param[in] P      query point.
+  //! \param[in] radius search radius.
+  //! \return sorted indices.
+  std::vector<int> BruteForceInRadius(const std::vector<double>& coords,
+                                      const double*              P,
+                                      const double               radius)
+  {
+    std::vector<int> indices;
+    for ( int i = 0; i < int( coords.size()/3 ); ++i )
+    {
+      if ( SquareDist(coords, i, P) <= radius*radius )
+        indices.push_back(i);
+    }
+    return indices;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_CloudKdTree::testKNearest(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Compare batched kNN queries against brute force. */
+
+  const std::vector<double> coords  = GenerateCoords(NumPoints, 1);
+  const std::vector<double> queries = GenerateCoords(NumQueries, 2);
+  const int                 k       = 8;
+
+  Handle(asiAlgo_CloudKdTree<double>) tree = new asiAlgo_CloudKdTree<double>(cf->Progress);
+  //
+  if ( !tree->Build(new asiAlgo_BaseCloud<double>(coords), 8) )
+    return res.failure();
+
+  std::vector<int>    indices;
+  std::vector<double> sqDists;
+  tree->FindKNearest(queries, k, indices, sqDists);
+
+  for ( int q = 0; q < NumQueries; ++q )
+  {
+    const std::vector<double> ref = BruteForce(coords, &queries[3*q]);
+
+    for ( int i = 0; i < k; ++i )
+    {
+      if ( sqDists[q*k + i] != ref[i] )
+      {
+        cf->Progress.SendLogMessage(LogErr(Normal) << "Unexpected distance to neighbor %1 "
+                                                      "of query point %2." << i << q);
+        return res.failure();
+      }
+    }
+
+    // The cloud contains duplicated points, so the indices are compared
+    // up to ties: each index has to be unique and to refer to the point
+    // at the reported distance. Together with the distances checked above,
+    // this makes the indices a valid brute-force answer.
+    std::vector<int> found( indices.begin() + q*k, indices.begin() + (q + 1)*k );
+    //
+    for ( int i = 0; i < k; ++i )
+    {
+      if ( found[i] < 0 || found[i] >= NumPoints ||
+           SquareDist(coords, found[i], &queries[3*q]) != sqDists[q*k + i] )
+      {
+        cf->Progress.SendLogMessage(LogErr(Normal) << "Unexpected index of neighbor %1 "
+                                                      "of query point %2." << i << q);
+        return res.failure();
+      }
+    }
+    //
+    std::sort( found.begin(), found.end() );
+    //
+    if ( std::adjacent_find( found.begin(), found.end() ) != found.end() )
+    {
+      cf->Progress.SendLogMessage(LogErr(Normal) << "Repeated neighbors of query point %1." << q);
+      return res.failure();
+    }
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_CloudKdTree::testRadius(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Compare batched radius queries against brute force. */
+
+  const std::vector<double> coords  = GenerateCoords(NumPoints, 3);
+  const std::vector<double> queries = GenerateCoords(NumQueries, 4);
+  const double              radius  = 0.05;
+
+  Handle(asiAlgo_CloudKdTree<double>) tree = new asiAlgo_CloudKdTree<double>(cf->Progress);
+  //
+  if ( !tree->Build(new asiAlgo_BaseCloud<double>(coords)) )
+    return res.failure();
+
+  std::vector< std::vector<int> >    indices;
+  std::vector< std::vector<double> > sqDists;
+  tree->FindInRadius(queries, radius, indices, sqDists);
+
+  for ( int q = 0; q < NumQueries; ++q )
+  {
+    const std::vector<double> ref = BruteForce(coords, &queries[3*q]);
+    const size_t              num = std::upper_bound(ref.begin(), ref.end(), radius*radius) - ref.begin();
+
+    if ( sqDists[q].size() != num || !std::equal( sqDists[q].begin(), sqDists[q].end(), ref.begin() ) )
+    {
+      cf->Progress.SendLogMessage(LogErr(Normal) << "Unexpected neighbors of query point %1." << q);
+      return res.failure();
+    }
+
+    // Compare indices.
+    std::vector<int> found = indices[q];
+    std::sort( found.begin(), found.end() );
+    //
+    if ( found != BruteForceInRadius(coords, &queries[3*q], radius) )
+    {
+      cf->Progress.SendLogMessage(LogErr(Normal) << "Unexpected indices of neighbors "
+                                                    "of query point %1." << q);
+      return res.failure();
+    }
+  }
+
+  return res.success();
+}
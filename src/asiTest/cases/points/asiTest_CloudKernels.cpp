@@ -0,0 +1,370 @@
+//-----------------------------------------------------------------------------
+// Created on: 19 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiTest_CloudKernels.h>
+
+// asiAlgo includes
+#include <asiAlgo_BaseCloud.h>
+#include <asiAlgo_CloudKernels.h>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Numbers of points to test. None of the non-trivial sizes is a multiple
+  //! of the vector width, and the largest ones span several blocks.
+  const int NumPoints[] = { 1, 2, 3, 5, 7, 9, 13, 1023, 1025, 65539, 131085 };
+
+  //! Generates random points in a box off the origin.
+  //! \param[in] numPts number of points.
+  //! \return point coordinates.
+  template <typename T>
+  std::vector<T> GenerateCoords(const int numPts)
+  {
+    std::mt19937                           gen(numPts);
+    std::uniform_real_distribution<double> uniform(-50., 150.);
+
+    std::vector<T> coords(3*numPts);
+    for ( size_t k = 0; k < coords.size(); ++k )
+      coords[k] = T( uniform(gen) );
+
+    return coords;
+  }
+
+  //! Checks the bounding box kernel against the scalar loop.
+  //! \param[in] numPts     number of points.
+  //! \param[in] isParallel whether to run the kernel in parallel.
+  //! \return true if the boxes are equal.
+  template <typename T>
+  bool CheckBoundingBox(const int numPts, const bool isParallel)
+  {
+    const std::vector<T> coords = GenerateCoords<T>(numPts);
+
+    T ref[6] = {  std::numeric_limits<T>::max(), -std::numeric_limits<T>::max(),
+                  std::numeric_limits<T>::max(), -std::numeric_limits<T>::max(),
+                  std::numeric_limits<T>::max(), -std::numeric_limits<T>::max() };
+    //
+    for ( int i = 0; i < numPts; ++i )
+    {
+      for ( int a = 0; a < 3; ++a )
+      {
+        ref[2*a]     = std::min(ref[2*a],     coords[3*i + a]);
+        ref[2*a + 1] = std::max(ref[2*a + 1], coords[3*i + a]);
+      }
+    }
+
+    T bounds[6];
+    asiAlgo_CloudKernels::ComputeBoundingBox(&coords[0], numPts, bounds, isParallel);
+
+    // Min and max are exact, so the boxes should be equal bit to bit.
+    for ( int k = 0; k < 6; ++k )
+      if ( bounds[k] != ref[k] )
+        return false;
+
+    return true;
+  }
+
+  //! Checks the covariance kernel against the two-pass scalar loop.
+  //! \param[in] numPts     number of points.
+  //! \param[in] isParallel whether to run the kernel in parallel.
+  //! \param[in] relTol     tolerance relative to the spread of points.
+  //! \return true if the results are equal within the tolerance.
+  template <typename T>
+  bool CheckCovariance(const int    numPts,
+                       const bool   isParallel,
+                       const double relTol)
+  {
+    const std::vector<T> coords = GenerateCoords<T>(numPts);
+
+    double refCentroid[3] = {0., 0., 0.};
+    //
+    for ( int i = 0; i < numPts; ++i )
+      for ( int a = 0; a < 3; ++a )
+        refCentroid[a] += coords[3*i + a];
+    //
+    for ( int a = 0; a < 3; ++a )
+      refCentroid[a] /= numPts;
+
+    double refCovariance[9] = {0., 0., 0., 0., 0., 0., 0., 0., 0.};
+    //
+    for ( int i = 0; i < numPts; ++i )
+      for ( int r = 0; r < 3; ++r )
+        for ( int c = 0; c < 3; ++c )
+          refCovariance[3*r + c] += (coords[3*i + r] - refCentroid[r])
+                                   *(coords[3*i + c] - refCentroid[c]);
+    //
+    for ( int k = 0; k < 9; ++k )
+      refCovariance[k] /= numPts;
+
+    double centroid[3], covariance[9];
+    asiAlgo_CloudKernels::ComputeCovariance(&coords[0], numPts, centroid, covariance, isParallel);
+
+    // The scale of coordinates is 150 and the variances are up to 100^2.
+    const double scale = 150.;
+    //
+    for ( int a = 0; a < 3; ++a )
+      if ( std::fabs(centroid[a] - refCentroid[a]) > relTol*scale )
+        return false;
+    //
+    for ( int k = 0; k < 9; ++k )
+      if ( std::fabs(covariance[k] - refCovariance[k]) > relTol*scale*scale )
+        return false;
+
+    return true;
+  }
+
+  //! Checks the transformation kernel against the scalar loop.
+  //! \param[in] numPts     number of points.
+  //! \param[in] isParallel whether to run the kernel in parallel.
+  //! \param[in] relTol     tolerance relative to the scale of coordinates.
+  //! \return true if the results are equal within the tolerance.
+  template <typename T>
+  bool CheckTransform(const int    numPts,
+                      const bool   isParallel,
+                      const double relTol)
+  {
+    const std::vector<T> coords = GenerateCoords<T>(numPts);
+
+    // Rotation by 30 degrees around Z, scaling and translation.
+    const double c = 0.5*std::sqrt(3.), s = 0.5;
+    const double mx[12] = { 2.*c, -2.*s, 0.,  10.,
+                            2.*s,  2.*c, 0., -20.,
+                            0.,    0.,   2.,  30. };
+
+    std::vector<T> ref( coords.size() );
+    //
+    for ( int i = 0; i < numPts; ++i )
+      for ( int r = 0; r < 3; ++r )
+        ref[3*i + r] = T( mx[4*r]*coords[3*i] + mx[4*r + 1]*coords[3*i + 1]
+                        + mx[4*r + 2]*coords[3*i + 2] + mx[4*r + 3] );
+
+    std::vector<T> result( coords.size() );
+    asiAlgo_CloudKernels::Transform(&coords[0], numPts, mx, &result[0], isParallel);
+
+    // The transformed coordinates are up to 400 in magnitude.
+    const double scale = 400.;
+    //
+    for ( size_t k = 0; k < ref.size(); ++k )
+      if ( std::fabs( double(result[k]) - double(ref[k]) ) > relTol*scale )
+        return false;
+
+    // Transform in place.
+    std::vector<T> inplace = coords;
+    asiAlgo_CloudKernels::Transform(&inplace[0], numPts, mx, &inplace[0], isParallel);
+    //
+    return inplace == result;
+  }
+
+  //! Checks merging of a cloud with itself and with another cloud.
+  //! \param[in] numPts     number of points in each cloud.
+  //! \param[in] isParallel whether to run the kernel in parallel.
+  //! \return true if the merged coordinates are as expected.
+  template <typename T>
+  bool CheckMerge(const int numPts, const bool isParallel)
+  {
+    const std::vector<T> coords = GenerateCoords<T>(numPts);
+    const std::vector<T> others = GenerateCoords<T>(numPts + 1);
+
+    // Single cloud merged with itself.
+    Handle(asiAlgo_BaseCloud<T>) self = new asiAlgo_BaseCloud<T>(coords);
+    self->Merge(self);
+
+    std::vector<T> ref = coords;
+    ref.insert( ref.end(), coords.begin(), coords.end() );
+    //
+    if ( self->GetCoords() != ref )
+      return false;
+
+    // Several clouds including the result itself.
+    Handle(asiAlgo_BaseCloud<T>) result = new asiAlgo_BaseCloud<T>(coords);
+    Handle(asiAlgo_BaseCloud<T>) other  = new asiAlgo_BaseCloud<T>(others);
+    //
+    std::vector<Handle(asiAlgo_BaseCloud<T>)> clouds;
+    clouds.push_back(result);
+    clouds.push_back( Handle(asiAlgo_BaseCloud<T>)() );
+    clouds.push_back(other);
+    clouds.push_back(result);
+    //
+    asiAlgo_CloudKernels::Merge(clouds, *result, isParallel);
+
+    ref = coords;
+    ref.insert( ref.end(), coords.begin(), coords.end() );
+    ref.insert( ref.end(), others.begin(), others.end() );
+    ref.insert( ref.end(), coords.begin(), coords.end() );
+    //
+    return result->GetCoords() == ref;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_CloudKernels::testBoundingBox(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  cf->Progress.SendLogMessage( LogInfo(Normal) << "Kernels are compiled for %1."
+                                               << asiAlgo_CloudKernels::GetInstructionSet() );
+
+  // The box of no points is void.
+  float  fBounds[6];
+  double dBounds[6];
+  //
+  asiAlgo_CloudKernels::ComputeBoundingBox( (const float*) nullptr, 0, fBounds );
+  asiAlgo_CloudKernels::ComputeBoundingBox( (const double*) nullptr, 0, dBounds );
+  //
+  for ( int a = 0; a < 3; ++a )
+  {
+    if ( fBounds[2*a] <= fBounds[2*a + 1] || dBounds[2*a] <= dBounds[2*a + 1] )
+    {
+      cf->Progress.SendLogMessage(LogErr(Normal) << "Bounding box of empty cloud is not void.");
+      return res.failure();
+    }
+  }
+
+  for ( int n : NumPoints )
+  {
+    for ( int p = 0; p < 2; ++p )
+    {
+      if ( !CheckBoundingBox<float>(n, p == 1) || !CheckBoundingBox<double>(n, p == 1) )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Unexpected bounding box of %1 point(s)."
+                                                    << n );
+        return res.failure();
+      }
+    }
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_CloudKernels::testCovariance(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  for ( int n : NumPoints )
+  {
+    for ( int p = 0; p < 2; ++p )
+    {
+      if ( !CheckCovariance<float>(n, p == 1, 1.e-6) || !CheckCovariance<double>(n, p == 1, 1.e-12) )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Unexpected covariance of %1 point(s)."
+                                                    << n );
+        return res.failure();
+      }
+    }
+  }
+
+  // The results do not depend on the number of threads.
+  const std::vector<float> coords = GenerateCoords<float>(NumPoints[10]);
+  //
+  double centroid[2][3], covariance[2][9];
+  //
+  for ( int p = 0; p < 2; ++p )
+    asiAlgo_CloudKernels::ComputeCovariance(&coords[0], NumPoints[10], centroid[p], covariance[p], p == 1);
+  //
+  if ( !std::equal(centroid[0], centroid[0] + 3, centroid[1]) ||
+       !std::equal(covariance[0], covariance[0] + 9, covariance[1]) )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Parallel covariance differs from the sequential one.");
+    return res.failure();
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_CloudKernels::testTransform(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  for ( int n : NumPoints )
+  {
+    for ( int p = 0; p < 2; ++p )
+    {
+      if ( !CheckTransform<float>(n, p == 1, 1.e-6) || !CheckTransform<double>(n, p == 1, 1.e-14) )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Unexpected transformation of %1 point(s)."
+                                                    << n );
+        return res.failure();
+      }
+    }
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_CloudKernels::testMerge(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  for ( int n : NumPoints )
+  {
+    for ( int p = 0; p < 2; ++p )
+    {
+      if ( !CheckMerge<float>(n, p == 1) || !CheckMerge<double>(n, p == 1) )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Unexpected merge of clouds with %1 point(s)."
+                                                    << n );
+        return res.failure();
+      }
+    }
+  }
+
+  return res.success();
+}
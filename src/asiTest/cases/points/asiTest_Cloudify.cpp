@@ -0,0 +1,219 @@
+//-----------------------------------------------------------------------------
+// Created on: 19 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+// Own include
+#include <asiTest_Cloudify.h>
+
+// asiAlgo includes
+#include <asiAlgo_Cloudify.h>
+#include <asiAlgo_Utils.h>
+
+// OCCT includes
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+
+// Standard includes
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Builds a model with planar and curved faces.
+  //! \return model to sample.
+  TopoDS_Shape BuildModel()
+  {
+    return BRepPrimAPI_MakeCylinder(8., 25.).Shape();
+  }
+
+  //! Reads binary PLY file written by asiAlgo_Cloudify.
+  //! \param[in]  filename file to read.
+  //! \param[out] coords   point coordinates.
+  //! \return true in case of success, false -- otherwise.
+  bool ReadPly(const std::string&   filename,
+               std::vector<double>& coords)
+  {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    //
+    if ( !file.is_open() )
+      return false;
+
+    // Parse header.
+    std::string line;
+    long long   numPts   = -1;
+    bool        isBinary = false;
+    //
+    while ( std::getline(file, line) && line != "end_header" )
+    {
+      std::istringstream iss(line);
+      std::string        keyword, arg;
+      iss >> keyword >> arg;
+      //
+      if ( keyword == "format" )
+        isBinary = (arg == "binary_little_endian");
+      else if ( keyword == "element" && arg == "vertex" )
+        iss >> numPts;
+    }
+    //
+    if ( line != "end_header" || !isBinary || numPts < 0 )
+      return false;
+
+    // Read points.
+    coords.resize( size_t(3*numPts) );
+    //
+    if ( numPts )
+      file.read( reinterpret_cast<char*>(&coords[0]), std::streamsize( coords.size()*sizeof(double) ) );
+    //
+    if ( !file )
+      return false;
+
+    // Nothing is expected after the points.
+    return file.peek() == std::char_traits<char>::eof();
+  }
+
+  //! Samples the model in memory and to a PLY file, and compares the results.
+  //! \param[in] model    model to sample.
+  //! \param[in] onFacets whether to sample facets.
+  //! \param[in] progress progress notifier.
+  //! \return true if the results are the same.
+  bool CompareStreamWithMemory(const TopoDS_Shape&  model,
+                               const bool           onFacets,
+                               ActAPI_ProgressEntry progress)
+  {
+    const std::string filename = asiAlgo_Utils::Str::Slashed( asiAlgo_Utils::Env::AsiTestDumping() )
+                               + "asiTest_Cloudify.ply";
+
+    // Sample in memory.
+    Handle(asiAlgo_BaseCloud<double>) memPts;
+    //
+    asiAlgo_Cloudify memCloudify(1.0);
+    //
+    if ( onFacets ? !memCloudify.Sample_Facets(model, memPts) : !memCloudify.Sample_Faces(model, memPts) )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "In-memory sampling failed.");
+      return false;
+    }
+
+    // Sample to file.
+    Handle(asiAlgo_BaseCloud<double>) streamPts;
+    //
+    asiAlgo_Cloudify streamCloudify(1.0);
+    streamCloudify.SetOutputFilename( filename.c_str() );
+    //
+    if ( onFacets ? !streamCloudify.Sample_Facets(model, streamPts) : !streamCloudify.Sample_Faces(model, streamPts) )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "Streaming sampling failed.");
+      return false;
+    }
+
+    std::vector<double> fileCoords;
+    const bool          isRead = ReadPly(filename, fileCoords);
+    //
+    std::remove( filename.c_str() );
+    //
+    if ( !isRead )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "Cannot read PLY file '%1'." << filename);
+      return false;
+    }
+
+    // Compare.
+    const std::vector<double>& memCoords = memPts->GetCoords();
+    //
+    if ( memCoords.empty() )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "No points are sampled.");
+      return false;
+    }
+    //
+    if ( !streamPts->IsEmpty() )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "Point cloud is not empty in the streaming mode.");
+      return false;
+    }
+    //
+    if ( streamCloudify.GetNumberOfSamples() != int64_t( memCoords.size()/3 ) ||
+         memCloudify.GetNumberOfSamples()    != int64_t( memCoords.size()/3 ) )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "Unexpected number of samples.");
+      return false;
+    }
+    //
+    if ( fileCoords != memCoords )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "PLY file contents differ from the in-memory point cloud.");
+      return false;
+    }
+
+    return true;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_Cloudify::testStreamFaces(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Compare the surface samples streamed to PLY with the in-memory result. */
+
+  if ( !CompareStreamWithMemory(BuildModel(), false, cf->Progress) )
+    return res.failure();
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_Cloudify::testStreamFacets(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Compare the facet samples streamed to PLY with the in-memory result. */
+
+  TopoDS_Shape model = BuildModel();
+  BRepMesh_IncrementalMesh(model, 0.5);
+
+  if ( !CompareStreamWithMemory(model, true, cf->Progress) )
+    return res.failure();
+
+  return res.success();
+}
@@ -0,0 +1,335 @@
+//-----------------------------------------------------------------------------
+// Created on: 19 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+// Own include
+#include <asiTest_KHull2d.h>
+
+// asiAlgo includes
+#include <asiAlgo_KHull2d.h>
+
+// OCCT includes
+#include <GCE2d_MakeSegment.hxx>
+#include <Geom2d_TrimmedCurve.hxx>
+#include <Geom2dAPI_InterCurveCurve.hxx>
+#include <gp_Pnt2d.hxx>
+
+// Standard includes
+#include <random>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Concave hull checking the link intersections with the built-in
+  //! predicate. The predicate is exposed for testing.
+  class KHull2d : public asiAlgo_KHull2d<gp_XY>
+  {
+  public:
+
+    //! Ctor.
+    //! \param[in] cloud    initial cloud.
+    //! \param[in] k        number of neighbors to start calculation with.
+    //! \param[in] progress progress notifier.
+    //! \param[in] plotter  imperative plotter.
+    KHull2d(const Handle(asiAlgo_PointWithAttrCloud<gp_XY>)& cloud,
+            const int                                        k,
+            ActAPI_ProgressEntry                             progress,
+            ActAPI_PlotterEntry                              plotter)
+    : asiAlgo_KHull2d<gp_XY>(cloud, k, 0, progress, plotter)
+    {}
+
+    //! Checks whether the links intersect.
+    bool AreLinksIntersecting(const gp_XY& A1, const gp_XY& A2,
+                              const gp_XY& B1, const gp_XY& B2) const
+    {
+      return this->areLinksIntersecting(A1, A2, B1, B2);
+    }
+  };
+
+  //! Concave hull checking the link intersections with OCCT intersector as
+  //! the former implementation did.
+  class KHull2dOcct : public KHull2d
+  {
+  public:
+
+    //! Ctor.
+    //! \param[in] cloud    initial cloud.
+    //! \param[in] k        number of neighbors to start calculation with.
+    //! \param[in] progress progress notifier.
+    //! \param[in] plotter  imperative plotter.
+    KHull2dOcct(const Handle(asiAlgo_PointWithAttrCloud<gp_XY>)& cloud,
+                const int                                        k,
+                ActAPI_ProgressEntry                             progress,
+                ActAPI_PlotterEntry                              plotter)
+    : KHull2d(cloud, k, progress, plotter)
+    {}
+
+  protected:
+
+    //! Intersects the links with Geom2dAPI_InterCurveCurve.
+    virtual bool areLinksIntersecting(const gp_XY& A1, const gp_XY& A2,
+                                      const gp_XY& B1, const gp_XY& B2) const
+    {
+      Handle(Geom2d_TrimmedCurve) L  = GCE2d_MakeSegment( gp_Pnt2d(A1), gp_Pnt2d(A2) );
+      Handle(Geom2d_TrimmedCurve) LL = GCE2d_MakeSegment( gp_Pnt2d(B1), gp_Pnt2d(B2) );
+
+      Geom2dAPI_InterCurveCurve IntCC(L, LL);
+      return IntCC.NbPoints() > 0;
+    }
+  };
+
+  //! Pair of links with the expected result of their intersection test.
+  struct t_linkCase
+  {
+    gp_XY A1, A2, B1, B2; //!< Links.
+    bool  isIntersecting; //!< Expected result.
+  };
+
+  //! Adds point to the cloud.
+  //! \param[in]     P     point to add.
+  //! \param[in,out] cloud target cloud.
+  void AddPoint(const gp_XY&                               P,
+                Handle(asiAlgo_PointWithAttrCloud<gp_XY>)& cloud)
+  {
+    const int idx = cloud->GetNumberOfElements();
+    //
+    cloud->AddElement( asiAlgo_PointWithAttr<gp_XY>(P, 0, idx) );
+  }
+
+  //! Adds the nodes of a regular grid to the cloud. The rows and columns
+  //! of the grid make lots of collinear points.
+  //! \param[in]     origin corner of the grid.
+  //! \param[in]     numX   number of nodes along X.
+  //! \param[in]     numY   number of nodes along Y.
+  //! \param[in]     step   distance between nodes.
+  //! \param[in,out] cloud  target cloud.
+  void AddGrid(const gp_XY&                               origin,
+               const int                                  numX,
+               const int                                  numY,
+               const double                               step,
+               Handle(asiAlgo_PointWithAttrCloud<gp_XY>)& cloud)
+  {
+    for ( int j = 0; j < numY; ++j )
+      for ( int i = 0; i < numX; ++i )
+        AddPoint( origin + gp_XY(i*step, j*step), cloud );
+  }
+
+  //! \return point sets to compute the hulls for.
+  std::vector< Handle(asiAlgo_PointWithAttrCloud<gp_XY>) > PointSets()
+  {
+    std::vector< Handle(asiAlgo_PointWithAttrCloud<gp_XY>) > sets;
+
+    // Regular grid: the hull runs along the collinear boundary nodes.
+    {
+      Handle(asiAlgo_PointWithAttrCloud<gp_XY>) cloud = new asiAlgo_PointWithAttrCloud<gp_XY>;
+      AddGrid(gp_XY(0., 0.), 15, 10, 1., cloud);
+      sets.push_back(cloud);
+    }
+
+    // L-shaped region of grid nodes with a concave corner.
+    {
+      Handle(asiAlgo_PointWithAttrCloud<gp_XY>) cloud = new asiAlgo_PointWithAttrCloud<gp_XY>;
+      AddGrid(gp_XY(0., 0.), 20, 4, 0.5, cloud);
+      AddGrid(gp_XY(0., 2.), 4, 16, 0.5, cloud);
+      sets.push_back(cloud);
+    }
+
+    // Random points in a C-shaped region.
+    {
+      Handle(asiAlgo_PointWithAttrCloud<gp_XY>) cloud = new asiAlgo_PointWithAttrCloud<gp_XY>;
+      //
+      std::mt19937                           gen(7);
+      std::uniform_real_distribution<double> uniform(0., 10.);
+      //
+      while ( cloud->GetNumberOfElements() < 2000 )
+      {
+        const gp_XY P( uniform(gen), uniform(gen) );
+        //
+        if ( P.X() > 3. && P.Y() > 3. && P.Y() < 7. )
+          continue;
+
+        AddPoint(P, cloud);
+      }
+      sets.push_back(cloud);
+    }
+
+    // U-shaped region of grid nodes shifted by less than the intersection
+    // tolerance, so the rows and columns are only almost collinear.
+    {
+      Handle(asiAlgo_PointWithAttrCloud<gp_XY>) cloud = new asiAlgo_PointWithAttrCloud<gp_XY>;
+      //
+      std::mt19937                           gen(11);
+      std::uniform_real_distribution<double> uniform(-5.0e-7, 5.0e-7);
+      //
+      for ( int j = 0; j < 10; ++j )
+        for ( int i = 0; i < 15; ++i )
+        {
+          if ( i > 4 && i < 10 && j > 2 )
+            continue;
+
+          AddPoint( gp_XY( i + uniform(gen), j + uniform(gen) ), cloud );
+        }
+      //
+      sets.push_back(cloud);
+    }
+
+    // Grids almost touching at the corner and along the side. The gaps are
+    // either below or well above the intersection tolerance.
+    const double gaps[] = { 5.0e-7, 1.0e-5 };
+    //
+    for ( const double gap : gaps )
+    {
+      Handle(asiAlgo_PointWithAttrCloud<gp_XY>) corner = new asiAlgo_PointWithAttrCloud<gp_XY>;
+      AddGrid(gp_XY(0., 0.),             5, 5, 1., corner);
+      AddGrid(gp_XY(4. + gap, 4. + gap), 5, 5, 1., corner);
+      sets.push_back(corner);
+
+      Handle(asiAlgo_PointWithAttrCloud<gp_XY>) side = new asiAlgo_PointWithAttrCloud<gp_XY>;
+      AddGrid(gp_XY(0., 0.),        5, 5, 1., side);
+      AddGrid(gp_XY(4. + gap, 0.5), 5, 5, 1., side);
+      sets.push_back(side);
+    }
+
+    return sets;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_KHull2d::testLinks(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  const t_linkCase cases[] =
+  {
+    // Proper crossing.
+    { gp_XY(0., 0.), gp_XY(2., 2.), gp_XY(0., 2.), gp_XY(2., 0.), true },
+    // Disjoint links.
+    { gp_XY(0., 0.), gp_XY(1., 0.), gp_XY(0., 1.), gp_XY(1., 2.), false },
+    // End point on the interior of the other link.
+    { gp_XY(0., 0.), gp_XY(2., 0.), gp_XY(1., 0.), gp_XY(1., 1.), true },
+    // End point closer to the other link than the tolerance.
+    { gp_XY(0., 0.), gp_XY(2., 0.), gp_XY(1., 5.0e-7), gp_XY(1., 1.), true },
+    // End point apart from the other link.
+    { gp_XY(0., 0.), gp_XY(2., 0.), gp_XY(1., 1.0e-5), gp_XY(1., 1.), false },
+    // Parallel links.
+    { gp_XY(0., 0.), gp_XY(2., 0.), gp_XY(0., 1.0e-3), gp_XY(2., 1.0e-3), false },
+    // Collinear links with a gap.
+    { gp_XY(0., 0.), gp_XY(1., 0.), gp_XY(2., 0.), gp_XY(3., 0.), false },
+    // Collinear links almost touching at the ends.
+    { gp_XY(0., 0.), gp_XY(1., 0.), gp_XY(1. + 5.0e-7, 0.), gp_XY(2., 0.), true },
+    // Collinear links apart at the ends.
+    { gp_XY(0., 0.), gp_XY(1., 0.), gp_XY(1. + 1.0e-5, 0.), gp_XY(2., 0.), false },
+  };
+
+  Handle(asiAlgo_PointWithAttrCloud<gp_XY>) cloud = new asiAlgo_PointWithAttrCloud<gp_XY>;
+  //
+  KHull2d     hull     (cloud, 3, cf->Progress, cf->Plotter);
+  KHull2dOcct hullOcct (cloud, 3, cf->Progress, cf->Plotter);
+
+  int caseIdx = 0;
+  for ( const t_linkCase& c : cases )
+  {
+    // Both orders of links are checked.
+    if ( hull.AreLinksIntersecting(c.A1, c.A2, c.B1, c.B2)     != c.isIntersecting ||
+         hull.AreLinksIntersecting(c.B1, c.B2, c.A1, c.A2)     != c.isIntersecting ||
+         hullOcct.AreLinksIntersecting(c.A1, c.A2, c.B1, c.B2) != c.isIntersecting )
+    {
+      cf->Progress.SendLogMessage( LogErr(Normal) << "Unexpected intersection test for links %1."
+                                                  << caseIdx );
+      return res.failure();
+    }
+
+    caseIdx++;
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_KHull2d::testHulls(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  const std::vector< Handle(asiAlgo_PointWithAttrCloud<gp_XY>) > sets = PointSets();
+  //
+  for ( size_t s = 0; s < sets.size(); ++s )
+  {
+    const int ks[] = { 3, 5, 10 };
+    //
+    for ( const int k : ks )
+    {
+      KHull2d     hull     (sets[s], k, cf->Progress, cf->Plotter);
+      KHull2dOcct hullOcct (sets[s], k, cf->Progress, cf->Plotter);
+      //
+      const bool isDone     = hull.Perform();
+      const bool isDoneOcct = hullOcct.Perform();
+
+      if ( !isDone )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Failed to build hull of point set %1 with k = %2."
+                                                    << int(s) << k );
+        return res.failure();
+      }
+
+      // The hulls should pass the same points in the same order.
+      const Handle(asiAlgo_PointWithAttrCloud<gp_XY>)& hullPts     = hull.GetHull();
+      const Handle(asiAlgo_PointWithAttrCloud<gp_XY>)& hullPtsOcct = hullOcct.GetHull();
+      //
+      bool isSame = (isDoneOcct == isDone)
+                 && (hullOcct.GetK() == hull.GetK())
+                 && (hullPtsOcct->GetNumberOfElements() == hullPts->GetNumberOfElements());
+      //
+      for ( int i = 0; isSame && i < hullPts->GetNumberOfElements(); ++i )
+        isSame = (hullPtsOcct->GetElement(i).Index == hullPts->GetElement(i).Index);
+
+      if ( !isSame )
+      {
+        cf->Progress.SendLogMessage( LogErr(Normal) << "Hulls of point set %1 with k = %2 differ from "
+                                                       "those built with Geom2dAPI_InterCurveCurve."
+                                                    << int(s) << k );
+        return res.failure();
+      }
+    }
+  }
+
+  return res.success();
+}
@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <asiTest_PurifyCloud.h>
+
+// asiAlgo includes
+#include <asiAlgo_PurifyCloud.h>
+
+// Standard includes
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Compares the voxel hashing purification against the reference cell
+  //! filter in sequential, parallel and in-place modes.
+  //! \param[in] tol      tolerance to use.
+  //! \param[in] pts      point cloud to purify.
+  //! \param[in] progress progress notifier.
+  //! \return true if all results are exactly the same.
+  bool CompareWithReference(const double                             tol,
+                            const Handle(asiAlgo_BaseCloud<double>)& pts,
+                            ActAPI_ProgressEntry                     progress)
+  {
+    // Reference result.
+    Handle(asiAlgo_BaseCloud<double>) ref;
+    asiAlgo_PurifyCloud().PerformCommon<asiAlgo_BaseCloud<double>,
+                                        asiAlgo_Inspector3d>(tol, pts, ref);
+
+    for ( int mode = 0; mode < 3; ++mode )
+    {
+      Handle(asiAlgo_BaseCloud<double>) source = new asiAlgo_BaseCloud<double>( pts->GetCoords() );
+      Handle(asiAlgo_BaseCloud<double>) result;
+      //
+      if ( mode == 2 )
+        result = source; // In-place compaction.
+
+      asiAlgo_PurifyCloud purify;
+      purify.SetParallelMode(mode != 0);
+      purify.Perform3d(tol, source, result);
+
+      if ( result.IsNull() || result->GetCoords() != ref->GetCoords() )
+      {
+        progress.SendLogMessage( LogErr(Normal) << "Purification result differs from "
+                                                   "the reference one (mode %1, tolerance %2)."
+                                                << mode << tol );
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_PurifyCloud::testRandom(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Random clusters of points with exact duplicates. */
+
+  std::mt19937                           gen(1);
+  std::uniform_real_distribution<double> uniform(-1., 1.);
+  //
+  const double tols[] = {0.001, 0.01, 0.1};
+  //
+  for ( int t = 0; t < 3; ++t )
+  {
+    const double tol = tols[t];
+
+    std::vector<double> coords;
+    for ( int i = 0; i < 6000; ++i )
+    {
+      if ( i && (i % 7 == 0) )
+      {
+        // Duplicate one of the previous points.
+        const int j = int(gen() % i);
+        //
+        coords.push_back(coords[3*j]);
+        coords.push_back(coords[3*j + 1]);
+        coords.push_back(coords[3*j + 2]);
+      }
+      else
+      {
+        // Dense clusters make many points fall within the tolerance.
+        const double scale = (i % 2) ? 1. : 3.*tol;
+        //
+        coords.push_back( scale*uniform(gen) );
+        coords.push_back( scale*uniform(gen) );
+        coords.push_back( scale*uniform(gen) );
+      }
+    }
+
+    if ( !CompareWithReference(tol, new asiAlgo_BaseCloud<double>(coords), cf->Progress) )
+      return res.failure();
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_PurifyCloud::testGrid(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Points lying on and near the cell boundaries. The inspection range of
+     such points is shifted to the neighbor cells, so the elimination order
+     is not symmetric. */
+
+  const double tol     = 0.05;
+  const double shift[] = {0., 0.5*Precision::Confusion(), -0.5*Precision::Confusion(), 0.5*tol};
+  //
+  std::vector<double> coords;
+  //
+  for ( int i = -6; i <= 6; ++i )
+    for ( int j = -6; j <= 6; ++j )
+      for ( int k = -6; k <= 6; ++k )
+        for ( int s = 0; s < 4; ++s )
+        {
+          coords.push_back(i*tol + shift[s]);
+          coords.push_back(j*tol + shift[(s + 1) % 4]);
+          coords.push_back(k*tol + shift[(s + 2) % 4]);
+        }
+
+  if ( !CompareWithReference(tol, new asiAlgo_BaseCloud<double>(coords), cf->Progress) )
+    return res.failure();
+
+  return res.success();
+}
@@ -0,0 +1,346 @@
+//-----------------------------------------------------------------------------
+// Created on: 19 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+// Own include
+#include <asiTest_TiledCloud.h>
+
+// asiAlgo includes
+#include <asiAlgo_TiledCloud.h>
+#include <asiAlgo_Utils.h>
+
+// Standard includes
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <random>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Number of points in the test cloud.
+  const int NumPoints = 100000;
+
+  //! Depth of the octree.
+  const int Depth = 3;
+
+  //! Max number of buffered points. It is small to make the writer spill
+  //! the points to the temporary file many times.
+  const int BufferSize = 7777;
+
+  //! Precision of the coordinates stored as 32-bit floats.
+  const double Prec = 1.e-5;
+
+  //! Generates random points in [-5, 5]^3.
+  //! \return point coordinates.
+  std::vector<double> GenerateCoords()
+  {
+    std::mt19937                           gen(1);
+    std::uniform_real_distribution<double> uniform(-5., 5.);
+
+    std::vector<double> coords(3*NumPoints);
+    for ( size_t k = 0; k < coords.size(); ++k )
+      coords[k] = uniform(gen);
+
+    return coords;
+  }
+
+  //! \return name of the file to write the tiled cloud to.
+  std::string GetFilename()
+  {
+    return asiAlgo_Utils::Str::Slashed( asiAlgo_Utils::Env::AsiTestDumping() )
+         + "asiTest_TiledCloud.tiles";
+  }
+
+  //! Writes the points to the tiled file and opens it.
+  //! \param[in] coords   points to write.
+  //! \param[in] progress progress notifier.
+  //! \return opened tiled cloud or null handle in case of failure.
+  Handle(asiAlgo_TiledCloud) WriteAndOpen(const std::vector<double>& coords,
+                                          ActAPI_ProgressEntry       progress)
+  {
+    const std::string filename = GetFilename();
+
+    asiAlgo_TiledCloudWriter writer(filename);
+    writer.SetBufferSize(BufferSize);
+    //
+    if ( !writer.Begin(-5., 5., -5., 5., -5., 5., Depth) ||
+         !writer.Add( new asiAlgo_BaseCloud<double>(coords) ) ||
+         !writer.End() )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "Cannot write tiled cloud '%1'." << filename);
+      return nullptr;
+    }
+
+    Handle(asiAlgo_TiledCloud) cloud = new asiAlgo_TiledCloud;
+    //
+    if ( !cloud->Open(filename) )
+    {
+      progress.SendLogMessage(LogErr(Normal) << "Cannot open tiled cloud '%1'." << filename);
+      return nullptr;
+    }
+
+    return cloud;
+  }
+
+  //! Closes the cloud and removes its file.
+  //! \param[in] cloud cloud to close.
+  void CloseAndRemove(const Handle(asiAlgo_TiledCloud)& cloud)
+  {
+    cloud->Close();
+    std::remove( GetFilename().c_str() );
+  }
+
+  //! Checks whether the point is in the box.
+  //! \param[in] P   point to check.
+  //! \param[in] box box (xMin, xMax, yMin, yMax, zMin, zMax).
+  //! \return true if the point is in the box.
+  bool IsIn(const double* P, const double* box)
+  {
+    for ( int a = 0; a < 3; ++a )
+      if ( P[a] < box[2*a] || P[a] > box[2*a + 1] )
+        return false;
+
+    return true;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_TiledCloud::testRoundTrip(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Write a cloud and compare its tiles with the input binned by the same octree. */
+
+  const std::vector<double>  coords = GenerateCoords();
+  Handle(asiAlgo_TiledCloud) cloud  = WriteAndOpen(coords, cf->Progress);
+  //
+  if ( cloud.IsNull() )
+    return res.failure();
+
+  // Bin the input points in the order of adding.
+  const int                                 numCells = 1 << Depth;
+  const double                              cellSize = 10./numCells;
+  std::map< uint32_t, std::vector<double> > expected;
+  //
+  for ( int i = 0; i < NumPoints; ++i )
+  {
+    int idx[3];
+    for ( int a = 0; a < 3; ++a )
+      idx[a] = std::max( 0, std::min( numCells - 1, int( std::floor( (coords[3*i + a] + 5.)/cellSize ) ) ) );
+
+    std::vector<double>& bin = expected[asiAlgo_TiledCloudWriter::MortonCode(idx[0], idx[1], idx[2], Depth)];
+    bin.insert( bin.end(), &coords[3*i], &coords[3*i + 3] );
+  }
+
+  bool isOk = ( cloud->GetNumPoints() == NumPoints ) &&
+              ( cloud->GetNumTiles()  == int( expected.size() ) );
+  //
+  for ( int t = 0; isOk && t < cloud->GetNumTiles(); ++t )
+  {
+    const asiAlgo_TiledCloud::t_tile& tile = cloud->GetTile(t);
+    const std::vector<double>&        bin  = expected[tile.Code];
+
+    std::vector<double> tileCoords;
+    cloud->GetTilePoints(t, tileCoords);
+    //
+    if ( tileCoords.size() != bin.size() )
+    {
+      isOk = false;
+      break;
+    }
+
+    // The points keep the order of adding and lie in the box of the tile.
+    for ( size_t k = 0; k < bin.size(); ++k )
+    {
+      const int a = int(k % 3);
+      //
+      if ( std::fabs(tileCoords[k] - bin[k]) > Prec ||
+           tileCoords[k] < tile.Bounds[2*a] || tileCoords[k] > tile.Bounds[2*a + 1] )
+      {
+        isOk = false;
+        break;
+      }
+    }
+  }
+
+  CloseAndRemove(cloud);
+  //
+  if ( !isOk )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Tiled cloud differs from the input points.");
+    return res.failure();
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_TiledCloud::testBoxQuery(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Count the points in a box by iterating the tiles and by brute force. */
+
+  const std::vector<double>  coords = GenerateCoords();
+  Handle(asiAlgo_TiledCloud) cloud  = WriteAndOpen(coords, cf->Progress);
+  //
+  if ( cloud.IsNull() )
+    return res.failure();
+
+  // The stored points deviate from the input within the precision, so
+  // the points near the faces of the box are ambiguous. The number of found
+  // points is therefore checked against the shrunk and the enlarged boxes.
+  const double box[6]   = { -1.3, 2.1, -4.2, 0.7, 0.1, 3.9 };
+  const double inner[6] = { box[0] + Prec, box[1] - Prec,
+                            box[2] + Prec, box[3] - Prec,
+                            box[4] + Prec, box[5] - Prec };
+  const double outer[6] = { box[0] - Prec, box[1] + Prec,
+                            box[2] - Prec, box[3] + Prec,
+                            box[4] - Prec, box[5] + Prec };
+
+  int numInner = 0, numOuter = 0;
+  //
+  for ( int i = 0; i < NumPoints; ++i )
+  {
+    if ( IsIn(&coords[3*i], inner) )
+      ++numInner;
+    //
+    if ( IsIn(&coords[3*i], outer) )
+      ++numOuter;
+  }
+
+  int numFound = 0, numVisited = 0;
+  //
+  for ( asiAlgo_TiledCloud::Iterator it(cloud, box[0], box[1], box[2], box[3], box[4], box[5]);
+        it.More(); it.Next() )
+  {
+    const std::vector<double>& tileCoords = it.Value()->GetCoords();
+    //
+    for ( size_t k = 0; k < tileCoords.size(); k += 3 )
+      if ( IsIn(&tileCoords[k], box) )
+        ++numFound;
+
+    numVisited += int( it.Tile().NumPoints );
+  }
+
+  CloseAndRemove(cloud);
+  //
+  if ( numFound < numInner || numFound > numOuter )
+  {
+    cf->Progress.SendLogMessage( LogErr(Normal) << "Unexpected box query result: %1 point(s) found "
+                                                   "while %2 to %3 expected."
+                                                << numFound << numInner << numOuter );
+    return res.failure();
+  }
+  //
+  if ( numVisited >= NumPoints )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "No tiles are culled by the box query.");
+    return res.failure();
+  }
+
+  return res.success();
+}
+
+//-----------------------------------------------------------------------------
+
+outcome asiTest_TiledCloud::testExtract(const int funcID)
+{
+  // Get common facilities.
+  Handle(asiTest_CommonFacilities) cf = asiTest_CommonFacilities::Instance();
+
+  // Prepare outcome.
+  outcome res(DescriptionFn(), funcID);
+
+  /* Extract points by global indices and compare with the decoded tiles. */
+
+  const std::vector<double>  coords = GenerateCoords();
+  Handle(asiAlgo_TiledCloud) cloud  = WriteAndOpen(coords, cf->Progress);
+  //
+  if ( cloud.IsNull() )
+    return res.failure();
+
+  // Decode all points in the order of global indices.
+  std::vector<double> all;
+  //
+  for ( int t = 0; t < cloud->GetNumTiles(); ++t )
+  {
+    std::vector<double> tileCoords;
+    cloud->GetTilePoints(t, tileCoords);
+    //
+    all.insert( all.end(), tileCoords.begin(), tileCoords.end() );
+  }
+
+  // Extract every 7th point in reversed order plus out-of-range indices.
+  std::vector<int64_t> indices;
+  //
+  for ( int64_t i = NumPoints - 1; i >= 0; i -= 7 )
+    indices.push_back(i);
+  //
+  indices.push_back(-1);
+  indices.push_back(NumPoints);
+
+  Handle(asiAlgo_BaseCloud<double>) extracted = cloud->ExtractRegion(indices);
+  CloseAndRemove(cloud);
+
+  const std::vector<double>& extractedCoords = extracted->GetCoords();
+  //
+  bool isOk = ( extractedCoords.size() == 3*(indices.size() - 2) );
+  //
+  for ( size_t k = 0; isOk && k < indices.size() - 2; ++k )
+  {
+    // The points are returned in the order of their indices.
+    const int64_t idx = indices[indices.size() - 3 - k];
+    //
+    for ( int a = 0; a < 3; ++a )
+      if ( extractedCoords[3*k + a] != all[3*idx + a] )
+        isOk = false;
+  }
+  //
+  if ( !isOk )
+  {
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Extracted points differ from the decoded tiles.");
+    return res.failure();
+  }
+
+  return res.success();
+}
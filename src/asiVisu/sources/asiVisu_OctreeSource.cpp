@@ -34,6 +34,7 @@
 // asiAlgo includes
 #include <asiAlgo_BaseCloud.h>
 #include <asiAlgo_ProjectPointOnMesh.h>
+#include <asiAlgo_SVO.h>
 
 // asiVisu includes
 #include <asiVisu_MeshUtils.h>
@@ -49,12 +50,6 @@
 #include <vtkPoints.h>
 #include <vtkUnstructuredGrid.h>
 
-#if defined USE_MOBIUS
-  #include <mobius/cascade.h>
-  #include <mobius/poly_DistanceField.h>
-  #include <mobius/poly_SVO.h>
-#endif
-
 //-----------------------------------------------------------------------------
 
 namespace
@@ -287,160 +282,119 @@ int asiVisu_OctreeSource::RequestData(vtkInformation*        asiVisu_NotUsed(req
 
 //-----------------------------------------------------------------------------
 
-void asiVisu_OctreeSource::samplePoints(void*                       pNode,
+void asiVisu_OctreeSource::samplePoints(void*                       pOctree,
                                         asiAlgo_ProjectPointOnMesh* pProj,
                                         asiAlgo_BaseCloud<double>*  pPts,
                                         asiAlgo_BaseCloud<double>*  pNorms,
                                         std::vector<double>&        scalars)
 {
-  if ( pNode == nullptr || pProj == nullptr )
+  if ( pOctree == nullptr || pProj == nullptr )
     return;
 
-#if defined USE_MOBIUS
-  mobius::poly_SVO* pMobNode = static_cast<mobius::poly_SVO*>(pNode);
+  const asiAlgo_SVO* pSVO = static_cast<const asiAlgo_SVO*>(pOctree);
+
+  // Only leaves are sampled.
+  std::vector<asiAlgo_SVO::t_cell> leaves;
+  pSVO->GetLeaves( leaves, this->getMembership() );
 
-  if ( pMobNode->IsLeaf() ) /* Only leaves are sampled */
+  for ( size_t l = 0; l < leaves.size(); ++l )
   {
-    const bool isOn  = mobius::poly_DistanceField::IsZeroCrossing(pMobNode);
-    const bool isIn  = mobius::poly_DistanceField::IsIn(pMobNode);
-    const bool isOut = mobius::poly_DistanceField::IsOut(pMobNode);
+    const asiAlgo_SVO::t_cell& leaf = leaves[l];
+    const bool                 isOn = ( pSVO->Classify(leaf.Node) == Membership_On );
+
+    // Get center point.
+    gp_XYZ point = 0.5*(leaf.Min + leaf.Max);
+    gp_XYZ norm;
 
-    if ( isOn  && (m_strategy & SS_On) ||
-         isIn  && (m_strategy & SS_In) ||
-         isOut && (m_strategy & SS_Out) )
+    if ( isOn )
     {
-      // Get center point.
-      gp_XYZ
-        point = 0.125 * ( mobius::cascade::GetOpenCascadeXYZ( pMobNode->GetP0() )
-                        + mobius::cascade::GetOpenCascadeXYZ( pMobNode->GetP1() )
-                        + mobius::cascade::GetOpenCascadeXYZ( pMobNode->GetP2() )
-                        + mobius::cascade::GetOpenCascadeXYZ( pMobNode->GetP3() )
-                        + mobius::cascade::GetOpenCascadeXYZ( pMobNode->GetP4() )
-                        + mobius::cascade::GetOpenCascadeXYZ( pMobNode->GetP5() )
-                        + mobius::cascade::GetOpenCascadeXYZ( pMobNode->GetP6() )
-                        + mobius::cascade::GetOpenCascadeXYZ( pMobNode->GetP7() ) );
-      //
-      gp_XYZ norm;
+      // Project.
+      point = pProj->Perform(point).XYZ();
 
-      if ( isOn )
+      // Get the norm vector to store with the point.
+      const int facetInd = pProj->GetFacetIds().size() ? pProj->GetFacetIds()[0] : -1;
+      //
+      if ( facetInd != -1 )
       {
-        // Project.
-        point = pProj->Perform(point).XYZ();
+        const asiAlgo_BVHFacets::t_facet& facet = pProj->GetBVH()->GetFacet(facetInd);
 
-        // Get the norm vector to store with the point.
-        const int facetInd = pProj->GetFacetIds().size() ? pProj->GetFacetIds()[0] : -1;
-        //
-        if ( facetInd != -1 )
-        {
-          const asiAlgo_BVHFacets::t_facet& facet = pProj->GetBVH()->GetFacet(facetInd);
-
-          // Set norm vector to be stored with the point cloud.
-          norm = facet.N.XYZ();
-        }
+        // Set norm vector to be stored with the point cloud.
+        norm = facet.N.XYZ();
       }
+    }
 
-      // Evaluate SVO node.
-      const double sc = ( isOn ? 0. : pMobNode->Eval( mobius::cascade::GetMobiusPnt(point) ) );
-      //
-      m_fMinScalar = Min(m_fMinScalar, sc);
-      m_fMaxScalar = Max(m_fMaxScalar, sc);
+    // Evaluate SVO.
+    const double sc = ( isOn ? 0. : pSVO->Eval(point) );
+    //
+    m_fMinScalar = Min(m_fMinScalar, sc);
+    m_fMaxScalar = Max(m_fMaxScalar, sc);
 
-      // Populate outputs.
-      pPts->AddElement(point); // Add point.
-      pNorms->AddElement(norm); // Add normal vector.
-      scalars.push_back(sc); // Add scalar.
-    }
+    // Populate outputs.
+    pPts->AddElement(point); // Add point.
+    pNorms->AddElement(norm); // Add normal vector.
+    scalars.push_back(sc); // Add scalar.
   }
-  else
-  {
-    for ( size_t k = 0; k < 8; ++k )
-    {
-      this->samplePoints(pMobNode->GetChild(k), pProj, pPts, pNorms, scalars);
-    }
-  }
-#else
-  vtkErrorMacro( << "Mobius SVO data structure is not available." );
-#endif
 }
 
 //-----------------------------------------------------------------------------
 
-void asiVisu_OctreeSource::addVoxels(void*                pNode,
+void asiVisu_OctreeSource::addVoxels(void*                pOctree,
                                      vtkUnstructuredGrid* pData)
 {
-  if ( !pNode )
+  if ( !pOctree )
     return;
 
-#if defined USE_MOBIUS
-  mobius::poly_SVO* pMobNode = static_cast<mobius::poly_SVO*>(pNode);
+  const asiAlgo_SVO* pSVO = static_cast<const asiAlgo_SVO*>(pOctree);
+
+  std::vector<asiAlgo_SVO::t_cell> leaves;
+  pSVO->GetLeaves( leaves, this->getMembership() );
 
-  if ( pMobNode->IsLeaf() )
+  for ( size_t l = 0; l < leaves.size(); ++l )
   {
-    const bool isOn  = mobius::poly_DistanceField::IsZeroCrossing(pMobNode);
-    const bool isIn  = mobius::poly_DistanceField::IsIn(pMobNode);
-    const bool isOut = mobius::poly_DistanceField::IsOut(pMobNode);
+    const asiAlgo_SVO::t_cell& leaf = leaves[l];
 
-    if ( isOn  && (m_strategy & SS_On) ||
-         isIn  && (m_strategy & SS_In) ||
-         isOut && (m_strategy & SS_Out) )
+    double sc[8];
+    //
+    for ( int k = 0; k < 8; ++k )
     {
-      const double sc0 = pMobNode->GetScalar( mobius::poly_SVO::GetCornerID(0, 0, 0) );
-      const double sc1 = pMobNode->GetScalar( mobius::poly_SVO::GetCornerID(1, 0, 0) );
-      const double sc2 = pMobNode->GetScalar( mobius::poly_SVO::GetCornerID(0, 1, 0) );
-      const double sc3 = pMobNode->GetScalar( mobius::poly_SVO::GetCornerID(1, 1, 0) );
-      //
-      const double sc4 = pMobNode->GetScalar( mobius::poly_SVO::GetCornerID(0, 0, 1) );
-      const double sc5 = pMobNode->GetScalar( mobius::poly_SVO::GetCornerID(1, 0, 1) );
-      const double sc6 = pMobNode->GetScalar( mobius::poly_SVO::GetCornerID(0, 1, 1) );
-      const double sc7 = pMobNode->GetScalar( mobius::poly_SVO::GetCornerID(1, 1, 1) );
-
-      m_fMinScalar = Min(m_fMinScalar, sc0);
-      m_fMinScalar = Min(m_fMinScalar, sc1);
-      m_fMinScalar = Min(m_fMinScalar, sc2);
-      m_fMinScalar = Min(m_fMinScalar, sc3);
-      m_fMinScalar = Min(m_fMinScalar, sc4);
-      m_fMinScalar = Min(m_fMinScalar, sc5);
-      m_fMinScalar = Min(m_fMinScalar, sc6);
-      m_fMinScalar = Min(m_fMinScalar, sc7);
-
-      m_fMaxScalar = Max(m_fMaxScalar, sc0);
-      m_fMaxScalar = Max(m_fMaxScalar, sc1);
-      m_fMaxScalar = Max(m_fMaxScalar, sc2);
-      m_fMaxScalar = Max(m_fMaxScalar, sc3);
-      m_fMaxScalar = Max(m_fMaxScalar, sc4);
-      m_fMaxScalar = Max(m_fMaxScalar, sc5);
-      m_fMaxScalar = Max(m_fMaxScalar, sc6);
-      m_fMaxScalar = Max(m_fMaxScalar, sc7);
-
-      const double d1 = ( pMobNode->GetP1() - pMobNode->GetP0() ).Modulus();
-      const double d2 = ( pMobNode->GetP2() - pMobNode->GetP0() ).Modulus();
-      const double d3 = ( pMobNode->GetP4() - pMobNode->GetP0() ).Modulus();
+      sc[k] = pSVO->GetScalar(leaf.Node, k);
       //
-      const double voxelSize = Max( d1, Max(d2, d3) );
-      m_fMinVoxelSize = Min(m_fMinVoxelSize, voxelSize);
-
-      this->registerVoxel( mobius::cascade::GetOpenCascadePnt( pMobNode->GetP0() ),
-                           mobius::cascade::GetOpenCascadePnt( pMobNode->GetP1() ),
-                           mobius::cascade::GetOpenCascadePnt( pMobNode->GetP2() ),
-                           mobius::cascade::GetOpenCascadePnt( pMobNode->GetP3() ),
-                           mobius::cascade::GetOpenCascadePnt( pMobNode->GetP4() ),
-                           mobius::cascade::GetOpenCascadePnt( pMobNode->GetP5() ),
-                           mobius::cascade::GetOpenCascadePnt( pMobNode->GetP6() ),
-                           mobius::cascade::GetOpenCascadePnt( pMobNode->GetP7() ),
-                           sc0, sc1, sc2, sc3, sc4, sc5, sc6, sc7,
-                           pData );
-    }
-  }
-  else
-  {
-    for ( size_t k = 0; k < 8; ++k )
-    {
-      this->addVoxels( pMobNode->GetChild(k), pData );
+      m_fMinScalar = Min(m_fMinScalar, sc[k]);
+      m_fMaxScalar = Max(m_fMaxScalar, sc[k]);
     }
+
+    const gp_XYZ d = leaf.Max - leaf.Min;
+    //
+    const double voxelSize = Max( d.X(), Max( d.Y(), d.Z() ) );
+    m_fMinVoxelSize = Min(m_fMinVoxelSize, voxelSize);
+
+    gp_Pnt P[8];
+    //
+    for ( int k = 0; k < 8; ++k )
+      P[k] = gp_Pnt( (k & 1) ? leaf.Max.X() : leaf.Min.X(),
+                     (k & 2) ? leaf.Max.Y() : leaf.Min.Y(),
+                     (k & 4) ? leaf.Max.Z() : leaf.Min.Z() );
+
+    this->registerVoxel( P[0], P[1], P[2], P[3], P[4], P[5], P[6], P[7],
+                         sc[0], sc[1], sc[2], sc[3], sc[4], sc[5], sc[6], sc[7],
+                         pData );
   }
-#else
-  vtkErrorMacro( << "Mobius SVO data structure is not available." );
-#endif
+}
+
+//-----------------------------------------------------------------------------
+
+int asiVisu_OctreeSource::getMembership() const
+{
+  int membership = 0;
+  //
+  if ( m_strategy & SS_On )
+    membership |= Membership_On;
+  if ( m_strategy & SS_In )
+    membership |= Membership_In;
+  if ( m_strategy & SS_Out )
+    membership |= Membership_Out;
+
+  return membership;
 }
 
 //-----------------------------------------------------------------------------
@@ -455,29 +409,30 @@ void asiVisu_OctreeSource::addUniformVoxels(vtkUnstructuredGrid* pData)
 
   const double step = (double) m_grid->CellSize;
 
-  for ( int i = 0; i <= m_grid->Nx; ++i )
+  // Iterate with X index running fastest to follow the grid layout.
+  for ( int k = 0; k <= m_grid->Nz; ++k )
   {
-    const double x = m_grid->XMin + step*i;
+    const double z = m_grid->ZMin + step*k;
     //
     for ( int j = 0; j <= m_grid->Ny; ++j )
     {
       const double y = m_grid->YMin + step*j;
       //
-      for ( int k = 0; k <= m_grid->Nz; ++k )
+      for ( int i = 0; i <= m_grid->Nx; ++i )
       {
-        const double z = m_grid->ZMin + step*k;
+        const double x = m_grid->XMin + step*i;
 
         if ( (i < m_grid->Nx) && (j < m_grid->Ny) && (k < m_grid->Nz) )
         {
           const double
-            sc[8] = { m_grid->pArray[i]    [j]    [k],
-                      m_grid->pArray[i + 1][j]    [k],
-                      m_grid->pArray[i]    [j + 1][k],
-                      m_grid->pArray[i + 1][j + 1][k],
-                      m_grid->pArray[i]    [j]    [k + 1],
-                      m_grid->pArray[i + 1][j]    [k + 1],
-                      m_grid->pArray[i]    [j + 1][k + 1],
-                      m_grid->pArray[i + 1][j + 1][k + 1] };
+            sc[8] = { m_grid->GetValue(i, j, k),
+                      m_grid->GetValue(i + 1, j, k),
+                      m_grid->GetValue(i, j + 1, k),
+                      m_grid->GetValue(i + 1, j + 1, k),
+                      m_grid->GetValue(i, j, k + 1),
+                      m_grid->GetValue(i + 1, j, k + 1),
+                      m_grid->GetValue(i, j + 1, k + 1),
+                      m_grid->GetValue(i + 1, j + 1, k + 1) };
 
           const bool isOn  = ::IsZeroCrossing (sc);
           const bool isIn  = ::IsIn           (sc);
@@ -195,28 +195,32 @@ protected:
 
 private:
 
-  //! Recursively iterates ADF and gathers the center points of the inner voxels.
+  //! Iterates the leaves of ADF and gathers their center points.
   //! Depending on the sampling strategy, points can be sampled inside,
   //! outside or on the shape. The points of the zero-crossing voxels are
   //! projected to the boundary.
-  //! \param[in]     pNode   SVO node to start recursive iteration from.
+  //! \param[in]     pOctree octree to sample.
   //! \param[in]     pProj   projection utility.
   //! \param[in,out] pPts    sampled points.
   //! \param[in,out] pNorms  normal vectors in the sampled points.
   //! \param[in,out] scalars scalar values evaluated in points.
-  void samplePoints(void*                       pNode,
+  void samplePoints(void*                       pOctree,
                     asiAlgo_ProjectPointOnMesh* pProj,
                     asiAlgo_BaseCloud<double>*  pPts,
                     asiAlgo_BaseCloud<double>*  pNorms,
                     std::vector<double>&        scalars);
 
-  //! Recursively adds SVO node (a voxel) to the unstructured grid being
+  //! Adds the leaves of SVO (voxels) to the unstructured grid being
   //! constructed.
-  //! \param[in]     pNode parent node.
-  //! \param[in,out] pData unstructured data set being populated.
-  void addVoxels(void*                pNode,
+  //! \param[in]     pOctree octree to add the leaves of.
+  //! \param[in,out] pData   unstructured data set being populated.
+  void addVoxels(void*                pOctree,
                  vtkUnstructuredGrid* pData);
 
+  //! \return membership flags of the octree leaves corresponding to the
+  //!         sampling strategy.
+  int getMembership() const;
+
   //! Populates the unstructured grid with uniform voxelization.
   //! \param[in,out] pData unstructured data set being populated.
   void addUniformVoxels(vtkUnstructuredGrid* pData);
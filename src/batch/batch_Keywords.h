@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef batch_Keywords_h
+#define batch_Keywords_h
+
+//-----------------------------------------------------------------------------
+
+#define ASIBATCH_KW_dir       "dir"
+#define ASIBATCH_KW_recipe    "recipe"
+#define ASIBATCH_KW_ext       "ext"
+#define ASIBATCH_KW_recursive "recursive"
+#define ASIBATCH_KW_threads   "threads"
+#define ASIBATCH_KW_out       "out"
+#define ASIBATCH_KW_logs      "logs"
+#define ASIBATCH_KW_report    "report"
+#define ASIBATCH_KW_worker    "worker"
+#define ASIBATCH_KW_file      "file"
+
+//-----------------------------------------------------------------------------
+
+// Standard includes
+#include <string>
+
+//-----------------------------------------------------------------------------
+
+//! Command line utilities of the batch runner. The arguments are passed
+//! in the same "/key=value" form as for the main executable. Unlike there,
+//! the key has to start the argument, so the file paths passed as values
+//! cannot be confused with keywords.
+class asiBatch
+{
+public:
+
+  //! Checks whether the passed argument is the given keyword.
+  //! \param[in] opt argument to check.
+  //! \param[in] key keyword.
+  //! \return true if the argument is "/key" or "/key=...".
+  static bool IsKeyword(const std::string& opt,
+                        const std::string& key)
+  {
+    const std::string slashedKey = "/" + key;
+    //
+    if ( opt.compare(0, slashedKey.length(), slashedKey) != 0 )
+      return false;
+
+    return opt.length() == slashedKey.length() || opt[slashedKey.length()] == '=';
+  }
+
+  //! Checks whether the keyword is passed.
+  //! \param[in] argc number of arguments.
+  //! \param[in] argv arguments.
+  //! \param[in] key  keyword to check.
+  //! \return true/false.
+  static bool HasKeyword(const int          argc,
+                         char**             argv,
+                         const std::string& key)
+  {
+    for ( int k = 1; k < argc; ++k )
+    {
+      if ( IsKeyword(argv[k], key) )
+        return true;
+    }
+    return false;
+  }
+
+  //! Extracts the value of the "/key=value" argument.
+  //! \param[in]  argc  number of arguments.
+  //! \param[in]  argv  arguments.
+  //! \param[in]  key   keyword.
+  //! \param[out] value extracted value.
+  //! \return false if the keyword is not passed or has no value.
+  static bool GetKeyValue(const int          argc,
+                          char**             argv,
+                          const std::string& key,
+                          std::string&       value)
+  {
+    for ( int k = 1; k < argc; ++k )
+    {
+      const std::string arg(argv[k]);
+      //
+      if ( IsKeyword(arg, key) )
+      {
+        if ( arg.length() <= key.length() + 2 )
+          return false;
+
+        value = arg.substr(key.length() + 2);
+        return true;
+      }
+    }
+    return false;
+  }
+
+};
+
+#endif
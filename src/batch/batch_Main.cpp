@@ -0,0 +1,214 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// batch includes
+#include <batch_Keywords.h>
+#include <batch_Runner.h>
+#include <batch_Worker.h>
+
+// asiAlgo includes
+#include <asiAlgo_Dictionary.h>
+#include <asiAlgo_Utils.h>
+
+// OCCT includes
+#include <OSD_Directory.hxx>
+#include <OSD_Environment.hxx>
+#include <OSD_File.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Protection.hxx>
+
+// Standard includes
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _WIN32
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <limits.h>
+  #include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+//! \return full path to this executable.
+static std::string GetExecutablePath(const char* argv0)
+{
+#ifdef _WIN32
+  char buff[MAX_PATH];
+  const DWORD len = GetModuleFileNameA(NULL, buff, MAX_PATH);
+  //
+  if ( len > 0 && len < MAX_PATH )
+    return std::string(buff, len);
+#else
+  char buff[PATH_MAX];
+  const ssize_t len = readlink("/proc/self/exe", buff, PATH_MAX - 1);
+  //
+  if ( len > 0 )
+    return std::string(buff, len);
+#endif
+
+  return argv0;
+}
+
+//-----------------------------------------------------------------------------
+
+//! Sets the environment and loads the data dictionary from the resources
+//! directory located next to the executable (the same way as the main
+//! executable does).
+static void InitResources(const std::string& exePath)
+{
+  const size_t      slashPos = exePath.find_last_of("/\\");
+  const std::string resDir   = ( slashPos == std::string::npos ? std::string(".")
+                                                               : exePath.substr(0, slashPos) ) + "/resources";
+  //
+  if ( !OSD_Directory( OSD_Path( resDir.c_str() ) ).Exists() )
+    return;
+
+  if ( OSD_Environment("CSF_PluginDefaults").Value().IsEmpty() )
+    OSD_Environment( "CSF_PluginDefaults", resDir.c_str() ).Build();
+  //
+  if ( OSD_Environment("CSF_ResourcesDefaults").Value().IsEmpty() )
+    OSD_Environment( "CSF_ResourcesDefaults", resDir.c_str() ).Build();
+
+  const std::string dictFilename = resDir + "/asiExeDictionary.xml";
+  //
+  if ( OSD_File( OSD_Path( dictFilename.c_str() ) ).Exists() )
+    asiAlgo_Dictionary::Load( dictFilename.c_str() );
+}
+
+//-----------------------------------------------------------------------------
+
+static void PrintUsage()
+{
+  std::cout << "Usage:\n"
+            << "  asiBatch /" ASIBATCH_KW_dir "=<directory> /" ASIBATCH_KW_recipe "=<script.tcl>"
+            << " [/" ASIBATCH_KW_ext "=<ext1,ext2,...>] [/" ASIBATCH_KW_recursive "]"
+            << " [/" ASIBATCH_KW_threads "=<num>] [/" ASIBATCH_KW_out "=<directory>]"
+            << " [/" ASIBATCH_KW_logs "=<directory>] [/" ASIBATCH_KW_report "=<report.csv|report.json>]\n\n"
+            << "  Executes the Tcl recipe for each file of the directory in a separate\n"
+            << "  process. The recipe can use the variables $filename, $basename and\n"
+            << "  $outdir. By default, the number of concurrent workers is equal to the\n"
+            << "  number of hardware threads, the logs are written to 'batch_logs' and\n"
+            << "  the report to 'batch_report.csv' in the current directory." << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+// Entry point
+//-----------------------------------------------------------------------------
+
+//! main().
+int main(int argc, char** argv)
+{
+  const std::string exePath = GetExecutablePath(argv[0]);
+
+  //---------------------------------------------------------------------------
+  // Worker mode: process one file
+  //---------------------------------------------------------------------------
+
+  if ( asiBatch::HasKeyword(argc, argv, ASIBATCH_KW_worker) )
+  {
+    std::string filename, recipe, outDir;
+    //
+    if ( !asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_file,   filename) ||
+         !asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_recipe, recipe) )
+    {
+      std::cout << "Worker expects the file and the recipe." << std::endl;
+      return 1;
+    }
+    //
+    asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_out, outDir);
+
+    InitResources(exePath);
+
+    return batch_Worker(filename, recipe, outDir).Run();
+  }
+
+  //---------------------------------------------------------------------------
+  // Runner mode: distribute files over the workers
+  //---------------------------------------------------------------------------
+
+  std::string dir, recipe;
+  //
+  if ( !asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_dir,    dir) ||
+       !asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_recipe, recipe) )
+  {
+    PrintUsage();
+    return 1;
+  }
+  //
+  if ( !OSD_File( OSD_Path( recipe.c_str() ) ).Exists() )
+  {
+    std::cout << "Recipe file " << recipe << " does not exist." << std::endl;
+    return 1;
+  }
+
+  // Accepted extensions.
+  std::vector<std::string> exts;
+  std::string              extStr;
+  //
+  if ( asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_ext, extStr) )
+    asiAlgo_Utils::Str::Split(extStr, ",;", exts);
+
+  // Other options.
+  std::string threadsStr, outDir, logDir("batch_logs"), report("batch_report.csv");
+  //
+  asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_out,    outDir);
+  asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_logs,   logDir);
+  asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_report, report);
+  //
+  const int numThreads = asiBatch::GetKeyValue(argc, argv, ASIBATCH_KW_threads, threadsStr)
+                       ? atoi( threadsStr.c_str() ) : 0;
+
+  // Prepare directory for logs.
+  OSD_Directory logDirectory( OSD_Path( logDir.c_str() ) );
+  //
+  if ( !logDirectory.Exists() )
+    logDirectory.Build( OSD_Protection() );
+
+  batch_Runner runner(exePath, recipe);
+  runner.SetNumWorkers(numThreads);
+  runner.SetOutputDir(outDir);
+  runner.SetLogDir(logDir);
+  //
+  if ( !runner.Collect( dir, exts, asiBatch::HasKeyword(argc, argv, ASIBATCH_KW_recursive) ) )
+  {
+    std::cout << "No files to process in " << dir << "." << std::endl;
+    return 0;
+  }
+
+  const bool isOk = runner.Run();
+  //
+  if ( !runner.WriteReport(report) )
+    return 1;
+
+  std::cout << "Report written to " << report << "." << std::endl;
+  return isOk ? 0 : 1;
+}
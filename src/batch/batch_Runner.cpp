@@ -0,0 +1,488 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <batch_Runner.h>
+
+// batch includes
+#include <batch_Keywords.h>
+
+// OCCT includes
+#include <OSD_Directory.hxx>
+#include <OSD_DirectoryIterator.hxx>
+#include <OSD_File.hxx>
+#include <OSD_FileIterator.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Timer.hxx>
+
+// Standard includes
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <locale>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+  #define NOMINMAX
+  #include <windows.h>
+  #include <psapi.h>
+#else
+  #include <fcntl.h>
+  #include <spawn.h>
+  #include <sys/resource.h>
+  #include <sys/wait.h>
+
+  extern char** environ;
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Converts the passed string to lower case.
+  std::string ToLower(const std::string& str)
+  {
+    std::string res(str);
+    for ( size_t k = 0; k < res.length(); ++k )
+      res[k] = char( ::tolower( (unsigned char) res[k] ) );
+
+    return res;
+  }
+
+  //! Escapes the passed string for JSON.
+  std::string EscapeJSON(const std::string& str)
+  {
+    std::ostringstream out;
+    for ( size_t k = 0; k < str.length(); ++k )
+    {
+      const char c = str[k];
+      //
+      if ( c == '"' || c == '\\' )
+        out << '\\' << c;
+      else if ( (unsigned char) c < 0x20 )
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+      else
+        out << c;
+    }
+    return out.str();
+  }
+
+  //! Escapes the passed string for CSV.
+  std::string EscapeCSV(const std::string& str)
+  {
+    std::string res("\"");
+    for ( size_t k = 0; k < str.length(); ++k )
+    {
+      if ( str[k] == '"' )
+        res += '"';
+      res += str[k];
+    }
+    res += '"';
+    return res;
+  }
+
+  //! Orders jobs by filenames.
+  struct CompareByName
+  {
+    bool operator()(const batch_Runner::t_job& a,
+                    const batch_Runner::t_job& b) const
+    {
+      return a.Filename < b.Filename;
+    }
+  };
+
+  //! Orders job indices by decreasing file sizes.
+  struct CompareBySize
+  {
+    CompareBySize(const std::vector<batch_Runner::t_job>& jobs) : Jobs(jobs) {}
+
+    bool operator()(const int a, const int b) const
+    {
+      return Jobs[a].FileSize > Jobs[b].FileSize;
+    }
+
+    const std::vector<batch_Runner::t_job>& Jobs;
+  };
+}
+
+//-----------------------------------------------------------------------------
+
+batch_Runner::batch_Runner(const std::string& exe,
+                           const std::string& recipe)
+: m_exe         (exe),
+  m_recipe      (recipe),
+  m_iNumWorkers (0),
+  m_fWallTime   (0.),
+  m_iNext       (0),
+  m_iNumDone    (0)
+{}
+
+//-----------------------------------------------------------------------------
+
+int batch_Runner::Collect(const std::string&              dir,
+                          const std::vector<std::string>& extensions,
+                          const bool                      recursive)
+{
+  std::vector<std::string> exts;
+  for ( size_t k = 0; k < extensions.size(); ++k )
+  {
+    std::string ext = ToLower(extensions[k]);
+    //
+    if ( !ext.empty() && ext[0] == '.' )
+      ext.erase(0, 1);
+    //
+    exts.push_back(ext);
+  }
+
+  this->scan(dir, exts, recursive);
+
+  // Keep the report stable regardless of the directory listing order.
+  std::sort( m_jobs.begin(), m_jobs.end(), CompareByName() );
+
+  return int( m_jobs.size() );
+}
+
+//-----------------------------------------------------------------------------
+
+bool batch_Runner::Run()
+{
+  if ( m_jobs.empty() )
+    return true;
+
+  // Prepare log files.
+  for ( size_t k = 0; k < m_jobs.size(); ++k )
+  {
+    if ( m_logDir.empty() )
+      continue;
+
+    OSD_Path path( m_jobs[k].Filename.c_str() );
+
+    std::ostringstream logName;
+    logName << m_logDir << "/" << std::setw(5) << std::setfill('0') << k << "_"
+            << path.Name().ToCString() << ".log";
+    //
+    m_jobs[k].LogFile = logName.str();
+  }
+
+  // Process the largest files first, so the long jobs do not end up
+  // running alone at the tail of the batch.
+  m_queue.resize( m_jobs.size() );
+  for ( size_t k = 0; k < m_jobs.size(); ++k )
+    m_queue[k] = int(k);
+  //
+  std::stable_sort( m_queue.begin(), m_queue.end(), CompareBySize(m_jobs) );
+
+  int numWorkers = m_iNumWorkers;
+  if ( numWorkers <= 0 )
+    numWorkers = std::max( 1, int( std::thread::hardware_concurrency() ) );
+  //
+  numWorkers = std::min( numWorkers, int( m_jobs.size() ) );
+
+  std::cout << "Processing " << m_jobs.size() << " file(s) with "
+            << numWorkers << " worker(s)..." << std::endl;
+
+  OSD_Timer timer;
+  timer.Start();
+
+  m_iNext    = 0;
+  m_iNumDone = 0;
+
+  // Each thread supervises one worker process at a time.
+  std::vector<std::thread> pool;
+  for ( int t = 0; t < numWorkers; ++t )
+    pool.push_back( std::thread(&batch_Runner::workerLoop, this) );
+  //
+  for ( size_t t = 0; t < pool.size(); ++t )
+    pool[t].join();
+
+  timer.Stop();
+  m_fWallTime = timer.ElapsedTime();
+
+  int numFailed = 0;
+  for ( size_t k = 0; k < m_jobs.size(); ++k )
+    if ( m_jobs[k].ExitCode != 0 )
+      ++numFailed;
+
+  std::cout << "Done in " << m_fWallTime << " s: "
+            << (m_jobs.size() - numFailed) << " succeeded, "
+            << numFailed << " failed." << std::endl;
+
+  return numFailed == 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool batch_Runner::WriteReport(const std::string& filename) const
+{
+  std::ofstream FILE( filename.c_str() );
+  //
+  if ( !FILE.is_open() )
+  {
+    std::cout << "Cannot open report file " << filename << " for writing." << std::endl;
+    return false;
+  }
+
+  FILE.imbue( std::locale::classic() );
+  FILE << std::fixed << std::setprecision(3);
+
+  const bool isJSON = ( ToLower( filename.substr( filename.find_last_of('.') + 1 ) ) == "json" );
+  //
+  if ( isJSON )
+  {
+    int numFailed = 0;
+    for ( size_t k = 0; k < m_jobs.size(); ++k )
+      if ( m_jobs[k].ExitCode != 0 )
+        ++numFailed;
+
+    FILE << "{\n"
+         << "  \"recipe\": \"" << EscapeJSON(m_recipe) << "\",\n"
+         << "  \"numFiles\": " << m_jobs.size() << ",\n"
+         << "  \"numFailed\": " << numFailed << ",\n"
+         << "  \"wallTime\": " << m_fWallTime << ",\n"
+         << "  \"files\": [";
+    //
+    for ( size_t k = 0; k < m_jobs.size(); ++k )
+    {
+      const t_job& job = m_jobs[k];
+
+      FILE << (k ? ",\n" : "\n")
+           << "    {\"file\": \"" << EscapeJSON(job.Filename) << "\""
+           << ", \"status\": \"" << (job.ExitCode == 0 ? "ok" : "failed") << "\""
+           << ", \"exitCode\": " << job.ExitCode
+           << ", \"sizeMiB\": " << job.FileSize
+           << ", \"time\": " << job.Time
+           << ", \"peakMemMiB\": " << job.PeakMem
+           << ", \"log\": \"" << EscapeJSON(job.LogFile) << "\"}";
+    }
+    FILE << "\n  ]\n}\n";
+  }
+  else
+  {
+    FILE << "file,status,exit_code,size_mib,time_s,peak_mem_mib,log\n";
+    //
+    for ( size_t k = 0; k < m_jobs.size(); ++k )
+    {
+      const t_job& job = m_jobs[k];
+
+      FILE << EscapeCSV(job.Filename) << ","
+           << (job.ExitCode == 0 ? "ok" : "failed") << ","
+           << job.ExitCode << ","
+           << job.FileSize << ","
+           << job.Time << ","
+           << job.PeakMem << ","
+           << EscapeCSV(job.LogFile) << "\n";
+    }
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void batch_Runner::workerLoop()
+{
+  for ( ;; )
+  {
+    const int pos = m_iNext++;
+    //
+    if ( pos >= int( m_queue.size() ) )
+      break;
+
+    t_job& job = m_jobs[ m_queue[pos] ];
+    this->execute(job);
+
+    const int numDone = ++m_iNumDone;
+
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    //
+    std::cout << "[" << numDone << "/" << m_jobs.size() << "] "
+              << (job.ExitCode == 0 ? "OK     " : "FAILED ")
+              << std::fixed << std::setprecision(2)
+              << job.Time << " s, " << job.PeakMem << " MiB: "
+              << job.Filename << std::endl;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void batch_Runner::execute(t_job& job) const
+{
+  const std::string fileArg   = "/file="   + job.Filename;
+  const std::string recipeArg = "/recipe=" + m_recipe;
+  const std::string outArg    = "/out="    + m_outDir;
+
+  OSD_Timer timer;
+  timer.Start();
+
+#ifdef _WIN32
+  // Redirect the output of the worker to its log file.
+  SECURITY_ATTRIBUTES sa;
+  sa.nLength              = sizeof(sa);
+  sa.lpSecurityDescriptor = NULL;
+  sa.bInheritHandle       = TRUE;
+  //
+  HANDLE hLog = CreateFileA( job.LogFile.empty() ? "NUL" : job.LogFile.c_str(),
+                             GENERIC_WRITE, FILE_SHARE_READ, &sa,
+                             CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL );
+
+  STARTUPINFOA si;
+  ZeroMemory( &si, sizeof(si) );
+  si.cb         = sizeof(si);
+  si.dwFlags    = STARTF_USESTDHANDLES;
+  si.hStdInput  = NULL;
+  si.hStdOutput = hLog;
+  si.hStdError  = hLog;
+
+  PROCESS_INFORMATION pi;
+  ZeroMemory( &pi, sizeof(pi) );
+
+  std::string cmdLine = "\"" + m_exe + "\" /" ASIBATCH_KW_worker
+                        " \"" + fileArg + "\" \"" + recipeArg + "\"";
+  //
+  if ( !m_outDir.empty() )
+    cmdLine += " \"" + outArg + "\"";
+
+  if ( CreateProcessA(NULL, &cmdLine[0], NULL, NULL, TRUE, CREATE_NO_WINDOW, NULL, NULL, &si, &pi) )
+  {
+    WaitForSingleObject(pi.hProcess, INFINITE);
+
+    DWORD exitCode = 1;
+    GetExitCodeProcess(pi.hProcess, &exitCode);
+    job.ExitCode = int(exitCode);
+
+    PROCESS_MEMORY_COUNTERS pmc;
+    if ( GetProcessMemoryInfo( pi.hProcess, &pmc, sizeof(pmc) ) )
+      job.PeakMem = double(pmc.PeakWorkingSetSize)/(1024.*1024.);
+
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+  }
+
+  if ( hLog != INVALID_HANDLE_VALUE )
+    CloseHandle(hLog);
+#else
+  std::vector<char*> args;
+  args.push_back( const_cast<char*>( m_exe.c_str() ) );
+  args.push_back( const_cast<char*>( "/" ASIBATCH_KW_worker ) );
+  args.push_back( const_cast<char*>( fileArg.c_str() ) );
+  args.push_back( const_cast<char*>( recipeArg.c_str() ) );
+  //
+  if ( !m_outDir.empty() )
+    args.push_back( const_cast<char*>( outArg.c_str() ) );
+  //
+  args.push_back(nullptr);
+
+  // Redirect the output of the worker to its log file.
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen( &actions, STDOUT_FILENO,
+                                    job.LogFile.empty() ? "/dev/null" : job.LogFile.c_str(),
+                                    O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+  pid_t pid;
+  if ( posix_spawn(&pid, m_exe.c_str(), &actions, nullptr, &args[0], environ) == 0 )
+  {
+    int           status = 0;
+    struct rusage usage;
+    //
+    if ( wait4(pid, &status, 0, &usage) == pid )
+    {
+      if ( WIFEXITED(status) )
+        job.ExitCode = WEXITSTATUS(status);
+      else if ( WIFSIGNALED(status) )
+        job.ExitCode = 128 + WTERMSIG(status);
+
+#ifdef __APPLE__
+      job.PeakMem = double(usage.ru_maxrss)/(1024.*1024.); // Bytes.
+#else
+      job.PeakMem = double(usage.ru_maxrss)/1024.; // Kilobytes.
+#endif
+    }
+  }
+
+  posix_spawn_file_actions_destroy(&actions);
+#endif
+
+  timer.Stop();
+  job.Time = timer.ElapsedTime();
+}
+
+//-----------------------------------------------------------------------------
+
+void batch_Runner::scan(const std::string&              dir,
+                        const std::vector<std::string>& extensions,
+                        const bool                      recursive)
+{
+  OSD_Path dirPath( dir.c_str() );
+
+  for ( OSD_FileIterator fit(dirPath, "*"); fit.More(); fit.Next() )
+  {
+    OSD_File file = fit.Values();
+    OSD_Path path;
+    file.Path(path);
+
+    // Extension includes the leading dot.
+    TCollection_AsciiString ext = path.Extension();
+    //
+    if ( !extensions.empty() )
+    {
+      const std::string extStr = ToLower( ext.Length() > 1 ? ext.ToCString() + 1 : "" );
+      //
+      if ( std::find(extensions.begin(), extensions.end(), extStr) == extensions.end() )
+        continue;
+    }
+
+    t_job job;
+    job.Filename = dir + "/" + path.Name().ToCString() + ext.ToCString();
+    job.FileSize = double( OSD_File( OSD_Path( job.Filename.c_str() ) ).Size() )/(1024.*1024.);
+    //
+    m_jobs.push_back(job);
+  }
+
+  if ( !recursive )
+    return;
+
+  for ( OSD_DirectoryIterator dit(dirPath, "*"); dit.More(); dit.Next() )
+  {
+    OSD_Path path;
+    dit.Values().Path(path);
+
+    const TCollection_AsciiString name = path.Name() + path.Extension();
+    //
+    if ( name == "." || name == ".." )
+      continue;
+
+    this->scan(dir + "/" + name.ToCString(), extensions, recursive);
+  }
+}
@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef batch_Runner_h
+#define batch_Runner_h
+
+// Standard includes
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+//! Runs the recipe for all files of a directory on a pool of concurrent
+//! worker processes. Each file is processed by a separate instance of the
+//! batch executable launched in the worker mode (see batch_Worker), so
+//! the files are converted in isolated Data Models. The runner measures
+//! wall-clock time and peak memory of each worker and writes the run
+//! report in CSV or JSON format.
+class batch_Runner
+{
+public:
+
+  //! Processing status of a single file.
+  struct t_job
+  {
+    std::string Filename;  //!< Input file.
+    std::string LogFile;   //!< Log of the worker process.
+    double      FileSize;  //!< File size in MiB.
+    int         ExitCode;  //!< Exit code of the worker process.
+    double      Time;      //!< Elapsed time in seconds.
+    double      PeakMem;   //!< Peak memory (resident set) in MiB.
+
+    t_job() : FileSize(0.), ExitCode(-1), Time(0.), PeakMem(0.) {}
+  };
+
+public:
+
+  //! Ctor.
+  //! \param[in] exe    path to the batch executable to launch workers.
+  //! \param[in] recipe Tcl script to execute for each file.
+  batch_Runner(const std::string& exe,
+               const std::string& recipe);
+
+public:
+
+  //! Sets the number of concurrent workers. If zero is passed (default),
+  //! the number of hardware threads is used.
+  //! \param[in] num number of workers.
+  void SetNumWorkers(const int num)
+  {
+    m_iNumWorkers = num;
+  }
+
+  //! Sets output directory passed to the recipe as `outdir` variable.
+  //! If not set, the directory of each input file is used.
+  //! \param[in] dir output directory.
+  void SetOutputDir(const std::string& dir)
+  {
+    m_outDir = dir;
+  }
+
+  //! Sets directory for the worker logs.
+  //! \param[in] dir log directory.
+  void SetLogDir(const std::string& dir)
+  {
+    m_logDir = dir;
+  }
+
+  //! Collects files to process.
+  //! \param[in] dir        directory to scan.
+  //! \param[in] extensions file extensions to accept (without dots, case
+  //!                       insensitive). All files are accepted if empty.
+  //! \param[in] recursive  whether to scan subdirectories.
+  //! \return number of collected files.
+  int Collect(const std::string&              dir,
+              const std::vector<std::string>& extensions,
+              const bool                      recursive);
+
+  //! Processes the collected files.
+  //! \return true if all files were processed successfully.
+  bool Run();
+
+  //! Writes run report. The format is selected by the file extension:
+  //! JSON for ".json" and CSV otherwise.
+  //! \param[in] filename target file.
+  //! \return true in case of success, false -- otherwise.
+  bool WriteReport(const std::string& filename) const;
+
+  //! \return processing status of files.
+  const std::vector<t_job>& GetJobs() const
+  {
+    return m_jobs;
+  }
+
+protected:
+
+  //! Launches worker process for the given job and waits for its
+  //! termination.
+  //! \param[in,out] job job to execute.
+  void execute(t_job& job) const;
+
+  //! Takes the jobs from the queue until it is empty. This function is
+  //! executed by each thread of the pool.
+  void workerLoop();
+
+  //! Scans directory for the files to process.
+  //! \param[in] dir        directory to scan.
+  //! \param[in] extensions accepted extensions in lower case.
+  //! \param[in] recursive  whether to scan subdirectories.
+  void scan(const std::string&              dir,
+            const std::vector<std::string>& extensions,
+            const bool                      recursive);
+
+protected:
+
+  std::string        m_exe;         //!< Batch executable.
+  std::string        m_recipe;      //!< Recipe script.
+  std::string        m_outDir;      //!< Output directory.
+  std::string        m_logDir;      //!< Log directory.
+  int                m_iNumWorkers; //!< Number of concurrent workers.
+  double             m_fWallTime;   //!< Total elapsed time.
+  std::vector<t_job> m_jobs;        //!< Files to process.
+
+  /* Pool state */
+
+  std::vector<int>   m_queue;       //!< Job indices in processing order.
+  std::atomic<int>   m_iNext;       //!< Next position in the queue.
+  std::atomic<int>   m_iNumDone;    //!< Number of finished jobs.
+  std::mutex         m_outMutex;    //!< Guards console output.
+
+};
+
+#endif
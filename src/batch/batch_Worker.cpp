@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+// Own include
+#include <batch_Worker.h>
+
+// asiUI includes
+#include <asiUI_BatchFacilities.h>
+
+// asiTcl includes
+#include <asiTcl_Plugin.h>
+
+// OCCT includes
+#include <OSD_Path.hxx>
+
+// Standard includes
+#include <algorithm>
+
+#define BATCH_LOAD_MODULE(name) \
+{ \
+  if ( !asiTcl_Plugin::Load(cf->Interp, cf, name) ) \
+    cf->Progress.SendLogMessage(LogErr(Normal) << "Cannot load %1 commands." << name); \
+}
+
+//-----------------------------------------------------------------------------
+
+batch_Worker::batch_Worker(const std::string& filename,
+                           const std::string& recipe,
+                           const std::string& outDir)
+: m_filename (filename),
+  m_recipe   (recipe),
+  m_outDir   (outDir)
+{}
+
+//-----------------------------------------------------------------------------
+
+int batch_Worker::Run()
+{
+  // Data Model, interpreter and notifier of this process.
+  Handle(asiUI_BatchFacilities) cf = asiUI_BatchFacilities::Instance();
+
+  // Load default commands.
+  BATCH_LOAD_MODULE("cmdMisc")
+  BATCH_LOAD_MODULE("cmdEngine")
+  BATCH_LOAD_MODULE("cmdRE")
+  BATCH_LOAD_MODULE("cmdDDF")
+
+  // Prepare variables for the recipe.
+  OSD_Path path( m_filename.c_str() );
+  //
+  TCollection_AsciiString basename = path.Name();
+  //
+  std::string outDir = m_outDir;
+  if ( outDir.empty() )
+  {
+    TCollection_AsciiString dirname;
+    path.SetName("");
+    path.SetExtension("");
+    path.SystemName(dirname);
+    //
+    outDir = dirname.ToCString();
+  }
+  //
+  cf->Interp->SetVar( "filename", m_filename.c_str() );
+  cf->Interp->SetVar( "basename", basename.ToCString() );
+  cf->Interp->SetVar( "outdir",   outDir.c_str() );
+
+  std::cout << "Processing " << m_filename << "..." << std::endl;
+
+  // Execute recipe. Backslashes would be taken as escapes by Tcl. The path
+  // is braced to survive spaces.
+  std::string recipe = m_recipe;
+  std::replace(recipe.begin(), recipe.end(), '\\', '/');
+  //
+  const int ret = cf->Interp->Eval( asiTcl_SourceCmd( ("{" + recipe + "}").c_str() ) );
+  //
+  if ( ret != TCL_OK )
+  {
+    std::cout << "Recipe finished with error code " << ret << "." << std::endl;
+    return 1;
+  }
+
+  std::cout << "Recipe finished successfully." << std::endl;
+  return 0;
+}
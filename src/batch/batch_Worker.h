@@ -0,0 +1,77 @@
+//-----------------------------------------------------------------------------
+// Created on: 18 October 2026
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026-present, Sergey Slyadnev
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//    * Neither the name of the copyright holder(s) nor the
+//      names of all contributors may be used to endorse or promote products
+//      derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifndef batch_Worker_h
+#define batch_Worker_h
+
+// Standard includes
+#include <string>
+
+//-----------------------------------------------------------------------------
+
+//! Processes a single file in a dedicated process. The worker initializes
+//! its own Data Model and Tcl interpreter with the standard command
+//! plugins and sources the recipe script. The following Tcl variables are
+//! available in the recipe:
+//!
+//! - `filename` -- full path of the file to process;
+//! - `basename` -- short filename without extension;
+//! - `outdir`   -- output directory for the conversion results.
+//!
+//! Since each file is processed in a separate process, the Data Model of
+//! the worker is isolated from other files, and crashes or memory leaks
+//! in one conversion do not affect the others.
+class batch_Worker
+{
+public:
+
+  //! Ctor.
+  //! \param[in] filename file to process.
+  //! \param[in] recipe   Tcl script to execute.
+  //! \param[in] outDir   output directory.
+  batch_Worker(const std::string& filename,
+               const std::string& recipe,
+               const std::string& outDir);
+
+public:
+
+  //! Executes the recipe.
+  //! \return process exit code: 0 in case of success, 1 -- otherwise.
+  int Run();
+
+protected:
+
+  std::string m_filename; //!< File to process.
+  std::string m_recipe;   //!< Recipe script.
+  std::string m_outDir;   //!< Output directory.
+
+};
+
+#endif
@@ -42,27 +42,19 @@
 #include <asiVisu_OctreePrs.h>
 
 // asiAlgo includes
+#include <asiAlgo_MarchingCubes.h>
+#include <asiAlgo_MeshDistanceFunc.h>
 #include <asiAlgo_ProjectPointOnMesh.h>
+#include <asiAlgo_ReadREK.h>
+#include <asiAlgo_ResampleADF.h>
+#include <asiAlgo_ResampleADFInput.h>
+#include <asiAlgo_SVO.h>
 #include <asiAlgo_Timer.h>
-//
-#ifdef USE_MOBIUS
-  #include <asiAlgo_MeshDistanceFunc.h>
-#endif
+#include <asiAlgo_WriteREK.h>
 
 // asiTcl includes
 #include <asiTcl_PluginMacro.h>
 
-#ifdef USE_MOBIUS
-  #include <mobius/cascade.h>
-  #include <mobius/cascade_Triangulation.h>
-  #include <mobius/poly_DistanceField.h>
-  #include <mobius/poly_DistanceFunc.h>
-  #include <mobius/poly_MarchingCubes.h>
-  #include <mobius/poly_SVO.h>
-
-  using namespace mobius;
-#endif
-
 // VTK includes
 #pragma warning(push, 0)
 #include <vtkXMLUnstructuredGridWriter.h>
@@ -104,7 +96,6 @@ int DDF_BuildSVO(const Handle(asiTcl_Interp)& interp,
                  int                          argc,
                  const char**                 argv)
 {
-#if defined USE_MOBIUS
   // Min cell size.
   double minSize = 1.0;
   interp->GetKeyValue(argc, argv, "min", minSize);
@@ -176,17 +167,9 @@ int DDF_BuildSVO(const Handle(asiTcl_Interp)& interp,
 
   // Size of a single voxel for information.
   interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Size of a single voxel (bytes): %1."
-                                                        << int( sizeof(poly_SVO) ) );
+                                                        << int( sizeof(asiAlgo_SVO::t_node) ) );
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -195,7 +178,6 @@ int DDF_DumpVTU(const Handle(asiTcl_Interp)& interp,
                 int                          argc,
                 const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc != 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -216,8 +198,8 @@ int DDF_DumpVTU(const Handle(asiTcl_Interp)& interp,
   }
 
   // Get distance field from the Part Node.
-  poly_SVO*
-    pSVO = static_cast<poly_SVO*>( octreeNode->GetOctree() );
+  asiAlgo_SVO*
+    pSVO = static_cast<asiAlgo_SVO*>( octreeNode->GetOctree() );
   //
   if ( !pSVO )
   {
@@ -251,14 +233,6 @@ int DDF_DumpVTU(const Handle(asiTcl_Interp)& interp,
   writer->Write();
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -267,7 +241,6 @@ int DDF_SetSVO(const Handle(asiTcl_Interp)& interp,
                int                          argc,
                const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc < 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -288,7 +261,7 @@ int DDF_SetSVO(const Handle(asiTcl_Interp)& interp,
   }
 
   // Get distance field from the Part Node.
-  poly_SVO* pSVO = static_cast<poly_SVO*>( octreeNode->GetOctree() );
+  asiAlgo_SVO* pSVO = static_cast<asiAlgo_SVO*>( octreeNode->GetOctree() );
   //
   if ( !pSVO )
   {
@@ -297,24 +270,28 @@ int DDF_SetSVO(const Handle(asiTcl_Interp)& interp,
   }
 
   // Prepare path.
-  std::vector<size_t> path;
+  std::vector<int> path;
   //
   for ( int k = 2; k < argc; ++k )
-    path.push_back( (size_t) atoi(argv[k]) );
+    path.push_back( atoi(argv[k]) );
 
-  // Access octree node.
-  poly_SVO* pNode = pSVO->FindChild(path);
+  // Access octree cell.
+  asiAlgo_SVO::t_cell cell;
   //
-  if ( !pNode )
+  if ( !pSVO->FindCell(path, cell) )
   {
     interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot access the requested node.");
     return TCL_ERROR;
   }
 
+  // The extracted subtree becomes a new octree, while the original one is
+  // kept for undo.
+  asiAlgo_SVO* pSubSVO = pSVO->Extract(cell);
+
   // Show voxels.
   M->OpenCommand();
   {
-    octreeNode->SetOctree(pNode);
+    octreeNode->SetOctree(pSubSVO);
 
     double xMin, yMin, zMin, xMax, yMax, zMax;
     octreeNode->GetDomainMinCorner(xMin, yMin, zMin);
@@ -324,45 +301,29 @@ int DDF_SetSVO(const Handle(asiTcl_Interp)& interp,
     gp_XYZ domainMax(xMax, yMax, zMax);
 
     // Evaluate real distances to compare with the cached ones.
-    t_ptr<poly_RealFunc>
+    Handle(asiAlgo_DistanceFunc)
       distFunc = new asiAlgo_MeshDistanceFunc( octreeNode->GetBVH(),
                                                domainMin,
                                                domainMax,
-                                               poly_DistanceFunc::Mode_Signed,
+                                               asiAlgo_DistanceFunc::Mode_Signed,
                                                octreeNode->GetNumRaysSign(),
                                                octreeNode->IsDomainCube() );
     //
-    const double f0 = distFunc->Eval( pNode->GetP0().X(), pNode->GetP0().Y(), pNode->GetP0().Z() );
-    const double f1 = distFunc->Eval( pNode->GetP1().X(), pNode->GetP1().Y(), pNode->GetP1().Z() );
-    const double f2 = distFunc->Eval( pNode->GetP2().X(), pNode->GetP2().Y(), pNode->GetP2().Z() );
-    const double f3 = distFunc->Eval( pNode->GetP3().X(), pNode->GetP3().Y(), pNode->GetP3().Z() );
-    const double f4 = distFunc->Eval( pNode->GetP4().X(), pNode->GetP4().Y(), pNode->GetP4().Z() );
-    const double f5 = distFunc->Eval( pNode->GetP5().X(), pNode->GetP5().Y(), pNode->GetP5().Z() );
-    const double f6 = distFunc->Eval( pNode->GetP6().X(), pNode->GetP6().Y(), pNode->GetP6().Z() );
-    const double f7 = distFunc->Eval( pNode->GetP7().X(), pNode->GetP7().Y(), pNode->GetP7().Z() );
-
-    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar 0: %1 vs %2 evaluated." << pNode->GetScalar(0) << f0 );
-    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar 1: %1 vs %2 evaluated." << pNode->GetScalar(1) << f1 );
-    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar 2: %1 vs %2 evaluated." << pNode->GetScalar(2) << f2 );
-    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar 3: %1 vs %2 evaluated." << pNode->GetScalar(3) << f3 );
-    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar 4: %1 vs %2 evaluated." << pNode->GetScalar(4) << f4 );
-    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar 5: %1 vs %2 evaluated." << pNode->GetScalar(5) << f5 );
-    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar 6: %1 vs %2 evaluated." << pNode->GetScalar(6) << f6 );
-    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar 7: %1 vs %2 evaluated." << pNode->GetScalar(7) << f7 );
+    for ( int k = 0; k < 8; ++k )
+    {
+      const double f = distFunc->Eval( (k & 1) ? cell.Max.X() : cell.Min.X(),
+                                       (k & 2) ? cell.Max.Y() : cell.Min.Y(),
+                                       (k & 4) ? cell.Max.Z() : cell.Min.Z() );
+
+      interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Scalar %1: %2 vs %3 evaluated."
+                                                            << k << pSVO->GetScalar(cell.Node, k) << f );
+    }
   }
   M->CommitCommand();
   //
   cmdDDF::cf->ViewerPart->PrsMgr()->Actualize(octreeNode);
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -371,7 +332,6 @@ int DDF_EvalSVO(const Handle(asiTcl_Interp)& interp,
                 int                          argc,
                 const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc != 5 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -392,7 +352,7 @@ int DDF_EvalSVO(const Handle(asiTcl_Interp)& interp,
   }
 
   // Get octree from the Part Node.
-  poly_SVO* pSVO = static_cast<poly_SVO*>( octreeNode->GetOctree() );
+  asiAlgo_SVO* pSVO = static_cast<asiAlgo_SVO*>( octreeNode->GetOctree() );
   //
   if ( !pSVO )
   {
@@ -400,12 +360,6 @@ int DDF_EvalSVO(const Handle(asiTcl_Interp)& interp,
     return TCL_ERROR;
   }
 
-  if ( !pSVO->HasScalars() )
-  {
-    interp->GetProgress().SendLogMessage(LogErr(Normal) << "The root SVO node is uninitialized.");
-    return TCL_ERROR;
-  }
-
   // Get coordinates of the point to evaluate.
   const double x = atof(argv[2]);
   const double y = atof(argv[3]);
@@ -413,7 +367,7 @@ int DDF_EvalSVO(const Handle(asiTcl_Interp)& interp,
   //
   interp->GetPlotter().REDRAW_POINT("P", gp_Pnt(x, y, z), Color_Red);
   //
-  t_xyz P(x, y, z);
+  gp_XYZ P(x, y, z);
 
   // Evaluate.
   const double f = pSVO->Eval(P);
@@ -422,14 +376,6 @@ int DDF_EvalSVO(const Handle(asiTcl_Interp)& interp,
                                                        << x << y << z << f);
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -438,7 +384,6 @@ int DDF_Polygonize(const Handle(asiTcl_Interp)& interp,
                    int                          argc,
                    const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc < 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -451,6 +396,12 @@ int DDF_Polygonize(const Handle(asiTcl_Interp)& interp,
   // Get number of slices for a regular grid.
   int numSlices = 128;
   interp->GetKeyValue(argc, argv, "slices", numSlices);
+  //
+  if ( numSlices < 1 )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "The number of slices should be positive.");
+    return TCL_ERROR;
+  }
 
   Handle(asiEngine_Model)
     M = Handle(asiEngine_Model)::DownCast( interp->GetModel() );
@@ -467,7 +418,7 @@ int DDF_Polygonize(const Handle(asiTcl_Interp)& interp,
   }
 
   // Get distance field from the Part Node.
-  poly_SVO* pOctree = static_cast<poly_SVO*>( octreeNode->GetOctree() );
+  asiAlgo_SVO* pOctree = static_cast<asiAlgo_SVO*>( octreeNode->GetOctree() );
   //
   if ( !pOctree )
   {
@@ -475,40 +426,30 @@ int DDF_Polygonize(const Handle(asiTcl_Interp)& interp,
     return TCL_ERROR;
   }
 
-  // Construct distance field to serve as a function for the
-  // reconstruction algorithm.
-  t_ptr<poly_DistanceField> df = new poly_DistanceField(pOctree);
+  // Resample the distance field to a uniform grid.
+  const gp_XYZ size = pOctree->GetCornerMax() - pOctree->GetCornerMin();
+  const double step = Max( size.X(), Max( size.Y(), size.Z() ) ) / numSlices;
+  //
+  asiAlgo_ResampleADF resampleAlgo( pOctree, interp->GetProgress(), interp->GetPlotter() );
+  //
+  if ( !resampleAlgo.Perform( (float) step ) )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Failed to resample ADF.");
+    return TCL_ERROR;
+  }
 
   // Run marching cubes reconstruction.
-  poly_MarchingCubes mcAlgo(df, numSlices);
+  asiAlgo_MarchingCubes mcAlgo( interp->GetProgress(), interp->GetPlotter() );
   //
-  if ( !mcAlgo.Perform(level) )
+  if ( !mcAlgo.Perform(resampleAlgo.GetResult(), level) )
   {
     interp->GetProgress().SendLogMessage(LogErr(Normal) << "Marching cubes reconstruction failed.");
     return TCL_ERROR;
   }
 
-  // Get the reconstruction result.
-  const t_ptr<poly_Mesh>& mesh = mcAlgo.GetResult();
-
-  // Convert to OpenCascade's mesh.
-  cascade_Triangulation converter(mesh);
-  converter.DirectConvert();
-  //
-  const Handle(Poly_Triangulation)&
-    triangulation = converter.GetOpenCascadeTriangulation();
-
   // Draw.
-  interp->GetPlotter().REDRAW_TRIANGULATION(argv[1], triangulation, Color_Default, 1.);
+  interp->GetPlotter().REDRAW_TRIANGULATION(argv[1], mcAlgo.GetResult(), Color_Default, 1.);
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -517,7 +458,6 @@ int DDF_PolygonizeCell(const Handle(asiTcl_Interp)& interp,
                        int                          argc,
                        const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc < 4 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -538,7 +478,7 @@ int DDF_PolygonizeCell(const Handle(asiTcl_Interp)& interp,
   }
 
   // Get distance field from the Part Node.
-  poly_SVO* pSVO = static_cast<poly_SVO*>( octreeNode->GetOctree() );
+  asiAlgo_SVO* pSVO = static_cast<asiAlgo_SVO*>( octreeNode->GetOctree() );
   //
   if ( !pSVO )
   {
@@ -547,86 +487,47 @@ int DDF_PolygonizeCell(const Handle(asiTcl_Interp)& interp,
   }
 
   // Prepare path.
-  std::vector<size_t> path;
+  std::vector<int> path;
   //
   for ( int k = 3; k < argc; ++k )
-    path.push_back( (size_t) atoi(argv[k]) );
+    path.push_back( atoi(argv[k]) );
 
-  // Access octree node.
-  poly_SVO* pNode = pSVO->FindChild(path);
+  // Access octree cell.
+  asiAlgo_SVO::t_cell cell;
   //
-  if ( !pNode )
+  if ( !pSVO->FindCell(path, cell) )
   {
     interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot access the requested node.");
     return TCL_ERROR;
   }
 
+  // The original octree is kept for undo.
+  asiAlgo_SVO* pSubSVO = pSVO->Extract(cell);
+
   // Show voxels.
   M->OpenCommand();
   {
-    octreeNode->SetOctree(pNode);
+    octreeNode->SetOctree(pSubSVO);
   }
   M->CommitCommand();
   //
   cmdDDF::cf->ViewerPart->PrsMgr()->Actualize(octreeNode);
 
-  // Construct distance field to serve as a function for the
-  // reconstruction algorithm.
-  t_ptr<poly_DistanceField> df = new poly_DistanceField(pNode);
-
-  // Run marching cubes reconstruction at a single voxel.
-  t_ptr<poly_Mesh>
-    mesh = poly_MarchingCubes::PolygonizeVoxel( pNode->GetP0(), pNode->GetP7(),
-                                                df, 0. );
-
-  if ( !mesh->GetNumTriangles() )
+  // Run marching cubes reconstruction in the leaves of the cell.
+  asiAlgo_MarchingCubes mcAlgo( interp->GetProgress(), interp->GetPlotter() );
+  //
+  if ( !mcAlgo.Perform(pSubSVO) )
   {
     interp->GetProgress().SendLogMessage(LogWarn(Normal) << "Empty polygon.");
   }
   else
   {
-    // Convert to OpenCascade's mesh.
-    cascade_Triangulation converter(mesh);
-    converter.DirectConvert();
-    //
-    const Handle(Poly_Triangulation)&
-      triangulation = converter.GetOpenCascadeTriangulation();
-
     // Draw.
-    interp->GetPlotter().REDRAW_TRIANGULATION(argv[1], triangulation, Color_Default, 1.);
+    interp->GetPlotter().REDRAW_TRIANGULATION(argv[1], mcAlgo.GetResult(), Color_Default, 1.);
   }
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
-}
-
-//-----------------------------------------------------------------------------
-
-#if defined USE_MOBIUS
-void getLeaves(poly_SVO*               pNode,
-               std::vector<poly_SVO*>& leaves)
-{
-  if ( pNode == nullptr )
-    return;
-
-  if ( pNode->IsLeaf() )
-  {
-    leaves.push_back(pNode);
-  }
-  else
-    for ( size_t k = 0; k < 8; ++k )
-    {
-      getLeaves(pNode->GetChild(k), leaves);
-    }
 }
-#endif
 
 //-----------------------------------------------------------------------------
 
@@ -634,7 +535,6 @@ int DDF_PolygonizeSVO(const Handle(asiTcl_Interp)& interp,
                       int                          argc,
                       const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc != 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -655,7 +555,7 @@ int DDF_PolygonizeSVO(const Handle(asiTcl_Interp)& interp,
   }
 
   // Get distance field from the Part Node.
-  poly_SVO* pSVO = static_cast<poly_SVO*>( octreeNode->GetOctree() );
+  asiAlgo_SVO* pSVO = static_cast<asiAlgo_SVO*>( octreeNode->GetOctree() );
   //
   if ( !pSVO )
   {
@@ -663,78 +563,18 @@ int DDF_PolygonizeSVO(const Handle(asiTcl_Interp)& interp,
     return TCL_ERROR;
   }
 
-  // Construct distance field to serve as a function for the
-  // reconstruction algorithm.
-  t_ptr<poly_DistanceField> df = new poly_DistanceField(pSVO);
-
-  // Gather leaves.
-  std::vector<poly_SVO*> leaves;
+  // Run marching cubes reconstruction in all leaves.
+  asiAlgo_MarchingCubes mcAlgo( interp->GetProgress(), interp->GetPlotter() );
   //
-  getLeaves(pSVO, leaves);
-
-  t_ptr<poly_Mesh> resMesh = new poly_Mesh;
-
-  // Run marching cubes in each leaf.
-  for ( size_t k = 0; k < leaves.size(); ++k )
+  if ( !mcAlgo.Perform(pSVO) )
   {
-    // Run marching cubes reconstruction at a single voxel.
-    t_ptr<poly_Mesh>
-      localMesh = poly_MarchingCubes::PolygonizeVoxel( leaves[k]->GetP0(), leaves[k]->GetP7(),
-                                                       df, 0. );
-
-    if ( !localMesh->GetNumTriangles() )
-    {
-      interp->GetProgress().SendLogMessage(LogWarn(Normal) << "Empty local mesh.");
-    }
-    else
-    {
-      for ( poly_Mesh::TriangleIterator tit(localMesh); tit.More(); tit.Next() )
-      {
-        poly_TriangleHandle ht = tit.Current();
-        poly_VertexHandle   hv[3], res_hv[3];
-
-        // Get vertices.
-        poly_Triangle t;
-        if ( !localMesh->GetTriangle(ht, t) )
-          continue;
-        //
-        t.GetVertices(hv[0], hv[1], hv[2]);
-
-        // Add new triangle to the result mesh.
-        for ( int kk = 0; kk < 3; ++kk )
-        {
-          poly_Vertex v;
-          localMesh->GetVertex(hv[kk], v);
-
-          // Add vertex to the resulting mesh.
-          res_hv[kk] = resMesh->AddVertex(v);
-        }
-
-        // Add triangle to the resulting mesh.
-        resMesh->AddTriangle(res_hv[0], res_hv[1], res_hv[2]);
-      }
-    }
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Marching cubes reconstruction failed.");
+    return TCL_ERROR;
   }
 
-  // Convert to OpenCascade's mesh.
-  cascade_Triangulation converter(resMesh);
-  converter.DirectConvert();
-  //
-  const Handle(Poly_Triangulation)&
-    triangulation = converter.GetOpenCascadeTriangulation();
-
   // Draw.
-  interp->GetPlotter().REDRAW_TRIANGULATION(argv[1], triangulation, Color_Default, 1.);
-
+  interp->GetPlotter().REDRAW_TRIANGULATION(argv[1], mcAlgo.GetResult(), Color_Default, 1.);
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -743,7 +583,6 @@ int DDF_Unite(const Handle(asiTcl_Interp)& interp,
               int                          argc,
               const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc != 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -794,14 +633,6 @@ int DDF_Unite(const Handle(asiTcl_Interp)& interp,
   cmdDDF::cf->ViewerPart->PrsMgr()->Actualize(octreeNode);
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -810,7 +641,6 @@ int DDF_Common(const Handle(asiTcl_Interp)& interp,
                int                          argc,
                const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc != 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -861,14 +691,6 @@ int DDF_Common(const Handle(asiTcl_Interp)& interp,
   cmdDDF::cf->ViewerPart->PrsMgr()->Actualize(octreeNode);
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -877,7 +699,6 @@ int DDF_Cut(const Handle(asiTcl_Interp)& interp,
             int                          argc,
             const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc != 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -928,14 +749,6 @@ int DDF_Cut(const Handle(asiTcl_Interp)& interp,
   cmdDDF::cf->ViewerPart->PrsMgr()->Actualize(octreeNode);
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
-
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
-
-  return TCL_ERROR;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -944,7 +757,6 @@ int DDF_ExtractOutsideLeaves(const Handle(asiTcl_Interp)& interp,
                              int                          argc,
                              const char**                 argv)
 {
-#if defined USE_MOBIUS
   if ( argc != 2 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
@@ -965,7 +777,7 @@ int DDF_ExtractOutsideLeaves(const Handle(asiTcl_Interp)& interp,
   }
 
   // Get SVO node.
-  poly_SVO* pSVO = static_cast<poly_SVO*>( octreeNodeLeft->GetOctree() );
+  asiAlgo_SVO* pSVO = static_cast<asiAlgo_SVO*>( octreeNodeLeft->GetOctree() );
   //
   if ( pSVO == nullptr )
   {
@@ -975,8 +787,8 @@ int DDF_ExtractOutsideLeaves(const Handle(asiTcl_Interp)& interp,
   }
 
   // Get leaves.
-  std::vector<const poly_SVO*> svoLeaves;
-  pSVO->GetLeaves(svoLeaves, ScalarMembership_On);
+  std::vector<asiAlgo_SVO::t_cell> svoLeaves;
+  pSVO->GetLeaves(svoLeaves, Membership_On);
   //
   interp->GetProgress().SendLogMessage( LogInfo(Normal) << "%1 SVO leaves collected."
                                                         << int( svoLeaves.size() ) );
@@ -987,14 +799,136 @@ int DDF_ExtractOutsideLeaves(const Handle(asiTcl_Interp)& interp,
   cmdDDF::cf->ViewerPart->PrsMgr()->Actualize( M->GetTessellationNode() );
 
   return TCL_OK;
-#else
-  cmdDDF_NotUsed(argc);
-  cmdDDF_NotUsed(argv);
+}
+
+//-----------------------------------------------------------------------------
+
+int DDF_WriteREK(const Handle(asiTcl_Interp)& interp,
+                 int                          argc,
+                 const char**                 argv)
+{
+  if ( argc < 3 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  Handle(asiEngine_Model)
+    M = Handle(asiEngine_Model)::DownCast( interp->GetModel() );
+
+  // Find octree.
+  Handle(asiData_OctreeNode)
+    octreeNode = Handle(asiData_OctreeNode)::DownCast( M->FindNode(argv[1]) );
+  //
+  if ( octreeNode.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot find octree with the id %1."
+                                                        << argv[1]);
+    return TCL_ERROR;
+  }
+
+  asiAlgo_SVO* pSVO = static_cast<asiAlgo_SVO*>( octreeNode->GetOctree() );
+  //
+  if ( !pSVO )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Distance field is not initialized.");
+    return TCL_ERROR;
+  }
+
+  // Sampling step.
+  double step = 1.0;
+  interp->GetKeyValue(argc, argv, "step", step);
+
+  // Number of slices to flush at once.
+  int slabSize = 0;
+  interp->GetKeyValue(argc, argv, "slab", slabSize);
+
+  // Scaling coefficient.
+  double scale = 1.0;
+  interp->GetKeyValue(argc, argv, "scale", scale);
+
+  // Data provider evaluating the distance field slice by slice.
+  Handle(asiAlgo_ResampleADFInput)
+    input = new asiAlgo_ResampleADFInput( pSVO, (float) step, interp->GetProgress() );
+  //
+  interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Volume size: %1 x %2 x %3 voxels."
+                                                        << input->GetSizeX()
+                                                        << input->GetSizeY()
+                                                        << input->GetSizeZ() );
+
+  TIMER_NEW
+  TIMER_GO
+
+  try
+  {
+    asiAlgo_WriteREK WriteREK(argv[2], (float) scale);
+    WriteREK.SetSlabSize(slabSize);
+    //
+    if ( !WriteREK.Write(input) )
+    {
+      interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot write REK file.");
+      return TCL_ERROR;
+    }
+  }
+  catch ( const std::exception& ex )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot write REK file: %1." << ex.what());
+    return TCL_ERROR;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Write REK file")
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
 
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "SVO is a part of Mobius (not available in open source).");
+int DDF_ProbeREK(const Handle(asiTcl_Interp)& interp,
+                 int                          argc,
+                 const char**                 argv)
+{
+  if ( argc != 2 && argc != 5 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
 
-  return TCL_ERROR;
-#endif
+  // Map the file.
+  asiAlgo_ReadREK ReadREK;
+  //
+  if ( !ReadREK.Open(argv[1]) )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot open REK file %1." << argv[1]);
+    return TCL_ERROR;
+  }
+
+  interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Volume size: %1 x %2 x %3 voxels of size %4."
+                                                        << ReadREK.GetSizeX()
+                                                        << ReadREK.GetSizeY()
+                                                        << ReadREK.GetSizeZ()
+                                                        << ReadREK.GetHeader().PixelSize );
+
+  if ( argc == 2 )
+    return TCL_OK;
+
+  const int i = atoi(argv[2]);
+  const int j = atoi(argv[3]);
+  const int k = atoi(argv[4]);
+  //
+  if ( i < 0 || i >= ReadREK.GetSizeX() ||
+       j < 0 || j >= ReadREK.GetSizeY() ||
+       k < 0 || k >= ReadREK.GetSizeZ() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Voxel indices are out of range.");
+    return TCL_ERROR;
+  }
+
+  const double f = ReadREK.GetValue(i, j, k);
+  //
+  interp->GetProgress().SendLogMessage(LogInfo(Normal) << "f[%1, %2, %3] = %4."
+                                                       << i << j << k << f);
+  *interp << f;
+
+  return TCL_OK;
 }
 
 //-----------------------------------------------------------------------------
@@ -1081,8 +1015,8 @@ void cmdDDF::Factory(const Handle(asiTcl_Interp)&      interp,
     "ddf-polygonize <resName> <octreeId> [-level <isoLevel>] [-slices <numSlices>]\n"
     "\t Polygonizes the distance field stored in the octree <octreeId> at\n"
     "\t <isoLevel> function level set. The keyword '-slices' allows to control\n"
-    "\t the number of cells in the uniform grid used internally in the marching\n"
-    "\t cubes algorithm.",
+    "\t the number of cells along the longest side of the uniform grid used\n"
+    "\t internally in the marching cubes algorithm.",
     //
     __FILE__, group, DDF_Polygonize);
 
@@ -1098,7 +1032,8 @@ void cmdDDF::Factory(const Handle(asiTcl_Interp)&      interp,
   interp->AddCommand("ddf-polygonize-svo",
     //
     "ddf-polygonize-svo <resName> <octreeId>\n"
-    "\t Polygonizes the SVO with the <octreeId> identifier.",
+    "\t Polygonizes the leaves of the SVO with the <octreeId> identifier\n"
+    "\t into a mesh with shared vertices.",
     //
     __FILE__, group, DDF_PolygonizeSVO);
 
@@ -1136,6 +1071,27 @@ void cmdDDF::Factory(const Handle(asiTcl_Interp)&      interp,
     "\t Extracts the outside leaves of the DDF with the specified <id>.",
     //
     __FILE__, group, DDF_ExtractOutsideLeaves);
+
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("ddf-write-rek",
+    //
+    "ddf-write-rek <octreeId> <filename> [-step <step>] [-slab <numSlices>] [-scale <coeff>]\n"
+    "\t Samples the distance field stored in the octree <octreeId> with the\n"
+    "\t given <step> and writes the voxels to the REK file. The volume is\n"
+    "\t generated and flushed to the file slab by slab, where each slab\n"
+    "\t contains <numSlices> XOY slices. The voxel values are multiplied by\n"
+    "\t <coeff> which is useful for unit conversion.",
+    //
+    __FILE__, group, DDF_WriteREK);
+
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("ddf-probe-rek",
+    //
+    "ddf-probe-rek <filename> [<i> <j> <k>]\n"
+    "\t Maps the REK file to memory and prints its dimensions. If the voxel\n"
+    "\t indices are passed, the corresponding value is returned.",
+    //
+    __FILE__, group, DDF_ProbeREK);
 }
 
 // Declare entry point PLUGINFACTORY
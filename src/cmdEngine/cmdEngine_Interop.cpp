@@ -45,17 +45,63 @@
 #include <asiTcl_PluginMacro.h>
 
 // asiAlgo includes
+#include <asiAlgo_MeshGen.h>
+#include <asiAlgo_MeshInfo.h>
 #include <asiAlgo_ReadSTEPWithMeta.h>
 #include <asiAlgo_STEP.h>
 #include <asiAlgo_STEPReduce.h>
 #include <asiAlgo_Timer.h>
 #include <asiAlgo_Utils.h>
+#include <asiAlgo_WriteGLTF.h>
+
+// OCCT includes
+#include <BRep_Tool.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
 
 // VTK includes
 #include <vtkXMLPolyDataWriter.h>
 
 //-----------------------------------------------------------------------------
 
+namespace
+{
+  //! Reader of STEP file structure kept between the commands, so that the
+  //! roots of the same file are materialized without parsing it again.
+  Handle(asiAlgo_ReadSTEPWithMeta) StepStructureReader;
+
+  //! Returns the reader with the indexed roots of the given file. The kept
+  //! reader is reused if it has been created for the same file.
+  //! \param[in] interp    Tcl interpreter.
+  //! \param[in] filename  STEP file to read.
+  //! \param[in] forceRead whether to read the file even if the kept reader
+  //!                      has been created for it.
+  //! \return reader or null handle if the file cannot be read.
+  Handle(asiAlgo_ReadSTEPWithMeta)
+    GetStepStructureReader(const Handle(asiTcl_Interp)& interp,
+                           const char*                  filename,
+                           const bool                   forceRead)
+  {
+    if ( !forceRead                                          &&
+         !StepStructureReader.IsNull()                       &&
+         StepStructureReader->GetFilename().IsEqual(filename) )
+      return StepStructureReader;
+
+    StepStructureReader = new asiAlgo_ReadSTEPWithMeta( interp->GetProgress(),
+                                                        interp->GetPlotter() );
+    //
+    if ( !StepStructureReader->ReadStructure(filename) )
+    {
+      StepStructureReader.Nullify();
+      return nullptr;
+    }
+
+    return StepStructureReader;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
 void onModelLoaded(const TopoDS_Shape& loadedShape)
 {
   // Modify Data Model.
@@ -99,13 +145,21 @@ int ENGINE_LoadStep(const Handle(asiTcl_Interp)& interp,
                     int                          argc,
                     const char**                 argv)
 {
-  if ( argc != 2 )
+  if ( argc != 2 && argc != 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
   }
 
   TCollection_AsciiString filename(argv[1]);
 
+  // Check whether roots should be transferred concurrently.
+  const bool isParallel = interp->HasKeyword(argc, argv, "parallel");
+  //
+  if ( argc == 3 && !isParallel )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
   // Prepare output
   Handle(asiEngine_STEPReaderOutput)
     output = new asiEngine_STEPReaderOutput(cmdEngine::model);
@@ -114,6 +168,7 @@ int ENGINE_LoadStep(const Handle(asiTcl_Interp)& interp,
   asiAlgo_ReadSTEPWithMeta reader( interp->GetProgress(),
                                    interp->GetPlotter() );
   reader.SetOutput(output);
+  reader.SetParallelMode(isParallel);
 
   TIMER_NEW
   TIMER_GO
@@ -147,6 +202,113 @@ int ENGINE_LoadStep(const Handle(asiTcl_Interp)& interp,
 
 //-----------------------------------------------------------------------------
 
+int ENGINE_LoadStepStructure(const Handle(asiTcl_Interp)& interp,
+                             int                          argc,
+                             const char**                 argv)
+{
+  if ( argc != 2 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  TIMER_NEW
+  TIMER_GO
+
+  // Index roots without transferring geometry. The reader is kept for
+  // 'load-step-root'.
+  Handle(asiAlgo_ReadSTEPWithMeta)
+    reader = GetStepStructureReader(interp, argv[1], true);
+  //
+  if ( reader.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot read structure of STEP file.");
+    return TCL_ERROR;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Load STEP structure")
+
+  // Print roots.
+  const std::vector<asiAlgo_ReadSTEPWithMeta::t_rootInfo>&
+    roots = reader->GetStructure();
+  //
+  for ( size_t k = 0; k < roots.size(); ++k )
+  {
+    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Root %1: %2 '%3'."
+                                                          << roots[k].index
+                                                          << roots[k].type
+                                                          << roots[k].name );
+  }
+
+  *interp << int( roots.size() );
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+int ENGINE_LoadStepRoot(const Handle(asiTcl_Interp)& interp,
+                        int                          argc,
+                        const char**                 argv)
+{
+  if ( argc < 3 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  // Prepare output.
+  Handle(asiEngine_STEPReaderOutput)
+    output = new asiEngine_STEPReaderOutput(cmdEngine::model);
+
+  TIMER_NEW
+  TIMER_GO
+
+  // Take the kept reader or index roots without transferring geometry.
+  Handle(asiAlgo_ReadSTEPWithMeta)
+    reader = GetStepStructureReader(interp, argv[1], false);
+  //
+  if ( reader.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot read structure of STEP file.");
+    return TCL_ERROR;
+  }
+  //
+  reader->SetOutput(output);
+
+  // Transfer the requested roots.
+  cmdEngine::model->OpenCommand(); // tx start
+  {
+    for ( int k = 2; k < argc; ++k )
+    {
+      const int    rootIdx = atoi(argv[k]);
+      TopoDS_Shape rootShape;
+      //
+      if ( !reader->MaterializeRoot(rootIdx, rootShape) )
+      {
+        interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot load root %1." << rootIdx);
+        //
+        cmdEngine::model->AbortCommand();
+        return TCL_ERROR;
+      }
+    }
+  }
+  cmdEngine::model->CommitCommand();
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Load STEP roots")
+
+  // Update viewer.
+  if ( cmdEngine::cf && cmdEngine::cf->ViewerPart )
+    cmdEngine::cf->ViewerPart->PrsMgr()->Actualize( cmdEngine::model->GetPartNode() );
+
+  // Update object browser.
+  if ( cmdEngine::cf && cmdEngine::cf->ObjectBrowser )
+    cmdEngine::cf->ObjectBrowser->Populate();
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
 int ENGINE_SaveStep(const Handle(asiTcl_Interp)& interp,
                     int                          argc,
                     const char**                 argv)
@@ -199,6 +361,136 @@ int ENGINE_SaveStep(const Handle(asiTcl_Interp)& interp,
 
 //-----------------------------------------------------------------------------
 
+int ENGINE_SaveGLB(const Handle(asiTcl_Interp)& interp,
+                   int                          argc,
+                   const char**                 argv)
+{
+  if ( argc < 2 || argc > 4 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  TCollection_AsciiString filename(argv[1]);
+
+  // Check keywords.
+  bool isMesh = false, isQuantize = false;
+  //
+  for ( int k = 2; k < argc; ++k )
+  {
+    if ( !isMesh && interp->IsKeyword(argv[k], "mesh") )
+      isMesh = true;
+    else if ( !isQuantize && interp->IsKeyword(argv[k], "quantize") )
+      isQuantize = true;
+    else
+    {
+      interp->GetProgress().SendLogMessage(LogErr(Normal) << "Unexpected argument '%1'." << argv[k]);
+      return interp->ErrorOnWrongArgs(argv[0]);
+    }
+  }
+
+  asiAlgo_WriteGLTF writer( interp->GetProgress(), interp->GetPlotter() );
+  writer.SetQuantization(isQuantize);
+
+  bool isOk;
+  if ( isMesh )
+  {
+    // Get Triangulation Node.
+    Handle(asiData_TriangulationNode) tris_n = cmdEngine::model->GetTriangulationNode();
+    //
+    if ( tris_n.IsNull() || !tris_n->IsWellFormed() || tris_n->GetTriangulation().IsNull() )
+    {
+      interp->GetProgress().SendLogMessage(LogErr(Normal) << "Triangulation is not initialized.");
+      return TCL_ERROR;
+    }
+
+    isOk = writer.Perform(tris_n->GetTriangulation(), filename);
+  }
+  else
+  {
+    // Get Part Node to access shape.
+    Handle(asiData_PartNode) partNode = cmdEngine::model->GetPartNode();
+    //
+    if ( partNode.IsNull() || !partNode->IsWellFormed() )
+    {
+      interp->GetProgress().SendLogMessage(LogErr(Normal) << "Part is not initialized.");
+      return TCL_ERROR;
+    }
+    //
+    TopoDS_Shape shape = partNode->GetShape();
+
+    // Tessellate the faces which are not meshed yet.
+    bool isMeshed = true;
+    for ( TopExp_Explorer fexp(shape, TopAbs_FACE); fexp.More(); fexp.Next() )
+    {
+      TopLoc_Location L;
+      if ( BRep_Tool::Triangulation(TopoDS::Face( fexp.Current() ), L).IsNull() )
+      {
+        isMeshed = false;
+        break;
+      }
+    }
+    //
+    if ( !isMeshed )
+    {
+      asiAlgo_MeshInfo meshInfo;
+      asiAlgo_MeshGen::DoNative(shape,
+                                partNode->GetLinearDeflection(),
+                                partNode->GetAngularDeflection(),
+                                meshInfo);
+    }
+
+    // Colors from the metadata. The colors of solids and shells are
+    // inherited by their faces unless the faces are colored explicitly.
+    asiEngine_Part partApi(cmdEngine::model);
+    //
+    Handle(ActAPI_HNodeList) elems;
+    partApi.GetMetadataElems(elems);
+    //
+    if ( !elems.IsNull() )
+    {
+      for ( int pass = 0; pass < 2; ++pass )
+      {
+        for ( ActAPI_HNodeList::Iterator nit(*elems); nit.More(); nit.Next() )
+        {
+          Handle(asiData_ElemMetadataNode)
+            elem_n = Handle(asiData_ElemMetadataNode)::DownCast( nit.Value() );
+          //
+          if ( elem_n.IsNull() || !elem_n->IsWellFormed() )
+            continue;
+
+          const TopoDS_Shape elemShape = elem_n->GetShape();
+          //
+          if ( elemShape.IsNull() )
+            continue;
+
+          const bool isFace = (elemShape.ShapeType() == TopAbs_FACE);
+          //
+          if ( isFace != (pass == 1) )
+            continue;
+
+          for ( TopExp_Explorer fexp(elemShape, TopAbs_FACE); fexp.More(); fexp.Next() )
+            writer.SetFaceColor( fexp.Current(), elem_n->GetColor() );
+        }
+      }
+    }
+
+    // Colors from AAG take precedence.
+    writer.SetAAG( partNode->GetAAG() );
+
+    isOk = writer.Perform(shape, filename);
+  }
+
+  if ( !isOk )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot save GLB file.");
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
 int ENGINE_LoadBRep(const Handle(asiTcl_Interp)& interp,
                     int                          argc,
                     const char**                 argv)
@@ -328,7 +620,7 @@ int ENGINE_ReduceSTEP(const Handle(asiTcl_Interp)& interp,
                       int                          argc,
                       const char**                 argv)
 {
-  if ( argc != 3 )
+  if ( argc != 3 && argc != 4 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
   }
@@ -336,6 +628,14 @@ int ENGINE_ReduceSTEP(const Handle(asiTcl_Interp)& interp,
   std::string inFilename(argv[1]);
   std::string outFilename(argv[2]);
 
+  // Check whether the streaming mode is requested.
+  const bool isStreaming = interp->HasKeyword(argc, argv, "streaming");
+  //
+  if ( argc == 4 && !isStreaming )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
   TIMER_NEW
   TIMER_GO
 
@@ -343,7 +643,10 @@ int ENGINE_ReduceSTEP(const Handle(asiTcl_Interp)& interp,
   asiAlgo_STEPReduce ReduceTool( interp->GetProgress(),
                                  interp->GetPlotter() );
   //
-  if ( !ReduceTool.Peform(inFilename, outFilename) )
+  const bool isOk = isStreaming ? ReduceTool.PerformStreaming(inFilename, outFilename)
+                                : ReduceTool.Peform(inFilename, outFilename);
+  //
+  if ( !isOk )
   {
     interp->GetProgress().SendLogMessage(LogErr(Normal) << "STEP reduction failed.");
     return TCL_ERROR;
@@ -428,11 +731,35 @@ void cmdEngine::Commands_Interop(const Handle(asiTcl_Interp)&      interp,
   //-------------------------------------------------------------------------//
   interp->AddCommand("load-step",
     //
-    "load-step <filename>\n"
-    "\t Loads STEP file to the active part.",
+    "load-step <filename> [-parallel]\n"
+    "\t Loads STEP file to the active part. If the '-parallel' key is passed,\n"
+    "\t the transferable roots are translated concurrently. Each extra worker\n"
+    "\t parses the file again, so the workers are only used if the measured\n"
+    "\t transfer time outweighs the parsing time. Shapes shared between the\n"
+    "\t roots of different workers are duplicated in the result.",
     //
     __FILE__, group, ENGINE_LoadStep);
 
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("load-step-structure",
+    //
+    "load-step-structure <filename>\n"
+    "\t Reads STEP file and indexes its transferable roots without translating\n"
+    "\t geometry. Use 'load-step-root' to load the individual roots.",
+    //
+    __FILE__, group, ENGINE_LoadStepStructure);
+
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("load-step-root",
+    //
+    "load-step-root <filename> <index> [<index> ...]\n"
+    "\t Loads the roots with the given 1-based indices (as printed by\n"
+    "\t 'load-step-structure') from STEP file. The loaded roots constitute\n"
+    "\t the active part together with the roots loaded from the same file\n"
+    "\t before. The file is parsed only once for all calls.",
+    //
+    __FILE__, group, ENGINE_LoadStepRoot);
+
   //-------------------------------------------------------------------------//
   interp->AddCommand("save-step",
     //
@@ -442,6 +769,18 @@ void cmdEngine::Commands_Interop(const Handle(asiTcl_Interp)&      interp,
     //
     __FILE__, group, ENGINE_SaveStep);
 
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("save-glb",
+    //
+    "save-glb <filename> [-mesh] [-quantize]\n"
+    "\t Saves tessellation of the active part to a binary glTF file. The face\n"
+    "\t colors are taken from AAG and STEP metadata. If the '-mesh' key is\n"
+    "\t passed, the active triangulation is saved instead of the part. The\n"
+    "\t '-quantize' key enables compact storage of positions and normals\n"
+    "\t (KHR_mesh_quantization).",
+    //
+    __FILE__, group, ENGINE_SaveGLB);
+
   //-------------------------------------------------------------------------//
   interp->AddCommand("load-brep",
     //
@@ -477,8 +816,11 @@ void cmdEngine::Commands_Interop(const Handle(asiTcl_Interp)&      interp,
   //-------------------------------------------------------------------------//
   interp->AddCommand("reduce-step",
     //
-    "reduce-step <inFlename> <outFilename>\n"
-    "\t Applies STEP reduction procedure developed by Seth Hillbrand for KICAD.",
+    "reduce-step <inFlename> <outFilename> [-streaming]\n"
+    "\t Applies STEP reduction procedure developed by Seth Hillbrand for KICAD.\n"
+    "\t If the '-streaming' key is passed, the file is processed in several\n"
+    "\t passes without loading its contents into memory. Use this mode for\n"
+    "\t huge files.",
     //
     __FILE__, group, ENGINE_ReduceSTEP);
 
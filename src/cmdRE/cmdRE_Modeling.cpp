@@ -32,19 +32,27 @@
 #include <cmdRE.h>
 
 // asiAlgo includes
+#include <asiAlgo_ApproxBSurf.h>
 #include <asiAlgo_CheckDeviations.h>
 #include <asiAlgo_Cloudify.h>
+#include <asiAlgo_CloudKernels.h>
+#include <asiAlgo_DetectPrimitives.h>
+#include <asiAlgo_KHull2d.h>
 #include <asiAlgo_MeshInterPlane.h>
 #include <asiAlgo_MeshMerge.h>
-#include <asiAlgo_MeshProjectLine.h>
 #include <asiAlgo_PlaneOnPoints.h>
 #include <asiAlgo_PlateOnEdges.h>
-#include <asiAlgo_ProjectPointOnMesh.h>
+#include <asiAlgo_PlateOnPoints.h>
+#include <asiAlgo_PointCloudUtils.h>
 #include <asiAlgo_PurifyCloud.h>
+#include <asiAlgo_ReapproxContour.h>
+#include <asiAlgo_ReorientNorms.h>
+#include <asiAlgo_TiledCloud.h>
 #include <asiAlgo_Timer.h>
 #include <asiAlgo_Utils.h>
 
 // asiEngine includes
+#include <asiEngine_FuncScheduler.h>
 #include <asiEngine_IV.h>
 #include <asiEngine_Part.h>
 #include <asiEngine_RE.h>
@@ -59,7 +67,6 @@
 #if defined USE_MOBIUS
   // Mobius includes
   #include <mobius/cascade.h>
-  #include <mobius/geom_ApproxBSurf.h>
   #include <mobius/geom_BuildAveragePlane.h>
   #include <mobius/geom_InterpolateMultiCurve.h>
   #include <mobius/geom_FairBCurve.h>
@@ -74,11 +81,16 @@
 #include <ActData_Mesh_Quadrangle.h>
 
 // OCCT includes
+#include <BRep_Builder.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <GCPnts_QuasiUniformAbscissa.hxx>
 #include <GeomAdaptor_Curve.hxx>
+#include <gp.hxx>
+#include <gp_Ax3.hxx>
 #include <ShapeAnalysis_Surface.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
 
 // Qt includes
 #pragma warning(push, 0)
@@ -87,39 +99,8 @@
 #include <QProcess>
 #pragma warning(pop)
 
-//-----------------------------------------------------------------------------
-
-//! Unoriented link.
-struct t_undirectedLink
-{
-  int N1; //!< First node.
-  int N2; //!< Second node.
-
-  //! Ctor default.
-  t_undirectedLink() : N1(0), N2(0) {}
-
-  //! Ctor with parameters.
-  t_undirectedLink(const int _N1, const int _N2) : N1(_N1), N2(_N2) {}
-
-  //! \return hash code for the link.
-  static int HashCode(const t_undirectedLink& arc, const int upper)
-  {
-    int key = arc.N1 + arc.N2;
-    key += (key << 10);
-    key ^= (key >> 6);
-    key += (key << 3);
-    key ^= (key >> 11);
-    return (key & 0x7fffffff) % upper;
-  }
-
-  //! \return true if two links are equal.
-  static int IsEqual(const t_undirectedLink& arc1,
-                     const t_undirectedLink& arc2)
-  {
-    return ( (arc1.N1 == arc2.N1) && (arc1.N2 == arc2.N2) ) ||
-           ( (arc1.N2 == arc2.N1) && (arc1.N1 == arc2.N2) );
-  }
-};
+// Standard includes
+#include <random>
 
 //-----------------------------------------------------------------------------
 
@@ -174,6 +155,59 @@ int RE_SmoothenRegularEdges(const Handle(asiTcl_Interp)& interp,
 
 //-----------------------------------------------------------------------------
 
+namespace
+{
+  //! Collects the Patch Nodes by the names passed as command arguments. If
+  //! no names are passed, all patches are collected.
+  Handle(ActAPI_HNodeList)
+    CollectPatches(const Handle(asiTcl_Interp)&         interp,
+                   int                                  argc,
+                   const char**                         argv,
+                   const Handle(asiData_RePatchesNode)& patchesNode)
+  {
+    Handle(ActAPI_HNodeList) patchNodes = new ActAPI_HNodeList;
+
+    /* Collect patches by names */
+
+    for ( int k = 1; k < argc; ++k )
+    {
+      // Skip keywords and their values.
+      TCollection_AsciiString arg(argv[k]);
+      if ( arg.IsEmpty() || arg.IsRealValue() || arg.Value(1) == '-' )
+        continue;
+
+      Handle(asiData_RePatchNode)
+        patchNode = Handle(asiData_RePatchNode)::DownCast( cmdRE::model->FindNodeByName(arg) );
+      //
+      if ( patchNode.IsNull() || !patchNode->IsWellFormed() )
+      {
+        interp->GetProgress().SendLogMessage(LogWarn(Normal) << "Object with name '%1' is not a patch."
+                                                              << arg);
+        continue;
+      }
+      //
+      patchNodes->Append(patchNode);
+    }
+
+    if ( !patchNodes->Length() )
+    {
+      /* Collect all patches */
+
+      for ( Handle(ActAPI_IChildIterator) eit = patchesNode->GetChildIterator(); eit->More(); eit->Next() )
+      {
+        Handle(asiData_RePatchNode)
+          patchNode = Handle(asiData_RePatchNode)::DownCast( eit->Value() );
+        //
+        patchNodes->Append(patchNode);
+      }
+    }
+
+    return patchNodes;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
 int RE_BuildPatches(const Handle(asiTcl_Interp)& interp,
                     int                          argc,
                     const char**                 argv)
@@ -204,46 +238,8 @@ int RE_BuildPatches(const Handle(asiTcl_Interp)& interp,
     return TCL_ERROR;
   }
 
-  /* =============================
-   *  Collect patches of interest
-   * ============================= */
-
-  Handle(ActAPI_HNodeList) patchNodes = new ActAPI_HNodeList;
-
-  /* Collect patches by names */
-
-  for ( int k = 1; k < argc; ++k )
-  {
-    // Skip keywords.
-    TCollection_AsciiString arg(argv[k]);
-    if ( arg.IsRealValue() || arg == "-fair" || arg == "-approx" )
-      continue;
-
-    Handle(asiData_RePatchNode)
-      patchNode = Handle(asiData_RePatchNode)::DownCast( cmdRE::model->FindNodeByName(arg) );
-    //
-    if ( patchNode.IsNull() || !patchNode->IsWellFormed() )
-    {
-      interp->GetProgress().SendLogMessage(LogWarn(Normal) << "Object with name '%1' is not a patch."
-                                                            << arg);
-      continue;
-    }
-    //
-    patchNodes->Append(patchNode);
-  }
-
-  if ( !patchNodes->Length() )
-  {
-    /* Collect all patches */
-
-    for ( Handle(ActAPI_IChildIterator) eit = patchesNode->GetChildIterator(); eit->More(); eit->Next() )
-    {
-      Handle(asiData_RePatchNode)
-        patchNode = Handle(asiData_RePatchNode)::DownCast( eit->Value() );
-      //
-      patchNodes->Append(patchNode);
-    }
-  }
+  // Collect patches of interest.
+  Handle(ActAPI_HNodeList) patchNodes = CollectPatches(interp, argc, argv, patchesNode);
 
   /* ================
    *  Build surfaces
@@ -262,7 +258,51 @@ int RE_BuildPatches(const Handle(asiTcl_Interp)& interp,
       reApi.ReconnectBuildPatchFunc(patchNode);
     }
 
-    cmdRE::model->FuncExecuteAll();
+    // Patches are built concurrently as they only depend on their edges.
+    asiEngine_FuncScheduler( cmdRE::model,
+                             interp->GetProgress(),
+                             interp->GetPlotter() ).ExecuteAll();
+  }
+  cmdRE::model->CommitCommand();
+
+  // Actualize Patch Nodes.
+  for ( ActAPI_HNodeList::Iterator nit(*patchNodes); nit.More(); nit.Next() )
+    cmdRE::cf->ViewerPart->PrsMgr()->Actualize(nit.Value(), false, false, false, false);
+  //
+  cmdRE::cf->ViewerPart->Repaint();
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+int RE_FillPatches(const Handle(asiTcl_Interp)& interp,
+                   int                          argc,
+                   const char**                 argv)
+{
+  // Get a flag indicating if plate surfaces are requested.
+  const bool usePlate = interp->HasKeyword(argc, argv, "plate");
+
+  asiEngine_RE reApi( cmdRE::model,
+                      interp->GetProgress(),
+                      interp->GetPlotter() );
+
+  // Find Patches Node.
+  Handle(asiData_RePatchesNode) patchesNode = reApi.Get_Patches();
+  //
+  if ( patchesNode.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "No patches are available.");
+    return TCL_ERROR;
+  }
+
+  // Collect patches of interest.
+  Handle(ActAPI_HNodeList) patchNodes = CollectPatches(interp, argc, argv, patchesNode);
+
+  // Fill all patches in one transaction.
+  cmdRE::model->OpenCommand();
+  {
+    reApi.FillPatches(patchNodes, usePlate);
   }
   cmdRE::model->CommitCommand();
 
@@ -424,6 +464,73 @@ int RE_BuildContourLines(const Handle(asiTcl_Interp)& interp,
 
 //-----------------------------------------------------------------------------
 
+int RE_ReapproxContours(const Handle(asiTcl_Interp)& interp,
+                        int                          argc,
+                        const char**                 argv)
+{
+  if ( argc < 3 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  // Get contours to re-approximate.
+  Handle(asiData_IVTopoItemNode)
+    topoNode = Handle(asiData_IVTopoItemNode)::DownCast( cmdRE::model->FindNodeByName(argv[2]) );
+  //
+  if ( topoNode.IsNull() || !topoNode->IsWellFormed() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot find topological object with name %1."
+                                                        << argv[2]);
+    return TCL_ERROR;
+  }
+
+  // Get precision and barrier angle.
+  double prec = 1.0, angleDeg = 5.0;
+  TCollection_AsciiString precStr, angleStr;
+  //
+  if ( interp->GetKeyValue(argc, argv, "prec", precStr) )
+    prec = precStr.RealValue();
+  //
+  if ( interp->GetKeyValue(argc, argv, "angle", angleStr) )
+    angleDeg = angleStr.RealValue();
+
+  // Collect wires.
+  std::vector<TopoDS_Shape> contours;
+  //
+  for ( TopExp_Explorer exp(topoNode->GetShape(), TopAbs_WIRE); exp.More(); exp.Next() )
+    contours.push_back( exp.Current() );
+
+  TIMER_NEW
+  TIMER_GO
+
+  // Re-approximate all contours concurrently.
+  std::vector<TopoDS_Wire> wires;
+  const int numDone = asiAlgo_ReapproxContour::PerformBatch(contours, prec, angleDeg,
+                                                            true, false,
+                                                            wires, true,
+                                                            interp->GetProgress() );
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Re-approximate contours")
+
+  interp->GetProgress().SendLogMessage( LogInfo(Normal) << "%1 of %2 contours re-approximated."
+                                                        << numDone << int( contours.size() ) );
+
+  // Collect the resulting wires.
+  TopoDS_Compound result;
+  BRep_Builder().MakeCompound(result);
+  //
+  for ( size_t k = 0; k < wires.size(); ++k )
+    if ( !wires[k].IsNull() )
+      BRep_Builder().Add(result, wires[k]);
+
+  interp->GetPlotter().REDRAW_SHAPE(argv[1], result, Color_Red, 1.0, true);
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
 int RE_FairContourLines(const Handle(asiTcl_Interp)& interp,
                         int                          argc,
                         const char**                 argv)
@@ -466,7 +573,9 @@ int RE_FairContourLines(const Handle(asiTcl_Interp)& interp,
     }
 
     // Execute deps.
-    M->FuncExecuteAll();
+    asiEngine_FuncScheduler( M,
+                             interp->GetProgress(),
+                             interp->GetPlotter() ).ExecuteAll();
   }
   M->CommitCommand();
 
@@ -491,13 +600,32 @@ int RE_CutWithPlane(const Handle(asiTcl_Interp)& interp,
                     int                          argc,
                     const char**                 argv)
 {
-  if ( argc != 3 && argc != 4 )
+  if ( argc < 3 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
   }
 
   const bool doSort = !interp->HasKeyword(argc, argv, "nosort");
 
+  // Stack of parallel planes.
+  int    numPlanes = 1;
+  double step      = 0.;
+  //
+  interp->GetKeyValue(argc, argv, "num",  numPlanes);
+  interp->GetKeyValue(argc, argv, "step", step);
+  //
+  if ( numPlanes < 1 )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Number of planes should be positive.");
+    return TCL_ERROR;
+  }
+  //
+  if ( numPlanes > 1 && step <= 0. )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Step between planes should be positive.");
+    return TCL_ERROR;
+  }
+
   // Get Triangulaion.
   Handle(asiData_TriangulationNode) tris_n = cmdRE::model->GetTriangulationNode();
   //
@@ -536,7 +664,21 @@ int RE_CutWithPlane(const Handle(asiTcl_Interp)& interp,
                                interp->GetProgress(),
                                interp->GetPlotter() );
   //
-  if ( !algo.Perform(occtPlane, true) )
+  bool isDone;
+  //
+  if ( numPlanes > 1 )
+  {
+    std::vector<double> levels;
+    //
+    for ( int k = 0; k < numPlanes; ++k )
+      levels.push_back(k*step);
+
+    isDone = algo.Perform(occtPlane->Position(), levels, doSort);
+  }
+  else
+    isDone = algo.Perform(occtPlane, doSort);
+  //
+  if ( !isDone )
   {
     interp->GetProgress().SendLogMessage(LogErr(Normal) << "Failed to cut mesh with t_plane.");
     return TCL_ERROR;
@@ -546,6 +688,124 @@ int RE_CutWithPlane(const Handle(asiTcl_Interp)& interp,
   interp->GetPlotter().REDRAW_POINTS(argv[1], algo.GetResult()->GetCoordsArray(),
                                      doSort ? Color_Green : Color_Red);
 
+  // Draw the ordered polylines.
+  if ( doSort )
+  {
+    const std::vector<asiAlgo_MeshInterPlane::t_section>& sections = algo.GetSections();
+    //
+    int loopIdx = 0;
+    //
+    for ( size_t k = 0; k < sections.size(); ++k )
+    {
+      for ( size_t l = 0; l < sections[k].size(); ++l )
+      {
+        std::vector<gp_XYZ> pts = sections[k][l].Pts;
+        //
+        if ( sections[k][l].IsClosed && !pts.empty() )
+          pts.push_back( pts.front() );
+
+        TCollection_AsciiString name(argv[1]);
+        name += "_loop_";
+        name += ++loopIdx;
+        //
+        interp->GetPlotter().REDRAW_POLYLINE(name, pts, Color_Yellow);
+      }
+    }
+  }
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+int RE_ConcaveHull(const Handle(asiTcl_Interp)& interp,
+                   int                          argc,
+                   const char**                 argv)
+{
+  if ( argc < 4 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  // Find Points Node by name.
+  Handle(asiData_IVPointSetNode)
+    pointsNode = Handle(asiData_IVPointSetNode)::DownCast( interp->GetModel()->FindNodeByName(argv[2]) );
+  //
+  if ( pointsNode.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Node '%1' is not a point cloud."
+                                                        << argv[2]);
+    return TCL_ERROR;
+  }
+
+  // Find plane to project the points on.
+  Handle(asiData_IVSurfaceNode)
+    surfaceNode = Handle(asiData_IVSurfaceNode)::DownCast( interp->GetModel()->FindNodeByName(argv[3]) );
+  //
+  Handle(Geom_Plane) plane;
+  //
+  if ( !surfaceNode.IsNull() )
+    plane = Handle(Geom_Plane)::DownCast( surfaceNode->GetSurface() );
+  //
+  if ( plane.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Node '%1' is not a plane."
+                                                        << argv[3]);
+    return TCL_ERROR;
+  }
+
+  // Get number of neighbors to start with.
+  int k = 5;
+  interp->GetKeyValue(argc, argv, "k", k);
+  //
+  if ( k < 3 )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Number of neighbors should be at least 3.");
+    return TCL_ERROR;
+  }
+
+  // Project points on plane.
+  Handle(asiAlgo_BaseCloud<double>)         pts   = pointsNode->GetPoints();
+  Handle(asiAlgo_PointWithAttrCloud<gp_XY>) cloud = new asiAlgo_PointWithAttrCloud<gp_XY>;
+  ShapeAnalysis_Surface                     sas(plane);
+  //
+  for ( int i = 0; i < pts->GetNumberOfElements(); ++i )
+  {
+    gp_XY P = sas.ValueOfUV(gp_Pnt( pts->GetElement(i) ), 1.0e-4).XY();
+    //
+    cloud->AddElement( asiAlgo_PointWithAttr<gp_XY>(P, 0, i) );
+  }
+
+  TIMER_NEW
+  TIMER_GO
+
+  // Build K-neighbors hull.
+  asiAlgo_KHull2d<gp_XY> kHull( cloud, k, 0, interp->GetProgress(), interp->GetPlotter() );
+  //
+  if ( !kHull.Perform() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "K-hull failed.");
+    return TCL_ERROR;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Build K-neighbors hull")
+
+  // Draw the hull through the original points.
+  const Handle(asiAlgo_PointWithAttrCloud<gp_XY>)& hull = kHull.GetHull();
+  //
+  std::vector<gp_XYZ> hullPts;
+  //
+  for ( int i = 0; i < hull->GetNumberOfElements(); ++i )
+    hullPts.push_back( pts->GetElement( hull->GetElement(i).Index ) );
+  //
+  if ( !hullPts.empty() )
+    hullPts.push_back( hullPts.front() );
+
+  interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Concave hull with %1 points built for k = %2."
+                                                        << hull->GetNumberOfElements() << kHull.GetK() );
+
+  interp->GetPlotter().REDRAW_POLYLINE(argv[1], hullPts, Color_Yellow);
   return TCL_OK;
 }
 
@@ -1102,11 +1362,62 @@ int RE_CheckSurfDeviation(const Handle(asiTcl_Interp)& interp,
 
 //-----------------------------------------------------------------------------
 
+namespace
+{
+  //! Sets up the histogram of deviations from the `-bins <num> <min> <max>`
+  //! option of the deviation check commands.
+  void SetDeviationHistogram(const Handle(asiTcl_Interp)& interp,
+                             int                          argc,
+                             const char**                 argv,
+                             asiAlgo_CheckDeviations&     checkDeviations)
+  {
+    int binsIdx = 0;
+    //
+    if ( interp->HasKeyword(argc, argv, "bins", binsIdx) && binsIdx + 3 < argc )
+      checkDeviations.SetHistogram( atoi(argv[binsIdx + 1]),
+                                    Atof(argv[binsIdx + 2]),
+                                    Atof(argv[binsIdx + 3]) );
+  }
+
+  //! Dumps the statistics of deviations collected without the distance field.
+  void PrintDeviationStats(const Handle(asiTcl_Interp)&  interp,
+                           const asiAlgo_DeviationStats& stats)
+  {
+    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Number of points: %1."
+                                                          << stats.GetCount() );
+    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Min/max deviation: %1/%2."
+                                                          << stats.GetMin()
+                                                          << stats.GetMax() );
+    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Mean/RMS/std deviation: %1/%2/%3."
+                                                          << stats.GetMean()
+                                                          << stats.GetRMS()
+                                                          << stats.GetStdDev() );
+    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Percentiles 1/5/50/95/99: %1/%2/%3/%4/%5."
+                                                          << stats.GetPercentile(1.)
+                                                          << stats.GetPercentile(5.)
+                                                          << stats.GetPercentile(50.)
+                                                          << stats.GetPercentile(95.)
+                                                          << stats.GetPercentile(99.) );
+
+    std::vector<double> edges;
+    std::vector<int>    counts;
+    stats.GetHistogram(10, edges, counts);
+    //
+    for ( size_t b = 0; b < counts.size(); ++b )
+      interp->GetProgress().SendLogMessage( LogInfo(Normal) << "\t[%1, %2): %3"
+                                                            << edges[b]
+                                                            << edges[b + 1]
+                                                            << counts[b] );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
 int RE_CheckDeviation(const Handle(asiTcl_Interp)& interp,
                       int                          argc,
                       const char**                 argv)
 {
-  if ( argc != 2 )
+  if ( argc < 2 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
   }
@@ -1133,6 +1444,26 @@ int RE_CheckDeviation(const Handle(asiTcl_Interp)& interp,
     return TCL_ERROR;
   }
 
+  // Collect statistics only without creating the Deviation Node.
+  if ( interp->HasKeyword(argc, argv, "stats") )
+  {
+    asiAlgo_CheckDeviations checkDeviations( pointsNode->GetPoints(),
+                                             interp->GetProgress(),
+                                             interp->GetPlotter() );
+    //
+    checkDeviations.SetComputeField(false);
+    SetDeviationHistogram(interp, argc, argv, checkDeviations);
+    //
+    if ( !checkDeviations.Perform( partNode->GetShape() ) )
+    {
+      interp->GetProgress().SendLogMessage(LogErr(Normal) << "Failed to check deviations.");
+      return TCL_ERROR;
+    }
+
+    PrintDeviationStats( interp, checkDeviations.GetStats() );
+    return TCL_OK;
+  }
+
   Handle(asiData_DeviationNode) devNode;
 
   // Check deviations.
@@ -1170,7 +1501,7 @@ int RE_CheckTriDeviation(const Handle(asiTcl_Interp)& interp,
                          int                          argc,
                          const char**                 argv)
 {
-  if ( argc != 2 )
+  if ( argc < 2 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
   }
@@ -1197,6 +1528,26 @@ int RE_CheckTriDeviation(const Handle(asiTcl_Interp)& interp,
     return TCL_ERROR;
   }
 
+  // Collect statistics only without creating the Deviation Node.
+  if ( interp->HasKeyword(argc, argv, "stats") )
+  {
+    asiAlgo_CheckDeviations checkDeviations( pointsNode->GetPoints(),
+                                             interp->GetProgress(),
+                                             interp->GetPlotter() );
+    //
+    checkDeviations.SetComputeField(false);
+    SetDeviationHistogram(interp, argc, argv, checkDeviations);
+    //
+    if ( !checkDeviations.Perform( trisNode->GetTriangulation() ) )
+    {
+      interp->GetProgress().SendLogMessage(LogErr(Normal) << "Failed to check deviations.");
+      return TCL_ERROR;
+    }
+
+    PrintDeviationStats( interp, checkDeviations.GetStats() );
+    return TCL_OK;
+  }
+
   Handle(asiData_DeviationNode) devNode;
 
   // Check deviations.
@@ -1340,7 +1691,7 @@ int RE_SamplePart(const Handle(asiTcl_Interp)& interp,
                   int                          argc,
                   const char**                 argv)
 {
-  if ( argc != 4 && argc != 5 && argc != 6 )
+  if ( argc < 4 || argc > 8 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
   }
@@ -1363,14 +1714,20 @@ int RE_SamplePart(const Handle(asiTcl_Interp)& interp,
   // Whether to take vertices as points.
   const bool useVertices = interp->HasKeyword(argc, argv, "vertices");
 
+  // Binary PLY file to stream the samples to.
+  TCollection_AsciiString outFilename;
+  interp->GetKeyValue(argc, argv, "out", outFilename);
+
   // Cloudify shape.
   Handle(asiAlgo_BaseCloud<double>) sampledPts;
   //
   if ( !useVertices )
   {
-    asiAlgo_Cloudify cloudify( std::min( atof(argv[2]), atof(argv[3]) ) );
+    asiAlgo_Cloudify cloudify( std::min( atof(argv[2]), atof(argv[3]) ),
+                               interp->GetProgress(), interp->GetPlotter() );
     //
     cloudify.SetParametricSteps( atof(argv[2]), atof(argv[3]) );
+    cloudify.SetOutputFilename(outFilename);
     //
     if ( (  onFacets && !cloudify.Sample_Facets (shape, sampledPts) ) ||
          ( !onFacets && !cloudify.Sample_Faces  (shape, sampledPts) ) )
@@ -1378,6 +1735,10 @@ int RE_SamplePart(const Handle(asiTcl_Interp)& interp,
       interp->GetProgress().SendLogMessage( LogErr(Normal) << "Cannot sample shape." );
       return TCL_ERROR;
     }
+
+    // The samples are not kept in memory if they are streamed to file.
+    if ( !outFilename.IsEmpty() )
+      return TCL_OK;
   }
   else
   {
@@ -1583,12 +1944,386 @@ int RE_PurifyCloud(const Handle(asiTcl_Interp)& interp,
 
 //-----------------------------------------------------------------------------
 
-int RE_ApproxSurf(const Handle(asiTcl_Interp)& interp,
-                  int                          argc,
-                  const char**                 argv)
+int RE_PurifyTiledCloud(const Handle(asiTcl_Interp)& interp,
+                        int                          argc,
+                        const char**                 argv)
 {
-#if defined USE_MOBIUS
-  if (argc != 7 && argc != 8 )
+  if ( argc != 4 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  Handle(asiAlgo_TiledCloud) tiles = new asiAlgo_TiledCloud;
+  //
+  if ( !tiles->Open(argv[2]) )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot open tiled point cloud '%1'."
+                                                        << argv[2]);
+    return TCL_ERROR;
+  }
+
+  asiAlgo_PurifyCloud purify( interp->GetProgress(), interp->GetPlotter() );
+  //
+  if ( !purify.Perform3d(atof(argv[3]), tiles, argv[1]) )
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+int RE_BenchTiledCloud(const Handle(asiTcl_Interp)& interp,
+                       int                          argc,
+                       const char**                 argv)
+{
+  if ( argc < 2 || argc > 8 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  const std::string filename(argv[1]);
+
+  // Get parameters.
+  int64_t                 numPts = 1000000;
+  int                     depth  = 6;
+  double                  tol    = 0.01;
+  TCollection_AsciiString numStr, depthStr, tolStr;
+  //
+  if ( interp->GetKeyValue(argc, argv, "n", numStr) )
+    numPts = int64_t( numStr.RealValue() );
+  //
+  if ( interp->GetKeyValue(argc, argv, "depth", depthStr) )
+    depth = depthStr.IntegerValue();
+  //
+  if ( interp->GetKeyValue(argc, argv, "tol", tolStr) )
+    tol = tolStr.RealValue();
+
+  // Write a synthetic terrain scan of 1000 x 1000 with a 0.1 wave.
+  {
+    TIMER_NEW
+    TIMER_GO
+
+    asiAlgo_TiledCloudWriter writer(filename);
+    //
+    if ( !writer.Begin(0., 1000., 0., 1000., -1., 1., depth) )
+    {
+      interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot write file '%1'." << argv[1]);
+      return TCL_ERROR;
+    }
+
+    std::mt19937_64                        gen(1);
+    std::uniform_real_distribution<double> uniform(0., 1000.);
+    //
+    for ( int64_t i = 0; i < numPts; ++i )
+    {
+      const double x = uniform(gen);
+      const double y = uniform(gen);
+      //
+      if ( !writer.Add( x, y, 0.1*std::sin(x)*std::cos(y) ) )
+      {
+        interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot write file '%1'." << argv[1]);
+        return TCL_ERROR;
+      }
+    }
+    //
+    if ( !writer.End() )
+    {
+      interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot write file '%1'." << argv[1]);
+      return TCL_ERROR;
+    }
+
+    TIMER_FINISH
+    TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Write tiled cloud")
+  }
+
+  Handle(asiAlgo_TiledCloud) tiles = new asiAlgo_TiledCloud;
+  //
+  if ( !tiles->Open(filename) )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Cannot open tiled point cloud '%1'."
+                                                        << argv[1]);
+    return TCL_ERROR;
+  }
+
+  // Stream all tiles through the cache.
+  {
+    TIMER_NEW
+    TIMER_GO
+
+    double zMin = DBL_MAX, zMax = -DBL_MAX;
+    //
+    for ( asiAlgo_TiledCloud::Iterator it(tiles); it.More(); it.Next() )
+    {
+      const std::vector<double>& coords = it.Value()->GetCoords();
+      //
+      for ( size_t i = 2; i < coords.size(); i += 3 )
+      {
+        zMin = std::min(zMin, coords[i]);
+        zMax = std::max(zMax, coords[i]);
+      }
+    }
+
+    TIMER_FINISH
+    TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Iterate tiled cloud")
+
+    interp->GetProgress().SendLogMessage( LogInfo(Normal) << "%1 point(s) in %2 tile(s), Z range [%3, %4]."
+                                                          << std::to_string( tiles->GetNumPoints() ).c_str()
+                                                          << tiles->GetNumTiles() << zMin << zMax );
+  }
+
+  // Purify.
+  asiAlgo_PurifyCloud purify( interp->GetProgress(), interp->GetPlotter() );
+  //
+  if ( !purify.Perform3d(tol, tiles, filename + ".purified") )
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+  //! Runs the bulk kernels over a random cloud of the given type.
+  template <typename T>
+  void BenchCloudKernels(const Handle(asiTcl_Interp)& interp,
+                         const int                    numPts)
+  {
+    std::mt19937                      gen(1);
+    std::uniform_real_distribution<T> uniform(T(-100), T(100));
+    //
+    Handle(asiAlgo_BaseCloud<T>) cloud = new asiAlgo_BaseCloud<T>;
+    cloud->Reserve(numPts);
+    //
+    std::vector<T>& coords = cloud->ChangeCoords();
+    for ( size_t i = 0; i < coords.size(); ++i )
+      coords[i] = uniform(gen);
+
+    {
+      TIMER_NEW
+      TIMER_GO
+
+      T xMin, xMax, yMin, yMax, zMin, zMax;
+      cloud->ComputeBoundingBox(xMin, xMax, yMin, yMax, zMin, zMax);
+
+      TIMER_FINISH
+      TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Bounding box")
+    }
+
+    {
+      TIMER_NEW
+      TIMER_GO
+
+      gp_Ax3 axes;
+      cloud->ComputeInertiaAxes(axes);
+
+      TIMER_FINISH
+      TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Inertia axes")
+    }
+
+    {
+      TIMER_NEW
+      TIMER_GO
+
+      gp_Trsf trsf;
+      trsf.SetRotation(gp::OZ(), 0.1);
+      trsf.SetTranslationPart( gp_Vec(1., 2., 3.) );
+      //
+      cloud->Transform(trsf);
+
+      TIMER_FINISH
+      TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Transform")
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+int RE_BenchCloudKernels(const Handle(asiTcl_Interp)& interp,
+                         int                          argc,
+                         const char**                 argv)
+{
+  if ( argc != 1 && argc != 3 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  int                     numPts = 10000000;
+  TCollection_AsciiString numStr;
+  //
+  if ( interp->GetKeyValue(argc, argv, "n", numStr) )
+    numPts = numStr.IntegerValue();
+
+  interp->GetProgress().SendLogMessage( LogInfo(Normal) << "Running kernels (%1) over %2 point(s)."
+                                                        << asiAlgo_CloudKernels::GetInstructionSet()
+                                                        << numPts );
+
+  interp->GetProgress().SendLogMessage(LogInfo(Normal) << "Single precision:");
+  BenchCloudKernels<float>(interp, numPts);
+
+  interp->GetProgress().SendLogMessage(LogInfo(Normal) << "Double precision:");
+  BenchCloudKernels<double>(interp, numPts);
+
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+int RE_OrientNormals(const Handle(asiTcl_Interp)& interp,
+                     int                          argc,
+                     const char**                 argv)
+{
+  if ( argc < 4 || argc > 8 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  // Find Points Nodes by names.
+  Handle(asiData_IVPointSetNode)
+    pointsNode = Handle(asiData_IVPointSetNode)::DownCast( interp->GetModel()->FindNodeByName(argv[2]) );
+  //
+  Handle(asiData_IVPointSetNode)
+    normsNode = Handle(asiData_IVPointSetNode)::DownCast( interp->GetModel()->FindNodeByName(argv[3]) );
+  //
+  if ( pointsNode.IsNull() || normsNode.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Node '%1' or '%2' is not a point cloud."
+                                                        << argv[2] << argv[3]);
+    return TCL_ERROR;
+  }
+
+  // Get the reference index.
+  int refIdx = 0;
+  TCollection_AsciiString refStr;
+  //
+  if ( interp->GetKeyValue(argc, argv, "ref", refStr) )
+    refIdx = refStr.IntegerValue();
+
+  // Get the number of neighbors.
+  int k = 8;
+  TCollection_AsciiString kStr;
+  //
+  if ( interp->GetKeyValue(argc, argv, "k", kStr) )
+    k = kStr.IntegerValue();
+
+  // Get point cloud and normal field.
+  Handle(asiAlgo_BaseCloud<double>) pts   = pointsNode->GetPoints();
+  Handle(asiAlgo_BaseCloud<float>)  norms = asiAlgo_PointCloudUtils::AsCloudf( normsNode->GetPoints()->GetCoordsArray() );
+  Handle(asiAlgo_BaseCloud<float>)  res;
+
+  // Orient normals.
+  asiAlgo_ReorientNorms orient( interp->GetProgress(), interp->GetPlotter() );
+  orient.SetNumNeighbors(k);
+  //
+  if ( !orient.Perform(pts, norms, refIdx, res) )
+    return TCL_ERROR;
+
+  // Set the result.
+  interp->GetPlotter().REDRAW_POINTS(argv[1], asiAlgo_PointCloudUtils::AsRealArray(res), Color_Default);
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+int RE_DetectPrimitives(const Handle(asiTcl_Interp)& interp,
+                        int                          argc,
+                        const char**                 argv)
+{
+  if ( argc < 3 || argc > 13 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  // Find Points Node by name.
+  Handle(asiData_IVPointSetNode)
+    pointsNode = Handle(asiData_IVPointSetNode)::DownCast( interp->GetModel()->FindNodeByName(argv[2]) );
+  //
+  if ( pointsNode.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Node '%1' is not a point cloud."
+                                                        << argv[2]);
+    return TCL_ERROR;
+  }
+
+  asiAlgo_DetectPrimitives detect( interp->GetProgress(), interp->GetPlotter() );
+
+  // Get tolerances.
+  TCollection_AsciiString tolStr, angStr, minStr;
+  //
+  if ( interp->GetKeyValue(argc, argv, "eps", tolStr) )
+    detect.SetTolerance( tolStr.RealValue() );
+  //
+  if ( interp->GetKeyValue(argc, argv, "ang", angStr) )
+    detect.SetAngularTolerance( angStr.RealValue() );
+  //
+  if ( interp->GetKeyValue(argc, argv, "min", minStr) )
+    detect.SetMinPoints( minStr.IntegerValue() );
+
+  // Get types of primitives.
+  int types = 0;
+  //
+  if ( interp->HasKeyword(argc, argv, "plane") )    types |= Primitive_Plane;
+  if ( interp->HasKeyword(argc, argv, "sphere") )   types |= Primitive_Sphere;
+  if ( interp->HasKeyword(argc, argv, "cylinder") ) types |= Primitive_Cylinder;
+  if ( interp->HasKeyword(argc, argv, "cone") )     types |= Primitive_Cone;
+  //
+  detect.SetTypes(types ? types : Primitive_All);
+
+  // Detect primitives.
+  Handle(asiAlgo_BaseCloud<double>) pts = pointsNode->GetPoints();
+  //
+  if ( !detect.Perform(pts) )
+    return TCL_ERROR;
+
+  // Set the results.
+  Handle(asiUI_IV) IV = Handle(asiUI_IV)::DownCast( interp->GetPlotter().Access() );
+  //
+  const std::vector<asiAlgo_DetectPrimitives::t_primitive>& prims = detect.GetPrimitives();
+  //
+  for ( size_t i = 0; i < prims.size(); ++i )
+  {
+    TCollection_AsciiString name(argv[1]);
+    name += "_";
+    name += int(i + 1);
+
+    Handle(asiAlgo_BaseCloud<double>)
+      primPts = pts->ExtractRegion( asiAlgo_CloudRegion(prims[i].Indices) );
+    //
+    interp->GetPlotter().REDRAW_POINTS(name + "_pts", primPts->GetCoordsArray(), Color_Default);
+
+    if ( IV.IsNull() )
+      continue;
+
+    IV->REDRAW_SURFACE(name, prims[i].Surface, Color_Default);
+
+    // Trim the surface by the inliers.
+    Handle(asiData_IVSurfaceNode)
+      ivSurf = Handle(asiData_IVSurfaceNode)::DownCast( IV->GetLastNode() );
+    //
+    if ( !ivSurf.IsNull() )
+    {
+      cmdRE::model->OpenCommand();
+      {
+        ivSurf->SetLimits(prims[i].UMin, prims[i].UMax, prims[i].VMin, prims[i].VMax);
+      }
+      cmdRE::model->CommitCommand();
+    }
+  }
+
+  // Unassigned points.
+  interp->GetPlotter().REDRAW_POINTS(TCollection_AsciiString(argv[1]) + "_rest",
+                                     pts->ExtractRegion( asiAlgo_CloudRegion( detect.GetUnassigned() ) )->GetCoordsArray(),
+                                     Color_Default);
+  return TCL_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+int RE_ApproxSurf(const Handle(asiTcl_Interp)& interp,
+                  int                          argc,
+                  const char**                 argv)
+{
+  if ( argc < 5 )
   {
     return interp->ErrorOnWrongArgs(argv[0]);
   }
@@ -1611,29 +2346,35 @@ int RE_ApproxSurf(const Handle(asiTcl_Interp)& interp,
   if ( interp->GetKeyValue(argc, argv, "lambda", lambdaStr) )
     lambda = lambdaStr.RealValue();
 
-  // Has init surf.
-  const bool hasInitSurf = interp->HasKeyword(argc, argv, "init");
-
   // Get point cloud.
   Handle(asiAlgo_BaseCloud<double>) pts = pointsNode->GetPoints();
 
-  // Convert to Mobius point cloud.
-  t_ptr<t_pcloud> mobPts = new t_pcloud;
+  // Prepare approximation tool.
+  asiAlgo_ApproxBSurf approx( pts, interp->GetProgress(), interp->GetPlotter() );
+
+  TCollection_AsciiString initSurfName;
   //
-  for ( int k = 0; k < pts->GetNumberOfElements(); ++k )
-    mobPts->AddPoint( cascade::GetMobiusPnt( pts->GetElement(k) ) );
+  if ( !interp->GetKeyValue(argc, argv, "init", initSurfName) )
+  {
+    const int uDegree = atoi(argv[3]);
+    const int vDegree = atoi(argv[4]);
 
-  t_ptr<t_bsurf> resSurf;
+    // Get the numbers of poles. Bezier surface is built by default.
+    int numPolesU = uDegree + 1;
+    int numPolesV = vDegree + 1;
+    int polesIdx  = 0;
+    //
+    if ( interp->HasKeyword(argc, argv, "poles", polesIdx) && polesIdx + 2 < argc )
+    {
+      numPolesU = atoi(argv[polesIdx + 1]);
+      numPolesV = atoi(argv[polesIdx + 2]);
+    }
 
-  if ( !hasInitSurf )
-  {
     TIMER_NEW
     TIMER_GO
 
     // Approximate.
-    geom_ApproxBSurf approx( mobPts, atoi(argv[3]), atoi(argv[4]) );
-    //
-    if ( !approx.Perform(lambda) )
+    if ( !approx.Perform(uDegree, vDegree, numPolesU, numPolesV, lambda) )
     {
       interp->GetProgress().SendLogMessage(LogErr(Normal) << "Approximation failed.");
       return TCL_ERROR;
@@ -1641,66 +2382,54 @@ int RE_ApproxSurf(const Handle(asiTcl_Interp)& interp,
 
     TIMER_FINISH
     TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Approximate (passed degrees)")
-
-    // Get result.
-    resSurf = approx.GetResult();
   }
   else /* Initial surface is specified */
   {
     // Find Surface Node by name.
     Handle(asiData_IVSurfaceNode)
-      surfNode = Handle(asiData_IVSurfaceNode)::DownCast( interp->GetModel()->FindNodeByName(argv[4]) );
+      surfNode = Handle(asiData_IVSurfaceNode)::DownCast( interp->GetModel()->FindNodeByName(initSurfName) );
     //
     if ( surfNode.IsNull() )
     {
       interp->GetProgress().SendLogMessage(LogErr(Normal) << "Node '%1' is not a surface."
-                                                          << argv[4]);
+                                                          << initSurfName);
       return TCL_ERROR;
     }
 
     // Get surface.
     Handle(Geom_BSplineSurface)
-      bsurfOcc = Handle(Geom_BSplineSurface)::DownCast( surfNode->GetSurface() );
+      initSurf = Handle(Geom_BSplineSurface)::DownCast( surfNode->GetSurface() );
     //
-    if ( bsurfOcc.IsNull() )
+    if ( initSurf.IsNull() )
     {
       interp->GetProgress().SendLogMessage(LogErr(Normal) << "The passed surface is not a B-surface.");
       return TCL_ERROR;
     }
 
-    // Check if the boundary is requested to be constrained.
-    const bool isPinned = interp->HasKeyword(argc, argv, "pinned");
-
-    // Convert to Mobius form.
-    t_ptr<t_bsurf> initSurf = cascade::GetMobiusBSurface(bsurfOcc);
-
-    TIMER_NEW
-    TIMER_GO
-
-    // Prepare approximation tool.
-    geom_ApproxBSurf approx(mobPts, initSurf);
-
-    // Constraint the boundary.
-    if ( isPinned )
+    // Constrain the boundary.
+    if ( interp->HasKeyword(argc, argv, "pinned") )
     {
-      const int nPolesU = int( initSurf->GetPoles().size() );
-      const int nPolesV = int( initSurf->GetPoles()[0].size() );
+      const int nPolesU = initSurf->NbUPoles();
+      const int nPolesV = initSurf->NbVPoles();
       //
-      for ( int i = 0; i < nPolesU; ++i )
+      for ( int i = 1; i <= nPolesU; ++i )
       {
-        approx.AddPinnedPole( i, 0 );
-        approx.AddPinnedPole( i, nPolesV - 1 );
+        approx.AddPinnedPole( i, 1 );
+        approx.AddPinnedPole( i, nPolesV );
       }
       //
-      for ( int j = 0; j < nPolesV; ++j )
+      for ( int j = 1; j <= nPolesV; ++j )
       {
-        approx.AddPinnedPole( 0, j );
-        approx.AddPinnedPole( nPolesU - 1, j );
+        approx.AddPinnedPole( 1, j );
+        approx.AddPinnedPole( nPolesU, j );
       }
     }
 
+    TIMER_NEW
+    TIMER_GO
+
     // Approximate.
-    if ( !approx.Perform(lambda) )
+    if ( !approx.Perform(initSurf, lambda) )
     {
       interp->GetProgress().SendLogMessage(LogErr(Normal) << "Approximation failed.");
       return TCL_ERROR;
@@ -1708,21 +2437,74 @@ int RE_ApproxSurf(const Handle(asiTcl_Interp)& interp,
 
     TIMER_FINISH
     TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Approximate (passed initial surface)")
-
-    // Get result.
-    resSurf = approx.GetResult();
   }
 
   // Set the result.
-  interp->GetPlotter().REDRAW_SURFACE(argv[1], cascade::GetOpenCascadeBSurface(resSurf), Color_Default);
+  interp->GetPlotter().REDRAW_SURFACE(argv[1], approx.GetResult(), Color_Default);
   return TCL_OK;
-#else
-  cmdRE_NotUsed(argc);
-  cmdRE_NotUsed(argv);
+}
 
-  interp->GetProgress().SendLogMessage(LogErr(Normal) << "Mobius is not available.");
-  return TCL_ERROR;
-#endif
+//-----------------------------------------------------------------------------
+
+int RE_PlatePoints(const Handle(asiTcl_Interp)& interp,
+                   int                          argc,
+                   const char**                 argv)
+{
+  if ( argc < 3 )
+  {
+    return interp->ErrorOnWrongArgs(argv[0]);
+  }
+
+  // Find Points Node by name.
+  Handle(asiData_IVPointSetNode)
+    pointsNode = Handle(asiData_IVPointSetNode)::DownCast( interp->GetModel()->FindNodeByName(argv[2]) );
+  //
+  if ( pointsNode.IsNull() )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Node '%1' is not a point cloud."
+                                                        << argv[2]);
+    return TCL_ERROR;
+  }
+
+  // Get the max number of points to plate.
+  int maxPlatePts = 0;
+  interp->GetKeyValue(argc, argv, "maxplatepts", maxPlatePts);
+  //
+  if ( maxPlatePts < 0 )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Max number of points to plate should not be negative.");
+    return TCL_ERROR;
+  }
+
+  // Get point cloud.
+  Handle(asiAlgo_BaseCloud<double>) cloud = pointsNode->GetPoints();
+  //
+  std::vector<gp_XYZ> pts;
+  //
+  for ( int i = 0; i < cloud->GetNumberOfElements(); ++i )
+    pts.push_back( cloud->GetElement(i) );
+
+  TIMER_NEW
+  TIMER_GO
+
+  // Build plate.
+  asiAlgo_PlateOnPoints plate( interp->GetProgress(), interp->GetPlotter() );
+  plate.SetMaxNumPlatePoints(maxPlatePts);
+  //
+  Handle(Geom_BSplineSurface) surf;
+  //
+  if ( !plate.Perform(pts, surf) )
+  {
+    interp->GetProgress().SendLogMessage(LogErr(Normal) << "Plating failed.");
+    return TCL_ERROR;
+  }
+
+  TIMER_FINISH
+  TIMER_COUT_RESULT_NOTIFIER(interp->GetProgress(), "Plate on points")
+
+  // Set the result.
+  interp->GetPlotter().REDRAW_SURFACE(argv[1], surf, Color_Default);
+  return TCL_OK;
 }
 
 //-----------------------------------------------------------------------------
@@ -1897,157 +2679,63 @@ int RE_Topologize(const Handle(asiTcl_Interp)& interp,
   }
   cmdRE::model->CommitCommand(); // tx commit
 
-  // All edges.
-  Handle(ActAPI_HNodeList) edgesList = new ActAPI_HNodeList;
-
-  // Build BVH for CAD-agnostic mesh.
-  Handle(asiAlgo_BVHFacets) bvh;
-  //
-  asiEngine_RE            reApi   ( cmdRE::model, interp->GetProgress(), interp->GetPlotter() );
-  asiEngine_Triangulation trisApi ( cmdRE::model, interp->GetProgress(), interp->GetPlotter() );
+  // Collect the quads with their nodes.
+  std::vector<gp_XYZ>           nodes;
+  std::vector<int>              quads;
+  NCollection_DataMap<int, int> nodeIndices;
   //
-  cmdRE::model->OpenCommand();
+  for ( ActData_Mesh_ElementsIterator it(mesh, ActData_Mesh_ET_Face); it.More(); it.Next() )
   {
-    bvh = trisApi.BuildBVH();
-
-    // Tool to project points on mesh.
-    asiAlgo_ProjectPointOnMesh pointToMesh(bvh);
-
-    // Constructed topological primitives.
-    NCollection_DataMap<int, Handle(asiData_ReVertexNode)>                              vertices;
-    NCollection_DataMap<t_undirectedLink, Handle(asiData_ReEdgeNode), t_undirectedLink> edges;
+    // Get next quad.
+    const Handle(ActData_Mesh_Element)& elem = it.GetValue();
+    //
+    if ( !elem->IsKind( STANDARD_TYPE(ActData_Mesh_Quadrangle) ) )
+      continue;
 
-    // Initialize progress indicator.
-    interp->GetProgress().Init( mesh->NbFaces() );
-    interp->GetProgress().SetMessageKey("Process quads");
+    const Handle(ActData_Mesh_Quadrangle)&
+      quad = Handle(ActData_Mesh_Quadrangle)::DownCast(elem);
 
-    // Iterate over the quads.
-    int patchIdx = 0, edgeIdx = 0, vertexIdx = 0;
-    for ( ActData_Mesh_ElementsIterator it(mesh, ActData_Mesh_ET_Face); it.More(); it.Next() )
+    // Get nodes.
+    int* nodeIDs = (int*) quad->GetConnections();
+    //
+    for ( int k = 0; k < 4; ++k )
     {
-      interp->GetProgress().StepProgress(1);
-
-      // Get next quad.
-      const Handle(ActData_Mesh_Element)& elem = it.GetValue();
+      const int n = nodeIDs[k];
       //
-      if ( !elem->IsKind( STANDARD_TYPE(ActData_Mesh_Quadrangle) ) )
-        continue;
-
-      const Handle(ActData_Mesh_Quadrangle)&
-        quad = Handle(ActData_Mesh_Quadrangle)::DownCast(elem);
-
-      ++patchIdx;
-      TCollection_ExtendedString patchName("Patch "); patchName += patchIdx;
-
-      // Create patch.
-      Handle(asiData_RePatchNode) patch = reApi.Create_Patch(patchName);
-
-      // Get nodes.
-      int* nodeIDs = (int*) quad->GetConnections();
-
-      // Create vertices.
-      std::vector<Handle(asiData_ReVertexNode)> quadVertices;
-      std::vector<int>                          quadVerticesIds;
-      //
-      for ( int k = 0; k < 4; ++k )
+      if ( !nodeIndices.IsBound(n) )
       {
-        const int n = nodeIDs[k];
+        nodeIndices.Bind( n, int( nodes.size() ) );
+        nodes.push_back( mesh->FindNode(n)->Pnt().XYZ() );
+      }
 
-        if ( !vertices.IsBound(n) )
-        {
-          const gp_Pnt& node         = mesh->FindNode(n)->Pnt();
-          gp_Pnt        nodeProj     = pointToMesh.Perform(node);
-          int           nodeFacetInd = pointToMesh.GetFacetIds().size() ? pointToMesh.GetFacetIds()[0] : -1;
-          //
-          if ( nodeFacetInd == -1 )
-          {
-            interp->GetProgress().SendLogMessage(LogErr(Normal) << "Failed to project network node.");
-            continue;
-          }
-
-          ++vertexIdx;
-          TCollection_ExtendedString vertexName("Vertex "); vertexName += vertexIdx;
-
-          // Create vertex.
-          Handle(asiData_ReVertexNode)
-            V = reApi.Create_Vertex( vertexName,
-                                     nodeProj.XYZ(),
-                                     bvh->GetFacet(nodeFacetInd).N.XYZ() );
-          //
-          vertices.Bind(n, V);
+      quads.push_back( nodeIndices(n) );
+    }
+  }
 
-          // Store vertices of the current quad.
-          quadVertices.push_back(V);
-          quadVerticesIds.push_back(n);
-        }
-        else
-        {
-          quadVertices.push_back( vertices(n) );
-          quadVerticesIds.push_back(n);
-        }
-      }
+  // All edges.
+  Handle(ActAPI_HNodeList) edgesList;
 
-      // Create edges/coedges.
-      for ( int k = 0; k < 4; ++k )
-      {
-        const int currIdx = k;
-        const int nextIdx = ((k == 3) ? 0 : k + 1);
+  asiEngine_RE            reApi   ( cmdRE::model, interp->GetProgress(), interp->GetPlotter() );
+  asiEngine_Triangulation trisApi ( cmdRE::model, interp->GetProgress(), interp->GetPlotter() );
 
-        const int n1 = quadVerticesIds[currIdx];
-        const int n2 = quadVerticesIds[nextIdx];
-        t_undirectedLink n1n2(n1, n2);
+  // Initialize progress indicator.
+  interp->GetProgress().Init();
+  interp->GetProgress().SetMessageKey("Process quads");
 
-        // Create or take an existing edge.
-        bool sameSense;
-        Handle(asiData_ReEdgeNode) edge;
-        //
-        if ( !edges.IsBound(n1n2) )
-        {
-          ++edgeIdx;
-          TCollection_ExtendedString edgeName("Edge "); edgeName += edgeIdx;
-
-          edge = reApi.Create_Edge(edgeName, quadVertices[currIdx], quadVertices[nextIdx]);
-          edges.Bind(n1n2, edge);
-          edgesList->Append(edge);
-          sameSense = true;
-
-          // Tool for line projection.
-          asiAlgo_MeshProjectLine projectLineMesh( bvh,
-                                                   interp->GetProgress(),
-                                                   interp->GetPlotter() );
-
-          // Project line between vertices n1 and n2 to mesh.
-          std::vector<gp_XYZ> projPts;
-          std::vector<int>    projInds;
-          //
-          if ( !projectLineMesh.Perform(quadVertices[currIdx]->GetPoint(),
-                                        quadVertices[nextIdx]->GetPoint(),
-                                        projPts, projInds, projTol) )
-          {
-            interp->GetProgress().SendLogMessage(LogWarn(Normal) << "Cannot project line to mesh.");
-            continue;
-          }
-
-          // Store projection.
-          if ( projPts.size() > 2 )
-          {
-            for ( size_t kk = 0; kk < projPts.size(); ++kk )
-              edge->AddPolylinePole(projPts[kk], projInds[kk]);
-
-            edge->AddPolylinePole(quadVertices[nextIdx]->GetPoint(), -1);
-          }
-        }
-        else
-        {
-          edge      = edges(n1n2);
-          sameSense = false;
-        }
+  int numPatches = 0;
+  //
+  cmdRE::model->OpenCommand();
+  {
+    // Build BVH for CAD-agnostic mesh.
+    Handle(asiAlgo_BVHFacets) bvh = trisApi.BuildBVH();
 
-        // Create coedge.
-        reApi.Create_CoEdge(patch, edge, sameSense);
-      }
-    }
-  } cmdRE::model->CommitCommand();
+    // Project the network and create its topology.
+    numPatches = reApi.CreateQuadTopology(nodes, quads, bvh, projTol, edgesList);
+  }
+  cmdRE::model->CommitCommand();
+
+  interp->GetProgress().SendLogMessage( LogInfo(Normal) << "%1 patches created from %2 quads."
+                                                        << numPatches << int( quads.size() ) / 4 );
 
   // Progress indication.
   interp->GetProgress().Init();
@@ -2172,6 +2860,18 @@ void cmdRE::Commands_Modeling(const Handle(asiTcl_Interp)&      interp,
     //
     __FILE__, group, RE_BuildPatches);
 
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-fill-patches",
+    //
+    "re-fill-patches [<patchName1> [<patchName2> ...]] [-plate]\n"
+    "\t Fills the given patches (or all patches if no names are passed) with\n"
+    "\t Coons surfaces. If the '-plate' keyword is passed, plate surfaces are\n"
+    "\t constructed instead, so the patches are not required to be 4-sided.\n"
+    "\t Unlike 're-build-patches', this command does not reconnect the tree\n"
+    "\t functions, and the surfaces are constructed concurrently in batch.",
+    //
+    __FILE__, group, RE_FillPatches);
+
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-build-contour-lines",
     //
@@ -2181,6 +2881,16 @@ void cmdRE::Commands_Modeling(const Handle(asiTcl_Interp)&      interp,
     //
     __FILE__, group, RE_BuildContourLines);
 
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-reapprox-contours",
+    //
+    "re-reapprox-contours <resName> <shapeName> [-prec <val>] [-angle <deg>]\n"
+    "\t Re-approximates all wires of the given shape with the passed precision\n"
+    "\t (1.0 by default) and barrier angle for segmentation (5 degrees by\n"
+    "\t default). The wires are processed concurrently.",
+    //
+    __FILE__, group, RE_ReapproxContours);
+
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-fair-contour-lines",
     //
@@ -2193,13 +2903,26 @@ void cmdRE::Commands_Modeling(const Handle(asiTcl_Interp)&      interp,
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-cut-with-plane",
     //
-    "re-cut-with-plane <res> <p> [-nosort]\n"
-    "\t Cuts triangulation with plane. If '-nosort' key is passed, the\n"
-    "\t resulting points are not post-processed with K-neighbors hull\n"
-    "\t algorithm thus remaining disordered.",
+    "re-cut-with-plane <res> <p> [-nosort] [-num <n> -step <h>]\n"
+    "\t Cuts triangulation with plane. The section points are linked into\n"
+    "\t ordered polylines unless '-nosort' key is passed. If the number of\n"
+    "\t planes is passed, the triangulation is cut with a stack of parallel\n"
+    "\t planes offset from <p> by the given positive step along its normal.\n"
+    "\t The '-nosort' key applies to each plane of the stack.",
     //
     __FILE__, group, RE_CutWithPlane);
 
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-concave-hull",
+    //
+    "re-concave-hull <res> <ptsName> <p> [-k <k>]\n"
+    "\t Projects the point cloud onto the plane <p> and builds a concave\n"
+    "\t hull of the projected points with the k-nearest neighbors approach.\n"
+    "\t The '-k' key specifies the number of neighbors to start with (5 by\n"
+    "\t default). The hull is drawn through the original points.",
+    //
+    __FILE__, group, RE_ConcaveHull);
+
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-approx-points",
     //
@@ -2243,16 +2966,24 @@ void cmdRE::Commands_Modeling(const Handle(asiTcl_Interp)&      interp,
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-check-deviation",
     //
-    "re-check-deviation <pointsName>\n"
-    "\t Checks deviation between the given point cloud and the active CAD part.",
+    "re-check-deviation <pointsName> [-stats [-bins <num> <min> <max>]]\n"
+    "\t Checks deviation between the given point cloud and the active CAD part.\n"
+    "\t If the '-stats' keyword is passed, only the statistics of deviations\n"
+    "\t are printed without storing the distance field. The histogram counts\n"
+    "\t are exact if its bins are set with the '-bins' keyword, otherwise\n"
+    "\t they are estimated.",
     //
     __FILE__, group, RE_CheckDeviation);
 
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-check-tri-deviation",
     //
-    "re-check-tri-deviation <pointsName>\n"
-    "\t Checks deviation between the given point cloud and the active triangulation.",
+    "re-check-tri-deviation <pointsName> [-stats [-bins <num> <min> <max>]]\n"
+    "\t Checks deviation between the given point cloud and the active triangulation.\n"
+    "\t If the '-stats' keyword is passed, only the statistics of deviations\n"
+    "\t are printed without storing the distance field. The histogram counts\n"
+    "\t are exact if its bins are set with the '-bins' keyword, otherwise\n"
+    "\t they are estimated.",
     //
     __FILE__, group, RE_CheckTriDeviation);
 
@@ -2267,8 +2998,10 @@ void cmdRE::Commands_Modeling(const Handle(asiTcl_Interp)&      interp,
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-sample-part",
     //
-    "re-sample-part <res> <ustep> <vstep> [-facets] [-vertices]\n"
-    "\t Makes a point cloud by sampling CAD part.",
+    "re-sample-part <res> <ustep> <vstep> [-facets] [-vertices] [-out <filename>]\n"
+    "\t Makes a point cloud by sampling CAD part. If the '-out' keyword is\n"
+    "\t passed, the samples are streamed to the given binary PLY file instead\n"
+    "\t of being drawn.",
     //
     __FILE__, group, RE_SamplePart);
 
@@ -2289,14 +3022,83 @@ void cmdRE::Commands_Modeling(const Handle(asiTcl_Interp)&      interp,
     //
     __FILE__, group, RE_PurifyCloud);
 
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-purify-tiled-cloud",
+    //
+    "re-purify-tiled-cloud <resFilename> <filename> <tol3d>\n"
+    "\t Purifies the out-of-core tiled point cloud stored in <filename>\n"
+    "\t tile by tile and writes the result to <resFilename>.",
+    //
+    __FILE__, group, RE_PurifyTiledCloud);
+
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-bench-tiled-cloud",
+    //
+    "re-bench-tiled-cloud <filename> [-n <numPts>] [-depth <depth>] [-tol <tol3d>]\n"
+    "\t Writes a synthetic tiled point cloud of <numPts> points (one million\n"
+    "\t by default, pass e.g. '-n 1e9' for out-of-core runs) to <filename>,\n"
+    "\t streams it through the tile cache and purifies it to <filename>.purified.\n"
+    "\t Reports timings of each stage.",
+    //
+    __FILE__, group, RE_BenchTiledCloud);
+
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-bench-cloud-kernels",
+    //
+    "re-bench-cloud-kernels [-n <numPts>]\n"
+    "\t Measures the bounding box, inertia axes and transformation kernels\n"
+    "\t over a random cloud of <numPts> points (ten million by default) in\n"
+    "\t single and double precision.",
+    //
+    __FILE__, group, RE_BenchCloudKernels);
+
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-orient-normals",
+    //
+    "re-orient-normals <resNormsName> <ptsName> <normsName> [-ref <index>] [-k <numNeighbors>]\n"
+    "\t Orients the normal field <normsName> of the point cloud <ptsName>\n"
+    "\t consistently with the normal at the reference index (0 by default).\n"
+    "\t The orientation is propagated along the minimum spanning tree of\n"
+    "\t the graph connecting each point with its k nearest neighbors.",
+    //
+    __FILE__, group, RE_OrientNormals);
+
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-detect-primitives",
+    //
+    "re-detect-primitives <resPrefix> <ptsName> [-eps <tol>] [-ang <deg>] [-min <numPts>] [-plane] [-sphere] [-cylinder] [-cone]\n"
+    "\t Detects planes, spheres, cylinders and cones in the point cloud <ptsName>\n"
+    "\t with RANSAC. Each primitive is drawn as a trimmed surface named\n"
+    "\t <resPrefix>_<i> together with its points <resPrefix>_<i>_pts. The points\n"
+    "\t out of primitives are drawn as <resPrefix>_rest. If no types are\n"
+    "\t passed, all types are detected.",
+    //
+    __FILE__, group, RE_DetectPrimitives);
+
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-approx-surf",
     //
-    "re-approx-surf <resSurf> <ptsName> {<uDegree> <vDegree> | -init <initSurf>} [-lambda <coeff>] [{-pinned | -pinned2}]\n"
-    "\t Approximates point cloud with B-surface.",
+    "re-approx-surf <resSurf> <ptsName> {<uDegree> <vDegree> [-poles <numU> <numV>] | -init <initSurf>} [-lambda <coeff>] [-pinned]\n"
+    "\t Approximates point cloud with B-surface. The surface is either built\n"
+    "\t from scratch with the passed degrees and numbers of poles (Bezier\n"
+    "\t surface by default) or has the knots of the initial surface whose\n"
+    "\t boundary poles are kept if the '-pinned' key is passed. The '-lambda'\n"
+    "\t key specifies the fairing coefficient.",
     //
     __FILE__, group, RE_ApproxSurf);
 
+  //-------------------------------------------------------------------------//
+  interp->AddCommand("re-plate-points",
+    //
+    "re-plate-points <resSurf> <ptsName> [-maxplatepts <num>]\n"
+    "\t Builds a plate surface passing through the points of the given point\n"
+    "\t cloud. Each point constrains the plate, so the plate solver becomes\n"
+    "\t impractical for dense clouds. If the '-maxplatepts' key is passed, the\n"
+    "\t clouds with more points are fitted with a least squares B-surface\n"
+    "\t instead. The points are always plated by default.",
+    //
+    __FILE__, group, RE_PlatePoints);
+
   //-------------------------------------------------------------------------//
   interp->AddCommand("re-get-triangulation-nodes",
     //